@@ -279,6 +279,10 @@ if (WAMR_BUILD_LIBC_UVWASI EQUAL 1)
   message ("     Libc WASI enabled with uvwasi implementation")
 elseif (WAMR_BUILD_LIBC_WASI EQUAL 1)
   message ("     Libc WASI enabled")
+  if (WAMR_BUILD_LIBC_WASI_IO_URING EQUAL 1)
+    add_definitions (-DWASM_ENABLE_LIBC_WASI_IO_URING=1)
+    message ("     Libc WASI io_uring backend enabled")
+  endif ()
 else ()
   message ("     Libc WASI disabled")
 endif ()
@@ -326,6 +330,29 @@ if (WAMR_BUILD_SHARED_HEAP EQUAL 1)
   add_definitions (-DWASM_ENABLE_SHARED_HEAP=1)
   message ("     Shared heap enabled")
 endif()
+if (WAMR_BUILD_INSTANCE_SNAPSHOT EQUAL 1)
+  add_definitions (-DWASM_ENABLE_INSTANCE_SNAPSHOT=1)
+  message ("     Instance snapshot enabled")
+endif()
+if (WAMR_BUILD_ALLOC_THREAD_CACHE EQUAL 1)
+  add_definitions (-DWASM_ENABLE_ALLOC_THREAD_CACHE=1)
+  message ("     Allocator thread caches enabled")
+endif()
+if (WAMR_BUILD_ASYNC_CALL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_ASYNC_CALL=1)
+  message ("     Async call enabled")
+endif()
+if (WAMR_BUILD_LAZY_VALIDATION EQUAL 1)
+  if (WAMR_BUILD_JIT EQUAL 1 OR WAMR_BUILD_FAST_JIT EQUAL 1
+      OR WAMR_BUILD_DEBUG_INTERP EQUAL 1 OR WAMR_BUILD_MINI_LOADER EQUAL 1)
+    message ("     Lazy validation disabled due to JIT, debug interp or mini loader enabled")
+  elseif (NOT WAMR_BUILD_INTERP EQUAL 1)
+    message ("     Lazy validation disabled due to interpreter disabled")
+  else ()
+    add_definitions (-DWASM_ENABLE_LAZY_VALIDATION=1)
+    message ("     Lazy function validation enabled")
+  endif ()
+endif ()
 
 if (WAMR_ENABLE_COPY_CALLSTACK EQUAL 1)
   add_definitions (-DWAMR_ENABLE_COPY_CALLSTACK=1)
@@ -398,6 +425,14 @@ if (WAMR_BUILD_PERF_PROFILING EQUAL 1)
   add_definitions (-DWASM_ENABLE_PERF_PROFILING=1)
   message ("     Performance profiling enabled")
 endif ()
+if (WAMR_BUILD_SAMPLING_PROFILER EQUAL 1)
+  if (WAMR_BUILD_PLATFORM STREQUAL "linux" OR WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    add_definitions (-DWASM_ENABLE_SAMPLING_PROFILER=1)
+    message ("     Sampling profiler enabled")
+  else ()
+    message ("     Sampling profiler disabled due to unsupported platform")
+  endif ()
+endif ()
 if (DEFINED WAMR_APP_THREAD_STACK_SIZE_MAX)
   add_definitions (-DAPP_THREAD_STACK_SIZE_MAX=${WAMR_APP_THREAD_STACK_SIZE_MAX})
 endif ()
@@ -426,6 +461,14 @@ if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_PERF_PROFILING EQUAL 1)
 else ()
   message ("     GC performance profiling disabled")
 endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_PARALLEL_MARK EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_PARALLEL_MARK=1)
+  message ("     GC parallel mark enabled")
+endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_NURSERY EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_NURSERY=1)
+  message ("     GC nursery enabled")
+endif ()
 if (WAMR_BUILD_STRINGREF EQUAL 1)
   if (NOT DEFINED WAMR_STRINGREF_IMPL_SOURCE)
     message ("       Using WAMR builtin implementation for stringref")
@@ -434,10 +477,11 @@ if (WAMR_BUILD_STRINGREF EQUAL 1)
   endif()
 endif ()
 if (WAMR_BUILD_PERF_PROFILING EQUAL 1 OR
+    WAMR_BUILD_SAMPLING_PROFILER EQUAL 1 OR
     WAMR_BUILD_DUMP_CALL_STACK EQUAL 1 OR
     WAMR_BUILD_GC EQUAL 1)
-  # Enable AOT/JIT stack frame when perf-profiling, dump-call-stack
-  # or GC is enabled
+  # Enable AOT/JIT stack frame when perf-profiling, sampling profiler,
+  # dump-call-stack or GC is enabled
   if (WAMR_BUILD_AOT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
     add_definitions (-DWASM_ENABLE_AOT_STACK_FRAME=1)
   endif ()
@@ -633,6 +677,11 @@ else ()
   # Disable quick aot/jit entries for interp and fast-jit
   add_definitions (-DWASM_ENABLE_QUICK_AOT_ENTRY=0)
 endif ()
+if (WAMR_BUILD_QUICK_NATIVE_CALL EQUAL 0)
+  # Quick native calls are enabled by default on the supported targets
+  add_definitions (-DWASM_ENABLE_QUICK_NATIVE_CALL=0)
+  message ("     Quick native calls disabled")
+endif ()
 if (WAMR_BUILD_AOT EQUAL 1)
   if (NOT DEFINED WAMR_BUILD_AOT_INTRINSICS)
     # Enable aot intrinsics by default
@@ -112,6 +112,13 @@
 #error "WASM_ORC_JIT_COMPILE_THREAD_NUM must be greater than 0"
 #endif
 
+#ifndef WASM_TIERUP_HOTNESS_THRESHOLD
+/* The default hotness which a function reaches before it is compiled by
+   LLVM JIT in Multi-tier JIT mode, the hotness counts the calls of the
+   function and the iterations of its loops run by Fast JIT */
+#define WASM_TIERUP_HOTNESS_THRESHOLD 1000
+#endif
+
 #if (WASM_ENABLE_AOT == 0) && (WASM_ENABLE_JIT != 0)
 /* LLVM JIT can only be enabled when AOT is enabled */
 #undef WASM_ENABLE_JIT
@@ -145,6 +152,11 @@
 #define WASM_ENABLE_LIBC_WASI 0
 #endif
 
+/* Submit the file and socket I/O of libc-wasi through io_uring on Linux */
+#ifndef WASM_ENABLE_LIBC_WASI_IO_URING
+#define WASM_ENABLE_LIBC_WASI_IO_URING 0
+#endif
+
 #ifndef WASM_ENABLE_UVWASI
 #define WASM_ENABLE_UVWASI 0
 #endif
@@ -333,6 +345,16 @@ unless used elsewhere */
 #define WASM_ENABLE_GC_PERF_PROFILING 0
 #endif
 
+/* Mark the GC heap with helper threads */
+#ifndef WASM_ENABLE_GC_PARALLEL_MARK
+#define WASM_ENABLE_GC_PARALLEL_MARK 0
+#endif
+
+/* Allocate the new GC objects in a nursery collected by minor GC */
+#ifndef WASM_ENABLE_GC_NURSERY
+#define WASM_ENABLE_GC_NURSERY 0
+#endif
+
 /* Memory profiling */
 #ifndef WASM_ENABLE_MEMORY_PROFILING
 #define WASM_ENABLE_MEMORY_PROFILING 0
@@ -348,6 +370,28 @@ unless used elsewhere */
 #define WASM_ENABLE_PERF_PROFILING 0
 #endif
 
+/* Sampling profiler driven by SIGPROF, see wasm_runtime_start_profiling */
+#ifndef WASM_ENABLE_SAMPLING_PROFILER
+#define WASM_ENABLE_SAMPLING_PROFILER 0
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+/* Max number of distinct call stacks recorded, must be a power of 2 */
+#ifndef WASM_SAMPLING_PROFILER_MAX_STACKS
+#define WASM_SAMPLING_PROFILER_MAX_STACKS 4096
+#endif
+/* Max number of frames recorded for a call stack, the outermost
+   frames of a deeper call stack are dropped */
+#ifndef WASM_SAMPLING_PROFILER_MAX_DEPTH
+#define WASM_SAMPLING_PROFILER_MAX_DEPTH 64
+#endif
+/* Max number of threads running wasm code which can be sampled at the
+   same time */
+#ifndef WASM_SAMPLING_PROFILER_MAX_THREADS
+#define WASM_SAMPLING_PROFILER_MAX_THREADS 64
+#endif
+#endif
+
 /* Dump call stack */
 #ifndef WASM_ENABLE_DUMP_CALL_STACK
 #define WASM_ENABLE_DUMP_CALL_STACK 0
@@ -417,6 +461,11 @@ unless used elsewhere */
 #define GC_HEAP_SIZE_MIN (4 * 1024)
 #define GC_HEAP_SIZE_MAX (1024 * 1024 * 1024)
 
+/* Default size of the nursery where the new gc objects are allocated */
+#ifndef GC_NURSERY_SIZE_DEFAULT
+#define GC_NURSERY_SIZE_DEFAULT (256 * 1024)
+#endif
+
 /* Default wasm stack size of each app */
 #if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64)
 #define DEFAULT_WASM_STACK_SIZE (16 * 1024)
@@ -603,6 +652,12 @@ unless used elsewhere */
 #define GC_RTTOBJ_MAP_SIZE_DEFAULT 64
 #endif
 
+/* Max entry count of a GC type's supertype display, the subtype check
+   of a type deeper than it falls back to walking the parent types */
+#ifndef GC_TYPE_SUPERS_DISPLAY_SIZE
+#define GC_TYPE_SUPERS_DISPLAY_SIZE 32
+#endif
+
 #ifndef WASM_ENABLE_EXCE_HANDLING
 #define WASM_ENABLE_EXCE_HANDLING 0
 #endif
@@ -667,6 +722,21 @@ unless used elsewhere */
 #define WASM_ENABLE_QUICK_AOT_ENTRY 1
 #endif
 
+/* Call the native APIs whose params and result are all i32 or i64 with
+   C function pointers directly, instead of marshalling the arguments
+   through invokeNative, the signatures of them are precompiled when the
+   import functions are resolved. Only available on the targets whose
+   calling conventions leave the upper bits of 32-bit integer arguments
+   in 64-bit registers unspecified */
+#ifndef WASM_ENABLE_QUICK_NATIVE_CALL
+#if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64) \
+    || defined(BUILD_TARGET_AARCH64)
+#define WASM_ENABLE_QUICK_NATIVE_CALL 1
+#else
+#define WASM_ENABLE_QUICK_NATIVE_CALL 0
+#endif
+#endif
+
 /* Support AOT intrinsic functions which can be called from the AOT code
    when `--disable-llvm-intrinsics` flag or
    `--enable-builtin-intrinsics=<intr1,intr2,...>` is used by wamrc to
@@ -708,6 +778,42 @@ unless used elsewhere */
 #define WASM_ENABLE_SHARED_HEAP 0
 #endif
 
+/* Snapshot an initialized module instance and create new instances
+   from the snapshot */
+#ifndef WASM_ENABLE_INSTANCE_SNAPSHOT
+#define WASM_ENABLE_INSTANCE_SNAPSHOT 0
+#endif
+
+/* Serve the small allocations and frees of the global pool with thread
+   caches in front of the heap lock, see gc_enable_thread_cache */
+#ifndef WASM_ENABLE_ALLOC_THREAD_CACHE
+#define WASM_ENABLE_ALLOC_THREAD_CACHE 0
+#endif
+
+/* Support calling WASM functions on separately allocated native stacks
+   which can be suspended by native functions and resumed by the host,
+   see wasm_runtime_call_wasm_async */
+#ifndef WASM_ENABLE_ASYNC_CALL
+#define WASM_ENABLE_ASYNC_CALL 0
+#endif
+
+/* Native stack size of each async call */
+#ifndef WASM_ASYNC_CALL_STACK_SIZE
+#define WASM_ASYNC_CALL_STACK_SIZE (128 * 1024)
+#endif
+
+/* Validate (and prepare for the fast interpreter) each function body on
+   its first call instead of at load time, see LoadArgs::lazy_validation */
+#ifndef WASM_ENABLE_LAZY_VALIDATION
+#define WASM_ENABLE_LAZY_VALIDATION 0
+#endif
+
+#if WASM_ENABLE_JIT != 0 || WASM_ENABLE_FAST_JIT != 0 \
+    || WASM_ENABLE_DEBUG_INTERP != 0 || WASM_ENABLE_MINI_LOADER != 0
+#undef WASM_ENABLE_LAZY_VALIDATION
+#define WASM_ENABLE_LAZY_VALIDATION 0
+#endif
+
 #ifndef WASM_ENABLE_SHRUNK_MEMORY
 #define WASM_ENABLE_SHRUNK_MEMORY 1
 #endif
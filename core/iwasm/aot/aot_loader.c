@@ -604,8 +604,8 @@ load_target_info_section(const uint8 *buf, const uint8 *buf_end,
         return false;
     }
 
-#if WASM_ENABLE_DUMP_CALL_STACK != 0
-    module->feature_flags = target_info.feature_flags;
+#if WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_GC_NURSERY != 0
+    module->feature_flags = (uint32)target_info.feature_flags;
 #endif
 
     /* Finally, check feature flags */
@@ -1640,6 +1640,8 @@ destroy_type(AOTType *type)
         return;
     }
 
+    wasm_type_destroy_supers(type);
+
     if (type->type_flag == WASM_TYPE_FUNC) {
         AOTFuncType *func_type = (AOTFuncType *)type;
         if (func_type->ref_type_maps != NULL) {
@@ -1986,7 +1988,14 @@ load_types(const uint8 **p_buf, const uint8 *buf_end, AOTModule *module,
                 AOTType *cur_type = module->types[j];
                 parent_type_idx = cur_type->parent_type_idx;
                 if (parent_type_idx != (uint32)-1) { /* has parent */
-                    AOTType *parent_type = module->types[parent_type_idx];
+                    AOTType *parent_type;
+
+                    if (parent_type_idx >= j) {
+                        set_error_buf(error_buf, error_buf_size,
+                                      "invalid parent type index");
+                        goto fail;
+                    }
+                    parent_type = module->types[parent_type_idx];
 
                     module->types[j]->parent_type = parent_type;
                     module->types[j]->root_type = parent_type->root_type;
@@ -2003,6 +2012,12 @@ load_types(const uint8 **p_buf, const uint8 *buf_end, AOTModule *module,
                     module->types[j]->root_type = module->types[j];
                     module->types[j]->inherit_depth = 0;
                 }
+
+                if (!wasm_type_init_supers(module->types[j])) {
+                    set_error_buf(error_buf, error_buf_size,
+                                  "allocate memory failed");
+                    goto fail;
+                }
             }
 
             for (j = i - rec_idx; j <= i; j++) {
@@ -4501,8 +4516,7 @@ aot_unload(AOTModule *module)
     if (module->func_ptrs)
         wasm_runtime_free(module->func_ptrs);
 
-    if (module->const_str_set)
-        bh_hash_map_destroy(module->const_str_set);
+    wasm_const_str_pool_destroy(&module->const_str_pool);
 #if WASM_ENABLE_MULTI_MODULE != 0
     /* just release the sub module list */
     if (module->import_module_list) {
@@ -9,6 +9,7 @@
 #include "mem_alloc.h"
 #include "../common/wasm_runtime_common.h"
 #include "../common/wasm_memory.h"
+#include "../common/wasm_loader_common.h"
 #include "../interpreter/wasm_runtime.h"
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "../common/wasm_shared_memory.h"
@@ -16,6 +17,9 @@
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../libraries/thread-mgr/thread_manager.h"
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+#include "../common/wasm_sampling_profiler.h"
+#endif
 
 /*
  * Note: These offsets need to match the values hardcoded in
@@ -1109,8 +1113,8 @@ aot_get_memory_with_idx(AOTModuleInstance *module_inst, uint32 mem_idx)
 static bool
 memories_instantiate(AOTModuleInstance *module_inst, AOTModuleInstance *parent,
                      AOTModule *module, uint32 heap_size,
-                     uint32 max_memory_pages, char *error_buf,
-                     uint32 error_buf_size)
+                     uint32 max_memory_pages, bool from_snapshot,
+                     char *error_buf, uint32 error_buf_size)
 {
     uint32 global_index, global_data_offset, length;
     uint32 i, memory_count = module->memory_count;
@@ -1151,9 +1155,9 @@ memories_instantiate(AOTModuleInstance *module_inst, AOTModuleInstance *parent,
         if (data_seg->is_passive)
             continue;
 #endif
-        if (parent != NULL)
+        if (parent != NULL || from_snapshot)
             /* Ignore setting memory init data if the memory has been
-               initialized */
+               initialized, or will be restored from the snapshot */
             continue;
 
         bh_assert(data_seg->offset.init_expr_type
@@ -1598,6 +1602,9 @@ execute_post_instantiate_functions(AOTModuleInstance *module_inst,
     WASMExecEnv *exec_env_tls = wasm_runtime_get_exec_env_tls();
 #endif
     WASMExecEnv *exec_env = NULL, *exec_env_created = NULL;
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    WASMProfilerThread *prof_thread;
+#endif
     bool ret = false;
 
 #if WASM_ENABLE_LIBC_WASI != 0
@@ -1695,6 +1702,12 @@ execute_post_instantiate_functions(AOTModuleInstance *module_inst,
     }
 #endif
 
+    /* The frames of the functions below belong to module_inst, though
+       they may be on the stack of an exec_env of another instance */
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    prof_thread = wasm_sampling_profiler_enter(exec_env);
+#endif
+
     /* Execute start function for both main instance and sub instance */
     if (module->start_function) {
         AOTFunctionInstance start_func = { 0 };
@@ -1731,6 +1744,9 @@ execute_post_instantiate_functions(AOTModuleInstance *module_inst,
     ret = true;
 
 fail:
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_leave(prof_thread);
+#endif
     if (is_sub_inst) {
         /* Restore the parent exec_env's module inst */
         wasm_exec_env_restore_module_inst(exec_env_main, module_inst_main);
@@ -1769,7 +1785,8 @@ check_linked_symbol(AOTModule *module, char *error_buf, uint32 error_buf_size)
 AOTModuleInstance *
 aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
                 WASMExecEnv *exec_env_main, uint32 stack_size, uint32 heap_size,
-                uint32 max_memory_pages, char *error_buf, uint32 error_buf_size)
+                uint32 max_memory_pages, bool from_snapshot, char *error_buf,
+                uint32 error_buf_size)
 {
     AOTModuleInstance *module_inst;
 #if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
@@ -1933,7 +1950,8 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
 
     /* Initialize memory space */
     if (!memories_instantiate(module_inst, parent, module, heap_size,
-                              max_memory_pages, error_buf, error_buf_size))
+                              max_memory_pages, from_snapshot, error_buf,
+                              error_buf_size))
         goto fail;
 
     /* Initialize function pointers */
@@ -2150,8 +2168,10 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
     }
 #endif
 
-    if (!execute_post_instantiate_functions(module_inst, is_sub_inst,
-                                            exec_env_main)) {
+    /* The start functions have been executed before taking the snapshot */
+    if (!from_snapshot
+        && !execute_post_instantiate_functions(module_inst, is_sub_inst,
+                                               exec_env_main)) {
         set_error_buf(error_buf, error_buf_size, module_inst->cur_exception);
         goto fail;
     }
@@ -2696,6 +2716,9 @@ execute_malloc_function(AOTModuleInstance *module_inst, WASMExecEnv *exec_env,
 #endif
     WASMExecEnv *exec_env_created = NULL;
     WASMModuleInstanceCommon *module_inst_old = NULL;
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    WASMProfilerThread *prof_thread;
+#endif
     union {
         uint32 u32[3];
         uint64 u64;
@@ -2765,10 +2788,16 @@ execute_malloc_function(AOTModuleInstance *module_inst, WASMExecEnv *exec_env,
         }
     }
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    prof_thread = wasm_sampling_profiler_enter(exec_env);
+#endif
     ret = aot_call_function(exec_env, malloc_func, argc, argv.u32);
 
     if (retain_func && ret)
         ret = aot_call_function(exec_env, retain_func, 1, argv.u32);
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_leave(prof_thread);
+#endif
 
     if (module_inst_old)
         /* Restore the existing exec_env's module inst */
@@ -2799,6 +2828,9 @@ execute_free_function(AOTModuleInstance *module_inst, WASMExecEnv *exec_env,
 #endif
     WASMExecEnv *exec_env_created = NULL;
     WASMModuleInstanceCommon *module_inst_old = NULL;
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    WASMProfilerThread *prof_thread;
+#endif
     union {
         uint32 u32[2];
         uint64 u64;
@@ -2855,7 +2887,13 @@ execute_free_function(AOTModuleInstance *module_inst, WASMExecEnv *exec_env,
         }
     }
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    prof_thread = wasm_sampling_profiler_enter(exec_env);
+#endif
     ret = aot_call_function(exec_env, free_func, argc, argv.u32);
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_leave(prof_thread);
+#endif
 
     if (module_inst_old)
         /* Restore the existing exec_env's module inst */
@@ -3140,9 +3178,16 @@ aot_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
         }
 #endif
 #endif /* WASM_ENABLE_MULTI_MODULE != 0 */
-        ret =
-            wasm_runtime_invoke_native(exec_env, func_ptr, func_type, signature,
-                                       attachment, argv, argc, argv);
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+        if (import_func->native_call.quick)
+            ret = wasm_runtime_invoke_native_quick(exec_env, func_ptr,
+                                                   &import_func->native_call,
+                                                   attachment, argv, argv);
+        else
+#endif
+            ret = wasm_runtime_invoke_native(exec_env, func_ptr, func_type,
+                                             signature, attachment, argv,
+                                             argc, argv);
 #if WASM_ENABLE_MULTI_MODULE != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
         /* Free all frames allocated, note that some frames
            may be allocated in AOT code and haven't been
@@ -3496,15 +3541,6 @@ aot_get_aux_stack(WASMExecEnv *exec_env, uint64 *start_offset, uint32 *size)
 #endif
 
 #if (WASM_ENABLE_MEMORY_PROFILING != 0) || (WASM_ENABLE_MEMORY_TRACING != 0)
-static void
-const_string_node_size_cb(void *key, void *value, void *p_const_string_size)
-{
-    uint32 const_string_size = 0;
-    const_string_size += bh_hash_map_get_elem_struct_size();
-    const_string_size += strlen((const char *)value) + 1;
-    *(uint32 *)p_const_string_size += const_string_size;
-}
-
 void
 aot_get_module_mem_consumption(const AOTModule *module,
                                WASMModuleMemConsumption *mem_conspn)
@@ -3554,16 +3590,8 @@ aot_get_module_mem_consumption(const AOTModule *module,
         mem_conspn->data_segs_size += sizeof(AOTMemInitData);
     }
 
-    if (module->const_str_set) {
-        uint32 const_string_size = 0;
-
-        mem_conspn->const_strs_size =
-            bh_hash_map_get_struct_size(module->const_str_set);
-
-        bh_hash_map_traverse(module->const_str_set, const_string_node_size_cb,
-                             (void *)&const_string_size);
-        mem_conspn->const_strs_size += const_string_size;
-    }
+    mem_conspn->const_strs_size =
+        wasm_const_str_pool_get_mem_size(&module->const_str_pool);
 
     /* code size + literal size + object data section size */
     mem_conspn->aot_code_size =
@@ -5273,46 +5301,29 @@ aot_const_str_set_insert(const uint8 *str, int32 len, AOTModule *module,
 #endif
                          char *error_buf, uint32 error_buf_size)
 {
-    HashMap *set = module->const_str_set;
-    char *c_str, *value;
-
-    /* Create const string set if it isn't created */
-    if (!set
-        && !(set = module->const_str_set = bh_hash_map_create(
-                 32, false, (HashFunc)wasm_string_hash,
-                 (KeyEqualFunc)wasm_string_equal, NULL, wasm_runtime_free))) {
-        set_error_buf(error_buf, error_buf_size,
-                      "create const string set failed");
-        return NULL;
-    }
+    /* len includes the terminating '\0' of the string */
+    bh_assert(len > 0);
 
-    /* Lookup const string set, use the string if found */
-    if (!(c_str = runtime_malloc((uint32)len, error_buf, error_buf_size))) {
-        return NULL;
-    }
 #if (WASM_ENABLE_WORD_ALIGN_READ != 0)
     if (is_vram_word_align) {
-        bh_memcpy_wa(c_str, (uint32)len, str, (uint32)len);
-    }
-    else
-#endif
-    {
-        bh_memcpy_s(c_str, len, str, (uint32)len);
-    }
+        char *buf, *c_str;
 
-    if ((value = bh_hash_map_find(set, c_str))) {
-        wasm_runtime_free(c_str);
-        return value;
-    }
-
-    if (!bh_hash_map_insert(set, c_str, c_str)) {
-        set_error_buf(error_buf, error_buf_size,
-                      "insert string to hash map failed");
-        wasm_runtime_free(c_str);
-        return NULL;
+        /* The string can only be read by words, copy it out first */
+        if (!(buf = runtime_malloc((uint32)len, error_buf, error_buf_size))) {
+            return NULL;
+        }
+        bh_memcpy_wa(buf, (uint32)len, str, (uint32)len);
+        c_str = wasm_const_str_pool_insert(&module->const_str_pool,
+                                           (uint8 *)buf, (uint32)len - 1, true,
+                                           error_buf, error_buf_size);
+        wasm_runtime_free(buf);
+        return c_str;
     }
+#endif
 
-    return c_str;
+    return wasm_const_str_pool_insert(&module->const_str_pool, str,
+                                      (uint32)len - 1, true, error_buf,
+                                      error_buf_size);
 }
 
 #if WASM_ENABLE_DYNAMIC_AOT_DEBUG != 0
@@ -5451,6 +5462,12 @@ aot_resolve_import_func(AOTModule *module, AOTImportFunc *import_func)
         import_func->module_name, import_func->func_name,
         import_func->func_type, &import_func->signature,
         &import_func->attachment, &import_func->call_conv_raw);
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    if (import_func->func_ptr_linked && !import_func->call_conv_raw)
+        wasm_native_precompile_signature(import_func->func_type,
+                                         import_func->signature,
+                                         &import_func->native_call);
+#endif
 #if WASM_ENABLE_MULTI_MODULE != 0
     if (!import_func->func_ptr_linked) {
         if (!wasm_runtime_is_built_in_module(import_func->module_name)) {
@@ -35,6 +35,8 @@ extern "C" {
  * and not at the beginning of each function call */
 #define WASM_FEATURE_FRAME_PER_FUNCTION (1 << 12)
 #define WASM_FEATURE_FRAME_NO_FUNC_IDX (1 << 13)
+/* The reference stores into GC objects call the write barrier */
+#define WASM_FEATURE_GC_WRITE_BARRIER (1 << 14)
 
 typedef enum AOTSectionType {
     AOT_SECTION_TYPE_TARGET_INFO = 0,
@@ -275,8 +277,8 @@ typedef struct AOTModule {
     AOTObjectDataSection *data_sections;
     uint32 data_section_count;
 
-    /* constant string set */
-    HashMap *const_str_set;
+    /* constant string pool */
+    ConstStrPool const_str_pool;
 
     /* the index of auxiliary __data_end global,
        -1 means unexported */
@@ -357,7 +359,7 @@ typedef struct AOTModule {
     uint8 *merged_data_text_sections;
     uint32 merged_data_text_sections_size;
 
-#if WASM_ENABLE_AOT_STACK_FRAME != 0
+#if WASM_ENABLE_AOT_STACK_FRAME != 0 || WASM_ENABLE_GC_NURSERY != 0
     uint32 feature_flags;
 #endif
 } AOTModule;
@@ -539,6 +541,9 @@ aot_resolve_import_func(AOTModule *module, AOTImportFunc *import_func);
  *        be created besides the app memory space. Both wasm app and native
  *        function can allocate memory from the heap. If heap_size is 0, the
  *        default heap size will be used.
+ * @param from_snapshot whether the instance state will be restored from
+ *        a snapshot, if true, the initialization of linear memories with
+ *        data segments and the start functions are skipped
  * @param error_buf buffer to output the error info if failed
  * @param error_buf_size the size of the error buffer
  *
@@ -547,7 +552,7 @@ aot_resolve_import_func(AOTModule *module, AOTImportFunc *import_func);
 AOTModuleInstance *
 aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
                 WASMExecEnv *exec_env_main, uint32 stack_size, uint32 heap_size,
-                uint32 max_memory_pages, char *error_buf,
+                uint32 max_memory_pages, bool from_snapshot, char *error_buf,
                 uint32 error_buf_size);
 
 /**
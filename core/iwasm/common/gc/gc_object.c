@@ -82,6 +82,18 @@ get_gc_heap_handle(WASMExecEnv *exec_env)
     return gc_heap_handle;
 }
 
+#if WASM_ENABLE_GC_NURSERY != 0
+static inline bool
+is_ref_array_obj(const WASMArrayObjectRef array_obj)
+{
+    WASMRttTypeRef rtt_type =
+        (WASMRttTypeRef)wasm_object_header((WASMObjectRef)array_obj);
+    WASMArrayType *array_type = (WASMArrayType *)rtt_type->defined_type;
+
+    return wasm_is_type_reftype(array_type->elem_type);
+}
+#endif
+
 WASMStructObjectRef
 wasm_struct_obj_new_internal(void *heap_handle, WASMRttTypeRef rtt_type)
 {
@@ -143,6 +155,11 @@ wasm_struct_obj_set_field(WASMStructObjectRef struct_obj, uint32 field_idx,
     else {
         bh_assert(0);
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (wasm_is_type_reftype(field->field_type))
+        wasm_obj_write_barrier((WASMObjectRef)struct_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -293,6 +310,11 @@ wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
             PUT_I64_TO_ADDR((uint32 *)elem_data, value->i64);
             break;
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (is_ref_array_obj(array_obj))
+        wasm_obj_write_barrier((WASMObjectRef)array_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -347,6 +369,11 @@ wasm_array_obj_fill(const WASMArrayObjectRef array_obj, uint32 elem_idx,
         }
         elem_data += elem_size;
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (len > 0 && is_ref_array_obj(array_obj))
+        wasm_obj_write_barrier((WASMObjectRef)array_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -358,6 +385,16 @@ wasm_array_obj_copy(WASMArrayObjectRef dst_obj, uint32 dst_idx,
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(dst_obj);
 
     bh_memmove_s(dst_data, elem_size * len, src_data, elem_size * len);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (is_ref_array_obj(dst_obj)) {
+        uint32 i;
+        for (i = 0; i < len; i++, dst_data += elem_size) {
+            wasm_obj_write_barrier((WASMObjectRef)dst_obj,
+                                   GET_REF_FROM_ADDR((uint32 *)dst_data));
+        }
+    }
+#endif
 }
 
 uint32
@@ -653,8 +690,6 @@ wasm_obj_is_instance_of(WASMObjectRef obj, uint32 type_idx, WASMType **types,
                         uint32 type_count)
 {
     WASMRttTypeRef rtt_type_sub;
-    WASMType *type_sub, *type_parent;
-    uint32 distance, i;
 
     bh_assert(obj);
     bh_assert(type_idx < type_count);
@@ -663,20 +698,7 @@ wasm_obj_is_instance_of(WASMObjectRef obj, uint32 type_idx, WASMType **types,
         return false;
 
     rtt_type_sub = (WASMRttTypeRef)wasm_object_header(obj);
-    type_parent = types[type_idx];
-
-    if (!(rtt_type_sub->root_type == type_parent->root_type
-          && rtt_type_sub->inherit_depth >= type_parent->inherit_depth))
-        return false;
-
-    type_sub = rtt_type_sub->defined_type;
-    distance = type_sub->inherit_depth - type_parent->inherit_depth;
-
-    for (i = 0; i < distance; i++) {
-        type_sub = type_sub->parent_type;
-    }
-
-    return (type_sub == type_parent) ? true : false;
+    return wasm_type_is_supers_of(types[type_idx], rtt_type_sub->defined_type);
 }
 
 bool
@@ -725,6 +747,18 @@ wasm_obj_equal(WASMObjectRef obj1, WASMObjectRef obj2)
     return obj1 == obj2 ? true : false;
 }
 
+void
+wasm_obj_write_barrier(WASMObjectRef obj, WASMObjectRef value)
+{
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (wasm_obj_is_created_from_heap(value))
+        mem_allocator_write_barrier(obj, value);
+#else
+    (void)obj;
+    (void)value;
+#endif
+}
+
 bool
 wasm_object_get_ref_list(WASMObjectRef obj, bool *p_is_compact_mode,
                          uint32 *p_ref_num, uint16 **p_ref_list,
@@ -328,6 +328,13 @@ wasm_obj_is_type_of(WASMObjectRef obj, int32 heap_type);
 bool
 wasm_obj_equal(WASMObjectRef obj1, WASMObjectRef obj2);
 
+/**
+ * The write barrier of the GC nursery, which must be called after a
+ * reference is stored into a GC object without the setters above
+ */
+void
+wasm_obj_write_barrier(WASMObjectRef obj, WASMObjectRef value);
+
 bool
 wasm_object_get_ref_list(WASMObjectRef obj, bool *p_is_compact_mode,
                          uint32 *p_ref_num, uint16 **p_ref_list,
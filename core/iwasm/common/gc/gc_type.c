@@ -903,27 +903,73 @@ wasm_is_reftype_supers_of_noextern(uint8 type)
                : false;
 }
 
-/* Whether type1 is one of super types of type2 */
-static bool
+bool
+wasm_type_init_supers(WASMType *type)
+{
+    WASMType *parent_type = type->parent_type;
+    uint32 supers_count, parent_supers_count;
+
+    if (type->supers)
+        /* Already initialized, e.g. a reused equivalence type */
+        return true;
+
+    supers_count = wasm_type_get_supers_count(type);
+    if (!(type->supers = wasm_runtime_malloc((uint32)sizeof(WASMType *)
+                                             * supers_count))) {
+        return false;
+    }
+
+    if (parent_type) {
+        /* The parent type is defined before the current type and its
+           display has been initialized, copy it as the prefix */
+        bh_assert(parent_type->supers);
+        parent_supers_count = wasm_type_get_supers_count(parent_type);
+        bh_memcpy_s(type->supers, (uint32)sizeof(WASMType *) * supers_count,
+                    parent_type->supers,
+                    (uint32)sizeof(WASMType *) * parent_supers_count);
+    }
+
+    if (type->inherit_depth < GC_TYPE_SUPERS_DISPLAY_SIZE)
+        type->supers[type->inherit_depth] = type;
+
+    return true;
+}
+
+void
+wasm_type_destroy_supers(WASMType *type)
+{
+    if (type->supers) {
+        wasm_runtime_free(type->supers);
+        type->supers = NULL;
+    }
+}
+
+bool
 wasm_type_is_supers_of(const WASMType *type1, const WASMType *type2)
 {
-    uint32 i, inherit_depth_diff;
+    uint32 i, inherit_depth_diff, inherit_depth1 = type1->inherit_depth;
 
     if (type1 == type2)
         return true;
 
-    if (!(type1->root_type == type2->root_type
-          && type1->inherit_depth < type2->inherit_depth))
+    if (inherit_depth1 >= type2->inherit_depth)
         return false;
 
-    inherit_depth_diff = type2->inherit_depth - type1->inherit_depth;
-    for (i = 0; i < inherit_depth_diff; i++) {
-        type2 = type2->parent_type;
-        if (type2 == type1)
-            return true;
+    if (inherit_depth1 < GC_TYPE_SUPERS_DISPLAY_SIZE) {
+        /* type1 must be at index inherit_depth1 of type2's display */
+        bh_assert(type2->supers);
+        return type2->supers[inherit_depth1] == type1 ? true : false;
     }
 
-    return false;
+    /* type1 is deeper than the display, walk up from type2 */
+    if (type1->root_type != type2->root_type)
+        return false;
+
+    inherit_depth_diff = type2->inherit_depth - inherit_depth1;
+    for (i = 0; i < inherit_depth_diff; i++)
+        type2 = type2->parent_type;
+
+    return type2 == type1 ? true : false;
 }
 
 bool
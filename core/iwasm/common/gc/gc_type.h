@@ -120,6 +120,30 @@ bool
 wasm_type_is_subtype_of(const WASMType *type1, const WASMType *type2,
                         const WASMTypePtr *types, uint32 type_count);
 
+/* Get the entry count of a wasm type's supertype display, the display
+   records the type's ancestors indexed by their inherit depth */
+inline static uint32
+wasm_type_get_supers_count(const WASMType *type)
+{
+    return type->inherit_depth < GC_TYPE_SUPERS_DISPLAY_SIZE
+               ? (uint32)type->inherit_depth + 1
+               : GC_TYPE_SUPERS_DISPLAY_SIZE;
+}
+
+/* Initialize the supertype display of a wasm type, the parent type's
+   display must have been initialized before */
+bool
+wasm_type_init_supers(WASMType *type);
+
+/* Destroy the supertype display of a wasm type */
+void
+wasm_type_destroy_supers(WASMType *type);
+
+/* Whether wasm type1 is one of the super types of wasm type2 or
+   type2 itself, a lookup of type2's supertype display */
+bool
+wasm_type_is_supers_of(const WASMType *type1, const WASMType *type2);
+
 /* Operations of reference type */
 
 /* Whether a value type is a reference type */
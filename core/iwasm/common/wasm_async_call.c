@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2026 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_runtime_common.h"
+#include "bh_log.h"
+
+#if WASM_ENABLE_ASYNC_CALL != 0
+
+#ifdef OS_ENABLE_FIBER
+
+/* The native stack state of the exec env, which is switched between the
+   host and the fiber running the call */
+typedef struct AsyncCallStackInfo {
+    uint8 *native_stack_boundary;
+    uint8 *user_native_stack_boundary;
+    uint8 *native_stack_top_min;
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    WASMExecEnv *exec_env_tls;
+#endif
+} AsyncCallStackInfo;
+
+typedef struct WASMAsyncCall {
+    os_fiber *fiber;
+    WASMExecEnv *exec_env;
+    WASMFunctionInstanceCommon *function;
+    uint32 argc;
+    uint32 *argv;
+    /* the result passed from wasm_runtime_resume to wasm_runtime_suspend */
+    uint64 resume_value;
+    /* the thread which started the call, the call can only be resumed
+       by it since the fiber stack may hold its thread local data */
+    korp_tid handle;
+    bool call_ret;
+    /* whether the function is being called, including the suspension */
+    bool running;
+    bool suspended;
+    bool canceled;
+    AsyncCallStackInfo host_info;
+    AsyncCallStackInfo fiber_info;
+} WASMAsyncCall;
+
+static void
+save_stack_info(WASMExecEnv *exec_env, AsyncCallStackInfo *info)
+{
+    info->native_stack_boundary = exec_env->native_stack_boundary;
+    info->user_native_stack_boundary = exec_env->user_native_stack_boundary;
+    info->native_stack_top_min = exec_env->native_stack_top_min;
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    info->exec_env_tls = wasm_runtime_get_exec_env_tls();
+#endif
+}
+
+static void
+restore_stack_info(WASMExecEnv *exec_env, const AsyncCallStackInfo *info)
+{
+    exec_env->native_stack_boundary = info->native_stack_boundary;
+    exec_env->user_native_stack_boundary = info->user_native_stack_boundary;
+    exec_env->native_stack_top_min = info->native_stack_top_min;
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    wasm_runtime_set_exec_env_tls(info->exec_env_tls);
+#endif
+}
+
+static void
+async_call_entry(void *arg)
+{
+    WASMAsyncCall *call = (WASMAsyncCall *)arg;
+
+    /* The fiber is reused by the later calls */
+    while (true) {
+        call->call_ret = wasm_runtime_call_wasm(call->exec_env, call->function,
+                                                call->argc, call->argv);
+        call->running = false;
+        os_fiber_yield(call->fiber);
+    }
+}
+
+/* Run the fiber until the call returns or is suspended */
+static wasm_async_status_t
+switch_to_fiber(WASMAsyncCall *call)
+{
+    WASMExecEnv *exec_env = call->exec_env;
+
+    save_stack_info(exec_env, &call->host_info);
+    restore_stack_info(exec_env, &call->fiber_info);
+
+    if (os_fiber_resume(call->fiber) != BHT_OK) {
+        restore_stack_info(exec_env, &call->host_info);
+        wasm_runtime_set_exception(exec_env->module_inst,
+                                   "resume async call failed");
+        call->running = false;
+        return WASM_ASYNC_FAILED;
+    }
+
+    save_stack_info(exec_env, &call->fiber_info);
+    restore_stack_info(exec_env, &call->host_info);
+
+    if (call->running)
+        return WASM_ASYNC_SUSPENDED;
+    return call->call_ret ? WASM_ASYNC_DONE : WASM_ASYNC_FAILED;
+}
+
+wasm_async_status_t
+wasm_runtime_call_wasm_async(WASMExecEnv *exec_env,
+                             WASMFunctionInstanceCommon *function,
+                             uint32 argc, uint32 argv[])
+{
+    WASMAsyncCall *call = exec_env->async_call;
+    uint8 *stack_boundary;
+
+    if (call && call->running) {
+        LOG_ERROR("Exec env is running an async call.");
+        return WASM_ASYNC_FAILED;
+    }
+
+    if (!call) {
+        if (!(call = wasm_runtime_malloc(sizeof(WASMAsyncCall)))) {
+            wasm_runtime_set_exception(exec_env->module_inst,
+                                       "allocate memory failed");
+            return WASM_ASYNC_FAILED;
+        }
+        memset(call, 0, sizeof(WASMAsyncCall));
+        if (!(call->fiber = os_fiber_create(async_call_entry, call,
+                                            WASM_ASYNC_CALL_STACK_SIZE))) {
+            wasm_runtime_free(call);
+            wasm_runtime_set_exception(exec_env->module_inst,
+                                       "create async call stack failed");
+            return WASM_ASYNC_FAILED;
+        }
+        call->exec_env = exec_env;
+        exec_env->async_call = call;
+    }
+
+    call->function = function;
+    call->argc = argc;
+    call->argv = argv;
+    call->handle = os_self_thread();
+    call->running = true;
+    call->suspended = false;
+    call->canceled = false;
+
+    /* The boundary is picked up by wasm_exec_env_set_thread_info */
+    stack_boundary = os_fiber_get_stack_boundary(call->fiber);
+    call->fiber_info.native_stack_boundary =
+        call->fiber_info.user_native_stack_boundary =
+            stack_boundary + WASM_STACK_GUARD_SIZE;
+    call->fiber_info.native_stack_top_min = (uint8 *)UINTPTR_MAX;
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    call->fiber_info.exec_env_tls = NULL;
+#endif
+
+    return switch_to_fiber(call);
+}
+
+bool
+wasm_runtime_suspend(WASMExecEnv *exec_env, uint64 *p_result)
+{
+    WASMAsyncCall *call = exec_env->async_call;
+
+    if (!call || !call->running || call->suspended || call->canceled)
+        return false;
+
+    call->suspended = true;
+    os_fiber_yield(call->fiber);
+    call->suspended = false;
+
+    if (call->canceled) {
+        wasm_runtime_set_exception(exec_env->module_inst,
+                                   "async call canceled");
+        return false;
+    }
+
+    *p_result = call->resume_value;
+    return true;
+}
+
+wasm_async_status_t
+wasm_runtime_resume(WASMExecEnv *exec_env, uint64 result)
+{
+    WASMAsyncCall *call = exec_env->async_call;
+
+    if (!call || !call->suspended) {
+        LOG_ERROR("Exec env has no suspended async call.");
+        return WASM_ASYNC_FAILED;
+    }
+
+    if (call->handle != os_self_thread()) {
+        LOG_ERROR("Async call must be resumed by the thread starting it.");
+        return WASM_ASYNC_FAILED;
+    }
+
+    call->resume_value = result;
+    return switch_to_fiber(call);
+}
+
+void
+wasm_runtime_destroy_async_call(WASMExecEnv *exec_env)
+{
+    WASMAsyncCall *call = exec_env->async_call;
+
+    if (call->suspended) {
+        /* Unwind the suspended call, wasm_runtime_suspend returns false
+           with an exception thrown and the call can't be suspended again */
+        bh_assert(call->handle == os_self_thread());
+        call->canceled = true;
+        switch_to_fiber(call);
+        bh_assert(!call->running);
+    }
+
+    os_fiber_destroy(call->fiber);
+    wasm_runtime_free(call);
+    exec_env->async_call = NULL;
+}
+
+#else /* else of OS_ENABLE_FIBER */
+
+wasm_async_status_t
+wasm_runtime_call_wasm_async(WASMExecEnv *exec_env,
+                             WASMFunctionInstanceCommon *function,
+                             uint32 argc, uint32 argv[])
+{
+    (void)function;
+    (void)argc;
+    (void)argv;
+    wasm_runtime_set_exception(exec_env->module_inst,
+                               "async call isn't supported by the platform");
+    return WASM_ASYNC_FAILED;
+}
+
+bool
+wasm_runtime_suspend(WASMExecEnv *exec_env, uint64 *p_result)
+{
+    (void)exec_env;
+    (void)p_result;
+    return false;
+}
+
+wasm_async_status_t
+wasm_runtime_resume(WASMExecEnv *exec_env, uint64 result)
+{
+    (void)exec_env;
+    (void)result;
+    LOG_ERROR("Exec env has no suspended async call.");
+    return WASM_ASYNC_FAILED;
+}
+
+void
+wasm_runtime_destroy_async_call(WASMExecEnv *exec_env)
+{
+    (void)exec_env;
+}
+
+#endif /* end of OS_ENABLE_FIBER */
+
+#endif /* end of WASM_ENABLE_ASYNC_CALL != 0 */
@@ -113,9 +113,17 @@ fail1:
 void
 wasm_exec_env_destroy_internal(WASMExecEnv *exec_env)
 {
+#if WASM_ENABLE_ASYNC_CALL != 0
+    if (exec_env->async_call)
+        wasm_runtime_destroy_async_call(exec_env);
+#endif
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     os_munmap(exec_env->exce_check_guard_page, os_getpagesize());
 #endif
+#ifdef OS_ENABLE_IO_URING
+    if (exec_env->io_ring)
+        os_io_ring_destroy(exec_env->io_ring);
+#endif
 #if WASM_ENABLE_THREAD_MGR != 0
     os_mutex_destroy(&exec_env->wait_lock);
     os_cond_destroy(&exec_env->wait_cond);
@@ -188,6 +196,23 @@ wasm_exec_env_create(struct WASMModuleInstanceCommon *module_inst,
     mem_allocator_enable_gc_reclaim(gc_heap_handle, exec_env);
 #endif
 #endif /* end of WASM_ENABLE_THREAD_MGR */
+#if WASM_ENABLE_GC != 0
+    mem_allocator_set_gc_pause_budget(
+        gc_heap_handle, wasm_runtime_get_gc_pause_budget_default());
+#if WASM_ENABLE_GC_NURSERY != 0
+#if WASM_ENABLE_AOT != 0
+    /* The AOT code compiled by the old wamrc doesn't call write barrier */
+    if (module_inst->module_type == Wasm_Module_AoT
+        && !(((AOTModule *)((AOTModuleInstance *)module_inst)->module)
+                 ->feature_flags
+             & WASM_FEATURE_GC_WRITE_BARRIER))
+        mem_allocator_set_gc_nursery_size(gc_heap_handle, 0);
+    else
+#endif
+        mem_allocator_set_gc_nursery_size(
+            gc_heap_handle, wasm_runtime_get_gc_nursery_size_default());
+#endif
+#endif
 
     return exec_env;
 }
@@ -309,6 +334,16 @@ wasm_exec_env_set_thread_arg(WASMExecEnv *exec_env, void *thread_arg)
 }
 #endif
 
+#ifdef OS_ENABLE_IO_URING
+os_io_ring *
+wasm_exec_env_get_io_ring(WASMExecEnv *exec_env)
+{
+    if (!exec_env->io_ring)
+        exec_env->io_ring = os_io_ring_create();
+    return exec_env->io_ring;
+}
+#endif
+
 #ifdef OS_ENABLE_HW_BOUND_CHECK
 void
 wasm_exec_env_push_jmpbuf(WASMExecEnv *exec_env, WASMJmpBuf *jmpbuf)
@@ -118,6 +118,12 @@ typedef struct WASMExecEnv {
     /* whether current thread is detached */
     bool thread_is_detached;
 
+    /* whether current thread runs on a native thread of the thread
+       pool of the cluster, see wasm_cluster_create_pooled_thread */
+    bool thread_is_pooled;
+    /* the ticket of the pooled thread, see thread_pool_run_thread */
+    uint64 pool_ticket;
+
     /* whether the aux stack is allocated */
     bool is_aux_stack_allocated;
 #endif
@@ -153,6 +159,18 @@ typedef struct WASMExecEnv {
     uint8 *exce_check_guard_page;
 #endif
 
+#ifdef OS_ENABLE_IO_URING
+    /* The ring to submit the WASI I/O of the thread, created on first use,
+       see wasm_exec_env_get_io_ring */
+    os_io_ring *io_ring;
+#endif
+
+#if WASM_ENABLE_ASYNC_CALL != 0
+    /* The state of the async call, created by the first call of
+       wasm_runtime_call_wasm_async and reused by the later ones */
+    struct WASMAsyncCall *async_call;
+#endif
+
 #if WASM_ENABLE_MEMORY_PROFILING != 0
     uint32 max_wasm_stack_used;
 #endif
@@ -308,6 +326,18 @@ void
 wasm_exec_env_set_thread_arg(WASMExecEnv *exec_env, void *thread_arg);
 #endif
 
+#ifdef OS_ENABLE_IO_URING
+/**
+ * Get the io_uring of the exec env, create it if it hasn't been created
+ *
+ * @param exec_env the execution environment
+ *
+ * @return the ring, or NULL if io_uring isn't available
+ */
+os_io_ring *
+wasm_exec_env_get_io_ring(WASMExecEnv *exec_env);
+#endif
+
 #ifdef OS_ENABLE_HW_BOUND_CHECK
 void
 wasm_exec_env_push_jmpbuf(WASMExecEnv *exec_env, WASMJmpBuf *jmpbuf);
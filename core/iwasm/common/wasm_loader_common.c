@@ -152,7 +152,7 @@ bool
 is_valid_value_type_for_interpreter(uint8 value_type)
 {
 #if (WASM_ENABLE_WAMR_COMPILER == 0) && (WASM_ENABLE_JIT == 0) \
-    && (WASM_ENABLE_FAST_INTERP == 0)
+    && (WASM_ENABLE_FAST_INTERP == 0) && (WASM_ENABLE_FAST_JIT == 0)
     /*
      * Note: regardless of WASM_ENABLE_SIMD, our interpreters don't have
      * SIMD implemented. It's safer to reject v128, especially for the
@@ -224,3 +224,193 @@ read_leb(uint8 **p_buf, const uint8 *buf_end, uint32 maxbits, bool sign,
             return false;
     }
 }
+
+/* Header placed before each string in the const string arena */
+typedef struct ConstStrHeader {
+    uint32 hash;
+    uint32 len;
+} ConstStrHeader;
+
+#define CONST_STR_BLOCK_SIZE 4096
+#define CONST_STR_POOL_INIT_SLOTS 64
+
+static uint32
+const_str_hash(const uint8 *str, uint32 len)
+{
+    const uint8 *p = str, *end = str + len;
+    uint32 h = len;
+
+    /* Same hash as wasm_string_hash, but on a sized buffer */
+    while (p != end)
+        h = ((h << 5) - h) + *p++;
+    return h;
+}
+
+static inline ConstStrHeader *
+const_str_header(const char *str)
+{
+    return (ConstStrHeader *)(str - sizeof(ConstStrHeader));
+}
+
+static bool
+const_str_pool_resize(ConstStrPool *pool, uint32 slot_count, bool is_aot,
+                      char *error_buf, uint32 error_buf_size)
+{
+    uint64 size = sizeof(char *) * (uint64)slot_count;
+    uint32 mask = slot_count - 1, i, j;
+    char **slots;
+
+    if (size >= UINT32_MAX || !(slots = wasm_runtime_malloc((uint32)size))) {
+        wasm_loader_set_error_buf(error_buf, error_buf_size,
+                                  "allocate memory failed", is_aot);
+        return false;
+    }
+    memset(slots, 0, (uint32)size);
+
+    for (i = 0; i < pool->slot_count; i++) {
+        if (pool->slots[i]) {
+            j = const_str_header(pool->slots[i])->hash & mask;
+            while (slots[j])
+                j = (j + 1) & mask;
+            slots[j] = pool->slots[i];
+        }
+    }
+
+    if (pool->slots)
+        wasm_runtime_free(pool->slots);
+    pool->slots = slots;
+    pool->slot_count = slot_count;
+    return true;
+}
+
+static ConstStrBlock *
+const_str_block_new(uint64 block_size, bool is_aot, char *error_buf,
+                    uint32 error_buf_size)
+{
+    uint64 total_size = offsetof(ConstStrBlock, data) + block_size;
+    ConstStrBlock *block;
+
+    if (total_size >= UINT32_MAX
+        || !(block = wasm_runtime_malloc((uint32)total_size))) {
+        wasm_loader_set_error_buf(error_buf, error_buf_size,
+                                  "allocate memory failed", is_aot);
+        return NULL;
+    }
+    block->size = (uint32)block_size;
+    block->used = 0;
+    block->next = NULL;
+    return block;
+}
+
+static char *
+const_str_pool_alloc(ConstStrPool *pool, uint32 len, bool is_aot,
+                     char *error_buf, uint32 error_buf_size)
+{
+    ConstStrBlock *block = pool->blocks;
+    ConstStrHeader *header;
+    uint64 entry_size;
+
+    entry_size = align_uint64(sizeof(ConstStrHeader) + (uint64)len + 1, 4);
+
+    if (entry_size > CONST_STR_BLOCK_SIZE / 4) {
+        /* A big string is allocated on its own and kept behind the head,
+           so that the free space of the current block can still be used */
+        if (!(block = const_str_block_new(entry_size, is_aot, error_buf,
+                                          error_buf_size)))
+            return NULL;
+        if (pool->blocks) {
+            block->next = pool->blocks->next;
+            pool->blocks->next = block;
+        }
+        else {
+            pool->blocks = block;
+        }
+    }
+    else if (!block || (uint64)(block->size - block->used) < entry_size) {
+        if (!(block = const_str_block_new(CONST_STR_BLOCK_SIZE, is_aot,
+                                          error_buf, error_buf_size)))
+            return NULL;
+        block->next = pool->blocks;
+        pool->blocks = block;
+    }
+
+    header = (ConstStrHeader *)(block->data + block->used);
+    block->used += (uint32)entry_size;
+    header->len = len;
+    return (char *)(header + 1);
+}
+
+char *
+wasm_const_str_pool_insert(ConstStrPool *pool, const uint8 *str, uint32 len,
+                           bool is_aot, char *error_buf, uint32 error_buf_size)
+{
+    uint32 hash = const_str_hash(str, len), mask, i;
+    ConstStrHeader *header;
+    char *c_str;
+
+    if (pool->slots) {
+        mask = pool->slot_count - 1;
+        for (i = hash & mask; pool->slots[i]; i = (i + 1) & mask) {
+            c_str = pool->slots[i];
+            header = const_str_header(c_str);
+            if (header->hash == hash && header->len == len
+                && !memcmp(c_str, str, len))
+                return c_str;
+        }
+    }
+
+    /* Keep the load factor under 3/4 */
+    if (!pool->slots
+        && !const_str_pool_resize(pool, CONST_STR_POOL_INIT_SLOTS, is_aot,
+                                  error_buf, error_buf_size))
+        return NULL;
+    if ((uint64)(pool->str_count + 1) * 4 > (uint64)pool->slot_count * 3
+        && !const_str_pool_resize(pool, pool->slot_count * 2, is_aot,
+                                  error_buf, error_buf_size))
+        return NULL;
+
+    if (!(c_str = const_str_pool_alloc(pool, len, is_aot, error_buf,
+                                       error_buf_size)))
+        return NULL;
+
+    const_str_header(c_str)->hash = hash;
+    bh_memcpy_s(c_str, len + 1, str, len);
+    c_str[len] = '\0';
+
+    mask = pool->slot_count - 1;
+    for (i = hash & mask; pool->slots[i]; i = (i + 1) & mask)
+        ;
+    pool->slots[i] = c_str;
+    pool->str_count++;
+    return c_str;
+}
+
+uint32
+wasm_const_str_pool_get_mem_size(const ConstStrPool *pool)
+{
+    ConstStrBlock *block = pool->blocks;
+    uint32 size = (uint32)sizeof(char *) * pool->slot_count;
+
+    while (block) {
+        size += (uint32)offsetof(ConstStrBlock, data) + block->size;
+        block = block->next;
+    }
+    return size;
+}
+
+void
+wasm_const_str_pool_destroy(ConstStrPool *pool)
+{
+    ConstStrBlock *block = pool->blocks, *block_next;
+
+    while (block) {
+        block_next = block->next;
+        wasm_runtime_free(block);
+        block = block_next;
+    }
+
+    if (pool->slots)
+        wasm_runtime_free(pool->slots);
+
+    memset(pool, 0, sizeof(ConstStrPool));
+}
@@ -50,6 +50,29 @@ void
 wasm_loader_set_error_buf(char *error_buf, uint32 error_buf_size,
                           const char *string, bool is_aot);
 
+/**
+ * Intern a string into the constant string pool of a module.
+ *
+ * @param pool the constant string pool
+ * @param str the string, which needn't be terminated with '\0'
+ * @param len the length of the string, not including any terminator
+ * @param is_aot whether the pool belongs to an AOT module
+ * @param error_buf buffer to output the error info if failed
+ * @param error_buf_size the size of the error buffer
+ *
+ * @return the interned '\0' terminated copy, which lives until the pool
+ * is destroyed, or NULL if failed
+ */
+char *
+wasm_const_str_pool_insert(ConstStrPool *pool, const uint8 *str, uint32 len,
+                           bool is_aot, char *error_buf, uint32 error_buf_size);
+
+uint32
+wasm_const_str_pool_get_mem_size(const ConstStrPool *pool);
+
+void
+wasm_const_str_pool_destroy(ConstStrPool *pool);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,41 @@ static WASMSharedHeap *shared_heap_list = NULL;
 static korp_mutex shared_heap_list_lock;
 #endif
 
+/* The linear memory pool reserves the regions mapped for linear memories
+   when hardware bound check is enabled and recycles them across module
+   instances, see RuntimeInitArgs.linear_memory_pool_slots */
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && defined(OS_ENABLE_MEM_DISCARD) \
+    && WASM_MEM_ALLOC_WITH_USAGE == 0
+#define WASM_LINEAR_MEMORY_POOL 1
+#else
+#define WASM_LINEAR_MEMORY_POOL 0
+#endif
+
+#if WASM_LINEAR_MEMORY_POOL != 0
+typedef struct LinearMemorySlot {
+    uint8 *base;
+    /* Size of the readable and writable range from base */
+    uint64 accessible_size;
+    /* Size of the range from base which is mapped to a memfd by instance
+       snapshot, it can't be reset to zero by discarding the pages */
+    uint64 remapped_size;
+    /* Whether the slot has been used by a linear memory */
+    bool used;
+    struct LinearMemorySlot *next_free;
+} LinearMemorySlot;
+
+typedef struct LinearMemoryPool {
+    korp_mutex lock;
+    /* Slots sorted by base address */
+    LinearMemorySlot *slots;
+    uint32 slot_num;
+    LinearMemorySlot *free_list;
+    linear_memory_pool_stats_t stats;
+} LinearMemoryPool;
+
+static LinearMemoryPool *linear_memory_pool = NULL;
+#endif
+
 static enlarge_memory_error_callback_t enlarge_memory_error_cb;
 static void *enlarge_memory_error_user_data;
 
@@ -83,6 +118,12 @@ wasm_memory_init_with_pool(void *mem, unsigned int bytes)
     mem_allocator_t allocator = mem_allocator_create(mem, bytes);
 
     if (allocator) {
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0 \
+    && DEFAULT_MEM_ALLOCATOR == MEM_ALLOCATOR_EMS
+        /* The pool is shared by all the threads */
+        if (!mem_allocator_enable_thread_cache(allocator))
+            LOG_WARNING("Enable thread caches of the pool failed.\n");
+#endif
         memory_mode = MEMORY_MODE_POOL;
         pool_allocator = allocator;
         global_pool_size = bytes;
@@ -506,6 +547,244 @@ wasm_runtime_shared_heap_free(WASMModuleInstanceCommon *module_inst, uint64 ptr)
 }
 #endif /* end of WASM_ENABLE_SHARED_HEAP != 0 */
 
+#if WASM_LINEAR_MEMORY_POOL != 0
+static int
+linear_memory_slot_cmp(const void *a, const void *b)
+{
+    const uint8 *base_a = ((const LinearMemorySlot *)a)->base;
+    const uint8 *base_b = ((const LinearMemorySlot *)b)->base;
+
+    return base_a < base_b ? -1 : (base_a > base_b ? 1 : 0);
+}
+
+static void
+linear_memory_pool_destroy(void)
+{
+    LinearMemoryPool *pool = linear_memory_pool;
+    uint32 i;
+
+    if (!pool)
+        return;
+
+    for (i = 0; i < pool->slot_num; i++) {
+        os_munmap(pool->slots[i].base, 8 * (uint64)BH_GB);
+    }
+    os_mutex_destroy(&pool->lock);
+    wasm_runtime_free(pool);
+    linear_memory_pool = NULL;
+}
+
+static LinearMemorySlot *
+linear_memory_pool_find_slot(uint8 *data)
+{
+    LinearMemoryPool *pool = linear_memory_pool;
+    int64 low = 0, high, mid;
+
+    if (!pool)
+        return NULL;
+
+    high = (int64)pool->slot_num - 1;
+    while (low <= high) {
+        mid = (low + high) / 2;
+        if (pool->slots[mid].base == data)
+            return &pool->slots[mid];
+        else if (pool->slots[mid].base < data)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return NULL;
+}
+
+static uint8 *
+linear_memory_pool_acquire(uint64 commit_size)
+{
+    LinearMemoryPool *pool = linear_memory_pool;
+    LinearMemorySlot *slot;
+    bool reused;
+    int ret = 0;
+
+    if (!pool)
+        return NULL;
+
+    os_mutex_lock(&pool->lock);
+    if (!(slot = pool->free_list)) {
+        pool->stats.fallback_count++;
+        os_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+    pool->free_list = slot->next_free;
+    pool->stats.slots_in_use++;
+    os_mutex_unlock(&pool->lock);
+
+    /* Only change the protection of the range which differs from the
+       previous linear memory, the instances of the same module usually
+       need no change at all */
+    if (slot->accessible_size < commit_size) {
+        ret = os_mprotect(slot->base + slot->accessible_size,
+                          commit_size - slot->accessible_size,
+                          MMAP_PROT_READ | MMAP_PROT_WRITE);
+    }
+    else if (slot->accessible_size > commit_size) {
+        ret = os_mprotect(slot->base + commit_size,
+                          slot->accessible_size - commit_size,
+                          MMAP_PROT_NONE);
+    }
+    if (ret == 0)
+        slot->accessible_size = commit_size;
+
+    os_mutex_lock(&pool->lock);
+    if (ret != 0) {
+        slot->next_free = pool->free_list;
+        pool->free_list = slot;
+        pool->stats.slots_in_use--;
+        pool->stats.fallback_count++;
+        slot = NULL;
+    }
+    else {
+        reused = slot->used;
+        slot->used = true;
+        pool->stats.acquire_count++;
+        if (reused)
+            pool->stats.reuse_count++;
+    }
+    os_mutex_unlock(&pool->lock);
+
+    return slot ? slot->base : NULL;
+}
+
+static bool
+linear_memory_pool_release(uint8 *data, uint64 accessible_size)
+{
+    LinearMemoryPool *pool = linear_memory_pool;
+    LinearMemorySlot *slot;
+    uint64 remapped_size;
+    bool reset = true;
+
+    if (!(slot = linear_memory_pool_find_slot(data)))
+        return false;
+
+    /* Reset the dirty pages to zero, the range keeps accessible so that
+       the next linear memory of similar size needn't change it */
+    remapped_size = slot->remapped_size;
+#ifdef OS_ENABLE_MEMFD
+    if (remapped_size > 0
+        && os_memfd_unmap_private(slot->base, remapped_size) != 0)
+        reset = false;
+#endif
+    slot->remapped_size = 0;
+    if (reset && accessible_size > remapped_size
+        && os_mem_discard(slot->base + remapped_size,
+                          accessible_size - remapped_size)
+               != 0)
+        reset = false;
+    slot->accessible_size = accessible_size;
+
+    os_mutex_lock(&pool->lock);
+    pool->stats.slots_in_use--;
+    if (reset) {
+        slot->next_free = pool->free_list;
+        pool->free_list = slot;
+        pool->stats.release_count++;
+    }
+    else {
+        /* Retire the slot, it is unmapped when the pool is destroyed */
+        LOG_WARNING("Reset linear memory slot %p failed", slot->base);
+        pool->stats.slot_count--;
+    }
+    os_mutex_unlock(&pool->lock);
+
+    return true;
+}
+
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+static void
+linear_memory_pool_set_remapped(uint8 *data, uint64 remapped_size)
+{
+    LinearMemorySlot *slot = linear_memory_pool_find_slot(data);
+
+    if (slot && slot->remapped_size < remapped_size)
+        slot->remapped_size = remapped_size;
+}
+#endif
+#endif /* end of WASM_LINEAR_MEMORY_POOL != 0 */
+
+bool
+wasm_runtime_linear_memory_pool_init(uint32 slot_count)
+{
+#if WASM_LINEAR_MEMORY_POOL != 0
+    LinearMemoryPool *pool;
+    uint64 total_size;
+    uint32 i;
+
+    if (slot_count == 0)
+        return true;
+
+    bh_assert(!linear_memory_pool);
+
+    total_size = sizeof(LinearMemoryPool)
+                 + sizeof(LinearMemorySlot) * (uint64)slot_count;
+    if (total_size >= UINT32_MAX
+        || !(pool = wasm_runtime_malloc((uint32)total_size))) {
+        LOG_ERROR("Allocate linear memory pool failed");
+        return false;
+    }
+    memset(pool, 0, (uint32)total_size);
+    pool->slots = (LinearMemorySlot *)(pool + 1);
+
+    if (os_mutex_init(&pool->lock) != 0) {
+        wasm_runtime_free(pool);
+        return false;
+    }
+    linear_memory_pool = pool;
+
+    for (i = 0; i < slot_count; i++) {
+        /* See wasm_allocate_linear_memory for the size */
+        if (!(pool->slots[i].base =
+                  os_mmap(NULL, 8 * (uint64)BH_GB, MMAP_PROT_NONE,
+                          MMAP_MAP_NONE, os_get_invalid_handle()))) {
+            LOG_ERROR("Reserve linear memory slot %" PRIu32 " failed", i);
+            linear_memory_pool_destroy();
+            return false;
+        }
+        pool->slot_num++;
+    }
+
+    qsort(pool->slots, slot_count, sizeof(LinearMemorySlot),
+          linear_memory_slot_cmp);
+    for (i = slot_count; i > 0; i--) {
+        pool->slots[i - 1].next_free = pool->free_list;
+        pool->free_list = &pool->slots[i - 1];
+    }
+    pool->stats.slot_count = slot_count;
+    return true;
+#else
+    if (slot_count > 0)
+        LOG_WARNING("warning: linear memory pool is only supported on Linux "
+                    "with hardware bound check enabled");
+    return true;
+#endif
+}
+
+bool
+wasm_runtime_get_linear_memory_pool_stats(linear_memory_pool_stats_t *stats)
+{
+#if WASM_LINEAR_MEMORY_POOL != 0
+    LinearMemoryPool *pool = linear_memory_pool;
+
+    if (!pool || !stats)
+        return false;
+
+    os_mutex_lock(&pool->lock);
+    *stats = pool->stats;
+    os_mutex_unlock(&pool->lock);
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
 bool
 wasm_runtime_memory_init(mem_alloc_type_t mem_alloc_type,
                          const MemAllocOption *alloc_option)
@@ -539,6 +818,13 @@ wasm_runtime_memory_init(mem_alloc_type_t mem_alloc_type,
         ret = false;
     }
 
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_PARALLEL_MARK != 0
+    if (ret && !mem_allocator_init_gc_mark_pool()) {
+        wasm_runtime_memory_destroy();
+        return false;
+    }
+#endif
+
 #if WASM_ENABLE_SHARED_HEAP != 0
     if (!ret) {
         os_mutex_destroy(&shared_heap_list_lock);
@@ -581,10 +867,18 @@ destroy_shared_heaps()
 void
 wasm_runtime_memory_destroy(void)
 {
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_PARALLEL_MARK != 0
+    mem_allocator_destroy_gc_mark_pool();
+#endif
+
 #if WASM_ENABLE_SHARED_HEAP != 0
     destroy_shared_heaps();
 #endif
 
+#if WASM_LINEAR_MEMORY_POOL != 0
+    linear_memory_pool_destroy();
+#endif
+
     if (memory_mode == MEMORY_MODE_POOL) {
 #if BH_ENABLE_GC_VERIFY == 0
         (void)mem_allocator_destroy(pool_allocator);
@@ -1692,8 +1986,12 @@ wasm_deallocate_linear_memory(WASMMemoryInstance *memory_inst)
 #endif
               memory_inst->memory_data);
 #else
-    wasm_munmap_linear_memory(memory_inst->memory_data,
-                              memory_inst->memory_data_size, map_size);
+#if WASM_LINEAR_MEMORY_POOL != 0
+    if (!linear_memory_pool_release(memory_inst->memory_data,
+                                    memory_inst->memory_data_size))
+#endif
+        wasm_munmap_linear_memory(memory_inst->memory_data,
+                                  memory_inst->memory_data_size, map_size);
 #endif
 
     memory_inst->memory_data = NULL;
@@ -1747,9 +2045,13 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
             return BHT_ERROR;
         }
 #else
-        if (!(*data = wasm_mmap_linear_memory(map_size, *memory_data_size))) {
-            return BHT_ERROR;
-        }
+#if WASM_LINEAR_MEMORY_POOL != 0
+        if (!(*data = linear_memory_pool_acquire(*memory_data_size)))
+#endif
+            if (!(*data =
+                      wasm_mmap_linear_memory(map_size, *memory_data_size))) {
+                return BHT_ERROR;
+            }
 #endif
     }
 
@@ -1761,3 +2063,159 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
 
     return BHT_OK;
 }
+
+#if WASM_ENABLE_INSTANCE_SNAPSHOT != 0
+bool
+wasm_memory_snapshot_init(WASMMemorySnapshot *snapshot,
+                          const WASMMemoryInstance *memory)
+{
+    uint64 copy_offset = 0, copy_size;
+    uint32 heap_struct_size;
+
+    memset(snapshot, 0, sizeof(WASMMemorySnapshot));
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+    snapshot->memfd = os_get_invalid_handle();
+#endif
+
+    snapshot->num_bytes_per_page = memory->num_bytes_per_page;
+    snapshot->cur_page_count = memory->cur_page_count;
+    snapshot->max_page_count = memory->max_page_count;
+    snapshot->memory_data_size = memory->memory_data_size;
+    snapshot->heap_offset = (uint64)(memory->heap_data - memory->memory_data);
+    snapshot->heap_size = (uint32)(memory->heap_data_end - memory->heap_data);
+
+    if (snapshot->heap_size > 0) {
+        if (mem_allocator_is_heap_corrupted(memory->heap_handle)) {
+            wasm_runtime_show_app_heap_corrupted_prompt();
+            goto fail;
+        }
+
+        heap_struct_size = mem_allocator_get_heap_struct_size();
+        if (!(snapshot->heap_struct = wasm_runtime_malloc(heap_struct_size))) {
+            LOG_WARNING("Allocate memory failed");
+            goto fail;
+        }
+        bh_memcpy_s(snapshot->heap_struct, heap_struct_size,
+                    memory->heap_handle, heap_struct_size);
+    }
+
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+    snapshot->memfd_size =
+        memory->memory_data_size & ~((uint64)os_getpagesize() - 1);
+
+    if (snapshot->memfd_size > 0) {
+        if (os_memfd_create(memory->memory_data, snapshot->memfd_size,
+                            &snapshot->memfd)
+            == 0) {
+            copy_offset = snapshot->memfd_size;
+        }
+        else {
+            /* Fall back to copying the whole linear memory */
+            LOG_WARNING("warning: failed to create memfd for snapshot");
+            snapshot->memfd = os_get_invalid_handle();
+            snapshot->memfd_size = 0;
+        }
+    }
+#endif
+
+    copy_size = memory->memory_data_size - copy_offset;
+    if (copy_size > 0) {
+        if (copy_size >= UINT32_MAX
+            || !(snapshot->memory_data =
+                     wasm_runtime_malloc((uint32)copy_size))) {
+            LOG_WARNING("Allocate memory failed");
+            goto fail;
+        }
+        bh_memcpy_s(snapshot->memory_data, (uint32)copy_size,
+                    memory->memory_data + copy_offset, (uint32)copy_size);
+    }
+
+    return true;
+
+fail:
+    wasm_memory_snapshot_destroy(snapshot);
+    return false;
+}
+
+bool
+wasm_memory_snapshot_restore(const WASMMemorySnapshot *snapshot,
+                             WASMModuleInstanceCommon *module_inst,
+                             WASMMemoryInstance *memory)
+{
+    uint64 copy_offset = 0, copy_size;
+
+    /* The instance was created with the same arguments as the snapshotted
+       instance, so the layout of linear memory must be the same, except
+       that the snapshotted instance may have grown its memory */
+    if (memory->num_bytes_per_page != snapshot->num_bytes_per_page
+        || memory->cur_page_count > snapshot->cur_page_count
+        || (uint64)(memory->heap_data - memory->memory_data)
+               != snapshot->heap_offset
+        || (uint32)(memory->heap_data_end - memory->heap_data)
+               != snapshot->heap_size) {
+        LOG_ERROR("Linear memory layout mismatches with the snapshot");
+        return false;
+    }
+
+    memory->max_page_count = snapshot->max_page_count;
+    if (memory->cur_page_count < snapshot->cur_page_count
+        && !wasm_enlarge_memory_internal(
+            module_inst, memory,
+            snapshot->cur_page_count - memory->cur_page_count)) {
+        LOG_ERROR("Enlarge linear memory for the snapshot failed");
+        return false;
+    }
+    bh_assert(memory->memory_data_size == snapshot->memory_data_size);
+
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+    if (snapshot->memfd_size > 0) {
+        /* Replace the committed pages with the private mapping of memfd,
+           the pages are only copied when the instance writes them */
+#if WASM_LINEAR_MEMORY_POOL != 0
+        linear_memory_pool_set_remapped(memory->memory_data,
+                                        snapshot->memfd_size);
+#endif
+        if (!os_memfd_map_private(memory->memory_data, snapshot->memfd_size,
+                                  snapshot->memfd)) {
+            return false;
+        }
+        copy_offset = snapshot->memfd_size;
+    }
+#endif
+
+    copy_size = snapshot->memory_data_size - copy_offset;
+    if (copy_size > 0) {
+        bh_memcpy_s(memory->memory_data + copy_offset, (uint32)copy_size,
+                    snapshot->memory_data, (uint32)copy_size);
+    }
+
+    if (snapshot->heap_size > 0
+        && mem_allocator_restore(memory->heap_handle, snapshot->heap_struct,
+                                 (char *)memory->heap_data, snapshot->heap_size)
+               != 0) {
+        LOG_ERROR("Restore app heap from the snapshot failed");
+        return false;
+    }
+
+    return true;
+}
+
+void
+wasm_memory_snapshot_destroy(WASMMemorySnapshot *snapshot)
+{
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+    if (snapshot->memfd != os_get_invalid_handle()) {
+        os_memfd_close(snapshot->memfd);
+        snapshot->memfd = os_get_invalid_handle();
+    }
+#endif
+    if (snapshot->memory_data) {
+        wasm_runtime_free(snapshot->memory_data);
+        snapshot->memory_data = NULL;
+    }
+    if (snapshot->heap_struct) {
+        wasm_runtime_free(snapshot->heap_struct);
+        snapshot->heap_struct = NULL;
+    }
+}
+#endif /* end of WASM_ENABLE_INSTANCE_SNAPSHOT != 0 */
@@ -80,6 +80,9 @@ wasm_runtime_memory_destroy(void);
 unsigned
 wasm_runtime_memory_pool_size(void);
 
+bool
+wasm_runtime_linear_memory_pool_init(uint32 slot_count);
+
 void
 wasm_runtime_set_mem_bound_check_bytes(WASMMemoryInstance *memory,
                                        uint64 memory_data_size);
@@ -97,6 +100,51 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
                             uint64 init_page_count, uint64 max_page_count,
                             uint64 *memory_data_size);
 
+#if WASM_ENABLE_INSTANCE_SNAPSHOT != 0
+/* Whether the linear memory of a snapshot is mapped copy-on-write into
+   the new instances: it requires the linear memory to be allocated by
+   mmap and to be grown in place, which is the case when hardware bound
+   check is enabled */
+#if defined(OS_ENABLE_MEMFD) && defined(OS_ENABLE_HW_BOUND_CHECK) \
+    && WASM_MEM_ALLOC_WITH_USAGE == 0
+#define WASM_MEMORY_SNAPSHOT_COW 1
+#else
+#define WASM_MEMORY_SNAPSHOT_COW 0
+#endif
+
+typedef struct WASMMemorySnapshot {
+    uint32 num_bytes_per_page;
+    uint32 cur_page_count;
+    uint32 max_page_count;
+    uint64 memory_data_size;
+    /* Offset of the app heap in linear memory */
+    uint64 heap_offset;
+    uint32 heap_size;
+    /* Copy of the app heap structure, NULL if there is no app heap */
+    uint8 *heap_struct;
+    /* Copy of the linear memory data which isn't kept in memfd */
+    uint8 *memory_data;
+#if WASM_MEMORY_SNAPSHOT_COW != 0
+    /* The memory-backed file holding the leading page-aligned part
+       of linear memory, invalid handle if it isn't created */
+    os_file_handle memfd;
+    uint64 memfd_size;
+#endif
+} WASMMemorySnapshot;
+
+bool
+wasm_memory_snapshot_init(WASMMemorySnapshot *snapshot,
+                          const WASMMemoryInstance *memory);
+
+bool
+wasm_memory_snapshot_restore(const WASMMemorySnapshot *snapshot,
+                             WASMModuleInstanceCommon *module_inst,
+                             WASMMemoryInstance *memory);
+
+void
+wasm_memory_snapshot_destroy(WASMMemorySnapshot *snapshot);
+#endif /* end of WASM_ENABLE_INSTANCE_SNAPSHOT != 0 */
+
 #ifdef __cplusplus
 }
 #endif
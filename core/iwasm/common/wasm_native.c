@@ -259,6 +259,66 @@ wasm_native_resolve_symbol(const char *module_name, const char *field_name,
     return func_ptr;
 }
 
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+void
+wasm_native_precompile_signature(const WASMFuncType *func_type,
+                                 const char *signature,
+                                 WASMNativeCallDesc *desc)
+{
+    uint32 param_count = func_type->param_count, i;
+    const uint8 *types = func_type->types;
+    char sig;
+
+    memset(desc, 0, sizeof(WASMNativeCallDesc));
+
+    if (param_count > QUICK_NATIVE_CALL_MAX_PARAMS
+        || func_type->result_count > 1)
+        return;
+
+    /* The signature has been checked by check_symbol_signature, each
+       param has one character in it */
+    for (i = 0; i < param_count; i++) {
+        sig = signature ? signature[i + 1] : '\0';
+
+        if (types[i] == VALUE_TYPE_I32) {
+            if (sig == '*') {
+                desc->arg_kinds[i] = signature[i + 2] == '~'
+                                         ? NATIVE_ARG_PTR_LEN
+                                         : NATIVE_ARG_PTR;
+                desc->has_ptr_args = true;
+            }
+            else if (sig == '$') {
+                desc->arg_kinds[i] = NATIVE_ARG_STR;
+                desc->has_ptr_args = true;
+            }
+            else {
+                desc->arg_kinds[i] = NATIVE_ARG_I32;
+            }
+        }
+        else if (types[i] == VALUE_TYPE_I64 && sig != '*' && sig != '$') {
+            desc->arg_kinds[i] = NATIVE_ARG_I64;
+        }
+        else {
+            /* leave float, reference and memory64 pointer params to
+               invokeNative */
+            return;
+        }
+    }
+
+    if (func_type->result_count) {
+        if (types[i] == VALUE_TYPE_I32)
+            desc->ret_cell_num = 1;
+        else if (types[i] == VALUE_TYPE_I64)
+            desc->ret_cell_num = 2;
+        else
+            return;
+    }
+
+    desc->param_count = (uint8)param_count;
+    desc->quick = true;
+}
+#endif /* end of WASM_ENABLE_QUICK_NATIVE_CALL != 0 */
+
 static bool
 register_natives(const char *module_name, NativeSymbol *native_symbols,
                  uint32 n_native_symbols, bool call_conv_raw)
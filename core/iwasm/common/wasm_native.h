@@ -55,6 +55,23 @@ wasm_native_resolve_symbol(const char *module_name, const char *field_name,
                            const char **p_signature, void **p_attachment,
                            bool *p_call_conv_raw);
 
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+/**
+ * Precompile the signature of a resolved native symbol, so that it can be
+ * called by wasm_runtime_invoke_native_quick without parsing the signature
+ * string, desc->quick is set to false if the types of its params or result
+ * are not supported
+ *
+ * @param func_type the function prototype of the import function
+ * @param signature the signature output by wasm_native_resolve_symbol
+ * @param desc output the precompiled signature
+ */
+void
+wasm_native_precompile_signature(const WASMFuncType *func_type,
+                                 const char *signature,
+                                 WASMNativeCallDesc *desc);
+#endif
+
 bool
 wasm_native_register_natives(const char *module_name,
                              NativeSymbol *native_symbols,
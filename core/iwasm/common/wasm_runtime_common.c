@@ -33,10 +33,14 @@
 #endif
 #if WASM_ENABLE_FAST_JIT != 0
 #include "../fast-jit/jit_compiler.h"
+#include "../fast-jit/jit_codecache.h"
 #endif
 #if WASM_ENABLE_JIT != 0 || WASM_ENABLE_WAMR_COMPILER != 0
 #include "../compilation/aot_llvm.h"
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+#include "wasm_sampling_profiler.h"
+#endif
 #include "../common/wasm_c_api_internal.h"
 #include "../../version.h"
 
@@ -166,11 +170,16 @@ static JitCompOptions jit_options = { 0 };
 #if WASM_ENABLE_JIT != 0
 /* opt_level: 3, size_level: 3, segue-flags: 0,
    quick_invoke_c_api_import: false */
-static LLVMJITOptions llvm_jit_options = { 3, 3, 0, false };
+static LLVMJITOptions llvm_jit_options = { 3, 3, 0, false, NULL,
+                                           WASM_TIERUP_HOTNESS_THRESHOLD };
 #endif
 
 #if WASM_ENABLE_GC != 0
 static uint32 gc_heap_size_default = GC_HEAP_SIZE_DEFAULT;
+static uint32 gc_pause_budget_default = 0;
+#if WASM_ENABLE_GC_NURSERY != 0
+static uint32 gc_nursery_size_default = GC_NURSERY_SIZE_DEFAULT;
+#endif
 #endif
 
 static RunningMode runtime_running_mode = Mode_Default;
@@ -641,6 +650,10 @@ wasm_runtime_init()
 static void
 wasm_runtime_destroy_internal(void)
 {
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_destroy();
+#endif
+
 #if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
     wasm_externref_map_destroy();
 #endif
@@ -724,6 +737,29 @@ wasm_runtime_get_default_running_mode(void)
     return runtime_running_mode;
 }
 
+bool
+wasm_runtime_get_fast_jit_code_cache_stats(fast_jit_code_cache_stats_t *stats)
+{
+#if WASM_ENABLE_FAST_JIT != 0
+    JitCodeCacheStats cache_stats;
+
+    if (!stats || !jit_code_cache_get_stats(&cache_stats))
+        return false;
+
+    stats->chunk_count = cache_stats.chunk_count;
+    stats->module_chunk_count = cache_stats.module_chunk_count;
+    stats->largest_free_size = cache_stats.largest_free_size;
+    stats->total_size = cache_stats.total_size;
+    stats->max_size = cache_stats.max_size;
+    stats->used_size = cache_stats.used_size;
+    stats->free_size = cache_stats.free_size;
+    return true;
+#else
+    (void)stats;
+    return false;
+#endif
+}
+
 #if WASM_ENABLE_JIT != 0
 LLVMJITOptions *
 wasm_runtime_get_llvm_jit_options(void)
@@ -738,6 +774,20 @@ wasm_runtime_get_gc_heap_size_default(void)
 {
     return gc_heap_size_default;
 }
+
+uint32
+wasm_runtime_get_gc_pause_budget_default(void)
+{
+    return gc_pause_budget_default;
+}
+
+#if WASM_ENABLE_GC_NURSERY != 0
+uint32
+wasm_runtime_get_gc_nursery_size_default(void)
+{
+    return gc_nursery_size_default;
+}
+#endif
 #endif
 
 static bool
@@ -752,8 +802,16 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
         return false;
     }
 
+    if (!wasm_runtime_linear_memory_pool_init(
+            init_args->linear_memory_pool_slots)) {
+        wasm_runtime_memory_destroy();
+        return false;
+    }
+
 #if WASM_ENABLE_FAST_JIT != 0
     jit_options.code_cache_size = init_args->fast_jit_code_cache_size;
+    jit_options.code_cache_max_size = init_args->fast_jit_code_cache_max_size;
+    jit_options.opt_level = init_args->fast_jit_opt_level;
 #endif
 
 #if WASM_ENABLE_GC != 0
@@ -761,12 +819,22 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
     if (gc_heap_size > 0) {
         gc_heap_size_default = gc_heap_size;
     }
+    gc_pause_budget_default = init_args->gc_pause_budget_us;
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (init_args->gc_nursery_size > 0) {
+        gc_nursery_size_default = init_args->gc_nursery_size;
+    }
+#endif
 #endif
 
 #if WASM_ENABLE_JIT != 0
     llvm_jit_options.size_level = init_args->llvm_jit_size_level;
     llvm_jit_options.opt_level = init_args->llvm_jit_opt_level;
     llvm_jit_options.segue_flags = init_args->segue_flags;
+    llvm_jit_options.cache_dir = init_args->llvm_jit_cache_dir;
+    llvm_jit_options.tierup_threshold = WASM_TIERUP_HOTNESS_THRESHOLD;
+    if (init_args->tierup_hotness_threshold > 0)
+        llvm_jit_options.tierup_threshold = init_args->tierup_hotness_threshold;
 #endif
 
 #if WASM_ENABLE_LINUX_PERF != 0
@@ -801,6 +869,9 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
 
 #if WASM_ENABLE_THREAD_MGR != 0
     wasm_cluster_set_max_thread_num(init_args->max_thread_num);
+    if (init_args->thread_pool_size > 0)
+        wasm_cluster_set_thread_pool_options(
+            init_args->thread_pool_size, init_args->thread_idle_timeout_ms);
 #endif
 
     return true;
@@ -1412,6 +1483,12 @@ wasm_runtime_set_max_thread_num(uint32 num)
 {
     wasm_cluster_set_max_thread_num(num);
 }
+
+void
+wasm_runtime_set_thread_pool_options(uint32 pool_size, uint32 idle_timeout_ms)
+{
+    wasm_cluster_set_thread_pool_options(pool_size, idle_timeout_ms);
+}
 #endif /* end of WASM_ENABLE_THREAD_MGR */
 
 static WASMModuleCommon *
@@ -1631,13 +1708,15 @@ wasm_runtime_instantiate_internal(WASMModuleCommon *module,
     if (module->module_type == Wasm_Module_Bytecode)
         return (WASMModuleInstanceCommon *)wasm_instantiate(
             (WASMModule *)module, (WASMModuleInstance *)parent, exec_env_main,
-            stack_size, heap_size, max_memory_pages, error_buf, error_buf_size);
+            stack_size, heap_size, max_memory_pages, false, error_buf,
+            error_buf_size);
 #endif
 #if WASM_ENABLE_AOT != 0
     if (module->module_type == Wasm_Module_AoT)
         return (WASMModuleInstanceCommon *)aot_instantiate(
             (AOTModule *)module, (AOTModuleInstance *)parent, exec_env_main,
-            stack_size, heap_size, max_memory_pages, error_buf, error_buf_size);
+            stack_size, heap_size, max_memory_pages, false, error_buf,
+            error_buf_size);
 #endif
     set_error_buf(error_buf, error_buf_size,
                   "Instantiate module failed, invalid module type");
@@ -1724,6 +1803,356 @@ wasm_runtime_deinstantiate(WASMModuleInstanceCommon *module_inst)
     wasm_runtime_deinstantiate_internal(module_inst, false);
 }
 
+#if WASM_ENABLE_INSTANCE_SNAPSHOT != 0
+typedef struct WASMTableSnapshot {
+    uint32 cur_size;
+    table_elem_type_t *elems;
+} WASMTableSnapshot;
+
+struct WASMInstanceSnapshot {
+    WASMModuleCommon *module;
+    uint32 default_wasm_stack_size;
+    /* The heap size to instantiate the module with */
+    uint32 heap_size;
+    uint32 global_data_size;
+    uint8 *global_data;
+    uint32 table_count;
+    WASMTableSnapshot *tables;
+    uint32 memory_count;
+    WASMMemorySnapshot *memories;
+#if WASM_ENABLE_BULK_MEMORY != 0
+    bh_bitmap *data_dropped;
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    bh_bitmap *elem_dropped;
+#endif
+};
+
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return &((WASMModuleInstanceExtra *)((WASMModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+#endif
+    return NULL;
+}
+
+#if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
+static uint32
+bitmap_map_size(const bh_bitmap *bitmap)
+{
+    return (uint32)((bitmap->end_index - bitmap->begin_index + 7) / 8);
+}
+
+static bh_bitmap *
+bitmap_clone(const bh_bitmap *bitmap)
+{
+    bh_bitmap *bitmap_new;
+
+    if (!(bitmap_new =
+              bh_bitmap_new(bitmap->begin_index,
+                            (unsigned)(bitmap->end_index - bitmap->begin_index))))
+        return NULL;
+
+    bh_memcpy_s(bitmap_new->map, bitmap_map_size(bitmap_new), bitmap->map,
+                bitmap_map_size(bitmap));
+    return bitmap_new;
+}
+#endif
+
+#if WASM_ENABLE_MULTI_MODULE != 0
+static bool
+has_sub_module_inst(WASMModuleInstanceCommon *module_inst)
+{
+    bh_list *sub_module_inst_list = NULL;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        sub_module_inst_list =
+            ((WASMModuleInstanceExtra *)((WASMModuleInstance *)module_inst)->e)
+                ->sub_module_inst_list;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        sub_module_inst_list =
+            ((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)->e)
+                ->sub_module_inst_list;
+#endif
+    return sub_module_inst_list && bh_list_length(sub_module_inst_list) > 0;
+}
+#endif
+
+WASMInstanceSnapshot *
+wasm_runtime_snapshot_instance(WASMModuleInstanceCommon *module_inst_comm,
+                               char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *common;
+    WASMInstanceSnapshot *snapshot;
+    WASMTableInstance *table;
+    uint64 total_size;
+    uint32 i;
+
+    bh_assert(module_inst_comm->module_type == Wasm_Module_Bytecode
+              || module_inst_comm->module_type == Wasm_Module_AoT);
+
+#if WASM_ENABLE_GC != 0
+    set_error_buf(error_buf, error_buf_size,
+                  "taking snapshot of instance isn't supported when GC is "
+                  "enabled");
+    return NULL;
+#endif
+#if WASM_ENABLE_MULTI_MODULE != 0
+    if (has_sub_module_inst(module_inst_comm)) {
+        set_error_buf(error_buf, error_buf_size,
+                      "taking snapshot of instance with sub modules "
+                      "isn't supported");
+        return NULL;
+    }
+#endif
+    for (i = 0; i < module_inst->memory_count; i++) {
+        if (module_inst->memories[i]->is_shared_memory) {
+            set_error_buf(error_buf, error_buf_size,
+                          "taking snapshot of instance with shared memory "
+                          "isn't supported");
+            return NULL;
+        }
+    }
+
+    if (!(snapshot = runtime_malloc(sizeof(WASMInstanceSnapshot), NULL,
+                                    error_buf, error_buf_size))) {
+        return NULL;
+    }
+
+    snapshot->module = (WASMModuleCommon *)module_inst->module;
+    snapshot->default_wasm_stack_size = module_inst->default_wasm_stack_size;
+    if (module_inst->memory_count > 0)
+        snapshot->heap_size = (uint32)(module_inst->memories[0]->heap_data_end
+                                       - module_inst->memories[0]->heap_data);
+
+    if (module_inst->global_data_size > 0) {
+        if (!(snapshot->global_data =
+                  runtime_malloc(module_inst->global_data_size, NULL,
+                                 error_buf, error_buf_size))) {
+            goto fail;
+        }
+        bh_memcpy_s(snapshot->global_data, module_inst->global_data_size,
+                    module_inst->global_data, module_inst->global_data_size);
+        snapshot->global_data_size = module_inst->global_data_size;
+    }
+
+    if (module_inst->table_count > 0) {
+        total_size =
+            sizeof(WASMTableSnapshot) * (uint64)module_inst->table_count;
+        if (!(snapshot->tables = runtime_malloc(total_size, NULL, error_buf,
+                                                error_buf_size))) {
+            goto fail;
+        }
+        snapshot->table_count = module_inst->table_count;
+
+        for (i = 0; i < module_inst->table_count; i++) {
+            table = module_inst->tables[i];
+            snapshot->tables[i].cur_size = table->cur_size;
+            if (table->cur_size == 0)
+                continue;
+
+            total_size = sizeof(table_elem_type_t) * (uint64)table->cur_size;
+            if (!(snapshot->tables[i].elems = runtime_malloc(
+                      total_size, NULL, error_buf, error_buf_size))) {
+                goto fail;
+            }
+            bh_memcpy_s(snapshot->tables[i].elems, (uint32)total_size,
+                        table->elems, (uint32)total_size);
+        }
+    }
+
+    if (module_inst->memory_count > 0) {
+        total_size =
+            sizeof(WASMMemorySnapshot) * (uint64)module_inst->memory_count;
+        if (!(snapshot->memories = runtime_malloc(total_size, NULL, error_buf,
+                                                  error_buf_size))) {
+            goto fail;
+        }
+
+        for (i = 0; i < module_inst->memory_count; i++) {
+            if (!wasm_memory_snapshot_init(&snapshot->memories[i],
+                                           module_inst->memories[i])) {
+                set_error_buf(error_buf, error_buf_size,
+                              "take snapshot of linear memory failed");
+                goto fail;
+            }
+            snapshot->memory_count++;
+        }
+    }
+
+    common = get_module_inst_extra_common(module_inst_comm);
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (common->data_dropped
+        && !(snapshot->data_dropped = bitmap_clone(common->data_dropped))) {
+        set_error_buf(error_buf, error_buf_size, "allocate memory failed");
+        goto fail;
+    }
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (common->elem_dropped
+        && !(snapshot->elem_dropped = bitmap_clone(common->elem_dropped))) {
+        set_error_buf(error_buf, error_buf_size, "allocate memory failed");
+        goto fail;
+    }
+#endif
+    (void)common;
+
+    return snapshot;
+
+fail:
+    wasm_runtime_destroy_instance_snapshot(snapshot);
+    return NULL;
+}
+
+WASMModuleInstanceCommon *
+wasm_runtime_instantiate_from_snapshot(WASMInstanceSnapshot *snapshot,
+                                       uint32 default_stack_size,
+                                       char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleCommon *module = snapshot->module;
+    WASMModuleInstanceCommon *module_inst_comm = NULL;
+    WASMModuleInstance *module_inst;
+    WASMModuleInstanceExtraCommon *common;
+    WASMTableInstance *table;
+    uint32 stack_size, i;
+
+    stack_size = default_stack_size > 0 ? default_stack_size
+                                        : snapshot->default_wasm_stack_size;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module->module_type == Wasm_Module_Bytecode)
+        module_inst_comm = (WASMModuleInstanceCommon *)wasm_instantiate(
+            (WASMModule *)module, NULL, NULL, stack_size, snapshot->heap_size,
+            0, true, error_buf, error_buf_size);
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module->module_type == Wasm_Module_AoT)
+        module_inst_comm = (WASMModuleInstanceCommon *)aot_instantiate(
+            (AOTModule *)module, NULL, NULL, stack_size, snapshot->heap_size, 0,
+            true, error_buf, error_buf_size);
+#endif
+    if (!module_inst_comm)
+        return NULL;
+
+    module_inst = (WASMModuleInstance *)module_inst_comm;
+
+    if (module_inst->global_data_size != snapshot->global_data_size
+        || module_inst->table_count != snapshot->table_count
+        || module_inst->memory_count != snapshot->memory_count) {
+        set_error_buf(error_buf, error_buf_size,
+                      "instance mismatches with the snapshot");
+        goto fail;
+    }
+
+    if (snapshot->global_data_size > 0) {
+        bh_memcpy_s(module_inst->global_data, module_inst->global_data_size,
+                    snapshot->global_data, snapshot->global_data_size);
+    }
+
+    for (i = 0; i < snapshot->table_count; i++) {
+        table = module_inst->tables[i];
+        if (snapshot->tables[i].cur_size > table->max_size) {
+            set_error_buf(error_buf, error_buf_size,
+                          "instance mismatches with the snapshot");
+            goto fail;
+        }
+        table->cur_size = snapshot->tables[i].cur_size;
+        if (table->cur_size > 0) {
+            bh_memcpy_s(table->elems,
+                        (uint32)sizeof(table_elem_type_t) * table->cur_size,
+                        snapshot->tables[i].elems,
+                        (uint32)sizeof(table_elem_type_t) * table->cur_size);
+        }
+    }
+
+    for (i = 0; i < snapshot->memory_count; i++) {
+        if (!wasm_memory_snapshot_restore(&snapshot->memories[i],
+                                          module_inst_comm,
+                                          module_inst->memories[i])) {
+            set_error_buf(error_buf, error_buf_size,
+                          "restore linear memory from the snapshot failed");
+            goto fail;
+        }
+    }
+
+    common = get_module_inst_extra_common(module_inst_comm);
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (snapshot->data_dropped) {
+        bh_assert(common->data_dropped);
+        bh_memcpy_s(common->data_dropped->map,
+                    bitmap_map_size(common->data_dropped),
+                    snapshot->data_dropped->map,
+                    bitmap_map_size(snapshot->data_dropped));
+    }
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (snapshot->elem_dropped) {
+        bh_assert(common->elem_dropped);
+        bh_memcpy_s(common->elem_dropped->map,
+                    bitmap_map_size(common->elem_dropped),
+                    snapshot->elem_dropped->map,
+                    bitmap_map_size(snapshot->elem_dropped));
+    }
+#endif
+    (void)common;
+
+    return module_inst_comm;
+
+fail:
+    wasm_runtime_deinstantiate_internal(module_inst_comm, false);
+    return NULL;
+}
+
+void
+wasm_runtime_destroy_instance_snapshot(WASMInstanceSnapshot *snapshot)
+{
+    uint32 i;
+
+    if (!snapshot)
+        return;
+
+    if (snapshot->global_data)
+        wasm_runtime_free(snapshot->global_data);
+
+    if (snapshot->tables) {
+        for (i = 0; i < snapshot->table_count; i++) {
+            if (snapshot->tables[i].elems)
+                wasm_runtime_free(snapshot->tables[i].elems);
+        }
+        wasm_runtime_free(snapshot->tables);
+    }
+
+    if (snapshot->memories) {
+        for (i = 0; i < snapshot->memory_count; i++)
+            wasm_memory_snapshot_destroy(&snapshot->memories[i]);
+        wasm_runtime_free(snapshot->memories);
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    bh_bitmap_delete(snapshot->data_dropped);
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    bh_bitmap_delete(snapshot->elem_dropped);
+#endif
+
+    wasm_runtime_free(snapshot);
+}
+#endif /* end of WASM_ENABLE_INSTANCE_SNAPSHOT != 0 */
+
 WASMModuleCommon *
 wasm_runtime_get_module(WASMModuleInstanceCommon *module_inst)
 {
@@ -2577,6 +3006,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
 #if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
     uint32 result_argc = 0;
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    WASMProfilerThread *prof_thread;
+#endif
 
     if (!wasm_runtime_exec_env_check(exec_env)) {
         LOG_ERROR("Invalid exec env stack info.");
@@ -2596,6 +3028,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
     param_argc = argc;
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    prof_thread = wasm_sampling_profiler_enter(exec_env);
+#endif
 #if WASM_ENABLE_INTERP != 0
     if (exec_env->module_inst->module_type == Wasm_Module_Bytecode)
         ret = wasm_call_function(exec_env, (WASMFunctionInstance *)function,
@@ -2605,6 +3040,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
     if (exec_env->module_inst->module_type == Wasm_Module_AoT)
         ret = aot_call_function(exec_env, (AOTFunctionInstance *)function,
                                 param_argc, new_argv);
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_leave(prof_thread);
 #endif
     if (!ret) {
         if (new_argv != argv) {
@@ -6157,11 +6595,147 @@ fail:
                  || defined(BUILD_TARGET_RISCV64_LP64D) \
                  || defined(BUILD_TARGET_RISCV64_LP64) */
 
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+/* The integer arguments are all passed as uint64, which the calling
+   conventions of the supported targets accept for the i32 and pointer
+   params, and the result is taken from the 64-bit return register, the
+   same as what invokeNative does */
+typedef uint64 (*QuickNativeFunc0)(WASMExecEnv *);
+typedef uint64 (*QuickNativeFunc1)(WASMExecEnv *, uint64);
+typedef uint64 (*QuickNativeFunc2)(WASMExecEnv *, uint64, uint64);
+typedef uint64 (*QuickNativeFunc3)(WASMExecEnv *, uint64, uint64, uint64);
+typedef uint64 (*QuickNativeFunc4)(WASMExecEnv *, uint64, uint64, uint64,
+                                   uint64);
+typedef uint64 (*QuickNativeFunc5)(WASMExecEnv *, uint64, uint64, uint64,
+                                   uint64, uint64);
+typedef uint64 (*QuickNativeFunc6)(WASMExecEnv *, uint64, uint64, uint64,
+                                   uint64, uint64, uint64);
+typedef uint64 (*QuickNativeFunc7)(WASMExecEnv *, uint64, uint64, uint64,
+                                   uint64, uint64, uint64, uint64);
+typedef uint64 (*QuickNativeFunc8)(WASMExecEnv *, uint64, uint64, uint64,
+                                   uint64, uint64, uint64, uint64, uint64);
+
+bool
+wasm_runtime_invoke_native_quick(WASMExecEnv *exec_env, void *func_ptr,
+                                 const WASMNativeCallDesc *desc,
+                                 void *attachment, uint32 *argv,
+                                 uint32 *argv_ret)
+{
+    WASMModuleInstanceCommon *module = wasm_runtime_get_module_inst(exec_env);
+    uint64 args[QUICK_NATIVE_CALL_MAX_PARAMS], ret = 0;
+    uint32 *argv_src = argv, i, app_offset, ptr_len;
+    bool convert_ptrs = desc->has_ptr_args;
+
+    bh_assert(desc->quick);
+
+#if WASM_ENABLE_MEMORY64 != 0
+    if (convert_ptrs) {
+        WASMMemoryInstance *memory =
+            wasm_get_default_memory((WASMModuleInstance *)module);
+        /* i32 pointer params aren't converted for memory64, the same as
+           wasm_runtime_invoke_native */
+        convert_ptrs = memory ? !memory->is_memory64 : true;
+    }
+#endif
+
+    for (i = 0; i < desc->param_count; i++) {
+        switch (desc->arg_kinds[i]) {
+            case NATIVE_ARG_I64:
+                args[i] = GET_I64_FROM_ADDR(argv_src);
+                argv_src += 2;
+                break;
+            case NATIVE_ARG_PTR:
+            case NATIVE_ARG_PTR_LEN:
+                app_offset = *argv_src++;
+                args[i] = app_offset;
+                if (!convert_ptrs)
+                    break;
+                ptr_len =
+                    desc->arg_kinds[i] == NATIVE_ARG_PTR_LEN ? *argv_src : 1;
+                if (!wasm_runtime_validate_app_addr(module, (uint64)app_offset,
+                                                    (uint64)ptr_len))
+                    return false;
+                args[i] = (uint64)(uintptr_t)wasm_runtime_addr_app_to_native(
+                    module, (uint64)app_offset);
+                break;
+            case NATIVE_ARG_STR:
+                app_offset = *argv_src++;
+                args[i] = app_offset;
+                if (!convert_ptrs)
+                    break;
+                if (!wasm_runtime_validate_app_str_addr(module,
+                                                        (uint64)app_offset))
+                    return false;
+                args[i] = (uint64)(uintptr_t)wasm_runtime_addr_app_to_native(
+                    module, (uint64)app_offset);
+                break;
+            default:
+                args[i] = *argv_src++;
+                break;
+        }
+    }
+
+    exec_env->attachment = attachment;
+    switch (desc->param_count) {
+        case 0:
+            ret = ((QuickNativeFunc0)func_ptr)(exec_env);
+            break;
+        case 1:
+            ret = ((QuickNativeFunc1)func_ptr)(exec_env, args[0]);
+            break;
+        case 2:
+            ret = ((QuickNativeFunc2)func_ptr)(exec_env, args[0], args[1]);
+            break;
+        case 3:
+            ret = ((QuickNativeFunc3)func_ptr)(exec_env, args[0], args[1],
+                                               args[2]);
+            break;
+        case 4:
+            ret = ((QuickNativeFunc4)func_ptr)(exec_env, args[0], args[1],
+                                               args[2], args[3]);
+            break;
+        case 5:
+            ret = ((QuickNativeFunc5)func_ptr)(exec_env, args[0], args[1],
+                                               args[2], args[3], args[4]);
+            break;
+        case 6:
+            ret = ((QuickNativeFunc6)func_ptr)(exec_env, args[0], args[1],
+                                               args[2], args[3], args[4],
+                                               args[5]);
+            break;
+        case 7:
+            ret = ((QuickNativeFunc7)func_ptr)(exec_env, args[0], args[1],
+                                               args[2], args[3], args[4],
+                                               args[5], args[6]);
+            break;
+        case 8:
+            ret = ((QuickNativeFunc8)func_ptr)(exec_env, args[0], args[1],
+                                               args[2], args[3], args[4],
+                                               args[5], args[6], args[7]);
+            break;
+        default:
+            bh_assert(0);
+            break;
+    }
+    exec_env->attachment = NULL;
+
+    if (desc->ret_cell_num == 1)
+        argv_ret[0] = (uint32)ret;
+    else if (desc->ret_cell_num == 2)
+        PUT_I64_TO_ADDR(argv_ret, ret);
+
+    return !wasm_runtime_copy_exception(module, NULL);
+}
+#endif /* end of WASM_ENABLE_QUICK_NATIVE_CALL != 0 */
+
 bool
 wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
                            uint32 argc, uint32 argv[])
 {
     bool ret = false;
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    WASMProfilerThread *prof_thread;
+#endif
 
     if (!wasm_runtime_exec_env_check(exec_env)) {
         LOG_ERROR("Invalid exec env stack info.");
@@ -6172,6 +6746,9 @@ wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
        exec_env->native_stack_boundary must have been set, we don't set
        it again */
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    prof_thread = wasm_sampling_profiler_enter(exec_env);
+#endif
 #if WASM_ENABLE_INTERP != 0
     if (exec_env->module_inst->module_type == Wasm_Module_Bytecode)
         ret = wasm_call_indirect(exec_env, 0, element_index, argc, argv);
@@ -6180,6 +6757,9 @@ wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
     if (exec_env->module_inst->module_type == Wasm_Module_AoT)
         ret = aot_call_indirect(exec_env, 0, element_index, argc, argv);
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_leave(prof_thread);
+#endif
 
     return ret;
 }
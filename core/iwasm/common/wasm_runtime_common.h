@@ -589,6 +589,8 @@ typedef struct LLVMJITOptions {
     uint32 size_level;
     uint32 segue_flags;
     bool quick_invoke_c_api_import;
+    const char *cache_dir;
+    uint32 tierup_threshold;
 } LLVMJITOptions;
 #endif
 
@@ -630,6 +632,16 @@ wasm_runtime_get_llvm_jit_options(void);
 /* Internal API */
 uint32
 wasm_runtime_get_gc_heap_size_default(void);
+
+/* Internal API */
+uint32
+wasm_runtime_get_gc_pause_budget_default(void);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/* Internal API */
+uint32
+wasm_runtime_get_gc_nursery_size_default(void);
+#endif
 #endif
 
 /* See wasm_export.h for description */
@@ -700,6 +712,25 @@ wasm_runtime_instantiate_ex(WASMModuleCommon *module,
                             const InstantiationArgs *args, char *error_buf,
                             uint32 error_buf_size);
 
+#if WASM_ENABLE_INSTANCE_SNAPSHOT != 0
+typedef struct WASMInstanceSnapshot WASMInstanceSnapshot;
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN WASMInstanceSnapshot *
+wasm_runtime_snapshot_instance(WASMModuleInstanceCommon *module_inst,
+                               char *error_buf, uint32 error_buf_size);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN WASMModuleInstanceCommon *
+wasm_runtime_instantiate_from_snapshot(WASMInstanceSnapshot *snapshot,
+                                       uint32 default_stack_size,
+                                       char *error_buf, uint32 error_buf_size);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_destroy_instance_snapshot(WASMInstanceSnapshot *snapshot);
+#endif
+
 /* See wasm_export.h for description */
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_set_running_mode(wasm_module_inst_t module_inst,
@@ -826,6 +857,27 @@ wasm_runtime_call_wasm_v(WASMExecEnv *exec_env,
                          uint32 num_results, wasm_val_t *results,
                          uint32 num_args, ...);
 
+#if WASM_ENABLE_ASYNC_CALL != 0
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN wasm_async_status_t
+wasm_runtime_call_wasm_async(WASMExecEnv *exec_env,
+                             WASMFunctionInstanceCommon *function,
+                             uint32 argc, uint32 argv[]);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_suspend(WASMExecEnv *exec_env, uint64 *p_result);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN wasm_async_status_t
+wasm_runtime_resume(WASMExecEnv *exec_env, uint64 result);
+
+/* Cancel the suspended async call of the exec env if any, and release
+   its native stack, called when the exec env is destroyed */
+void
+wasm_runtime_destroy_async_call(WASMExecEnv *exec_env);
+#endif
+
 /* See wasm_export.h for description */
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
@@ -1209,6 +1261,16 @@ wasm_runtime_invoke_native(WASMExecEnv *exec_env, void *func_ptr,
                            void *attachment, uint32 *argv, uint32 argc,
                            uint32 *ret);
 
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+/* Call a native API with the signature precompiled by
+   wasm_native_precompile_signature, desc->quick must be true */
+bool
+wasm_runtime_invoke_native_quick(WASMExecEnv *exec_env, void *func_ptr,
+                                 const WASMNativeCallDesc *desc,
+                                 void *attachment, uint32 *argv,
+                                 uint32 *ret);
+#endif
+
 bool
 wasm_runtime_invoke_native_raw(WASMExecEnv *exec_env, void *func_ptr,
                                const WASMFuncType *func_type,
@@ -0,0 +1,1032 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_sampling_profiler.h"
+#include "wasm_runtime_common.h"
+#include "bh_atomic.h"
+#include "bh_log.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#include "../interpreter/wasm_interp.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#include "../compilation/aot_stack_frame.h"
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+
+/* Default sample interval, 100 samples per second of cpu time */
+#define DEFAULT_SAMPLE_INTERVAL_US 10000
+
+/* Hash table of the distinct call stacks, at most half full */
+#define STACK_SLOT_NUM (WASM_SAMPLING_PROFILER_MAX_STACKS * 2)
+/* Frames of all the call stacks, 16 frames per call stack in average */
+#define FRAME_POOL_SIZE (WASM_SAMPLING_PROFILER_MAX_STACKS * 16)
+
+/* A frame of a sampled call stack, module is NULL if the thread was
+   running wasm code but no frame was found, e.g. the AOT module was
+   compiled without the call stack features, or the module of the frame
+   wasn't found */
+typedef struct ProfFrame {
+    const WASMModuleCommon *module;
+    uint32 func_index;
+} ProfFrame;
+
+typedef struct ProfStack {
+    /* 0 if the slot is empty */
+    uint32 hash;
+    uint32 depth;
+    /* index of the innermost frame in the frame pool */
+    uint32 frame_offset;
+    uint32 count;
+} ProfStack;
+
+typedef struct ProfFunc {
+    const WASMModuleCommon *module;
+    uint32 func_index;
+    const char *name;
+    char name_buf[16];
+} ProfFunc;
+
+typedef struct SamplingProfiler {
+    bool running;
+    uint32 interval_us;
+    uint64 start_time_us;
+    uint64 duration_us;
+    struct sigaction prev_action;
+
+    /* The following fields are updated by the signal handler */
+    uint32 lock;
+    ProfStack *stacks;
+    uint32 stack_count;
+    ProfFrame *frames;
+    uint32 frame_count;
+    uint32 sample_count;
+    /* samples dropped when the tables were full or another thread
+       was recording a sample at the same time */
+    uint32 dropped_count;
+} SamplingProfiler;
+
+static SamplingProfiler profiler;
+
+/* Max number of nested wasm calls recorded for a thread, e.g. wasm
+   calls a native function which calls wasm_runtime_call_wasm again */
+#define MAX_NESTED_CALLS 8
+
+/* Max level of the sub modules searched for the module of a frame */
+#define MAX_SUB_MODULE_LEVEL 4
+
+typedef struct ProfCall {
+    WASMExecEnv *exec_env;
+    WASMModuleInstanceCommon *module_inst;
+    /* Top of the wasm stack when the call started, the AOT frames above
+       it belong to module_inst until the next call on the exec_env */
+    uint8 *wasm_stack_top;
+} ProfCall;
+
+/* The wasm calls running in a thread, the signal handler finds the slot
+   of the interrupted thread by its thread id instead of reading a thread
+   local variable, which isn't async-signal-safe when the runtime is in
+   a library loaded by dlopen */
+struct WASMProfilerThread {
+    /* 1 if the slot is claimed by a thread */
+    uint32 used;
+    korp_tid tid;
+    /* May be larger than MAX_NESTED_CALLS, the calls beyond it aren't
+       recorded and the samples taken in them are dropped */
+    uint32 call_count;
+    ProfCall calls[MAX_NESTED_CALLS];
+};
+
+static WASMProfilerThread
+    profiler_threads[WASM_SAMPLING_PROFILER_MAX_THREADS];
+
+static uint32
+get_thread_slot_index(korp_tid tid)
+{
+    /* The thread id is the address of the thread control block */
+    return (uint32)(((uintptr_t)tid >> 8)
+                    % WASM_SAMPLING_PROFILER_MAX_THREADS);
+}
+
+/* Only reads the slots, so that it can be called in the signal handler */
+static WASMProfilerThread *
+find_thread(korp_tid tid)
+{
+    WASMProfilerThread *thread;
+    uint32 index = get_thread_slot_index(tid), i;
+
+    for (i = 0; i < WASM_SAMPLING_PROFILER_MAX_THREADS; i++) {
+        thread = profiler_threads + index;
+        if (BH_ATOMIC_32_LOAD(thread->used) && thread->tid == tid)
+            return thread;
+        index = (index + 1) % WASM_SAMPLING_PROFILER_MAX_THREADS;
+    }
+    return NULL;
+}
+
+static WASMProfilerThread *
+claim_thread(korp_tid tid)
+{
+    WASMProfilerThread *thread;
+    uint32 index = get_thread_slot_index(tid), i;
+
+    for (i = 0; i < WASM_SAMPLING_PROFILER_MAX_THREADS; i++) {
+        thread = profiler_threads + index;
+        if (BH_ATOMIC_32_FETCH_OR(thread->used, 1) == 0) {
+            thread->call_count = 0;
+            thread->tid = tid;
+            return thread;
+        }
+        index = (index + 1) % WASM_SAMPLING_PROFILER_MAX_THREADS;
+    }
+    return NULL;
+}
+
+WASMProfilerThread *
+wasm_sampling_profiler_enter(WASMExecEnv *exec_env)
+{
+    korp_tid tid = os_self_thread();
+    WASMProfilerThread *thread;
+    ProfCall *call;
+
+    if (!(thread = find_thread(tid)) && !(thread = claim_thread(tid))) {
+        /* The thread isn't sampled */
+        return NULL;
+    }
+
+    if (thread->call_count < MAX_NESTED_CALLS) {
+        call = thread->calls + thread->call_count;
+        call->exec_env = exec_env;
+        call->module_inst = exec_env->module_inst;
+        call->wasm_stack_top = exec_env->wasm_stack.top;
+    }
+    /* Publish the call after it is filled, the signal handler may
+       interrupt the thread at any point */
+    BH_ATOMIC_32_STORE(thread->call_count, thread->call_count + 1);
+    return thread;
+}
+
+void
+wasm_sampling_profiler_leave(WASMProfilerThread *thread)
+{
+    if (!thread)
+        return;
+
+    bh_assert(thread->call_count > 0);
+    BH_ATOMIC_32_STORE(thread->call_count, thread->call_count - 1);
+    if (thread->call_count == 0) {
+        /* Release the slot, the thread id is cleared before the slot is
+           claimed again by another thread */
+        thread->tid = 0;
+        BH_ATOMIC_32_STORE(thread->used, 0);
+    }
+}
+
+#if WASM_ENABLE_INTERP != 0
+/* Find the module instance which the function belongs to, from the
+   instance and its sub module instances */
+static WASMModuleInstance *
+find_interp_module_inst(WASMModuleInstance *module_inst,
+                        const WASMFunctionInstance *function, uint32 level)
+{
+#if WASM_ENABLE_MULTI_MODULE != 0
+    WASMSubModInstNode *node;
+    WASMModuleInstance *sub_module_inst;
+#endif
+
+    if (function >= module_inst->e->functions
+        && function < module_inst->e->functions + module_inst->e->function_count)
+        return module_inst;
+
+#if WASM_ENABLE_MULTI_MODULE != 0
+    if (level >= MAX_SUB_MODULE_LEVEL)
+        return NULL;
+    node = bh_list_first_elem(module_inst->e->sub_module_inst_list);
+    while (node) {
+        if ((sub_module_inst = find_interp_module_inst(node->module_inst,
+                                                       function, level + 1)))
+            return sub_module_inst;
+        node = bh_list_elem_next(node);
+    }
+#else
+    (void)level;
+#endif
+    return NULL;
+}
+
+/**
+ * Resolve the module of an interpreter frame. The frames of an exec_env
+ * may belong to different instances: the imported functions of the sub
+ * modules run on the exec_env of the caller, and the malloc/free function
+ * of another instance may be called with the exec_env temporarily set to
+ * that instance.
+ */
+static void
+resolve_interp_frame(const WASMProfilerThread *thread, uint32 call_count,
+                     WASMExecEnv *exec_env, const WASMFunctionInstance *function,
+                     ProfFrame *frame)
+{
+    WASMModuleInstance *module_inst =
+        find_interp_module_inst((WASMModuleInstance *)exec_env->module_inst,
+                                function, 0);
+    uint32 i;
+
+    for (i = call_count; !module_inst && i > 0; i--) {
+        if (thread->calls[i - 1].exec_env == exec_env)
+            module_inst = find_interp_module_inst(
+                (WASMModuleInstance *)thread->calls[i - 1].module_inst,
+                function, 0);
+    }
+
+    if (module_inst) {
+        frame->module = (const WASMModuleCommon *)module_inst->module;
+        frame->func_index = (uint32)(function - module_inst->e->functions);
+    }
+    else {
+        frame->module = NULL;
+        frame->func_index = 0;
+    }
+}
+
+static uint32
+copy_interp_call_stack(const WASMProfilerThread *thread, uint32 call_count,
+                       WASMExecEnv *exec_env, ProfFrame *frames)
+{
+    WASMInterpFrame *cur_frame = wasm_exec_env_get_cur_frame(exec_env);
+    uint8 *top_boundary = exec_env->wasm_stack.top_boundary;
+    uint8 *bottom = exec_env->wasm_stack.bottom;
+    uint32 depth = 0;
+
+    /* Only read the frames between the bottom and the top boundary of
+       the wasm stack, same as wasm_interp_copy_callstack */
+    while (cur_frame && (uint8 *)cur_frame >= bottom
+           && (uint8 *)cur_frame + sizeof(WASMInterpFrame) <= top_boundary
+           && depth < WASM_SAMPLING_PROFILER_MAX_DEPTH) {
+        if (cur_frame->function) {
+            resolve_interp_frame(thread, call_count, exec_env,
+                                 cur_frame->function, frames + depth);
+            depth++;
+        }
+        cur_frame = cur_frame->prev_frame;
+    }
+    return depth;
+}
+#endif /* end of WASM_ENABLE_INTERP != 0 */
+
+#if WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
+/**
+ * The AOT frames only have the function index, the module of a frame is
+ * the module of the innermost call on the exec_env which started below
+ * the frame, e.g. the malloc/free function of another instance called
+ * with the exec_env temporarily set to that instance.
+ */
+static const WASMModuleCommon *
+get_aot_frame_module(const WASMProfilerThread *thread, uint32 call_count,
+                     WASMExecEnv *exec_env, const uint8 *frame)
+{
+    const ProfCall *call;
+    uint32 i;
+
+    for (i = call_count; i > 0; i--) {
+        call = thread->calls + i - 1;
+        if (call->exec_env == exec_env && call->wasm_stack_top <= frame)
+            return (const WASMModuleCommon *)((AOTModuleInstance *)
+                                                  call->module_inst)
+                ->module;
+    }
+    return (const WASMModuleCommon *)((AOTModuleInstance *)
+                                          exec_env->module_inst)
+        ->module;
+}
+
+static uint32
+copy_aot_call_stack(const WASMProfilerThread *thread, uint32 call_count,
+                    WASMExecEnv *exec_env, ProfFrame *frames)
+{
+    AOTModule *module =
+        (AOTModule *)((AOTModuleInstance *)exec_env->module_inst)->module;
+    uint8 *top_boundary = exec_env->wasm_stack.top_boundary;
+    uint8 *top = exec_env->wasm_stack.top;
+    uint8 *bottom = exec_env->wasm_stack.bottom;
+    uint32 depth = 0;
+
+    /* Only read the frames between the bottom and the top boundary of
+       the wasm stack, same as aot_copy_callstack */
+    if (module->feature_flags & WASM_FEATURE_TINY_STACK_FRAME) {
+        AOTTinyFrame *frame;
+
+        if (top > top_boundary || top < bottom
+            || (uintptr_t)(top - bottom) % sizeof(AOTTinyFrame) != 0)
+            return 0;
+
+        frame = (AOTTinyFrame *)top;
+        while ((uint8 *)frame > bottom
+               && depth < WASM_SAMPLING_PROFILER_MAX_DEPTH) {
+            frame--;
+            frames[depth].module = get_aot_frame_module(
+                thread, call_count, exec_env, (uint8 *)frame);
+            frames[depth].func_index = frame->func_index;
+            depth++;
+        }
+    }
+#if WASM_ENABLE_GC == 0
+    /* The size of the standard frames varies when GC is enabled */
+    else {
+        AOTFrame *cur_frame =
+            (AOTFrame *)wasm_exec_env_get_cur_frame(exec_env);
+
+        while (cur_frame && (uint8 *)cur_frame >= bottom
+               && (uint8 *)cur_frame + offsetof(AOTFrame, lp) <= top_boundary
+               && depth < WASM_SAMPLING_PROFILER_MAX_DEPTH) {
+            frames[depth].module = get_aot_frame_module(
+                thread, call_count, exec_env, (uint8 *)cur_frame);
+            frames[depth].func_index = (uint32)cur_frame->func_index;
+            depth++;
+            cur_frame = cur_frame->prev_frame;
+        }
+    }
+#endif
+    return depth;
+}
+#endif /* end of WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0 */
+
+/**
+ * Copy the call stack of the innermost call of the thread to frames,
+ * from the innermost frame, and return the number of frames copied.
+ */
+static uint32
+copy_call_stack(const WASMProfilerThread *thread, uint32 call_count,
+                ProfFrame *frames)
+{
+    WASMExecEnv *exec_env = thread->calls[call_count - 1].exec_env;
+    WASMModuleInstanceCommon *module_inst = exec_env->module_inst;
+
+    if (!module_inst)
+        return 0;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return copy_interp_call_stack(thread, call_count, exec_env, frames);
+#endif
+#if WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return copy_aot_call_stack(thread, call_count, exec_env, frames);
+#endif
+    return 0;
+}
+
+static uint32
+hash_frames(const ProfFrame *frames, uint32 depth)
+{
+    /* FNV-1a */
+    uint32 hash = 2166136261u, i;
+
+    for (i = 0; i < depth; i++) {
+        hash = (hash ^ (uint32)(uintptr_t)frames[i].module) * 16777619u;
+        hash = (hash ^ frames[i].func_index) * 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
+static bool
+frames_equal(const ProfFrame *frames1, const ProfFrame *frames2,
+             uint32 depth)
+{
+    uint32 i;
+
+    /* Don't memcmp them as the padding bytes aren't initialized */
+    for (i = 0; i < depth; i++) {
+        if (frames1[i].module != frames2[i].module
+            || frames1[i].func_index != frames2[i].func_index)
+            return false;
+    }
+    return true;
+}
+
+static bool
+record_sample(const ProfFrame *frames, uint32 depth)
+{
+    uint32 hash = hash_frames(frames, depth);
+    uint32 index = hash & (STACK_SLOT_NUM - 1);
+    ProfStack *stack;
+
+    while (true) {
+        stack = profiler.stacks + index;
+        if (stack->hash == 0)
+            break;
+        if (stack->hash == hash && stack->depth == depth
+            && frames_equal(profiler.frames + stack->frame_offset, frames,
+                            depth)) {
+            stack->count++;
+            return true;
+        }
+        index = (index + 1) & (STACK_SLOT_NUM - 1);
+    }
+
+    if (profiler.stack_count >= WASM_SAMPLING_PROFILER_MAX_STACKS
+        || depth > FRAME_POOL_SIZE - profiler.frame_count)
+        return false;
+
+    bh_memcpy_s(profiler.frames + profiler.frame_count,
+                (uint32)sizeof(ProfFrame) * depth, frames,
+                (uint32)sizeof(ProfFrame) * depth);
+    stack->depth = depth;
+    stack->frame_offset = profiler.frame_count;
+    stack->count = 1;
+    stack->hash = hash;
+    profiler.frame_count += depth;
+    profiler.stack_count++;
+    return true;
+}
+
+static void
+profiler_signal_handler(int sig, siginfo_t *info, void *ucontext)
+{
+    WASMProfilerThread *thread;
+    ProfFrame frames[WASM_SAMPLING_PROFILER_MAX_DEPTH];
+    uint32 call_count, depth;
+    int saved_errno = errno;
+
+    (void)sig;
+    (void)info;
+    (void)ucontext;
+
+    /* Not running wasm code */
+    if (!(thread = find_thread(os_self_thread()))
+        || !(call_count = BH_ATOMIC_32_LOAD(thread->call_count)))
+        goto return_func;
+
+    /* The innermost call isn't recorded */
+    if (call_count > MAX_NESTED_CALLS) {
+        BH_ATOMIC_32_FETCH_ADD(profiler.dropped_count, 1);
+        goto return_func;
+    }
+
+    /* SIGPROF is blocked in its handler, so the lock is held by another
+       thread, drop the sample instead of waiting for it */
+    if (BH_ATOMIC_32_FETCH_OR(profiler.lock, 1) != 0) {
+        BH_ATOMIC_32_FETCH_ADD(profiler.dropped_count, 1);
+        goto return_func;
+    }
+
+    if (profiler.stacks) {
+        depth = copy_call_stack(thread, call_count, frames);
+        if (depth == 0) {
+            frames[0].module = NULL;
+            frames[0].func_index = 0;
+            depth = 1;
+        }
+        if (record_sample(frames, depth))
+            profiler.sample_count++;
+        else
+            BH_ATOMIC_32_FETCH_ADD(profiler.dropped_count, 1);
+    }
+
+    BH_ATOMIC_32_STORE(profiler.lock, 0);
+
+return_func:
+    errno = saved_errno;
+}
+
+static void
+wait_for_signal_handlers(void)
+{
+    while (BH_ATOMIC_32_FETCH_OR(profiler.lock, 1) != 0)
+        os_usleep(1);
+    BH_ATOMIC_32_STORE(profiler.lock, 0);
+}
+
+static void
+free_samples(void)
+{
+    if (profiler.stacks) {
+        wasm_runtime_free(profiler.stacks);
+        profiler.stacks = NULL;
+    }
+    if (profiler.frames) {
+        wasm_runtime_free(profiler.frames);
+        profiler.frames = NULL;
+    }
+    profiler.stack_count = profiler.frame_count = 0;
+    profiler.sample_count = profiler.dropped_count = 0;
+}
+
+bool
+wasm_runtime_start_profiling(uint32 sample_interval_us)
+{
+    struct sigaction sig_act;
+    struct itimerval timer;
+    uint64 size;
+
+    if (profiler.running) {
+        LOG_WARNING("sampling profiler is already running");
+        return false;
+    }
+
+    free_samples();
+
+    size = sizeof(ProfStack) * (uint64)STACK_SLOT_NUM;
+    if (!(profiler.stacks = wasm_runtime_malloc((uint32)size))) {
+        LOG_ERROR("allocate memory for sampling profiler failed");
+        return false;
+    }
+    memset(profiler.stacks, 0, (uint32)size);
+
+    size = sizeof(ProfFrame) * (uint64)FRAME_POOL_SIZE;
+    if (!(profiler.frames = wasm_runtime_malloc((uint32)size))) {
+        LOG_ERROR("allocate memory for sampling profiler failed");
+        goto fail;
+    }
+
+    memset(&sig_act, 0, sizeof(sig_act));
+    sig_act.sa_sigaction = profiler_signal_handler;
+    sig_act.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sig_act.sa_mask);
+    if (sigaction(SIGPROF, &sig_act, &profiler.prev_action) != 0) {
+        LOG_ERROR("install SIGPROF handler failed");
+        goto fail;
+    }
+
+    profiler.interval_us =
+        sample_interval_us ? sample_interval_us : DEFAULT_SAMPLE_INTERVAL_US;
+    timer.it_interval.tv_sec = profiler.interval_us / 1000000;
+    timer.it_interval.tv_usec = profiler.interval_us % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+        LOG_ERROR("start profiling timer failed");
+        sigaction(SIGPROF, &profiler.prev_action, NULL);
+        goto fail;
+    }
+
+    profiler.start_time_us = os_time_get_boot_us();
+    profiler.duration_us = 0;
+    profiler.running = true;
+    return true;
+
+fail:
+    free_samples();
+    return false;
+}
+
+bool
+wasm_runtime_stop_profiling(void)
+{
+    struct itimerval timer;
+
+    if (!profiler.running)
+        return false;
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    /* A signal generated before the timer was stopped may still be
+       pending, ignore it instead of terminating the process */
+    if (!(profiler.prev_action.sa_flags & SA_SIGINFO)
+        && profiler.prev_action.sa_handler == SIG_DFL)
+        profiler.prev_action.sa_handler = SIG_IGN;
+    sigaction(SIGPROF, &profiler.prev_action, NULL);
+    /* A handler may still be running in another thread */
+    wait_for_signal_handlers();
+
+    profiler.duration_us = os_time_get_boot_us() - profiler.start_time_us;
+    profiler.running = false;
+    return true;
+}
+
+void
+wasm_sampling_profiler_destroy(void)
+{
+    wasm_runtime_stop_profiling();
+    free_samples();
+}
+
+#if WASM_ENABLE_INTERP != 0
+static const char *
+get_interp_func_name(const WASMModule *module, uint32 func_index)
+{
+    const char *name = NULL;
+    uint32 i;
+
+    if (func_index < module->import_function_count)
+        return module->import_functions[func_index].u.function.field_name;
+
+#if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
+    if (func_index - module->import_function_count < module->function_count)
+        name =
+            module->functions[func_index - module->import_function_count]
+                ->field_name;
+#endif
+
+    for (i = 0; !name && i < module->export_count; i++) {
+        if (module->exports[i].kind == EXPORT_KIND_FUNC
+            && module->exports[i].index == func_index)
+            name = module->exports[i].name;
+    }
+    return name;
+}
+#endif
+
+#if WASM_ENABLE_AOT != 0
+static const char *
+get_aot_func_name(const AOTModule *module, uint32 func_index)
+{
+    const char *name = NULL;
+    uint32 i;
+
+    if (func_index < module->import_func_count)
+        return module->import_funcs[func_index].func_name;
+
+#if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
+    for (i = 0; i < module->aux_func_name_count; i++) {
+        if (module->aux_func_indexes[i] == func_index)
+            return module->aux_func_names[i];
+    }
+#endif
+
+    for (i = 0; !name && i < module->export_count; i++) {
+        if (module->exports[i].kind == EXPORT_KIND_FUNC
+            && module->exports[i].index == func_index)
+            name = module->exports[i].name;
+    }
+    return name;
+}
+#endif
+
+static void
+resolve_func_name(ProfFunc *func)
+{
+    const WASMModuleCommon *module = func->module;
+
+    func->name = NULL;
+    if (!module) {
+        func->name = "[unknown]";
+        return;
+    }
+
+#if WASM_ENABLE_INTERP != 0
+    if (module->module_type == Wasm_Module_Bytecode)
+        func->name =
+            get_interp_func_name((const WASMModule *)module, func->func_index);
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module->module_type == Wasm_Module_AoT)
+        func->name =
+            get_aot_func_name((const AOTModule *)module, func->func_index);
+#endif
+
+    if (!func->name) {
+        /* Same as the function name in the dumped call stack */
+        snprintf(func->name_buf, sizeof(func->name_buf), "$f%" PRIu32,
+                 func->func_index);
+        func->name = func->name_buf;
+    }
+}
+
+static int
+compare_funcs(const void *a, const void *b)
+{
+    const ProfFunc *f1 = (const ProfFunc *)a, *f2 = (const ProfFunc *)b;
+
+    if (f1->module != f2->module)
+        return (uintptr_t)f1->module < (uintptr_t)f2->module ? -1 : 1;
+    if (f1->func_index != f2->func_index)
+        return f1->func_index < f2->func_index ? -1 : 1;
+    return 0;
+}
+
+/* Create the sorted list of distinct functions of the recorded frames */
+static ProfFunc *
+create_func_list(uint32 *p_func_count)
+{
+    ProfFunc *funcs;
+    uint32 i, func_count = 0;
+
+    if (!(funcs = wasm_runtime_malloc(
+              (uint32)(sizeof(ProfFunc) * (profiler.frame_count + 1)))))
+        return NULL;
+
+    for (i = 0; i < profiler.frame_count; i++) {
+        funcs[i].module = profiler.frames[i].module;
+        funcs[i].func_index = profiler.frames[i].func_index;
+    }
+    qsort(funcs, profiler.frame_count, sizeof(ProfFunc), compare_funcs);
+
+    for (i = 0; i < profiler.frame_count; i++) {
+        if (func_count == 0
+            || compare_funcs(&funcs[func_count - 1], &funcs[i]) != 0) {
+            funcs[func_count] = funcs[i];
+            resolve_func_name(&funcs[func_count]);
+            func_count++;
+        }
+    }
+
+    *p_func_count = func_count;
+    return funcs;
+}
+
+static uint32
+get_func_id(const ProfFunc *funcs, uint32 func_count, const ProfFrame *frame)
+{
+    ProfFunc key, *func;
+
+    key.module = frame->module;
+    key.func_index = frame->func_index;
+    func = bsearch(&key, funcs, func_count, sizeof(ProfFunc), compare_funcs);
+    bh_assert(func);
+    /* Function ids of pprof start from 1 */
+    return (uint32)(func - funcs) + 1;
+}
+
+static bool
+write_collapsed(FILE *file, const ProfFunc *funcs, uint32 func_count)
+{
+    const ProfStack *stack;
+    const ProfFrame *frames;
+    uint32 i, j;
+
+    for (i = 0; i < STACK_SLOT_NUM; i++) {
+        stack = profiler.stacks + i;
+        if (stack->hash == 0)
+            continue;
+
+        /* From the outermost frame to the innermost frame */
+        frames = profiler.frames + stack->frame_offset;
+        for (j = stack->depth; j > 0; j--) {
+            fprintf(file, j < stack->depth ? ";%s" : "%s",
+                    funcs[get_func_id(funcs, func_count, &frames[j - 1]) - 1]
+                        .name);
+        }
+        fprintf(file, " %" PRIu32 "\n", stack->count);
+    }
+
+    return !ferror(file);
+}
+
+/* A growable buffer to encode the protocol buffer messages of pprof */
+typedef struct ProtoBuf {
+    uint8 *data;
+    uint32 size;
+    uint32 capacity;
+    bool failed;
+} ProtoBuf;
+
+static void
+proto_put_bytes(ProtoBuf *buf, const void *data, uint32 size)
+{
+    uint8 *new_data;
+    uint64 capacity;
+
+    if (buf->failed)
+        return;
+
+    if (size > buf->capacity - buf->size) {
+        capacity = (uint64)buf->capacity * 2 + size + 256;
+        if (capacity > UINT32_MAX
+            || !(new_data =
+                     wasm_runtime_realloc(buf->data, (uint32)capacity))) {
+            buf->failed = true;
+            return;
+        }
+        buf->data = new_data;
+        buf->capacity = (uint32)capacity;
+    }
+
+    bh_memcpy_s(buf->data + buf->size, buf->capacity - buf->size, data, size);
+    buf->size += size;
+}
+
+static void
+proto_put_varint(ProtoBuf *buf, uint64 value)
+{
+    uint8 bytes[10];
+    uint32 n = 0;
+
+    do {
+        bytes[n] = (uint8)(value & 0x7f);
+        value >>= 7;
+        if (value)
+            bytes[n] |= 0x80;
+        n++;
+    } while (value);
+
+    proto_put_bytes(buf, bytes, n);
+}
+
+static void
+proto_put_varint_field(ProtoBuf *buf, uint32 field, uint64 value)
+{
+    /* wire type 0: varint */
+    proto_put_varint(buf, (uint64)field << 3);
+    proto_put_varint(buf, value);
+}
+
+static void
+proto_put_bytes_field(ProtoBuf *buf, uint32 field, const void *data,
+                      uint32 size)
+{
+    /* wire type 2: length-delimited */
+    proto_put_varint(buf, ((uint64)field << 3) | 2);
+    proto_put_varint(buf, size);
+    proto_put_bytes(buf, data, size);
+}
+
+/* Put the message in msg as a field of buf and clear msg */
+static void
+proto_put_message_field(ProtoBuf *buf, uint32 field, ProtoBuf *msg)
+{
+    if (msg->failed)
+        buf->failed = true;
+    proto_put_bytes_field(buf, field, msg->data, msg->size);
+    msg->size = 0;
+}
+
+/* Fields of the messages in profile.proto of pprof */
+#define PROFILE_SAMPLE_TYPE 1
+#define PROFILE_SAMPLE 2
+#define PROFILE_LOCATION 4
+#define PROFILE_FUNCTION 5
+#define PROFILE_STRING_TABLE 6
+#define PROFILE_DURATION_NANOS 10
+#define PROFILE_PERIOD_TYPE 11
+#define PROFILE_PERIOD 12
+#define VALUE_TYPE_TYPE 1
+#define VALUE_TYPE_UNIT 2
+#define SAMPLE_LOCATION_ID 1
+#define SAMPLE_VALUE 2
+#define LOCATION_ID 1
+#define LOCATION_LINE 4
+#define LINE_FUNCTION_ID 1
+#define FUNCTION_ID 1
+#define FUNCTION_NAME 2
+#define FUNCTION_SYSTEM_NAME 3
+
+/* Fixed entries of the string table, the names of the functions follow */
+static const char *pprof_strings[] = { "", "samples", "count", "cpu",
+                                       "nanoseconds" };
+#define STR_SAMPLES 1
+#define STR_COUNT 2
+#define STR_CPU 3
+#define STR_NANOSECONDS 4
+#define STR_FUNC_NAME_BASE 5
+
+static bool
+write_pprof(FILE *file, const ProfFunc *funcs, uint32 func_count)
+{
+    ProtoBuf buf = { 0 }, msg = { 0 }, field = { 0 };
+    const ProfStack *stack;
+    const ProfFrame *frames;
+    uint64 period_ns = (uint64)profiler.interval_us * 1000;
+    uint32 i, j;
+    bool ret = false;
+
+    /* sample_type: samples/count and cpu/nanoseconds */
+    proto_put_varint_field(&msg, VALUE_TYPE_TYPE, STR_SAMPLES);
+    proto_put_varint_field(&msg, VALUE_TYPE_UNIT, STR_COUNT);
+    proto_put_message_field(&buf, PROFILE_SAMPLE_TYPE, &msg);
+    proto_put_varint_field(&msg, VALUE_TYPE_TYPE, STR_CPU);
+    proto_put_varint_field(&msg, VALUE_TYPE_UNIT, STR_NANOSECONDS);
+    proto_put_message_field(&buf, PROFILE_SAMPLE_TYPE, &msg);
+
+    for (i = 0; i < STACK_SLOT_NUM; i++) {
+        stack = profiler.stacks + i;
+        if (stack->hash == 0)
+            continue;
+
+        /* The location ids are packed, from the innermost frame */
+        frames = profiler.frames + stack->frame_offset;
+        for (j = 0; j < stack->depth; j++)
+            proto_put_varint(&field,
+                             get_func_id(funcs, func_count, &frames[j]));
+        proto_put_message_field(&msg, SAMPLE_LOCATION_ID, &field);
+
+        proto_put_varint(&field, stack->count);
+        proto_put_varint(&field, stack->count * period_ns);
+        proto_put_message_field(&msg, SAMPLE_VALUE, &field);
+
+        proto_put_message_field(&buf, PROFILE_SAMPLE, &msg);
+    }
+
+    /* A location and a function for each distinct function */
+    for (i = 0; i < func_count; i++) {
+        proto_put_varint_field(&msg, LOCATION_ID, i + 1);
+        proto_put_varint_field(&field, LINE_FUNCTION_ID, i + 1);
+        proto_put_message_field(&msg, LOCATION_LINE, &field);
+        proto_put_message_field(&buf, PROFILE_LOCATION, &msg);
+    }
+    for (i = 0; i < func_count; i++) {
+        proto_put_varint_field(&msg, FUNCTION_ID, i + 1);
+        proto_put_varint_field(&msg, FUNCTION_NAME, STR_FUNC_NAME_BASE + i);
+        proto_put_varint_field(&msg, FUNCTION_SYSTEM_NAME,
+                               STR_FUNC_NAME_BASE + i);
+        proto_put_message_field(&buf, PROFILE_FUNCTION, &msg);
+    }
+
+    for (i = 0; i < sizeof(pprof_strings) / sizeof(pprof_strings[0]); i++)
+        proto_put_bytes_field(&buf, PROFILE_STRING_TABLE, pprof_strings[i],
+                              (uint32)strlen(pprof_strings[i]));
+    for (i = 0; i < func_count; i++)
+        proto_put_bytes_field(&buf, PROFILE_STRING_TABLE, funcs[i].name,
+                              (uint32)strlen(funcs[i].name));
+
+    proto_put_varint_field(&buf, PROFILE_DURATION_NANOS,
+                           profiler.duration_us * 1000);
+    proto_put_varint_field(&msg, VALUE_TYPE_TYPE, STR_CPU);
+    proto_put_varint_field(&msg, VALUE_TYPE_UNIT, STR_NANOSECONDS);
+    proto_put_message_field(&buf, PROFILE_PERIOD_TYPE, &msg);
+    proto_put_varint_field(&buf, PROFILE_PERIOD, period_ns);
+
+    if (buf.failed || msg.failed || field.failed) {
+        LOG_ERROR("allocate memory for pprof profile failed");
+        goto fail;
+    }
+
+    ret = fwrite(buf.data, 1, buf.size, file) == buf.size;
+
+fail:
+    if (field.data)
+        wasm_runtime_free(field.data);
+    if (msg.data)
+        wasm_runtime_free(msg.data);
+    if (buf.data)
+        wasm_runtime_free(buf.data);
+    return ret;
+}
+
+bool
+wasm_runtime_write_profile(const char *file_name,
+                           wasm_profile_format_t format)
+{
+    ProfFunc *funcs = NULL;
+    uint32 func_count = 0;
+    FILE *file;
+    bool ret;
+
+    if (profiler.running) {
+        LOG_WARNING("stop the sampling profiler before writing the profile");
+        return false;
+    }
+    if (!profiler.stacks) {
+        LOG_WARNING("no profile was recorded");
+        return false;
+    }
+
+    if (!(funcs = create_func_list(&func_count))) {
+        LOG_ERROR("allocate memory for profile failed");
+        return false;
+    }
+
+    if (!(file = fopen(file_name, "wb"))) {
+        LOG_ERROR("open profile file %s failed", file_name);
+        wasm_runtime_free(funcs);
+        return false;
+    }
+
+    if (profiler.dropped_count > 0)
+        LOG_WARNING("%" PRIu32 " of %" PRIu32 " samples were dropped",
+                    profiler.dropped_count,
+                    profiler.sample_count + profiler.dropped_count);
+
+    if (format == WASM_PROFILE_FORMAT_PPROF)
+        ret = write_pprof(file, funcs, func_count);
+    else
+        ret = write_collapsed(file, funcs, func_count);
+
+    if (fclose(file) != 0)
+        ret = false;
+    if (!ret)
+        LOG_ERROR("write profile file %s failed", file_name);
+
+    wasm_runtime_free(funcs);
+    return ret;
+}
+
+#else /* else of WASM_ENABLE_SAMPLING_PROFILER != 0 */
+
+bool
+wasm_runtime_start_profiling(uint32 sample_interval_us)
+{
+    (void)sample_interval_us;
+    LOG_WARNING("sampling profiler isn't enabled, build with "
+                "WAMR_BUILD_SAMPLING_PROFILER=1");
+    return false;
+}
+
+bool
+wasm_runtime_stop_profiling(void)
+{
+    return false;
+}
+
+bool
+wasm_runtime_write_profile(const char *file_name,
+                           wasm_profile_format_t format)
+{
+    (void)file_name;
+    (void)format;
+    return false;
+}
+
+#endif /* end of WASM_ENABLE_SAMPLING_PROFILER != 0 */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_SAMPLING_PROFILER_H
+#define _WASM_SAMPLING_PROFILER_H
+
+#include "bh_platform.h"
+#include "wasm_exec_env.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+typedef struct WASMProfilerThread WASMProfilerThread;
+
+/**
+ * Record that the exec_env starts to run wasm code in the current thread,
+ * the call stack of it is recorded when the thread is sampled.
+ *
+ * @param exec_env the exec_env which starts to run wasm code, its module
+ *        instance is the instance of the functions called
+ *
+ * @return the slot of the current thread, which should be passed to
+ *         wasm_sampling_profiler_leave after the wasm code returns, NULL
+ *         if all the slots are used and the thread isn't sampled
+ */
+WASMProfilerThread *
+wasm_sampling_profiler_enter(WASMExecEnv *exec_env);
+
+void
+wasm_sampling_profiler_leave(WASMProfilerThread *thread);
+
+/* Stop the profiler if it is running and free the samples */
+void
+wasm_sampling_profiler_destroy(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_SAMPLING_PROFILER_H */
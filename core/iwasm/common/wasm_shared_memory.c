@@ -26,46 +26,58 @@ korp_mutex g_shared_memory_lock;
 /* clang-format off */
 enum {
     S_WAITING,
-    S_NOTIFIED
+    S_NOTIFIED,
+    S_INTERRUPTED
 };
 /* clang-format on */
 
-typedef struct AtomicWaitInfo {
-    bh_list wait_list_head;
-    bh_list *wait_list;
-    /* WARNING: insert to the list allowed only in acquire_wait_info
-       otherwise there will be data race as described in PR #2016 */
-} AtomicWaitInfo;
-
+/* A thread waiting with atomic.wait, allocated on its native stack */
 typedef struct AtomicWaitNode {
-    bh_list_link l;
-    uint8 status;
+    struct AtomicWaitNode *prev;
+    struct AtomicWaitNode *next;
+    void *address;
+    WASMModuleInstanceCommon *module_inst;
+    /* S_WAITING until the waiter is removed from the wait list by
+       atomic.notify or by the termination of its thread, which is also
+       the futex word the waiter sleeps on */
+    uint32 status;
+#ifndef OS_ENABLE_FUTEX
     korp_cond wait_cond;
+#endif
 } AtomicWaitNode;
 
-/* Atomic wait map */
-static HashMap *wait_map;
+/* The waiters are kept in a table sharded by the address they wait on,
+   so that waits and notifies of different addresses rarely contend on
+   the same lock. The lock of a shard is only held to add, remove or
+   notify a waiter, not while waiting, except that it is used with the
+   condition variable of the waiter when futex isn't supported. */
+#define WAIT_TABLE_SHARD_NUM 64
 
-static uint32
-wait_address_hash(const void *address);
+typedef struct AtomicWaitShard {
+    korp_mutex lock;
+    /* The waiters of all addresses of the shard in FIFO order */
+    AtomicWaitNode *first;
+    AtomicWaitNode *last;
+} AtomicWaitShard;
 
-static bool
-wait_address_equal(void *h1, void *h2);
-
-static void
-destroy_wait_info(void *wait_info);
+static AtomicWaitShard wait_table[WAIT_TABLE_SHARD_NUM];
 
 bool
 wasm_shared_memory_init()
 {
+    uint32 i;
+
     if (os_mutex_init(&g_shared_memory_lock) != 0)
         return false;
-    /* wait map not exists, create new map */
-    if (!(wait_map = bh_hash_map_create(32, true, (HashFunc)wait_address_hash,
-                                        (KeyEqualFunc)wait_address_equal, NULL,
-                                        destroy_wait_info))) {
-        os_mutex_destroy(&g_shared_memory_lock);
-        return false;
+
+    for (i = 0; i < WAIT_TABLE_SHARD_NUM; i++) {
+        if (os_mutex_init(&wait_table[i].lock) != 0) {
+            while (i > 0)
+                os_mutex_destroy(&wait_table[--i].lock);
+            os_mutex_destroy(&g_shared_memory_lock);
+            return false;
+        }
+        wait_table[i].first = wait_table[i].last = NULL;
     }
     return true;
 }
@@ -73,7 +85,12 @@ wasm_shared_memory_init()
 void
 wasm_shared_memory_destroy()
 {
-    bh_hash_map_destroy(wait_map);
+    uint32 i;
+
+    for (i = 0; i < WAIT_TABLE_SHARD_NUM; i++) {
+        bh_assert(!wait_table[i].first);
+        os_mutex_destroy(&wait_table[i].lock);
+    }
     os_mutex_destroy(&g_shared_memory_lock);
 }
 
@@ -110,140 +127,62 @@ shared_memory_dec_reference(WASMMemoryInstance *memory)
     return old - 1;
 }
 
-static korp_mutex *
-shared_memory_get_lock_pointer(WASMMemoryInstance *memory)
-{
-    bh_assert(memory != NULL);
-    return &g_shared_memory_lock;
-}
-
 /* Atomics wait && notify APIs */
-static uint32
-wait_address_hash(const void *address)
+static AtomicWaitShard *
+get_wait_shard(const void *address)
 {
-    return (uint32)(uintptr_t)address;
-}
+    /* The addresses waited on are at least 4-byte aligned, mix the
+       higher bits in since adjacent words are often used together */
+    uintptr_t h = (uintptr_t)address >> 2;
 
-static bool
-wait_address_equal(void *h1, void *h2)
-{
-    return h1 == h2 ? true : false;
+    h ^= h >> 6;
+    h ^= h >> 12;
+    return &wait_table[h & (WAIT_TABLE_SHARD_NUM - 1)];
 }
 
-static bool
-is_wait_node_exists(bh_list *wait_list, AtomicWaitNode *node)
-{
-    AtomicWaitNode *curr;
-    curr = bh_list_first_elem(wait_list);
-
-    while (curr) {
-        if (curr == node) {
-            return true;
-        }
-        curr = bh_list_elem_next(curr);
-    }
-
-    return false;
-}
-
-static uint32
-notify_wait_list(bh_list *wait_list, uint32 count)
-{
-    AtomicWaitNode *node, *next;
-    uint32 i, notify_count = count;
-
-    if (count > wait_list->len)
-        notify_count = wait_list->len;
-
-    node = bh_list_first_elem(wait_list);
-    if (!node)
-        return 0;
-
-    for (i = 0; i < notify_count; i++) {
-        bh_assert(node);
-        next = bh_list_elem_next(node);
-
-        node->status = S_NOTIFIED;
-        /* wakeup */
-        os_cond_signal(&node->wait_cond);
-
-        node = next;
-    }
-
-    return notify_count;
-}
-
-static AtomicWaitInfo *
-acquire_wait_info(void *address, AtomicWaitNode *wait_node)
+/* The caller should lock the shard */
+static void
+wait_list_append(AtomicWaitShard *shard, AtomicWaitNode *node)
 {
-    AtomicWaitInfo *wait_info = NULL;
-    bh_list_status ret;
-
-    bh_assert(address != NULL);
-
-    wait_info = (AtomicWaitInfo *)bh_hash_map_find(wait_map, address);
-
-    if (!wait_node) {
-        return wait_info;
-    }
-
-    /* No wait info on this address, create new info */
-    if (!wait_info) {
-        if (!(wait_info = (AtomicWaitInfo *)wasm_runtime_malloc(
-                  sizeof(AtomicWaitInfo)))) {
-            return NULL;
-        }
-        memset(wait_info, 0, sizeof(AtomicWaitInfo));
-
-        /* init wait list */
-        wait_info->wait_list = &wait_info->wait_list_head;
-        ret = bh_list_init(wait_info->wait_list);
-        bh_assert(ret == BH_LIST_SUCCESS);
-        (void)ret;
-
-        if (!bh_hash_map_insert(wait_map, address, (void *)wait_info)) {
-            wasm_runtime_free(wait_info);
-            return NULL;
-        }
-    }
-
-    ret = bh_list_insert(wait_info->wait_list, wait_node);
-    bh_assert(ret == BH_LIST_SUCCESS);
-    (void)ret;
-
-    return wait_info;
+    node->next = NULL;
+    node->prev = shard->last;
+    if (shard->last)
+        shard->last->next = node;
+    else
+        shard->first = node;
+    shard->last = node;
 }
 
+/* The caller should lock the shard */
 static void
-destroy_wait_info(void *wait_info)
+wait_list_remove(AtomicWaitShard *shard, AtomicWaitNode *node)
 {
-    AtomicWaitNode *node, *next;
-
-    if (wait_info) {
-
-        node = bh_list_first_elem(((AtomicWaitInfo *)wait_info)->wait_list);
-
-        while (node) {
-            next = bh_list_elem_next(node);
-            os_cond_destroy(&node->wait_cond);
-            wasm_runtime_free(node);
-            node = next;
-        }
-
-        wasm_runtime_free(wait_info);
-    }
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        shard->first = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        shard->last = node->prev;
+    node->prev = node->next = NULL;
 }
 
+/* Remove the waiter from the wait list and wake it up with the new
+   status, the caller should lock the shard */
 static void
-map_try_release_wait_info(HashMap *wait_hash_map, AtomicWaitInfo *wait_info,
-                          void *address)
+wake_wait_node(AtomicWaitShard *shard, AtomicWaitNode *node, uint32 status)
 {
-    if (wait_info->wait_list->len > 0) {
-        return;
-    }
-
-    bh_hash_map_remove(wait_hash_map, address, NULL, NULL);
-    destroy_wait_info(wait_info);
+    wait_list_remove(shard, node);
+#ifdef OS_ENABLE_FUTEX
+    BH_ATOMIC_32_STORE(node->status, status);
+    /* The waiter locks the shard before returning, so the node is
+       still valid here */
+    os_futex_wake(&node->status, 1);
+#else
+    node->status = status;
+    os_cond_signal(&node->wait_cond);
+#endif
 }
 
 #if WASM_ENABLE_SHARED_HEAP != 0
@@ -276,14 +215,14 @@ wasm_runtime_atomic_wait(WASMModuleInstanceCommon *module, void *address,
                          uint64 expect, int64 timeout, bool wait64)
 {
     WASMModuleInstance *module_inst = (WASMModuleInstance *)module;
-    AtomicWaitInfo *wait_info;
-    AtomicWaitNode *wait_node;
-    korp_mutex *lock;
+    AtomicWaitShard *shard;
+    AtomicWaitNode wait_node;
 #if WASM_ENABLE_THREAD_MGR != 0
     WASMExecEnv *exec_env;
 #endif
-    uint64 timeout_left, timeout_wait, timeout_1sec;
-    bool check_ret, is_timeout, no_wait;
+    uint64 deadline = 0, now, timeout_wait, timeout_1sec = (uint64)1e6;
+    uint32 status;
+    bool no_wait;
 
     bh_assert(module->module_type == Wasm_Module_Bytecode
               || module->module_type == Wasm_Module_AoT);
@@ -317,105 +256,98 @@ wasm_runtime_atomic_wait(WASMModuleInstanceCommon *module, void *address,
     shared_memory_unlock(module_inst->memories[0]);
 
 #if WASM_ENABLE_THREAD_MGR != 0
+    /* Search it before locking the shard, the cluster list lock must not
+       be taken with a shard locked since wasm_cluster_cancel_thread locks
+       the shards with the cluster list lock held */
     exec_env =
         wasm_clusters_search_exec_env((WASMModuleInstanceCommon *)module_inst);
     bh_assert(exec_env);
 #endif
 
-    lock = shared_memory_get_lock_pointer(module_inst->memories[0]);
+    memset(&wait_node, 0, sizeof(AtomicWaitNode));
+    wait_node.address = address;
+    wait_node.module_inst = module;
+    wait_node.status = S_WAITING;
+#ifndef OS_ENABLE_FUTEX
+    if (0 != os_cond_init(&wait_node.wait_cond)) {
+        wasm_runtime_set_exception(module, "failed to init wait cond");
+        return -1;
+    }
+#endif
+
+    if (timeout >= 0) {
+        /* unit of timeout is nsec, convert it to usec */
+        deadline = os_time_get_boot_us() + (uint64)timeout / 1000;
+    }
+
+    shard = get_wait_shard(address);
 
-    /* Lock the shared_mem_lock for the whole atomic wait process,
-       and use it to os_cond_reltimedwait */
-    os_mutex_lock(lock);
+    /* The notifier locks the shard too, so checking the value and adding
+       the waiter to the wait list are atomic against atomic.notify */
+    os_mutex_lock(&shard->lock);
 
     no_wait = (!wait64 && *(uint32 *)address != (uint32)expect)
               || (wait64 && *(uint64 *)address != expect);
 
     if (no_wait) {
-        os_mutex_unlock(lock);
+        os_mutex_unlock(&shard->lock);
+#ifndef OS_ENABLE_FUTEX
+        os_cond_destroy(&wait_node.wait_cond);
+#endif
         return 1;
     }
 
-    if (!(wait_node = wasm_runtime_malloc(sizeof(AtomicWaitNode)))) {
-        os_mutex_unlock(lock);
-        wasm_runtime_set_exception(module, "failed to create wait node");
-        return -1;
-    }
-    memset(wait_node, 0, sizeof(AtomicWaitNode));
-
-    if (0 != os_cond_init(&wait_node->wait_cond)) {
-        os_mutex_unlock(lock);
-        wasm_runtime_free(wait_node);
-        wasm_runtime_set_exception(module, "failed to init wait cond");
-        return -1;
-    }
-
-    wait_node->status = S_WAITING;
-
-    /* Acquire the wait info, create new one if not exists */
-    wait_info = acquire_wait_info(address, wait_node);
-
-    if (!wait_info) {
-        os_mutex_unlock(lock);
-        os_cond_destroy(&wait_node->wait_cond);
-        wasm_runtime_free(wait_node);
-        wasm_runtime_set_exception(module, "failed to acquire wait_info");
-        return -1;
-    }
+    wait_list_append(shard, &wait_node);
 
-    /* unit of timeout is nsec, convert it to usec */
-    timeout_left = (uint64)timeout / 1000;
-    timeout_1sec = (uint64)1e6;
+#ifdef OS_ENABLE_FUTEX
+    os_mutex_unlock(&shard->lock);
+#endif
 
     while (1) {
-        if (timeout < 0) {
-            /* wait forever until it is notified or terminated
-               here we keep waiting and checking every second */
-            os_cond_reltimedwait(&wait_node->wait_cond, lock,
-                                 (uint64)timeout_1sec);
-            if (wait_node->status == S_NOTIFIED /* notified by atomic.notify */
-#if WASM_ENABLE_THREAD_MGR != 0
-                /* terminated by other thread */
-                || wasm_cluster_is_thread_terminated(exec_env)
-#endif
-            ) {
+        /* Wake up every second to check whether the thread is terminated
+           in case the termination happens before the thread waits */
+        timeout_wait = timeout_1sec;
+        if (timeout >= 0) {
+            now = os_time_get_boot_us();
+            if (now >= deadline)
                 break;
-            }
+            if (deadline - now < timeout_wait)
+                timeout_wait = deadline - now;
         }
-        else {
-            timeout_wait =
-                timeout_left < timeout_1sec ? timeout_left : timeout_1sec;
-            os_cond_reltimedwait(&wait_node->wait_cond, lock, timeout_wait);
-            if (wait_node->status == S_NOTIFIED /* notified by atomic.notify */
-                || timeout_left <= timeout_wait /* time out */
+
+#ifdef OS_ENABLE_FUTEX
+        os_futex_wait(&wait_node.status, S_WAITING, timeout_wait);
+        status = BH_ATOMIC_32_LOAD(wait_node.status);
+#else
+        os_cond_reltimedwait(&wait_node.wait_cond, &shard->lock, timeout_wait);
+        status = wait_node.status;
+#endif
+        if (status != S_WAITING)
+            break;
+
 #if WASM_ENABLE_THREAD_MGR != 0
-                /* terminated by other thread */
-                || wasm_cluster_is_thread_terminated(exec_env)
+        /* Woken up by the timer or spuriously, check whether the
+           thread is terminated by other thread */
+        if (wasm_cluster_is_thread_terminated(exec_env))
+            break;
 #endif
-            ) {
-                break;
-            }
-            timeout_left -= timeout_wait;
-        }
     }
 
-    is_timeout = wait_node->status == S_WAITING ? true : false;
-
-    check_ret = is_wait_node_exists(wait_info->wait_list, wait_node);
-    bh_assert(check_ret);
-    (void)check_ret;
-
-    /* Remove wait node from wait list */
-    bh_list_remove(wait_info->wait_list, wait_node);
-    os_cond_destroy(&wait_node->wait_cond);
-    wasm_runtime_free(wait_node);
-
-    /* Release wait info if no wait nodes are attached */
-    map_try_release_wait_info(wait_map, wait_info, address);
+#ifdef OS_ENABLE_FUTEX
+    os_mutex_lock(&shard->lock);
+#endif
+    status = wait_node.status;
+    if (status == S_WAITING) {
+        /* Timed out or terminated, nobody has removed the waiter */
+        wait_list_remove(shard, &wait_node);
+    }
+    os_mutex_unlock(&shard->lock);
 
-    os_mutex_unlock(lock);
+#ifndef OS_ENABLE_FUTEX
+    os_cond_destroy(&wait_node.wait_cond);
+#endif
 
-    return is_timeout ? 2 : 0;
+    return status == S_NOTIFIED ? 0 : 2;
 }
 
 uint32
@@ -423,9 +355,9 @@ wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
                            uint32 count)
 {
     WASMModuleInstance *module_inst = (WASMModuleInstance *)module;
-    uint32 notify_result;
-    AtomicWaitInfo *wait_info;
-    korp_mutex *lock;
+    AtomicWaitShard *shard;
+    AtomicWaitNode *node, *next;
+    uint32 notify_count = 0;
     bool out_of_bounds;
 
     bh_assert(module->module_type == Wasm_Module_Bytecode
@@ -454,24 +386,42 @@ wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
         return 0;
     }
 
-    lock = shared_memory_get_lock_pointer(module_inst->memories[0]);
+    if (count == 0)
+        return 0;
 
-    /* Lock the shared_mem_lock for the whole atomic notify process,
-       and use it to os_cond_signal */
-    os_mutex_lock(lock);
+    shard = get_wait_shard(address);
 
-    wait_info = acquire_wait_info(address, NULL);
+    os_mutex_lock(&shard->lock);
 
-    /* Nobody wait on this address */
-    if (!wait_info) {
-        os_mutex_unlock(lock);
-        return 0;
+    /* Notify the waiters of the address in the order they wait */
+    for (node = shard->first; node && notify_count < count; node = next) {
+        next = node->next;
+        if (node->address == address) {
+            wake_wait_node(shard, node, S_NOTIFIED);
+            notify_count++;
+        }
     }
 
-    /* Notify each wait node in the wait list */
-    notify_result = notify_wait_list(wait_info->wait_list, count);
+    os_mutex_unlock(&shard->lock);
 
-    os_mutex_unlock(lock);
+    return notify_count;
+}
 
-    return notify_result;
+void
+wasm_runtime_atomic_wait_interrupt(WASMModuleInstanceCommon *module)
+{
+    AtomicWaitShard *shard;
+    AtomicWaitNode *node, *next;
+    uint32 i;
+
+    for (i = 0; i < WAIT_TABLE_SHARD_NUM; i++) {
+        shard = &wait_table[i];
+        os_mutex_lock(&shard->lock);
+        for (node = shard->first; node; node = next) {
+            next = node->next;
+            if (node->module_inst == module)
+                wake_wait_node(shard, node, S_INTERRUPTED);
+        }
+        os_mutex_unlock(&shard->lock);
+    }
 }
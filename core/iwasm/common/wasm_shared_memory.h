@@ -56,6 +56,11 @@ uint32
 wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
                            uint32 count);
 
+/* Wake up the threads waiting with atomic.wait in the module instance,
+   the waits return as timed out */
+void
+wasm_runtime_atomic_wait_interrupt(WASMModuleInstanceCommon *module);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,12 @@ extern "C" {
 #define AOT_FUNC_INTERNAL_PREFIX "aot_func_internal#"
 #endif
 
+/* Prefix of the runtime symbols referenced by the JIT code when the
+   JIT cache is enabled */
+#ifndef AOT_JIT_SYMBOL_PREFIX
+#define AOT_JIT_SYMBOL_PREFIX "aot_jit_symbol#"
+#endif
+
 #ifndef AOT_STACK_SIZES_NAME
 #define AOT_STACK_SIZES_NAME "aot_stack_sizes"
 #endif
@@ -196,6 +202,10 @@ typedef struct AOTImportFunc {
     const char *signature;
     /* attachment */
     void *attachment;
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    /* signature precompiled after linked */
+    WASMNativeCallDesc native_call;
+#endif
     bool call_conv_raw;
     bool call_conv_wasm_c_api;
     bool wasm_c_api_with_env;
@@ -304,6 +314,13 @@ typedef struct AOTNativeSymbol {
     int32 index;
 } AOTNativeSymbol;
 
+/* The runtime symbol referenced by the JIT code */
+typedef struct AOTJITSymbol {
+    bh_list_link link;
+    char symbol[64];
+    const void *addr;
+} AOTJITSymbol;
+
 AOTCompData *
 aot_create_comp_data(WASMModule *module, const char *target_arch,
                      bool gc_enabled);
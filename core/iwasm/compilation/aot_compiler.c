@@ -679,10 +679,7 @@ aot_gen_commit_sp_ip(AOTCompFrame *frame, bool commit_sp, bool commit_ip)
                 value = I32_CONST((uint32)(uintptr_t)(ip - module->load_addr));
         }
         else {
-            if (is_64bit)
-                value = I64_CONST((uint64)(uintptr_t)ip);
-            else
-                value = I32_CONST((uint32)(uintptr_t)ip);
+            value = aot_get_jit_ip_addr(comp_ctx, ip);
         }
 
         if (!value) {
@@ -1043,7 +1040,10 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
         }
     }
 
+    func_ctx->frame_ip_end = frame_ip_end;
+
     while (frame_ip < frame_ip_end) {
+        func_ctx->cur_frame_ip = frame_ip;
         opcode = *frame_ip++;
 
         if (comp_ctx->aot_frame) {
@@ -4012,6 +4012,21 @@ aot_compile_wasm(AOTCompContext *comp_ctx)
         return false;
     }
 
+    /* All the functions are found in the JIT cache, add the cached objects
+       to the JIT rather than translating the module */
+    if (comp_ctx->jit_cache_hit) {
+        LLVMOrcJITDylibRef orc_main_dylib =
+            LLVMOrcLLLazyJITGetMainJITDylib(comp_ctx->orc_jit);
+
+        bh_print_time("Begin to load the module from JIT cache");
+        if (!orc_main_dylib) {
+            aot_set_last_error(
+                "failed to get orc orc_jit main dynamic library");
+            return false;
+        }
+        return aot_load_jit_cache(comp_ctx, orc_main_dylib);
+    }
+
     bh_print_time("Begin to compile WASM bytecode to LLVM IR");
     for (i = 0; i < comp_ctx->func_ctx_count; i++) {
         if (!aot_compile_func(comp_ctx, i)) {
@@ -4045,6 +4060,14 @@ aot_compile_wasm(AOTCompContext *comp_ctx)
         bh_print_time("Finish llvm optimization passes");
     }
 
+    /* Write the report after optimization, which may version loops to
+       remove their bound checks */
+    if (comp_ctx->bound_check_report_file
+        && !aot_emit_bound_check_report(comp_ctx,
+                                        comp_ctx->bound_check_report_file)) {
+        return false;
+    }
+
 #ifdef DUMP_MODULE
     LLVMDumpModule(comp_ctx->module);
     os_printf("\n");
@@ -4062,6 +4085,11 @@ aot_compile_wasm(AOTCompContext *comp_ctx)
             return false;
         }
 
+        /* Resolve the runtime symbols referenced by the JIT code */
+        if (!aot_define_jit_symbols(comp_ctx, orc_main_dylib)) {
+            return false;
+        }
+
         orc_thread_safe_module = LLVMOrcCreateNewThreadSafeModule(
             comp_ctx->module, comp_ctx->orc_thread_safe_context);
         if (!orc_thread_safe_module) {
@@ -765,7 +765,8 @@ set_local_gc_ref(AOTCompFrame *frame, int n, LLVMValueRef value, uint8 ref_type)
                 aot_set_last_error("llvm add pointer type failed.");        \
                 goto fail;                                                  \
             }                                                               \
-            if (!(value = I64_CONST((uint64)(uintptr_t)name))               \
+            if (!(value = aot_get_jit_symbol_addr(comp_ctx, #name,          \
+                                                  (void *)name))            \
                 || !(func = LLVMConstIntToPtr(value, func_ptr_type))) {     \
                 aot_set_last_error("create LLVM value failed.");            \
                 goto fail;                                                  \
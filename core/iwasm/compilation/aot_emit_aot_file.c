@@ -82,6 +82,18 @@ typedef struct AOTObjectData {
     const char *stack_sizes_section_name;
     uint32 stack_sizes_offset;
     uint32 *stack_sizes;
+
+    /* objects of the partitions emitted in parallel, which are merged
+       into this one */
+    struct AOTObjectData **partitions;
+    uint32 partition_count;
+    /* whether the text is the merged text of the partitions */
+    bool is_text_allocated;
+
+    /* offsets of the text and the data sections of a partition in the
+       merged ones */
+    uint32 merged_text_offset;
+    uint32 *merged_data_offsets;
 } AOTObjectData;
 
 #if 0
@@ -2033,7 +2045,13 @@ aot_emit_table_info(uint8 *buf, uint8 *buf_end, uint32 *p_offset,
         EMIT_U32(init_datas[i]->elem_type);
         EMIT_U32(init_datas[i]->table_index);
         EMIT_U32(init_datas[i]->offset.init_expr_type);
-        EMIT_U64(init_datas[i]->offset.u.i64);
+        /* Only the low 32 bits of the value are set by the loader if it
+           isn't an i64 const, don't emit the garbage in the high 32 bits
+           so that the generated AOT file is reproducible */
+        if (init_datas[i]->offset.init_expr_type == INIT_EXPR_TYPE_I64_CONST)
+            EMIT_U64(init_datas[i]->offset.u.i64);
+        else
+            EMIT_U64((uint64)init_datas[i]->offset.u.u32);
 #if WASM_ENABLE_GC != 0
         if (comp_ctx->enable_gc && init_datas[i]->elem_ref_type) {
             EMIT_U16(init_datas[i]->elem_ref_type->ref_ht_common.ref_type);
@@ -4273,9 +4291,629 @@ aot_obj_data_destroy(AOTObjectData *obj_data)
         destroy_relocation_symbol_list(&obj_data->symbol_list);
     if (obj_data->stack_sizes)
         wasm_runtime_free(obj_data->stack_sizes);
+    if (obj_data->is_text_allocated)
+        wasm_runtime_free(obj_data->text);
+    if (obj_data->merged_data_offsets)
+        wasm_runtime_free(obj_data->merged_data_offsets);
+    if (obj_data->partitions) {
+        uint32 i;
+        for (i = 0; i < obj_data->partition_count; i++) {
+            if (obj_data->partitions[i])
+                aot_obj_data_destroy(obj_data->partitions[i]);
+        }
+        wasm_runtime_free(obj_data->partitions);
+    }
     wasm_runtime_free(obj_data);
 }
 
+/* Alignment of the text and the data sections of the partitions in the
+   merged sections, which isn't less than the one LLVM aligns them to */
+#define PARTITION_SECTION_ALIGN 64
+
+/* A symbol defined in a partition, and its section and offset in the
+   merged object */
+typedef struct AOTPartitionSymbol {
+    const char *name;
+    const char *section_name;
+    uint32 offset;
+    uint32 partition_idx;
+} AOTPartitionSymbol;
+
+static int
+partition_symbol_cmp(const void *a, const void *b)
+{
+    const AOTPartitionSymbol *sym1 = (const AOTPartitionSymbol *)a;
+    const AOTPartitionSymbol *sym2 = (const AOTPartitionSymbol *)b;
+    int ret = strcmp(sym1->name, sym2->name);
+
+    if (ret != 0)
+        return ret;
+    if (sym1->partition_idx != sym2->partition_idx)
+        return sym1->partition_idx < sym2->partition_idx ? -1 : 1;
+    return 0;
+}
+
+/* Get the offset of a text section of the partition in its text, which is
+   laid out as aot_resolve_functions does, or -1 if it isn't a text section */
+static int64
+get_partition_text_offset(AOTObjectData *part, const char *section_name)
+{
+    if (!strcmp(section_name, ".text") || !strcmp(section_name, ".ltext"))
+        return 0;
+    if (!strcmp(section_name, ".text.unlikely.")
+        || !strcmp(section_name, ".ltext.unlikely."))
+        return align_uint(part->text_size, 4);
+    if (!strcmp(section_name, ".text.hot.")
+        || !strcmp(section_name, ".ltext.hot."))
+        return align_uint(part->text_size, 4)
+               + align_uint(part->text_unlikely_size, 4);
+    return -1;
+}
+
+static int32
+get_data_section_index(AOTObjectData *obj_data, const char *section_name)
+{
+    uint32 i;
+
+    for (i = 0; i < obj_data->data_sections_count; i++) {
+        if (!strcmp(obj_data->data_sections[i].name, section_name))
+            return (int32)i;
+    }
+    return -1;
+}
+
+static bool
+merge_partition_texts(AOTObjectData *obj_data)
+{
+    AOTObjectData *part;
+    uint8 *text;
+    uint64 total_size = 0;
+    uint32 i, offset;
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        total_size = align_uint64(total_size, PARTITION_SECTION_ALIGN);
+        part->merged_text_offset = (uint32)total_size;
+        total_size += (uint64)align_uint(part->text_size, 4)
+                      + align_uint(part->text_unlikely_size, 4)
+                      + align_uint(part->text_hot_size, 4);
+        if (total_size >= UINT32_MAX) {
+            aot_set_last_error("text size of the partitions too large.");
+            return false;
+        }
+    }
+
+    if (!(text = wasm_runtime_malloc((uint32)total_size + 1))) {
+        aot_set_last_error("allocate memory for text failed.");
+        return false;
+    }
+    memset(text, 0, (uint32)total_size + 1);
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        offset = part->merged_text_offset;
+        if (part->text_size > 0)
+            bh_memcpy_s(text + offset, part->text_size, part->text,
+                        part->text_size);
+        offset += align_uint(part->text_size, 4);
+        if (part->text_unlikely_size > 0)
+            bh_memcpy_s(text + offset, part->text_unlikely_size,
+                        part->text_unlikely, part->text_unlikely_size);
+        offset += align_uint(part->text_unlikely_size, 4);
+        if (part->text_hot_size > 0)
+            bh_memcpy_s(text + offset, part->text_hot_size, part->text_hot,
+                        part->text_hot_size);
+    }
+
+    obj_data->text = text;
+    obj_data->text_size = (uint32)total_size;
+    obj_data->is_text_allocated = true;
+    return true;
+}
+
+static bool
+merge_partition_data_sections(AOTObjectData *obj_data)
+{
+    AOTObjectData *part;
+    AOTObjectDataSection *data_section;
+    uint64 total_size = 0, size;
+    uint32 i, j;
+    int32 idx;
+
+    for (i = 0; i < obj_data->partition_count; i++)
+        total_size += obj_data->partitions[i]->data_sections_count;
+    if (total_size == 0)
+        return true;
+
+    size = sizeof(AOTObjectDataSection) * total_size;
+    if (size >= UINT32_MAX
+        || !(obj_data->data_sections = wasm_runtime_malloc((uint32)size))) {
+        aot_set_last_error("allocate memory for data sections failed.");
+        return false;
+    }
+    memset(obj_data->data_sections, 0, (uint32)size);
+
+    /* The sections with the same name are concatenated in the order of
+       the partitions, record the offset of each one */
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        if (part->data_sections_count == 0)
+            continue;
+
+        size = sizeof(uint32) * (uint64)part->data_sections_count;
+        if (!(part->merged_data_offsets = wasm_runtime_malloc((uint32)size))) {
+            aot_set_last_error("allocate memory failed.");
+            return false;
+        }
+
+        for (j = 0; j < part->data_sections_count; j++) {
+            idx = get_data_section_index(obj_data, part->data_sections[j].name);
+            if (idx < 0) {
+                idx = (int32)obj_data->data_sections_count++;
+                obj_data->data_sections[idx].name =
+                    part->data_sections[j].name;
+            }
+            data_section = obj_data->data_sections + idx;
+            size = align_uint64(data_section->size, PARTITION_SECTION_ALIGN);
+            part->merged_data_offsets[j] = (uint32)size;
+            size += part->data_sections[j].size;
+            if (size >= UINT32_MAX) {
+                aot_set_last_error("data section size too large.");
+                return false;
+            }
+            data_section->size = (uint32)size;
+        }
+    }
+
+    for (i = 0; i < obj_data->data_sections_count; i++) {
+        data_section = obj_data->data_sections + i;
+        if (!(data_section->data =
+                  wasm_runtime_malloc(data_section->size + 1))) {
+            aot_set_last_error("allocate memory for data section failed.");
+            return false;
+        }
+        memset(data_section->data, 0, data_section->size + 1);
+        data_section->is_data_allocated = true;
+    }
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->data_sections_count; j++) {
+            if (!part->data_sections[j].data
+                || part->data_sections[j].size == 0)
+                continue;
+            idx = get_data_section_index(obj_data, part->data_sections[j].name);
+            data_section = obj_data->data_sections + idx;
+            bh_memcpy_s(data_section->data + part->merged_data_offsets[j],
+                        data_section->size - part->merged_data_offsets[j],
+                        part->data_sections[j].data,
+                        part->data_sections[j].size);
+        }
+    }
+
+    return true;
+}
+
+/* Resolve the symbols defined in the text and the data sections of the
+   partition, or only count them if symbols is NULL */
+static bool
+resolve_partition_symbols(AOTObjectData *part, uint32 partition_idx,
+                          AOTPartitionSymbol *symbols, uint32 *p_count)
+{
+    LLVMSymbolIteratorRef sym_itr;
+    LLVMSectionIteratorRef sec_itr;
+    AOTPartitionSymbol *symbol;
+    const char *name, *section_name, *sym_section_name;
+    int64 text_offset;
+    uint32 offset = 0;
+    int32 idx;
+
+    if (!(sym_itr = LLVMObjectFileCopySymbolIterator(part->binary))) {
+        aot_set_last_error("llvm get symbol iterator failed.");
+        return false;
+    }
+
+    while (!LLVMObjectFileIsSymbolIteratorAtEnd(part->binary, sym_itr)) {
+        if ((name = LLVMGetSymbolName(sym_itr)) && *name != '\0') {
+            if (!(sec_itr = LLVMObjectFileCopySectionIterator(part->binary))) {
+                aot_set_last_error("llvm get section iterator failed.");
+                LLVMDisposeSymbolIterator(sym_itr);
+                return false;
+            }
+            LLVMMoveToContainingSection(sec_itr, sym_itr);
+            /* skip the undefined symbols and the section symbols */
+            if (!LLVMObjectFileIsSectionIteratorAtEnd(part->binary, sec_itr)
+                && (section_name = LLVMGetSectionName(sec_itr))
+                && strcmp(name, section_name)) {
+                sym_section_name = NULL;
+                if ((text_offset =
+                         get_partition_text_offset(part, section_name))
+                    >= 0) {
+                    sym_section_name = ".text";
+                    offset = part->merged_text_offset + (uint32)text_offset;
+                }
+                else if ((idx = get_data_section_index(part, section_name))
+                         >= 0) {
+                    sym_section_name = part->data_sections[idx].name;
+                    offset = part->merged_data_offsets[idx];
+                }
+                if (sym_section_name) {
+                    if (symbols) {
+                        symbol = symbols + *p_count;
+                        symbol->name = name;
+                        symbol->section_name = sym_section_name;
+                        symbol->offset =
+                            offset + (uint32)LLVMGetSymbolAddress(sym_itr);
+                        symbol->partition_idx = partition_idx;
+                    }
+                    (*p_count)++;
+                }
+            }
+            LLVMDisposeSectionIterator(sec_itr);
+        }
+        LLVMMoveToNextSymbol(sym_itr);
+    }
+    LLVMDisposeSymbolIterator(sym_itr);
+
+    return true;
+}
+
+static AOTPartitionSymbol *
+find_partition_symbol(AOTPartitionSymbol *symbols, uint32 symbol_count,
+                      const char *name, uint32 partition_idx)
+{
+    uint32 low = 0, high = symbol_count, mid, i;
+
+    /* find the first symbol with the name */
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (strcmp(symbols[mid].name, name) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    if (low == symbol_count || strcmp(symbols[low].name, name))
+        return NULL;
+
+    /* prefer the one defined in the partition itself, e.g. a local symbol
+       whose name is also used by other partitions */
+    for (i = low; i < symbol_count && !strcmp(symbols[i].name, name); i++) {
+        if (symbols[i].partition_idx == partition_idx)
+            return symbols + i;
+    }
+    return symbols + low;
+}
+
+static bool
+merge_partition_functions(AOTCompContext *comp_ctx, AOTObjectData *obj_data,
+                          AOTPartitionSymbol *symbols, uint32 symbol_count)
+{
+    AOTObjectFunc *func;
+    AOTPartitionSymbol *symbol;
+    char buf[48];
+    uint32 i, total_size;
+
+    obj_data->func_count = comp_ctx->comp_data->func_count;
+    if (obj_data->func_count == 0)
+        return true;
+
+    total_size = (uint32)sizeof(AOTObjectFunc) * obj_data->func_count;
+    if (!(obj_data->funcs = wasm_runtime_malloc(total_size))) {
+        aot_set_last_error("allocate memory for functions failed.");
+        return false;
+    }
+    memset(obj_data->funcs, 0, total_size);
+
+    for (i = 0, func = obj_data->funcs; i < obj_data->func_count;
+         i++, func++) {
+        snprintf(buf, sizeof(buf), "%s%" PRIu32, AOT_FUNC_PREFIX, i);
+        if ((symbol = find_partition_symbol(symbols, symbol_count, buf, 0))) {
+            func->func_name = (char *)symbol->name;
+            func->text_offset = symbol->offset;
+        }
+        snprintf(buf, sizeof(buf), "%s%" PRIu32, AOT_FUNC_INTERNAL_PREFIX, i);
+        if ((symbol = find_partition_symbol(symbols, symbol_count, buf, 0)))
+            func->text_offset_of_aot_func_internal = symbol->offset;
+    }
+
+    return true;
+}
+
+static bool
+is_text_relocation_group(const char *section_name)
+{
+    return !strcmp(section_name, ".rela.text")
+           || !strcmp(section_name, ".rel.text")
+           || !strcmp(section_name, ".rela.ltext")
+           || !strcmp(section_name, ".rel.ltext");
+}
+
+/* Rebase a relocation of the partition to the merged sections */
+static bool
+rebase_partition_relocation(AOTObjectData *part, uint32 partition_idx,
+                            AOTRelocationGroup *group,
+                            AOTRelocation *relocation,
+                            AOTPartitionSymbol *symbols, uint32 symbol_count)
+{
+    AOTPartitionSymbol *symbol;
+    const char *section_name, *symbol_name = relocation->symbol_name;
+    int64 text_offset;
+    int32 idx;
+
+    if (is_text_relocation_group(group->section_name)) {
+        relocation->relocation_offset += part->merged_text_offset;
+    }
+    else {
+        /* the section of ".rela.xxx" or ".rel.xxx" */
+        section_name = group->section_name
+                       + (str_starts_with(group->section_name, ".rela")
+                              ? strlen(".rela")
+                              : strlen(".rel"));
+        if ((idx = get_data_section_index(part, section_name)) < 0) {
+            aot_set_last_error_v("unsupported relocation section %s in "
+                                 "partition.",
+                                 group->section_name);
+            return false;
+        }
+        relocation->relocation_offset += part->merged_data_offsets[idx];
+    }
+
+    relocation->is_symbol_name_allocated = false;
+
+    if ((text_offset = get_partition_text_offset(part, symbol_name)) >= 0) {
+        relocation->symbol_name = ".text";
+        relocation->relocation_addend +=
+            part->merged_text_offset + text_offset;
+    }
+    else if ((idx = get_data_section_index(part, symbol_name)) >= 0) {
+        relocation->relocation_addend += part->merged_data_offsets[idx];
+    }
+    else if (!str_starts_with(symbol_name, AOT_FUNC_PREFIX)) {
+        /* The stack sizes are referenced by the section name, which is
+           only in the partition defining them */
+        if (!strcmp(symbol_name, aot_stack_sizes_section_name))
+            symbol_name = aot_stack_sizes_name;
+        /* The symbols defined in another partition, e.g. the externalized
+           local functions and constants, are resolved to the sections
+           defining them, others are native symbols */
+        if ((symbol = find_partition_symbol(symbols, symbol_count,
+                                            symbol_name, partition_idx))) {
+            relocation->symbol_name = (char *)symbol->section_name;
+            relocation->relocation_addend += symbol->offset;
+        }
+    }
+
+    return true;
+}
+
+static bool
+merge_partition_relocation_groups(AOTObjectData *obj_data,
+                                  AOTPartitionSymbol *symbols,
+                                  uint32 symbol_count)
+{
+    AOTObjectData *part;
+    AOTRelocationGroup *group, *part_group;
+    AOTRelocation *relocation;
+    uint64 total_size = 0;
+    uint32 i, j, k, n, size;
+
+    for (i = 0; i < obj_data->partition_count; i++)
+        total_size += obj_data->partitions[i]->relocation_group_count;
+    if (total_size == 0)
+        return true;
+
+    total_size *= sizeof(AOTRelocationGroup);
+    if (total_size >= UINT32_MAX
+        || !(obj_data->relocation_groups =
+                 wasm_runtime_malloc((uint32)total_size))) {
+        aot_set_last_error("allocate memory for relocation groups failed.");
+        return false;
+    }
+    memset(obj_data->relocation_groups, 0, (uint32)total_size);
+
+    /* The groups with the same name are combined in the order of the
+       partitions, count the relocations of each one */
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->relocation_group_count; j++) {
+            part_group = part->relocation_groups + j;
+            for (k = 0; k < obj_data->relocation_group_count; k++) {
+                if (!strcmp(obj_data->relocation_groups[k].section_name,
+                            part_group->section_name))
+                    break;
+            }
+            group = obj_data->relocation_groups + k;
+            if (k == obj_data->relocation_group_count) {
+                group->section_name = part_group->section_name;
+                obj_data->relocation_group_count++;
+            }
+            group->relocation_count += part_group->relocation_count;
+        }
+    }
+
+    for (k = 0; k < obj_data->relocation_group_count; k++) {
+        group = obj_data->relocation_groups + k;
+        size = (uint32)sizeof(AOTRelocation) * group->relocation_count;
+        if (!(group->relocations = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory for relocations failed.");
+            return false;
+        }
+        relocation = group->relocations;
+
+        for (i = 0; i < obj_data->partition_count; i++) {
+            part = obj_data->partitions[i];
+            for (j = 0; j < part->relocation_group_count; j++) {
+                part_group = part->relocation_groups + j;
+                if (strcmp(part_group->section_name, group->section_name))
+                    continue;
+                size = (uint32)sizeof(AOTRelocation)
+                       * part_group->relocation_count;
+                bh_memcpy_s(relocation, size, part_group->relocations, size);
+                for (n = 0; n < part_group->relocation_count;
+                     n++, relocation++) {
+                    if (!rebase_partition_relocation(part, i, part_group,
+                                                     relocation, symbols,
+                                                     symbol_count))
+                        return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool
+merge_partition_stack_sizes(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
+{
+    AOTObjectData *part;
+    uint32 i;
+    int32 idx;
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        if ((idx = get_data_section_index(part, aot_stack_sizes_section_name))
+            < 0)
+            continue;
+
+        /* The stack usage files of the partitions have been concatenated,
+           resolve the stack sizes of all functions in the partition */
+        part->func_count = obj_data->func_count;
+        if (!aot_resolve_stack_sizes(comp_ctx, part))
+            return false;
+
+        obj_data->stack_sizes = part->stack_sizes;
+        part->stack_sizes = NULL;
+        obj_data->stack_sizes_section_name = part->stack_sizes_section_name;
+        obj_data->stack_sizes_offset =
+            part->merged_data_offsets[idx] + part->stack_sizes_offset;
+        return true;
+    }
+
+    aot_set_last_error("stack_sizes not found.");
+    return false;
+}
+
+/**
+ * Merge the objects of the partitions into one like a static linker: the
+ * text and the data sections are concatenated, the relocations are rebased
+ * to the merged sections, and the ones referring to the symbols defined in
+ * the partitions are resolved to the sections defining them.
+ */
+static bool
+aot_merge_partition_objects(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
+{
+    AOTPartitionSymbol *symbols = NULL;
+    uint32 symbol_count = 0, i, size;
+    bool ret = false;
+
+    if (!merge_partition_texts(obj_data)
+        || !merge_partition_data_sections(obj_data))
+        return false;
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        if (!resolve_partition_symbols(obj_data->partitions[i], i, NULL,
+                                       &symbol_count))
+            return false;
+    }
+    if (symbol_count > 0) {
+        size = (uint32)sizeof(AOTPartitionSymbol) * symbol_count;
+        if (!(symbols = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory failed.");
+            return false;
+        }
+        memset(symbols, 0, size);
+        symbol_count = 0;
+        for (i = 0; i < obj_data->partition_count; i++) {
+            if (!resolve_partition_symbols(obj_data->partitions[i], i,
+                                           symbols, &symbol_count))
+                goto fail;
+        }
+        qsort(symbols, symbol_count, sizeof(AOTPartitionSymbol),
+              partition_symbol_cmp);
+    }
+
+    if (!merge_partition_functions(comp_ctx, obj_data, symbols, symbol_count)
+        || !merge_partition_relocation_groups(obj_data, symbols,
+                                              symbol_count))
+        goto fail;
+
+    if (obj_data->func_count > 0
+        && (comp_ctx->enable_stack_bound_check
+            || comp_ctx->enable_stack_estimation)
+        && !merge_partition_stack_sizes(comp_ctx, obj_data))
+        goto fail;
+
+    ret = true;
+
+fail:
+    if (symbols)
+        wasm_runtime_free(symbols);
+    return ret;
+}
+
+static bool
+aot_obj_data_create_partitions(AOTCompContext *comp_ctx,
+                               AOTObjectData *obj_data)
+{
+    LLVMMemoryBufferRef *objects;
+    AOTObjectData *part;
+    char *err = NULL;
+    uint32 count, i;
+    bool ret = false;
+
+    if (!aot_emit_partition_objects(comp_ctx, &objects, &count))
+        return false;
+    if (count == 0)
+        return true;
+
+    if (!(obj_data->partitions =
+              wasm_runtime_malloc(sizeof(AOTObjectData *) * count))) {
+        aot_set_last_error("allocate memory failed.");
+        goto fail;
+    }
+    memset(obj_data->partitions, 0, sizeof(AOTObjectData *) * count);
+    obj_data->partition_count = count;
+
+    for (i = 0; i < count; i++) {
+        if (!(part = wasm_runtime_malloc(sizeof(AOTObjectData)))) {
+            aot_set_last_error("allocate memory failed.");
+            goto fail;
+        }
+        memset(part, 0, sizeof(AOTObjectData));
+        part->comp_ctx = comp_ctx;
+        part->mem_buf = objects[i];
+        objects[i] = NULL;
+        obj_data->partitions[i] = part;
+
+        if (!(part->binary = LLVMCreateBinary(part->mem_buf, NULL, &err))) {
+            if (err) {
+                LLVMDisposeMessage(err);
+                err = NULL;
+            }
+            aot_set_last_error("llvm create binary failed.");
+            goto fail;
+        }
+
+        if (!aot_resolve_target_info(comp_ctx, part)
+            || !aot_resolve_text(part)
+            || !aot_resolve_object_data_sections(part)
+            || !aot_resolve_object_relocation_groups(part))
+            goto fail;
+    }
+
+    obj_data->target_info = obj_data->partitions[0]->target_info;
+    ret = true;
+
+fail:
+    for (i = 0; i < count; i++) {
+        if (objects[i])
+            LLVMDisposeMemoryBuffer(objects[i]);
+    }
+    wasm_runtime_free(objects);
+    return ret;
+}
+
 AOTObjectData *
 aot_obj_data_create(AOTCompContext *comp_ctx)
 {
@@ -4382,10 +5020,18 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
         }
     }
     else {
-        if (LLVMTargetMachineEmitToMemoryBuffer(
-                comp_ctx->target_machine, comp_ctx->module, LLVMObjectFile,
-                &err, &obj_data->mem_buf)
-            != 0) {
+        /* Emit the partitions of the module in parallel if possible, and
+           the whole module otherwise */
+        if (comp_ctx->parallel_jobs > 0
+            && !aot_obj_data_create_partitions(comp_ctx, obj_data)) {
+            goto fail;
+        }
+
+        if (obj_data->partition_count == 0
+            && LLVMTargetMachineEmitToMemoryBuffer(
+                   comp_ctx->target_machine, comp_ctx->module, LLVMObjectFile,
+                   &err, &obj_data->mem_buf)
+                   != 0) {
             if (err) {
                 LLVMDisposeMessage(err);
                 err = NULL;
@@ -4395,7 +5041,9 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
         }
     }
 
-    if (!(obj_data->binary = LLVMCreateBinary(obj_data->mem_buf, NULL, &err))) {
+    if (obj_data->partition_count == 0
+        && !(obj_data->binary =
+                 LLVMCreateBinary(obj_data->mem_buf, NULL, &err))) {
         if (err) {
             LLVMDisposeMessage(err);
             err = NULL;
@@ -4419,7 +5067,8 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
         obj_data->target_info.feature_flags |= WASM_FEATURE_REF_TYPES;
     }
     if (comp_ctx->enable_gc) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_GARBAGE_COLLECTION;
+        obj_data->target_info.feature_flags |=
+            WASM_FEATURE_GARBAGE_COLLECTION | WASM_FEATURE_GC_WRITE_BARRIER;
     }
     if (comp_ctx->aux_stack_frame_type == AOT_STACK_FRAME_TYPE_TINY) {
         obj_data->target_info.feature_flags |= WASM_FEATURE_TINY_STACK_FRAME;
@@ -4431,6 +5080,14 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
         obj_data->target_info.feature_flags |= WASM_FEATURE_FRAME_NO_FUNC_IDX;
     }
 
+    if (obj_data->partition_count > 0) {
+        bh_print_time("Begin to merge object files of partitions");
+
+        if (!aot_merge_partition_objects(comp_ctx, obj_data))
+            goto fail;
+        return obj_data;
+    }
+
     bh_print_time("Begin to resolve object file info");
 
     /* resolve target info/text/relocations/functions */
@@ -75,8 +75,9 @@ aot_emit_exception(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                 return false;
             }
             /* Create LLVM function with const function pointer */
-            if (!(func_const =
-                      I64_CONST((uint64)(uintptr_t)jit_set_exception_with_id))
+            if (!(func_const = aot_get_jit_symbol_addr(
+                      comp_ctx, "jit_set_exception_with_id",
+                      (void *)jit_set_exception_with_id))
                 || !(func = LLVMConstIntToPtr(func_const, func_ptr_type))) {
                 aot_set_last_error("create LLVM value failed.");
                 return false;
@@ -148,10 +149,7 @@ aot_emit_exception(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                     I32_CONST((uint32)(uintptr_t)(ip - module->load_addr));
         }
         else {
-            if (is_64bit)
-                exce_ip = I64_CONST((uint64)(uintptr_t)ip);
-            else
-                exce_ip = I32_CONST((uint32)(uintptr_t)ip);
+            exce_ip = aot_get_jit_ip_addr(comp_ctx, ip);
         }
 
         if (!exce_ip) {
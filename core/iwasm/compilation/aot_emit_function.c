@@ -187,7 +187,8 @@ call_aot_invoke_native_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
 
         /* JIT mode, call the function directly */
-        if (!(func = I64_CONST((uint64)(uintptr_t)llvm_jit_invoke_native))
+        if (!(func = aot_get_jit_symbol_addr(comp_ctx, "llvm_jit_invoke_native",
+                                             (void *)llvm_jit_invoke_native))
             || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
             aot_set_last_error("create LLVM value failed.");
             return false;
@@ -998,8 +999,9 @@ alloc_frame_for_aot_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 #if WASM_ENABLE_JIT != 0 \
     && (WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_MEMORY_PROFILING != 0)
             /* JIT mode, call the function directly */
-            if (!(func = I64_CONST(
-                      (uint64)(uintptr_t)llvm_jit_frame_update_profile_info))
+            if (!(func = aot_get_jit_symbol_addr(
+                      comp_ctx, "llvm_jit_frame_update_profile_info",
+                      (void *)llvm_jit_frame_update_profile_info))
                 || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
                 aot_set_last_error("create LLVM value failed.");
                 return false;
@@ -1086,8 +1088,9 @@ free_frame_for_aot_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
 #if WASM_ENABLE_JIT != 0 \
     && (WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_MEMORY_PROFILING != 0)
             /* JIT mode, call the function directly */
-            if (!(func = I64_CONST(
-                      (uint64)(uintptr_t)llvm_jit_frame_update_profile_info))
+            if (!(func = aot_get_jit_symbol_addr(
+                      comp_ctx, "llvm_jit_frame_update_profile_info",
+                      (void *)llvm_jit_frame_update_profile_info))
                 || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
                 aot_set_last_error("create LLVM value failed.");
                 return false;
@@ -1190,8 +1193,9 @@ check_app_addr_and_convert(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
 
         /* JIT mode, call the function directly */
-        if (!(func =
-                  I64_CONST((uint64)(uintptr_t)jit_check_app_addr_and_convert))
+        if (!(func = aot_get_jit_symbol_addr(
+                  comp_ctx, "jit_check_app_addr_and_convert",
+                  (void *)jit_check_app_addr_and_convert))
             || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
             aot_set_last_error("create LLVM value failed.");
             return false;
@@ -1957,7 +1961,8 @@ call_aot_call_indirect_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
 
         /* JIT mode, call the function directly */
-        if (!(func = I64_CONST((uint64)(uintptr_t)llvm_jit_call_indirect))
+        if (!(func = aot_get_jit_symbol_addr(comp_ctx, "llvm_jit_call_indirect",
+                                             (void *)llvm_jit_call_indirect))
             || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
             aot_set_last_error("create LLVM value failed.");
             return false;
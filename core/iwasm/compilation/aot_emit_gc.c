@@ -295,6 +295,66 @@ fail:
     return false;
 }
 
+/* Call the write barrier of the GC nursery after a reference is stored
+   into an object, the null and i31 references are skipped inline */
+static bool
+aot_call_wasm_obj_write_barrier(AOTCompContext *comp_ctx,
+                                AOTFuncContext *func_ctx, LLVMValueRef gc_obj,
+                                LLVMValueRef ref)
+{
+    LLVMValueRef param_values[2], func, value, ref_int, cmp[2];
+    LLVMTypeRef param_types[2], ret_type, func_type, func_ptr_type;
+    LLVMBasicBlockRef call_barrier, barrier_end;
+
+    ADD_BASIC_BLOCK(call_barrier, "call_write_barrier");
+    MOVE_BLOCK_AFTER_CURR(call_barrier);
+    ADD_BASIC_BLOCK(barrier_end, "write_barrier_end");
+    MOVE_BLOCK_AFTER(barrier_end, call_barrier);
+
+    if (!(ref_int = LLVMBuildPtrToInt(comp_ctx->builder, ref, I64_TYPE,
+                                      "ref_int"))) {
+        aot_set_last_error("llvm build ptr to int failed.");
+        goto fail;
+    }
+    BUILD_ICMP(LLVMIntNE, ref_int, I64_ZERO, cmp[0], "ref_not_null");
+    if (!(value = LLVMBuildAnd(comp_ctx->builder, ref_int, I64_CONST(1),
+                               "ref_i31_bit"))) {
+        aot_set_last_error("llvm build and failed.");
+        goto fail;
+    }
+    BUILD_ICMP(LLVMIntEQ, value, I64_ZERO, cmp[1], "ref_not_i31");
+    if (!(cmp[0] = LLVMBuildAnd(comp_ctx->builder, cmp[0], cmp[1],
+                                "ref_from_heap"))) {
+        aot_set_last_error("llvm build and failed.");
+        goto fail;
+    }
+    BUILD_COND_BR(cmp[0], call_barrier, barrier_end);
+
+    SET_BUILDER_POS(call_barrier);
+
+    param_types[0] = GC_REF_TYPE;
+    param_types[1] = GC_REF_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_obj_write_barrier, 2);
+
+    /* Call function wasm_obj_write_barrier() */
+    param_values[0] = gc_obj;
+    param_values[1] = ref;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 2,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    BUILD_BR(barrier_end);
+    SET_BUILDER_POS(barrier_end);
+
+    return true;
+fail:
+    return false;
+}
+
 static void
 get_struct_field_data_types(const AOTCompContext *comp_ctx, uint8 field_type,
                             LLVMTypeRef *p_field_data_type,
@@ -707,6 +767,11 @@ aot_compile_op_struct_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                                   field_value, field_type))
         goto fail;
 
+    if (wasm_is_type_reftype(field_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, struct_obj,
+                                            field_value))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1446,6 +1511,11 @@ aot_compile_op_array_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+    if (wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, array_obj,
+                                            array_elem))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1595,6 +1665,11 @@ aot_compile_op_array_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 
     SET_BUILDER_POS(len_le_zero);
 
+    if (wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, array_obj,
+                                            fill_value))
+        goto fail;
+
     return true;
 fail:
     return false;
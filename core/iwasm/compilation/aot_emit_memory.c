@@ -9,6 +9,7 @@
 #include "../aot/aot_runtime.h"
 #include "aot_intrinsic.h"
 #include "aot_emit_control.h"
+#include "../interpreter/wasm_opcode.h"
 
 #define BUILD_ICMP(op, left, right, res, name)                                \
     do {                                                                      \
@@ -88,6 +89,11 @@ get_memory_check_bound(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         aot_set_last_error("llvm build load failed.");
         return NULL;
     }
+    /* The bound only grows, so an earlier loaded value is still valid */
+    if (!aot_mark_bound_check(comp_ctx, mem_check_bound,
+                              AOT_MEM_BOUND_METADATA)) {
+        return NULL;
+    }
     return mem_check_bound;
 }
 
@@ -111,6 +117,166 @@ ffs(int n)
 static LLVMValueRef
 get_memory_curr_page_count(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
 
+/* Max number of opcodes to look ahead when widening a bound check */
+#define BOUND_CHECK_LOOKAHEAD_MAX 64
+
+static bool
+skip_leb(const uint8 **p_buf, const uint8 *buf_end, uint64 *p_result)
+{
+    const uint8 *buf = *p_buf;
+    uint64 result = 0;
+    uint32 shift = 0;
+    uint8 byte;
+
+    do {
+        if (buf >= buf_end || shift >= 64)
+            return false;
+        byte = *buf++;
+        result |= ((uint64)(byte & 0x7f)) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    *p_buf = buf;
+    if (p_result)
+        *p_result = result;
+    return true;
+}
+
+static uint32
+get_plain_load_bytes(uint8 opcode)
+{
+    switch (opcode) {
+        case WASM_OP_I32_LOAD8_S:
+        case WASM_OP_I32_LOAD8_U:
+        case WASM_OP_I64_LOAD8_S:
+        case WASM_OP_I64_LOAD8_U:
+            return 1;
+        case WASM_OP_I32_LOAD16_S:
+        case WASM_OP_I32_LOAD16_U:
+        case WASM_OP_I64_LOAD16_S:
+        case WASM_OP_I64_LOAD16_U:
+            return 2;
+        case WASM_OP_I32_LOAD:
+        case WASM_OP_F32_LOAD:
+        case WASM_OP_I64_LOAD32_S:
+        case WASM_OP_I64_LOAD32_U:
+            return 4;
+        case WASM_OP_I64_LOAD:
+        case WASM_OP_F64_LOAD:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Look ahead of the load being translated for the loads from the same
+ * local in the following straight-line code, and return the end of the
+ * range accessed by them, so that a single check can cover all of them.
+ *
+ * The scan stops at any opcode which may have side effects, trap for
+ * other reasons than an out of bounds access, change the local or leave
+ * the straight-line code, so that trapping earlier in the widened check
+ * isn't observable.
+ */
+static uint64
+lookahead_bound_check_end(AOTFuncContext *func_ctx, uint32 local_idx,
+                          uint64 end, uint32 *p_merged_count)
+{
+    const uint8 *p = func_ctx->cur_frame_ip, *p_end = func_ctx->frame_ip_end;
+    uint64 align, offset, idx;
+    uint32 bytes, i;
+    uint8 opcode;
+    bool base_is_local = false;
+
+    *p_merged_count = 0;
+
+    /* Skip the load being translated */
+    if (!p || p >= p_end || !get_plain_load_bytes(*p))
+        return end;
+    p++;
+    if (!skip_leb(&p, p_end, &align) || (align & 0x40)
+        || !skip_leb(&p, p_end, NULL))
+        return end;
+
+    for (i = 0; i < BOUND_CHECK_LOOKAHEAD_MAX && p < p_end; i++) {
+        opcode = *p++;
+
+        if ((bytes = get_plain_load_bytes(opcode))) {
+            /* Multi-memory access if bit 6 of align is set */
+            if (!skip_leb(&p, p_end, &align) || (align & 0x40)
+                || !skip_leb(&p, p_end, &offset))
+                break;
+            if (base_is_local && offset + bytes > end
+                && offset + bytes <= UINT32_MAX) {
+                end = offset + bytes;
+                (*p_merged_count)++;
+            }
+            base_is_local = false;
+            continue;
+        }
+
+        base_is_local = false;
+        switch (opcode) {
+            case WASM_OP_NOP:
+            case WASM_OP_DROP:
+            case WASM_OP_SELECT:
+            case WASM_OP_DROP_64:
+            case WASM_OP_SELECT_64:
+                break;
+            case WASM_OP_GET_LOCAL:
+                if (!skip_leb(&p, p_end, &idx))
+                    return end;
+                base_is_local = (idx == local_idx);
+                break;
+            case WASM_OP_SET_LOCAL:
+            case WASM_OP_TEE_LOCAL:
+                if (!skip_leb(&p, p_end, &idx) || idx == local_idx)
+                    return end;
+                break;
+            case WASM_OP_GET_GLOBAL:
+            case WASM_OP_GET_GLOBAL_64:
+            case WASM_OP_I32_CONST:
+            case WASM_OP_I64_CONST:
+                if (!skip_leb(&p, p_end, NULL))
+                    return end;
+                break;
+            case WASM_OP_F32_CONST:
+                p += sizeof(float32);
+                break;
+            case WASM_OP_F64_CONST:
+                p += sizeof(float64);
+                break;
+            case WASM_OP_I32_DIV_S:
+            case WASM_OP_I32_DIV_U:
+            case WASM_OP_I32_REM_S:
+            case WASM_OP_I32_REM_U:
+            case WASM_OP_I64_DIV_S:
+            case WASM_OP_I64_DIV_U:
+            case WASM_OP_I64_REM_S:
+            case WASM_OP_I64_REM_U:
+            case WASM_OP_I32_TRUNC_S_F32:
+            case WASM_OP_I32_TRUNC_U_F32:
+            case WASM_OP_I32_TRUNC_S_F64:
+            case WASM_OP_I32_TRUNC_U_F64:
+            case WASM_OP_I64_TRUNC_S_F32:
+            case WASM_OP_I64_TRUNC_U_F32:
+            case WASM_OP_I64_TRUNC_S_F64:
+            case WASM_OP_I64_TRUNC_U_F64:
+                /* May trap */
+                return end;
+            default:
+                /* Other numeric opcodes have no side effects */
+                if (opcode >= WASM_OP_I32_EQZ
+                    && opcode <= WASM_OP_I64_EXTEND32_S)
+                    break;
+                return end;
+        }
+    }
+
+    return end;
+}
+
 LLVMValueRef
 aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                           mem_offset_t offset, uint32 bytes, bool enable_segue,
@@ -119,7 +285,7 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     LLVMValueRef offset_const =
         MEMORY64_COND_VALUE(I64_CONST(offset), I32_CONST(offset));
     LLVMValueRef addr, maddr, maddr_phi = NULL, offset1, cmp1, cmp2, cmp;
-    LLVMValueRef mem_base_addr, mem_check_bound;
+    LLVMValueRef mem_base_addr, mem_check_bound, check_offset;
     LLVMBasicBlockRef block_curr = LLVMGetInsertBlock(comp_ctx->builder);
     LLVMBasicBlockRef check_succ, block_maddr_phi = NULL;
     AOTValue *aot_value_top;
@@ -235,6 +401,10 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
         if (mem_offset + bytes <= mem_data_size) {
             /* inside memory space */
+            if (comp_ctx->enable_bound_check) {
+                func_ctx->bound_check_stats.access_count++;
+                func_ctx->bound_check_stats.const_count++;
+            }
             if (comp_ctx->pointer_size == sizeof(uint64))
                 offset1 = I64_CONST(mem_offset);
             else
@@ -418,12 +588,46 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         block_curr = LLVMGetInsertBlock(comp_ctx->builder);
     }
 
-    if (comp_ctx->enable_bound_check
-        && !(is_local_of_aot_value
-             && aot_checked_addr_list_find(func_ctx, local_idx_of_aot_value,
-                                           offset, bytes))) {
+    if (comp_ctx->enable_bound_check) {
+        func_ctx->bound_check_stats.access_count++;
+    }
+
+    if (comp_ctx->enable_bound_check && is_local_of_aot_value
+        && aot_checked_addr_list_find(func_ctx, local_idx_of_aot_value, offset,
+                                      bytes, comp_ctx->enable_shared_heap)) {
+        func_ctx->bound_check_stats.covered_count++;
+    }
+    else if (comp_ctx->enable_bound_check) {
         uint32 init_page_count =
             comp_ctx->comp_data->memories[0].init_page_count;
+        uint64 check_end = (uint64)offset + bytes;
+        uint32 merged_count = 0;
+
+        /* Widen the check to cover the following loads from the same
+           local, the overflow checks below assume that the range end
+           fits into 32 bits */
+        if (is_local_of_aot_value && !is_memory64
+            && !comp_ctx->enable_shared_heap && !comp_ctx->is_indirect_mode) {
+            check_end = lookahead_bound_check_end(
+                func_ctx, local_idx_of_aot_value, check_end, &merged_count);
+        }
+
+        if (check_end > (uint64)offset + bytes) {
+            /* Check offset + (check_end - bytes) + addr against the
+               bound of the access size instead */
+            LLVMValueRef extra_offset =
+                is_target_64bit
+                    ? I64_CONST(check_end - offset - bytes)
+                    : I32_CONST((uint32)(check_end - offset - bytes));
+
+            CHECK_LLVM_CONST(extra_offset);
+            BUILD_OP(Add, offset1, extra_offset, check_offset,
+                     "check_offset");
+            func_ctx->bound_check_stats.merged_count += merged_count;
+        }
+        else {
+            check_offset = offset1;
+        }
         if (init_page_count == 0) {
             LLVMValueRef mem_size;
 
@@ -450,21 +654,31 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
 
         if (is_target_64bit) {
-            BUILD_ICMP(LLVMIntUGT, offset1, mem_check_bound, cmp, "cmp");
+            BUILD_ICMP(LLVMIntUGT, check_offset, mem_check_bound, cmp, "cmp");
+            cmp2 = cmp;
         }
         else {
             if (comp_ctx->enable_shared_heap /* TODO: && mem_idx == 0 */) {
                 /* Check integer overflow has been checked above */
                 BUILD_ICMP(LLVMIntUGT, offset1, mem_check_bound, cmp, "cmp");
+                cmp2 = cmp;
             }
             else {
                 /* Check integer overflow */
-                BUILD_ICMP(LLVMIntULT, offset1, addr, cmp1, "cmp1");
-                BUILD_ICMP(LLVMIntUGT, offset1, mem_check_bound, cmp2, "cmp2");
+                BUILD_ICMP(LLVMIntULT, check_offset, addr, cmp1, "cmp1");
+                BUILD_ICMP(LLVMIntUGT, check_offset, mem_check_bound, cmp2,
+                           "cmp2");
                 BUILD_OP(Or, cmp1, cmp2, cmp, "cmp");
             }
         }
 
+        /* Mark the bound comparison for the loop versioning of the
+           optimizer, see aot_llvm_extra.cpp */
+        if (!aot_mark_bound_check(comp_ctx, cmp2, AOT_BOUND_CHECK_METADATA)) {
+            goto fail;
+        }
+        func_ctx->bound_check_stats.check_count++;
+
         /* Add basic blocks */
         ADD_BASIC_BLOCK(check_succ, "check_succ");
         LLVMMoveBasicBlockAfter(check_succ, block_curr);
@@ -479,7 +693,8 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 
         if (is_local_of_aot_value) {
             if (!aot_checked_addr_list_add(func_ctx, local_idx_of_aot_value,
-                                           offset, bytes))
+                                           offset,
+                                           (uint32)(check_end - offset)))
                 goto fail;
         }
     }
@@ -1078,7 +1293,8 @@ aot_compile_op_memory_grow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
             aot_set_last_error("llvm add pointer type failed.");
             return false;
         }
-        if (!(value = I64_CONST((uint64)(uintptr_t)wasm_enlarge_memory))
+        if (!(value = aot_get_jit_symbol_addr(comp_ctx, "wasm_enlarge_memory",
+                                              (void *)wasm_enlarge_memory))
             || !(func = LLVMConstIntToPtr(value, func_ptr_type))) {
             aot_set_last_error("create LLVM value failed.");
             return false;
@@ -1505,7 +1721,8 @@ aot_compile_op_memory_copy(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
         }
 
         if (comp_ctx->is_jit_mode) {
-            if (!(func = I64_CONST((uint64)(uintptr_t)aot_memmove))
+            if (!(func = aot_get_jit_symbol_addr(comp_ctx, "aot_memmove",
+                                                 (void *)aot_memmove))
                 || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
                 aot_set_last_error("create LLVM value failed.");
                 return false;
@@ -1546,12 +1763,6 @@ fail:
     return false;
 }
 
-static void *
-jit_memset(void *s, int c, size_t n)
-{
-    return memset(s, c, n);
-}
-
 bool
 aot_compile_op_memory_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
 {
@@ -1586,7 +1797,8 @@ aot_compile_op_memory_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
     }
 
     if (comp_ctx->is_jit_mode) {
-        if (!(func = I64_CONST((uint64)(uintptr_t)jit_memset))
+        if (!(func = aot_get_jit_symbol_addr(comp_ctx, "aot_memset",
+                                             (void *)aot_memset))
             || !(func = LLVMConstIntToPtr(func, func_ptr_type))) {
             aot_set_last_error("create LLVM value failed.");
             return false;
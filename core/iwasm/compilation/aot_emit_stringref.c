@@ -445,10 +445,21 @@ aot_compile_op_string_const(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     GET_AOT_FUNCTION(wasm_string_new_const, 2);
 
     bh_assert(contents < comp_ctx->comp_data->string_literal_count);
-    param_values[0] = LLVMConstIntToPtr(
-        I64_CONST((unsigned long long)(uintptr_t)
-                      comp_ctx->comp_data->string_literal_ptrs_wp[contents]),
-        INT8_PTR_TYPE);
+    if (comp_ctx->is_jit_mode) {
+        char symbol[32];
+        snprintf(symbol, sizeof(symbol), "string_literal#%" PRIu32, contents);
+        if (!(value = aot_get_jit_symbol_addr(
+                  comp_ctx, symbol,
+                  comp_ctx->comp_data->string_literal_ptrs_wp[contents]))) {
+            goto fail;
+        }
+    }
+    else {
+        value = I64_CONST(
+            (unsigned long long)(uintptr_t)
+                comp_ctx->comp_data->string_literal_ptrs_wp[contents]);
+    }
+    param_values[0] = LLVMConstIntToPtr(value, INT8_PTR_TYPE);
     param_values[1] =
         I32_CONST(comp_ctx->comp_data->string_literal_lengths_wp[contents]);
 
@@ -16,6 +16,11 @@
 #include "debug/dwarf_extractor.h"
 #endif
 
+#if WASM_ENABLE_JIT != 0
+#include "../aot/aot_reloc.h"
+#include "../../version.h"
+#endif
+
 static bool
 create_native_symbol(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
 static bool
@@ -2448,8 +2453,202 @@ jit_stack_size_callback(void *user_data, const char *name, size_t namelen,
     comp_ctx->jit_stack_sizes[func_idx] = (uint32)stack_size + call_size;
 }
 
+#if WASM_ENABLE_JIT != 0
+/* The runtime functions called by the JIT code besides the ones of the
+   AOT runtime, which are found in the target symbol map */
+static SymbolMap jit_symbol_map[] = {
+    REG_SYM(jit_set_exception_with_id),
+    REG_SYM(jit_check_app_addr_and_convert),
+    REG_SYM(llvm_jit_call_indirect),
+    REG_SYM(llvm_jit_invoke_native),
+    REG_SYM(wasm_enlarge_memory),
+    REG_SYM(aot_memmove),
+    REG_SYM(aot_memset),
+#if WASM_ENABLE_BULK_MEMORY != 0
+    REG_SYM(llvm_jit_memory_init),
+    REG_SYM(llvm_jit_data_drop),
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    REG_SYM(llvm_jit_drop_table_seg),
+    REG_SYM(llvm_jit_table_init),
+    REG_SYM(llvm_jit_table_copy),
+    REG_SYM(llvm_jit_table_fill),
+    REG_SYM(llvm_jit_table_grow),
+#endif
+#if WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_PERF_PROFILING != 0 \
+    || WASM_ENABLE_AOT_STACK_FRAME != 0
+    REG_SYM(llvm_jit_alloc_frame),
+    REG_SYM(llvm_jit_free_frame),
+    REG_SYM(llvm_jit_frame_update_profile_info),
+#endif
+#if WASM_ENABLE_GC != 0
+    REG_SYM(llvm_jit_create_func_obj),
+    REG_SYM(llvm_jit_obj_is_instance_of),
+    REG_SYM(llvm_jit_func_type_is_super_of),
+    REG_SYM(llvm_jit_rtt_type_new),
+    REG_SYM(llvm_array_init_with_data),
+#endif
+};
+#endif
+
+/**
+ * Resolve a runtime symbol referenced by the JIT code by its name, which
+ * is prefixed with AOT_JIT_SYMBOL_PREFIX, return NULL if it isn't found.
+ */
+static const void *
+resolve_jit_symbol(const AOTCompContext *comp_ctx, const char *symbol)
+{
+#if WASM_ENABLE_JIT != 0
+    const WASMModule *module = comp_ctx->comp_data->wasm_module;
+    const char *name = symbol + strlen(AOT_JIT_SYMBOL_PREFIX);
+    SymbolMap *target_symbol_map;
+    uint32 target_symbol_count, i;
+    char *end;
+
+    if (strncmp(symbol, AOT_JIT_SYMBOL_PREFIX, strlen(AOT_JIT_SYMBOL_PREFIX)))
+        return NULL;
+
+    if (!strcmp(name, "load_addr"))
+        return module->load_addr;
+
+    if (!strncmp(name, "string_literal#", strlen("string_literal#"))) {
+#if WASM_ENABLE_STRINGREF != 0
+        unsigned long idx =
+            strtoul(name + strlen("string_literal#"), &end, 10);
+        if (*end == '\0' && idx < comp_ctx->comp_data->string_literal_count)
+            return comp_ctx->comp_data->string_literal_ptrs_wp[idx];
+#endif
+        (void)end;
+        return NULL;
+    }
+
+    for (i = 0; i < sizeof(jit_symbol_map) / sizeof(SymbolMap); i++) {
+        if (!strcmp(jit_symbol_map[i].symbol_name, name))
+            return jit_symbol_map[i].symbol_addr;
+    }
+
+    target_symbol_map = get_target_symbol_map(&target_symbol_count);
+    for (i = 0; i < target_symbol_count; i++) {
+        if (!strcmp(target_symbol_map[i].symbol_name, name))
+            return target_symbol_map[i].symbol_addr;
+    }
+#endif
+    (void)comp_ctx;
+    (void)symbol;
+    return NULL;
+}
+
+/* Whether the module can be loaded from the JIT cache without being
+   translated: all the runtime symbols referenced by the cached objects
+   must be resolved in this process */
 static bool
-orc_jit_create(AOTCompContext *comp_ctx)
+jit_cache_can_load(const AOTCompContext *comp_ctx, AOTJITCache *cache)
+{
+    uint32 count, i;
+
+    if (!aot_jit_cache_is_complete(cache))
+        return false;
+
+    count = aot_jit_cache_get_symbol_count(cache);
+    for (i = 0; i < count; i++) {
+        if (!resolve_jit_symbol(comp_ctx, aot_jit_cache_get_symbol(cache, i))) {
+            LOG_VERBOSE("jit cache symbol %s not found",
+                        aot_jit_cache_get_symbol(cache, i));
+            return false;
+        }
+    }
+
+    if (comp_ctx->enable_stack_bound_check
+        || comp_ctx->enable_stack_estimation) {
+        aot_jit_cache_get_stack_sizes(cache, &count);
+        if (count != comp_ctx->comp_data->func_count)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Open the JIT cache of the module, the key of the module describes the
+ * host, the runtime and the compile options, along with the wasm binary,
+ * so that it can be checked before the module is translated into LLVM IR.
+ * The cache is disabled if it fails to be opened.
+ */
+static void
+jit_cache_open(AOTCompContext *comp_ctx, const AOTCompOption *option)
+{
+    const WASMModule *module = comp_ctx->comp_data->wasm_module;
+    char *triple = NULL, *cpu = NULL, *features = NULL, *key = NULL;
+    char options[256];
+    uint64 size;
+
+    if (module->load_size >= UINT32_MAX)
+        return;
+
+    if (!(triple = LLVMGetTargetMachineTriple(comp_ctx->target_machine))
+        || !(cpu = LLVMGetTargetMachineCPU(comp_ctx->target_machine))
+        || !(features =
+                 LLVMGetTargetMachineFeatureString(comp_ctx->target_machine)))
+        goto fail;
+
+    /* The struct layouts and the function addresses of the runtime are
+       embedded into the JIT code, which change with the build options */
+    snprintf(options, sizeof(options),
+             "wamr-%u.%u.%u inst=%u exec_env=%u mem=%u "
+             "opt=%u size=%u segue=%u bulk=%d thread=%d tail=%d simd=%d "
+             "ref=%d gc=%d aux_stack=%d frame=%d features=%d%d%d%d%d%d "
+             "perf=%d mem_prof=%d stack_est=%d quick_invoke=%d "
+             "shared_heap=%d bound=%d stack_bound=%d",
+#if WASM_ENABLE_JIT != 0
+             WAMR_VERSION_MAJOR, WAMR_VERSION_MINOR, WAMR_VERSION_PATCH,
+#else
+             0, 0, 0,
+#endif
+             (uint32)sizeof(WASMModuleInstance),
+             (uint32)sizeof(WASMExecEnv), (uint32)sizeof(WASMMemoryInstance),
+             option->opt_level, option->size_level, option->segue_flags,
+             option->enable_bulk_memory, option->enable_thread_mgr,
+             option->enable_tail_call, option->enable_simd,
+             option->enable_ref_types, option->enable_gc,
+             option->enable_aux_stack_check, option->aux_stack_frame_type,
+             option->call_stack_features.bounds_checks,
+             option->call_stack_features.func_idx,
+             option->call_stack_features.ip,
+             option->call_stack_features.trap_ip,
+             option->call_stack_features.values,
+             option->call_stack_features.frame_per_function,
+             option->enable_perf_profiling, option->enable_memory_profiling,
+             option->enable_stack_estimation,
+             option->quick_invoke_c_api_import, option->enable_shared_heap,
+             comp_ctx->enable_bound_check, comp_ctx->enable_stack_bound_check);
+
+    size = (uint64)strlen(triple) + strlen(cpu) + strlen(features)
+           + strlen(options) + 4;
+    if (size >= UINT32_MAX || !(key = wasm_runtime_malloc((uint32)size)))
+        goto fail;
+    snprintf(key, (uint32)size, "%s\n%s\n%s\n%s", triple, cpu, features,
+             options);
+
+    comp_ctx->jit_cache =
+        aot_jit_cache_open(option->jit_cache_dir, (const uint8 *)key,
+                           (uint32)strlen(key), module->load_addr,
+                           (uint32)module->load_size);
+    if (comp_ctx->jit_cache
+        && jit_cache_can_load(comp_ctx, comp_ctx->jit_cache))
+        comp_ctx->jit_cache_hit = true;
+
+fail:
+    if (key)
+        wasm_runtime_free(key);
+    if (features)
+        LLVMDisposeMessage(features);
+    if (cpu)
+        LLVMDisposeMessage(cpu);
+    if (triple)
+        LLVMDisposeMessage(triple);
+}
+
+static bool
+orc_jit_create(AOTCompContext *comp_ctx, AOTJITCache *cache)
 {
     LLVMErrorRef err;
     LLVMOrcLLLazyJITRef orc_jit = NULL;
@@ -2464,8 +2663,11 @@ orc_jit_create(AOTCompContext *comp_ctx)
     }
 
     if (comp_ctx->enable_stack_bound_check || comp_ctx->enable_stack_estimation)
-        LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithStackSizesCallback(
-            builder, jit_stack_size_callback, comp_ctx);
+        LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithObjectCache(
+            builder, cache, jit_stack_size_callback, comp_ctx);
+    else if (cache)
+        LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithObjectCache(
+            builder, cache, NULL, NULL);
 
     err = LLVMOrcJITTargetMachineBuilderDetectHost(&jtmb);
     if (err != LLVMErrorSuccess) {
@@ -2489,6 +2691,9 @@ orc_jit_create(AOTCompContext *comp_ctx)
     /* Ownership transfer: LLVMOrcLLJITBuilderRef -> LLVMOrcLLJITRef */
     builder = NULL;
 
+    if (cache)
+        LLVMOrcLLLazyJITEnableFixedPartitions(orc_jit);
+
 #if WASM_ENABLE_LINUX_PERF != 0
     if (wasm_runtime_get_linux_perf()) {
         LOG_DEBUG("Enable linux perf support in JIT");
@@ -2617,6 +2822,10 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
         goto fail;
     }
 
+    if (BH_LIST_ERROR == bh_list_init(&comp_ctx->jit_symbols)) {
+        goto fail;
+    }
+
 #if WASM_ENABLE_DEBUG_AOT != 0
     if (!(comp_ctx->debug_builder = LLVMCreateDIBuilder(comp_ctx->module))) {
         aot_set_last_error("create LLVM Debug Infor builder failed.");
@@ -2691,6 +2900,13 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
     if (option->builtin_intrinsics)
         comp_ctx->builtin_intrinsics = option->builtin_intrinsics;
 
+#if WASM_ENABLE_DEBUG_AOT == 0
+    /* The profiling sections of LLVM PGO can't be merged, and JIT mode
+       doesn't emit object files */
+    if (!option->is_jit_mode && !option->enable_llvm_pgo)
+        comp_ctx->parallel_jobs = option->parallel_jobs;
+#endif
+
     if (option->enable_gc)
         comp_ctx->enable_gc = true;
 
@@ -2730,8 +2946,13 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
         if (!create_target_machine_detect_host(comp_ctx))
             goto fail;
 
+        /* Open the JIT cache before the module is translated, which
+           isn't required if all the functions are cached */
+        if (option->jit_cache_dir)
+            jit_cache_open(comp_ctx, option);
+
         /* Create LLJIT Instance */
-        if (!orc_jit_create(comp_ctx))
+        if (!orc_jit_create(comp_ctx, comp_ctx->jit_cache))
             goto fail;
     }
     else {
@@ -3076,6 +3297,7 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
         else {
             comp_ctx->stack_usage_file = option->stack_usage_file;
         }
+        comp_ctx->bound_check_report_file = option->bound_check_report_file;
 
         os_printf("Create AoT compiler with:\n");
         os_printf("  target:        %s\n", comp_ctx->target_arch);
@@ -3284,8 +3506,9 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
     comp_ctx->aot_inst_type = INT8_PTR_TYPE;
 
     /* Create function context for each function */
-    comp_ctx->func_ctx_count = comp_data->func_count;
-    if (comp_data->func_count > 0
+    comp_ctx->func_ctx_count =
+        comp_ctx->jit_cache_hit ? 0 : comp_data->func_count;
+    if (comp_ctx->func_ctx_count > 0
         && !(comp_ctx->func_ctxes =
                  aot_create_func_contexts(comp_data, comp_ctx)))
         goto fail;
@@ -3349,6 +3572,10 @@ aot_destroy_comp_context(AOTCompContext *comp_ctx)
     if (comp_ctx->orc_jit)
         LLVMOrcDisposeLLLazyJIT(comp_ctx->orc_jit);
 
+    /* After the JIT, whose compile threads may still use it */
+    if (comp_ctx->jit_cache)
+        aot_jit_cache_close(comp_ctx->jit_cache);
+
     if (comp_ctx->func_ctxes)
         aot_destroy_func_contexts(comp_ctx, comp_ctx->func_ctxes,
                                   comp_ctx->func_ctx_count);
@@ -3363,6 +3590,16 @@ aot_destroy_comp_context(AOTCompContext *comp_ctx)
         }
     }
 
+    if (bh_list_length(&comp_ctx->jit_symbols) > 0) {
+        AOTJITSymbol *sym = bh_list_first_elem(&comp_ctx->jit_symbols);
+        while (sym) {
+            AOTJITSymbol *t = bh_list_elem_next(sym);
+            bh_list_remove(&comp_ctx->jit_symbols, sym);
+            wasm_runtime_free(sym);
+            sym = t;
+        }
+    }
+
     if (comp_ctx->target_cpu) {
         wasm_runtime_free(comp_ctx->target_cpu);
     }
@@ -3454,6 +3691,255 @@ aot_get_native_symbol_index(AOTCompContext *comp_ctx, const char *symbol)
     return idx;
 }
 
+/**
+ * Get the address of a runtime symbol referenced by the JIT code as an
+ * i64 constant. Normally the address is embedded into the code directly,
+ * but the objects saved to the JIT cache may be loaded by another process
+ * in which the runtime is mapped elsewhere, so if the cache is enabled, an
+ * external global is referenced instead, and its address is resolved when
+ * linking the object, see aot_define_jit_symbols.
+ */
+LLVMValueRef
+aot_get_jit_symbol_addr(AOTCompContext *comp_ctx, const char *symbol,
+                        const void *addr)
+{
+    AOTJITSymbol *sym;
+    LLVMValueRef global;
+    char buf[64];
+    int ret;
+
+    bh_assert(comp_ctx->is_jit_mode);
+
+    if (!comp_ctx->jit_cache)
+        return I64_CONST((uint64)(uintptr_t)addr);
+
+    ret = snprintf(buf, sizeof(buf), "%s%s", AOT_JIT_SYMBOL_PREFIX, symbol);
+    if (ret < 0 || ret + 1 > (int)sizeof(buf)) {
+        aot_set_last_error_v("symbol name too long: %s", symbol);
+        return NULL;
+    }
+
+    if (!(global = LLVMGetNamedGlobal(comp_ctx->module, buf))) {
+        if (!(sym = wasm_runtime_malloc(sizeof(AOTJITSymbol)))) {
+            aot_set_last_error("alloc jit symbol failed.");
+            return NULL;
+        }
+        memset(sym, 0, sizeof(AOTJITSymbol));
+        bh_memcpy_s(sym->symbol, (uint32)sizeof(sym->symbol), buf,
+                    (uint32)ret + 1);
+        sym->addr = addr;
+
+        /* The objects referencing it can't be loaded by another process */
+        if (resolve_jit_symbol(comp_ctx, buf) != addr) {
+            LOG_VERBOSE("jit symbol %s can't be resolved by name", buf);
+            comp_ctx->jit_cache_unresolvable = true;
+        }
+
+        if (BH_LIST_ERROR == bh_list_insert(&comp_ctx->jit_symbols, sym)) {
+            wasm_runtime_free(sym);
+            aot_set_last_error("insert jit symbol to list failed.");
+            return NULL;
+        }
+
+        if (!(global = LLVMAddGlobal(comp_ctx->module, INT8_TYPE, buf))) {
+            aot_set_last_error("add LLVM global failed.");
+            return NULL;
+        }
+        LLVMSetLinkage(global, LLVMExternalLinkage);
+    }
+
+    return LLVMConstPtrToInt(global, I64_TYPE);
+}
+
+/**
+ * Get the address of the bytecode at ip in JIT mode as a constant of
+ * pointer size, it is relative to the wasm binary if the JIT cache is
+ * enabled, see aot_get_jit_symbol_addr.
+ */
+LLVMValueRef
+aot_get_jit_ip_addr(AOTCompContext *comp_ctx, const uint8 *ip)
+{
+    WASMModule *module = comp_ctx->comp_data->wasm_module;
+    bool is_64bit = (comp_ctx->pointer_size == sizeof(uint64)) ? true : false;
+    LLVMValueRef load_addr, offset, value;
+
+    bh_assert(comp_ctx->is_jit_mode);
+
+    if (!comp_ctx->jit_cache) {
+        if (is_64bit)
+            return I64_CONST((uint64)(uintptr_t)ip);
+        else
+            return I32_CONST((uint32)(uintptr_t)ip);
+    }
+
+    bh_assert(ip >= module->load_addr
+              && ip < module->load_addr + module->load_size);
+    if (!(load_addr = aot_get_jit_symbol_addr(comp_ctx, "load_addr",
+                                              module->load_addr))
+        || !(load_addr = LLVMConstIntToPtr(load_addr, INT8_PTR_TYPE))) {
+        return NULL;
+    }
+
+    offset = I64_CONST((uint64)(uintptr_t)(ip - module->load_addr));
+    if (!(value = LLVMConstInBoundsGEP2(INT8_TYPE, load_addr, &offset, 1))) {
+        aot_set_last_error("llvm build const failed");
+        return NULL;
+    }
+    return LLVMConstPtrToInt(value, is_64bit ? I64_TYPE : I32_TYPE);
+}
+
+bool
+aot_define_jit_symbols(AOTCompContext *comp_ctx,
+                       LLVMOrcJITDylibRef orc_main_dylib)
+{
+    LLVMOrcCSymbolMapPairs pairs;
+    LLVMOrcMaterializationUnitRef mu;
+    LLVMErrorRef err;
+    AOTJITSymbol *sym;
+    uint32 count = bh_list_length(&comp_ctx->jit_symbols), i = 0;
+
+    if (count == 0)
+        return true;
+
+    if (!(pairs = wasm_runtime_malloc((uint32)sizeof(*pairs) * count))) {
+        aot_set_last_error("allocate memory failed.");
+        return false;
+    }
+
+    sym = bh_list_first_elem(&comp_ctx->jit_symbols);
+    while (sym) {
+        pairs[i].Name =
+            LLVMOrcLLLazyJITMangleAndIntern(comp_ctx->orc_jit, sym->symbol);
+        pairs[i].Sym.Address = (LLVMOrcExecutorAddress)(uintptr_t)sym->addr;
+        pairs[i].Sym.Flags.GenericFlags = LLVMJITSymbolGenericFlagsExported;
+        pairs[i].Sym.Flags.TargetFlags = 0;
+        sym = bh_list_elem_next(sym);
+        i++;
+    }
+
+    /* Ownership transfer: the symbol names -> materialization unit */
+    mu = LLVMOrcAbsoluteSymbols(pairs, count);
+    wasm_runtime_free(pairs);
+
+    if ((err = LLVMOrcJITDylibDefine(orc_main_dylib, mu))) {
+        LLVMOrcDisposeMaterializationUnit(mu);
+        aot_handle_llvm_errmsg("failed to define jit symbols", err);
+        return false;
+    }
+    return true;
+}
+
+bool
+aot_load_jit_cache(AOTCompContext *comp_ctx, LLVMOrcJITDylibRef orc_main_dylib)
+{
+    AOTJITCache *cache = comp_ctx->jit_cache;
+    AOTJITSymbol *sym;
+    LLVMErrorRef err;
+    const uint32 *stack_sizes;
+    uint32 count, i;
+
+    bh_assert(comp_ctx->jit_cache_hit);
+
+    /* The symbols are checked to be resolvable when the cache is opened */
+    count = aot_jit_cache_get_symbol_count(cache);
+    for (i = 0; i < count; i++) {
+        const char *symbol = aot_jit_cache_get_symbol(cache, i);
+
+        if (strlen(symbol) >= sizeof(sym->symbol)) {
+            aot_set_last_error_v("symbol name too long: %s", symbol);
+            return false;
+        }
+        if (!(sym = wasm_runtime_malloc(sizeof(AOTJITSymbol)))) {
+            aot_set_last_error("alloc jit symbol failed.");
+            return false;
+        }
+        memset(sym, 0, sizeof(AOTJITSymbol));
+        bh_memcpy_s(sym->symbol, (uint32)sizeof(sym->symbol), symbol,
+                    (uint32)strlen(symbol) + 1);
+        sym->addr = resolve_jit_symbol(comp_ctx, symbol);
+
+        if (BH_LIST_ERROR == bh_list_insert(&comp_ctx->jit_symbols, sym)) {
+            wasm_runtime_free(sym);
+            aot_set_last_error("insert jit symbol to list failed.");
+            return false;
+        }
+    }
+
+    if (!aot_define_jit_symbols(comp_ctx, orc_main_dylib))
+        return false;
+
+    if ((err = aot_jit_cache_add_objects(cache, comp_ctx->orc_jit,
+                                         orc_main_dylib))) {
+        aot_handle_llvm_errmsg("failed to add jit cache objects", err);
+        return false;
+    }
+
+    /* The stack sizes global in the objects holds the placeholders, as
+       they are only known after the functions are compiled */
+    if (comp_ctx->enable_stack_bound_check
+        || comp_ctx->enable_stack_estimation) {
+        LLVMOrcJITTargetAddress addr;
+
+        if ((err = LLVMOrcLLLazyJITLookup(comp_ctx->orc_jit, &addr,
+                                          aot_stack_sizes_alias_name))) {
+            aot_handle_llvm_errmsg("failed to look up stack_sizes", err);
+            return false;
+        }
+        comp_ctx->jit_stack_sizes = (uint32 *)addr;
+
+        stack_sizes = aot_jit_cache_get_stack_sizes(cache, &count);
+        bh_assert(count == comp_ctx->comp_data->func_count);
+        bh_memcpy_s(comp_ctx->jit_stack_sizes, (uint32)sizeof(uint32) * count,
+                    stack_sizes, (uint32)sizeof(uint32) * count);
+    }
+    return true;
+}
+
+void
+aot_save_jit_cache(AOTCompContext *comp_ctx)
+{
+    const char **symbols = NULL;
+    const uint32 *stack_sizes = NULL;
+    uint32 symbol_count = bh_list_length(&comp_ctx->jit_symbols);
+    uint32 stack_size_count = 0, i = 0;
+    AOTJITSymbol *sym;
+
+    if (!comp_ctx->jit_cache || comp_ctx->jit_cache_hit
+        || comp_ctx->jit_cache_unresolvable)
+        return;
+
+    if (comp_ctx->jit_stack_sizes) {
+        stack_sizes = comp_ctx->jit_stack_sizes;
+        stack_size_count = comp_ctx->comp_data->func_count;
+        for (i = 0; i < stack_size_count; i++) {
+            /* Not compiled yet, see aot_create_stack_sizes */
+            if (stack_sizes[i] == (uint32)-1)
+                return;
+        }
+    }
+
+    if (symbol_count > 0
+        && !(symbols = wasm_runtime_malloc((uint32)sizeof(char *)
+                                           * symbol_count))) {
+        LOG_WARNING("failed to save the jit cache: allocate memory failed.");
+        return;
+    }
+
+    i = 0;
+    sym = bh_list_first_elem(&comp_ctx->jit_symbols);
+    while (sym) {
+        symbols[i++] = sym->symbol;
+        sym = bh_list_elem_next(sym);
+    }
+
+    if (aot_jit_cache_save(comp_ctx->jit_cache, symbols, symbol_count,
+                           stack_sizes, stack_size_count))
+        LOG_VERBOSE("jit cache saved");
+
+    if (symbols)
+        wasm_runtime_free(symbols);
+}
+
 void
 aot_value_stack_push(const AOTCompContext *comp_ctx, AOTValueStack *stack,
                      AOTValue *value)
@@ -3681,14 +4167,22 @@ aot_checked_addr_list_del(AOTFuncContext *func_ctx, uint32 local_idx)
 
 bool
 aot_checked_addr_list_find(AOTFuncContext *func_ctx, uint32 local_idx,
-                           uint64 offset, uint32 bytes)
+                           uint64 offset, uint32 bytes, bool same_offset)
 {
     AOTCheckedAddr *node = func_ctx->checked_addr_list;
 
     while (node) {
-        if (node->local_idx == local_idx && node->offset == offset
-            && node->bytes >= bytes) {
-            return true;
+        if (node->local_idx == local_idx) {
+            if (same_offset) {
+                if (node->offset == offset && node->bytes >= bytes)
+                    return true;
+            }
+            /* Otherwise the access is covered if it ends no later than
+               the checked one, since both of them start from the local */
+            else if (bytes <= node->offset + node->bytes
+                     && offset <= node->offset + node->bytes - bytes) {
+                return true;
+            }
         }
         node = node->next;
     }
@@ -3710,6 +4204,76 @@ aot_checked_addr_list_destroy(AOTFuncContext *func_ctx)
     func_ctx->checked_addr_list = NULL;
 }
 
+bool
+aot_mark_bound_check(AOTCompContext *comp_ctx, LLVMValueRef value,
+                     const char *kind)
+{
+    LLVMValueRef md_node;
+    unsigned kind_id;
+
+    /* The comparison may have been folded into a constant */
+    if (!LLVMIsAInstruction(value))
+        return true;
+
+    kind_id =
+        LLVMGetMDKindIDInContext(comp_ctx->context, kind, (uint32)strlen(kind));
+    if (!(md_node = LLVMMDNodeInContext(comp_ctx->context, NULL, 0))) {
+        aot_set_last_error("create LLVM metadata node failed.");
+        return false;
+    }
+    LLVMSetMetadata(value, kind_id, md_node);
+    return true;
+}
+
+bool
+aot_emit_bound_check_report(AOTCompContext *comp_ctx, const char *file_name)
+{
+    AOTBoundCheckStats *stats, total = { 0 };
+    FILE *fp;
+    uint32 i;
+
+    if (!(fp = fopen(file_name, "w"))) {
+        aot_set_last_error("open bound check report file failed.");
+        return false;
+    }
+
+    /*
+     * the file consists of lines like:
+     *
+     * aot_func#9  accesses=12  checks=3  const=1  covered=8  merged=5
+     *             loop_versioned=2
+     *
+     * separated by tabs, where const + covered + checks == accesses
+     */
+    for (i = 0; i < comp_ctx->func_ctx_count; i++) {
+        stats = &comp_ctx->func_ctxes[i]->bound_check_stats;
+        fprintf(fp,
+                "%s%u\taccesses=%u\tchecks=%u\tconst=%u\tcovered=%u"
+                "\tmerged=%u\tloop_versioned=%u\n",
+                AOT_FUNC_PREFIX, i, stats->access_count, stats->check_count,
+                stats->const_count, stats->covered_count, stats->merged_count,
+                stats->loop_versioned_count);
+        total.access_count += stats->access_count;
+        total.check_count += stats->check_count;
+        total.const_count += stats->const_count;
+        total.covered_count += stats->covered_count;
+        total.merged_count += stats->merged_count;
+        total.loop_versioned_count += stats->loop_versioned_count;
+    }
+    fprintf(fp,
+            "total\taccesses=%u\tchecks=%u\tconst=%u\tcovered=%u"
+            "\tmerged=%u\tloop_versioned=%u\n",
+            total.access_count, total.check_count, total.const_count,
+            total.covered_count, total.merged_count,
+            total.loop_versioned_count);
+
+    if (fclose(fp) != 0) {
+        aot_set_last_error("write bound check report file failed.");
+        return false;
+    }
+    return true;
+}
+
 bool
 aot_build_zero_function_ret(const AOTCompContext *comp_ctx,
                             AOTFuncContext *func_ctx, AOTFuncType *func_type)
@@ -213,6 +213,29 @@ typedef struct AOTCheckedAddr {
     uint32 bytes;
 } AOTCheckedAddr, *AOTCheckedAddrList;
 
+/* Metadata kinds which mark the comparisons of the software bound checks
+   and the loads of the memory bounds, for the loop versioning pass */
+#define AOT_BOUND_CHECK_METADATA "wamr.bound_check"
+#define AOT_MEM_BOUND_METADATA "wamr.mem_bound"
+
+/* Statistics of the software bound checks of a function */
+typedef struct AOTBoundCheckStats {
+    /* Linear memory accesses which require a bound check */
+    uint32 access_count;
+    /* Bound checks emitted into the LLVM IR */
+    uint32 check_count;
+    /* Accesses to constant addresses proven to be inside the memory */
+    uint32 const_count;
+    /* Accesses covered by a previous check of the same local */
+    uint32 covered_count;
+    /* Accesses covered by a check widened for them in advance,
+       a subset of covered_count */
+    uint32 merged_count;
+    /* Checks removed from loops versioned by the optimizer, which run
+       without bound checks when the accessed range is proven in bounds */
+    uint32 loop_versioned_count;
+} AOTBoundCheckStats;
+
 typedef struct AOTMemInfo {
     LLVMValueRef mem_base_addr;
     LLVMValueRef mem_data_size_addr;
@@ -253,6 +276,12 @@ typedef struct AOTFuncContext {
 
     bool mem_space_unchanged;
     AOTCheckedAddrList checked_addr_list;
+    AOTBoundCheckStats bound_check_stats;
+    /* The opcode being translated and the end of the function's code,
+       used to look ahead for the memory accesses that a bound check
+       can be widened to cover */
+    const uint8 *cur_frame_ip;
+    const uint8 *frame_ip_end;
 
     LLVMValueRef shared_heap_base_addr_adj;
     LLVMValueRef shared_heap_start_off;
@@ -398,6 +427,19 @@ typedef struct AOTCompContext {
     LLVMOrcLLLazyJITRef orc_jit;
     LLVMOrcThreadSafeContextRef orc_thread_safe_context;
 
+    /* The on-disk cache of the JIT compiled objects, NULL if disabled,
+       if not, the runtime symbols are referenced by name instead of by
+       address, see aot_get_jit_symbol_addr */
+    AOTJITCache *jit_cache;
+    /* Whether all the functions are found in the JIT cache, the module
+       isn't translated into LLVM IR and no function context is created
+       then */
+    bool jit_cache_hit;
+    /* Whether a runtime symbol can't be resolved by its name in another
+       process, the JIT cache isn't completed then */
+    bool jit_cache_unresolvable;
+    bh_list jit_symbols;
+
     LLVMModuleRef module;
 
     bool is_jit_mode;
@@ -528,9 +570,14 @@ typedef struct AOTCompContext {
 
     const char *stack_usage_file;
     char stack_usage_temp_file[64];
+    const char *bound_check_report_file;
     const char *llvm_passes;
     const char *builtin_intrinsics;
 
+    /* Number of threads to generate the machine code with, 0 means
+       to emit the whole module in the current thread */
+    uint32 parallel_jobs;
+
     /* Current frame information for translation */
     AOTCompFrame *aot_frame;
 } AOTCompContext;
@@ -557,6 +604,27 @@ aot_destroy_comp_context(AOTCompContext *comp_ctx);
 int32
 aot_get_native_symbol_index(AOTCompContext *comp_ctx, const char *symbol);
 
+LLVMValueRef
+aot_get_jit_symbol_addr(AOTCompContext *comp_ctx, const char *symbol,
+                        const void *addr);
+
+LLVMValueRef
+aot_get_jit_ip_addr(AOTCompContext *comp_ctx, const uint8 *ip);
+
+bool
+aot_define_jit_symbols(AOTCompContext *comp_ctx,
+                       LLVMOrcJITDylibRef orc_main_dylib);
+
+/* Add the objects of the JIT cache to the JIT instead of the module, if
+   all the functions are found in the cache */
+bool
+aot_load_jit_cache(AOTCompContext *comp_ctx, LLVMOrcJITDylibRef orc_main_dylib);
+
+/* Complete the JIT cache after all the functions are compiled, so that
+   the module needn't be translated in the next run */
+void
+aot_save_jit_cache(AOTCompContext *comp_ctx);
+
 bool
 aot_compile_wasm(AOTCompContext *comp_ctx);
 
@@ -601,11 +669,18 @@ aot_checked_addr_list_del(AOTFuncContext *func_ctx, uint32 local_idx);
 
 bool
 aot_checked_addr_list_find(AOTFuncContext *func_ctx, uint32 local_idx,
-                           uint64 offset, uint32 bytes);
+                           uint64 offset, uint32 bytes, bool same_offset);
 
 void
 aot_checked_addr_list_destroy(AOTFuncContext *func_ctx);
 
+bool
+aot_mark_bound_check(AOTCompContext *comp_ctx, LLVMValueRef value,
+                     const char *kind);
+
+bool
+aot_emit_bound_check_report(AOTCompContext *comp_ctx, const char *file_name);
+
 bool
 aot_build_zero_function_ret(const AOTCompContext *comp_ctx,
                             AOTFuncContext *func_ctx, AOTFuncType *func_type);
@@ -636,6 +711,10 @@ aot_check_simd_compatibility(const char *arch_c_str, const char *cpu_c_str);
 void
 aot_apply_llvm_new_pass_manager(AOTCompContext *comp_ctx, LLVMModuleRef module);
 
+bool
+aot_emit_partition_objects(AOTCompContext *comp_ctx,
+                           LLVMMemoryBufferRef **p_objects, uint32 *p_count);
+
 void
 aot_handle_llvm_errmsg(const char *string, LLVMErrorRef err);
 
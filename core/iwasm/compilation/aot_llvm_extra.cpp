@@ -59,8 +59,30 @@
 #include <llvm/Analysis/AliasAnalysis.h>
 #endif
 #include <llvm/ProfileData/InstrProf.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#if LLVM_VERSION_MAJOR >= 14
+#include <llvm/MC/TargetRegistry.h>
+#else
+#include <llvm/Support/TargetRegistry.h>
+#endif
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <llvm/Analysis/AssumptionCache.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/ScalarEvolution.h>
+#include <llvm/Analysis/ScalarEvolutionExpressions.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
+#include <llvm/Transforms/Utils/LCSSA.h>
+#include <llvm/Transforms/Utils/LoopSimplify.h>
+#include <llvm/Transforms/Utils/Mem2Reg.h>
+#include <llvm/Transforms/Utils/ScalarEvolutionExpander.h>
 
+#include <atomic>
 #include <cstring>
+#include <thread>
 #include "../aot/aot_runtime.h"
 #include "aot_llvm.h"
 
@@ -82,6 +104,10 @@ aot_check_simd_compatibility(const char *arch_c_str, const char *cpu_c_str);
 void
 aot_apply_llvm_new_pass_manager(AOTCompContext *comp_ctx, LLVMModuleRef module);
 
+bool
+aot_emit_partition_objects(AOTCompContext *comp_ctx,
+                           LLVMMemoryBufferRef **p_objects, uint32 *p_count);
+
 LLVM_C_EXTERN_C_END
 
 ExitOnError ExitOnErr;
@@ -145,6 +171,416 @@ ExpandMemoryOpPass::run(Function &F, FunctionAnalysisManager &AM)
     return PA;
 }
 
+/* Max number of loops versioned in a function */
+#define BOUND_CHECK_VERSIONING_MAX_LOOPS 16
+/* Max number of instructions of a loop to version */
+#define BOUND_CHECK_VERSIONING_MAX_LOOP_SIZE 1024
+
+/*
+ * Version the innermost loops whose bound checks can be proven in bounds
+ * for all the iterations before entering the loop: the checks marked by
+ * aot_check_memory_overflow() compare an affine induction variable against
+ * a loop invariant bound, so the range of the accessed addresses is known
+ * from the backedge-taken count. The loop is cloned and the clone with the
+ * checks is run if the range check in the preheader fails, while the
+ * checks are removed from the original loop.
+ */
+class BoundCheckVersioningPass : public PassInfoMixin<BoundCheckVersioningPass>
+{
+  public:
+    explicit BoundCheckVersioningPass(const AOTCompContext *comp_ctx)
+      : comp_ctx(comp_ctx)
+    {}
+
+    PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
+
+  private:
+    const AOTCompContext *comp_ctx;
+};
+
+/* A check of "Offset + zext(AR) >u Bound", AR is an affine recurrence */
+struct LoopBoundCheck {
+    ICmpInst *Cmp;
+    const SCEVAddRecExpr *AR;
+    uint64_t Offset;
+    Value *Bound;
+};
+
+static bool
+is_safe_to_expand_at(const SCEV *S, DominatorTree &DT, Instruction *InsertPt)
+{
+    switch (S->getSCEVType()) {
+        case scConstant:
+            return true;
+        case scTruncate:
+        case scZeroExtend:
+        case scSignExtend:
+            return is_safe_to_expand_at(cast<SCEVCastExpr>(S)->getOperand(),
+                                        DT, InsertPt);
+        case scAddExpr:
+        case scMulExpr:
+        case scUMaxExpr:
+        case scSMaxExpr:
+        case scUMinExpr:
+        case scSMinExpr:
+            for (const SCEV *Op : cast<SCEVNAryExpr>(S)->operands()) {
+                if (!is_safe_to_expand_at(Op, DT, InsertPt))
+                    return false;
+            }
+            return true;
+        case scUDivExpr:
+        {
+            const SCEVUDivExpr *Div = cast<SCEVUDivExpr>(S);
+            const SCEVConstant *RHS = dyn_cast<SCEVConstant>(Div->getRHS());
+            /* Don't expand a division which may trap */
+            return RHS && !RHS->getValue()->isZero()
+                   && is_safe_to_expand_at(Div->getLHS(), DT, InsertPt);
+        }
+        case scUnknown:
+        {
+            Value *V = cast<SCEVUnknown>(S)->getValue();
+            if (Instruction *I = dyn_cast<Instruction>(V))
+                return DT.dominates(I, InsertPt);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool
+match_loop_bound_check(ICmpInst *Cmp, Loop *L, ScalarEvolution &SE,
+                       unsigned MemBoundKind, LoopBoundCheck &Check)
+{
+    Value *X, *Bound;
+    const SCEV *S;
+    uint64_t Offset = 0;
+
+    /* The access is out of bounds if X >u Bound */
+    if (Cmp->getPredicate() == ICmpInst::ICMP_UGT) {
+        X = Cmp->getOperand(0);
+        Bound = Cmp->getOperand(1);
+    }
+    else if (Cmp->getPredicate() == ICmpInst::ICMP_ULT) {
+        X = Cmp->getOperand(1);
+        Bound = Cmp->getOperand(0);
+    }
+    else {
+        return false;
+    }
+
+    /* The bound is reloaded in the loop if the memory may grow, which
+       only makes it larger, so the load can be hoisted */
+    if (!L->isLoopInvariant(Bound)) {
+        LoadInst *Load = dyn_cast<LoadInst>(Bound);
+        if (!Load || !Load->isSimple() || !Load->getMetadata(MemBoundKind)
+            || !L->isLoopInvariant(Load->getPointerOperand()))
+            return false;
+    }
+
+    S = SE.getSCEV(X);
+    if (const SCEVAddExpr *Add = dyn_cast<SCEVAddExpr>(S)) {
+        const SCEVConstant *C = dyn_cast<SCEVConstant>(Add->getOperand(0));
+        /* The constant offset of the access, which can't overflow when
+           added to a zero extended 32-bit address */
+        if (Add->getNumOperands() != 2 || !C
+            || C->getAPInt().getActiveBits() > 32
+            || !isa<SCEVZeroExtendExpr>(Add->getOperand(1)))
+            return false;
+        Offset = C->getAPInt().getZExtValue();
+        S = Add->getOperand(1);
+    }
+    if (const SCEVZeroExtendExpr *ZExt = dyn_cast<SCEVZeroExtendExpr>(S)) {
+        S = ZExt->getOperand();
+        if (Offset && S->getType()->getIntegerBitWidth() > 32)
+            return false;
+    }
+
+    const SCEVAddRecExpr *AR = dyn_cast<SCEVAddRecExpr>(S);
+    if (!AR || AR->getLoop() != L || !AR->isAffine()
+        || !isa<SCEVConstant>(AR->getStepRecurrence(SE))
+        || cast<SCEVConstant>(AR->getStepRecurrence(SE))->getValue()->isZero())
+        return false;
+
+    Check.Cmp = Cmp;
+    Check.AR = AR;
+    Check.Offset = Offset;
+    Check.Bound = Bound;
+    return true;
+}
+
+/* Build the condition that all the accesses of the check are in bounds
+   for the iterations [0, BTC] */
+static Value *
+build_in_bounds_cond(IRBuilder<> &Builder, SCEVExpander &Expander,
+                     const LoopBoundCheck &Check, Value *Bound, Value *BTC,
+                     Instruction *InsertPt)
+{
+    const SCEVAddRecExpr *AR = Check.AR;
+    unsigned ARBits = AR->getType()->getIntegerBitWidth();
+    APInt Step = cast<SCEVConstant>(AR->getStepRecurrence(*Expander.getSE()))
+                     ->getAPInt();
+    /* Bits to compute Start + |Step| * BTC + Offset without overflow,
+       the offset fits into 32 bits */
+    unsigned Bits = std::max(
+        ARBits, Step.abs().getActiveBits() + BTC->getType()->getIntegerBitWidth());
+    Bits = std::max(std::max(Bits, 32u) + 2,
+                    Bound->getType()->getIntegerBitWidth());
+    unsigned WideBits = Bits <= 64 ? 64 : (Bits <= 128 ? 128 : 0);
+    Value *Start, *Dist, *Max, *NoWrap, *End;
+
+    if (!WideBits)
+        return nullptr;
+
+    Type *WideTy = Builder.getIntNTy(WideBits);
+
+    Start = Expander.expandCodeFor(AR->getStart(), AR->getType(), InsertPt);
+    Start = Builder.CreateZExt(Start, WideTy);
+    Dist = Builder.CreateMul(ConstantInt::get(WideTy, Step.abs().zext(WideBits)),
+                             Builder.CreateZExt(BTC, WideTy));
+
+    /* The induction variable must not wrap around in its own width,
+       so that the max value is reached in the first or last iteration */
+    if (!Step.isNegative()) {
+        Max = Builder.CreateAdd(Start, Dist);
+        NoWrap = Builder.CreateICmpULE(
+            Max, ConstantInt::get(WideTy,
+                                  APInt::getMaxValue(ARBits).zext(WideBits)));
+    }
+    else {
+        Max = Start;
+        NoWrap = Builder.CreateICmpUGE(Start, Dist);
+    }
+
+    End = Builder.CreateAdd(Max, ConstantInt::get(WideTy, Check.Offset));
+    return Builder.CreateAnd(
+        NoWrap, Builder.CreateICmpULE(End, Builder.CreateZExt(Bound, WideTy)));
+}
+
+/* Returns the number of checks removed from the loop */
+static unsigned
+version_loop_bound_checks(Loop *L, DominatorTree &DT, LoopInfo &LI,
+                          ScalarEvolution &SE, unsigned BoundCheckKind,
+                          unsigned MemBoundKind)
+{
+    SmallVector<LoopBoundCheck, 8> Checks;
+    SmallVector<BasicBlock *, 8> ExitBlocks;
+    SmallVector<BasicBlock *, 16> ClonedBlocks;
+    SmallDenseMap<Value *, Value *, 4> HoistedBounds;
+    BasicBlock *CheckBB = L->getLoopPreheader(), *FastPH, *SlowPH;
+    Instruction *InsertPt;
+    ValueToValueMapTy VMap;
+    Value *Cond = nullptr;
+    const SCEV *BTCExpr;
+    unsigned InstCount = 0;
+
+    if (!CheckBB || !L->isLoopSimplifyForm() || !L->isLCSSAForm(DT))
+        return 0;
+
+    for (BasicBlock *BB : L->blocks()) {
+        for (Instruction &I : *BB) {
+            LoopBoundCheck Check;
+            ICmpInst *Cmp = dyn_cast<ICmpInst>(&I);
+
+            InstCount++;
+            if (Cmp && Cmp->getMetadata(BoundCheckKind)
+                && match_loop_bound_check(Cmp, L, SE, MemBoundKind, Check))
+                Checks.push_back(Check);
+        }
+    }
+    if (Checks.empty() || InstCount > BOUND_CHECK_VERSIONING_MAX_LOOP_SIZE)
+        return 0;
+
+    /* The checks also exit the loop, but only the exits with a computable
+       count bound the iterations */
+    BTCExpr = SE.getSymbolicMaxBackedgeTakenCount(L);
+    InsertPt = CheckBB->getTerminator();
+    if (isa<SCEVCouldNotCompute>(BTCExpr)
+        || !is_safe_to_expand_at(BTCExpr, DT, InsertPt))
+        return 0;
+
+    SCEVExpander Expander(SE, CheckBB->getModule()->getDataLayout(), "bce");
+    IRBuilder<> Builder(InsertPt);
+    Value *BTC = nullptr;
+    unsigned Removed = 0;
+
+    for (LoopBoundCheck &Check : Checks) {
+        Value *Bound = Check.Bound;
+
+        if (!is_safe_to_expand_at(Check.AR->getStart(), DT, InsertPt)) {
+            Check.Cmp = nullptr;
+            continue;
+        }
+        Instruction *BoundInst = dyn_cast<Instruction>(Bound);
+
+        if (BoundInst && L->contains(BoundInst)) {
+            /* Hoist the reloaded bound into the preheader */
+            auto It = HoistedBounds.find(Bound);
+            if (It != HoistedBounds.end()) {
+                Bound = It->second;
+            }
+            else {
+                Instruction *Load = BoundInst->clone();
+                Value *Ptr = cast<LoadInst>(Load)->getPointerOperand();
+                if (isa<Instruction>(Ptr)
+                    && !DT.dominates(cast<Instruction>(Ptr), InsertPt)) {
+                    Load->deleteValue();
+                    Check.Cmp = nullptr;
+                    continue;
+                }
+                Load->insertBefore(InsertPt);
+                HoistedBounds[Bound] = Load;
+                Bound = Load;
+            }
+        }
+        else if (BoundInst && !DT.dominates(BoundInst, InsertPt)) {
+            Check.Cmp = nullptr;
+            continue;
+        }
+
+        if (!BTC)
+            BTC = Expander.expandCodeFor(BTCExpr, BTCExpr->getType(), InsertPt);
+        Value *InBounds =
+            build_in_bounds_cond(Builder, Expander, Check, Bound, BTC, InsertPt);
+        if (!InBounds) {
+            Check.Cmp = nullptr;
+            continue;
+        }
+        Cond = Cond ? Builder.CreateAnd(Cond, InBounds) : InBounds;
+        Removed++;
+    }
+
+    if (!Cond) {
+        /* Nothing expanded but the hoisted loads, if any */
+        for (auto &Hoisted : HoistedBounds)
+            cast<Instruction>(Hoisted.second)->eraseFromParent();
+        return 0;
+    }
+
+    L->getUniqueExitBlocks(ExitBlocks);
+
+    /* Preheader -> CheckBB: branch to FastPH or SlowPH on the condition */
+    FastPH = SplitBlock(CheckBB, CheckBB->getTerminator(), &DT, &LI, nullptr,
+                        L->getHeader()->getName() + ".bce.ph");
+    Loop *SlowLoop = cloneLoopWithPreheader(FastPH, CheckBB, L, VMap,
+                                            ".bce.slow", &LI, &DT, ClonedBlocks);
+    remapInstructionsInBlocks(ClonedBlocks, VMap);
+    SlowPH = SlowLoop->getLoopPreheader();
+
+    Instruction *OrigTerm = CheckBB->getTerminator();
+    BranchInst::Create(FastPH, SlowPH, Cond, OrigTerm);
+    OrigTerm->eraseFromParent();
+    DT.changeImmediateDominator(SlowPH, CheckBB);
+
+    /* The exit blocks are also reached from the slow loop now */
+    for (BasicBlock *Exit : ExitBlocks) {
+        for (PHINode &PN : Exit->phis()) {
+            unsigned IncomingCount = PN.getNumIncomingValues();
+            for (unsigned i = 0; i < IncomingCount; i++) {
+                BasicBlock *Incoming = PN.getIncomingBlock(i);
+                Value *V = PN.getIncomingValue(i);
+                if (!L->contains(Incoming))
+                    continue;
+                auto It = VMap.find(V);
+                PN.addIncoming(It != VMap.end() ? (Value *)It->second : V,
+                               cast<BasicBlock>(VMap[Incoming]));
+            }
+        }
+    }
+
+    /* Keep the checks in the slow loop but don't version it again */
+    for (BasicBlock *BB : ClonedBlocks) {
+        for (Instruction &I : *BB)
+            I.setMetadata(BoundCheckKind, nullptr);
+    }
+
+    /* Remove the proven checks from the fast loop */
+    for (LoopBoundCheck &Check : Checks) {
+        if (!Check.Cmp)
+            continue;
+        Check.Cmp->replaceAllUsesWith(
+            ConstantInt::getFalse(Check.Cmp->getType()));
+        Check.Cmp->eraseFromParent();
+    }
+
+    return Removed;
+}
+
+static bool
+has_loop_bound_check(Function &F, LoopInfo &LI, unsigned BoundCheckKind)
+{
+    for (BasicBlock &BB : F) {
+        if (!LI.getLoopFor(&BB))
+            continue;
+        for (Instruction &I : BB) {
+            if (isa<ICmpInst>(I) && I.getMetadata(BoundCheckKind))
+                return true;
+        }
+    }
+    return false;
+}
+
+PreservedAnalyses
+BoundCheckVersioningPass::run(Function &F, FunctionAnalysisManager &AM)
+{
+    LLVMContext &Ctx = F.getContext();
+    unsigned BoundCheckKind = Ctx.getMDKindID(AOT_BOUND_CHECK_METADATA);
+    unsigned MemBoundKind = Ctx.getMDKindID(AOT_MEM_BOUND_METADATA);
+    unsigned Removed = 0, i;
+
+    if (F.isDeclaration())
+        return PreservedAnalyses::all();
+
+    if (!has_loop_bound_check(F, AM.getResult<LoopAnalysis>(F),
+                              BoundCheckKind))
+        return PreservedAnalyses::all();
+
+    /* Promote the locals to SSA values for the scalar evolution, and
+       canonicalize the loops */
+    FunctionPassManager FPM;
+    FPM.addPass(PromotePass());
+    FPM.addPass(LoopSimplifyPass());
+    FPM.addPass(LCSSAPass());
+    FPM.run(F, AM);
+
+    TargetLibraryInfo &TLI = AM.getResult<TargetLibraryAnalysis>(F);
+    AssumptionCache &AC = AM.getResult<AssumptionAnalysis>(F);
+
+    for (i = 0; i < BOUND_CHECK_VERSIONING_MAX_LOOPS; i++) {
+        /* Versioning a loop invalidates the analyses, recompute them and
+           go on with the next loop */
+        DominatorTree DT(F);
+        LoopInfo LI(DT);
+        ScalarEvolution SE(F, TLI, AC, DT, LI);
+        unsigned Count = 0;
+
+        for (Loop *L : LI.getLoopsInPreorder()) {
+            if (L->isInnermost()
+                && (Count = version_loop_bound_checks(L, DT, LI, SE,
+                                                      BoundCheckKind,
+                                                      MemBoundKind)))
+                break;
+        }
+        if (!Count)
+            break;
+        Removed += Count;
+    }
+
+    /* Record the count for the bound check report */
+    StringRef Name = F.getName();
+    uint32 func_idx;
+    if (Removed
+        && (Name.consume_front(AOT_FUNC_INTERNAL_PREFIX)
+            || Name.consume_front(AOT_FUNC_PREFIX))
+        && !Name.getAsInteger(10, func_idx)
+        && func_idx < comp_ctx->func_ctx_count) {
+        comp_ctx->func_ctxes[func_idx]->bound_check_stats.loop_versioned_count +=
+            Removed;
+    }
+
+    return PreservedAnalyses::none();
+}
+
 bool
 aot_check_simd_compatibility(const char *arch_c_str, const char *cpu_c_str)
 {
@@ -353,6 +789,13 @@ aot_apply_llvm_new_pass_manager(AOTCompContext *comp_ctx, LLVMModuleRef module)
 
         MPM.addPass(createModuleToFunctionPassAdaptor(std::move(FPM)));
 
+        if (comp_ctx->enable_bound_check && comp_ctx->opt_level > 0) {
+            /* Version the loops with the software bound checks before
+               the loops are transformed by the main pipeline */
+            MPM.addPass(createModuleToFunctionPassAdaptor(
+                BoundCheckVersioningPass(comp_ctx)));
+        }
+
         if (comp_ctx->llvm_passes) {
             ExitOnErr(PB.parsePassPipeline(MPM, comp_ctx->llvm_passes));
         }
@@ -395,6 +838,204 @@ aot_apply_llvm_new_pass_manager(AOTCompContext *comp_ctx, LLVMModuleRef module)
     MPM.run(*M, MAM);
 }
 
+/* Minimal number of functions in a partition of the parallel code
+   generation */
+#define AOT_PARTITION_MIN_FUNC_NUM 16
+/* Maximal partition number of the parallel code generation */
+#define AOT_PARTITION_MAX_NUM 64
+
+struct AOTPartition {
+    SmallString<0> bitcode;
+    LLVMMemoryBufferRef object = NULL;
+    std::string stack_usage_file;
+    std::string error;
+};
+
+static void
+emit_partition_objects(const TargetMachine *TM, const std::string &ModuleId,
+                       std::vector<AOTPartition> &partitions,
+                       std::atomic<uint32> &next)
+{
+    uint32 i;
+
+    while ((i = next.fetch_add(1)) < partitions.size()) {
+        AOTPartition &P = partitions[i];
+        /* TargetMachine isn't thread safe, and the stack usage file is an
+           option of it, so each partition uses its own one */
+        TargetOptions Options = TM->Options;
+        Options.StackUsageOutput = P.stack_usage_file;
+        std::unique_ptr<TargetMachine> PartTM(
+            TM->getTarget().createTargetMachine(
+                TM->getTargetTriple().str(), TM->getTargetCPU(),
+                TM->getTargetFeatureString(), Options,
+                TM->getRelocationModel(), TM->getCodeModel(),
+                TM->getOptLevel()));
+        char *err = NULL;
+
+        if (!PartTM) {
+            P.error = "create LLVM target machine failed";
+            continue;
+        }
+
+        /* Each partition is emitted in a private LLVM context, which is
+           the unit of thread safety in LLVM */
+        LLVMContext Ctx;
+        Expected<std::unique_ptr<Module>> MOrErr = parseBitcodeFile(
+            MemoryBufferRef(StringRef(P.bitcode.data(), P.bitcode.size()),
+                            ModuleId),
+            Ctx);
+        if (!MOrErr) {
+            P.error = toString(MOrErr.takeError());
+            continue;
+        }
+
+        if (LLVMTargetMachineEmitToMemoryBuffer(
+                reinterpret_cast<LLVMTargetMachineRef>(PartTM.get()),
+                wrap(MOrErr->get()), LLVMObjectFile, &err, &P.object)
+            != 0) {
+            P.error = err ? err : "llvm emit to memory buffer failed";
+            if (err)
+                LLVMDisposeMessage(err);
+            P.object = NULL;
+        }
+        P.bitcode.clear();
+    }
+}
+
+/**
+ * Split the optimized module into partitions and emit their object files
+ * with comp_ctx->parallel_jobs threads, the AOT file emitter merges them
+ * into one. The partitioning only depends on the module itself but not on
+ * the thread number, so the same AOT file is generated for any thread
+ * number.
+ *
+ * *p_count is set to 0 if the module isn't split, e.g. it is too small
+ * or the objects of the target can't be merged, and the whole module
+ * should be emitted as usual then.
+ */
+bool
+aot_emit_partition_objects(AOTCompContext *comp_ctx,
+                           LLVMMemoryBufferRef **p_objects, uint32 *p_count)
+{
+    Module *M = reinterpret_cast<Module *>(comp_ctx->module);
+    TargetMachine *TM =
+        reinterpret_cast<TargetMachine *>(comp_ctx->target_machine);
+    const Triple &TT = TM->getTargetTriple();
+    std::vector<AOTPartition> partitions;
+    std::vector<std::thread> workers;
+    std::atomic<uint32> next(0);
+    LLVMMemoryBufferRef *objects;
+    uint32 func_count = 0, partition_num, thread_num, i;
+    bool ret = false;
+
+    *p_objects = NULL;
+    *p_count = 0;
+
+    /* The relocations are rebased when merging the objects, which is only
+       done for the ELF objects of the targets whose relocations have
+       explicit addends and don't refer to the local labels, e.g. the
+       paired relocations of riscv64 */
+    if (!TT.isOSBinFormatELF()
+        || (TT.getArch() != Triple::x86_64 && TT.getArch() != Triple::aarch64))
+        return true;
+
+    for (Function &F : *M) {
+        if (!F.isDeclaration())
+            func_count++;
+    }
+    partition_num = func_count / AOT_PARTITION_MIN_FUNC_NUM;
+    if (partition_num > AOT_PARTITION_MAX_NUM)
+        partition_num = AOT_PARTITION_MAX_NUM;
+    if (partition_num <= 1)
+        return true;
+
+    partitions.resize(partition_num);
+    if (comp_ctx->stack_usage_file) {
+        for (i = 0; i < partition_num; i++) {
+            partitions[i].stack_usage_file =
+                std::string(comp_ctx->stack_usage_file) + "."
+                + std::to_string(i);
+        }
+    }
+
+    /* SplitModule externalizes the local symbols referenced across the
+       partitions with hidden visibility, the AOT file emitter resolves
+       their relocations to the sections defining them */
+    i = 0;
+    SplitModule(
+#if LLVM_VERSION_MAJOR >= 13
+        *M,
+#else
+        CloneModule(*M),
+#endif
+        partition_num,
+        [&](std::unique_ptr<Module> MPart) {
+            raw_svector_ostream OS(partitions[i++].bitcode);
+            WriteBitcodeToFile(*MPart, OS);
+        },
+        false);
+
+    thread_num = comp_ctx->parallel_jobs;
+    if (thread_num > partition_num)
+        thread_num = partition_num;
+    for (i = 0; i < thread_num; i++) {
+        workers.emplace_back(emit_partition_objects, TM,
+                             std::cref(M->getModuleIdentifier()),
+                             std::ref(partitions), std::ref(next));
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    for (AOTPartition &P : partitions) {
+        if (!P.error.empty()) {
+            aot_set_last_error(P.error.c_str());
+            goto fail;
+        }
+    }
+
+    if (comp_ctx->stack_usage_file) {
+        /* Concatenate the stack usage files of the partitions */
+        std::error_code EC;
+        raw_fd_ostream OS(comp_ctx->stack_usage_file, EC);
+
+        if (EC) {
+            aot_set_last_error("open stack usage file failed.");
+            goto fail;
+        }
+        for (AOTPartition &P : partitions) {
+            ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+                MemoryBuffer::getFile(P.stack_usage_file);
+            if (!BufOrErr) {
+                aot_set_last_error("read stack usage file failed.");
+                goto fail;
+            }
+            OS << (*BufOrErr)->getBuffer();
+        }
+    }
+
+    if (!(objects = (LLVMMemoryBufferRef *)wasm_runtime_malloc(
+              sizeof(LLVMMemoryBufferRef) * partition_num))) {
+        aot_set_last_error("allocate memory failed.");
+        goto fail;
+    }
+    for (i = 0; i < partition_num; i++) {
+        objects[i] = partitions[i].object;
+        partitions[i].object = NULL;
+    }
+    *p_objects = objects;
+    *p_count = partition_num;
+    ret = true;
+
+fail:
+    for (AOTPartition &P : partitions) {
+        if (P.object)
+            LLVMDisposeMemoryBuffer(P.object);
+        if (!P.stack_usage_file.empty())
+            sys::fs::remove(P.stack_usage_file);
+    }
+    return ret;
+}
+
 char *
 aot_compress_aot_func_names(AOTCompContext *comp_ctx, uint32 *p_size)
 {
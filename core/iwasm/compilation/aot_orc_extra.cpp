@@ -251,6 +251,98 @@ PartitionFunction(GlobalValueSet Requested)
     return Requested;
 }
 
+/* Get the AOT function index from the name of "aot_func#n",
+   "aot_func#n_wrapper" or "aot_func_internal#n", return -1 if
+   it isn't an AOT function */
+static int
+GetAOTFuncIndex(const std::string &Name)
+{
+    const char *name = Name.c_str(), *p;
+    char *end;
+    unsigned long index;
+
+    if (!strncmp(name, AOT_FUNC_INTERNAL_PREFIX,
+                 strlen(AOT_FUNC_INTERNAL_PREFIX)))
+        p = name + strlen(AOT_FUNC_INTERNAL_PREFIX);
+    else if (!strncmp(name, AOT_FUNC_PREFIX, strlen(AOT_FUNC_PREFIX)))
+        p = name + strlen(AOT_FUNC_PREFIX);
+    else
+        return -1;
+
+    if (!isdigit((unsigned char)*p))
+        return -1;
+    index = strtoul(p, &end, 10);
+    if ((*end != '\0' && strcmp(end, "_wrapper")) || index > INT32_MAX)
+        return -1;
+    return (int)index;
+}
+
+/*
+ * The partition function used when the JIT object cache is enabled: the
+ * functions are always compiled in the fixed groups of the jit wrappers,
+ * so that the same partitions are compiled in every run no matter in which
+ * order the functions are requested, and the objects cached by a previous
+ * run can be found. Only one group is returned each time, the functions of
+ * other groups which are requested too are left in the remaining module,
+ * and are materialized separately by ORC.
+ */
+static Optional<GlobalValueSet>
+PartitionFunctionFixedGroups(GlobalValueSet Requested)
+{
+    const int group_stride = WASM_ORC_JIT_BACKEND_THREAD_NUM;
+    const int group_size = WASM_ORC_JIT_COMPILE_THREAD_NUM;
+    GlobalValueSet Partition;
+    const Module *M = nullptr;
+    int base = -1, i, j;
+    char func_name[64];
+
+    for (auto *GV : Requested) {
+        if (!isa<Function>(GV) || !GV->hasName()) {
+            Partition.insert(GV);
+            continue;
+        }
+        if ((i = GetAOTFuncIndex(GV->getName().str())) < 0) {
+            Partition.insert(GV);
+            continue;
+        }
+        /* The index of the first function in the group, which is also
+           the index of the jit wrapper, see aot_add_llvm_func */
+        i = i / (group_stride * group_size) * (group_stride * group_size)
+            + i % group_stride;
+        if (base < 0 || i < base) {
+            base = i;
+            M = GV->getParent();
+        }
+    }
+
+    if (base < 0)
+        return Requested;
+
+    snprintf(func_name, sizeof(func_name), "%s%d%s", AOT_FUNC_PREFIX, base,
+             "_wrapper");
+    if (auto *F = M->getFunction(func_name))
+        Partition.insert(F);
+
+    for (j = 0; j < group_size; j++) {
+        snprintf(func_name, sizeof(func_name), "%s%d", AOT_FUNC_PREFIX,
+                 base + j * group_stride);
+        if (auto *F = M->getFunction(func_name))
+            Partition.insert(F);
+        snprintf(func_name, sizeof(func_name), "%s%d",
+                 AOT_FUNC_INTERNAL_PREFIX, base + j * group_stride);
+        if (auto *F = M->getFunction(func_name))
+            Partition.insert(F);
+    }
+
+    return Partition;
+}
+
+void
+LLVMOrcLLLazyJITEnableFixedPartitions(LLVMOrcLLLazyJITRef J)
+{
+    unwrap(J)->setPartitionFunction(PartitionFunctionFixedGroups);
+}
+
 LLVMErrorRef
 LLVMOrcCreateLLLazyJIT(LLVMOrcLLLazyJITRef *Result,
                        LLVMOrcLLLazyJITBuilderRef Builder)
@@ -310,6 +402,41 @@ LLVMOrcLLLazyJITLookup(LLVMOrcLLLazyJITRef J, LLVMOrcExecutorAddress *Result,
     return LLVMErrorSuccess;
 }
 
+LLVMErrorRef
+LLVMOrcLLLazyJITCompileFunction(LLVMOrcLLLazyJITRef J,
+                                LLVMOrcExecutorAddress *Result,
+                                const char *Name)
+{
+    LLLazyJIT *lazy_jit = unwrap(J);
+    ExecutionSession &ES = lazy_jit->getExecutionSession();
+    JITDylib *ImplD;
+
+    assert(Result && "Result can not be null");
+    *Result = 0;
+
+    /* The CompileOnDemandLayer keeps the function bodies in the ".impl"
+       dylib of the main dylib, and only lazy call-through stubs in the
+       main dylib, looking up the body there compiles the partition of
+       the function, rather than the group of its jit wrapper. There is
+       no such dylib if the bodies are loaded from the jit cache, they
+       are in the main dylib then */
+    ImplD = ES.getJITDylibByName(
+        lazy_jit->getMainJITDylib().getName() + ".impl");
+    if (!ImplD)
+        ImplD = &lazy_jit->getMainJITDylib();
+
+    auto Sym = ES.lookup({ ImplD }, lazy_jit->mangleAndIntern(Name));
+    if (!Sym)
+        return wrap(Sym.takeError());
+
+#if LLVM_VERSION_MAJOR < 17
+    *Result = Sym->getAddress();
+#else
+    *Result = Sym->getAddress().getValue();
+#endif
+    return LLVMErrorSuccess;
+}
+
 LLVMOrcSymbolStringPoolEntryRef
 LLVMOrcLLLazyJITMangleAndIntern(LLVMOrcLLLazyJITRef J,
                                 const char *UnmangledName)
@@ -12,6 +12,8 @@
 #include "llvm-c/Orc.h"
 #include "llvm-c/Types.h"
 
+#include <stdbool.h>
+
 LLVM_C_EXTERN_C_BEGIN
 
 typedef struct LLVMOrcOpaqueLLLazyJITBuilder *LLVMOrcLLLazyJITBuilderRef;
@@ -44,6 +46,11 @@ LLVMOrcCreateLLLazyJIT(LLVMOrcLLLazyJITRef *Result,
 LLVMErrorRef
 LLVMOrcDisposeLLLazyJIT(LLVMOrcLLLazyJITRef J);
 
+/* Always compile the functions in fixed groups, which is required by
+   the JIT object cache */
+void
+LLVMOrcLLLazyJITEnableFixedPartitions(LLVMOrcLLLazyJITRef J);
+
 LLVMErrorRef
 LLVMOrcLLLazyJITAddLLVMIRModule(LLVMOrcLLLazyJITRef J, LLVMOrcJITDylibRef JD,
                                 LLVMOrcThreadSafeModuleRef TSM);
@@ -52,6 +59,14 @@ LLVMErrorRef
 LLVMOrcLLLazyJITLookup(LLVMOrcLLLazyJITRef J, LLVMOrcExecutorAddress *Result,
                        const char *Name);
 
+/* Compile the function if it isn't compiled and return the address of
+   its body, unlike LLVMOrcLLLazyJITLookup which returns the address of
+   the stub compiling it when it is called */
+LLVMErrorRef
+LLVMOrcLLLazyJITCompileFunction(LLVMOrcLLLazyJITRef J,
+                                LLVMOrcExecutorAddress *Result,
+                                const char *Name);
+
 LLVMOrcSymbolStringPoolEntryRef
 LLVMOrcLLLazyJITMangleAndIntern(LLVMOrcLLLazyJITRef J,
                                 const char *UnmangledName);
@@ -76,6 +91,55 @@ LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithStackSizesCallback(
     LLVMOrcLLLazyJITBuilderRef Builder,
     void (*cb)(void *, const char *, size_t, size_t), void *cb_data);
 
+typedef struct AOTJITCache AOTJITCache;
+
+/* Same as above, besides the compiled objects are saved to and loaded
+   from cache if it isn't NULL. cb can be NULL if the stack sizes
+   aren't required. */
+void
+LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithObjectCache(
+    LLVMOrcLLLazyJITBuilderRef Builder, AOTJITCache *cache,
+    void (*cb)(void *, const char *, size_t, size_t), void *cb_data);
+
+/* Open the cache of a wasm module under cache_dir, the module is keyed
+   by key_data, which describes the target and the compile options, and
+   by the wasm binary. Returns NULL if the cache can't be used. */
+AOTJITCache *
+aot_jit_cache_open(const char *cache_dir, const uint8_t *key_data,
+                   uint32_t key_data_size, const uint8_t *wasm,
+                   uint32_t wasm_size);
+
+void
+aot_jit_cache_close(AOTJITCache *cache);
+
+/* Whether all the functions of the module are found in the cache, the
+   IR of the module isn't required then */
+bool
+aot_jit_cache_is_complete(AOTJITCache *cache);
+
+/* The runtime symbols referred to by the cached objects */
+uint32_t
+aot_jit_cache_get_symbol_count(AOTJITCache *cache);
+
+const char *
+aot_jit_cache_get_symbol(AOTJITCache *cache, uint32_t index);
+
+/* The stack sizes of the functions saved in the cache */
+const uint32_t *
+aot_jit_cache_get_stack_sizes(AOTJITCache *cache, uint32_t *p_count);
+
+/* Add the cached objects of a complete cache to JD */
+LLVMErrorRef
+aot_jit_cache_add_objects(AOTJITCache *cache, LLVMOrcLLLazyJITRef J,
+                          LLVMOrcJITDylibRef JD);
+
+/* Write the manifest of the module after all of its functions are
+   compiled, so that the next run can load it without the IR */
+bool
+aot_jit_cache_save(AOTJITCache *cache, const char *const *symbols,
+                   uint32_t symbol_count, const uint32_t *stack_sizes,
+                   uint32_t stack_size_count);
+
 LLVMOrcObjectLayerRef
 LLVMOrcLLLazyJITGetObjLinkingLayer(LLVMOrcLLLazyJITRef J);
 
@@ -7,10 +7,16 @@
 // See https://llvm.org/LICENSE.txt for license information.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/MachineFrameInfo.h"
@@ -19,46 +25,98 @@
 #include "aot_orc_extra.h"
 #include "bh_log.h"
 
+#include <algorithm>
+#include <mutex>
+#include <set>
+
 typedef void (*cb_t)(void *, const char *, size_t, size_t);
 
+/* The stack sizes of the functions in a compiled module, saved along
+   with the cached object so that they can be reported on a cache hit */
+typedef std::vector<std::pair<std::string, size_t>> StackSizeList;
+
+/* Bump it whenever the layout of the cache files changes */
+#define JIT_CACHE_FORMAT_VERSION "wamr-jit-cache-2"
+
+/* Name of the file listing the objects of a module, which is written
+   after all of its functions are compiled */
+#define JIT_CACHE_MANIFEST_NAME "manifest"
+
+/*
+ * The cache of a wasm module, which is kept in the directory named by
+ * the key of the module under the cache directory. The key is computed
+ * from the wasm binary, the target and the compile options, so it is
+ * known before the module is translated into LLVM IR, and the objects
+ * of a module are valid as long as its key matches.
+ */
+struct AOTJITCache {
+    std::string Dir;
+    std::mutex Lock;
+    /* The objects compiled or loaded in this run */
+    std::set<std::string> Objects;
+    /* Whether any object failed to be saved */
+    bool Failed = false;
+    /* The objects, the runtime symbols and the stack sizes read from the
+       manifest, if all the functions of the module are cached */
+    bool Complete = false;
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> CompleteObjects;
+    std::vector<std::string> Symbols;
+    std::vector<uint32_t> StackSizes;
+};
+
 class MyCompiler : public llvm::orc::IRCompileLayer::IRCompiler
 {
   public:
-    MyCompiler(llvm::orc::JITTargetMachineBuilder JTMB, cb_t cb, void *cb_data);
+    MyCompiler(llvm::orc::JITTargetMachineBuilder JTMB, cb_t cb, void *cb_data,
+               AOTJITCache *Cache);
     llvm::Expected<llvm::orc::SimpleCompiler::CompileResult> operator()(
         llvm::Module &M) override;
 
   private:
+    std::string getObjectName(llvm::Module &M);
+    std::unique_ptr<llvm::MemoryBuffer> loadFromCache(const std::string &Name,
+                                                      llvm::Module &M);
+    void saveToCache(const std::string &Name, llvm::MemoryBuffer &Obj,
+                     const StackSizeList &StackSizes);
+
     llvm::orc::JITTargetMachineBuilder JTMB;
 
     cb_t cb;
     void *cb_data;
+
+    /* NULL if the object cache is disabled */
+    AOTJITCache *Cache;
 };
 
 MyCompiler::MyCompiler(llvm::orc::JITTargetMachineBuilder JTMB, cb_t cb,
-                       void *cb_data)
+                       void *cb_data, AOTJITCache *Cache)
   : IRCompiler(llvm::orc::irManglingOptionsFromTargetOptions(JTMB.getOptions()))
   , JTMB(std::move(JTMB))
   , cb(cb)
   , cb_data(cb_data)
+  , Cache(Cache)
 {}
 
 class PrintStackSizes : public llvm::MachineFunctionPass
 {
   public:
-    PrintStackSizes(cb_t cb, void *cb_data);
+    PrintStackSizes(cb_t cb, void *cb_data, StackSizeList *StackSizes);
     bool runOnMachineFunction(llvm::MachineFunction &MF) override;
     static char ID;
 
   private:
     cb_t cb;
     void *cb_data;
+    /* If not NULL, the stack sizes are also recorded here */
+    StackSizeList *StackSizes;
 };
 
-PrintStackSizes::PrintStackSizes(cb_t cb, void *cb_data)
+PrintStackSizes::PrintStackSizes(cb_t cb, void *cb_data,
+                                 StackSizeList *StackSizes)
   : MachineFunctionPass(ID)
   , cb(cb)
   , cb_data(cb_data)
+  , StackSizes(StackSizes)
 {}
 
 char PrintStackSizes::ID = 0;
@@ -69,6 +127,8 @@ PrintStackSizes::runOnMachineFunction(llvm::MachineFunction &MF)
     auto name = MF.getName();
     auto MFI = &MF.getFrameInfo();
     size_t sz = MFI->getStackSize();
+    if (StackSizes)
+        StackSizes->emplace_back(name.str(), sz);
     cb(cb_data, name.data(), name.size(), sz);
     return false;
 }
@@ -90,12 +150,173 @@ MyPassManager::add(llvm::Pass *P)
     llvm::legacy::PassManager::add(P);
 }
 
+/* Read an object file of the cache, return NULL if it isn't found or
+   is invalid */
+static std::unique_ptr<llvm::MemoryBuffer>
+read_cache_object(const llvm::Twine &Path)
+{
+    auto ObjBuffer = llvm::MemoryBuffer::getFile(Path);
+    if (!ObjBuffer)
+        return nullptr;
+
+    /* Don't feed a truncated or corrupted file to the linker */
+    auto Obj = llvm::object::ObjectFile::createObjectFile(
+        (*ObjBuffer)->getMemBufferRef());
+    if (!Obj) {
+        llvm::consumeError(Obj.takeError());
+        LOG_WARNING("invalid jit cache file %s", Path.str().c_str());
+        return nullptr;
+    }
+    return std::move(*ObjBuffer);
+}
+
+/* The partitions of the module are fixed when the cache is enabled, so
+   an object is named by the symbols defined in it */
+std::string
+MyCompiler::getObjectName(llvm::Module &M)
+{
+    std::vector<std::string> Names;
+    llvm::SHA1 Hash;
+
+    for (auto &GV : M.global_values()) {
+        if (!GV.isDeclaration() && GV.hasName())
+            Names.push_back(GV.getName().str());
+    }
+    std::sort(Names.begin(), Names.end());
+    for (auto &Name : Names) {
+        Hash.update(Name);
+        Hash.update(llvm::ArrayRef<uint8_t>((const uint8_t *)"", 1));
+    }
+    return llvm::toHex(Hash.final(), true);
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+MyCompiler::loadFromCache(const std::string &Name, llvm::Module &M)
+{
+    llvm::SmallString<256> Path(Cache->Dir);
+    StackSizeList StackSizes;
+
+    llvm::sys::path::append(Path, Name + ".o");
+    auto ObjBuffer = read_cache_object(Path);
+    if (!ObjBuffer)
+        return nullptr;
+
+    if (cb) {
+        llvm::SmallString<256> StackSizesPath(Cache->Dir);
+        llvm::sys::path::append(StackSizesPath, Name + ".stack_sizes");
+        auto StackSizesBuffer = llvm::MemoryBuffer::getFile(StackSizesPath);
+        if (!StackSizesBuffer)
+            return nullptr;
+
+        /* One "<stack size> <function name>" record per line */
+        llvm::SmallVector<llvm::StringRef, 16> Lines;
+        (*StackSizesBuffer)->getBuffer().split(Lines, '\n', -1, false);
+        for (auto Line : Lines) {
+            auto Record = Line.split(' ');
+            unsigned long long Size;
+            if (Record.first.getAsInteger(10, Size) || Record.second.empty()) {
+                LOG_WARNING("invalid jit cache file %s",
+                            StackSizesPath.c_str());
+                return nullptr;
+            }
+            StackSizes.emplace_back(Record.second.str(), (size_t)Size);
+        }
+        for (auto &StackSize : StackSizes)
+            cb(cb_data, StackSize.first.data(), StackSize.first.size(),
+               StackSize.second);
+    }
+
+    {
+        std::lock_guard<std::mutex> Guard(Cache->Lock);
+        Cache->Objects.insert(Name);
+    }
+
+    LOG_VERBOSE("load %s from jit cache %s",
+                M.getModuleIdentifier().c_str(), Path.c_str());
+    return ObjBuffer;
+}
+
+static bool
+write_cache_file(const llvm::Twine &Path, llvm::StringRef Data)
+{
+    llvm::SmallString<256> TmpPath;
+    int FD;
+
+    /* Write to a temporary file and rename it, so that the other processes
+       sharing the cache directory never see a partially written file */
+    if (llvm::sys::fs::createUniqueFile(Path + ".tmp-%%%%%%%%", FD, TmpPath))
+        return false;
+
+    {
+        llvm::raw_fd_ostream OS(FD, true);
+        OS << Data;
+        OS.close();
+        if (OS.has_error()) {
+            OS.clear_error();
+            llvm::sys::fs::remove(TmpPath);
+            return false;
+        }
+    }
+
+    if (llvm::sys::fs::rename(TmpPath, Path)) {
+        llvm::sys::fs::remove(TmpPath);
+        return false;
+    }
+    return true;
+}
+
+void
+MyCompiler::saveToCache(const std::string &Name, llvm::MemoryBuffer &Obj,
+                        const StackSizeList &StackSizes)
+{
+    llvm::SmallString<256> StackSizesPath(Cache->Dir), Path(Cache->Dir);
+    bool Saved = true;
+
+    /* The stack sizes are written first, an object file found in the
+       cache means that its stack sizes are available too */
+    if (cb) {
+        std::string Buf;
+        llvm::raw_string_ostream OS(Buf);
+        for (auto &StackSize : StackSizes)
+            OS << (unsigned long long)StackSize.second << ' '
+               << StackSize.first << '\n';
+        OS.flush();
+
+        llvm::sys::path::append(StackSizesPath, Name + ".stack_sizes");
+        if (!write_cache_file(StackSizesPath, Buf)) {
+            LOG_WARNING("failed to write jit cache file %s",
+                        StackSizesPath.c_str());
+            Saved = false;
+        }
+    }
+
+    llvm::sys::path::append(Path, Name + ".o");
+    if (Saved && !write_cache_file(Path, Obj.getBuffer())) {
+        LOG_WARNING("failed to write jit cache file %s", Path.c_str());
+        Saved = false;
+    }
+
+    std::lock_guard<std::mutex> Guard(Cache->Lock);
+    if (Saved)
+        Cache->Objects.insert(Name);
+    else
+        Cache->Failed = true;
+}
+
 // a modified copy from llvm/lib/ExecutionEngine/Orc/CompileUtils.cpp
 llvm::Expected<llvm::orc::SimpleCompiler::CompileResult>
 MyCompiler::operator()(llvm::Module &M)
 {
     auto TM = cantFail(JTMB.createTargetMachine());
     llvm::SmallVector<char, 0> ObjBufferSV;
+    StackSizeList StackSizes;
+    std::string ObjName;
+
+    if (Cache) {
+        ObjName = getObjectName(M);
+        if (auto CachedObj = loadFromCache(ObjName, M))
+            return std::move(CachedObj);
+    }
 
     {
         llvm::raw_svector_ostream ObjStream(ObjBufferSV);
@@ -106,7 +327,9 @@ MyCompiler::operator()(llvm::Module &M)
             return llvm::make_error<llvm::StringError>(
                 "Target does not support MC emission",
                 llvm::inconvertibleErrorCode());
-        PM.add(new PrintStackSizes(cb, cb_data));
+        if (cb)
+            PM.add(new PrintStackSizes(cb, cb_data,
+                                       Cache ? &StackSizes : nullptr));
         dynamic_cast<llvm::legacy::PassManager *>(&PM)->add(
             llvm::createFreeMachineFunctionPass());
         PM.run(M);
@@ -123,6 +346,9 @@ MyCompiler::operator()(llvm::Module &M)
         M.getModuleIdentifier() + "-jitted-objectbuffer");
 #endif
 
+    if (Cache)
+        saveToCache(ObjName, *ObjBuffer, StackSizes);
+
     return std::move(ObjBuffer);
 }
 
@@ -133,13 +359,189 @@ void
 LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithStackSizesCallback(
     LLVMOrcLLLazyJITBuilderRef Builder,
     void (*cb)(void *, const char *, size_t, size_t), void *cb_data)
+{
+    LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithObjectCache(Builder, NULL,
+                                                                cb, cb_data);
+}
+
+void
+LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithObjectCache(
+    LLVMOrcLLLazyJITBuilderRef Builder, AOTJITCache *cache,
+    void (*cb)(void *, const char *, size_t, size_t), void *cb_data)
 {
     auto b = unwrap(Builder);
+
     b->setCompileFunctionCreator(
-        [cb, cb_data](llvm::orc::JITTargetMachineBuilder JTMB)
+        [cb, cb_data, cache](llvm::orc::JITTargetMachineBuilder JTMB)
             -> llvm::Expected<
                 std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
             return std::make_unique<MyCompiler>(
-                MyCompiler(std::move(JTMB), cb, cb_data));
+                MyCompiler(std::move(JTMB), cb, cb_data, cache));
         });
 }
+
+/* Read the manifest and all the objects listed in it, which are kept in
+   the cache until they are added to the JIT */
+static bool
+read_cache_manifest(AOTJITCache *Cache)
+{
+    llvm::SmallString<256> Path(Cache->Dir);
+    llvm::SmallVector<llvm::StringRef, 64> Lines;
+
+    llvm::sys::path::append(Path, JIT_CACHE_MANIFEST_NAME);
+    auto Manifest = llvm::MemoryBuffer::getFile(Path);
+    if (!Manifest)
+        return false;
+
+    /* One "object <name>", "symbol <name>" or "stack_size <size>" record
+       per line, the stack sizes are in the order of the functions */
+    (*Manifest)->getBuffer().split(Lines, '\n', -1, false);
+    if (Lines.empty() || Lines[0] != JIT_CACHE_FORMAT_VERSION)
+        goto fail;
+
+    for (size_t i = 1; i < Lines.size(); i++) {
+        auto Record = Lines[i].split(' ');
+        unsigned long long Size;
+
+        if (Record.second.empty())
+            goto fail;
+
+        if (Record.first == "object") {
+            llvm::SmallString<256> ObjPath(Cache->Dir);
+            llvm::sys::path::append(ObjPath, Record.second + ".o");
+            auto Obj = read_cache_object(ObjPath);
+            if (!Obj)
+                return false;
+            Cache->CompleteObjects.push_back(std::move(Obj));
+        }
+        else if (Record.first == "symbol") {
+            Cache->Symbols.push_back(Record.second.str());
+        }
+        else if (Record.first == "stack_size"
+                 && !Record.second.getAsInteger(10, Size)
+                 && Size <= UINT32_MAX) {
+            Cache->StackSizes.push_back((uint32_t)Size);
+        }
+        else {
+            goto fail;
+        }
+    }
+    return !Cache->CompleteObjects.empty();
+
+fail:
+    LOG_WARNING("invalid jit cache file %s", Path.c_str());
+    return false;
+}
+
+AOTJITCache *
+aot_jit_cache_open(const char *cache_dir, const uint8_t *key_data,
+                   uint32_t key_data_size, const uint8_t *wasm,
+                   uint32_t wasm_size)
+{
+    auto Cache = std::make_unique<AOTJITCache>();
+    llvm::SHA1 Hash;
+
+    Hash.update(JIT_CACHE_FORMAT_VERSION);
+    Hash.update(LLVM_VERSION_STRING);
+    Hash.update(llvm::ArrayRef<uint8_t>(key_data, key_data_size));
+    Hash.update(llvm::ArrayRef<uint8_t>(wasm, wasm_size));
+
+    llvm::SmallString<256> Dir(cache_dir);
+    llvm::sys::path::append(Dir, llvm::toHex(Hash.final(), true));
+    if (llvm::sys::fs::create_directories(Dir)) {
+        LOG_WARNING("failed to create jit cache directory %s, "
+                    "the jit cache is disabled",
+                    Dir.c_str());
+        return NULL;
+    }
+    Cache->Dir = Dir.str().str();
+
+    if (read_cache_manifest(Cache.get())) {
+        Cache->Complete = true;
+        LOG_VERBOSE("load the module from jit cache %s", Cache->Dir.c_str());
+    }
+    else {
+        Cache->CompleteObjects.clear();
+        Cache->Symbols.clear();
+        Cache->StackSizes.clear();
+    }
+    return Cache.release();
+}
+
+void
+aot_jit_cache_close(AOTJITCache *cache)
+{
+    delete cache;
+}
+
+bool
+aot_jit_cache_is_complete(AOTJITCache *cache)
+{
+    return cache->Complete;
+}
+
+uint32_t
+aot_jit_cache_get_symbol_count(AOTJITCache *cache)
+{
+    return (uint32_t)cache->Symbols.size();
+}
+
+const char *
+aot_jit_cache_get_symbol(AOTJITCache *cache, uint32_t index)
+{
+    return cache->Symbols[index].c_str();
+}
+
+const uint32_t *
+aot_jit_cache_get_stack_sizes(AOTJITCache *cache, uint32_t *p_count)
+{
+    *p_count = (uint32_t)cache->StackSizes.size();
+    return cache->StackSizes.data();
+}
+
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS(llvm::orc::LLLazyJIT, LLVMOrcLLLazyJITRef)
+DEFINE_SIMPLE_CONVERSION_FUNCTIONS(llvm::orc::JITDylib, LLVMOrcJITDylibRef)
+
+LLVMErrorRef
+aot_jit_cache_add_objects(AOTJITCache *cache, LLVMOrcLLLazyJITRef J,
+                          LLVMOrcJITDylibRef JD)
+{
+    for (auto &Obj : cache->CompleteObjects) {
+        if (auto Err = unwrap(J)->addObjectFile(*unwrap(JD), std::move(Obj)))
+            return wrap(std::move(Err));
+    }
+    cache->CompleteObjects.clear();
+    return LLVMErrorSuccess;
+}
+
+bool
+aot_jit_cache_save(AOTJITCache *cache, const char *const *symbols,
+                   uint32_t symbol_count, const uint32_t *stack_sizes,
+                   uint32_t stack_size_count)
+{
+    llvm::SmallString<256> Path(cache->Dir);
+    std::string Buf;
+    llvm::raw_string_ostream OS(Buf);
+    uint32_t i;
+
+    std::lock_guard<std::mutex> Guard(cache->Lock);
+    if (cache->Complete || cache->Failed || cache->Objects.empty())
+        return false;
+
+    OS << JIT_CACHE_FORMAT_VERSION << '\n';
+    for (auto &Name : cache->Objects)
+        OS << "object " << Name << '\n';
+    for (i = 0; i < symbol_count; i++)
+        OS << "symbol " << symbols[i] << '\n';
+    for (i = 0; i < stack_size_count; i++)
+        OS << "stack_size " << stack_sizes[i] << '\n';
+    OS.flush();
+
+    llvm::sys::path::append(Path, JIT_CACHE_MANIFEST_NAME);
+    if (!write_cache_file(Path, Buf)) {
+        LOG_WARNING("failed to write jit cache file %s", Path.c_str());
+        return false;
+    }
+    cache->Complete = true;
+    return true;
+}
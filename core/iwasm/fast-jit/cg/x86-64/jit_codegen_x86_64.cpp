@@ -25,6 +25,11 @@ static char *code_block_return_to_interp_from_jitted = NULL;
 #if WASM_ENABLE_LAZY_JIT != 0
 static char *code_block_compile_fast_jit_and_then_call = NULL;
 #endif
+#if WASM_ENABLE_SIMD != 0
+/* Whether the host CPU has SSSE3, SSE4.1 and SSE4.2, which the vector
+   instructions are lowered to */
+static bool simd_supported = false;
+#endif
 
 typedef enum {
     REG_BPL_IDX = 0,
@@ -110,6 +115,12 @@ x86::Gp regs_i64[] = {
 
 #define REG_F32_FREE_IDX 15
 #define REG_F64_FREE_IDX 15
+#if WASM_ENABLE_SIMD != 0
+/* xmm14 is freely used by the vector instructions, xmm15 is shared
+   with the float instructions */
+#define REG_V128_FREE_IDX 14
+#define REG_V128_FREE2_IDX 15
+#endif
 
 x86::Xmm regs_float[] = {
     x86::xmm0,
@@ -244,7 +255,8 @@ jit_codegen_interp_jitted_glue(void *exec_env, JitInterpSwitchInfo *info,
             CHECK_I32_REG_NO(no);                                        \
             CHECK_I64_REG_NO(no);                                        \
         }                                                                \
-        else if (kind == JIT_REG_KIND_F32 || kind == JIT_REG_KIND_F64) { \
+        else if (kind == JIT_REG_KIND_F32 || kind == JIT_REG_KIND_F64  \
+                 || kind == JIT_REG_KIND_V128) {                         \
             CHECK_F32_REG_NO(no);                                        \
             CHECK_F64_REG_NO(no);                                        \
         }                                                                \
@@ -786,6 +798,11 @@ mov_m_to_r(x86::Assembler &a, uint32 bytes_dst, uint32 kind_dst, bool is_signed,
     else if (kind_dst == JIT_REG_KIND_F64) {
         a.movsd(regs_float[reg_no_dst], m_src);
     }
+#if WASM_ENABLE_SIMD != 0
+    else if (kind_dst == JIT_REG_KIND_V128) {
+        a.movdqu(regs_float[reg_no_dst], m_src);
+    }
+#endif
     return true;
 }
 
@@ -850,6 +867,11 @@ mov_r_to_m(x86::Assembler &a, uint32 bytes_dst, uint32 kind_dst,
     else if (kind_dst == JIT_REG_KIND_F64) {
         a.movsd(m_dst, regs_float[reg_no_src]);
     }
+#if WASM_ENABLE_SIMD != 0
+    else if (kind_dst == JIT_REG_KIND_V128) {
+        a.movdqu(m_dst, regs_float[reg_no_src]);
+    }
+#endif
     return true;
 }
 
@@ -1443,6 +1465,53 @@ mov_r_to_r_f64(x86::Assembler &a, int32 reg_no_dst, int32 reg_no_src)
     return true;
 }
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Encode moving immediate v128 data to register
+ *
+ * @param a the assembler to emit the code
+ * @param reg_no the no of dst register
+ * @param data the immediate data to move
+ *
+ * @return true if success, false otherwise
+ */
+static bool
+mov_imm_to_r_v128(x86::Assembler &a, int32 reg_no, V128 data)
+{
+    if (data.i64x2[0] == 0 && data.i64x2[1] == 0) {
+        a.pxor(regs_float[reg_no], regs_float[reg_no]);
+        return true;
+    }
+
+    /* imm -> gp -> xmm, movq clears the upper 64 bits */
+    a.mov(regs_i64[REG_I64_FREE_IDX], Imm(data.i64x2[0]));
+    a.movq(regs_float[reg_no], regs_i64[REG_I64_FREE_IDX]);
+    if (data.i64x2[1] != 0) {
+        a.mov(regs_i64[REG_I64_FREE_IDX], Imm(data.i64x2[1]));
+        a.pinsrq(regs_float[reg_no], regs_i64[REG_I64_FREE_IDX], Imm(1));
+    }
+    return true;
+}
+
+/**
+ * Encode moving v128 data from src register to dst register
+ *
+ * @param a the assembler to emit the code
+ * @param reg_no_dst the no of dst register
+ * @param reg_no_src the no of src register
+ *
+ * @return true if success, false otherwise
+ */
+static bool
+mov_r_to_r_v128(x86::Assembler &a, int32 reg_no_dst, int32 reg_no_src)
+{
+    if (reg_no_dst != reg_no_src) {
+        a.movdqa(regs_float[reg_no_dst], regs_float[reg_no_src]);
+    }
+    return true;
+}
+#endif
+
 /* Let compiler do the conversation job as much as possible */
 
 /**
@@ -4784,38 +4853,145 @@ cmp_r_imm_to_r_f64(x86::Assembler &a, int32 reg_no_dst, int32 reg_no1_src,
             GOTO_FAIL;                                                         \
     } while (0)
 
+#if WASM_ENABLE_SIMD != 0
 /**
- * Encode insn mov: MOV r0, r1
- * @param kind the data kind, such as I32, I64, F32 and F64
- * @param Type the data type, such as int32, int64, float32, and float64
- * @param type the abbreviation of data type, such as i32, i64, f32, and f64
- * @param bytes_dst the byte number of dst data
+ * Get the xmm register of a V128 operand, a const operand is loaded
+ * into the given free register
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r the V128 operand
+ * @param reg_no_free the no of free register to load the const into
+ *
+ * @return the xmm register which holds the operand
  */
-#define MOV_R_R(kind, Type, type)                                \
-    do {                                                         \
-        bool _ret = false;                                       \
-        int32 reg_no_dst = 0, reg_no_src = 0;                    \
-        CHECK_EQKIND(r0, r1);                                    \
-                                                                 \
-        CHECK_NCONST(r0);                                        \
-        reg_no_dst = jit_reg_no(r0);                             \
-        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));              \
-                                                                 \
-        if (jit_reg_is_const(r1)) {                              \
-            Type data = jit_cc_get_const_##kind(cc, r1);         \
-            _ret = mov_imm_to_r_##type(a, reg_no_dst, data);     \
-        }                                                        \
-        else {                                                   \
-            reg_no_src = jit_reg_no(r1);                         \
-            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));          \
-            _ret = mov_r_to_r_##type(a, reg_no_dst, reg_no_src); \
-        }                                                        \
-        if (!_ret)                                               \
-            GOTO_FAIL;                                           \
-    } while (0)
+static x86::Xmm
+simd_get_opnd(JitCompContext *cc, x86::Assembler &a, JitReg r,
+              int32 reg_no_free)
+{
+    if (jit_reg_is_const(r)) {
+        mov_imm_to_r_v128(a, reg_no_free, jit_cc_get_const_V128(cc, r));
+        return regs_float[reg_no_free];
+    }
+    return regs_float[jit_reg_no(r)];
+}
 
 /**
- * Encode mov insn, MOV r0, r1
+ * Prepare the operands of a two-operand vector instruction: the first
+ * operand is moved to the dst register, and the second one is copied
+ * to REG_V128_FREE2_IDX if it is const, aliases the dst register or
+ * copy_src2 is true
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param reg_no_dst the no of dst register
+ * @param r1 the first src operand
+ * @param r2 the second src operand
+ * @param copy_src2 whether the second operand is always copied, so
+ *        that the instruction sequence can overwrite it
+ *
+ * @return the xmm register which holds the second operand
+ */
+static x86::Xmm
+simd_prepare_opnds(JitCompContext *cc, x86::Assembler &a, int32 reg_no_dst,
+                   JitReg r1, JitReg r2, bool copy_src2)
+{
+    x86::Xmm src2 = regs_float[REG_V128_FREE2_IDX];
+
+    if (jit_reg_is_const(r2))
+        mov_imm_to_r_v128(a, REG_V128_FREE2_IDX,
+                          jit_cc_get_const_V128(cc, r2));
+    else if (copy_src2 || jit_reg_no(r2) == reg_no_dst)
+        a.movdqa(src2, regs_float[jit_reg_no(r2)]);
+    else
+        src2 = regs_float[jit_reg_no(r2)];
+
+    if (jit_reg_is_const(r1))
+        mov_imm_to_r_v128(a, reg_no_dst, jit_cc_get_const_V128(cc, r1));
+    else
+        mov_r_to_r_v128(a, reg_no_dst, jit_reg_no(r1));
+
+    return src2;
+}
+
+/**
+ * Get the lane shape of a vector instruction
+ *
+ * @param cc the compiler context
+ * @param r the const I32 shape operand, or 0 if there is none
+ *
+ * @return the lane shape
+ */
+static JitV128Shape
+simd_get_shape(JitCompContext *cc, JitReg r)
+{
+    if (!r)
+        return JIT_V128_I8X16;
+    bh_assert(jit_reg_is_const(r) && jit_reg_kind(r) == JIT_REG_KIND_I32);
+    return (JitV128Shape)jit_cc_get_const_I32(cc, r);
+}
+
+/**
+ * Encode storing V128 data to memory, STV128 r0, r1, r2
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 the src V128 register or const
+ * @param r1 the base register or const
+ * @param r2 the offset register or const
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_store(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1,
+                 JitReg r2)
+{
+    int32 reg_no_src, reg_no_base = 0, reg_no_offset = 0;
+    int32 base = 0, offset = 0;
+
+    CHECK_KIND(r0, JIT_REG_KIND_V128);
+
+    if (jit_reg_is_const(r0)) {
+        reg_no_src = REG_V128_FREE_IDX;
+        mov_imm_to_r_v128(a, reg_no_src, jit_cc_get_const_V128(cc, r0));
+    }
+    else {
+        reg_no_src = jit_reg_no(r0);
+        CHECK_REG_NO(reg_no_src, JIT_REG_KIND_V128);
+    }
+    if (jit_reg_is_const(r1))
+        base = jit_cc_get_const_I32(cc, r1);
+    else {
+        reg_no_base = jit_reg_no(r1);
+        CHECK_REG_NO(reg_no_base, jit_reg_kind(r1));
+    }
+    if (jit_reg_is_const(r2))
+        offset = jit_cc_get_const_I32(cc, r2);
+    else {
+        reg_no_offset = jit_reg_no(r2);
+        CHECK_REG_NO(reg_no_offset, jit_reg_kind(r2));
+    }
+
+    if (jit_reg_is_const(r1)) {
+        if (jit_reg_is_const(r2))
+            return st_r_to_base_imm_offset_imm(a, 16, JIT_REG_KIND_V128,
+                                               reg_no_src, base, offset,
+                                               false);
+        return st_r_to_base_imm_offset_r(a, 16, JIT_REG_KIND_V128,
+                                         reg_no_src, base, reg_no_offset,
+                                         false);
+    }
+    if (jit_reg_is_const(r2))
+        return st_r_to_base_r_offset_imm(a, 16, JIT_REG_KIND_V128, reg_no_src,
+                                         reg_no_base, offset, false);
+    return st_r_to_base_r_offset_r(a, 16, JIT_REG_KIND_V128, reg_no_src,
+                                   reg_no_base, reg_no_offset, false);
+fail:
+    return false;
+}
+
+/**
+ * Encode insn NOT r0, r1 of V128 registers
  *
  * @param cc the compiler context
  * @param a the assembler to emit the code
@@ -4825,132 +5001,1572 @@ cmp_r_imm_to_r_f64(x86::Assembler &a, int32 reg_no_dst, int32 reg_no1_src,
  * @return true if success, false if failed
  */
 static bool
-lower_mov(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1)
+lower_simd_not(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1)
 {
-    switch (jit_reg_kind(r0)) {
-        case JIT_REG_KIND_I32:
-            MOV_R_R(I32, int32, i32);
-            break;
-        case JIT_REG_KIND_I64:
-            MOV_R_R(I64, int64, i64);
+    x86::Xmm ones = regs_float[REG_V128_FREE_IDX];
+    int32 reg_no_dst = jit_reg_no(r0);
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    if (jit_reg_is_const(r1))
+        mov_imm_to_r_v128(a, reg_no_dst, jit_cc_get_const_V128(cc, r1));
+    else
+        mov_r_to_r_v128(a, reg_no_dst, jit_reg_no(r1));
+    a.pcmpeqd(ones, ones);
+    a.pxor(regs_float[reg_no_dst], ones);
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn OR/XOR/AND r0, r1, r2 of V128 registers
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param op the opcode of bit operations
+ * @param r0 dst jit register that contains the dst operand info
+ * @param r1 src jit register that contains the first src operand info
+ * @param r2 src jit register that contains the second src operand info
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_bit(JitCompContext *cc, x86::Assembler &a, BIT_OP op, JitReg r0,
+               JitReg r1, JitReg r2)
+{
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst], src2;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_EQKIND(r0, r2);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    src2 = simd_prepare_opnds(cc, a, reg_no_dst, r1, r2, false);
+    switch (op) {
+        case OR:
+            a.por(dst, src2);
             break;
-        case JIT_REG_KIND_F32:
-            MOV_R_R(F32, float32, f32);
+        case XOR:
+            a.pxor(dst, src2);
             break;
-        case JIT_REG_KIND_F64:
-            MOV_R_R(F64, float64, f64);
+        case AND:
+            a.pand(dst, src2);
             break;
         default:
-            LOG_VERBOSE("Invalid reg type of mov: %d\n", jit_reg_kind(r0));
+            bh_assert(0);
             GOTO_FAIL;
     }
-
     return true;
 fail:
     return false;
 }
 
 /**
- * Encode insn neg: NEG r0, r1
- * @param kind the data kind, such as I32, I64, F32 and F64
- * @param Type the data type, such as int32, int64, float32, and float64
- * @param type the abbreviation of data type, such as i32, i64, f32, and f64
- */
-#define NEG_R_R(kind, Type, type)                                \
-    do {                                                         \
-        bool _ret = false;                                       \
-        int32 reg_no_dst = 0, reg_no_src = 0;                    \
-        CHECK_EQKIND(r0, r1);                                    \
-                                                                 \
-        CHECK_NCONST(r0);                                        \
-        reg_no_dst = jit_reg_no(r0);                             \
-        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));              \
-                                                                 \
-        if (jit_reg_is_const(r1)) {                              \
-            Type data = jit_cc_get_const_##kind(cc, r1);         \
-            _ret = neg_imm_to_r_##type(a, reg_no_dst, data);     \
-        }                                                        \
-        else {                                                   \
-            reg_no_src = jit_reg_no(r1);                         \
-            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));          \
-            _ret = neg_r_to_r_##type(a, reg_no_dst, reg_no_src); \
-        }                                                        \
-        if (!_ret)                                               \
-            GOTO_FAIL;                                           \
-    } while (0)
-
-/**
- * Encode neg insn, NEG r0, r1
+ * Encode insn VSPLAT r0, r1, r2
  *
  * @param cc the compiler context
  * @param a the assembler to emit the code
- * @param r0 dst jit register that contains the dst operand info
- * @param r1 src jit register that contains the src operand info
+ * @param r0 the dst V128 register
+ * @param r1 the scalar register or const
+ * @param r2 the lane shape
  *
  * @return true if success, false if failed
  */
 static bool
-lower_neg(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1)
+lower_simd_splat(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1,
+                 JitReg r2)
 {
-    switch (jit_reg_kind(r0)) {
+    JitV128Shape shape = simd_get_shape(cc, r2);
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst];
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+
+    CHECK_KIND(r0, JIT_REG_KIND_V128);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    /* Move the scalar to the lowest lane of dst */
+    switch (jit_reg_kind(r1)) {
         case JIT_REG_KIND_I32:
-            NEG_R_R(I32, int32, i32);
+            if (jit_reg_is_const(r1)) {
+                mov_imm_to_r_i32(a, REG_I32_FREE_IDX,
+                                 jit_cc_get_const_I32(cc, r1));
+                a.movd(dst, regs_i32[REG_I32_FREE_IDX]);
+            }
+            else
+                a.movd(dst, regs_i32[jit_reg_no(r1)]);
             break;
         case JIT_REG_KIND_I64:
-            NEG_R_R(I64, int64, i64);
+            if (jit_reg_is_const(r1)) {
+                mov_imm_to_r_i64(a, REG_I64_FREE_IDX,
+                                 jit_cc_get_const_I64(cc, r1));
+                a.movq(dst, regs_i64[REG_I64_FREE_IDX]);
+            }
+            else
+                a.movq(dst, regs_i64[jit_reg_no(r1)]);
             break;
         case JIT_REG_KIND_F32:
-            NEG_R_R(F32, float32, f32);
+            if (jit_reg_is_const(r1))
+                mov_imm_to_r_f32(a, reg_no_dst, jit_cc_get_const_F32(cc, r1));
+            else
+                a.movdqa(dst, regs_float[jit_reg_no(r1)]);
             break;
         case JIT_REG_KIND_F64:
-            NEG_R_R(F64, float64, f64);
+            if (jit_reg_is_const(r1))
+                mov_imm_to_r_f64(a, reg_no_dst, jit_cc_get_const_F64(cc, r1));
+            else
+                a.movdqa(dst, regs_float[jit_reg_no(r1)]);
             break;
         default:
-            LOG_VERBOSE("Invalid reg type of neg: %d\n", jit_reg_kind(r0));
             GOTO_FAIL;
     }
 
+    switch (shape) {
+        case JIT_V128_I8X16:
+            a.pxor(tmp, tmp);
+            a.pshufb(dst, tmp);
+            break;
+        case JIT_V128_I16X8:
+            a.pshuflw(dst, dst, Imm(0));
+            a.punpcklqdq(dst, dst);
+            break;
+        case JIT_V128_I32X4:
+        case JIT_V128_F32X4:
+            a.pshufd(dst, dst, Imm(0));
+            break;
+        case JIT_V128_I64X2:
+        case JIT_V128_F64X2:
+            a.punpcklqdq(dst, dst);
+            break;
+        default:
+            GOTO_FAIL;
+    }
     return true;
 fail:
     return false;
 }
 
 /**
- * Encode insn convert: I32TOI8 r0, r1, or I32TOI16, I32TOF32, F32TOF64, etc.
- * @param kind0 the dst JIT_REG_KIND, such as I32, I64, F32 and F64
- * @param kind1 the src JIT_REG_KIND, such as I32, I64, F32 and F64
- * @param type0 the dst data type, such as i8, u8, i16, u16, i32, f32, i64, f32,
- * f64
- * @param type1 the src data type, such as i8, u8, i16, u16, i32, f32, i64, f32,
- * f64
+ * Encode insn VEXTRACTS/VEXTRACTU r0, r1, r2, r3
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param is_signed whether the i8/i16 lane is sign extended
+ * @param r0 the dst scalar register
+ * @param r1 the src V128 register or const
+ * @param r2 the lane index
+ * @param r3 the lane shape
+ *
+ * @return true if success, false if failed
  */
-#define CONVERT_R_R(kind0, kind1, type0, type1, Type1)                       \
-    do {                                                                     \
-        bool _ret = false;                                                   \
-        int32 reg_no_dst = 0, reg_no_src = 0;                                \
-        CHECK_KIND(r0, JIT_REG_KIND_##kind0);                                \
-        CHECK_KIND(r1, JIT_REG_KIND_##kind1);                                \
-                                                                             \
-        CHECK_NCONST(r0);                                                    \
-        reg_no_dst = jit_reg_no(r0);                                         \
-        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));                          \
-                                                                             \
-        if (jit_reg_is_const(r1)) {                                          \
-            Type1 data = jit_cc_get_const_##kind1(cc, r1);                   \
-            _ret = convert_imm_##type1##_to_r_##type0(a, reg_no_dst, data);  \
-        }                                                                    \
-        else {                                                               \
-            reg_no_src = jit_reg_no(r1);                                     \
-            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));                      \
-            _ret =                                                           \
-                convert_r_##type1##_to_r_##type0(a, reg_no_dst, reg_no_src); \
-        }                                                                    \
-        if (!_ret)                                                           \
-            GOTO_FAIL;                                                       \
-    } while (0)
+static bool
+lower_simd_extract(JitCompContext *cc, x86::Assembler &a, bool is_signed,
+                   JitReg r0, JitReg r1, JitReg r2, JitReg r3)
+{
+    JitV128Shape shape = simd_get_shape(cc, r3);
+    int32 reg_no_dst = jit_reg_no(r0), lane;
+    x86::Xmm src;
 
-/**
- * Encode insn alu: ADD/SUB/MUL/DIV/REM r0, r1, r2
+    CHECK_KIND(r1, JIT_REG_KIND_V128);
+    CHECK_CONST(r2);
+    CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));
+
+    lane = jit_cc_get_const_I32(cc, r2);
+    src = simd_get_opnd(cc, a, r1, REG_V128_FREE_IDX);
+
+    switch (shape) {
+        case JIT_V128_I8X16:
+            a.pextrb(regs_i32[reg_no_dst], src, Imm(lane));
+            if (is_signed)
+                a.movsx(regs_i32[reg_no_dst], regs_i8[reg_no_dst]);
+            break;
+        case JIT_V128_I16X8:
+            a.pextrw(regs_i32[reg_no_dst], src, Imm(lane));
+            if (is_signed)
+                a.movsx(regs_i32[reg_no_dst], regs_i16[reg_no_dst]);
+            break;
+        case JIT_V128_I32X4:
+            a.pextrd(regs_i32[reg_no_dst], src, Imm(lane));
+            break;
+        case JIT_V128_I64X2:
+            a.pextrq(regs_i64[reg_no_dst], src, Imm(lane));
+            break;
+        case JIT_V128_F32X4:
+            /* Only the lowest lane of the dst register is used */
+            a.pshufd(regs_float[reg_no_dst], src, Imm(lane));
+            break;
+        case JIT_V128_F64X2:
+            if (lane == 0)
+                a.movdqa(regs_float[reg_no_dst], src);
+            else
+                a.pshufd(regs_float[reg_no_dst], src, Imm(0xEE));
+            break;
+        default:
+            GOTO_FAIL;
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn VREPLACE r0, r1, r2, r3, r4
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 the dst V128 register
+ * @param r1 the src V128 register or const
+ * @param r2 the scalar register or const to replace the lane with
+ * @param r3 the lane index
+ * @param r4 the lane shape
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_replace(JitCompContext *cc, x86::Assembler &a, JitReg r0,
+                   JitReg r1, JitReg r2, JitReg r3, JitReg r4)
+{
+    JitV128Shape shape = simd_get_shape(cc, r4);
+    int32 reg_no_dst = jit_reg_no(r0), reg_no_src = 0, lane;
+    x86::Xmm dst = regs_float[reg_no_dst];
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_CONST(r3);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    lane = jit_cc_get_const_I32(cc, r3);
+    if (jit_reg_is_const(r1))
+        mov_imm_to_r_v128(a, reg_no_dst, jit_cc_get_const_V128(cc, r1));
+    else
+        mov_r_to_r_v128(a, reg_no_dst, jit_reg_no(r1));
+
+    /* Const scalars are moved to the free gp register */
+    if (jit_reg_is_const(r2)) {
+        reg_no_src = REG_I64_FREE_IDX;
+        switch (jit_reg_kind(r2)) {
+            case JIT_REG_KIND_I32:
+                mov_imm_to_r_i32(a, reg_no_src, jit_cc_get_const_I32(cc, r2));
+                break;
+            case JIT_REG_KIND_I64:
+                mov_imm_to_r_i64(a, reg_no_src, jit_cc_get_const_I64(cc, r2));
+                break;
+            case JIT_REG_KIND_F32:
+            {
+                cast_float_to_integer v = { .f = jit_cc_get_const_F32(cc, r2) };
+                mov_imm_to_r_i32(a, reg_no_src, (int32)v.i);
+                break;
+            }
+            case JIT_REG_KIND_F64:
+            {
+                cast_double_to_integer v = { .d =
+                                                 jit_cc_get_const_F64(cc, r2) };
+                mov_imm_to_r_i64(a, reg_no_src, (int64)v.i);
+                break;
+            }
+            default:
+                GOTO_FAIL;
+        }
+    }
+    else
+        reg_no_src = jit_reg_no(r2);
+
+    switch (shape) {
+        case JIT_V128_I8X16:
+            a.pinsrb(dst, regs_i32[reg_no_src], Imm(lane));
+            break;
+        case JIT_V128_I16X8:
+            a.pinsrw(dst, regs_i32[reg_no_src], Imm(lane));
+            break;
+        case JIT_V128_I32X4:
+            a.pinsrd(dst, regs_i32[reg_no_src], Imm(lane));
+            break;
+        case JIT_V128_I64X2:
+            a.pinsrq(dst, regs_i64[reg_no_src], Imm(lane));
+            break;
+        case JIT_V128_F32X4:
+            if (jit_reg_is_const(r2))
+                a.pinsrd(dst, regs_i32[reg_no_src], Imm(lane));
+            else
+                a.insertps(dst, regs_float[reg_no_src], Imm(lane << 4));
+            break;
+        case JIT_V128_F64X2:
+            if (jit_reg_is_const(r2))
+                a.pinsrq(dst, regs_i64[reg_no_src], Imm(lane));
+            else if (lane == 0)
+                a.movsd(dst, regs_float[reg_no_src]);
+            else
+                a.movlhps(dst, regs_float[reg_no_src]);
+            break;
+        default:
+            GOTO_FAIL;
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode the one-operand vector insns: VNEG, VABS, VSQRT, VEXTENDxx,
+ * VPOPCNT and the lane-wise conversions, OP r0, r1[, r2]
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param opcode the JIT opcode
+ * @param r0 the dst V128 register
+ * @param r1 the src V128 register or const
+ * @param r2 the lane shape, or 0 if the insn has no shape operand
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_unary(JitCompContext *cc, x86::Assembler &a, JitOpcode opcode,
+                 JitReg r0, JitReg r1, JitReg r2)
+{
+    JitV128Shape shape = simd_get_shape(cc, r2);
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst], src;
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+    /* Free once src has been copied to dst */
+    x86::Xmm tmp2 = regs_float[REG_V128_FREE2_IDX];
+    V128 v;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    src = simd_get_opnd(cc, a, r1, REG_V128_FREE2_IDX);
+
+    switch (opcode) {
+        case JIT_OP_VNEG:
+            if (shape == JIT_V128_F32X4 || shape == JIT_V128_F64X2) {
+                /* Flip the sign bits */
+                a.pcmpeqd(tmp, tmp);
+                if (shape == JIT_V128_F32X4)
+                    a.pslld(tmp, Imm(31));
+                else
+                    a.psllq(tmp, Imm(63));
+                if (dst.id() != src.id())
+                    a.movdqa(dst, src);
+                a.xorps(dst, tmp);
+                break;
+            }
+            a.pxor(tmp, tmp);
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.psubb(tmp, src);
+                    break;
+                case JIT_V128_I16X8:
+                    a.psubw(tmp, src);
+                    break;
+                case JIT_V128_I32X4:
+                    a.psubd(tmp, src);
+                    break;
+                case JIT_V128_I64X2:
+                    a.psubq(tmp, src);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            a.movdqa(dst, tmp);
+            break;
+        case JIT_OP_VABS:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.pabsb(dst, src);
+                    break;
+                case JIT_V128_I16X8:
+                    a.pabsw(dst, src);
+                    break;
+                case JIT_V128_I32X4:
+                    a.pabsd(dst, src);
+                    break;
+                case JIT_V128_I64X2:
+                    /* tmp = src < 0 ? -1 : 0, dst = (src ^ tmp) - tmp */
+                    a.movdqa(tmp, src);
+                    a.psrad(tmp, Imm(31));
+                    a.pshufd(tmp, tmp, Imm(0xF5));
+                    if (dst.id() != src.id())
+                        a.movdqa(dst, src);
+                    a.pxor(dst, tmp);
+                    a.psubq(dst, tmp);
+                    break;
+                case JIT_V128_F32X4:
+                    a.pcmpeqd(tmp, tmp);
+                    a.psrld(tmp, Imm(1));
+                    if (dst.id() != src.id())
+                        a.movdqa(dst, src);
+                    a.andps(dst, tmp);
+                    break;
+                case JIT_V128_F64X2:
+                    a.pcmpeqd(tmp, tmp);
+                    a.psrlq(tmp, Imm(1));
+                    if (dst.id() != src.id())
+                        a.movdqa(dst, src);
+                    a.andpd(dst, tmp);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        case JIT_OP_VSQRT:
+            if (shape == JIT_V128_F32X4)
+                a.sqrtps(dst, src);
+            else if (shape == JIT_V128_F64X2)
+                a.sqrtpd(dst, src);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VEXTENDLOWS:
+        case JIT_OP_VEXTENDLOWU:
+        case JIT_OP_VEXTENDHIGHS:
+        case JIT_OP_VEXTENDHIGHU:
+        {
+            bool is_signed = opcode == JIT_OP_VEXTENDLOWS
+                             || opcode == JIT_OP_VEXTENDHIGHS;
+
+            if (opcode == JIT_OP_VEXTENDHIGHS
+                || opcode == JIT_OP_VEXTENDHIGHU) {
+                /* Move the high 64 bits to the low 64 bits */
+                a.pshufd(tmp, src, Imm(0xEE));
+                src = tmp;
+            }
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    if (is_signed)
+                        a.pmovsxbw(dst, src);
+                    else
+                        a.pmovzxbw(dst, src);
+                    break;
+                case JIT_V128_I16X8:
+                    if (is_signed)
+                        a.pmovsxwd(dst, src);
+                    else
+                        a.pmovzxwd(dst, src);
+                    break;
+                case JIT_V128_I32X4:
+                    if (is_signed)
+                        a.pmovsxdq(dst, src);
+                    else
+                        a.pmovzxdq(dst, src);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        }
+        case JIT_OP_VPOPCNT:
+            /* Look up the bit counts of the low and high nibbles */
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            a.movdqa(tmp2, dst);
+            a.psrlw(tmp2, Imm(4));
+            v.i64x2[0] = v.i64x2[1] = 0x0F0F0F0F0F0F0F0FLL;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.pand(dst, tmp);
+            a.pand(tmp2, tmp);
+            /* The bit counts of 0 ~ 15 */
+            v.i64x2[0] = 0x0302020102010100LL;
+            v.i64x2[1] = 0x0403030203020201LL;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.pshufb(tmp, dst);
+            mov_imm_to_r_v128(a, reg_no_dst, v);
+            a.pshufb(dst, tmp2);
+            a.paddb(dst, tmp);
+            break;
+        case JIT_OP_VI32X4TOF32X4:
+            a.cvtdq2ps(dst, src);
+            break;
+        case JIT_OP_VU32X4TOF32X4:
+            /* Convert the low 16 bits and the high 16 bits halved
+               exactly, and round only when adding them */
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            a.pxor(tmp, tmp);
+            a.pblendw(tmp, dst, Imm(0x55));
+            a.psubd(dst, tmp);
+            a.cvtdq2ps(tmp, tmp);
+            a.psrld(dst, Imm(1));
+            a.cvtdq2ps(dst, dst);
+            a.addps(dst, dst);
+            a.addps(dst, tmp);
+            break;
+        case JIT_OP_VF32X4TOI32X4:
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            /* NaN to 0 */
+            a.movdqa(tmp, dst);
+            a.cmpps(tmp, tmp, Imm(0));
+            a.pand(dst, tmp);
+            /* Set the top bit of tmp for the lanes >= 0 */
+            a.pxor(tmp, dst);
+            /* The lanes out of range are converted to 0x80000000 */
+            a.cvttps2dq(dst, dst);
+            /* And flipped to 0x7FFFFFFF if they were >= 0 */
+            a.pand(tmp, dst);
+            a.psrad(tmp, Imm(31));
+            a.pxor(dst, tmp);
+            break;
+        case JIT_OP_VF32X4TOU32X4:
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            /* NaN and the negative lanes to 0 */
+            a.pxor(tmp, tmp);
+            a.maxps(dst, tmp);
+            /* tmp2 = 2147483648.0 */
+            a.pcmpeqd(tmp2, tmp2);
+            a.psrld(tmp2, Imm(1));
+            a.cvtdq2ps(tmp2, tmp2);
+            /* tmp = the lanes minus 2^31 converted, 0x7FFFFFFF for the
+               lanes >= 2^32 and 0 for the lanes < 2^31 */
+            a.movdqa(tmp, dst);
+            a.subps(tmp, tmp2);
+            a.cmpps(tmp2, tmp, Imm(2));
+            a.cvttps2dq(tmp, tmp);
+            a.pxor(tmp, tmp2);
+            a.pxor(tmp2, tmp2);
+            a.pmaxsd(tmp, tmp2);
+            /* The lanes >= 2^31 are converted to 0x80000000 */
+            a.cvttps2dq(dst, dst);
+            a.paddd(dst, tmp);
+            break;
+        case JIT_OP_VF64X2TOI32X4:
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            /* Clamp to INT32_MAX and NaN to 0, the lanes less than
+               INT32_MIN are converted to 0x80000000 */
+            a.movdqa(tmp, dst);
+            a.cmppd(tmp, dst, Imm(0));
+            v.f64x2[0] = v.f64x2[1] = 2147483647.0;
+            mov_imm_to_r_v128(a, REG_V128_FREE2_IDX, v);
+            a.andpd(tmp, tmp2);
+            a.minpd(dst, tmp);
+            /* The upper two lanes are zeroed */
+            a.cvttpd2dq(dst, dst);
+            break;
+        case JIT_OP_VF64X2TOU32X4:
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            /* NaN and the negative lanes to 0 */
+            a.pxor(tmp, tmp);
+            a.maxpd(dst, tmp);
+            v.f64x2[0] = v.f64x2[1] = 4294967295.0;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.minpd(dst, tmp);
+            a.roundpd(dst, dst, Imm(3));
+            /* Adding 2^52 moves the integer to the low 32 bits */
+            v.f64x2[0] = v.f64x2[1] = 4503599627370496.0;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.addpd(dst, tmp);
+            a.pxor(tmp, tmp);
+            a.shufps(dst, tmp, Imm(0x88));
+            break;
+        case JIT_OP_VI32X4TOF64X2:
+            a.cvtdq2pd(dst, src);
+            break;
+        case JIT_OP_VU32X4TOF64X2:
+            /* 0x43300000_xxxxxxxx is 2^52 + xxxxxxxx as a double */
+            if (dst.id() != src.id())
+                a.movdqa(dst, src);
+            v.i64x2[0] = v.i64x2[1] = 0x4330000043300000LL;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.unpcklps(dst, tmp);
+            v.f64x2[0] = v.f64x2[1] = 4503599627370496.0;
+            mov_imm_to_r_v128(a, REG_V128_FREE_IDX, v);
+            a.subpd(dst, tmp);
+            break;
+        case JIT_OP_VF64X2TOF32X4:
+            /* The upper two lanes are zeroed */
+            a.cvtpd2ps(dst, src);
+            break;
+        case JIT_OP_VF32X4TOF64X2:
+            a.cvtps2pd(dst, src);
+            break;
+        default:
+            GOTO_FAIL;
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn VROUND r0, r1, r2, r3
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 the dst V128 register
+ * @param r1 the src V128 register or const
+ * @param r2 the rounding mode
+ * @param r3 the lane shape
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_round(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1,
+                 JitReg r2, JitReg r3)
+{
+    JitV128Shape shape = simd_get_shape(cc, r3);
+    int32 reg_no_dst = jit_reg_no(r0), mode;
+    x86::Xmm src;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_CONST(r2);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    mode = jit_cc_get_const_I32(cc, r2);
+    src = simd_get_opnd(cc, a, r1, REG_V128_FREE_IDX);
+    if (shape == JIT_V128_F32X4)
+        a.roundps(regs_float[reg_no_dst], src, Imm(mode));
+    else if (shape == JIT_V128_F64X2)
+        a.roundpd(regs_float[reg_no_dst], src, Imm(mode));
+    else
+        GOTO_FAIL;
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode float min/max with wasm semantics: NaN is propagated and -0.0
+ * is less than +0.0, which minps/maxps don't honor. The dst register
+ * holds the first operand and src2 holds a copy of the second operand,
+ * both are clobbered.
+ */
+static void
+simd_float_min_max(x86::Assembler &a, bool is_min, bool is_f32, x86::Xmm dst,
+                   x86::Xmm src2)
+{
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+
+    a.movdqa(tmp, src2);
+    if (is_min) {
+        if (is_f32) {
+            a.minps(tmp, dst);
+            a.minps(dst, src2);
+            /* Propagate -0.0 and NaN */
+            a.orps(tmp, dst);
+            /* Canonicalize NaN */
+            a.cmpps(dst, tmp, Imm(3));
+            a.orps(tmp, dst);
+            a.psrld(dst, Imm(10));
+            a.andnps(dst, tmp);
+        }
+        else {
+            a.minpd(tmp, dst);
+            a.minpd(dst, src2);
+            a.orpd(tmp, dst);
+            a.cmppd(dst, tmp, Imm(3));
+            a.orpd(tmp, dst);
+            a.psrlq(dst, Imm(13));
+            a.andnpd(dst, tmp);
+        }
+    }
+    else {
+        if (is_f32) {
+            a.maxps(tmp, dst);
+            a.maxps(dst, src2);
+            /* Find the discrepancies and propagate NaN */
+            a.xorps(dst, tmp);
+            a.orps(tmp, dst);
+            /* Propagate the sign discrepancy and quiet NaN */
+            a.subps(tmp, dst);
+            /* Canonicalize NaN */
+            a.cmpps(dst, tmp, Imm(3));
+            a.psrld(dst, Imm(10));
+            a.andnps(dst, tmp);
+        }
+        else {
+            a.maxpd(tmp, dst);
+            a.maxpd(dst, src2);
+            a.xorpd(dst, tmp);
+            a.orpd(tmp, dst);
+            a.subpd(tmp, dst);
+            a.cmppd(dst, tmp, Imm(3));
+            a.psrlq(dst, Imm(13));
+            a.andnpd(dst, tmp);
+        }
+    }
+}
+
+/**
+ * Encode the two-operand vector insns, OP r0, r1, r2[, r3]
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param opcode the JIT opcode
+ * @param r0 the dst V128 register
+ * @param r1 the first src V128 register or const
+ * @param r2 the second src V128 register or const
+ * @param r3 the lane shape, or 0 if the insn has no shape operand
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_binary(JitCompContext *cc, x86::Assembler &a, JitOpcode opcode,
+                  JitReg r0, JitReg r1, JitReg r2, JitReg r3)
+{
+    JitV128Shape shape = simd_get_shape(cc, r3);
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst], src2;
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+    bool is_float = shape == JIT_V128_F32X4 || shape == JIT_V128_F64X2;
+    bool copy_src2 = false;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_EQKIND(r0, r2);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    /* The sequences below which clobber the second operand */
+    if (((opcode == JIT_OP_VMINS || opcode == JIT_OP_VMAXS) && is_float)
+        || opcode == JIT_OP_VPMIN || opcode == JIT_OP_VPMAX
+        || (opcode == JIT_OP_VMUL && shape == JIT_V128_I64X2)
+        || opcode == JIT_OP_VSWIZZLE)
+        copy_src2 = true;
+
+    src2 = simd_prepare_opnds(cc, a, reg_no_dst, r1, r2, copy_src2);
+
+    switch (opcode) {
+        case JIT_OP_VADD:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.paddb(dst, src2);
+                    break;
+                case JIT_V128_I16X8:
+                    a.paddw(dst, src2);
+                    break;
+                case JIT_V128_I32X4:
+                    a.paddd(dst, src2);
+                    break;
+                case JIT_V128_I64X2:
+                    a.paddq(dst, src2);
+                    break;
+                case JIT_V128_F32X4:
+                    a.addps(dst, src2);
+                    break;
+                case JIT_V128_F64X2:
+                    a.addpd(dst, src2);
+                    break;
+            }
+            break;
+        case JIT_OP_VSUB:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.psubb(dst, src2);
+                    break;
+                case JIT_V128_I16X8:
+                    a.psubw(dst, src2);
+                    break;
+                case JIT_V128_I32X4:
+                    a.psubd(dst, src2);
+                    break;
+                case JIT_V128_I64X2:
+                    a.psubq(dst, src2);
+                    break;
+                case JIT_V128_F32X4:
+                    a.subps(dst, src2);
+                    break;
+                case JIT_V128_F64X2:
+                    a.subpd(dst, src2);
+                    break;
+            }
+            break;
+        case JIT_OP_VMUL:
+            switch (shape) {
+                case JIT_V128_I16X8:
+                    a.pmullw(dst, src2);
+                    break;
+                case JIT_V128_I32X4:
+                    a.pmulld(dst, src2);
+                    break;
+                case JIT_V128_I64X2:
+                    /* lo(a) * lo(b) + ((hi(a) * lo(b) + lo(a) * hi(b)) << 32) */
+                    a.pshufd(tmp, src2, Imm(0xB1));
+                    a.pmulld(tmp, dst);
+                    a.pmuludq(dst, src2);
+                    a.movdqa(src2, tmp);
+                    a.psrlq(src2, Imm(32));
+                    a.paddd(tmp, src2);
+                    a.psllq(tmp, Imm(32));
+                    a.paddq(dst, tmp);
+                    break;
+                case JIT_V128_F32X4:
+                    a.mulps(dst, src2);
+                    break;
+                case JIT_V128_F64X2:
+                    a.mulpd(dst, src2);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        case JIT_OP_VDIV:
+            if (shape == JIT_V128_F32X4)
+                a.divps(dst, src2);
+            else if (shape == JIT_V128_F64X2)
+                a.divpd(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VADDSATS:
+            if (shape == JIT_V128_I8X16)
+                a.paddsb(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.paddsw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VADDSATU:
+            if (shape == JIT_V128_I8X16)
+                a.paddusb(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.paddusw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VSUBSATS:
+            if (shape == JIT_V128_I8X16)
+                a.psubsb(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.psubsw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VSUBSATU:
+            if (shape == JIT_V128_I8X16)
+                a.psubusb(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.psubusw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VMINS:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.pminsb(dst, src2);
+                    break;
+                case JIT_V128_I16X8:
+                    a.pminsw(dst, src2);
+                    break;
+                case JIT_V128_I32X4:
+                    a.pminsd(dst, src2);
+                    break;
+                case JIT_V128_F32X4:
+                case JIT_V128_F64X2:
+                    simd_float_min_max(a, true, shape == JIT_V128_F32X4, dst,
+                                       src2);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        case JIT_OP_VMINU:
+            if (shape == JIT_V128_I8X16)
+                a.pminub(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.pminuw(dst, src2);
+            else if (shape == JIT_V128_I32X4)
+                a.pminud(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VMAXS:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.pmaxsb(dst, src2);
+                    break;
+                case JIT_V128_I16X8:
+                    a.pmaxsw(dst, src2);
+                    break;
+                case JIT_V128_I32X4:
+                    a.pmaxsd(dst, src2);
+                    break;
+                case JIT_V128_F32X4:
+                case JIT_V128_F64X2:
+                    simd_float_min_max(a, false, shape == JIT_V128_F32X4, dst,
+                                       src2);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        case JIT_OP_VMAXU:
+            if (shape == JIT_V128_I8X16)
+                a.pmaxub(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.pmaxuw(dst, src2);
+            else if (shape == JIT_V128_I32X4)
+                a.pmaxud(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VPMIN:
+        case JIT_OP_VPMAX:
+            /* pmin(a, b) = b < a ? b : a, which is minps(b, a),
+               and pmax(a, b) = a < b ? b : a, which is maxps(b, a) */
+            if (shape == JIT_V128_F32X4) {
+                if (opcode == JIT_OP_VPMIN)
+                    a.minps(src2, dst);
+                else
+                    a.maxps(src2, dst);
+            }
+            else if (shape == JIT_V128_F64X2) {
+                if (opcode == JIT_OP_VPMIN)
+                    a.minpd(src2, dst);
+                else
+                    a.maxpd(src2, dst);
+            }
+            else
+                GOTO_FAIL;
+            a.movdqa(dst, src2);
+            break;
+        case JIT_OP_VAVGRU:
+            if (shape == JIT_V128_I8X16)
+                a.pavgb(dst, src2);
+            else if (shape == JIT_V128_I16X8)
+                a.pavgw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VNARROWS:
+            if (shape == JIT_V128_I16X8)
+                a.packsswb(dst, src2);
+            else if (shape == JIT_V128_I32X4)
+                a.packssdw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VNARROWU:
+            if (shape == JIT_V128_I16X8)
+                a.packuswb(dst, src2);
+            else if (shape == JIT_V128_I32X4)
+                a.packusdw(dst, src2);
+            else
+                GOTO_FAIL;
+            break;
+        case JIT_OP_VDOT:
+            a.pmaddwd(dst, src2);
+            break;
+        case JIT_OP_VQ15MULR:
+            /* pmulhrsw overflows only for 0x8000 * 0x8000, which gives
+               0x8000 and is flipped to 0x7FFF */
+            a.pmulhrsw(dst, src2);
+            a.pcmpeqw(tmp, tmp);
+            a.psllw(tmp, Imm(15));
+            a.pcmpeqw(tmp, dst);
+            a.pxor(dst, tmp);
+            break;
+        case JIT_OP_VSWIZZLE:
+            /* Set the top bit of the lane indexes greater than 15 so
+               that pshufb zeroes the corresponding lanes */
+            mov_imm_to_r_i32(a, REG_I32_FREE_IDX, 0x70707070);
+            a.movd(tmp, regs_i32[REG_I32_FREE_IDX]);
+            a.pshufd(tmp, tmp, Imm(0));
+            a.paddusb(src2, tmp);
+            a.pshufb(dst, src2);
+            break;
+        default:
+            GOTO_FAIL;
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn VSHL/VSHRS/VSHRU r0, r1, r2, r3
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param op the shift operation
+ * @param r0 the dst V128 register
+ * @param r1 the src V128 register or const
+ * @param r2 the I32 shift count, which has been masked with the lane
+ *        width minus one
+ * @param r3 the lane shape
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_shift(JitCompContext *cc, x86::Assembler &a, SHIFT_OP op,
+                 JitReg r0, JitReg r1, JitReg r2, JitReg r3)
+{
+    JitV128Shape shape = simd_get_shape(cc, r3);
+    int32 reg_no_dst = jit_reg_no(r0), count = 0;
+    x86::Xmm dst = regs_float[reg_no_dst];
+    x86::Xmm cnt = regs_float[REG_V128_FREE_IDX];
+    x86::Xmm tmp = regs_float[REG_V128_FREE2_IDX];
+    bool is_const_count = jit_reg_is_const(r2);
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_KIND(r2, JIT_REG_KIND_I32);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    if (jit_reg_is_const(r1))
+        mov_imm_to_r_v128(a, reg_no_dst, jit_cc_get_const_V128(cc, r1));
+    else
+        mov_r_to_r_v128(a, reg_no_dst, jit_reg_no(r1));
+
+    if (is_const_count) {
+        count = jit_cc_get_const_I32(cc, r2);
+        /* The i8 lanes are shifted as the high bytes of i16 lanes */
+        if (shape == JIT_V128_I8X16 && op != SHL)
+            count += 8;
+    }
+    else if (shape == JIT_V128_I8X16 && op != SHL) {
+        a.mov(regs_i32[REG_I32_FREE_IDX], regs_i32[jit_reg_no(r2)]);
+        a.add(regs_i32[REG_I32_FREE_IDX], Imm(8));
+        a.movd(cnt, regs_i32[REG_I32_FREE_IDX]);
+    }
+    else {
+        a.movd(cnt, regs_i32[jit_reg_no(r2)]);
+    }
+
+#define SIMD_SHIFT(inst, xmm)              \
+    do {                                   \
+        if (is_const_count)                \
+            a.inst(xmm, Imm(count));       \
+        else                               \
+            a.inst(xmm, cnt);              \
+    } while (0)
+
+    switch (shape) {
+        case JIT_V128_I8X16:
+            /* There are no byte shift instructions, unpack the bytes
+               to words, shift them and pack them back */
+            a.movdqa(tmp, dst);
+            a.punpcklbw(dst, dst);
+            a.punpckhbw(tmp, tmp);
+            if (op == SHL) {
+                SIMD_SHIFT(psllw, dst);
+                SIMD_SHIFT(psllw, tmp);
+                a.pcmpeqw(cnt, cnt);
+                a.psrlw(cnt, Imm(8));
+                a.pand(dst, cnt);
+                a.pand(tmp, cnt);
+                a.packuswb(dst, tmp);
+            }
+            else if (op == SHRS) {
+                SIMD_SHIFT(psraw, dst);
+                SIMD_SHIFT(psraw, tmp);
+                a.packsswb(dst, tmp);
+            }
+            else {
+                SIMD_SHIFT(psrlw, dst);
+                SIMD_SHIFT(psrlw, tmp);
+                a.packuswb(dst, tmp);
+            }
+            break;
+        case JIT_V128_I16X8:
+            if (op == SHL)
+                SIMD_SHIFT(psllw, dst);
+            else if (op == SHRS)
+                SIMD_SHIFT(psraw, dst);
+            else
+                SIMD_SHIFT(psrlw, dst);
+            break;
+        case JIT_V128_I32X4:
+            if (op == SHL)
+                SIMD_SHIFT(pslld, dst);
+            else if (op == SHRS)
+                SIMD_SHIFT(psrad, dst);
+            else
+                SIMD_SHIFT(psrld, dst);
+            break;
+        case JIT_V128_I64X2:
+            if (op == SHL)
+                SIMD_SHIFT(psllq, dst);
+            else if (op == SHRS) {
+                /* There is no psraq, sign extend the logical shift
+                   result with the shifted sign bit: (x ^ m) - m */
+                SIMD_SHIFT(psrlq, dst);
+                a.pcmpeqd(tmp, tmp);
+                a.psllq(tmp, Imm(63));
+                SIMD_SHIFT(psrlq, tmp);
+                a.pxor(dst, tmp);
+                a.psubq(dst, tmp);
+            }
+            else
+                SIMD_SHIFT(psrlq, dst);
+            break;
+        default:
+            GOTO_FAIL;
+    }
+
+#undef SIMD_SHIFT
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode pcmpeq/pcmpgt/pminu/pmaxu of the lane shape
+ */
+static bool
+simd_cmp_lanes(x86::Assembler &a, uint32 inst, JitV128Shape shape,
+               x86::Xmm dst, x86::Xmm src)
+{
+    /* inst: 0 pcmpeq, 1 pcmpgt, 2 pminu, 3 pmaxu */
+    switch (shape) {
+        case JIT_V128_I8X16:
+            if (inst == 0)
+                a.pcmpeqb(dst, src);
+            else if (inst == 1)
+                a.pcmpgtb(dst, src);
+            else if (inst == 2)
+                a.pminub(dst, src);
+            else
+                a.pmaxub(dst, src);
+            break;
+        case JIT_V128_I16X8:
+            if (inst == 0)
+                a.pcmpeqw(dst, src);
+            else if (inst == 1)
+                a.pcmpgtw(dst, src);
+            else if (inst == 2)
+                a.pminuw(dst, src);
+            else
+                a.pmaxuw(dst, src);
+            break;
+        case JIT_V128_I32X4:
+            if (inst == 0)
+                a.pcmpeqd(dst, src);
+            else if (inst == 1)
+                a.pcmpgtd(dst, src);
+            else if (inst == 2)
+                a.pminud(dst, src);
+            else
+                a.pmaxud(dst, src);
+            break;
+        case JIT_V128_I64X2:
+            if (inst == 0)
+                a.pcmpeqq(dst, src);
+            else if (inst == 1)
+                a.pcmpgtq(dst, src);
+            else
+                return false;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Encode insn VCMPxx r0, r1, r2, r3
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param op the condition
+ * @param r0 the dst V128 register
+ * @param r1 the first src V128 register or const
+ * @param r2 the second src V128 register or const
+ * @param r3 the lane shape
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_cmp(JitCompContext *cc, x86::Assembler &a, COND_OP op, JitReg r0,
+               JitReg r1, JitReg r2, JitReg r3)
+{
+    JitV128Shape shape = simd_get_shape(cc, r3);
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst], src2;
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+    bool invert = false;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_EQKIND(r0, r2);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    src2 = simd_prepare_opnds(cc, a, reg_no_dst, r1, r2, true);
+
+    if (shape == JIT_V128_F32X4 || shape == JIT_V128_F64X2) {
+        /* cmpps/cmppd predicates: 0 eq, 1 lt, 2 le, 4 neq, and gt/ge
+           are lt/le with the operands swapped */
+        int32 pred;
+        bool swap = false;
+
+        switch (op) {
+            case EQ:
+                pred = 0;
+                break;
+            case NE:
+                pred = 4;
+                break;
+            case LTS:
+                pred = 1;
+                break;
+            case LES:
+                pred = 2;
+                break;
+            case GTS:
+                pred = 1;
+                swap = true;
+                break;
+            case GES:
+                pred = 2;
+                swap = true;
+                break;
+            default:
+                GOTO_FAIL;
+        }
+        if (swap) {
+            if (shape == JIT_V128_F32X4)
+                a.cmpps(src2, dst, Imm(pred));
+            else
+                a.cmppd(src2, dst, Imm(pred));
+            a.movdqa(dst, src2);
+        }
+        else {
+            if (shape == JIT_V128_F32X4)
+                a.cmpps(dst, src2, Imm(pred));
+            else
+                a.cmppd(dst, src2, Imm(pred));
+        }
+        return true;
+    }
+
+    switch (op) {
+        case EQ:
+        case NE:
+            if (!simd_cmp_lanes(a, 0, shape, dst, src2))
+                GOTO_FAIL;
+            invert = op == NE;
+            break;
+        case GTS:
+        case LES:
+            if (!simd_cmp_lanes(a, 1, shape, dst, src2))
+                GOTO_FAIL;
+            invert = op == LES;
+            break;
+        case LTS:
+        case GES:
+            if (!simd_cmp_lanes(a, 1, shape, src2, dst))
+                GOTO_FAIL;
+            a.movdqa(dst, src2);
+            invert = op == GES;
+            break;
+        case GEU:
+        case LTU:
+            /* a >= b iff max(a, b) == a */
+            a.movdqa(tmp, dst);
+            if (!simd_cmp_lanes(a, 3, shape, tmp, src2)
+                || !simd_cmp_lanes(a, 0, shape, dst, tmp))
+                GOTO_FAIL;
+            invert = op == LTU;
+            break;
+        case LEU:
+        case GTU:
+            /* a <= b iff min(a, b) == a */
+            a.movdqa(tmp, dst);
+            if (!simd_cmp_lanes(a, 2, shape, tmp, src2)
+                || !simd_cmp_lanes(a, 0, shape, dst, tmp))
+                GOTO_FAIL;
+            invert = op == GTU;
+            break;
+        default:
+            GOTO_FAIL;
+    }
+
+    if (invert) {
+        a.pcmpeqd(tmp, tmp);
+        a.pxor(dst, tmp);
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn VANYTRUE/VALLTRUE/VBITMASK r0, r1[, r2]
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param opcode the JIT opcode
+ * @param r0 the dst I32 register
+ * @param r1 the src V128 register or const
+ * @param r2 the lane shape, or 0 for VANYTRUE
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_test(JitCompContext *cc, x86::Assembler &a, JitOpcode opcode,
+                JitReg r0, JitReg r1, JitReg r2)
+{
+    JitV128Shape shape = simd_get_shape(cc, r2);
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm src, tmp = regs_float[REG_V128_FREE_IDX];
+
+    CHECK_KIND(r0, JIT_REG_KIND_I32);
+    CHECK_KIND(r1, JIT_REG_KIND_V128);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_I32);
+
+    src = simd_get_opnd(cc, a, r1, REG_V128_FREE2_IDX);
+
+    switch (opcode) {
+        case JIT_OP_VANYTRUE:
+            a.xor_(regs_i32[reg_no_dst], regs_i32[reg_no_dst]);
+            a.ptest(src, src);
+            a.setne(regs_i8[reg_no_dst]);
+            break;
+        case JIT_OP_VALLTRUE:
+            /* All lanes are non-zero iff no lane equals to zero */
+            a.pxor(tmp, tmp);
+            if (!simd_cmp_lanes(a, 0, shape, tmp, src))
+                GOTO_FAIL;
+            a.xor_(regs_i32[reg_no_dst], regs_i32[reg_no_dst]);
+            a.ptest(tmp, tmp);
+            a.sete(regs_i8[reg_no_dst]);
+            break;
+        case JIT_OP_VBITMASK:
+            switch (shape) {
+                case JIT_V128_I8X16:
+                    a.pmovmskb(regs_i32[reg_no_dst], src);
+                    break;
+                case JIT_V128_I16X8:
+                    a.movdqa(tmp, src);
+                    a.packsswb(tmp, tmp);
+                    a.pmovmskb(regs_i32[reg_no_dst], tmp);
+                    a.movzx(regs_i32[reg_no_dst], regs_i8[reg_no_dst]);
+                    break;
+                case JIT_V128_I32X4:
+                    a.movmskps(regs_i32[reg_no_dst], src);
+                    break;
+                case JIT_V128_I64X2:
+                    a.movmskpd(regs_i32[reg_no_dst], src);
+                    break;
+                default:
+                    GOTO_FAIL;
+            }
+            break;
+        default:
+            GOTO_FAIL;
+    }
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn VSHUFFLE r0, r1, r2, r3
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 the dst V128 register
+ * @param r1 the first src V128 register or const
+ * @param r2 the second src V128 register or const
+ * @param r3 the const V128 of the lane indexes
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_simd_shuffle(JitCompContext *cc, x86::Assembler &a, JitReg r0,
+                   JitReg r1, JitReg r2, JitReg r3)
+{
+    int32 reg_no_dst = jit_reg_no(r0);
+    x86::Xmm dst = regs_float[reg_no_dst], src2;
+    x86::Xmm tmp = regs_float[REG_V128_FREE_IDX];
+    V128 lanes, mask1, mask2;
+    uint32 i;
+
+    CHECK_EQKIND(r0, r1);
+    CHECK_EQKIND(r0, r2);
+    CHECK_CONST(r3);
+    CHECK_REG_NO(reg_no_dst, JIT_REG_KIND_V128);
+
+    /* Lanes which aren't selected from an operand are zeroed by
+       pshufb with the top bit of the index set */
+    lanes = jit_cc_get_const_V128(cc, r3);
+    for (i = 0; i < 16; i++) {
+        uint8 lane = (uint8)lanes.i8x16[i];
+        mask1.i8x16[i] = (int8)(lane < 16 ? lane : 0x80);
+        mask2.i8x16[i] = (int8)(lane >= 16 ? lane - 16 : 0x80);
+    }
+
+    src2 = simd_prepare_opnds(cc, a, reg_no_dst, r1, r2, true);
+    mov_imm_to_r_v128(a, REG_V128_FREE_IDX, mask1);
+    a.pshufb(dst, tmp);
+    mov_imm_to_r_v128(a, REG_V128_FREE_IDX, mask2);
+    a.pshufb(src2, tmp);
+    a.por(dst, src2);
+    return true;
+fail:
+    return false;
+}
+#endif /* end of WASM_ENABLE_SIMD != 0 */
+
+/**
+ * Encode insn mov: MOV r0, r1
+ * @param kind the data kind, such as I32, I64, F32 and F64
+ * @param Type the data type, such as int32, int64, float32, and float64
+ * @param type the abbreviation of data type, such as i32, i64, f32, and f64
+ * @param bytes_dst the byte number of dst data
+ */
+#define MOV_R_R(kind, Type, type)                                \
+    do {                                                         \
+        bool _ret = false;                                       \
+        int32 reg_no_dst = 0, reg_no_src = 0;                    \
+        CHECK_EQKIND(r0, r1);                                    \
+                                                                 \
+        CHECK_NCONST(r0);                                        \
+        reg_no_dst = jit_reg_no(r0);                             \
+        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));              \
+                                                                 \
+        if (jit_reg_is_const(r1)) {                              \
+            Type data = jit_cc_get_const_##kind(cc, r1);         \
+            _ret = mov_imm_to_r_##type(a, reg_no_dst, data);     \
+        }                                                        \
+        else {                                                   \
+            reg_no_src = jit_reg_no(r1);                         \
+            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));          \
+            _ret = mov_r_to_r_##type(a, reg_no_dst, reg_no_src); \
+        }                                                        \
+        if (!_ret)                                               \
+            GOTO_FAIL;                                           \
+    } while (0)
+
+/**
+ * Encode mov insn, MOV r0, r1
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 dst jit register that contains the dst operand info
+ * @param r1 src jit register that contains the src operand info
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_mov(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1)
+{
+    switch (jit_reg_kind(r0)) {
+        case JIT_REG_KIND_I32:
+            MOV_R_R(I32, int32, i32);
+            break;
+        case JIT_REG_KIND_I64:
+            MOV_R_R(I64, int64, i64);
+            break;
+        case JIT_REG_KIND_F32:
+            MOV_R_R(F32, float32, f32);
+            break;
+        case JIT_REG_KIND_F64:
+            MOV_R_R(F64, float64, f64);
+            break;
+#if WASM_ENABLE_SIMD != 0
+        case JIT_REG_KIND_V128:
+            MOV_R_R(V128, V128, v128);
+            break;
+#endif
+        default:
+            LOG_VERBOSE("Invalid reg type of mov: %d\n", jit_reg_kind(r0));
+            GOTO_FAIL;
+    }
+
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn neg: NEG r0, r1
+ * @param kind the data kind, such as I32, I64, F32 and F64
+ * @param Type the data type, such as int32, int64, float32, and float64
+ * @param type the abbreviation of data type, such as i32, i64, f32, and f64
+ */
+#define NEG_R_R(kind, Type, type)                                \
+    do {                                                         \
+        bool _ret = false;                                       \
+        int32 reg_no_dst = 0, reg_no_src = 0;                    \
+        CHECK_EQKIND(r0, r1);                                    \
+                                                                 \
+        CHECK_NCONST(r0);                                        \
+        reg_no_dst = jit_reg_no(r0);                             \
+        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));              \
+                                                                 \
+        if (jit_reg_is_const(r1)) {                              \
+            Type data = jit_cc_get_const_##kind(cc, r1);         \
+            _ret = neg_imm_to_r_##type(a, reg_no_dst, data);     \
+        }                                                        \
+        else {                                                   \
+            reg_no_src = jit_reg_no(r1);                         \
+            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));          \
+            _ret = neg_r_to_r_##type(a, reg_no_dst, reg_no_src); \
+        }                                                        \
+        if (!_ret)                                               \
+            GOTO_FAIL;                                           \
+    } while (0)
+
+/**
+ * Encode neg insn, NEG r0, r1
+ *
+ * @param cc the compiler context
+ * @param a the assembler to emit the code
+ * @param r0 dst jit register that contains the dst operand info
+ * @param r1 src jit register that contains the src operand info
+ *
+ * @return true if success, false if failed
+ */
+static bool
+lower_neg(JitCompContext *cc, x86::Assembler &a, JitReg r0, JitReg r1)
+{
+    switch (jit_reg_kind(r0)) {
+        case JIT_REG_KIND_I32:
+            NEG_R_R(I32, int32, i32);
+            break;
+        case JIT_REG_KIND_I64:
+            NEG_R_R(I64, int64, i64);
+            break;
+        case JIT_REG_KIND_F32:
+            NEG_R_R(F32, float32, f32);
+            break;
+        case JIT_REG_KIND_F64:
+            NEG_R_R(F64, float64, f64);
+            break;
+        default:
+            LOG_VERBOSE("Invalid reg type of neg: %d\n", jit_reg_kind(r0));
+            GOTO_FAIL;
+    }
+
+    return true;
+fail:
+    return false;
+}
+
+/**
+ * Encode insn convert: I32TOI8 r0, r1, or I32TOI16, I32TOF32, F32TOF64, etc.
+ * @param kind0 the dst JIT_REG_KIND, such as I32, I64, F32 and F64
+ * @param kind1 the src JIT_REG_KIND, such as I32, I64, F32 and F64
+ * @param type0 the dst data type, such as i8, u8, i16, u16, i32, f32, i64, f32,
+ * f64
+ * @param type1 the src data type, such as i8, u8, i16, u16, i32, f32, i64, f32,
+ * f64
+ */
+#define CONVERT_R_R(kind0, kind1, type0, type1, Type1)                       \
+    do {                                                                     \
+        bool _ret = false;                                                   \
+        int32 reg_no_dst = 0, reg_no_src = 0;                                \
+        CHECK_KIND(r0, JIT_REG_KIND_##kind0);                                \
+        CHECK_KIND(r1, JIT_REG_KIND_##kind1);                                \
+                                                                             \
+        CHECK_NCONST(r0);                                                    \
+        reg_no_dst = jit_reg_no(r0);                                         \
+        CHECK_REG_NO(reg_no_dst, jit_reg_kind(r0));                          \
+                                                                             \
+        if (jit_reg_is_const(r1)) {                                          \
+            Type1 data = jit_cc_get_const_##kind1(cc, r1);                   \
+            _ret = convert_imm_##type1##_to_r_##type0(a, reg_no_dst, data);  \
+        }                                                                    \
+        else {                                                               \
+            reg_no_src = jit_reg_no(r1);                                     \
+            CHECK_REG_NO(reg_no_src, jit_reg_kind(r1));                      \
+            _ret =                                                           \
+                convert_r_##type1##_to_r_##type0(a, reg_no_dst, reg_no_src); \
+        }                                                                    \
+        if (!_ret)                                                           \
+            GOTO_FAIL;                                                       \
+    } while (0)
+
+/**
+ * Encode insn alu: ADD/SUB/MUL/DIV/REM r0, r1, r2
  * @param kind the data kind, such as I32, I64, F32 and F64
  * @param Type the data type, such as int32, int64, float32, and float64
  * @param type the abbreviation of data type, such as i32, i64, f32, and f64
@@ -5113,6 +6729,12 @@ lower_bit(JitCompContext *cc, x86::Assembler &a, BIT_OP op, JitReg r0,
         case JIT_REG_KIND_I64:
             BIT_R_R_R(I64, int64, i64, op);
             break;
+#if WASM_ENABLE_SIMD != 0
+        case JIT_REG_KIND_V128:
+            if (!lower_simd_bit(cc, a, op, r0, r1, r2))
+                GOTO_FAIL;
+            break;
+#endif
         default:
             LOG_VERBOSE("Invalid reg type of bit: %d\n", jit_reg_kind(r0));
             GOTO_FAIL;
@@ -6177,7 +7799,11 @@ patch_jmp_info_list(JitCompContext *cc, bh_list *jmp_info_list)
 {
     JmpInfo *jmp_info, *jmp_info_next;
     JitReg reg_dst;
-    char *stream;
+    char *stream, *write_stream;
+    /* The code is patched through its writable address */
+    intptr_t write_offset =
+        (char *)jit_code_cache_get_writable_addr(cc->jitted_addr_begin)
+        - (char *)cc->jitted_addr_begin;
 
     jmp_info = (JmpInfo *)bh_list_first_elem(jmp_info_list);
 
@@ -6185,12 +7811,13 @@ patch_jmp_info_list(JitCompContext *cc, bh_list *jmp_info_list)
         jmp_info_next = (JmpInfo *)bh_list_elem_next(jmp_info);
 
         stream = (char *)cc->jitted_addr_begin + jmp_info->offset;
+        write_stream = stream + write_offset;
 
         if (jmp_info->type == JMP_DST_LABEL_REL) {
             /* Jmp with relative address */
             reg_dst =
                 jit_reg_new(JIT_REG_KIND_L32, jmp_info->dst_info.label_dst);
-            *(int32 *)stream =
+            *(int32 *)write_stream =
                 (int32)((uintptr_t)*jit_annl_jitted_addr(cc, reg_dst)
                         - (uintptr_t)stream)
                 - 4;
@@ -6199,16 +7826,17 @@ patch_jmp_info_list(JitCompContext *cc, bh_list *jmp_info_list)
             /* Jmp with absolute address */
             reg_dst =
                 jit_reg_new(JIT_REG_KIND_L32, jmp_info->dst_info.label_dst);
-            *(uintptr_t *)stream =
+            *(uintptr_t *)write_stream =
                 (uintptr_t)*jit_annl_jitted_addr(cc, reg_dst);
         }
         else if (jmp_info->type == JMP_END_OF_CALLBC) {
             /* 7 is the size of mov and jmp instruction */
-            *(uintptr_t *)stream = (uintptr_t)stream + sizeof(uintptr_t) + 7;
+            *(uintptr_t *)write_stream =
+                (uintptr_t)stream + sizeof(uintptr_t) + 7;
         }
         else if (jmp_info->type == JMP_LOOKUPSWITCH_BASE) {
             /* 11 is the size of 8-byte addr and 3-byte jmp instruction */
-            *(uintptr_t *)stream = (uintptr_t)stream + 11;
+            *(uintptr_t *)write_stream = (uintptr_t)stream + 11;
         }
 
         jmp_info = jmp_info_next;
@@ -7983,6 +9611,164 @@ jit_codegen_gen_native(JitCompContext *cc)
                     ST_R_R_R(F64, float64, 8, false);
                     break;
 
+#if WASM_ENABLE_SIMD != 0
+                case JIT_OP_LDV128:
+                    LOAD_3ARGS();
+                    LD_R_R_R(V128, 16, false);
+                    break;
+
+                case JIT_OP_STV128:
+                    LOAD_3ARGS_NO_ASSIGN();
+                    if (!lower_simd_store(cc, a, r0, r1, r2))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_NOT:
+                    LOAD_2ARGS();
+                    if (!lower_simd_not(cc, a, r0, r1))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VSPLAT:
+                    LOAD_3ARGS();
+                    if (!lower_simd_splat(cc, a, r0, r1, r2))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VEXTRACTS:
+                case JIT_OP_VEXTRACTU:
+                    LOAD_4ARGS();
+                    if (!lower_simd_extract(cc, a,
+                                            insn->opcode == JIT_OP_VEXTRACTS,
+                                            r0, r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VREPLACE:
+                    LOAD_4ARGS();
+                    r4 = *jit_insn_opnd(insn, 4);
+                    if (!lower_simd_replace(cc, a, r0, r1, r2, r3, r4))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VNEG:
+                case JIT_OP_VABS:
+                case JIT_OP_VSQRT:
+                case JIT_OP_VEXTENDLOWS:
+                case JIT_OP_VEXTENDLOWU:
+                case JIT_OP_VEXTENDHIGHS:
+                case JIT_OP_VEXTENDHIGHU:
+                    LOAD_3ARGS();
+                    if (!lower_simd_unary(cc, a, (JitOpcode)insn->opcode, r0,
+                                          r1, r2))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VPOPCNT:
+                case JIT_OP_VI32X4TOF32X4:
+                case JIT_OP_VU32X4TOF32X4:
+                case JIT_OP_VF32X4TOI32X4:
+                case JIT_OP_VF32X4TOU32X4:
+                case JIT_OP_VF64X2TOI32X4:
+                case JIT_OP_VF64X2TOU32X4:
+                case JIT_OP_VI32X4TOF64X2:
+                case JIT_OP_VU32X4TOF64X2:
+                case JIT_OP_VF64X2TOF32X4:
+                case JIT_OP_VF32X4TOF64X2:
+                    LOAD_2ARGS();
+                    if (!lower_simd_unary(cc, a, (JitOpcode)insn->opcode, r0,
+                                          r1, 0))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VROUND:
+                    LOAD_4ARGS();
+                    if (!lower_simd_round(cc, a, r0, r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VADD:
+                case JIT_OP_VSUB:
+                case JIT_OP_VMUL:
+                case JIT_OP_VDIV:
+                case JIT_OP_VADDSATS:
+                case JIT_OP_VADDSATU:
+                case JIT_OP_VSUBSATS:
+                case JIT_OP_VSUBSATU:
+                case JIT_OP_VMINS:
+                case JIT_OP_VMINU:
+                case JIT_OP_VMAXS:
+                case JIT_OP_VMAXU:
+                case JIT_OP_VPMIN:
+                case JIT_OP_VPMAX:
+                case JIT_OP_VAVGRU:
+                case JIT_OP_VNARROWS:
+                case JIT_OP_VNARROWU:
+                    LOAD_4ARGS();
+                    if (!lower_simd_binary(cc, a, (JitOpcode)insn->opcode, r0,
+                                           r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VDOT:
+                case JIT_OP_VQ15MULR:
+                case JIT_OP_VSWIZZLE:
+                    LOAD_3ARGS();
+                    if (!lower_simd_binary(cc, a, (JitOpcode)insn->opcode, r0,
+                                           r1, r2, 0))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VSHL:
+                case JIT_OP_VSHRS:
+                case JIT_OP_VSHRU:
+                    LOAD_4ARGS();
+                    if (!lower_simd_shift(
+                            cc, a,
+                            (SHIFT_OP)(SHL + (insn->opcode - JIT_OP_VSHL)), r0,
+                            r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VCMPEQ:
+                case JIT_OP_VCMPNE:
+                case JIT_OP_VCMPGTS:
+                case JIT_OP_VCMPGES:
+                case JIT_OP_VCMPLTS:
+                case JIT_OP_VCMPLES:
+                case JIT_OP_VCMPGTU:
+                case JIT_OP_VCMPGEU:
+                case JIT_OP_VCMPLTU:
+                case JIT_OP_VCMPLEU:
+                    LOAD_4ARGS();
+                    if (!lower_simd_cmp(
+                            cc, a,
+                            (COND_OP)(EQ + (insn->opcode - JIT_OP_VCMPEQ)), r0,
+                            r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VANYTRUE:
+                    LOAD_2ARGS();
+                    if (!lower_simd_test(cc, a, JIT_OP_VANYTRUE, r0, r1, 0))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VALLTRUE:
+                case JIT_OP_VBITMASK:
+                    LOAD_3ARGS();
+                    if (!lower_simd_test(cc, a, (JitOpcode)insn->opcode, r0, r1,
+                                         r2))
+                        GOTO_FAIL;
+                    break;
+
+                case JIT_OP_VSHUFFLE:
+                    LOAD_4ARGS();
+                    if (!lower_simd_shuffle(cc, a, r0, r1, r2, r3))
+                        GOTO_FAIL;
+                    break;
+#endif
+
                 case JIT_OP_JMP:
                     LOAD_1ARG();
                     CHECK_KIND(r0, JIT_REG_KIND_L32);
@@ -8332,12 +10118,13 @@ jit_codegen_gen_native(JitCompContext *cc)
 
     code_buf = (char *)code.sectionById(0)->buffer().data();
     code_size = code.sectionById(0)->buffer().size();
-    if (!(stream = (char *)jit_code_cache_alloc(code_size))) {
+    if (!(stream = (char *)jit_code_cache_alloc_for_module(cc->cur_wasm_module,
+                                                           code_size))) {
         jit_set_last_error(cc, "allocate memory failed");
         goto fail;
     }
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
     cc->jitted_addr_begin = stream;
     cc->jitted_addr_end = stream + code_size;
 
@@ -8677,7 +10464,7 @@ jit_codegen_compile_call_to_llvm_jit(const WASMType *func_type)
     if (!stream)
         return NULL;
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
 
 #if 0
     dump_native(stream, code_size);
@@ -9102,11 +10889,11 @@ jit_codegen_compile_call_to_fast_jit(const WASMModule *module, uint32 func_idx)
 
     code_buf = (char *)code.sectionById(0)->buffer().data();
     code_size = code.sectionById(0)->buffer().size();
-    stream = (char *)jit_code_cache_alloc(code_size);
+    stream = (char *)jit_code_cache_alloc_for_module(module, code_size);
     if (!stream)
         return NULL;
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
 
 #if 0
     printf("Code of call to fast jit of func %u:\n", func_idx);
@@ -9160,6 +10947,17 @@ jit_codegen_init()
     code.setErrorHandler(&err_handler);
     x86::Assembler a(&code);
 
+#if WASM_ENABLE_SIMD != 0
+    const CpuInfo &cpu_info = CpuInfo::host();
+
+    simd_supported = cpu_info.hasFeature(CpuFeatures::X86::kSSSE3)
+                     && cpu_info.hasFeature(CpuFeatures::X86::kSSE4_1)
+                     && cpu_info.hasFeature(CpuFeatures::X86::kSSE4_2);
+    if (!simd_supported)
+        LOG_WARNING("SSSE3, SSE4.1 or SSE4.2 isn't supported by the CPU, "
+                    "fast jit can't compile the SIMD instructions\n");
+#endif
+
     /* Initialize code_block_switch_to_jitted_from_interp */
 
     /* push callee-save registers */
@@ -9196,7 +10994,7 @@ jit_codegen_init()
     if (!stream)
         return false;
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
     code_block_switch_to_jitted_from_interp = stream;
 
 #if 0
@@ -9243,7 +11041,7 @@ jit_codegen_init()
     if (!stream)
         goto fail1;
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
     code_block_return_to_interp_from_jitted =
         jit_globals->return_to_interp_from_jitted = stream;
 
@@ -9348,7 +11146,7 @@ jit_codegen_init()
     if (!stream)
         goto fail2;
 
-    bh_memcpy_s(stream, code_size, code_buf, code_size);
+    jit_code_cache_write(stream, code_buf, code_size);
     code_block_compile_fast_jit_and_then_call =
         jit_globals->compile_fast_jit_and_then_call = stream;
 
@@ -9419,6 +11217,52 @@ static uint8 hreg_info_F64[3][16] = {
       1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_jitted */
 };
 
+#if WASM_ENABLE_SIMD != 0
+/* No V128 register is used by the functions without v128 */
+static uint8 hreg_info_V128_none[3][16] = {
+    /* xmm0 ~ xmm15 */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1 },
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_native */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_jitted */
+};
+
+/* In the functions using v128, xmm6, xmm7, xmm12 and xmm13 are taken
+   from the float registers for the V128 registers, and xmm14 is freely
+   used by the vector instructions */
+static uint8 hreg_info_F32_simd[3][16] = {
+    /* xmm0 ~ xmm15 */
+    { 0, 0, 0, 0, 0, 0, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 1 },
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_native */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_jitted */
+};
+
+static uint8 hreg_info_F64_simd[3][16] = {
+    /* xmm0 ~ xmm15 */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      0, 0, 0, 0, 1, 1, 1, 1 },
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_native */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_jitted */
+};
+
+static uint8 hreg_info_V128[3][16] = {
+    /* xmm0 ~ xmm15 */
+    { 1, 1, 1, 1, 1, 1, 0, 0,
+      1, 1, 1, 1, 0, 0, 1, 1 },
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_native */
+    { 1, 1, 1, 1, 1, 1, 1, 1,
+      1, 1, 1, 1, 1, 1, 1, 0 }, /* caller_saved_jitted */
+};
+#endif
+
 static const JitHardRegInfo g_hreg_info = {
     {
         { 0, NULL, NULL, NULL }, /* VOID */
@@ -9444,7 +11288,53 @@ static const JitHardRegInfo g_hreg_info = {
           hreg_info_F64[2] },
 
         { 0, NULL, NULL, NULL }, /* V8 */
+#if WASM_ENABLE_SIMD != 0
+        { sizeof(hreg_info_V128_none[0]), /* V128 */
+          hreg_info_V128_none[0],
+          hreg_info_V128_none[1],
+          hreg_info_V128_none[2] },
+#else
         { 0, NULL, NULL, NULL }, /* V16 */
+#endif
+        { 0, NULL, NULL, NULL }  /* V32 */
+    },
+    /* frame pointer hreg index: rbp */
+    0,
+    /* exec_env hreg index: r15 */
+    15,
+    /* cmp hreg index: esi */
+    6
+};
+#if WASM_ENABLE_SIMD != 0
+static const JitHardRegInfo g_hreg_info_simd = {
+    {
+        { 0, NULL, NULL, NULL }, /* VOID */
+
+        { sizeof(hreg_info_I32[0]), /* I32 */
+          hreg_info_I32[0],
+          hreg_info_I32[1],
+          hreg_info_I32[2] },
+
+        { sizeof(hreg_info_I64[0]), /* I64 */
+          hreg_info_I64[0],
+          hreg_info_I64[1],
+          hreg_info_I64[2] },
+
+        { sizeof(hreg_info_F32_simd[0]), /* F32 */
+          hreg_info_F32_simd[0],
+          hreg_info_F32_simd[1],
+          hreg_info_F32_simd[2] },
+
+        { sizeof(hreg_info_F64_simd[0]), /* F64 */
+          hreg_info_F64_simd[0],
+          hreg_info_F64_simd[1],
+          hreg_info_F64_simd[2] },
+
+        { 0, NULL, NULL, NULL }, /* V8 */
+        { sizeof(hreg_info_V128[0]), /* V128 */
+          hreg_info_V128[0],
+          hreg_info_V128[1],
+          hreg_info_V128[2] },
         { 0, NULL, NULL, NULL }  /* V32 */
     },
     /* frame pointer hreg index: rbp */
@@ -9454,6 +11344,7 @@ static const JitHardRegInfo g_hreg_info = {
     /* cmp hreg index: esi */
     6
 };
+#endif
 /* clang-format on */
 
 const JitHardRegInfo *
@@ -9462,6 +11353,20 @@ jit_codegen_get_hreg_info()
     return &g_hreg_info;
 }
 
+#if WASM_ENABLE_SIMD != 0
+const JitHardRegInfo *
+jit_codegen_get_hreg_info_simd()
+{
+    return &g_hreg_info_simd;
+}
+
+bool
+jit_codegen_is_simd_supported()
+{
+    return simd_supported;
+}
+#endif
+
 static const char *reg_names_i32[] = {
     "ebp", "eax", "ebx", "ecx", "edx", "edi", "esi", "esp",
 };
@@ -9482,6 +11387,15 @@ static const char *reg_names_f64[] = {
     "xmm12_f64", "xmm13_f64", "xmm14_f64", "xmm15_f64"
 };
 
+#if WASM_ENABLE_SIMD != 0
+static const char *reg_names_v128[] = {
+    "xmm0_v128",  "xmm1_v128",  "xmm2_v128",  "xmm3_v128",
+    "xmm4_v128",  "xmm5_v128",  "xmm6_v128",  "xmm7_v128",
+    "xmm8_v128",  "xmm9_v128",  "xmm10_v128", "xmm11_v128",
+    "xmm12_v128", "xmm13_v128", "xmm14_v128", "xmm15_v128"
+};
+#endif
+
 JitReg
 jit_codegen_get_hreg_by_name(const char *name)
 {
@@ -9498,6 +11412,14 @@ jit_codegen_get_hreg_by_name(const char *name)
                 return jit_reg_new(JIT_REG_KIND_I64, i);
     }
     else if (!strncmp(name, "xmm", 3)) {
+#if WASM_ENABLE_SIMD != 0
+        if (strstr(name, "_v128")) {
+            for (i = 0; i < sizeof(reg_names_v128) / sizeof(char *); i++)
+                if (!strcmp(reg_names_v128[i], name))
+                    return jit_reg_new(JIT_REG_KIND_V128, i);
+            return 0;
+        }
+#endif
         if (!strstr(name, "_f64")) {
             for (i = 0; i < sizeof(reg_names_f32) / sizeof(char *); i++)
                 if (!strcmp(reg_names_f32[i], name))
@@ -107,6 +107,12 @@ load_block_params(JitCompContext *cc, JitBlock *block)
                 value = gen_load_f64(jit_frame, offset);
                 offset += 2;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                value = gen_load_v128(jit_frame, offset);
+                offset += 4;
+                break;
+#endif
             default:
                 bh_assert(0);
                 break;
@@ -153,6 +159,12 @@ load_block_results(JitCompContext *cc, JitBlock *block)
                 value = gen_load_f64(jit_frame, offset);
                 offset += 2;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                value = gen_load_v128(jit_frame, offset);
+                offset += 4;
+                break;
+#endif
             default:
                 bh_assert(0);
                 break;
@@ -374,6 +386,17 @@ copy_block_arities(JitCompContext *cc, JitReg dst_frame_sp, uint8 *dst_types,
                 offset_src += 2;
                 offset_dst += 2;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                /* v128 isn't returned in register, always store it
+                   to the dest frame */
+                value = gen_load_v128(jit_frame, offset_src);
+                GEN_INSN(STV128, value, dst_frame_sp,
+                         NEW_CONST(I32, offset_dst * 4));
+                offset_src += 4;
+                offset_dst += 4;
+                break;
+#endif
             default:
                 bh_assert(0);
                 break;
@@ -804,6 +827,10 @@ jit_compile_op_block(JitCompContext *cc, uint8 **p_frame_ip,
         if (!push_jit_block_to_stack_and_pass_params(
                 cc, block, block->basic_block_entry, 0, false))
             goto fail;
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+        /* Count the iteration for the tier-up to llvm jit */
+        gen_count_hotness(cc->jit_frame);
+#endif
     }
     else if (label_type == LABEL_TYPE_IF) {
         POP_I32(value);
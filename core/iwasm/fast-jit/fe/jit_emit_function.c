@@ -51,6 +51,13 @@ pre_call(JitCompContext *cc, const WASMType *func_type)
                 outs_off -= 8;
                 GEN_INSN(STF64, value, cc->fp_reg, NEW_CONST(I32, outs_off));
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                POP_V128(value);
+                outs_off -= 16;
+                GEN_INSN(STV128, value, cc->fp_reg, NEW_CONST(I32, outs_off));
+                break;
+#endif
             default:
                 bh_assert(0);
                 goto fail;
@@ -132,6 +139,17 @@ post_return(JitCompContext *cc, const WASMType *func_type, JitReg first_res,
                 PUSH_F64(value);
                 n += 2;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                /* The v128 result is always passed through the frame */
+                bh_assert(!(i == 0 && first_res));
+                value = jit_cc_new_reg_V128(cc);
+                GEN_INSN(LDV128, value, cc->fp_reg,
+                         NEW_CONST(I32, offset_of_local(n)));
+                PUSH_V128(value);
+                n += 4;
+                break;
+#endif
             default:
                 bh_assert(0);
                 goto fail;
@@ -206,6 +224,12 @@ create_first_res_reg(JitCompContext *cc, const WASMType *func_type)
                 return jit_cc_new_reg_F32(cc);
             case VALUE_TYPE_F64:
                 return jit_cc_new_reg_F64(cc);
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                /* No return register, the callee stores the result
+                   to the frame */
+                return 0;
+#endif
             default:
                 bh_assert(0);
                 return 0;
@@ -214,6 +238,20 @@ create_first_res_reg(JitCompContext *cc, const WASMType *func_type)
     return 0;
 }
 
+#if WASM_ENABLE_SIMD != 0
+static bool
+func_type_has_v128(const WASMType *func_type)
+{
+    uint32 i;
+
+    for (i = 0; i < func_type->param_count + func_type->result_count; i++) {
+        if (func_type->types[i] == VALUE_TYPE_V128)
+            return true;
+    }
+    return false;
+}
+#endif
+
 bool
 jit_compile_op_call(JitCompContext *cc, uint32 func_idx, bool tail_call)
 {
@@ -251,7 +289,12 @@ jit_compile_op_call(JitCompContext *cc, uint32 func_idx, bool tail_call)
             || func_type->param_count >= 5 /* registered as normal mode, but
                                               jit_emit_callnative only supports
                                               maximum 6 registers now
-                                              (include exec_nev) */) {
+                                              (include exec_nev) */
+#if WASM_ENABLE_SIMD != 0
+            /* jit_emit_callnative can't pass v128 in registers */
+            || func_type_has_v128(func_type)
+#endif
+        ) {
             JitReg arg_regs[3];
 
             if (!pre_call(cc, func_type)) {
@@ -675,6 +718,14 @@ jit_compile_op_call_indirect(JitCompContext *cc, uint32 type_idx,
                 GEN_INSN(STF64, res, cc->fp_reg,
                          NEW_CONST(I32, offset_of_local(n)));
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                res = jit_cc_new_reg_V128(cc);
+                GEN_INSN(LDV128, res, argv, NEW_CONST(I32, 0));
+                GEN_INSN(STV128, res, cc->fp_reg,
+                         NEW_CONST(I32, offset_of_local(n)));
+                break;
+#endif
             default:
                 bh_assert(0);
                 goto fail;
@@ -729,6 +780,11 @@ jit_compile_op_call_indirect(JitCompContext *cc, uint32 type_idx,
             case VALUE_TYPE_F64:
                 res = jit_cc_new_reg_F64(cc);
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                /* Stored to the frame by the callee */
+                break;
+#endif
             default:
                 bh_assert(0);
                 goto fail;
@@ -760,6 +816,10 @@ jit_compile_op_call_indirect(JitCompContext *cc, uint32 type_idx,
                 GEN_INSN(STF64, res, cc->fp_reg,
                          NEW_CONST(I32, offset_of_local(n)));
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                break;
+#endif
             default:
                 bh_assert(0);
                 goto fail;
@@ -572,6 +572,234 @@ fail:
     return false;
 }
 
+#if WASM_ENABLE_SIMD != 0
+bool
+jit_compile_op_v128_load(JitCompContext *cc, uint32 align, uint32 offset)
+{
+    JitReg addr, offset1, value, memory_data;
+
+    POP_I32(addr);
+
+    offset1 = check_and_seek(cc, addr, offset, 16);
+    if (!offset1) {
+        goto fail;
+    }
+
+    memory_data = get_memory_data_reg(cc->jit_frame, 0);
+
+    value = jit_cc_new_reg_V128(cc);
+    GEN_INSN(LDV128, value, memory_data, offset1);
+
+    PUSH_V128(value);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_op_v128_store(JitCompContext *cc, uint32 align, uint32 offset)
+{
+    JitReg value, addr, offset1, memory_data;
+
+    POP_V128(value);
+    POP_I32(addr);
+
+    offset1 = check_and_seek(cc, addr, offset, 16);
+    if (!offset1) {
+        goto fail;
+    }
+
+    memory_data = get_memory_data_reg(cc->jit_frame, 0);
+
+    GEN_INSN(STV128, value, memory_data, offset1);
+
+    return true;
+fail:
+    return false;
+}
+
+/* Load one lane of the given shape, the result is an I32 for the
+   8-bit, 16-bit and 32-bit lanes and an I64 for the 64-bit lane */
+static JitReg
+gen_load_lane_value(JitCompContext *cc, JitReg addr, uint32 offset,
+                    JitV128Shape shape)
+{
+    JitReg offset1, value, memory_data;
+    uint32 bytes = 1 << shape;
+
+    offset1 = check_and_seek(cc, addr, offset, bytes);
+    if (!offset1) {
+        return 0;
+    }
+
+    memory_data = get_memory_data_reg(cc->jit_frame, 0);
+
+    switch (shape) {
+        case JIT_V128_I8X16:
+            value = jit_cc_new_reg_I32(cc);
+            GEN_INSN(LDU8, value, memory_data, offset1);
+            break;
+        case JIT_V128_I16X8:
+            value = jit_cc_new_reg_I32(cc);
+            GEN_INSN(LDU16, value, memory_data, offset1);
+            break;
+        case JIT_V128_I32X4:
+            value = jit_cc_new_reg_I32(cc);
+            GEN_INSN(LDI32, value, memory_data, offset1);
+            break;
+        case JIT_V128_I64X2:
+            value = jit_cc_new_reg_I64(cc);
+            GEN_INSN(LDI64, value, memory_data, offset1);
+            break;
+        default:
+            bh_assert(0);
+            return 0;
+    }
+
+    return value;
+}
+
+bool
+jit_compile_op_v128_load_extend(JitCompContext *cc, uint32 align,
+                                uint32 offset, bool is_signed,
+                                JitV128Shape src_shape)
+{
+    JitReg addr, value, vec, res;
+
+    POP_I32(addr);
+
+    /* Load the eight bytes into the low half, then widen them */
+    if (!(value = gen_load_lane_value(cc, addr, offset, JIT_V128_I64X2))) {
+        goto fail;
+    }
+
+    vec = jit_cc_new_reg_V128(cc);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VSPLAT, vec, value, NEW_CONST(I32, JIT_V128_I64X2));
+    if (is_signed)
+        GEN_INSN(VEXTENDLOWS, res, vec, NEW_CONST(I32, src_shape));
+    else
+        GEN_INSN(VEXTENDLOWU, res, vec, NEW_CONST(I32, src_shape));
+
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_op_v128_load_splat(JitCompContext *cc, uint32 align, uint32 offset,
+                               JitV128Shape shape)
+{
+    JitReg addr, value, res;
+
+    POP_I32(addr);
+
+    if (!(value = gen_load_lane_value(cc, addr, offset, shape))) {
+        goto fail;
+    }
+
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VSPLAT, res, value, NEW_CONST(I32, shape));
+
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_op_v128_load_zero(JitCompContext *cc, uint32 align, uint32 offset,
+                              JitV128Shape shape)
+{
+    JitReg addr, value, res;
+    V128 zero = { 0 };
+
+    POP_I32(addr);
+
+    if (!(value = gen_load_lane_value(cc, addr, offset, shape))) {
+        goto fail;
+    }
+
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VREPLACE, res, NEW_CONST(V128, zero), value, NEW_CONST(I32, 0),
+             NEW_CONST(I32, shape));
+
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_op_v128_load_lane(JitCompContext *cc, uint32 align, uint32 offset,
+                              JitV128Shape shape, uint8 lane_id)
+{
+    JitReg addr, vec, value, res;
+
+    POP_V128(vec);
+    POP_I32(addr);
+
+    if (!(value = gen_load_lane_value(cc, addr, offset, shape))) {
+        goto fail;
+    }
+
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VREPLACE, res, vec, value, NEW_CONST(I32, lane_id),
+             NEW_CONST(I32, shape));
+
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_op_v128_store_lane(JitCompContext *cc, uint32 align, uint32 offset,
+                               JitV128Shape shape, uint8 lane_id)
+{
+    JitReg addr, vec, value, offset1, memory_data;
+    uint32 bytes = 1 << shape;
+
+    POP_V128(vec);
+    POP_I32(addr);
+
+    offset1 = check_and_seek(cc, addr, offset, bytes);
+    if (!offset1) {
+        goto fail;
+    }
+
+    memory_data = get_memory_data_reg(cc->jit_frame, 0);
+
+    value = shape == JIT_V128_I64X2 ? jit_cc_new_reg_I64(cc)
+                                    : jit_cc_new_reg_I32(cc);
+    GEN_INSN(VEXTRACTU, value, vec, NEW_CONST(I32, lane_id),
+             NEW_CONST(I32, shape));
+
+    switch (shape) {
+        case JIT_V128_I8X16:
+            GEN_INSN(STI8, value, memory_data, offset1);
+            break;
+        case JIT_V128_I16X8:
+            GEN_INSN(STI16, value, memory_data, offset1);
+            break;
+        case JIT_V128_I32X4:
+            GEN_INSN(STI32, value, memory_data, offset1);
+            break;
+        case JIT_V128_I64X2:
+            GEN_INSN(STI64, value, memory_data, offset1);
+            break;
+        default:
+            bh_assert(0);
+            goto fail;
+    }
+
+    return true;
+fail:
+    return false;
+}
+#endif /* end of WASM_ENABLE_SIMD != 0 */
+
 bool
 jit_compile_op_memory_size(JitCompContext *cc, uint32 mem_idx)
 {
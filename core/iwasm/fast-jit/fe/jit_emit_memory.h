@@ -43,6 +43,35 @@ jit_compile_op_f32_store(JitCompContext *cc, uint32 align, uint32 offset);
 bool
 jit_compile_op_f64_store(JitCompContext *cc, uint32 align, uint32 offset);
 
+#if WASM_ENABLE_SIMD != 0
+bool
+jit_compile_op_v128_load(JitCompContext *cc, uint32 align, uint32 offset);
+
+bool
+jit_compile_op_v128_store(JitCompContext *cc, uint32 align, uint32 offset);
+
+bool
+jit_compile_op_v128_load_extend(JitCompContext *cc, uint32 align,
+                                uint32 offset, bool is_signed,
+                                JitV128Shape src_shape);
+
+bool
+jit_compile_op_v128_load_splat(JitCompContext *cc, uint32 align, uint32 offset,
+                               JitV128Shape shape);
+
+bool
+jit_compile_op_v128_load_zero(JitCompContext *cc, uint32 align, uint32 offset,
+                              JitV128Shape shape);
+
+bool
+jit_compile_op_v128_load_lane(JitCompContext *cc, uint32 align, uint32 offset,
+                              JitV128Shape shape, uint8 lane_id);
+
+bool
+jit_compile_op_v128_store_lane(JitCompContext *cc, uint32 align, uint32 offset,
+                               JitV128Shape shape, uint8 lane_id);
+#endif
+
 bool
 jit_compile_op_memory_size(JitCompContext *cc, uint32 mem_idx);
 
@@ -0,0 +1,698 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "jit_emit_simd.h"
+#include "../jit_frontend.h"
+
+#if WASM_ENABLE_SIMD != 0
+
+/* Generate a SIMD instruction whose opcode is only known at runtime */
+#define GEN_INSN_OP(N, opcode, ...)                  \
+    _gen_insn(cc, _jit_cc_set_insn_uid_for_new_insn( \
+                      cc, _jit_insn_new_Reg_##N(opcode, __VA_ARGS__)))
+
+#define SHAPE(shape) NEW_CONST(I32, shape)
+
+static JitReg
+simd_gen_unary(JitCompContext *cc, JitOpcode opcode, JitReg v,
+               JitV128Shape shape)
+{
+    JitReg res = jit_cc_new_reg_V128(cc);
+
+    GEN_INSN_OP(3, opcode, res, v, SHAPE(shape));
+    return res;
+}
+
+static JitReg
+simd_gen_binary(JitCompContext *cc, JitOpcode opcode, JitReg lhs, JitReg rhs,
+                JitV128Shape shape)
+{
+    JitReg res = jit_cc_new_reg_V128(cc);
+
+    GEN_INSN_OP(4, opcode, res, lhs, rhs, SHAPE(shape));
+    return res;
+}
+
+static bool
+simd_unary(JitCompContext *cc, JitOpcode opcode, JitV128Shape shape)
+{
+    JitReg v, res;
+
+    POP_V128(v);
+    res = simd_gen_unary(cc, opcode, v, shape);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+static bool
+simd_binary(JitCompContext *cc, JitOpcode opcode, JitV128Shape shape)
+{
+    JitReg lhs, rhs, res;
+
+    POP_V128(rhs);
+    POP_V128(lhs);
+    res = simd_gen_binary(cc, opcode, lhs, rhs, shape);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+static uint8
+simd_scalar_type(JitV128Shape shape)
+{
+    switch (shape) {
+        case JIT_V128_I64X2:
+            return VALUE_TYPE_I64;
+        case JIT_V128_F32X4:
+            return VALUE_TYPE_F32;
+        case JIT_V128_F64X2:
+            return VALUE_TYPE_F64;
+        default:
+            /* i8 and i16 lanes are carried in an i32 */
+            return VALUE_TYPE_I32;
+    }
+}
+
+static JitReg
+simd_new_scalar_reg(JitCompContext *cc, uint8 type)
+{
+    switch (type) {
+        case VALUE_TYPE_I64:
+            return jit_cc_new_reg_I64(cc);
+        case VALUE_TYPE_F32:
+            return jit_cc_new_reg_F32(cc);
+        case VALUE_TYPE_F64:
+            return jit_cc_new_reg_F64(cc);
+        default:
+            return jit_cc_new_reg_I32(cc);
+    }
+}
+
+bool
+jit_compile_simd_v128_const(JitCompContext *cc, const uint8 *imm_bytes)
+{
+    V128 v;
+
+    bh_memcpy_s(&v, sizeof(V128), imm_bytes, sizeof(V128));
+    PUSH_V128(NEW_CONST(V128, v));
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_splat(JitCompContext *cc, JitV128Shape shape)
+{
+    uint8 type = simd_scalar_type(shape);
+    JitReg value, res;
+
+    POP(value, type);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VSPLAT, res, value, SHAPE(shape));
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_extract_lane(JitCompContext *cc, JitV128Shape shape,
+                              uint8 lane_id, bool is_signed)
+{
+    uint8 type = simd_scalar_type(shape);
+    JitReg v, res;
+
+    POP_V128(v);
+    res = simd_new_scalar_reg(cc, type);
+    if (is_signed)
+        GEN_INSN(VEXTRACTS, res, v, NEW_CONST(I32, lane_id), SHAPE(shape));
+    else
+        GEN_INSN(VEXTRACTU, res, v, NEW_CONST(I32, lane_id), SHAPE(shape));
+    PUSH(res, type);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_replace_lane(JitCompContext *cc, JitV128Shape shape,
+                              uint8 lane_id)
+{
+    uint8 type = simd_scalar_type(shape);
+    JitReg v, value, res;
+
+    POP(value, type);
+    POP_V128(v);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VREPLACE, res, v, value, NEW_CONST(I32, lane_id), SHAPE(shape));
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_shuffle(JitCompContext *cc, const uint8 *lanes)
+{
+    JitReg lhs, rhs, res;
+    V128 mask;
+
+    bh_memcpy_s(&mask, sizeof(V128), lanes, sizeof(V128));
+
+    POP_V128(rhs);
+    POP_V128(lhs);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VSHUFFLE, res, lhs, rhs, NEW_CONST(V128, mask));
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_swizzle(JitCompContext *cc)
+{
+    JitReg v, idx, res;
+
+    POP_V128(idx);
+    POP_V128(v);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VSWIZZLE, res, v, idx);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_int_compare(JitCompContext *cc, IntCond cond,
+                             JitV128Shape shape)
+{
+    JitOpcode opcode;
+
+    switch (cond) {
+        case INT_EQ:
+            opcode = JIT_OP_VCMPEQ;
+            break;
+        case INT_NE:
+            opcode = JIT_OP_VCMPNE;
+            break;
+        case INT_LT_S:
+            opcode = JIT_OP_VCMPLTS;
+            break;
+        case INT_LT_U:
+            opcode = JIT_OP_VCMPLTU;
+            break;
+        case INT_GT_S:
+            opcode = JIT_OP_VCMPGTS;
+            break;
+        case INT_GT_U:
+            opcode = JIT_OP_VCMPGTU;
+            break;
+        case INT_LE_S:
+            opcode = JIT_OP_VCMPLES;
+            break;
+        case INT_LE_U:
+            opcode = JIT_OP_VCMPLEU;
+            break;
+        case INT_GE_S:
+            opcode = JIT_OP_VCMPGES;
+            break;
+        case INT_GE_U:
+            opcode = JIT_OP_VCMPGEU;
+            break;
+        default:
+            bh_assert(0);
+            return false;
+    }
+
+    return simd_binary(cc, opcode, shape);
+}
+
+bool
+jit_compile_simd_float_compare(JitCompContext *cc, FloatCond cond,
+                               JitV128Shape shape)
+{
+    JitOpcode opcode;
+
+    /* The codegen treats the signed variants as ordered float compares */
+    switch (cond) {
+        case FLOAT_EQ:
+            opcode = JIT_OP_VCMPEQ;
+            break;
+        case FLOAT_NE:
+            opcode = JIT_OP_VCMPNE;
+            break;
+        case FLOAT_LT:
+            opcode = JIT_OP_VCMPLTS;
+            break;
+        case FLOAT_GT:
+            opcode = JIT_OP_VCMPGTS;
+            break;
+        case FLOAT_LE:
+            opcode = JIT_OP_VCMPLES;
+            break;
+        case FLOAT_GE:
+            opcode = JIT_OP_VCMPGES;
+            break;
+        default:
+            bh_assert(0);
+            return false;
+    }
+
+    return simd_binary(cc, opcode, shape);
+}
+
+bool
+jit_compile_simd_v128_bitwise(JitCompContext *cc, V128Bitwise op)
+{
+    JitReg v1, v2, c, tmp1, tmp2, res;
+
+    if (op == V128_NOT) {
+        POP_V128(v1);
+        res = jit_cc_new_reg_V128(cc);
+        GEN_INSN(NOT, res, v1);
+        PUSH_V128(res);
+        return true;
+    }
+
+    if (op == V128_BITSELECT) {
+        /* v2 ^ ((v1 ^ v2) & c) */
+        POP_V128(c);
+        POP_V128(v2);
+        POP_V128(v1);
+        tmp1 = jit_cc_new_reg_V128(cc);
+        tmp2 = jit_cc_new_reg_V128(cc);
+        res = jit_cc_new_reg_V128(cc);
+        GEN_INSN(XOR, tmp1, v1, v2);
+        GEN_INSN(AND, tmp2, tmp1, c);
+        GEN_INSN(XOR, res, v2, tmp2);
+        PUSH_V128(res);
+        return true;
+    }
+
+    POP_V128(v2);
+    POP_V128(v1);
+    res = jit_cc_new_reg_V128(cc);
+
+    switch (op) {
+        case V128_AND:
+            GEN_INSN(AND, res, v1, v2);
+            break;
+        case V128_ANDNOT:
+            tmp1 = jit_cc_new_reg_V128(cc);
+            GEN_INSN(NOT, tmp1, v2);
+            GEN_INSN(AND, res, v1, tmp1);
+            break;
+        case V128_OR:
+            GEN_INSN(OR, res, v1, v2);
+            break;
+        case V128_XOR:
+            GEN_INSN(XOR, res, v1, v2);
+            break;
+        default:
+            bh_assert(0);
+            goto fail;
+    }
+
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_any_true(JitCompContext *cc)
+{
+    JitReg v, res;
+
+    POP_V128(v);
+    res = jit_cc_new_reg_I32(cc);
+    GEN_INSN(VANYTRUE, res, v);
+    PUSH_I32(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_all_true(JitCompContext *cc, JitV128Shape shape)
+{
+    JitReg v, res;
+
+    POP_V128(v);
+    res = jit_cc_new_reg_I32(cc);
+    GEN_INSN(VALLTRUE, res, v, SHAPE(shape));
+    PUSH_I32(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_bitmask(JitCompContext *cc, JitV128Shape shape)
+{
+    JitReg v, res;
+
+    POP_V128(v);
+    res = jit_cc_new_reg_I32(cc);
+    GEN_INSN(VBITMASK, res, v, SHAPE(shape));
+    PUSH_I32(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_int_arith(JitCompContext *cc, V128Arithmetic op,
+                           JitV128Shape shape)
+{
+    switch (op) {
+        case V128_ADD:
+            return simd_binary(cc, JIT_OP_VADD, shape);
+        case V128_SUB:
+            return simd_binary(cc, JIT_OP_VSUB, shape);
+        case V128_MUL:
+            return simd_binary(cc, JIT_OP_VMUL, shape);
+        case V128_NEG:
+            return simd_unary(cc, JIT_OP_VNEG, shape);
+        default:
+            bh_assert(0);
+            return false;
+    }
+}
+
+bool
+jit_compile_simd_int_abs(JitCompContext *cc, JitV128Shape shape)
+{
+    return simd_unary(cc, JIT_OP_VABS, shape);
+}
+
+bool
+jit_compile_simd_int_sat_arith(JitCompContext *cc, V128Arithmetic op,
+                               bool is_signed, JitV128Shape shape)
+{
+    JitOpcode opcode;
+
+    if (op == V128_ADD)
+        opcode = is_signed ? JIT_OP_VADDSATS : JIT_OP_VADDSATU;
+    else
+        opcode = is_signed ? JIT_OP_VSUBSATS : JIT_OP_VSUBSATU;
+
+    return simd_binary(cc, opcode, shape);
+}
+
+bool
+jit_compile_simd_int_min_max(JitCompContext *cc, bool is_min, bool is_signed,
+                             JitV128Shape shape)
+{
+    JitOpcode opcode;
+
+    if (is_min)
+        opcode = is_signed ? JIT_OP_VMINS : JIT_OP_VMINU;
+    else
+        opcode = is_signed ? JIT_OP_VMAXS : JIT_OP_VMAXU;
+
+    return simd_binary(cc, opcode, shape);
+}
+
+bool
+jit_compile_simd_int_avgr_u(JitCompContext *cc, JitV128Shape shape)
+{
+    return simd_binary(cc, JIT_OP_VAVGRU, shape);
+}
+
+bool
+jit_compile_simd_shift(JitCompContext *cc, IntShift op, JitV128Shape shape)
+{
+    JitReg v, count, count1, res;
+    JitOpcode opcode;
+    /* lane width in bits is 8 << shape for the integer shapes */
+    int32 mask = (8 << shape) - 1;
+
+    switch (op) {
+        case INT_SHL:
+            opcode = JIT_OP_VSHL;
+            break;
+        case INT_SHR_S:
+            opcode = JIT_OP_VSHRS;
+            break;
+        case INT_SHR_U:
+            opcode = JIT_OP_VSHRU;
+            break;
+        default:
+            bh_assert(0);
+            return false;
+    }
+
+    POP_I32(count);
+    POP_V128(v);
+
+    /* The shift count is taken modulo the lane width */
+    if (jit_reg_is_const(count)) {
+        count1 = NEW_CONST(I32, jit_cc_get_const_I32(cc, count) & mask);
+    }
+    else {
+        count1 = jit_cc_new_reg_I32(cc);
+        GEN_INSN(AND, count1, count, NEW_CONST(I32, mask));
+    }
+
+    res = simd_gen_binary(cc, opcode, v, count1, shape);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_float_arith(JitCompContext *cc, V128Arithmetic op,
+                             JitV128Shape shape)
+{
+    switch (op) {
+        case V128_ADD:
+            return simd_binary(cc, JIT_OP_VADD, shape);
+        case V128_SUB:
+            return simd_binary(cc, JIT_OP_VSUB, shape);
+        case V128_MUL:
+            return simd_binary(cc, JIT_OP_VMUL, shape);
+        case V128_DIV:
+            return simd_binary(cc, JIT_OP_VDIV, shape);
+        case V128_MIN:
+            return simd_binary(cc, JIT_OP_VMINS, shape);
+        case V128_MAX:
+            return simd_binary(cc, JIT_OP_VMAXS, shape);
+        case V128_NEG:
+            return simd_unary(cc, JIT_OP_VNEG, shape);
+        default:
+            bh_assert(0);
+            return false;
+    }
+}
+
+bool
+jit_compile_simd_float_math(JitCompContext *cc, FloatMath op,
+                            JitV128Shape shape)
+{
+    JitReg v, res;
+    int32 mode;
+
+    switch (op) {
+        case FLOAT_ABS:
+            return simd_unary(cc, JIT_OP_VABS, shape);
+        case FLOAT_NEG:
+            return simd_unary(cc, JIT_OP_VNEG, shape);
+        case FLOAT_SQRT:
+            return simd_unary(cc, JIT_OP_VSQRT, shape);
+        case FLOAT_NEAREST:
+            mode = 0;
+            break;
+        case FLOAT_FLOOR:
+            mode = 1;
+            break;
+        case FLOAT_CEIL:
+            mode = 2;
+            break;
+        case FLOAT_TRUNC:
+            mode = 3;
+            break;
+        default:
+            bh_assert(0);
+            return false;
+    }
+
+    POP_V128(v);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VROUND, res, v, NEW_CONST(I32, mode), SHAPE(shape));
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_float_pmin_pmax(JitCompContext *cc, bool is_min,
+                                 JitV128Shape shape)
+{
+    return simd_binary(cc, is_min ? JIT_OP_VPMIN : JIT_OP_VPMAX, shape);
+}
+
+static JitOpcode
+simd_extend_opcode(bool is_low, bool is_signed)
+{
+    if (is_low)
+        return is_signed ? JIT_OP_VEXTENDLOWS : JIT_OP_VEXTENDLOWU;
+    return is_signed ? JIT_OP_VEXTENDHIGHS : JIT_OP_VEXTENDHIGHU;
+}
+
+bool
+jit_compile_simd_extend(JitCompContext *cc, bool is_low, bool is_signed,
+                        JitV128Shape src_shape)
+{
+    return simd_unary(cc, simd_extend_opcode(is_low, is_signed), src_shape);
+}
+
+bool
+jit_compile_simd_extmul(JitCompContext *cc, bool is_low, bool is_signed,
+                        JitV128Shape src_shape)
+{
+    JitOpcode opcode = simd_extend_opcode(is_low, is_signed);
+    JitReg lhs, rhs, lhs1, rhs1, res;
+
+    POP_V128(rhs);
+    POP_V128(lhs);
+    lhs1 = simd_gen_unary(cc, opcode, lhs, src_shape);
+    rhs1 = simd_gen_unary(cc, opcode, rhs, src_shape);
+    res = simd_gen_binary(cc, JIT_OP_VMUL, lhs1, rhs1, src_shape + 1);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_extadd_pairwise(JitCompContext *cc, bool is_signed,
+                                 JitV128Shape src_shape)
+{
+    JitV128Shape dst_shape = src_shape + 1;
+    JitOpcode shr = is_signed ? JIT_OP_VSHRS : JIT_OP_VSHRU;
+    JitReg half = NEW_CONST(I32, 8 << src_shape);
+    JitReg v, even, odd, res;
+
+    POP_V128(v);
+    /* Sign or zero extend the even lanes in place, then shift the odd
+       lanes down, and add the two halves lane by lane */
+    even = simd_gen_binary(cc, JIT_OP_VSHL, v, half, dst_shape);
+    even = simd_gen_binary(cc, shr, even, half, dst_shape);
+    odd = simd_gen_binary(cc, shr, v, half, dst_shape);
+    res = simd_gen_binary(cc, JIT_OP_VADD, even, odd, dst_shape);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_narrow(JitCompContext *cc, bool is_signed,
+                        JitV128Shape src_shape)
+{
+    return simd_binary(cc, is_signed ? JIT_OP_VNARROWS : JIT_OP_VNARROWU,
+                       src_shape);
+}
+
+bool
+jit_compile_simd_i32x4_dot_i16x8(JitCompContext *cc)
+{
+    JitReg lhs, rhs, res;
+
+    POP_V128(rhs);
+    POP_V128(lhs);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VDOT, res, lhs, rhs);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_i16x8_q15mulr_sat(JitCompContext *cc)
+{
+    JitReg lhs, rhs, res;
+
+    POP_V128(rhs);
+    POP_V128(lhs);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN(VQ15MULR, res, lhs, rhs);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+static bool
+simd_convert(JitCompContext *cc, JitOpcode opcode)
+{
+    JitReg v, res;
+
+    POP_V128(v);
+    res = jit_cc_new_reg_V128(cc);
+    GEN_INSN_OP(2, opcode, res, v);
+    PUSH_V128(res);
+    return true;
+fail:
+    return false;
+}
+
+bool
+jit_compile_simd_i8x16_popcnt(JitCompContext *cc)
+{
+    return simd_convert(cc, JIT_OP_VPOPCNT);
+}
+
+bool
+jit_compile_simd_f32x4_convert_i32x4(JitCompContext *cc, bool is_signed)
+{
+    return simd_convert(cc, is_signed ? JIT_OP_VI32X4TOF32X4
+                                      : JIT_OP_VU32X4TOF32X4);
+}
+
+bool
+jit_compile_simd_i32x4_trunc_sat_f32x4(JitCompContext *cc, bool is_signed)
+{
+    return simd_convert(cc, is_signed ? JIT_OP_VF32X4TOI32X4
+                                      : JIT_OP_VF32X4TOU32X4);
+}
+
+bool
+jit_compile_simd_i32x4_trunc_sat_f64x2_zero(JitCompContext *cc,
+                                            bool is_signed)
+{
+    return simd_convert(cc, is_signed ? JIT_OP_VF64X2TOI32X4
+                                      : JIT_OP_VF64X2TOU32X4);
+}
+
+bool
+jit_compile_simd_f64x2_convert_low_i32x4(JitCompContext *cc, bool is_signed)
+{
+    return simd_convert(cc, is_signed ? JIT_OP_VI32X4TOF64X2
+                                      : JIT_OP_VU32X4TOF64X2);
+}
+
+bool
+jit_compile_simd_f32x4_demote_f64x2(JitCompContext *cc)
+{
+    return simd_convert(cc, JIT_OP_VF64X2TOF32X4);
+}
+
+bool
+jit_compile_simd_f64x2_promote_f32x4(JitCompContext *cc)
+{
+    return simd_convert(cc, JIT_OP_VF32X4TOF64X2);
+}
+
+#endif /* end of WASM_ENABLE_SIMD != 0 */
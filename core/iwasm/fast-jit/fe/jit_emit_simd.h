@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _JIT_EMIT_SIMD_H_
+#define _JIT_EMIT_SIMD_H_
+
+#include "../jit_compiler.h"
+#include "../jit_frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_SIMD != 0
+bool
+jit_compile_simd_v128_const(JitCompContext *cc, const uint8 *imm_bytes);
+
+bool
+jit_compile_simd_splat(JitCompContext *cc, JitV128Shape shape);
+
+bool
+jit_compile_simd_extract_lane(JitCompContext *cc, JitV128Shape shape,
+                              uint8 lane_id, bool is_signed);
+
+bool
+jit_compile_simd_replace_lane(JitCompContext *cc, JitV128Shape shape,
+                              uint8 lane_id);
+
+bool
+jit_compile_simd_shuffle(JitCompContext *cc, const uint8 *lanes);
+
+bool
+jit_compile_simd_swizzle(JitCompContext *cc);
+
+bool
+jit_compile_simd_int_compare(JitCompContext *cc, IntCond cond,
+                             JitV128Shape shape);
+
+bool
+jit_compile_simd_float_compare(JitCompContext *cc, FloatCond cond,
+                               JitV128Shape shape);
+
+bool
+jit_compile_simd_v128_bitwise(JitCompContext *cc, V128Bitwise op);
+
+bool
+jit_compile_simd_any_true(JitCompContext *cc);
+
+bool
+jit_compile_simd_all_true(JitCompContext *cc, JitV128Shape shape);
+
+bool
+jit_compile_simd_bitmask(JitCompContext *cc, JitV128Shape shape);
+
+bool
+jit_compile_simd_int_arith(JitCompContext *cc, V128Arithmetic op,
+                           JitV128Shape shape);
+
+bool
+jit_compile_simd_int_abs(JitCompContext *cc, JitV128Shape shape);
+
+bool
+jit_compile_simd_int_sat_arith(JitCompContext *cc, V128Arithmetic op,
+                               bool is_signed, JitV128Shape shape);
+
+bool
+jit_compile_simd_int_min_max(JitCompContext *cc, bool is_min, bool is_signed,
+                             JitV128Shape shape);
+
+bool
+jit_compile_simd_int_avgr_u(JitCompContext *cc, JitV128Shape shape);
+
+bool
+jit_compile_simd_shift(JitCompContext *cc, IntShift op, JitV128Shape shape);
+
+bool
+jit_compile_simd_float_arith(JitCompContext *cc, V128Arithmetic op,
+                             JitV128Shape shape);
+
+bool
+jit_compile_simd_float_math(JitCompContext *cc, FloatMath op,
+                            JitV128Shape shape);
+
+bool
+jit_compile_simd_float_pmin_pmax(JitCompContext *cc, bool is_min,
+                                 JitV128Shape shape);
+
+bool
+jit_compile_simd_extend(JitCompContext *cc, bool is_low, bool is_signed,
+                        JitV128Shape src_shape);
+
+bool
+jit_compile_simd_extmul(JitCompContext *cc, bool is_low, bool is_signed,
+                        JitV128Shape src_shape);
+
+bool
+jit_compile_simd_extadd_pairwise(JitCompContext *cc, bool is_signed,
+                                 JitV128Shape src_shape);
+
+bool
+jit_compile_simd_narrow(JitCompContext *cc, bool is_signed,
+                        JitV128Shape src_shape);
+
+bool
+jit_compile_simd_i32x4_dot_i16x8(JitCompContext *cc);
+
+bool
+jit_compile_simd_i16x8_q15mulr_sat(JitCompContext *cc);
+
+bool
+jit_compile_simd_i8x16_popcnt(JitCompContext *cc);
+
+bool
+jit_compile_simd_f32x4_convert_i32x4(JitCompContext *cc, bool is_signed);
+
+bool
+jit_compile_simd_i32x4_trunc_sat_f32x4(JitCompContext *cc, bool is_signed);
+
+bool
+jit_compile_simd_i32x4_trunc_sat_f64x2_zero(JitCompContext *cc,
+                                            bool is_signed);
+
+bool
+jit_compile_simd_f64x2_convert_low_i32x4(JitCompContext *cc, bool is_signed);
+
+bool
+jit_compile_simd_f32x4_demote_f64x2(JitCompContext *cc);
+
+bool
+jit_compile_simd_f64x2_promote_f32x4(JitCompContext *cc);
+#endif
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif /* end of _JIT_EMIT_SIMD_H_ */
@@ -7,50 +7,362 @@
 #include "mem_alloc.h"
 #include "jit_compiler.h"
 
-static void *code_cache_pool = NULL;
-static uint32 code_cache_pool_size = 0;
-static mem_allocator_t code_cache_pool_allocator = NULL;
+/**
+ * A chunk of the code cache, the code cache is made of chunks which are
+ * mapped on demand, a chunk is unmapped after all the code allocated from
+ * it is freed, except the first chunk.
+ *
+ * The code of the functions of a module is only allocated from the chunks
+ * owned by the module, so the chunks are unmapped when the module is
+ * unloaded, and the code left by other modules doesn't pin them. The code
+ * shared by the modules, e.g. the stubs of the codegen, is allocated from
+ * the chunks without owner, which include the first chunk.
+ *
+ * If the platform supports it, the pages of a chunk are mapped twice: the
+ * code is written through the writable mapping and run through the
+ * executable mapping, so no page is writable and executable at the same
+ * time. Otherwise the chunk is mapped readable, writable and executable.
+ */
+typedef struct JitCodeCacheChunk {
+    struct JitCodeCacheChunk *next;
+    /* the module which owns the chunk, NULL for the shared code */
+    const void *owner;
+    /* the executable mapping, the code address is in it */
+    uint8 *code_base;
+    /* the writable mapping, in which the allocator is created, it is
+       the same as code_base if the chunk isn't dual mapped */
+    uint8 *write_base;
+    uint32 size;
+    /* the free size of the allocator when nothing is allocated */
+    uint32 empty_free_size;
+    mem_allocator_t allocator;
+} JitCodeCacheChunk;
 
-bool
-jit_code_cache_init(uint32 code_cache_size)
+/* The size of the first chunk of an owner, the later chunks double the
+   code cache of the owner until the size reaches code_cache_chunk_size */
+#define CODE_CACHE_MIN_CHUNK_SIZE (64 * 1024)
+
+static JitCodeCacheChunk *code_cache_chunks = NULL;
+/* the max size of a chunk, unless a code is larger */
+static uint32 code_cache_chunk_size = 0;
+/* the total size of the chunks and its limit */
+static uint64 code_cache_total_size = 0;
+static uint64 code_cache_max_size = 0;
+static korp_mutex code_cache_lock;
+
+static bool
+map_chunk(JitCodeCacheChunk *chunk)
 {
-    int map_prot = MMAP_PROT_READ | MMAP_PROT_WRITE | MMAP_PROT_EXEC;
-    int map_flags = MMAP_MAP_NONE;
+#ifdef OS_ENABLE_MEMFD
+    os_file_handle handle;
+
+    if (os_memfd_create(NULL, chunk->size, &handle) == 0) {
+        chunk->write_base = os_memfd_map_shared(
+            chunk->size, MMAP_PROT_READ | MMAP_PROT_WRITE, handle);
+        chunk->code_base = os_memfd_map_shared(
+            chunk->size, MMAP_PROT_READ | MMAP_PROT_EXEC, handle);
+        os_memfd_close(handle);
+
+        if (chunk->write_base && chunk->code_base)
+            return true;
 
-    if (!(code_cache_pool = os_mmap(NULL, code_cache_size, map_prot, map_flags,
-                                    os_get_invalid_handle()))) {
+        if (chunk->write_base)
+            os_munmap(chunk->write_base, chunk->size);
+        if (chunk->code_base)
+            os_munmap(chunk->code_base, chunk->size);
+    }
+#endif
+
+    /* Fall back to a single mapping */
+    if (!(chunk->code_base = os_mmap(
+              NULL, chunk->size,
+              MMAP_PROT_READ | MMAP_PROT_WRITE | MMAP_PROT_EXEC, MMAP_MAP_NONE,
+              os_get_invalid_handle()))) {
         return false;
     }
+    chunk->write_base = chunk->code_base;
+    return true;
+}
+
+static void
+unmap_chunk(JitCodeCacheChunk *chunk)
+{
+    if (chunk->write_base != chunk->code_base)
+        os_munmap(chunk->write_base, chunk->size);
+    os_munmap(chunk->code_base, chunk->size);
+}
+
+static JitCodeCacheChunk *
+create_chunk(const void *owner, uint32 size)
+{
+    JitCodeCacheChunk *chunk;
+    uint32 info[3];
+
+    if (!(chunk = jit_calloc(sizeof(JitCodeCacheChunk))))
+        return NULL;
+
+    chunk->owner = owner;
+    chunk->size = size;
+    if (!map_chunk(chunk)) {
+        jit_free(chunk);
+        return NULL;
+    }
+
+    if (!(chunk->allocator = mem_allocator_create(chunk->write_base, size))) {
+        unmap_chunk(chunk);
+        jit_free(chunk);
+        return NULL;
+    }
+
+    mem_allocator_get_alloc_info(chunk->allocator, info);
+    chunk->empty_free_size = info[1];
+    code_cache_total_size += size;
+    return chunk;
+}
 
-    if (!(code_cache_pool_allocator =
-              mem_allocator_create(code_cache_pool, code_cache_size))) {
-        os_munmap(code_cache_pool, code_cache_size);
-        code_cache_pool = NULL;
+static void
+destroy_chunk(JitCodeCacheChunk *chunk)
+{
+    code_cache_total_size -= chunk->size;
+    mem_allocator_destroy(chunk->allocator);
+    unmap_chunk(chunk);
+    jit_free(chunk);
+}
+
+/* Get the chunk which the code belongs to, code_cache_lock is held */
+static JitCodeCacheChunk *
+find_chunk(const void *code)
+{
+    JitCodeCacheChunk *chunk = code_cache_chunks;
+
+    while (chunk) {
+        if ((uint8 *)code >= chunk->code_base
+            && (uint8 *)code < chunk->code_base + chunk->size)
+            return chunk;
+        chunk = chunk->next;
+    }
+    return NULL;
+}
+
+/**
+ * Get the size of the new chunk to allocate the code of the owner,
+ * code_cache_lock is held, return 0 if the code cache is full
+ */
+static uint64
+get_new_chunk_size(const void *owner, uint32 size)
+{
+    JitCodeCacheChunk *chunk;
+    uint32 page_size = os_getpagesize();
+    uint64 owner_size = 0, min_size, chunk_size, remaining_size;
+
+    for (chunk = code_cache_chunks; chunk; chunk = chunk->next) {
+        if (chunk->owner == owner)
+            owner_size += chunk->size;
+    }
+
+    /* Large enough for the code and the allocator's own data */
+    min_size = align_uint64((uint64)size + mem_allocator_get_heap_struct_size()
+                                + page_size,
+                            page_size);
+
+    /* Double the code cache of the owner */
+    chunk_size = owner_size > CODE_CACHE_MIN_CHUNK_SIZE
+                     ? owner_size
+                     : CODE_CACHE_MIN_CHUNK_SIZE;
+    if (chunk_size > code_cache_chunk_size)
+        chunk_size = code_cache_chunk_size;
+    if (chunk_size < min_size)
+        chunk_size = min_size;
+
+    /* Take what is left if the chunk exceeds the limit */
+    remaining_size = code_cache_max_size > code_cache_total_size
+                         ? code_cache_max_size - code_cache_total_size
+                         : 0;
+    remaining_size = remaining_size / page_size * page_size;
+    if (chunk_size > remaining_size)
+        chunk_size = remaining_size;
+
+    return chunk_size >= min_size && chunk_size <= UINT32_MAX ? chunk_size
+                                                              : 0;
+}
+
+bool
+jit_code_cache_init(uint32 chunk_size, uint32 max_size)
+{
+    uint32 page_size = os_getpagesize();
+    uint32 first_chunk_size;
+
+    if (os_mutex_init(&code_cache_lock) != 0)
+        return false;
+
+    code_cache_chunk_size = align_uint(chunk_size, page_size);
+    code_cache_max_size = max_size > chunk_size
+                              ? align_uint64(max_size, page_size)
+                              : code_cache_chunk_size;
+    code_cache_total_size = 0;
+
+    /* The first chunk is only for the shared code */
+    first_chunk_size = code_cache_chunk_size < CODE_CACHE_MIN_CHUNK_SIZE
+                           ? code_cache_chunk_size
+                           : CODE_CACHE_MIN_CHUNK_SIZE;
+    if (!(code_cache_chunks = create_chunk(NULL, first_chunk_size))) {
+        os_mutex_destroy(&code_cache_lock);
         return false;
     }
 
-    code_cache_pool_size = code_cache_size;
     return true;
 }
 
 void
 jit_code_cache_destroy()
 {
-    mem_allocator_destroy(code_cache_pool_allocator);
-    os_munmap(code_cache_pool, code_cache_pool_size);
+    JitCodeCacheChunk *chunk = code_cache_chunks, *next;
+
+    while (chunk) {
+        next = chunk->next;
+        destroy_chunk(chunk);
+        chunk = next;
+    }
+    code_cache_chunks = NULL;
+    os_mutex_destroy(&code_cache_lock);
+}
+
+void *
+jit_code_cache_alloc_for_module(const void *module, uint32 size)
+{
+    JitCodeCacheChunk *chunk, *last = NULL;
+    uint64 chunk_size;
+    uint8 *ptr = NULL;
+
+    os_mutex_lock(&code_cache_lock);
+
+    for (chunk = code_cache_chunks; chunk; chunk = chunk->next) {
+        if (chunk->owner == module
+            && (ptr = mem_allocator_malloc(chunk->allocator, size)))
+            goto done;
+        last = chunk;
+    }
+
+    /* All the chunks of the owner are full, map a new one */
+    if (!(chunk_size = get_new_chunk_size(module, size))) {
+        /* Fall back to the first chunk, which is never unmapped, so the
+           code of the module doesn't pin it */
+        chunk = code_cache_chunks;
+        if (module && (ptr = mem_allocator_malloc(chunk->allocator, size)))
+            goto done;
+        LOG_VERBOSE("JIT: code cache is full, total size: %" PRIu64 "\n",
+                    code_cache_total_size);
+        chunk = NULL;
+        goto done;
+    }
+    if (!(chunk = create_chunk(module, (uint32)chunk_size))
+        || !(ptr = mem_allocator_malloc(chunk->allocator, size))) {
+        if (chunk)
+            destroy_chunk(chunk);
+        chunk = NULL;
+        goto done;
+    }
+
+    LOG_VERBOSE("JIT: code cache grows with chunk size: %u\n", chunk->size);
+    /* The first chunk is never NULL */
+    last->next = chunk;
+
+done:
+    os_mutex_unlock(&code_cache_lock);
+    /* Return the address in the executable mapping */
+    return ptr ? chunk->code_base + (ptr - chunk->write_base) : NULL;
 }
 
 void *
 jit_code_cache_alloc(uint32 size)
 {
-    return mem_allocator_malloc(code_cache_pool_allocator, size);
+    return jit_code_cache_alloc_for_module(NULL, size);
+}
+
+void *
+jit_code_cache_get_writable_addr(void *code)
+{
+    JitCodeCacheChunk *chunk;
+    uint8 *ptr;
+
+    os_mutex_lock(&code_cache_lock);
+    chunk = find_chunk(code);
+    bh_assert(chunk);
+    ptr = chunk->write_base + ((uint8 *)code - chunk->code_base);
+    os_mutex_unlock(&code_cache_lock);
+
+    return ptr;
+}
+
+void
+jit_code_cache_write(void *code, const void *data, uint32 size)
+{
+    void *ptr = jit_code_cache_get_writable_addr(code);
+
+    bh_memcpy_s(ptr, size, data, size);
 }
 
 void
 jit_code_cache_free(void *ptr)
 {
-    if (ptr)
-        mem_allocator_free(code_cache_pool_allocator, ptr);
+    JitCodeCacheChunk *chunk, *prev;
+    uint32 info[3];
+
+    if (!ptr)
+        return;
+
+    os_mutex_lock(&code_cache_lock);
+
+    chunk = find_chunk(ptr);
+    bh_assert(chunk);
+    mem_allocator_free(chunk->allocator,
+                       chunk->write_base + ((uint8 *)ptr - chunk->code_base));
+
+    /* Return the chunk to the system if it is empty, e.g. after the
+       module owning it is unloaded */
+    mem_allocator_get_alloc_info(chunk->allocator, info);
+    if (chunk != code_cache_chunks && info[1] == chunk->empty_free_size) {
+        prev = code_cache_chunks;
+        while (prev->next != chunk)
+            prev = prev->next;
+        prev->next = chunk->next;
+        LOG_VERBOSE("JIT: code cache releases chunk size: %u\n", chunk->size);
+        destroy_chunk(chunk);
+    }
+
+    os_mutex_unlock(&code_cache_lock);
+}
+
+bool
+jit_code_cache_get_stats(JitCodeCacheStats *stats)
+{
+    JitCodeCacheChunk *chunk;
+    uint32 info[3], largest_free_size;
+
+    /* The code cache isn't initialized */
+    if (!code_cache_chunks)
+        return false;
+
+    memset(stats, 0, sizeof(JitCodeCacheStats));
+
+    os_mutex_lock(&code_cache_lock);
+    stats->max_size = code_cache_max_size;
+    for (chunk = code_cache_chunks; chunk; chunk = chunk->next) {
+        mem_allocator_get_alloc_info(chunk->allocator, info);
+        largest_free_size =
+            mem_allocator_get_largest_free_size(chunk->allocator);
+
+        stats->chunk_count++;
+        if (chunk->owner)
+            stats->module_chunk_count++;
+        stats->total_size += chunk->size;
+        stats->used_size += chunk->empty_free_size - info[1];
+        stats->free_size += info[1];
+        if (stats->largest_free_size < largest_free_size)
+            stats->largest_free_size = largest_free_size;
+    }
+    os_mutex_unlock(&code_cache_lock);
+    return true;
 }
 
 bool
@@ -12,18 +12,96 @@
 extern "C" {
 #endif
 
+/* Statistics of the code cache */
+typedef struct JitCodeCacheStats {
+    /* number of chunks mapped */
+    uint32 chunk_count;
+    /* number of chunks owned by the modules */
+    uint32 module_chunk_count;
+    /* total size of the chunks */
+    uint64 total_size;
+    /* limit of the total size */
+    uint64 max_size;
+    /* size of the code allocated, including the allocator's overhead */
+    uint64 used_size;
+    /* size which can be allocated */
+    uint64 free_size;
+    /* size of the largest free block of all chunks, the code larger than
+       it can't be allocated without mapping a new chunk */
+    uint32 largest_free_size;
+} JitCodeCacheStats;
+
+/**
+ * Initialize the code cache, which grows by mapping new chunks when it
+ * is full and returns a chunk to the system when all its code is freed
+ *
+ * @param code_cache_size the max size of a chunk
+ * @param code_cache_max_size the max total size of the chunks, the
+ *        code cache doesn't grow beyond code_cache_size if it is 0
+ *
+ * @return true if success, false otherwise
+ */
 bool
-jit_code_cache_init(uint32 code_cache_size);
+jit_code_cache_init(uint32 code_cache_size, uint32 code_cache_max_size);
 
 void
 jit_code_cache_destroy();
 
+/**
+ * Allocate the code shared by the modules, e.g. the stubs of the codegen
+ */
 void *
 jit_code_cache_alloc(uint32 size);
 
+/**
+ * Allocate the code of a module from the chunks owned by the module,
+ * which are returned to the system when the module is unloaded
+ *
+ * @param module the module which the code belongs to
+ * @param size the size of the code
+ *
+ * @return the executable address of the code, NULL if the code cache
+ *         is full
+ */
+void *
+jit_code_cache_alloc_for_module(const void *module, uint32 size);
+
 void
 jit_code_cache_free(void *ptr);
 
+/**
+ * Get the address to write the code allocated, the code is only
+ * executable at the address returned by jit_code_cache_alloc, and
+ * only writable at the address returned by this function
+ *
+ * @param code the address returned by jit_code_cache_alloc, or an
+ *        address inside the code allocated
+ *
+ * @return the writable address of the code
+ */
+void *
+jit_code_cache_get_writable_addr(void *code);
+
+/**
+ * Copy data into the code allocated
+ *
+ * @param code the address inside the code allocated to copy to
+ * @param data the data to copy
+ * @param size the size of the data
+ */
+void
+jit_code_cache_write(void *code, const void *data, uint32 size);
+
+/**
+ * Get the statistics of the code cache
+ *
+ * @param stats the statistics returned
+ *
+ * @return true if success, false if the code cache isn't initialized
+ */
+bool
+jit_code_cache_get_stats(JitCodeCacheStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
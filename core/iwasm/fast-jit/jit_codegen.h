@@ -35,6 +35,26 @@ jit_codegen_destroy();
 const JitHardRegInfo *
 jit_codegen_get_hreg_info();
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Get hard register information of each kind for the functions using
+ * v128, in which some float registers are taken for the V128 registers.
+ *
+ * @return the JitHardRegInfo array of each kind
+ */
+const JitHardRegInfo *
+jit_codegen_get_hreg_info_simd();
+
+/**
+ * Check whether the host CPU supports the instructions which the vector
+ * instructions are lowered to.
+ *
+ * @return true if supported, false otherwise
+ */
+bool
+jit_codegen_is_simd_supported();
+#endif
+
 /**
  * Get hard register by name.
  *
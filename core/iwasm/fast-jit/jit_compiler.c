@@ -26,21 +26,54 @@ static JitCompilerPass compiler_passes[] = {
     REG_PASS(lower_cg),
     REG_PASS(regalloc),
     REG_PASS(codegen),
-    REG_PASS(register_jitted_code)
+    REG_PASS(register_jitted_code),
+    REG_PASS(propagate),
+    REG_PASS(redundancy_elim),
+    REG_PASS(dce)
 #undef REG_PASS
 };
 
 /* Number of compiler passes */
 #define COMPILER_PASS_NUM (sizeof(compiler_passes) / sizeof(compiler_passes[0]))
 
+/* Maximum optimization level, see JitCompOptions */
+#define COMPILER_OPT_LEVEL_MAX 2
+
+/* Index of the regalloc pass and the first optional optimization pass
+   in compiler_passes */
+#define COMPILER_PASS_REGALLOC 5
+#define COMPILER_PASS_OPT_BEGIN 8
+
 #if WASM_ENABLE_FAST_JIT_DUMP == 0
 static const uint8 compiler_passes_without_dump[] = {
     3, 4, 5, 6, 7, 0
 };
+static const uint8 compiler_passes_without_dump_opt1[] = {
+    3, 8, 10, 4, 5, 6, 7, 0
+};
+static const uint8 compiler_passes_without_dump_opt2[] = {
+    3, 8, 9, 8, 10, 4, 5, 6, 7, 0
+};
+static const uint8 *compiler_passes_of_opt_level[] = {
+    compiler_passes_without_dump,
+    compiler_passes_without_dump_opt1,
+    compiler_passes_without_dump_opt2
+};
 #else
 static const uint8 compiler_passes_with_dump[] = {
     3, 2, 1, 4, 1, 5, 1, 6, 1, 7, 0
 };
+static const uint8 compiler_passes_with_dump_opt1[] = {
+    3, 2, 1, 8, 10, 2, 1, 4, 1, 5, 1, 6, 1, 7, 0
+};
+static const uint8 compiler_passes_with_dump_opt2[] = {
+    3, 2, 1, 8, 9, 8, 10, 2, 1, 4, 1, 5, 1, 6, 1, 7, 0
+};
+static const uint8 *compiler_passes_of_opt_level[] = {
+    compiler_passes_with_dump,
+    compiler_passes_with_dump_opt1,
+    compiler_passes_with_dump_opt2
+};
 #endif
 
 /* The exported global data of JIT compiler */
@@ -58,7 +91,7 @@ static JitGlobals jit_globals = {
 /* clang-format on */
 
 static bool
-apply_compiler_passes(JitCompContext *cc)
+apply_compiler_passes(JitCompContext *cc, bool skip_opt_passes)
 {
     const uint8 *p = jit_globals.passes;
 
@@ -67,6 +100,9 @@ apply_compiler_passes(JitCompContext *cc)
         cc->cur_pass_no = p - jit_globals.passes;
         bh_assert(*p < COMPILER_PASS_NUM);
 
+        if (skip_opt_passes && *p >= COMPILER_PASS_OPT_BEGIN)
+            continue;
+
         if (!compiler_passes[*p].run(cc) || jit_get_last_error(cc)) {
             LOG_VERBOSE("JIT: compilation failed at pass[%td] = %s\n",
                         p - jit_globals.passes, compiler_passes[*p].name);
@@ -83,11 +119,17 @@ jit_compiler_init(const JitCompOptions *options)
     uint32 code_cache_size = options->code_cache_size > 0
                                  ? options->code_cache_size
                                  : FAST_JIT_DEFAULT_CODE_CACHE_SIZE;
+    uint32 opt_level = options->opt_level < COMPILER_OPT_LEVEL_MAX
+                           ? options->opt_level
+                           : COMPILER_OPT_LEVEL_MAX;
 
-    LOG_VERBOSE("JIT: compiler init with code cache size: %u\n",
-                code_cache_size);
+    LOG_VERBOSE("JIT: compiler init with code cache size: %u, "
+                "max size: %u, opt level: %u\n",
+                code_cache_size, options->code_cache_max_size, opt_level);
 
-    if (!jit_code_cache_init(code_cache_size))
+    jit_globals.passes = compiler_passes_of_opt_level[opt_level];
+
+    if (!jit_code_cache_init(code_cache_size, options->code_cache_max_size))
         return false;
 
     if (!jit_codegen_init())
@@ -120,12 +162,36 @@ jit_compiler_get_pass_name(unsigned i)
     return i < COMPILER_PASS_NUM ? compiler_passes[i].name : NULL;
 }
 
+static JitCompContext *
+create_comp_context(WASMModule *module, uint32 func_idx)
+{
+    JitCompContext *cc;
+    uint32 i = func_idx - module->import_function_count;
+
+    if (!(cc = jit_calloc(sizeof(*cc)))) {
+        return NULL;
+    }
+
+    if (!jit_cc_init(cc, 64)) {
+        jit_free(cc);
+        return NULL;
+    }
+
+    cc->cur_wasm_module = module;
+    cc->cur_wasm_func = module->functions[i];
+    cc->cur_wasm_func_idx = func_idx;
+    cc->mem_space_unchanged = (!cc->cur_wasm_func->has_op_memory_grow
+                               && !cc->cur_wasm_func->has_op_func_call)
+                              || (!module->possible_memory_grow);
+    return cc;
+}
+
 bool
 jit_compiler_compile(WASMModule *module, uint32 func_idx)
 {
     JitCompContext *cc = NULL;
     char *last_error;
-    bool ret = false;
+    bool ret = false, skip_opt_passes = false;
     uint32 i = func_idx - module->import_function_count;
     uint32 j = i % WASM_ORC_JIT_BACKEND_THREAD_NUM;
 
@@ -138,24 +204,29 @@ jit_compiler_compile(WASMModule *module, uint32 func_idx)
         return true;
     }
 
+retry:
     /* Initialize the compilation context */
-    if (!(cc = jit_calloc(sizeof(*cc)))) {
-        goto fail;
-    }
-
-    if (!jit_cc_init(cc, 64)) {
+    if (!(cc = create_comp_context(module, func_idx))) {
         goto fail;
     }
 
-    cc->cur_wasm_module = module;
-    cc->cur_wasm_func = module->functions[i];
-    cc->cur_wasm_func_idx = func_idx;
-    cc->mem_space_unchanged = (!cc->cur_wasm_func->has_op_memory_grow
-                               && !cc->cur_wasm_func->has_op_func_call)
-                              || (!module->possible_memory_grow);
-
     /* Apply compiler passes */
-    if (!apply_compiler_passes(cc) || jit_get_last_error(cc)) {
+    if (!apply_compiler_passes(cc, skip_opt_passes)
+        || jit_get_last_error(cc)) {
+        if (!skip_opt_passes && !jit_get_last_error(cc)
+            && jit_globals.passes[cc->cur_pass_no] == COMPILER_PASS_REGALLOC
+            && jit_globals.passes != compiler_passes_of_opt_level[0]) {
+            /* The optimized IR keeps more values alive and may need
+               more spill slots than the frame reserves, compile the
+               function again without the optimization passes */
+            LOG_VERBOSE("JIT: recompile function %u without optimization\n",
+                        func_idx);
+            jit_cc_delete(cc);
+            cc = NULL;
+            skip_opt_passes = true;
+            goto retry;
+        }
+
         last_error = jit_get_last_error(cc);
 
 #if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
@@ -281,6 +352,108 @@ jit_compiler_set_llvm_jit_func_ptr(WASMModule *module, uint32 func_idx,
     }
     os_mutex_unlock(&module->instance_list_lock);
 }
+
+/* The interval in microseconds to scan the hotness of the functions,
+   it is doubled after each scan finding no function getting hot, up to
+   TIERUP_SCAN_MAX_BACKOFF times, so that the compile threads of an idle
+   or cold module don't keep waking up to scan the counters */
+#define TIERUP_SCAN_INTERVAL_US 20000
+#define TIERUP_SCAN_MAX_BACKOFF 5
+
+static void
+tierup_queue_sift_down(WASMTierUpEntry *queue, uint32 size, uint32 idx)
+{
+    WASMTierUpEntry entry = queue[idx];
+    uint32 child;
+
+    while ((child = idx * 2 + 1) < size) {
+        if (child + 1 < size && queue[child + 1].hotness > queue[child].hotness)
+            child++;
+        if (queue[child].hotness <= entry.hotness)
+            break;
+        queue[idx] = queue[child];
+        idx = child;
+    }
+    queue[idx] = entry;
+}
+
+/* Add the functions reaching the threshold to the tier-up queue, and sort
+   the queue again by the current hotness of the functions in it, return
+   the count of the functions added */
+static uint32
+tierup_queue_scan(WASMModule *module, uint32 threshold)
+{
+    WASMTierUpEntry *queue = module->tierup_queue;
+    WASMFunction *func;
+    uint32 queue_size = module->tierup_queue_size, i;
+
+    for (i = 0; i < module->tierup_queue_size; i++)
+        queue[i].hotness = module->functions[queue[i].func_idx]->hotness;
+
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+        if (!func->tierup_queued && func->hotness >= threshold) {
+            func->tierup_queued = true;
+            queue[module->tierup_queue_size].func_idx = i;
+            queue[module->tierup_queue_size].hotness = func->hotness;
+            module->tierup_queue_size++;
+        }
+    }
+
+    for (i = module->tierup_queue_size / 2; i > 0; i--)
+        tierup_queue_sift_down(queue, module->tierup_queue_size, i - 1);
+
+    module->tierup_scan_time = os_time_get_boot_us();
+    return module->tierup_queue_size - queue_size;
+}
+
+bool
+jit_compiler_get_tierup_func(WASMModule *module, uint32 *p_func_idx)
+{
+    LLVMJITOptions *llvm_jit_options = wasm_runtime_get_llvm_jit_options();
+    WASMTierUpEntry *queue = module->tierup_queue;
+    uint64 interval, elapsed;
+
+    os_mutex_lock(&module->tierup_wait_lock);
+    while (!module->orcjit_stop_compiling) {
+        /* The counters are scanned at intervals since it takes time
+           for large modules, the threads compiling the functions in
+           the queue don't scan them again in the meantime */
+        interval = (uint64)TIERUP_SCAN_INTERVAL_US
+                   << module->tierup_scan_backoff;
+        elapsed = os_time_get_boot_us() - module->tierup_scan_time;
+        if (elapsed >= interval) {
+            if (tierup_queue_scan(module, llvm_jit_options->tierup_threshold)
+                > 0) {
+                /* Scan again soon since more functions may be getting
+                   hot, and wake up the other threads to compile the
+                   functions added */
+                module->tierup_scan_backoff = 0;
+                os_cond_broadcast(&module->tierup_wait_cond);
+            }
+            else if (module->tierup_scan_backoff < TIERUP_SCAN_MAX_BACKOFF)
+                module->tierup_scan_backoff++;
+            interval = (uint64)TIERUP_SCAN_INTERVAL_US
+                       << module->tierup_scan_backoff;
+            elapsed = 0;
+        }
+
+        if (module->tierup_queue_size > 0) {
+            *p_func_idx = queue[0].func_idx + module->import_function_count;
+            queue[0] = queue[--module->tierup_queue_size];
+            tierup_queue_sift_down(queue, module->tierup_queue_size, 0);
+            os_mutex_unlock(&module->tierup_wait_lock);
+            return true;
+        }
+
+        /* Sleep until the next scan */
+        os_cond_reltimedwait(&module->tierup_wait_cond,
+                             &module->tierup_wait_lock, interval - elapsed);
+    }
+    os_mutex_unlock(&module->tierup_wait_lock);
+
+    return false;
+}
 #endif /* end of WASM_ENABLE_LAZY_JIT != 0 && WASM_ENABLE_JIT != 0 */
 
 int
@@ -69,6 +69,10 @@ typedef struct JitInterpSwitchInfo {
 /* Jit compiler options */
 typedef struct JitCompOptions {
     uint32 code_cache_size;
+    /* the max total size of the code cache, 0 means code_cache_size */
+    uint32 code_cache_max_size;
+    /* 0: no IR optimization, 1: propagation and dead code elimination,
+       2: and redundancy elimination */
     uint32 opt_level;
 } JitCompOptions;
 
@@ -103,6 +107,19 @@ jit_compiler_set_call_to_fast_jit(WASMModule *module, uint32 func_idx);
 void
 jit_compiler_set_llvm_jit_func_ptr(WASMModule *module, uint32 func_idx,
                                    void *func_ptr);
+
+/**
+ * Get the next function to compile by llvm jit in Multi-Tier JIT mode,
+ * which is the hottest one among the functions reaching the tier-up
+ * threshold, wait until there is such a function.
+ *
+ * @param module the wasm module
+ * @param p_func_idx return the index of the function
+ *
+ * @return false if the compilation of the module is stopped
+ */
+bool
+jit_compiler_get_tierup_func(WASMModule *module, uint32 *p_func_idx);
 #endif
 
 int
@@ -131,6 +148,25 @@ jit_pass_update_cfg(JitCompContext *cc);
 bool
 jit_pass_frontend(JitCompContext *cc);
 
+/**
+ * Constant propagation, constant folding and copy propagation.
+ */
+bool
+jit_pass_propagate(JitCompContext *cc);
+
+/**
+ * Eliminate redundant computations, loads and exception checks,
+ * including subsumed linear memory bounds checks.
+ */
+bool
+jit_pass_redundancy_elim(JitCompContext *cc);
+
+/**
+ * Dead code elimination.
+ */
+bool
+jit_pass_dce(JitCompContext *cc);
+
 /**
  * Lower unsupported operations into supported ones.
  */
@@ -52,6 +52,18 @@ jit_dump_reg(JitCompContext *cc, JitReg reg)
                 os_printf("D%d", no);
             break;
 
+#if WASM_ENABLE_SIMD != 0
+        case JIT_REG_KIND_V128:
+            if (jit_reg_is_const(reg)) {
+                V128 v = jit_cc_get_const_V128(cc, reg);
+                os_printf("0x%016llx%016llxV", (unsigned long long)v.i64x2[1],
+                          (unsigned long long)v.i64x2[0]);
+            }
+            else
+                os_printf("V%d", no);
+            break;
+#endif
+
         case JIT_REG_KIND_L32:
             os_printf("L%d", no);
             break;
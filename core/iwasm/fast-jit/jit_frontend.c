@@ -5,6 +5,7 @@
 
 #include "jit_compiler.h"
 #include "jit_frontend.h"
+#include "jit_codegen.h"
 #include "fe/jit_emit_compare.h"
 #include "fe/jit_emit_const.h"
 #include "fe/jit_emit_control.h"
@@ -14,6 +15,7 @@
 #include "fe/jit_emit_memory.h"
 #include "fe/jit_emit_numberic.h"
 #include "fe/jit_emit_parametric.h"
+#include "fe/jit_emit_simd.h"
 #include "fe/jit_emit_table.h"
 #include "fe/jit_emit_variable.h"
 #include "../interpreter/wasm_interp.h"
@@ -844,6 +846,22 @@ gen_load_f64(JitFrame *frame, unsigned n)
     return frame->lp[n].reg;
 }
 
+#if WASM_ENABLE_SIMD != 0
+JitReg
+gen_load_v128(JitFrame *frame, unsigned n)
+{
+    if (!frame->lp[n].reg) {
+        JitCompContext *cc = frame->cc;
+        frame->lp[n].reg = frame->lp[n + 1].reg = frame->lp[n + 2].reg =
+            frame->lp[n + 3].reg = jit_cc_new_reg_V128(cc);
+        GEN_INSN(LDV128, frame->lp[n].reg, cc->fp_reg,
+                 NEW_CONST(I32, offset_of_local(n)));
+    }
+
+    return frame->lp[n].reg;
+}
+#endif
+
 void
 gen_commit_values(JitFrame *frame, JitValueSlot *begin, JitValueSlot *end)
 {
@@ -880,6 +898,16 @@ gen_commit_values(JitFrame *frame, JitValueSlot *begin, JitValueSlot *end)
                          NEW_CONST(I32, offset_of_local(n)));
                 (++p)->dirty = 0;
                 break;
+
+#if WASM_ENABLE_SIMD != 0
+            case JIT_REG_KIND_V128:
+                GEN_INSN(STV128, p->reg, cc->fp_reg,
+                         NEW_CONST(I32, offset_of_local(n)));
+                (++p)->dirty = 0;
+                (++p)->dirty = 0;
+                (++p)->dirty = 0;
+                break;
+#endif
         }
     }
 }
@@ -1064,6 +1092,14 @@ jit_pass_frontend(JitCompContext *cc)
     if (!(form_and_translate_func(cc)))
         return false;
 
+#if WASM_ENABLE_SIMD != 0
+    /* Only the functions using v128 take the float registers for the
+       V128 registers, the hard register numbers are the same */
+    if (jit_cc_reg_num(cc, JIT_REG_KIND_V128)
+        > jit_cc_hreg_num(cc, JIT_REG_KIND_V128))
+        cc->hreg_info = jit_codegen_get_hreg_info_simd();
+#endif
+
     /* Release the annotations after local CSE and translation. */
     jit_cc_disable_insn_hash(cc);
     jit_annl_disable_end_sp(cc);
@@ -1262,9 +1298,32 @@ init_func_translation(JitCompContext *cc)
     }
 #endif
 
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+    /* Count the call for the tier-up to llvm jit */
+    gen_count_hotness(jit_frame);
+#endif
+
     return jit_frame;
 }
 
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+void
+gen_count_hotness(JitFrame *frame)
+{
+    JitCompContext *cc = frame->cc;
+    JitReg hotness_addr = jit_cc_new_reg_ptr(cc);
+    JitReg hotness = jit_cc_new_reg_I32(cc);
+
+    /* The counter is increased without atomic operation, the counts
+       lost by the concurrent threads don't matter */
+    GEN_INSN(MOV, hotness_addr,
+             NEW_CONST(PTR, (uintptr_t)&frame->cur_wasm_func->hotness));
+    GEN_INSN(LDI32, hotness, hotness_addr, NEW_CONST(I32, 0));
+    GEN_INSN(ADD, hotness, hotness, NEW_CONST(I32, 1));
+    GEN_INSN(STI32, hotness, hotness_addr, NEW_CONST(I32, 0));
+}
+#endif
+
 static void
 free_block_memory(JitBlock *block)
 {
@@ -2575,6 +2634,690 @@ jit_compile_func(JitCompContext *cc)
             }
 #endif /* end of WASM_ENABLE_SHARED_MEMORY */
 
+#if WASM_ENABLE_SIMD != 0
+            case WASM_OP_SIMD_PREFIX:
+            {
+                uint32 opcode1;
+                uint8 lane_id;
+                JitV128Shape shape;
+
+                read_leb_uint32(frame_ip, frame_ip_end, opcode1);
+                /* opcode1 was checked in loader and is no larger than
+                   UINT8_MAX */
+                opcode = (uint8)opcode1;
+
+                if (!jit_codegen_is_simd_supported()) {
+                    jit_set_last_error(cc, "SIMD requires SSSE3, SSE4.1 and "
+                                           "SSE4.2 support of the CPU");
+                    return false;
+                }
+
+                /* The vector instructions use the scratch registers of
+                   the V128 registers even if no V128 register is used */
+                cc->hreg_info = jit_codegen_get_hreg_info_simd();
+
+                switch (opcode) {
+                    case SIMD_v128_load:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        if (!jit_compile_op_v128_load(cc, align, offset))
+                            return false;
+                        break;
+
+                    case SIMD_v128_load8x8_s:
+                    case SIMD_v128_load8x8_u:
+                    case SIMD_v128_load16x4_s:
+                    case SIMD_v128_load16x4_u:
+                    case SIMD_v128_load32x2_s:
+                    case SIMD_v128_load32x2_u:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        shape = (JitV128Shape)(JIT_V128_I8X16
+                                               + (opcode - SIMD_v128_load8x8_s)
+                                                     / 2);
+                        if (!jit_compile_op_v128_load_extend(
+                                cc, align, offset,
+                                (opcode - SIMD_v128_load8x8_s) % 2 == 0,
+                                shape))
+                            return false;
+                        break;
+
+                    case SIMD_v128_load8_splat:
+                    case SIMD_v128_load16_splat:
+                    case SIMD_v128_load32_splat:
+                    case SIMD_v128_load64_splat:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        shape = (JitV128Shape)(JIT_V128_I8X16 + opcode
+                                               - SIMD_v128_load8_splat);
+                        if (!jit_compile_op_v128_load_splat(cc, align, offset,
+                                                            shape))
+                            return false;
+                        break;
+
+                    case SIMD_v128_store:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        if (!jit_compile_op_v128_store(cc, align, offset))
+                            return false;
+                        break;
+
+                    case SIMD_v128_const:
+                        if (!jit_compile_simd_v128_const(cc, frame_ip))
+                            return false;
+                        frame_ip += 16;
+                        break;
+
+                    case SIMD_v8x16_shuffle:
+                        if (!jit_compile_simd_shuffle(cc, frame_ip))
+                            return false;
+                        frame_ip += 16;
+                        break;
+
+                    case SIMD_v8x16_swizzle:
+                        if (!jit_compile_simd_swizzle(cc))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_splat:
+                    case SIMD_i16x8_splat:
+                    case SIMD_i32x4_splat:
+                    case SIMD_i64x2_splat:
+                    case SIMD_f32x4_splat:
+                    case SIMD_f64x2_splat:
+                        shape = (JitV128Shape)(JIT_V128_I8X16 + opcode
+                                               - SIMD_i8x16_splat);
+                        if (!jit_compile_simd_splat(cc, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_extract_lane_s:
+                    case SIMD_i8x16_extract_lane_u:
+                        lane_id = *frame_ip++;
+                        if (!jit_compile_simd_extract_lane(
+                                cc, JIT_V128_I8X16, lane_id,
+                                opcode == SIMD_i8x16_extract_lane_s))
+                            return false;
+                        break;
+                    case SIMD_i16x8_extract_lane_s:
+                    case SIMD_i16x8_extract_lane_u:
+                        lane_id = *frame_ip++;
+                        if (!jit_compile_simd_extract_lane(
+                                cc, JIT_V128_I16X8, lane_id,
+                                opcode == SIMD_i16x8_extract_lane_s))
+                            return false;
+                        break;
+                    case SIMD_i32x4_extract_lane:
+                    case SIMD_i64x2_extract_lane:
+                    case SIMD_f32x4_extract_lane:
+                    case SIMD_f64x2_extract_lane:
+                        lane_id = *frame_ip++;
+                        shape = (JitV128Shape)(JIT_V128_I32X4
+                                               + (opcode
+                                                  - SIMD_i32x4_extract_lane)
+                                                     / 2);
+                        if (!jit_compile_simd_extract_lane(cc, shape, lane_id,
+                                                           false))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_replace_lane:
+                    case SIMD_i16x8_replace_lane:
+                        lane_id = *frame_ip++;
+                        shape = opcode == SIMD_i8x16_replace_lane
+                                    ? JIT_V128_I8X16
+                                    : JIT_V128_I16X8;
+                        if (!jit_compile_simd_replace_lane(cc, shape, lane_id))
+                            return false;
+                        break;
+                    case SIMD_i32x4_replace_lane:
+                    case SIMD_i64x2_replace_lane:
+                    case SIMD_f32x4_replace_lane:
+                    case SIMD_f64x2_replace_lane:
+                        lane_id = *frame_ip++;
+                        shape = (JitV128Shape)(JIT_V128_I32X4
+                                               + (opcode
+                                                  - SIMD_i32x4_replace_lane)
+                                                     / 2);
+                        if (!jit_compile_simd_replace_lane(cc, shape, lane_id))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_eq:
+                    case SIMD_i8x16_ne:
+                    case SIMD_i8x16_lt_s:
+                    case SIMD_i8x16_lt_u:
+                    case SIMD_i8x16_gt_s:
+                    case SIMD_i8x16_gt_u:
+                    case SIMD_i8x16_le_s:
+                    case SIMD_i8x16_le_u:
+                    case SIMD_i8x16_ge_s:
+                    case SIMD_i8x16_ge_u:
+                        if (!jit_compile_simd_int_compare(
+                                cc, INT_EQ + opcode - SIMD_i8x16_eq,
+                                JIT_V128_I8X16))
+                            return false;
+                        break;
+                    case SIMD_i16x8_eq:
+                    case SIMD_i16x8_ne:
+                    case SIMD_i16x8_lt_s:
+                    case SIMD_i16x8_lt_u:
+                    case SIMD_i16x8_gt_s:
+                    case SIMD_i16x8_gt_u:
+                    case SIMD_i16x8_le_s:
+                    case SIMD_i16x8_le_u:
+                    case SIMD_i16x8_ge_s:
+                    case SIMD_i16x8_ge_u:
+                        if (!jit_compile_simd_int_compare(
+                                cc, INT_EQ + opcode - SIMD_i16x8_eq,
+                                JIT_V128_I16X8))
+                            return false;
+                        break;
+                    case SIMD_i32x4_eq:
+                    case SIMD_i32x4_ne:
+                    case SIMD_i32x4_lt_s:
+                    case SIMD_i32x4_lt_u:
+                    case SIMD_i32x4_gt_s:
+                    case SIMD_i32x4_gt_u:
+                    case SIMD_i32x4_le_s:
+                    case SIMD_i32x4_le_u:
+                    case SIMD_i32x4_ge_s:
+                    case SIMD_i32x4_ge_u:
+                        if (!jit_compile_simd_int_compare(
+                                cc, INT_EQ + opcode - SIMD_i32x4_eq,
+                                JIT_V128_I32X4))
+                            return false;
+                        break;
+                    case SIMD_i64x2_eq:
+                    case SIMD_i64x2_ne:
+                    case SIMD_i64x2_lt_s:
+                    case SIMD_i64x2_gt_s:
+                    case SIMD_i64x2_le_s:
+                    case SIMD_i64x2_ge_s:
+                    {
+                        IntCond i64x2_conds[] = { INT_EQ,   INT_NE,
+                                                  INT_LT_S, INT_GT_S,
+                                                  INT_LE_S, INT_GE_S };
+
+                        if (!jit_compile_simd_int_compare(
+                                cc, i64x2_conds[opcode - SIMD_i64x2_eq],
+                                JIT_V128_I64X2))
+                            return false;
+                        break;
+                    }
+
+                    case SIMD_f32x4_eq:
+                    case SIMD_f32x4_ne:
+                    case SIMD_f32x4_lt:
+                    case SIMD_f32x4_gt:
+                    case SIMD_f32x4_le:
+                    case SIMD_f32x4_ge:
+                        if (!jit_compile_simd_float_compare(
+                                cc, FLOAT_EQ + opcode - SIMD_f32x4_eq,
+                                JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f64x2_eq:
+                    case SIMD_f64x2_ne:
+                    case SIMD_f64x2_lt:
+                    case SIMD_f64x2_gt:
+                    case SIMD_f64x2_le:
+                    case SIMD_f64x2_ge:
+                        if (!jit_compile_simd_float_compare(
+                                cc, FLOAT_EQ + opcode - SIMD_f64x2_eq,
+                                JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_v128_not:
+                    case SIMD_v128_and:
+                    case SIMD_v128_andnot:
+                    case SIMD_v128_or:
+                    case SIMD_v128_xor:
+                    case SIMD_v128_bitselect:
+                        if (!jit_compile_simd_v128_bitwise(
+                                cc, V128_NOT + opcode - SIMD_v128_not))
+                            return false;
+                        break;
+
+                    case SIMD_v128_any_true:
+                        if (!jit_compile_simd_any_true(cc))
+                            return false;
+                        break;
+
+                    case SIMD_v128_load8_lane:
+                    case SIMD_v128_load16_lane:
+                    case SIMD_v128_load32_lane:
+                    case SIMD_v128_load64_lane:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        lane_id = *frame_ip++;
+                        shape = (JitV128Shape)(JIT_V128_I8X16 + opcode
+                                               - SIMD_v128_load8_lane);
+                        if (!jit_compile_op_v128_load_lane(cc, align, offset,
+                                                           shape, lane_id))
+                            return false;
+                        break;
+
+                    case SIMD_v128_store8_lane:
+                    case SIMD_v128_store16_lane:
+                    case SIMD_v128_store32_lane:
+                    case SIMD_v128_store64_lane:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        lane_id = *frame_ip++;
+                        shape = (JitV128Shape)(JIT_V128_I8X16 + opcode
+                                               - SIMD_v128_store8_lane);
+                        if (!jit_compile_op_v128_store_lane(cc, align, offset,
+                                                            shape, lane_id))
+                            return false;
+                        break;
+
+                    case SIMD_v128_load32_zero:
+                    case SIMD_v128_load64_zero:
+                        read_leb_uint32(frame_ip, frame_ip_end, align);
+                        read_leb_uint32(frame_ip, frame_ip_end, offset);
+                        shape = opcode == SIMD_v128_load32_zero
+                                    ? JIT_V128_I32X4
+                                    : JIT_V128_I64X2;
+                        if (!jit_compile_op_v128_load_zero(cc, align, offset,
+                                                           shape))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_demote_f64x2_zero:
+                        if (!jit_compile_simd_f32x4_demote_f64x2(cc))
+                            return false;
+                        break;
+                    case SIMD_f64x2_promote_low_f32x4_zero:
+                        if (!jit_compile_simd_f64x2_promote_f32x4(cc))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_abs:
+                    case SIMD_i16x8_abs:
+                    case SIMD_i32x4_abs:
+                    case SIMD_i64x2_abs:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_abs)
+                                               / 0x20);
+                        if (!jit_compile_simd_int_abs(cc, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_neg:
+                    case SIMD_i16x8_neg:
+                    case SIMD_i32x4_neg:
+                    case SIMD_i64x2_neg:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_neg)
+                                               / 0x20);
+                        if (!jit_compile_simd_int_arith(cc, V128_NEG, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_all_true:
+                    case SIMD_i16x8_all_true:
+                    case SIMD_i32x4_all_true:
+                    case SIMD_i64x2_all_true:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_all_true)
+                                               / 0x20);
+                        if (!jit_compile_simd_all_true(cc, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_bitmask:
+                    case SIMD_i16x8_bitmask:
+                    case SIMD_i32x4_bitmask:
+                    case SIMD_i64x2_bitmask:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_bitmask)
+                                               / 0x20);
+                        if (!jit_compile_simd_bitmask(cc, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_narrow_i16x8_s:
+                    case SIMD_i8x16_narrow_i16x8_u:
+                        if (!jit_compile_simd_narrow(
+                                cc, opcode == SIMD_i8x16_narrow_i16x8_s,
+                                JIT_V128_I16X8))
+                            return false;
+                        break;
+                    case SIMD_i16x8_narrow_i32x4_s:
+                    case SIMD_i16x8_narrow_i32x4_u:
+                        if (!jit_compile_simd_narrow(
+                                cc, opcode == SIMD_i16x8_narrow_i32x4_s,
+                                JIT_V128_I32X4))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_ceil:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_CEIL,
+                                                         JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f32x4_floor:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_FLOOR,
+                                                         JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f32x4_trunc:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_TRUNC,
+                                                         JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f32x4_nearest:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_NEAREST,
+                                                         JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f64x2_ceil:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_CEIL,
+                                                         JIT_V128_F64X2))
+                            return false;
+                        break;
+                    case SIMD_f64x2_floor:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_FLOOR,
+                                                         JIT_V128_F64X2))
+                            return false;
+                        break;
+                    case SIMD_f64x2_trunc:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_TRUNC,
+                                                         JIT_V128_F64X2))
+                            return false;
+                        break;
+                    case SIMD_f64x2_nearest:
+                        if (!jit_compile_simd_float_math(cc, FLOAT_NEAREST,
+                                                         JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_shl:
+                    case SIMD_i8x16_shr_s:
+                    case SIMD_i8x16_shr_u:
+                    case SIMD_i16x8_shl:
+                    case SIMD_i16x8_shr_s:
+                    case SIMD_i16x8_shr_u:
+                    case SIMD_i32x4_shl:
+                    case SIMD_i32x4_shr_s:
+                    case SIMD_i32x4_shr_u:
+                    case SIMD_i64x2_shl:
+                    case SIMD_i64x2_shr_s:
+                    case SIMD_i64x2_shr_u:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_shl)
+                                               / 0x20);
+                        if (!jit_compile_simd_shift(
+                                cc,
+                                INT_SHL + (opcode - SIMD_i8x16_shl) % 0x20,
+                                shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_add:
+                    case SIMD_i16x8_add:
+                    case SIMD_i32x4_add:
+                    case SIMD_i64x2_add:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_add)
+                                               / 0x20);
+                        if (!jit_compile_simd_int_arith(cc, V128_ADD, shape))
+                            return false;
+                        break;
+                    case SIMD_i8x16_sub:
+                    case SIMD_i16x8_sub:
+                    case SIMD_i32x4_sub:
+                    case SIMD_i64x2_sub:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_sub)
+                                               / 0x20);
+                        if (!jit_compile_simd_int_arith(cc, V128_SUB, shape))
+                            return false;
+                        break;
+                    case SIMD_i16x8_mul:
+                    case SIMD_i32x4_mul:
+                    case SIMD_i64x2_mul:
+                        shape = (JitV128Shape)(JIT_V128_I16X8
+                                               + (opcode - SIMD_i16x8_mul)
+                                                     / 0x20);
+                        if (!jit_compile_simd_int_arith(cc, V128_MUL, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_add_sat_s:
+                    case SIMD_i8x16_add_sat_u:
+                    case SIMD_i16x8_add_sat_s:
+                    case SIMD_i16x8_add_sat_u:
+                        if (!jit_compile_simd_int_sat_arith(
+                                cc, V128_ADD,
+                                (opcode - SIMD_i8x16_add_sat_s) % 2 == 0,
+                                opcode < SIMD_i16x8_add_sat_s
+                                    ? JIT_V128_I8X16
+                                    : JIT_V128_I16X8))
+                            return false;
+                        break;
+                    case SIMD_i8x16_sub_sat_s:
+                    case SIMD_i8x16_sub_sat_u:
+                    case SIMD_i16x8_sub_sat_s:
+                    case SIMD_i16x8_sub_sat_u:
+                        if (!jit_compile_simd_int_sat_arith(
+                                cc, V128_SUB,
+                                (opcode - SIMD_i8x16_sub_sat_s) % 2 == 0,
+                                opcode < SIMD_i16x8_sub_sat_s
+                                    ? JIT_V128_I8X16
+                                    : JIT_V128_I16X8))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_min_s:
+                    case SIMD_i8x16_min_u:
+                    case SIMD_i8x16_max_s:
+                    case SIMD_i8x16_max_u:
+                    case SIMD_i16x8_min_s:
+                    case SIMD_i16x8_min_u:
+                    case SIMD_i16x8_max_s:
+                    case SIMD_i16x8_max_u:
+                    case SIMD_i32x4_min_s:
+                    case SIMD_i32x4_min_u:
+                    case SIMD_i32x4_max_s:
+                    case SIMD_i32x4_max_u:
+                        shape = (JitV128Shape)((opcode - SIMD_i8x16_min_s)
+                                               / 0x20);
+                        if (!jit_compile_simd_int_min_max(
+                                cc, (opcode - SIMD_i8x16_min_s) % 0x20 < 2,
+                                (opcode - SIMD_i8x16_min_s) % 2 == 0, shape))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_avgr_u:
+                    case SIMD_i16x8_avgr_u:
+                        if (!jit_compile_simd_int_avgr_u(
+                                cc, opcode == SIMD_i8x16_avgr_u
+                                        ? JIT_V128_I8X16
+                                        : JIT_V128_I16X8))
+                            return false;
+                        break;
+
+                    case SIMD_i16x8_extadd_pairwise_i8x16_s:
+                    case SIMD_i16x8_extadd_pairwise_i8x16_u:
+                    case SIMD_i32x4_extadd_pairwise_i16x8_s:
+                    case SIMD_i32x4_extadd_pairwise_i16x8_u:
+                        if (!jit_compile_simd_extadd_pairwise(
+                                cc,
+                                (opcode - SIMD_i16x8_extadd_pairwise_i8x16_s)
+                                        % 2
+                                    == 0,
+                                opcode < SIMD_i32x4_extadd_pairwise_i16x8_s
+                                    ? JIT_V128_I8X16
+                                    : JIT_V128_I16X8))
+                            return false;
+                        break;
+
+                    case SIMD_i16x8_extend_low_i8x16_s:
+                    case SIMD_i16x8_extend_high_i8x16_s:
+                    case SIMD_i16x8_extend_low_i8x16_u:
+                    case SIMD_i16x8_extend_high_i8x16_u:
+                    case SIMD_i32x4_extend_low_i16x8_s:
+                    case SIMD_i32x4_extend_high_i16x8_s:
+                    case SIMD_i32x4_extend_low_i16x8_u:
+                    case SIMD_i32x4_extend_high_i16x8_u:
+                    case SIMD_i64x2_extend_low_i32x4_s:
+                    case SIMD_i64x2_extend_high_i32x4_s:
+                    case SIMD_i64x2_extend_low_i32x4_u:
+                    case SIMD_i64x2_extend_high_i32x4_u:
+                    {
+                        uint32 idx = opcode - SIMD_i16x8_extend_low_i8x16_s;
+
+                        if (!jit_compile_simd_extend(
+                                cc, idx % 2 == 0, idx % 0x20 < 2,
+                                (JitV128Shape)(idx / 0x20)))
+                            return false;
+                        break;
+                    }
+
+                    case SIMD_i16x8_extmul_low_i8x16_s:
+                    case SIMD_i16x8_extmul_high_i8x16_s:
+                    case SIMD_i16x8_extmul_low_i8x16_u:
+                    case SIMD_i16x8_extmul_high_i8x16_u:
+                    case SIMD_i32x4_extmul_low_i16x8_s:
+                    case SIMD_i32x4_extmul_high_i16x8_s:
+                    case SIMD_i32x4_extmul_low_i16x8_u:
+                    case SIMD_i32x4_extmul_high_i16x8_u:
+                    case SIMD_i64x2_extmul_low_i32x4_s:
+                    case SIMD_i64x2_extmul_high_i32x4_s:
+                    case SIMD_i64x2_extmul_low_i32x4_u:
+                    case SIMD_i64x2_extmul_high_i32x4_u:
+                    {
+                        uint32 idx = opcode - SIMD_i16x8_extmul_low_i8x16_s;
+
+                        if (!jit_compile_simd_extmul(
+                                cc, idx % 2 == 0, idx % 0x20 < 2,
+                                (JitV128Shape)(idx / 0x20)))
+                            return false;
+                        break;
+                    }
+
+                    case SIMD_i32x4_dot_i16x8_s:
+                        if (!jit_compile_simd_i32x4_dot_i16x8(cc))
+                            return false;
+                        break;
+
+                    case SIMD_i16x8_q15mulr_sat_s:
+                        if (!jit_compile_simd_i16x8_q15mulr_sat(cc))
+                            return false;
+                        break;
+
+                    case SIMD_i8x16_popcnt:
+                        if (!jit_compile_simd_i8x16_popcnt(cc))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_abs:
+                    case SIMD_f64x2_abs:
+                        if (!jit_compile_simd_float_math(
+                                cc, FLOAT_ABS,
+                                opcode == SIMD_f32x4_abs ? JIT_V128_F32X4
+                                                         : JIT_V128_F64X2))
+                            return false;
+                        break;
+                    case SIMD_f32x4_neg:
+                    case SIMD_f64x2_neg:
+                        if (!jit_compile_simd_float_math(
+                                cc, FLOAT_NEG,
+                                opcode == SIMD_f32x4_neg ? JIT_V128_F32X4
+                                                         : JIT_V128_F64X2))
+                            return false;
+                        break;
+                    case SIMD_f32x4_sqrt:
+                    case SIMD_f64x2_sqrt:
+                        if (!jit_compile_simd_float_math(
+                                cc, FLOAT_SQRT,
+                                opcode == SIMD_f32x4_sqrt ? JIT_V128_F32X4
+                                                          : JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_add:
+                    case SIMD_f32x4_sub:
+                    case SIMD_f32x4_mul:
+                    case SIMD_f32x4_div:
+                        if (!jit_compile_simd_float_arith(
+                                cc, V128_ADD + opcode - SIMD_f32x4_add,
+                                JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f64x2_add:
+                    case SIMD_f64x2_sub:
+                    case SIMD_f64x2_mul:
+                    case SIMD_f64x2_div:
+                        if (!jit_compile_simd_float_arith(
+                                cc, V128_ADD + opcode - SIMD_f64x2_add,
+                                JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_min:
+                    case SIMD_f32x4_max:
+                        if (!jit_compile_simd_float_arith(
+                                cc,
+                                opcode == SIMD_f32x4_min ? V128_MIN : V128_MAX,
+                                JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f64x2_min:
+                    case SIMD_f64x2_max:
+                        if (!jit_compile_simd_float_arith(
+                                cc,
+                                opcode == SIMD_f64x2_min ? V128_MIN : V128_MAX,
+                                JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_pmin:
+                    case SIMD_f32x4_pmax:
+                        if (!jit_compile_simd_float_pmin_pmax(
+                                cc, opcode == SIMD_f32x4_pmin, JIT_V128_F32X4))
+                            return false;
+                        break;
+                    case SIMD_f64x2_pmin:
+                    case SIMD_f64x2_pmax:
+                        if (!jit_compile_simd_float_pmin_pmax(
+                                cc, opcode == SIMD_f64x2_pmin, JIT_V128_F64X2))
+                            return false;
+                        break;
+
+                    case SIMD_f32x4_convert_i32x4_s:
+                    case SIMD_f32x4_convert_i32x4_u:
+                        if (!jit_compile_simd_f32x4_convert_i32x4(
+                                cc, opcode == SIMD_f32x4_convert_i32x4_s))
+                            return false;
+                        break;
+
+                    case SIMD_i32x4_trunc_sat_f32x4_s:
+                    case SIMD_i32x4_trunc_sat_f32x4_u:
+                        if (!jit_compile_simd_i32x4_trunc_sat_f32x4(
+                                cc, opcode == SIMD_i32x4_trunc_sat_f32x4_s))
+                            return false;
+                        break;
+
+                    case SIMD_i32x4_trunc_sat_f64x2_s_zero:
+                    case SIMD_i32x4_trunc_sat_f64x2_u_zero:
+                        if (!jit_compile_simd_i32x4_trunc_sat_f64x2_zero(
+                                cc,
+                                opcode == SIMD_i32x4_trunc_sat_f64x2_s_zero))
+                            return false;
+                        break;
+
+                    case SIMD_f64x2_convert_low_i32x4_s:
+                    case SIMD_f64x2_convert_low_i32x4_u:
+                        if (!jit_compile_simd_f64x2_convert_low_i32x4(
+                                cc, opcode == SIMD_f64x2_convert_low_i32x4_s))
+                            return false;
+                        break;
+
+                    default:
+                        jit_set_last_error(cc, "unsupported opcode");
+                        return false;
+                }
+                break;
+            }
+#endif /* end of WASM_ENABLE_SIMD */
+
             default:
                 jit_set_last_error(cc, "unsupported opcode");
                 return false;
@@ -295,6 +295,19 @@ gen_load_f32(JitFrame *frame, unsigned n);
 JitReg
 gen_load_f64(JitFrame *frame, unsigned n);
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Generate instruction to load a v128 value from the frame.
+ *
+ * @param frame the frame information
+ * @param n slot index to the local variable array
+ *
+ * @return register holding the loaded value
+ */
+JitReg
+gen_load_v128(JitFrame *frame, unsigned n);
+#endif
+
 /**
  * Generate instructions to commit computation result to the frame.
  * The general principle is to only commit values that will be used
@@ -307,6 +320,18 @@ gen_load_f64(JitFrame *frame, unsigned n);
 void
 gen_commit_values(JitFrame *frame, JitValueSlot *begin, JitValueSlot *end);
 
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+/**
+ * Generate instructions to increase the hotness of the function, which
+ * decides when the function is compiled by llvm jit in Multi-Tier JIT
+ * mode.
+ *
+ * @param frame the frame information
+ */
+void
+gen_count_hotness(JitFrame *frame);
+#endif
+
 /**
  * Generate instructions to commit SP and IP pointers to the frame.
  *
@@ -392,6 +417,20 @@ push_f64(JitFrame *frame, JitReg value)
     push_i64(frame, value);
 }
 
+#if WASM_ENABLE_SIMD != 0
+static inline void
+push_v128(JitFrame *frame, JitReg value)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        frame->sp->reg = value;
+        frame->sp->dirty = 1;
+        frame->sp++;
+    }
+}
+#endif
+
 static inline JitReg
 pop_i32(JitFrame *frame)
 {
@@ -420,6 +459,15 @@ pop_f64(JitFrame *frame)
     return gen_load_f64(frame, frame->sp - frame->lp);
 }
 
+#if WASM_ENABLE_SIMD != 0
+static inline JitReg
+pop_v128(JitFrame *frame)
+{
+    frame->sp -= 4;
+    return gen_load_v128(frame, frame->sp - frame->lp);
+}
+#endif
+
 static inline void
 pop(JitFrame *frame, int n)
 {
@@ -451,6 +499,14 @@ local_f64(JitFrame *frame, int n)
     return gen_load_f64(frame, n);
 }
 
+#if WASM_ENABLE_SIMD != 0
+static inline JitReg
+local_v128(JitFrame *frame, int n)
+{
+    return gen_load_v128(frame, n);
+}
+#endif
+
 static void
 set_local_i32(JitFrame *frame, int n, JitReg val)
 {
@@ -479,6 +535,19 @@ set_local_f64(JitFrame *frame, int n, JitReg val)
     set_local_i64(frame, n, val);
 }
 
+#if WASM_ENABLE_SIMD != 0
+static inline void
+set_local_v128(JitFrame *frame, int n, JitReg val)
+{
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        frame->lp[n + i].reg = val;
+        frame->lp[n + i].dirty = 1;
+    }
+}
+#endif
+
 #define POP(jit_value, value_type)                         \
     do {                                                   \
         if (!jit_cc_pop_value(cc, value_type, &jit_value)) \
@@ -489,6 +558,7 @@ set_local_f64(JitFrame *frame, int n, JitReg val)
 #define POP_I64(v) POP(v, VALUE_TYPE_I64)
 #define POP_F32(v) POP(v, VALUE_TYPE_F32)
 #define POP_F64(v) POP(v, VALUE_TYPE_F64)
+#define POP_V128(v) POP(v, VALUE_TYPE_V128)
 #define POP_FUNCREF(v) POP(v, VALUE_TYPE_FUNCREF)
 #define POP_EXTERNREF(v) POP(v, VALUE_TYPE_EXTERNREF)
 
@@ -504,6 +574,7 @@ set_local_f64(JitFrame *frame, int n, JitReg val)
 #define PUSH_I64(v) PUSH(v, VALUE_TYPE_I64)
 #define PUSH_F32(v) PUSH(v, VALUE_TYPE_F32)
 #define PUSH_F64(v) PUSH(v, VALUE_TYPE_F64)
+#define PUSH_V128(v) PUSH(v, VALUE_TYPE_V128)
 #define PUSH_FUNCREF(v) PUSH(v, VALUE_TYPE_FUNCREF)
 #define PUSH_EXTERNREF(v) PUSH(v, VALUE_TYPE_EXTERNREF)
 
@@ -712,6 +712,15 @@ jit_cc_new_const_F64(JitCompContext *cc, double val)
     _JIT_CC_NEW_CONST_HELPER(F64, double, val);
 }
 
+#if WASM_ENABLE_SIMD != 0
+JitReg
+jit_cc_new_const_V128(JitCompContext *cc, V128 val)
+{
+    /* V128 constants never fit in the register number */
+    return _jit_cc_new_const(cc, JIT_REG_KIND_V128, sizeof(V128), &val);
+}
+#endif
+
 #undef _JIT_CC_NEW_CONST_HELPER
 
 #define _JIT_CC_GET_CONST_HELPER(KIND, TYPE)                               \
@@ -760,6 +769,17 @@ jit_cc_get_const_F64(JitCompContext *cc, JitReg reg)
     _JIT_CC_GET_CONST_HELPER(F64, double);
 }
 
+#if WASM_ENABLE_SIMD != 0
+V128
+jit_cc_get_const_V128(JitCompContext *cc, JitReg reg)
+{
+    bh_assert(jit_reg_kind(reg) == JIT_REG_KIND_V128);
+    bh_assert(jit_reg_is_const_idx(reg));
+
+    return *(V128 *)(address_of_const(cc, reg, sizeof(V128)));
+}
+#endif
+
 #undef _JIT_CC_GET_CONST_HELPER
 
 #define _JIT_REALLOC_ANN(TYPE, NAME, ANN, POSTFIX)                             \
@@ -1308,6 +1328,11 @@ jit_cc_pop_value(JitCompContext *cc, uint8 type, JitReg *p_value)
         case VALUE_TYPE_F64:
             value = pop_f64(cc->jit_frame);
             break;
+#if WASM_ENABLE_SIMD != 0
+        case VALUE_TYPE_V128:
+            value = pop_v128(cc->jit_frame);
+            break;
+#endif
         default:
             bh_assert(0);
             break;
@@ -1355,6 +1380,11 @@ jit_cc_push_value(JitCompContext *cc, uint8 type, JitReg value)
         case VALUE_TYPE_F64:
             push_f64(cc->jit_frame, value);
             break;
+#if WASM_ENABLE_SIMD != 0
+        case VALUE_TYPE_V128:
+            push_v128(cc->jit_frame, value);
+            break;
+#endif
     }
 
     return true;
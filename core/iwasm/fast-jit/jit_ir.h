@@ -124,6 +124,21 @@ typedef enum JitRegKind {
 #define JIT_REG_KIND_PTR JIT_REG_KIND_I32
 #endif
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Lane shapes of a V128 register, passed to the vector instructions
+ * as a const I32 operand.
+ */
+typedef enum JitV128Shape {
+    JIT_V128_I8X16 = 0,
+    JIT_V128_I16X8,
+    JIT_V128_I32X4,
+    JIT_V128_I64X2,
+    JIT_V128_F32X4,
+    JIT_V128_F64X2,
+} JitV128Shape;
+#endif
+
 /**
  * Construct a new JIT IR register from the kind and no.
  *
@@ -1356,6 +1371,19 @@ jit_cc_new_const_F32(JitCompContext *cc, float val);
 JitReg
 jit_cc_new_const_F64(JitCompContext *cc, double val);
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Create a V128 constant value into the compilation context.
+ *
+ * @param cc compilation context
+ * @param val a V128 value
+ *
+ * @return a constant register containing the value
+ */
+JitReg
+jit_cc_new_const_V128(JitCompContext *cc, V128 val);
+#endif
+
 /**
  * Get the relocation info of a I32 constant register.
  *
@@ -1411,6 +1439,19 @@ jit_cc_get_const_F32(JitCompContext *cc, JitReg reg);
 double
 jit_cc_get_const_F64(JitCompContext *cc, JitReg reg);
 
+#if WASM_ENABLE_SIMD != 0
+/**
+ * Get the constant value of a V128 constant register.
+ *
+ * @param cc compilation context
+ * @param reg constant register
+ *
+ * @return the constant value
+ */
+V128
+jit_cc_get_const_V128(JitCompContext *cc, JitReg reg);
+#endif
+
 /**
  * Get the number of total created labels.
  *
@@ -0,0 +1,1384 @@
+/*
+ * Copyright (C) 2021 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "jit_utils.h"
+#include "jit_compiler.h"
+
+/**
+ * Optional optimization passes running between the frontend and the
+ * register allocator. Virtual registers generated by the frontend
+ * never live across basic blocks (values are committed to the frame
+ * at block ends), so all the passes work block by block: facts are
+ * tagged with the position of the instruction that produced them and
+ * a fact is valid only if it was produced in the current block and
+ * none of the registers it mentions has been redefined since then.
+ * Hard registers are never rewritten and facts about them are never
+ * recorded, except that the exec_env and frame pointer registers may
+ * be operands of redundant instructions since they are only changed
+ * by explicit definitions.
+ */
+
+/* Size of the hash table used by value numbering, must be power of 2 */
+#define VALUE_HASH_SIZE 256
+
+/**
+ * An entry of the value numbering table, which tells that the
+ * instruction at @p pos with @p opcode and @p opnds computed @p value.
+ * Conditional exception branches are recorded with a zero value.
+ */
+typedef struct ValueEntry {
+    uint16 opcode;
+    JitReg opnds[3];
+    JitReg value;
+    uint32 pos;
+    /* Index of the next entry in the same bucket plus 1 */
+    uint32 next;
+} ValueEntry;
+
+typedef struct OptContext {
+    JitCompContext *cc;
+
+    /* Position of the instruction being visited */
+    uint32 pos;
+
+    /* Position of the first instruction of the current block */
+    uint32 block_pos;
+
+    /* Position of the last instruction that may write memory */
+    uint32 mem_pos;
+
+    /* Position of the last definition of each register */
+    uint32 *def_pos[JIT_REG_KIND_L32];
+
+    /* Copy and constant facts: value[r] is a register or a constant
+       that equals to r, recorded at position value_pos[r] */
+    JitReg *value[JIT_REG_KIND_L32];
+    uint32 *value_pos[JIT_REG_KIND_L32];
+
+    /* Affine facts of I64 registers: r == aff_base[r] + aff_off[r] */
+    JitReg *aff_base;
+    int64 *aff_off;
+    uint32 *aff_pos;
+
+    /* Passed bounds checks: base + chk_reach[base] bytes of memory
+       chk_mem[base] are known to be accessible */
+    uint64 *chk_reach;
+    uint32 *chk_mem;
+    uint32 *chk_pos;
+
+    /* Value numbering table */
+    uint32 buckets[VALUE_HASH_SIZE];
+    ValueEntry *entries;
+    uint32 entry_num;
+    uint32 entry_capacity;
+
+    /* Liveness stamps used by dead code elimination */
+    uint32 *live[JIT_REG_KIND_L32];
+    uint32 live_stamp;
+} OptContext;
+
+static void
+opt_context_destroy(OptContext *ctx)
+{
+    unsigned kind;
+
+    for (kind = JIT_REG_KIND_I32; kind < JIT_REG_KIND_L32; kind++) {
+        jit_free(ctx->def_pos[kind]);
+        jit_free(ctx->value[kind]);
+        jit_free(ctx->value_pos[kind]);
+        jit_free(ctx->live[kind]);
+    }
+
+    jit_free(ctx->aff_base);
+    jit_free(ctx->aff_off);
+    jit_free(ctx->aff_pos);
+    jit_free(ctx->chk_reach);
+    jit_free(ctx->chk_mem);
+    jit_free(ctx->chk_pos);
+    jit_free(ctx->entries);
+}
+
+static bool
+opt_context_init(OptContext *ctx, JitCompContext *cc, bool need_values,
+                 bool need_checks, bool need_live)
+{
+    unsigned kind, num;
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->cc = cc;
+
+    for (kind = JIT_REG_KIND_I32; kind < JIT_REG_KIND_L32; kind++) {
+        num = jit_cc_reg_num(cc, kind) + 1;
+
+        if (!(ctx->def_pos[kind] = jit_calloc(sizeof(uint32) * num)))
+            goto fail;
+
+        if (need_values
+            && (!(ctx->value[kind] = jit_calloc(sizeof(JitReg) * num))
+                || !(ctx->value_pos[kind] = jit_calloc(sizeof(uint32) * num))))
+            goto fail;
+
+        if (need_live && !(ctx->live[kind] = jit_calloc(sizeof(uint32) * num)))
+            goto fail;
+    }
+
+    if (need_checks) {
+        num = jit_cc_reg_num(cc, JIT_REG_KIND_I64) + 1;
+
+        if (!(ctx->aff_base = jit_calloc(sizeof(JitReg) * num))
+            || !(ctx->aff_off = jit_calloc(sizeof(int64) * num))
+            || !(ctx->aff_pos = jit_calloc(sizeof(uint32) * num))
+            || !(ctx->chk_reach = jit_calloc(sizeof(uint64) * num))
+            || !(ctx->chk_mem = jit_calloc(sizeof(uint32) * num))
+            || !(ctx->chk_pos = jit_calloc(sizeof(uint32) * num)))
+            goto fail;
+    }
+
+    return true;
+
+fail:
+    opt_context_destroy(ctx);
+    jit_set_last_error(cc, "allocate memory failed");
+    return false;
+}
+
+/**
+ * Check whether the register is a virtual register that the passes
+ * may rewrite and record facts about.
+ */
+static bool
+is_opt_vreg(JitCompContext *cc, JitReg reg)
+{
+    unsigned kind = jit_reg_kind(reg);
+
+    return kind > JIT_REG_KIND_VOID && kind < JIT_REG_KIND_L32
+           && jit_reg_is_variable(reg) && !jit_cc_is_hreg(cc, reg);
+}
+
+static bool
+is_int_const(JitCompContext *cc, JitReg reg)
+{
+    if (!jit_reg_is_const(reg))
+        return false;
+
+    if (jit_reg_is_kind(I32, reg))
+        /* Relocated constants are patched at runtime, keep them */
+        return jit_cc_get_const_I32_rel(cc, reg) == 0;
+
+    return jit_reg_is_kind(I64, reg);
+}
+
+static uint32 *
+def_pos_of(OptContext *ctx, JitReg reg)
+{
+    return &ctx->def_pos[jit_reg_kind(reg)][jit_reg_no(reg)];
+}
+
+static void
+record_defs(OptContext *ctx, JitInsn *insn)
+{
+    JitRegVec regvec = jit_insn_opnd_regs(insn);
+    unsigned first_use = jit_insn_opnd_first_use(insn), i;
+    JitReg *regp;
+
+    JIT_REG_VEC_FOREACH_DEF(regvec, i, regp, first_use)
+    {
+        unsigned kind = jit_reg_kind(*regp);
+
+        if (kind > JIT_REG_KIND_VOID && kind < JIT_REG_KIND_L32
+            && jit_reg_is_variable(*regp))
+            *def_pos_of(ctx, *regp) = ctx->pos;
+    }
+}
+
+/**
+ * Return the copy or the constant that equals to the given register
+ * at the current position, or the register itself if unknown.
+ */
+static JitReg
+lookup_value(OptContext *ctx, JitReg reg)
+{
+    unsigned kind, no;
+    uint32 pos;
+    JitReg value;
+
+    if (!is_opt_vreg(ctx->cc, reg))
+        return reg;
+
+    kind = jit_reg_kind(reg);
+    no = jit_reg_no(reg);
+    pos = ctx->value_pos[kind][no];
+    value = ctx->value[kind][no];
+
+    if (!value || pos < ctx->block_pos || ctx->def_pos[kind][no] != pos)
+        return reg;
+
+    if (jit_reg_is_variable(value) && *def_pos_of(ctx, value) >= pos)
+        return reg;
+
+    return value;
+}
+
+static void
+record_value(OptContext *ctx, JitReg reg, JitReg value)
+{
+    unsigned kind = jit_reg_kind(reg), no = jit_reg_no(reg);
+
+    ctx->value[kind][no] = value;
+    ctx->value_pos[kind][no] = ctx->pos;
+}
+
+/**
+ * Replace the uses of registers that are known copies of other
+ * registers with the original ones.
+ */
+static void
+propagate_copies(OptContext *ctx, JitInsn *insn)
+{
+    JitRegVec regvec = jit_insn_opnd_regs(insn);
+    unsigned first_use = jit_insn_opnd_first_use(insn), i;
+    JitReg *regp, v;
+
+    JIT_REG_VEC_FOREACH_USE(regvec, i, regp, first_use)
+    {
+        v = lookup_value(ctx, *regp);
+        if (v != *regp && jit_reg_is_variable(v))
+            *regp = v;
+    }
+}
+
+/**
+ * Record the copy or constant fact of a MOV instruction.
+ */
+static void
+record_move(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    JitReg dst, src;
+
+    if (insn->opcode != JIT_OP_MOV)
+        return;
+
+    dst = *(jit_insn_opnd(insn, 0));
+    src = *(jit_insn_opnd(insn, 1));
+
+    if (is_opt_vreg(cc, dst)
+        && ((is_opt_vreg(cc, src) && src != dst) || is_int_const(cc, src)
+            || (jit_reg_is_const(src)
+                && (jit_reg_is_kind(F32, src) || jit_reg_is_kind(F64, src)))))
+        record_value(ctx, dst, src);
+}
+
+/*
+ * Helpers of constant folding, which follow the semantics of the
+ * corresponding wasm opcodes.
+ */
+
+static uint32
+clz32(uint32 v)
+{
+    uint32 n = 0;
+
+    if (!v)
+        return 32;
+    while (!(v & 0x80000000u)) {
+        v <<= 1;
+        n++;
+    }
+    return n;
+}
+
+static uint32
+ctz32(uint32 v)
+{
+    uint32 n = 0;
+
+    if (!v)
+        return 32;
+    while (!(v & 1)) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static uint32
+popcnt32(uint32 v)
+{
+    uint32 n = 0;
+
+    while (v) {
+        v &= v - 1;
+        n++;
+    }
+    return n;
+}
+
+static uint64
+clz64(uint64 v)
+{
+    uint32 hi = (uint32)(v >> 32);
+    return hi ? clz32(hi) : 32 + clz32((uint32)v);
+}
+
+static uint64
+ctz64(uint64 v)
+{
+    uint32 lo = (uint32)v;
+    return lo ? ctz32(lo) : 32 + ctz32((uint32)(v >> 32));
+}
+
+static uint64
+popcnt64(uint64 v)
+{
+    return popcnt32((uint32)v) + popcnt32((uint32)(v >> 32));
+}
+
+static bool
+fold_binary_I32(uint16 opcode, uint32 a, uint32 b, uint32 *res)
+{
+    uint32 n = b & 31;
+
+    switch (opcode) {
+        case JIT_OP_ADD:
+            *res = a + b;
+            break;
+        case JIT_OP_SUB:
+            *res = a - b;
+            break;
+        case JIT_OP_MUL:
+            *res = a * b;
+            break;
+        case JIT_OP_AND:
+            *res = a & b;
+            break;
+        case JIT_OP_OR:
+            *res = a | b;
+            break;
+        case JIT_OP_XOR:
+            *res = a ^ b;
+            break;
+        case JIT_OP_SHL:
+            *res = a << n;
+            break;
+        case JIT_OP_SHRS:
+            *res = (uint32)((int32)a >> n);
+            break;
+        case JIT_OP_SHRU:
+            *res = a >> n;
+            break;
+        case JIT_OP_ROTL:
+            *res = n ? (a << n) | (a >> (32 - n)) : a;
+            break;
+        case JIT_OP_ROTR:
+            *res = n ? (a >> n) | (a << (32 - n)) : a;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool
+fold_binary_I64(uint16 opcode, uint64 a, uint64 b, uint64 *res)
+{
+    uint32 n = (uint32)(b & 63);
+
+    switch (opcode) {
+        case JIT_OP_ADD:
+            *res = a + b;
+            break;
+        case JIT_OP_SUB:
+            *res = a - b;
+            break;
+        case JIT_OP_MUL:
+            *res = a * b;
+            break;
+        case JIT_OP_AND:
+            *res = a & b;
+            break;
+        case JIT_OP_OR:
+            *res = a | b;
+            break;
+        case JIT_OP_XOR:
+            *res = a ^ b;
+            break;
+        case JIT_OP_SHL:
+            *res = a << n;
+            break;
+        case JIT_OP_SHRS:
+            *res = (uint64)((int64)a >> n);
+            break;
+        case JIT_OP_SHRU:
+            *res = a >> n;
+            break;
+        case JIT_OP_ROTL:
+            *res = n ? (a << n) | (a >> (64 - n)) : a;
+            break;
+        case JIT_OP_ROTR:
+            *res = n ? (a >> n) | (a << (64 - n)) : a;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool
+is_binary_alu(uint16 opcode)
+{
+    switch (opcode) {
+        case JIT_OP_ADD:
+        case JIT_OP_SUB:
+        case JIT_OP_MUL:
+        case JIT_OP_AND:
+        case JIT_OP_OR:
+        case JIT_OP_XOR:
+        case JIT_OP_SHL:
+        case JIT_OP_SHRS:
+        case JIT_OP_SHRU:
+        case JIT_OP_ROTL:
+        case JIT_OP_ROTR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool
+is_commutative(uint16 opcode)
+{
+    return opcode == JIT_OP_ADD || opcode == JIT_OP_MUL
+           || opcode == JIT_OP_AND || opcode == JIT_OP_OR
+           || opcode == JIT_OP_XOR;
+}
+
+/**
+ * Turn the instruction into MOV dst, src in place. MOV has the
+ * fewest operands, so the operand storage is always large enough.
+ */
+static void
+change_to_mov(JitInsn *insn, JitReg src)
+{
+    insn->opcode = JIT_OP_MOV;
+    insn->flags_u8 = 0;
+    *(jit_insn_opnd(insn, 1)) = src;
+}
+
+static JitReg
+new_int_const(JitCompContext *cc, unsigned kind, uint64 val)
+{
+    return kind == JIT_REG_KIND_I32 ? jit_cc_new_const_I32(cc, (int32)val)
+                                    : jit_cc_new_const_I64(cc, (int64)val);
+}
+
+static uint64
+get_int_const(JitCompContext *cc, JitReg reg)
+{
+    return jit_reg_is_kind(I32, reg)
+               ? (uint64)(uint32)jit_cc_get_const_I32(cc, reg)
+               : (uint64)jit_cc_get_const_I64(cc, reg);
+}
+
+/**
+ * Try to fold a binary ALU instruction whose operands (after
+ * propagation) are @p a and @p b, including the algebraic identities
+ * like x + 0 and x * 1.
+ *
+ * @return the register or constant equal to the result, 0 if it can't
+ * be folded
+ */
+static JitReg
+fold_binary(JitCompContext *cc, uint16 opcode, JitReg a, JitReg b)
+{
+    unsigned kind = jit_reg_kind(a);
+    bool a_const = is_int_const(cc, a), b_const = is_int_const(cc, b);
+    uint64 va = a_const ? get_int_const(cc, a) : 0;
+    uint64 vb = b_const ? get_int_const(cc, b) : 0;
+    uint64 ones = kind == JIT_REG_KIND_I32 ? 0xFFFFFFFFu : ~(uint64)0;
+    uint64 mask = kind == JIT_REG_KIND_I32 ? 31 : 63;
+
+    if (kind != JIT_REG_KIND_I32 && kind != JIT_REG_KIND_I64)
+        return 0;
+
+    if (a_const && b_const) {
+        uint32 res32;
+        uint64 res64;
+
+        if (kind == JIT_REG_KIND_I32) {
+            if (!fold_binary_I32(opcode, (uint32)va, (uint32)vb, &res32))
+                return 0;
+            return jit_cc_new_const_I32(cc, (int32)res32);
+        }
+        if (!fold_binary_I64(opcode, va, vb, &res64))
+            return 0;
+        return jit_cc_new_const_I64(cc, (int64)res64);
+    }
+
+    if (is_commutative(opcode) && a_const) {
+        JitReg t = a;
+        a = b;
+        b = t;
+        vb = va;
+        b_const = true;
+    }
+
+    if (!b_const || !jit_reg_is_variable(a))
+        return 0;
+
+    switch (opcode) {
+        case JIT_OP_ADD:
+        case JIT_OP_SUB:
+        case JIT_OP_OR:
+        case JIT_OP_XOR:
+            return vb == 0 ? a : 0;
+        case JIT_OP_SHL:
+        case JIT_OP_SHRS:
+        case JIT_OP_SHRU:
+        case JIT_OP_ROTL:
+        case JIT_OP_ROTR:
+            return (vb & mask) == 0 ? a : 0;
+        case JIT_OP_MUL:
+            if (vb == 1)
+                return a;
+            return vb == 0 ? new_int_const(cc, kind, 0) : 0;
+        case JIT_OP_AND:
+            if (vb == ones)
+                return a;
+            return vb == 0 ? new_int_const(cc, kind, 0) : 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Try to fold a unary instruction or an integer conversion whose
+ * operand is the constant @p a.
+ */
+static JitReg
+fold_unary(JitCompContext *cc, uint16 opcode, JitReg dst, JitReg a)
+{
+    unsigned kind = jit_reg_kind(dst);
+    uint64 v;
+
+    if (!is_int_const(cc, a))
+        return 0;
+
+    v = get_int_const(cc, a);
+
+    switch (opcode) {
+        case JIT_OP_NEG:
+            v = 0 - v;
+            break;
+        case JIT_OP_NOT:
+            v = ~v;
+            break;
+        case JIT_OP_CLZ:
+            v = kind == JIT_REG_KIND_I32 ? clz32((uint32)v) : clz64(v);
+            break;
+        case JIT_OP_CTZ:
+            v = kind == JIT_REG_KIND_I32 ? ctz32((uint32)v) : ctz64(v);
+            break;
+        case JIT_OP_POPCNT:
+            v = kind == JIT_REG_KIND_I32 ? popcnt32((uint32)v) : popcnt64(v);
+            break;
+        case JIT_OP_I8TOI32:
+        case JIT_OP_I8TOI64:
+            v = (uint64)(int64)(int8)v;
+            break;
+        case JIT_OP_I16TOI32:
+        case JIT_OP_I16TOI64:
+            v = (uint64)(int64)(int16)v;
+            break;
+        case JIT_OP_I32TOI64:
+            v = (uint64)(int64)(int32)v;
+            break;
+        case JIT_OP_U32TOI64:
+            v = (uint64)(uint32)v;
+            break;
+        case JIT_OP_I64TOI32:
+            v = (uint32)v;
+            break;
+        default:
+            return 0;
+    }
+
+    if (kind != JIT_REG_KIND_I32 && kind != JIT_REG_KIND_I64)
+        return 0;
+
+    return new_int_const(cc, kind, v);
+}
+
+/**
+ * Substitute known constants into the operand positions that the
+ * code generator accepts an immediate for.
+ */
+static void
+propagate_consts(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    JitReg *r1, *r2, v;
+
+    switch (insn->opcode) {
+        case JIT_OP_MOV:
+            r1 = jit_insn_opnd(insn, 1);
+            if (jit_reg_is_const(v = lookup_value(ctx, *r1)))
+                *r1 = v;
+            break;
+
+        case JIT_OP_ADD:
+        case JIT_OP_SUB:
+        case JIT_OP_MUL:
+        case JIT_OP_AND:
+        case JIT_OP_OR:
+        case JIT_OP_XOR:
+        case JIT_OP_SHL:
+        case JIT_OP_SHRS:
+        case JIT_OP_SHRU:
+        case JIT_OP_ROTL:
+        case JIT_OP_ROTR:
+        case JIT_OP_CMP:
+            r1 = jit_insn_opnd(insn, 1);
+            r2 = jit_insn_opnd(insn, 2);
+            /* Never make both sources constant */
+            if (!jit_reg_is_const(*r1)
+                && is_int_const(cc, v = lookup_value(ctx, *r2)))
+                *r2 = v;
+            else if (insn->opcode == JIT_OP_ADD && !jit_reg_is_const(*r2)
+                     && is_int_const(cc, v = lookup_value(ctx, *r1)))
+                *r1 = v;
+            break;
+
+        case JIT_OP_STI8:
+        case JIT_OP_STI16:
+        case JIT_OP_STI32:
+        case JIT_OP_STI64:
+            r1 = jit_insn_opnd(insn, 0);
+            if (!is_int_const(cc, v = lookup_value(ctx, *r1)))
+                break;
+            /* Like the frontend, narrow stores take I32 constants even
+               if the stored register is I64 */
+            if (insn->opcode != JIT_OP_STI64 && jit_reg_is_kind(I64, v)
+                && !(v = jit_cc_new_const_I32(
+                         cc, (int32)jit_cc_get_const_I64(cc, v))))
+                break;
+            *r1 = v;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * Fold the instruction into a MOV if its result is known.
+ */
+static void
+fold_insn(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    JitReg dst, res = 0;
+
+    if (is_binary_alu(insn->opcode)) {
+        dst = *(jit_insn_opnd(insn, 0));
+        res = fold_binary(cc, insn->opcode,
+                          lookup_value(ctx, *(jit_insn_opnd(insn, 1))),
+                          lookup_value(ctx, *(jit_insn_opnd(insn, 2))));
+    }
+    else if (insn->opcode == JIT_OP_NEG || insn->opcode == JIT_OP_NOT
+             || insn->opcode == JIT_OP_CLZ || insn->opcode == JIT_OP_CTZ
+             || insn->opcode == JIT_OP_POPCNT
+             || (insn->opcode >= JIT_OP_I8TOI32
+                 && insn->opcode <= JIT_OP_I64TOI32)) {
+        dst = *(jit_insn_opnd(insn, 0));
+        res = fold_unary(cc, insn->opcode, dst,
+                         lookup_value(ctx, *(jit_insn_opnd(insn, 1))));
+    }
+
+    if (res)
+        change_to_mov(insn, res);
+}
+
+/**
+ * Constant propagation, constant folding and copy propagation.
+ */
+bool
+jit_pass_propagate(JitCompContext *cc)
+{
+    OptContext ctx;
+    JitBasicBlock *block;
+    JitInsn *insn;
+    unsigned label_index, end_label_index;
+
+    if (!opt_context_init(&ctx, cc, true, false, false))
+        return false;
+
+    JIT_FOREACH_BLOCK(cc, label_index, end_label_index, block)
+    {
+        ctx.block_pos = ++ctx.pos;
+
+        JIT_FOREACH_INSN(block, insn)
+        {
+            ctx.pos++;
+
+#if WASM_ENABLE_SHARED_MEMORY != 0
+            /* fence insn doesn't have any operand */
+            if (insn->opcode == JIT_OP_FENCE)
+                continue;
+#endif
+
+            propagate_copies(&ctx, insn);
+
+            fold_insn(&ctx, insn);
+            if (jit_get_last_error(cc))
+                goto fail;
+
+            propagate_consts(&ctx, insn);
+            if (jit_get_last_error(cc))
+                goto fail;
+
+            record_defs(&ctx, insn);
+            record_move(&ctx, insn);
+        }
+    }
+
+    opt_context_destroy(&ctx);
+    return true;
+
+fail:
+    opt_context_destroy(&ctx);
+    return false;
+}
+
+/*
+ * Redundancy elimination: value numbering of pure instructions and
+ * loads, store to load forwarding, and removal of repeated or
+ * subsumed exception checks, including linear memory bounds checks.
+ */
+
+static bool
+is_pure_for_vn(uint16 opcode)
+{
+    if (is_binary_alu(opcode))
+        return true;
+
+    switch (opcode) {
+        case JIT_OP_NEG:
+        case JIT_OP_NOT:
+        case JIT_OP_CLZ:
+        case JIT_OP_CTZ:
+        case JIT_OP_POPCNT:
+        case JIT_OP_MAX:
+        case JIT_OP_MIN:
+        case JIT_OP_I32CASTF32:
+        case JIT_OP_I64CASTF64:
+        case JIT_OP_F32CASTI32:
+        case JIT_OP_F64CASTI64:
+            return true;
+        default:
+            return opcode >= JIT_OP_I8TOI32 && opcode <= JIT_OP_F64TOU32;
+    }
+}
+
+static bool
+is_load_for_vn(uint16 opcode)
+{
+    return opcode >= JIT_OP_LDI8 && opcode <= JIT_OP_LDPTR;
+}
+
+/**
+ * Return the load opcode whose result a store of @p opcode can be
+ * forwarded to, or 0 if none.
+ */
+static uint16
+load_opcode_of_store(uint16 opcode)
+{
+    switch (opcode) {
+        case JIT_OP_STI32:
+            return JIT_OP_LDI32;
+        case JIT_OP_STI64:
+            return JIT_OP_LDI64;
+        case JIT_OP_STF32:
+            return JIT_OP_LDF32;
+        case JIT_OP_STF64:
+            return JIT_OP_LDF64;
+        case JIT_OP_STPTR:
+            return JIT_OP_LDPTR;
+        default:
+            return 0;
+    }
+}
+
+static bool
+may_write_memory(JitInsn *insn)
+{
+    uint16 opcode = insn->opcode;
+
+    if (opcode >= JIT_OP_STI8 && opcode <= JIT_OP_STV256)
+        return true;
+
+    if (opcode == JIT_OP_CALLNATIVE || opcode == JIT_OP_CALLBC
+        || opcode == JIT_OP_RETURNBC)
+        return true;
+
+    /* Atomic loads order the accesses after them */
+    if (opcode >= JIT_OP_LDI8 && opcode <= JIT_OP_LDV256
+        && (insn->flags_u8 & 0x1))
+        return true;
+
+#if WASM_ENABLE_SHARED_MEMORY != 0
+    if (opcode >= JIT_OP_AT_CMPXCHGU8 && opcode <= JIT_OP_FENCE)
+        return true;
+#endif
+
+    return false;
+}
+
+/**
+ * Check whether the register can be an operand of a value numbering
+ * entry, i.e. its changes are all visible as definitions.
+ */
+static bool
+is_vn_opnd(JitCompContext *cc, JitReg reg)
+{
+    if (!reg || jit_reg_is_const(reg))
+        return true;
+
+    return is_opt_vreg(cc, reg) || reg == cc->exec_env_reg
+           || reg == cc->fp_reg;
+}
+
+static uint32
+hash_of_value(uint16 opcode, const JitReg *opnds)
+{
+    return (opcode * 31u + opnds[0] * 17u + opnds[1] * 7u + opnds[2])
+           & (VALUE_HASH_SIZE - 1);
+}
+
+static bool
+entry_is_valid(OptContext *ctx, const ValueEntry *entry)
+{
+    unsigned i;
+
+    for (i = 0; i < 3; i++)
+        if (entry->opnds[i] && jit_reg_is_variable(entry->opnds[i])
+            && jit_reg_kind(entry->opnds[i]) != JIT_REG_KIND_L32
+            && *def_pos_of(ctx, entry->opnds[i]) >= entry->pos)
+            return false;
+
+    /* The value of a load may also be a stored register, which must
+       be defined before the store */
+    if (entry->value && jit_reg_is_variable(entry->value)
+        && *def_pos_of(ctx, entry->value) > entry->pos)
+        return false;
+
+    return true;
+}
+
+static ValueEntry *
+find_value(OptContext *ctx, uint16 opcode, const JitReg *opnds)
+{
+    uint32 idx = ctx->buckets[hash_of_value(opcode, opnds)];
+    ValueEntry *entry;
+
+    for (; idx; idx = entry->next) {
+        entry = ctx->entries + idx - 1;
+        if (entry->opcode == opcode && entry->opnds[0] == opnds[0]
+            && entry->opnds[1] == opnds[1] && entry->opnds[2] == opnds[2]
+            && entry->pos >= ctx->block_pos && entry_is_valid(ctx, entry)) {
+            if (is_load_for_vn(opcode) && entry->pos < ctx->mem_pos)
+                continue;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static bool
+add_value(OptContext *ctx, uint16 opcode, const JitReg *opnds, JitReg value)
+{
+    uint32 slot = hash_of_value(opcode, opnds);
+    ValueEntry *entry;
+
+    if (ctx->entry_num == ctx->entry_capacity) {
+        uint32 capacity = ctx->entry_capacity
+                              ? ctx->entry_capacity + ctx->entry_capacity / 2
+                              : 64;
+        ValueEntry *entries = jit_malloc(sizeof(ValueEntry) * capacity);
+
+        if (!entries) {
+            jit_set_last_error(ctx->cc, "allocate memory failed");
+            return false;
+        }
+
+        if (ctx->entries)
+            memcpy(entries, ctx->entries, sizeof(ValueEntry) * ctx->entry_num);
+
+        jit_free(ctx->entries);
+        ctx->entries = entries;
+        ctx->entry_capacity = capacity;
+    }
+
+    entry = ctx->entries + ctx->entry_num++;
+    entry->opcode = opcode;
+    entry->opnds[0] = opnds[0];
+    entry->opnds[1] = opnds[1];
+    entry->opnds[2] = opnds[2];
+    entry->value = value;
+    entry->pos = ctx->pos;
+    entry->next = ctx->buckets[slot];
+    ctx->buckets[slot] = ctx->entry_num;
+
+    return true;
+}
+
+/**
+ * Get the affine decomposition reg == *base + *off of an I64 register.
+ */
+static void
+get_affine(OptContext *ctx, JitReg reg, JitReg *base, int64 *off)
+{
+    unsigned no = jit_reg_no(reg);
+    uint32 pos = ctx->aff_pos[no];
+
+    *base = reg;
+    *off = 0;
+
+    if (pos >= ctx->block_pos && ctx->def_pos[JIT_REG_KIND_I64][no] == pos
+        && *def_pos_of(ctx, ctx->aff_base[no]) < pos) {
+        *base = ctx->aff_base[no];
+        *off = ctx->aff_off[no];
+    }
+}
+
+static void
+record_affine(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    JitReg dst, a, b, base;
+    int64 off;
+
+    if (insn->opcode != JIT_OP_MOV && insn->opcode != JIT_OP_ADD)
+        return;
+
+    dst = *(jit_insn_opnd(insn, 0));
+    if (!jit_reg_is_kind(I64, dst) || !is_opt_vreg(cc, dst))
+        return;
+
+    a = *(jit_insn_opnd(insn, 1));
+    b = insn->opcode == JIT_OP_ADD ? *(jit_insn_opnd(insn, 2))
+                                   : jit_cc_new_const_I64(cc, 0);
+
+    if (jit_reg_is_const(a)) {
+        JitReg t = a;
+        a = b;
+        b = t;
+    }
+
+    if (!is_opt_vreg(cc, a) || a == dst || !jit_reg_is_const(b)
+        || jit_cc_get_const_I64(cc, b) < 0
+        || jit_cc_get_const_I64(cc, b) > (int64)UINT32_MAX * 2)
+        return;
+
+    get_affine(ctx, a, &base, &off);
+    off += jit_cc_get_const_I64(cc, b);
+
+    /* Only keep offsets that a wasm32 address computation may have */
+    if (base == dst || off < 0 || off > (int64)UINT32_MAX * 2)
+        return;
+
+    ctx->aff_base[jit_reg_no(dst)] = base;
+    ctx->aff_off[jit_reg_no(dst)] = off;
+    ctx->aff_pos[jit_reg_no(dst)] = ctx->pos;
+}
+
+/**
+ * Check whether the flags computed by the compare instruction before
+ * @p insn aren't used by later instructions of the block.
+ */
+static bool
+cmp_reg_unused_after(JitCompContext *cc, JitBasicBlock *block, JitInsn *insn)
+{
+    JitRegVec regvec;
+    JitReg *regp;
+    unsigned i, first_use;
+
+    for (insn = insn->next; insn != jit_basic_block_end_insn(block);
+         insn = insn->next) {
+#if WASM_ENABLE_SHARED_MEMORY != 0
+        if (insn->opcode == JIT_OP_FENCE)
+            continue;
+#endif
+        regvec = jit_insn_opnd_regs(insn);
+        first_use = jit_insn_opnd_first_use(insn);
+
+        JIT_REG_VEC_FOREACH_USE(regvec, i, regp, first_use)
+        if (*regp == cc->cmp_reg)
+            return false;
+
+        JIT_REG_VEC_FOREACH_DEF(regvec, i, regp, first_use)
+        if (*regp == cc->cmp_reg)
+            return true;
+    }
+
+    return true;
+}
+
+/**
+ * Get the number of bytes checked by comparing with the given
+ * register, or 0 if it isn't a bounds check register.
+ */
+static uint32
+bound_check_bytes(JitCompContext *cc, JitReg reg, uint32 *p_mem_idx)
+{
+    WASMModule *module = cc->cur_wasm_module;
+    uint32 count = module->import_memory_count + module->memory_count, i;
+    JitMemRegs *mem_regs;
+
+    for (i = 0; i < count; i++) {
+        mem_regs = cc->memory_regs + i;
+        *p_mem_idx = i;
+        if (reg == mem_regs->mem_bound_check_1byte)
+            return 1;
+        if (reg == mem_regs->mem_bound_check_2bytes)
+            return 2;
+        if (reg == mem_regs->mem_bound_check_4bytes)
+            return 4;
+        if (reg == mem_regs->mem_bound_check_8bytes)
+            return 8;
+        if (reg == mem_regs->mem_bound_check_16bytes)
+            return 16;
+    }
+
+    return 0;
+}
+
+/**
+ * Handle a bounds check "CMP cmp_reg, addr, bound; BGTU cmp_reg,
+ * exception, 0". The linear memory never shrinks, so a check is
+ * redundant if an earlier one in the block covered the same address
+ * range or more.
+ *
+ * @return true if the check is redundant
+ */
+static bool
+is_redundant_bounds_check(OptContext *ctx, JitInsn *cmp, JitInsn *br)
+{
+    JitCompContext *cc = ctx->cc;
+    JitReg addr = *(jit_insn_opnd(cmp, 1)), base;
+    uint32 mem_idx = 0, bytes, no, pos;
+    int64 off;
+    uint64 reach;
+
+    if (br->opcode != JIT_OP_BGTU || !jit_reg_is_kind(I64, addr)
+        || !is_opt_vreg(cc, addr)
+        || !(bytes = bound_check_bytes(cc, *(jit_insn_opnd(cmp, 2)),
+                                       &mem_idx)))
+        return false;
+
+    get_affine(ctx, addr, &base, &off);
+    reach = (uint64)off + bytes;
+
+    no = jit_reg_no(base);
+    pos = ctx->chk_pos[no];
+
+    if (pos >= ctx->block_pos && *def_pos_of(ctx, base) < pos
+        && ctx->chk_mem[no] == mem_idx) {
+        if (reach <= ctx->chk_reach[no])
+            return true;
+    }
+    else
+        ctx->chk_reach[no] = 0;
+
+    if (reach > ctx->chk_reach[no])
+        ctx->chk_reach[no] = reach;
+    ctx->chk_mem[no] = mem_idx;
+    ctx->chk_pos[no] = ctx->pos;
+    return false;
+}
+
+/**
+ * Handle a compare followed by a conditional branch to an exception
+ * block, remove both if the check is known to pass.
+ *
+ * @return true if the check was removed
+ */
+static bool
+eliminate_exception_check(OptContext *ctx, JitBasicBlock *block, JitInsn *cmp,
+                          JitInsn **p_next)
+{
+    JitCompContext *cc = ctx->cc;
+    JitInsn *br = cmp->next;
+    JitReg opnds[3];
+    bool redundant;
+
+    if (cmp->opcode != JIT_OP_CMP || *(jit_insn_opnd(cmp, 0)) != cc->cmp_reg
+        || br == jit_basic_block_end_insn(block) || br->opcode < JIT_OP_BEQ
+        || br->opcode > JIT_OP_BLEU || *(jit_insn_opnd(br, 0)) != cc->cmp_reg
+        || !*(jit_insn_opnd(br, 1)) || *(jit_insn_opnd(br, 2)))
+        return false;
+
+    opnds[0] = *(jit_insn_opnd(cmp, 1));
+    opnds[1] = *(jit_insn_opnd(cmp, 2));
+    opnds[2] = *(jit_insn_opnd(br, 1));
+
+    if (!is_vn_opnd(cc, opnds[0]) || !is_vn_opnd(cc, opnds[1]))
+        return false;
+
+    redundant = is_redundant_bounds_check(ctx, cmp, br)
+                || find_value(ctx, br->opcode, opnds);
+
+    if (redundant && cmp_reg_unused_after(cc, block, br)) {
+        *p_next = br->next;
+        jit_insn_unlink(cmp);
+        jit_insn_delete(cmp);
+        jit_insn_unlink(br);
+        jit_insn_delete(br);
+        return true;
+    }
+
+    add_value(ctx, br->opcode, opnds, 0);
+    return false;
+}
+
+/**
+ * Value numbering of a pure instruction or a load, replace it with a
+ * MOV if the same value was computed before.
+ */
+static bool
+number_value(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    uint16 opcode = insn->opcode;
+    JitReg dst, opnds[3] = { 0 };
+    ValueEntry *entry;
+    unsigned i;
+
+    if (!is_pure_for_vn(opcode)
+        && !(is_load_for_vn(opcode) && !(insn->flags_u8 & 0x1)))
+        return true;
+
+    dst = *(jit_insn_opnd(insn, 0));
+    if (!is_opt_vreg(cc, dst))
+        return true;
+
+    opnds[0] = *(jit_insn_opnd(insn, 1));
+    if (is_binary_alu(opcode) || is_load_for_vn(opcode)
+        || opcode == JIT_OP_MAX || opcode == JIT_OP_MIN)
+        opnds[1] = *(jit_insn_opnd(insn, 2));
+
+    for (i = 0; i < 2; i++)
+        if (!is_vn_opnd(cc, opnds[i]))
+            return true;
+
+    if (is_commutative(opcode) && opnds[0] > opnds[1]) {
+        JitReg t = opnds[0];
+        opnds[0] = opnds[1];
+        opnds[1] = t;
+    }
+
+    if ((entry = find_value(ctx, opcode, opnds))
+        && jit_reg_kind(entry->value) == jit_reg_kind(dst)
+        && entry->value != dst) {
+        change_to_mov(insn, entry->value);
+        return true;
+    }
+
+    return add_value(ctx, opcode, opnds, dst);
+}
+
+/**
+ * Record a store so that a later load of the same address gets the
+ * stored value.
+ */
+static bool
+record_store(OptContext *ctx, JitInsn *insn)
+{
+    JitCompContext *cc = ctx->cc;
+    uint16 load_opcode = load_opcode_of_store(insn->opcode);
+    JitReg value, opnds[3] = { 0 };
+
+    if (!load_opcode || (insn->flags_u8 & 0x1))
+        return true;
+
+    value = *(jit_insn_opnd(insn, 0));
+
+    /* i64.store32 stores the low half of an I64 register, a later
+       i64.load32_s of the address gets it sign extended */
+    if (insn->opcode == JIT_OP_STI32 && !jit_reg_is_kind(I32, value))
+        return true;
+
+    opnds[0] = *(jit_insn_opnd(insn, 1));
+    opnds[1] = *(jit_insn_opnd(insn, 2));
+
+    if (!(is_opt_vreg(cc, value) || is_int_const(cc, value)
+          || (jit_reg_is_const(value)
+              && (jit_reg_is_kind(F32, value) || jit_reg_is_kind(F64, value))))
+        || !is_vn_opnd(cc, opnds[0]) || !is_vn_opnd(cc, opnds[1]))
+        return true;
+
+    return add_value(ctx, load_opcode, opnds, value);
+}
+
+/**
+ * Redundant computation, load and exception check elimination.
+ */
+bool
+jit_pass_redundancy_elim(JitCompContext *cc)
+{
+    OptContext ctx;
+    JitBasicBlock *block;
+    JitInsn *insn, *next;
+    unsigned label_index, end_label_index;
+
+    if (!opt_context_init(&ctx, cc, true, true, false))
+        return false;
+
+    JIT_FOREACH_BLOCK(cc, label_index, end_label_index, block)
+    {
+        ctx.block_pos = ++ctx.pos;
+        ctx.mem_pos = ctx.pos;
+        ctx.entry_num = 0;
+        memset(ctx.buckets, 0, sizeof(ctx.buckets));
+
+        for (insn = jit_basic_block_first_insn(block);
+             insn != jit_basic_block_end_insn(block); insn = next) {
+            next = insn->next;
+            ctx.pos++;
+
+#if WASM_ENABLE_SHARED_MEMORY != 0
+            if (insn->opcode == JIT_OP_FENCE) {
+                ctx.mem_pos = ctx.pos;
+                continue;
+            }
+#endif
+
+            propagate_copies(&ctx, insn);
+
+            if (insn->opcode == JIT_OP_CMP) {
+                if (eliminate_exception_check(&ctx, block, insn, &next))
+                    continue;
+                if (jit_get_last_error(cc))
+                    goto fail;
+            }
+
+            if (!number_value(&ctx, insn))
+                goto fail;
+
+            if (may_write_memory(insn)) {
+                ctx.mem_pos = ctx.pos;
+                if (!record_store(&ctx, insn))
+                    goto fail;
+            }
+
+            record_defs(&ctx, insn);
+            record_move(&ctx, insn);
+            record_affine(&ctx, insn);
+            if (jit_get_last_error(cc))
+                goto fail;
+        }
+    }
+
+    opt_context_destroy(&ctx);
+    return true;
+
+fail:
+    opt_context_destroy(&ctx);
+    return false;
+}
+
+/*
+ * Dead code elimination.
+ */
+
+static bool
+is_removable(uint16 opcode)
+{
+    if (opcode == JIT_OP_MOV || is_pure_for_vn(opcode))
+        return true;
+
+    switch (opcode) {
+        case JIT_OP_SELECTEQ:
+        case JIT_OP_SELECTNE:
+        case JIT_OP_SELECTGTS:
+        case JIT_OP_SELECTGES:
+        case JIT_OP_SELECTLTS:
+        case JIT_OP_SELECTLES:
+        case JIT_OP_SELECTGTU:
+        case JIT_OP_SELECTGEU:
+        case JIT_OP_SELECTLTU:
+        case JIT_OP_SELECTLEU:
+        case JIT_OP_LDEXECENV:
+        case JIT_OP_LDJITINFO:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Remove pure instructions whose results are never used.
+ */
+bool
+jit_pass_dce(JitCompContext *cc)
+{
+    OptContext ctx;
+    JitBasicBlock *block;
+    JitInsn *insn, *prev;
+    unsigned label_index, end_label_index, i, first_use;
+    JitRegVec regvec;
+    JitReg *regp, dst;
+    uint32 *live;
+
+    if (!opt_context_init(&ctx, cc, false, false, true))
+        return false;
+
+    JIT_FOREACH_BLOCK(cc, label_index, end_label_index, block)
+    {
+        /* Virtual registers are dead at the end of each block */
+        ctx.live_stamp++;
+
+        for (insn = jit_basic_block_last_insn(block);
+             insn != jit_basic_block_end_insn(block); insn = prev) {
+            prev = insn->prev;
+
+#if WASM_ENABLE_SHARED_MEMORY != 0
+            if (insn->opcode == JIT_OP_FENCE)
+                continue;
+#endif
+
+            if (is_removable(insn->opcode)) {
+                dst = *(jit_insn_opnd(insn, 0));
+
+                if (is_opt_vreg(cc, dst)
+                    && (ctx.live[jit_reg_kind(dst)][jit_reg_no(dst)]
+                            != ctx.live_stamp
+                        || (insn->opcode == JIT_OP_MOV
+                            && *(jit_insn_opnd(insn, 1)) == dst))) {
+                    jit_insn_unlink(insn);
+                    jit_insn_delete(insn);
+                    continue;
+                }
+            }
+
+            regvec = jit_insn_opnd_regs(insn);
+            first_use = jit_insn_opnd_first_use(insn);
+
+            JIT_REG_VEC_FOREACH_DEF(regvec, i, regp, first_use)
+            if (is_opt_vreg(cc, *regp))
+                ctx.live[jit_reg_kind(*regp)][jit_reg_no(*regp)] = 0;
+
+            JIT_REG_VEC_FOREACH_USE(regvec, i, regp, first_use)
+            if (is_opt_vreg(cc, *regp)) {
+                live = &ctx.live[jit_reg_kind(*regp)][jit_reg_no(*regp)];
+                *live = ctx.live_stamp;
+            }
+        }
+    }
+
+    opt_context_destroy(&ctx);
+    return true;
+}
@@ -88,8 +88,19 @@ typedef struct AOTCompOption {
     char **custom_sections;
     uint32_t custom_sections_count;
     const char *stack_usage_file;
+    /* File to write the per-function statistics of the software bound
+     * checks to, NULL means not to write it. */
+    const char *bound_check_report_file;
     const char *llvm_passes;
     const char *builtin_intrinsics;
+    /* Number of threads to generate the machine code with, the optimized
+     * module is split into partitions whose object files are emitted in
+     * parallel and merged, the output is the same for any non-zero number.
+     * 0 means to emit the whole module in the current thread. */
+    uint32_t parallel_jobs;
+    /* Directory of the on-disk object cache used in JIT mode, NULL means
+     * no cache. */
+    const char *jit_cache_dir;
 } AOTCompOption, *aot_comp_option_t;
 
 #ifdef __cplusplus
@@ -159,6 +159,9 @@ typedef struct WASMExecEnv *wasm_exec_env_t;
 struct WASMSharedHeap;
 typedef struct WASMSharedHeap *wasm_shared_heap_t;
 
+struct WASMInstanceSnapshot;
+typedef struct WASMInstanceSnapshot *wasm_instance_snapshot_t;
+
 /* Package Type */
 typedef enum {
     Wasm_Module_Bytecode = 0,
@@ -209,6 +212,65 @@ typedef struct mem_alloc_info_t {
     uint32_t highmark_size;
 } mem_alloc_info_t;
 
+/* Linear memory pool statistics */
+typedef struct linear_memory_pool_stats_t {
+    /* number of slots reserved by the pool */
+    uint32_t slot_count;
+    /* number of slots currently used by linear memories */
+    uint32_t slots_in_use;
+    /* number of linear memories allocated from the pool */
+    uint64_t acquire_count;
+    /* number of them which reused a slot released before */
+    uint64_t reuse_count;
+    /* number of linear memories mapped outside of the pool
+       since all the slots were in use */
+    uint64_t fallback_count;
+    /* number of slots released back to the pool */
+    uint64_t release_count;
+} linear_memory_pool_stats_t;
+
+/* Fast JIT code cache statistics */
+typedef struct fast_jit_code_cache_stats_t {
+    /* number of chunks mapped */
+    uint32_t chunk_count;
+    /* number of chunks owned by the modules, the code of a module is
+       only allocated from its own chunks, which are unmapped when the
+       module is unloaded */
+    uint32_t module_chunk_count;
+    /* size of the largest free block, the code larger than it needs a
+       new chunk, a small value with a large free size means that the
+       code cache is fragmented */
+    uint32_t largest_free_size;
+    /* total size of the chunks */
+    uint64_t total_size;
+    /* limit of the total size */
+    uint64_t max_size;
+    /* size of the code allocated */
+    uint64_t used_size;
+    /* size free for the code */
+    uint64_t free_size;
+} fast_jit_code_cache_stats_t;
+
+/* Output format of the sampling profiler */
+typedef enum wasm_profile_format_t {
+    /* one line per call stack with the number of samples, which is the
+       input of flamegraph.pl */
+    WASM_PROFILE_FORMAT_COLLAPSED = 0,
+    /* the protocol buffer format of pprof, uncompressed */
+    WASM_PROFILE_FORMAT_PPROF,
+} wasm_profile_format_t;
+
+/* Status of a WASM function called by wasm_runtime_call_wasm_async */
+typedef enum wasm_async_status_t {
+    /* the function returned, the results are stored in argv */
+    WASM_ASYNC_DONE = 0,
+    /* a native function suspended the call, see wasm_runtime_suspend */
+    WASM_ASYNC_SUSPENDED,
+    /* the function threw an exception, or the call couldn't be started
+       or resumed */
+    WASM_ASYNC_FAILED,
+} wasm_async_status_t;
+
 /* Running mode of runtime and module instance*/
 typedef enum RunningMode {
     Mode_Interp = 1,
@@ -236,8 +298,13 @@ typedef struct RuntimeInitArgs {
     int unused; /* was platform_port */
     int instance_port;
 
-    /* Fast JIT code cache size */
+    /* Fast JIT code cache size, the code cache maps a new chunk when it
+       is full, and unmaps a chunk when all its code is freed, a chunk is
+       at most this size unless a function is larger */
     uint32_t fast_jit_code_cache_size;
+    /* Fast JIT code cache max total size, the code cache doesn't grow
+       beyond fast_jit_code_cache_size if it is 0 */
+    uint32_t fast_jit_code_cache_max_size;
 
     /* Default GC heap size */
     uint32_t gc_heap_size;
@@ -259,6 +326,79 @@ typedef struct RuntimeInitArgs {
      * - interpreter. TBD
      */
     bool enable_linux_perf;
+    /**
+     * Directory of the persistent LLVM JIT code cache, NULL to disable it.
+     * The machine code compiled by LLVM JIT is saved into this directory,
+     * keyed by the hash of the wasm binary, the host CPU, the runtime
+     * version and the compile options. Once all the functions of a module
+     * are compiled, a later process running the same module loads and
+     * links the cached object files without translating the module into
+     * LLVM IR. If only some of them are cached, e.g. in multi-tier JIT
+     * mode, where only the hot functions are compiled by LLVM JIT, the
+     * module is translated and optimized, and only the code generation of
+     * the cached functions is skipped. The code compiled by Fast JIT isn't
+     * cached, as it embeds the addresses of the runtime data. The string
+     * must be kept valid until the runtime is destroyed.
+     */
+    const char *llvm_jit_cache_dir;
+    /**
+     * Number of linear memory slots reserved when the runtime is
+     * initialized, 0 to disable the linear memory pool. Each slot is a
+     * guard-padded region as large as the one mapped for a linear memory,
+     * it is recycled across module instances: the pages dirtied by an
+     * instance are discarded when the instance is destroyed, instead of
+     * unmapping the whole region. Linear memories fall back to be mapped
+     * separately when all the slots are in use. Only supported on Linux
+     * with the hardware bound check enabled.
+     */
+    uint32_t linear_memory_pool_slots;
+    /**
+     * Max pause time in microseconds that a GC of the Wasm GC heap tries
+     * to take, 0 to sweep the whole heap in the GC. When it is set, the
+     * heap is only swept until the budget is used up after marking, and
+     * the rest is swept in slices by the later allocations. Only used
+     * when WASM_ENABLE_GC is defined.
+     */
+    uint32_t gc_pause_budget_us;
+    /**
+     * Size of the nursery of the Wasm GC heap, where the new objects are
+     * allocated by bumping a pointer and collected by a minor GC when it
+     * is full, 0 to use the default size. It is limited to a quarter of
+     * the heap. Only used when WASM_ENABLE_GC_NURSERY is defined.
+     */
+    uint32_t gc_nursery_size;
+    /**
+     * Max number of the parked native threads and of the idle module
+     * instances kept by a cluster to run its new threads, 0 to disable
+     * the thread pool. When a thread spawned by wasi-threads exits, its
+     * native thread waits for the next spawned thread instead of exiting,
+     * and the module instances of the exited threads are reused by the
+     * new threads spawned by wasi-threads or lib-pthread. Only used when
+     * WASM_ENABLE_THREAD_MGR is defined.
+     */
+    uint32_t thread_pool_size;
+    /**
+     * Time in milliseconds a parked native thread of the thread pool
+     * waits for a new thread to run before exiting, 0 to wait until the
+     * cluster is destroyed. Only used when thread_pool_size isn't 0.
+     */
+    uint32_t thread_idle_timeout_ms;
+    /**
+     * Hotness which a function reaches before the backend threads compile
+     * it with LLVM JIT in Multi-tier JIT mode, 0 to use the default
+     * WASM_TIERUP_HOTNESS_THRESHOLD. The hotness counts the calls of the
+     * function and the iterations of its loops run by Fast JIT, the
+     * hottest functions are compiled first, and the functions which never
+     * reach it keep running the Fast JIT jitted code.
+     */
+    uint32_t tierup_hotness_threshold;
+    /**
+     * Optimization level of the Fast JIT IR passes: 0 disables them, 1
+     * runs constant/copy propagation and dead code elimination, 2 also
+     * removes redundant computations, loads and bounds checks. Levels
+     * greater than 2 are treated as 2.
+     */
+    uint32_t fast_jit_opt_level;
 } RuntimeInitArgs;
 
 #ifndef LOAD_ARGS_OPTION_DEFINED
@@ -277,6 +417,14 @@ typedef struct LoadArgs {
        wasm_runtime_load_ex has to be followed by a wasm_runtime_resolve_symbols
        call */
     bool no_resolve;
+
+    /* false by default, only used by the wasm loader. If true, the loader
+       only parses the module structure, and each function body is validated
+       (and translated for the fast interpreter) on its first call. The wasm
+       binary buffer must be kept until the module is unloaded, so this is
+       ignored if wasm_binary_freeable is true. Requires
+       WAMR_BUILD_LAZY_VALIDATION=1 */
+    bool lazy_validation;
     /* TODO: more fields? */
 } LoadArgs;
 #endif /* LOAD_ARGS_OPTION_DEFINED */
@@ -444,6 +592,27 @@ wasm_runtime_free(void *ptr);
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_get_mem_alloc_info(mem_alloc_info_t *mem_alloc_info);
 
+/**
+ * Get the statistics of the linear memory pool
+ *
+ * @param stats the statistics returned
+ *
+ * @return true if success, false if the linear memory pool isn't enabled,
+ *         see RuntimeInitArgs.linear_memory_pool_slots
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_linear_memory_pool_stats(linear_memory_pool_stats_t *stats);
+
+/**
+ * Get the statistics of the Fast JIT code cache
+ *
+ * @param stats the statistics returned
+ *
+ * @return true if success, false if Fast JIT isn't enabled
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_fast_jit_code_cache_stats(fast_jit_code_cache_stats_t *stats);
+
 /**
  * Get the package type of a buffer.
  *
@@ -770,6 +939,65 @@ wasm_runtime_get_running_mode(wasm_module_inst_t module_inst);
 WASM_RUNTIME_API_EXTERN void
 wasm_runtime_deinstantiate(wasm_module_inst_t module_inst);
 
+/**
+ * Take a snapshot of a module instance, which captures the globals,
+ * the tables, the linear memories and the app heaps of the instance,
+ * e.g. after its start function or `_initialize` or other initialization
+ * functions were executed. New instances can then be created from the
+ * snapshot without executing the initialization again.
+ *
+ * Only the state of the wasm side is captured: the host side state, like
+ * the WASI context, the contexts set by wasm_runtime_set_context and the
+ * attached shared heap, is created again for the new instances as
+ * wasm_runtime_instantiate does. The snapshot holds a reference to the
+ * module, so the module must not be unloaded before the snapshot is
+ * destroyed. Shared memories, instances with sub modules and GC are not
+ * supported.
+ *
+ * On Linux with hardware bound check, the linear memory is kept in an
+ * anonymous memory-backed file and mapped copy-on-write into the new
+ * instances, so that a page is only copied when it is written.
+ *
+ * @param module_inst the module instance to take snapshot of, it must
+ *        not be running
+ * @param error_buf buffer to output the error info if failed
+ * @param error_buf_size the size of the error buffer
+ *
+ * @return the snapshot created, NULL if failed
+ */
+WASM_RUNTIME_API_EXTERN wasm_instance_snapshot_t
+wasm_runtime_snapshot_instance(wasm_module_inst_t module_inst, char *error_buf,
+                               uint32_t error_buf_size);
+
+/**
+ * Instantiate a WASM module from a snapshot taken by
+ * wasm_runtime_snapshot_instance. The start function and the
+ * initialization of globals, tables and linear memories from the module
+ * are skipped, the new instance gets the state captured in the snapshot.
+ *
+ * @param snapshot the snapshot to instantiate from
+ * @param default_stack_size the default stack size of the module instance,
+ *        0 to use the stack size of the snapshotted instance
+ * @param error_buf buffer to output the error info if failed
+ * @param error_buf_size the size of the error buffer
+ *
+ * @return return the instantiated WASM module instance, NULL if failed
+ */
+WASM_RUNTIME_API_EXTERN wasm_module_inst_t
+wasm_runtime_instantiate_from_snapshot(const wasm_instance_snapshot_t snapshot,
+                                       uint32_t default_stack_size,
+                                       char *error_buf,
+                                       uint32_t error_buf_size);
+
+/**
+ * Destroy a snapshot taken by wasm_runtime_snapshot_instance, the
+ * instances created from it are not affected.
+ *
+ * @param snapshot the snapshot to destroy
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_destroy_instance_snapshot(wasm_instance_snapshot_t snapshot);
+
 /**
  * Get WASM module from WASM module instance
  *
@@ -1168,6 +1396,72 @@ wasm_runtime_call_wasm_v(wasm_exec_env_t exec_env,
                          wasm_function_inst_t function, uint32_t num_results,
                          wasm_val_t results[], uint32_t num_args, ...);
 
+/**
+ * Call the given WASM function asynchronously on a separately allocated
+ * native stack. The native functions called by it can suspend the call
+ * with wasm_runtime_suspend instead of blocking the thread, e.g. when
+ * waiting for I/O, then this function returns WASM_ASYNC_SUSPENDED and
+ * the host can run other calls on the same thread, and resume the
+ * suspended call later with wasm_runtime_resume. So one thread can
+ * multiplex many guests, each of which has its own exec env.
+ *
+ * The suspended call keeps using the exec env, and argv, which receives
+ * the results, must be kept valid until the call is done. A suspended
+ * call must be resumed on the thread which started it. Destroying the
+ * exec env of a suspended call resumes it with an "async call canceled"
+ * exception to unwind it first.
+ *
+ * It is only supported when WASM_ENABLE_ASYNC_CALL is enabled and the
+ * platform supports fibers, e.g. Linux with glibc.
+ *
+ * @param exec_env the execution environment to call the function, which
+ *   must be created from wasm_create_exec_env() and not be running
+ * @param function the function to call
+ * @param argc total cell number that the function parameters occupy
+ * @param argv the arguments, the results are stored in it after the call
+ *   is done, as wasm_runtime_call_wasm does
+ *
+ * @return WASM_ASYNC_DONE if the function returned, WASM_ASYNC_SUSPENDED
+ *   if it was suspended, WASM_ASYNC_FAILED if an exception was thrown,
+ *   the caller can call wasm_runtime_get_exception to get the exception
+ *   info
+ */
+WASM_RUNTIME_API_EXTERN wasm_async_status_t
+wasm_runtime_call_wasm_async(wasm_exec_env_t exec_env,
+                             wasm_function_inst_t function, uint32_t argc,
+                             uint32_t argv[]);
+
+/**
+ * Suspend the async call running on the exec env and switch back to the
+ * host which started or resumed it, called by a native function. It
+ * returns after the host resumes the call with wasm_runtime_resume, and
+ * the native function usually returns the resumed result to the guest.
+ *
+ * @param exec_env the execution environment passed to the native function
+ * @param p_result output the result passed to wasm_runtime_resume
+ *
+ * @return true if the call was suspended and then resumed, false if the
+ *   exec env isn't running an async call, so the native function should
+ *   block instead, or if the call was canceled, in which case an exception
+ *   has been thrown
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_suspend(wasm_exec_env_t exec_env, uint64_t *p_result);
+
+/**
+ * Resume the async call suspended by wasm_runtime_suspend
+ *
+ * @param exec_env the execution environment of the suspended call
+ * @param result the result returned to the native function by
+ *   wasm_runtime_suspend
+ *
+ * @return the same as wasm_runtime_call_wasm_async, WASM_ASYNC_FAILED
+ *   without changing the call if it isn't suspended or is resumed on
+ *   another thread
+ */
+WASM_RUNTIME_API_EXTERN wasm_async_status_t
+wasm_runtime_resume(wasm_exec_env_t exec_env, uint64_t result);
+
 /**
  * Call a function reference of a given WASM runtime instance with
  * arguments.
@@ -1861,6 +2155,45 @@ WASM_RUNTIME_API_EXTERN double
 wasm_runtime_get_wasm_func_exec_time(wasm_module_inst_t inst,
                                      const char *func_name);
 
+/**
+ * Start the sampling profiler. The call stacks of the threads running
+ * wasm code are sampled when SIGPROF is raised by the profiling timer,
+ * i.e. every sample_interval_us of the cpu time consumed by the process.
+ * It requires the runtime to be built with WAMR_BUILD_SAMPLING_PROFILER=1,
+ * and AOT modules to be compiled with the call stack frames, e.g. with
+ * wamrc --enable-dump-call-stack.
+ *
+ * @param sample_interval_us the sample interval in microseconds, 0 to use
+ *        the default interval, 10000 (100 samples per second)
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_start_profiling(uint32_t sample_interval_us);
+
+/**
+ * Stop the sampling profiler, the samples recorded are kept until the
+ * profiler is started again or the runtime is destroyed.
+ *
+ * @return true if success, false if the profiler isn't running
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_stop_profiling(void);
+
+/**
+ * Write the samples recorded by the sampling profiler to a file, it must
+ * be called after the profiler is stopped. The modules sampled must not
+ * be unloaded before, as the function names are looked up from them.
+ *
+ * @param file_name the file to write
+ * @param format the output format
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_write_profile(const char *file_name,
+                           wasm_profile_format_t format);
+
 /* wasm thread callback function type */
 typedef void *(*wasm_thread_callback_t)(wasm_exec_env_t, void *);
 /* wasm thread type */
@@ -1874,6 +2207,21 @@ typedef uintptr_t wasm_thread_t;
 WASM_RUNTIME_API_EXTERN void
 wasm_runtime_set_max_thread_num(uint32_t num);
 
+/**
+ * Set the options of the thread pool of every cluster, the native threads
+ * of the exited threads spawned by wasi-threads and the module instances
+ * of the exited threads are kept to run the new threads, the max thread
+ * num per cluster is still respected.
+ *
+ * @param pool_size max number of the parked native threads and of the
+ *        idle module instances kept by a cluster, 0 to disable the pool
+ * @param idle_timeout_ms time in milliseconds a parked native thread
+ *        waits for a new thread before exiting, 0 to wait forever
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_set_thread_pool_options(uint32_t pool_size,
+                                     uint32_t idle_timeout_ms);
+
 /**
  * Spawn a new exec_env, the spawned exec_env
  *   can be used in other threads
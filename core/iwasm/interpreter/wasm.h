@@ -9,6 +9,9 @@
 #include "bh_platform.h"
 #include "bh_hashmap.h"
 #include "bh_assert.h"
+#if WASM_ENABLE_LAZY_VALIDATION != 0 || WASM_ENABLE_JIT != 0
+#include "bh_atomic.h"
+#endif
 #if WASM_ENABLE_GC != 0
 #include "gc_export.h"
 #endif
@@ -359,6 +362,9 @@ typedef struct WASMType {
     struct WASMType *root_type;
     /* The parent type */
     struct WASMType *parent_type;
+    /* The supertype display: supers[i] is the ancestor type whose
+       inherit depth is i, for i < GC_TYPE_SUPERS_DISPLAY_SIZE */
+    struct WASMType **supers;
     uint32 parent_type_idx;
 
     /* The number of internal types in the current rec group, and if
@@ -558,6 +564,33 @@ typedef struct WASMMemoryImport {
 #endif
 } WASMMemoryImport;
 
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+/* Max param count of the native APIs which can be called quickly */
+#define QUICK_NATIVE_CALL_MAX_PARAMS 8
+
+/* Kinds of the params of a native API, precompiled from its signature */
+enum {
+    NATIVE_ARG_I32 = 0, /* 'i' */
+    NATIVE_ARG_I64,     /* 'I' */
+    NATIVE_ARG_PTR,     /* '*' not followed by '~' */
+    NATIVE_ARG_PTR_LEN, /* '*' followed by '~' */
+    NATIVE_ARG_STR,     /* '$' */
+};
+
+/* The precompiled signature of a native API, which lets the runtime call
+   it directly without parsing the signature string on each call */
+typedef struct WASMNativeCallDesc {
+    /* whether the native API can be called quickly */
+    bool quick;
+    /* whether any param is a pointer or a string */
+    bool has_ptr_args;
+    uint8 param_count;
+    /* cell num of the result, 0 for void */
+    uint8 ret_cell_num;
+    uint8 arg_kinds[QUICK_NATIVE_CALL_MAX_PARAMS];
+} WASMNativeCallDesc;
+#endif
+
 typedef struct WASMFunctionImport {
     char *module_name;
     char *field_name;
@@ -569,6 +602,10 @@ typedef struct WASMFunctionImport {
     const char *signature;
     /* attachment */
     void *attachment;
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    /* signature precompiled after linked */
+    WASMNativeCallDesc native_call;
+#endif
 #if WASM_ENABLE_GC != 0
     /* the type index of this function's func_type */
     uint32 type_idx;
@@ -643,6 +680,55 @@ typedef struct WASMImport {
     } u;
 } WASMImport;
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+/* States of a function body of a lazily loaded module */
+#define WASM_FUNC_PREPARED 0
+#define WASM_FUNC_PENDING 1
+#define WASM_FUNC_INVALID 2
+#endif
+
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_EXCE_HANDLING != 0
+/* A catch or catch_all clause of a try block, for fast interpreter */
+typedef struct WASMCatchHandler {
+    /* the first instruction of the clause */
+    uint8 *handler_addr;
+    /* the caught tag, INVALID_TAGINDEX for catch_all */
+    uint32 tag_index;
+    /* offset of the slots which save the caught tag index and the
+       exception values for rethrow, the values passed to a catch
+       clause follow them */
+    uint16 exception_offset;
+    /* index of the next clause of the same try block, -1 if none */
+    int32 next_catch;
+} WASMCatchHandler;
+
+/* A try block, for fast interpreter */
+typedef struct WASMTryBlock {
+    /* compiled code range of the try body: [start_addr, end_addr) */
+    uint8 *start_addr;
+    uint8 *end_addr;
+    /* index of the first catch clause, -1 if none */
+    int32 first_catch;
+    /* index of the try block to search if no clause catches the
+       exception: the enclosing one or the target of delegate, -1 if
+       the exception is thrown to the caller */
+    int32 next_try;
+} WASMTryBlock;
+#endif
+
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_GC != 0
+/* Inline cache of a call_indirect, for fast interpreter. It holds the
+   indexes of the last two functions called through it, which are known
+   to be valid and to match the expected type, -1 for the unused entries.
+   The entries depend only on the module, so the cache is shared by all
+   its instances. It is only used with GC, where the cache hit saves the
+   subtype check, while an exact type check costs no more than the cache
+   lookup. */
+typedef struct WASMCallIndirectCache {
+    uint32 func_idxs[2];
+} WASMCallIndirectCache;
+#endif
+
 struct WASMFunction {
 #if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
     char *field_name;
@@ -675,6 +761,12 @@ struct WASMFunction {
     uint8 *code_compiled;
     uint8 *consts;
     uint32 const_cell_num;
+#if WASM_ENABLE_GC != 0
+    /* inline caches of the call_indirect opcodes, referred to by the
+       compiled code */
+    uint32 call_indirect_cache_count;
+    WASMCallIndirectCache *call_indirect_caches;
+#endif
 #endif
 
 #if WASM_ENABLE_GC != 0
@@ -684,6 +776,14 @@ struct WASMFunction {
 
 #if WASM_ENABLE_EXCE_HANDLING != 0
     uint32 exception_handler_count;
+#if WASM_ENABLE_FAST_INTERP != 0
+    /* try blocks in the order of the try opcodes and their catch
+       clauses, looked up when an exception is thrown */
+    uint32 try_block_count;
+    uint32 catch_handler_count;
+    WASMTryBlock *try_blocks;
+    WASMCatchHandler *catch_handlers;
+#endif
 #endif
 
 #if WASM_ENABLE_FAST_JIT != 0 || WASM_ENABLE_JIT != 0 \
@@ -702,6 +802,12 @@ struct WASMFunction {
     bool has_op_set_global_aux_stack;
 #endif
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    /* WASM_FUNC_PREPARED/PENDING/INVALID, the function body is validated
+       and prepared on its first call if the module is loaded lazily */
+    bh_atomic_32_t lazy_state;
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0
     /* The compiled fast jit jitted code block of this function */
     void *fast_jit_jitted_code;
@@ -711,6 +817,12 @@ struct WASMFunction {
     /* Code block to call fast jit jitted code of this function
        from the llvm jit jitted code */
     void *call_to_fast_jit_from_llvm_jit;
+    /* Hotness of this function, increased by its fast jit jitted code
+       when it is called and when its loops iterate, the function is
+       compiled by llvm jit after it reaches the tier-up threshold */
+    uint32 hotness;
+    /* Whether the function is added to the tier-up queue */
+    bool tierup_queued;
 #endif
 #endif
 };
@@ -792,10 +904,25 @@ typedef struct WASIArguments {
 } WASIArguments;
 #endif
 
-typedef struct StringNode {
-    struct StringNode *next;
-    char *str;
-} StringNode, *StringList;
+/* A chunk of the constant string arena */
+typedef struct ConstStrBlock {
+    struct ConstStrBlock *next;
+    uint32 size;
+    uint32 used;
+    uint8 data[1];
+} ConstStrBlock;
+
+/* Interned constant strings of a module: each distinct string is
+   copied once into the arena and indexed by an open-addressing
+   hash table, so lookups don't depend on the number of strings */
+typedef struct ConstStrPool {
+    /* hash index, each slot points to a string in the arena */
+    char **slots;
+    /* slot count, always a power of 2 */
+    uint32 slot_count;
+    uint32 str_count;
+    ConstStrBlock *blocks;
+} ConstStrPool;
 
 typedef struct BrTableCache {
     struct BrTableCache *next;
@@ -830,6 +957,16 @@ typedef struct WASMCustomSection {
 struct AOTCompData;
 struct AOTCompContext;
 
+#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+/* Function waiting in the tier-up queue */
+typedef struct WASMTierUpEntry {
+    uint32 func_idx;
+    /* the hotness when the queue is last sorted */
+    uint32 hotness;
+} WASMTierUpEntry;
+#endif
+
 /* Orc JIT thread arguments */
 typedef struct OrcJitThreadArg {
 #if WASM_ENABLE_JIT != 0
@@ -943,7 +1080,7 @@ struct WASMModule {
     /* Whether there is possible memory grow, e.g. memory.grow opcode */
     bool possible_memory_grow;
 
-    StringList const_str_list;
+    ConstStrPool const_str_pool;
 #if WASM_ENABLE_FAST_INTERP == 0
     bh_list br_table_cache_list_head;
     bh_list *br_table_cache_list;
@@ -1063,6 +1200,11 @@ struct WASMModule {
     OrcJitThreadArg orcjit_thread_args[WASM_ORC_JIT_BACKEND_THREAD_NUM];
     /* whether to stop the compilation of backend threads */
     bool orcjit_stop_compiling;
+#if WASM_ENABLE_JIT != 0
+    /* The count of the backend threads which finish compiling the llvm
+       jit functions of their groups, the last one saves the jit cache */
+    bh_atomic_32_t orcjit_finished_threads;
+#endif
 #endif
 
 #if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
@@ -1084,6 +1226,15 @@ struct WASMModule {
     /* The count of groups which finish compiling the fast jit
        functions in that group */
     uint32 fast_jit_ready_groups;
+    /* The functions which reach the tier-up threshold and wait to be
+       compiled by llvm jit, kept as a max heap by their hotness, and
+       the time when the hotness of the functions is last scanned */
+    WASMTierUpEntry *tierup_queue;
+    uint32 tierup_queue_size;
+    uint64 tierup_scan_time;
+    /* The scan interval is doubled this many times since the last
+       scan finding a function getting hot */
+    uint32 tierup_scan_backoff;
 #endif
 
 #if WASM_ENABLE_WAMR_COMPILER != 0
@@ -1097,6 +1248,13 @@ struct WASMModule {
 
     /* Whether the underlying wasm binary buffer can be freed */
     bool is_binary_freeable;
+
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    /* Whether the function bodies are validated on their first call */
+    bool is_lazy_validation;
+    /* Lock to serialize the lazy validation of function bodies */
+    korp_mutex lazy_validation_lock;
+#endif
 };
 
 typedef struct BlockType {
@@ -1294,6 +1294,13 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    else if (func_import->native_call.quick) {
+        ret = wasm_runtime_invoke_native_quick(
+            exec_env, native_func_pointer, &func_import->native_call,
+            func_import->attachment, frame->lp, argv_ret);
+    }
+#endif
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -6583,9 +6590,10 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         HANDLE_OP(WASM_OP_CATCH_ALL)
         HANDLE_OP(EXT_OP_TRY)
 #endif
-#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_SIMD != 0
-        /* SIMD isn't supported by interpreter, but when JIT is
-           enabled, `iwasm --interp <wasm_file>` may be run to
+#if (WASM_ENABLE_JIT != 0 || WASM_ENABLE_FAST_JIT != 0) \
+    && WASM_ENABLE_SIMD != 0
+        /* SIMD isn't supported by interpreter, but when JIT or Fast JIT
+           is enabled, `iwasm --interp <wasm_file>` may be run to
            trigger the SIMD opcode in interpreter */
         HANDLE_OP(WASM_OP_SIMD_PREFIX)
 #endif
@@ -6765,13 +6773,22 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         }
         else {
             WASMFunction *cur_wasm_func = cur_func->u.func;
-            WASMFuncType *func_type = cur_wasm_func->func_type;
-            uint32 max_stack_cell_num = cur_wasm_func->max_stack_cell_num;
+            WASMFuncType *func_type;
+            uint32 max_stack_cell_num;
             uint32 cell_num_of_local_stack;
 #if WASM_ENABLE_REF_TYPES != 0 && WASM_ENABLE_GC == 0
             uint32 local_cell_idx;
 #endif
 
+            /* The max stack/block num are known after the function body
+               is validated */
+            if (!WASM_PREPARE_FUNC_LAZILY(module, cur_func)) {
+                frame = prev_frame;
+                goto got_exception;
+            }
+            func_type = cur_wasm_func->func_type;
+            max_stack_cell_num = cur_wasm_func->max_stack_cell_num;
+
 #if WASM_ENABLE_EXCE_HANDLING != 0
             /* account for exception handlers, bundle them here */
             uint32 eh_size =
@@ -7010,6 +7027,12 @@ fast_jit_call_func_bytecode(WASMModuleInstance *module_inst,
                 *(frame->sp - function->ret_cell_num + 1) =
                     info.out.ret.fval[1];
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                /* The v128 result has been stored to the frame by the
+                   jitted code */
+                break;
+#endif
             default:
                 bh_assert(0);
                 break;
@@ -1244,6 +1244,13 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    else if (func_import->native_call.quick) {
+        ret = wasm_runtime_invoke_native_quick(
+            exec_env, native_func_pointer, &func_import->native_call,
+            func_import->attachment, frame->lp, argv_ret);
+    }
+#endif
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -1324,6 +1331,12 @@ wasm_interp_call_func_import(WASMModuleInstance *module_inst,
         return;
     }
 
+    if (!WASM_PREPARE_FUNC_LAZILY(sub_module_inst, sub_func_inst)) {
+        /* The detailed exception is set to the sub module */
+        wasm_set_exception(module_inst, "failed to prepare import function");
+        return;
+    }
+
     /* Switch exec_env but keep using the same one by replacing necessary
      * variables */
     sub_module_exec_env = wasm_runtime_get_exec_env_singleton(
@@ -1360,6 +1373,71 @@ wasm_interp_call_func_import(WASMModuleInstance *module_inst,
 }
 #endif
 
+#if WASM_ENABLE_EXCE_HANDLING != 0
+/* Get the type of the tag, NULL if the tag index is invalid */
+static WASMFuncType *
+get_tag_type(WASMModuleInstance *module_inst, uint32 tag_index)
+{
+    WASMModule *module = module_inst->module;
+
+    if (tag_index < module->import_tag_count)
+        return module->import_tags[tag_index].u.tag.tag_type;
+    tag_index -= module->import_tag_count;
+    if (tag_index < module->tag_count)
+        return module->tags[tag_index]->tag_type;
+    return NULL;
+}
+
+/* Reserve the space to keep the values of the exception being thrown
+   above the wasm stack top, it isn't overwritten when unwinding the
+   frames since no frame is allocated until the exception is caught */
+static uint32 *
+alloc_exception_values(WASMExecEnv *exec_env, uint32 cell_num)
+{
+    uint32 *values = wasm_exec_env_wasm_stack_top(exec_env);
+
+    if ((uint8 *)(values + cell_num) > exec_env->wasm_stack.top_boundary) {
+        wasm_set_exception((WASMModuleInstance *)exec_env->module_inst,
+                           "wasm operand stack overflow");
+        return NULL;
+    }
+    return values;
+}
+
+/* Look up the catch clause in the handler table of the function for the
+   exception thrown at ip. The try blocks are sorted by their start
+   addresses, so the innermost try body containing ip is the last one. */
+static WASMCatchHandler *
+find_catch_handler(WASMFunction *func, const uint8 *ip, uint32 tag_index)
+{
+    WASMTryBlock *try_block;
+    WASMCatchHandler *handler;
+    int32 try_index, catch_index;
+
+    for (try_index = (int32)func->try_block_count - 1; try_index >= 0;
+         try_index--) {
+        try_block = func->try_blocks + try_index;
+        if (try_block->start_addr <= ip && ip < try_block->end_addr)
+            break;
+    }
+
+    /* try the catch clauses from the innermost try block outward, the
+       next try block of a try-delegate is the one its label refers to */
+    while (try_index >= 0) {
+        try_block = func->try_blocks + try_index;
+        for (catch_index = try_block->first_catch; catch_index >= 0;
+             catch_index = handler->next_catch) {
+            handler = func->catch_handlers + catch_index;
+            if (IS_INVALID_TAGINDEX(handler->tag_index)
+                || handler->tag_index == tag_index)
+                return handler;
+        }
+        try_index = try_block->next_try;
+    }
+    return NULL;
+}
+#endif /* end of WASM_ENABLE_EXCE_HANDLING != 0 */
+
 #if WASM_ENABLE_THREAD_MGR != 0
 #define CHECK_SUSPEND_FLAGS()                               \
     do {                                                    \
@@ -1375,6 +1453,26 @@ wasm_interp_call_func_import(WASMModuleInstance *module_inst,
     } while (0)
 #endif
 
+#if WASM_ENABLE_THREAD_MGR != 0
+#define CHECK_BR_SUSPEND_FLAGS() CHECK_SUSPEND_FLAGS()
+#else
+#define CHECK_BR_SUSPEND_FLAGS() (void)0
+#endif
+
+/* i32 compare fused with br_if by the loader, the two operand
+   offsets of the compare are followed by the br_if info */
+#define DEF_OP_BR_IF_CMP(src_type, cond_op)                         \
+    do {                                                            \
+        CHECK_BR_SUSPEND_FLAGS();                                   \
+        cond = (uint32)(GET_OPERAND(src_type, I32, 2)               \
+                            cond_op GET_OPERAND(src_type, I32, 0)); \
+        frame_ip += 4;                                              \
+        if (cond)                                                   \
+            goto recover_br_info;                                   \
+        else                                                        \
+            SKIP_BR_INFO();                                         \
+    } while (0)
+
 #if WASM_ENABLE_OPCODE_COUNTER != 0
 typedef struct OpcodeInfo {
     char *name;
@@ -1390,20 +1488,60 @@ DEFINE_GOTO_TABLE(OpcodeInfo, opcode_table);
 #undef HANDLE_OPCODE
 /* clang-format on */
 
+/* Execution count of each pair of adjacent opcodes, which is used to
+   choose the opcode sequences fused into superinstructions */
+static uint64 opcode_pair_count[WASM_INSTRUCTION_NUM][WASM_INSTRUCTION_NUM];
+static uint8 last_opcode;
+
+#define COUNT_OPCODE_PAIR(opcode)                 \
+    do {                                          \
+        opcode_pair_count[last_opcode][opcode]++; \
+        last_opcode = opcode;                     \
+    } while (0)
+
+#define OPCODE_PAIR_DUMP_NUM 32
+
 static void
 wasm_interp_dump_op_count()
 {
-    uint32 i;
-    uint64 total_count = 0;
-    for (i = 0; i < WASM_OP_IMPDEP; i++)
+    uint32 i, k, max_index = 0, last_index = 0;
+    uint64 total_count = 0, count, max_count, last_count = 0;
+    char *name1, *name2;
+    /* The extended opcodes emitted by the loader are counted too */
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++)
         total_count += opcode_table[i].count;
 
     os_printf("total opcode count: %ld\n", total_count);
-    for (i = 0; i < WASM_OP_IMPDEP; i++)
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++)
         if (opcode_table[i].count > 0)
             os_printf("\t\t%s count:\t\t%ld,\t\t%.2f%%\n", opcode_table[i].name,
                       opcode_table[i].count,
                       opcode_table[i].count * 100.0f / total_count);
+
+    /* Dump the most frequent opcode pairs in descending order */
+    os_printf("most frequent opcode pairs:\n");
+    for (k = 0; k < OPCODE_PAIR_DUMP_NUM; k++) {
+        max_count = 0;
+        for (i = 0; i < WASM_INSTRUCTION_NUM * WASM_INSTRUCTION_NUM; i++) {
+            count = opcode_pair_count[i / WASM_INSTRUCTION_NUM]
+                                     [i % WASM_INSTRUCTION_NUM];
+            if (count > max_count
+                && (k == 0 || count < last_count
+                    || (count == last_count && i > last_index))) {
+                max_count = count;
+                max_index = i;
+            }
+        }
+        if (max_count == 0)
+            break;
+        name1 = opcode_table[max_index / WASM_INSTRUCTION_NUM].name;
+        name2 = opcode_table[max_index % WASM_INSTRUCTION_NUM].name;
+        os_printf("\t\t%s, %s count:\t\t%ld,\t\t%.2f%%\n",
+                  name1 ? name1 : "unknown", name2 ? name2 : "unknown",
+                  max_count, max_count * 100.0f / total_count);
+        last_count = max_count;
+        last_index = max_index;
+    }
 }
 #endif
 
@@ -1411,7 +1549,10 @@ wasm_interp_dump_op_count()
 
 /* #define HANDLE_OP(opcode) HANDLE_##opcode:printf(#opcode"\n"); */
 #if WASM_ENABLE_OPCODE_COUNTER != 0
-#define HANDLE_OP(opcode) HANDLE_##opcode : opcode_table[opcode].count++;
+#define HANDLE_OP(opcode)          \
+    HANDLE_##opcode:               \
+    opcode_table[opcode].count++; \
+    COUNT_OPCODE_PAIR(opcode);
 #else
 #define HANDLE_OP(opcode) HANDLE_##opcode:
 #endif
@@ -1545,6 +1686,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_TAIL_CALL != 0 || WASM_ENABLE_GC != 0
     bool is_return_call = false;
 #endif
+#if WASM_ENABLE_EXCE_HANDLING != 0
+    /* the exception being thrown, its values are kept above the wasm stack
+       top until it is caught */
+    uint32 exception_tag_index = 0, exception_cell_num = 0;
+    uint32 *exception_values = NULL;
+#endif
 #if WASM_ENABLE_SHARED_HEAP != 0
     WASMSharedHeap *shared_heap = module->e ? module->e->shared_heap : NULL;
     uint8 *shared_heap_base_addr = shared_heap ? shared_heap->base_addr : NULL;
@@ -1642,6 +1789,79 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+            HANDLE_OP(EXT_OP_BR_IF_I32_EQZ)
+            {
+                CHECK_BR_SUSPEND_FLAGS();
+                cond = frame_lp[GET_OFFSET()];
+
+                if (!cond)
+                    goto recover_br_info;
+                else
+                    SKIP_BR_INFO();
+
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_EQ)
+            {
+                DEF_OP_BR_IF_CMP(uint32, ==);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_NE)
+            {
+                DEF_OP_BR_IF_CMP(uint32, !=);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LT_S)
+            {
+                DEF_OP_BR_IF_CMP(int32, <);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LT_U)
+            {
+                DEF_OP_BR_IF_CMP(uint32, <);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GT_S)
+            {
+                DEF_OP_BR_IF_CMP(int32, >);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GT_U)
+            {
+                DEF_OP_BR_IF_CMP(uint32, >);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LE_S)
+            {
+                DEF_OP_BR_IF_CMP(int32, <=);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LE_U)
+            {
+                DEF_OP_BR_IF_CMP(uint32, <=);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GE_S)
+            {
+                DEF_OP_BR_IF_CMP(int32, >=);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GE_U)
+            {
+                DEF_OP_BR_IF_CMP(uint32, >=);
+                HANDLE_OP_END();
+            }
+
             HANDLE_OP(WASM_OP_BR_TABLE)
             {
                 uint32 arity, br_item_size;
@@ -1734,6 +1954,9 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
             {
                 WASMFuncType *cur_type, *cur_func_type;
                 WASMTableInstance *tbl_inst;
+#if WASM_ENABLE_GC != 0
+                WASMCallIndirectCache *cache;
+#endif
                 uint32 tbl_idx;
 
 #if WASM_ENABLE_TAIL_CALL != 0
@@ -1749,6 +1972,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 tbl_idx = read_uint32(frame_ip);
                 bh_assert(tbl_idx < module->table_count);
 
+#if WASM_ENABLE_GC != 0
+                cache = (WASMCallIndirectCache *)LOAD_PTR(frame_ip);
+                frame_ip += sizeof(WASMCallIndirectCache *);
+#endif
+
                 tbl_inst = wasm_get_table_inst(module, tbl_idx);
 
                 val = GET_OPERAND(uint32, I32, 0);
@@ -1776,6 +2004,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #endif
                 /* clang-format on */
 
+#if WASM_ENABLE_GC == 0
                 /*
                  * we might be using a table injected by host or
                  * another module. in that case, we don't validate
@@ -1794,19 +2023,51 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 else
                     cur_func_type = cur_func->u.func->func_type;
 
-                    /* clang-format off */
-#if WASM_ENABLE_GC == 0
                 if (cur_type != cur_func_type) {
                     wasm_set_exception(module, "indirect call type mismatch");
                     goto got_exception;
                 }
 #else
-                if (!wasm_func_type_is_super_of(cur_type, cur_func_type)) {
-                    wasm_set_exception(module, "indirect call type mismatch");
-                    goto got_exception;
+                /* The function was called here before, so the index is
+                   known to be valid and its type to match: skip the checks.
+                   The cache is keyed by the function index rather than by
+                   the table element, so table.set and table.grow don't
+                   need to invalidate it. */
+                if (fidx == cache->func_idxs[0]
+                    || fidx == cache->func_idxs[1]) {
+                    cur_func = module->e->functions + fidx;
+                }
+                else {
+                    /*
+                     * we might be using a table injected by host or
+                     * another module. in that case, we don't validate
+                     * the elem value while loading
+                     */
+                    if (fidx >= module->e->function_count) {
+                        wasm_set_exception(module, "unknown function");
+                        goto got_exception;
+                    }
+
+                    /* always call module own functions */
+                    cur_func = module->e->functions + fidx;
+
+                    if (cur_func->is_import_func)
+                        cur_func_type = cur_func->u.func_import->func_type;
+                    else
+                        cur_func_type = cur_func->u.func->func_type;
+
+                    if (!wasm_func_type_is_super_of(cur_type, cur_func_type)) {
+                        wasm_set_exception(module,
+                                           "indirect call type mismatch");
+                        goto got_exception;
+                    }
+
+                    /* Remember the latest callees, the entries are only
+                       written with checked indexes */
+                    cache->func_idxs[1] = cache->func_idxs[0];
+                    cache->func_idxs[0] = fidx;
                 }
 #endif
-                /* clang-format on */
 
 #if WASM_ENABLE_TAIL_CALL != 0
                 if (opcode == WASM_OP_RETURN_CALL_INDIRECT)
@@ -1816,10 +2077,51 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
             }
 
 #if WASM_ENABLE_EXCE_HANDLING != 0
-            HANDLE_OP(WASM_OP_TRY)
-            HANDLE_OP(WASM_OP_CATCH)
             HANDLE_OP(WASM_OP_THROW)
+            {
+                WASMFuncType *tag_type;
+                uint32 *values, i, cell_num;
+
+                exception_tag_index = read_uint32(frame_ip);
+                tag_type = get_tag_type(module, exception_tag_index);
+                bh_assert(tag_type);
+
+                exception_cell_num = tag_type->param_cell_num;
+                if (!(exception_values = alloc_exception_values(
+                          exec_env, exception_cell_num)))
+                    goto got_exception;
+
+                /* the loader emits the offsets of the tag params */
+                for (i = 0, values = exception_values;
+                     i < tag_type->param_count; i++) {
+                    cell_num = wasm_value_type_cell_num(tag_type->types[i]);
+                    word_copy(values, frame_lp + GET_OFFSET(), cell_num);
+                    values += cell_num;
+                }
+                goto find_a_catch_handler;
+            }
+
             HANDLE_OP(WASM_OP_RETHROW)
+            {
+                WASMFuncType *tag_type;
+                /* the tag index and the values saved by the catch clause */
+                uint32 *exception = frame_lp + GET_OFFSET();
+
+                exception_tag_index = exception[0];
+                tag_type = get_tag_type(module, exception_tag_index);
+                exception_cell_num = tag_type ? tag_type->param_cell_num : 0;
+                if (!(exception_values = alloc_exception_values(
+                          exec_env, exception_cell_num)))
+                    goto got_exception;
+
+                word_copy(exception_values, exception + 1, exception_cell_num);
+                goto find_a_catch_handler;
+            }
+
+            /* try is skipped and catch, catch_all are replaced with else
+               by the loader, delegate is skipped too */
+            HANDLE_OP(WASM_OP_TRY)
+            HANDLE_OP(WASM_OP_CATCH)
             HANDLE_OP(WASM_OP_DELEGATE)
             HANDLE_OP(WASM_OP_CATCH_ALL)
             HANDLE_OP(EXT_OP_TRY)
@@ -7497,6 +7799,10 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         uint32 *lp_base = NULL, *lp = NULL;
         int i;
 
+        /* The args are copied after the consts of the callee */
+        if (!WASM_PREPARE_FUNC_LAZILY(module, cur_func))
+            goto got_exception;
+
         if (cur_func->param_cell_num > 0
             && !(lp_base = lp = wasm_runtime_malloc(cur_func->param_cell_num
                                                     * sizeof(uint32)))) {
@@ -7537,8 +7843,18 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         WASMInterpFrame *outs_area = wasm_exec_env_wasm_stack_top(exec_env);
         int i;
 
+        /* The args are copied after the consts of the callee, which are
+           known after the callee is prepared */
 #if WASM_ENABLE_MULTI_MODULE != 0
         if (cur_func->is_import_func) {
+            if (cur_func->import_func_inst
+                && !WASM_PREPARE_FUNC_LAZILY(cur_func->import_module_inst,
+                                             cur_func->import_func_inst)) {
+                /* The detailed exception is set to the sub module */
+                wasm_set_exception(module,
+                                   "failed to prepare import function");
+                goto got_exception;
+            }
             outs_area->lp = outs_area->operand
                             + (cur_func->import_func_inst
                                    ? cur_func->import_func_inst->const_cell_num
@@ -7547,6 +7863,8 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         else
 #endif
         {
+            if (!WASM_PREPARE_FUNC_LAZILY(module, cur_func))
+                goto got_exception;
             outs_area->lp = outs_area->operand + cur_func->const_cell_num;
         }
 
@@ -7648,8 +7966,38 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
             if (memory)
                 linear_mem_size = GET_LINEAR_MEMORY_SIZE(memory);
 #endif
-            if (wasm_copy_exception(module, NULL))
+            if (wasm_copy_exception(module, NULL)) {
+#if WASM_ENABLE_EXCE_HANDLING != 0
+                char uncaught_exception[128] = { 0 };
+                WASMInterpFrame *native_frame =
+                    wasm_exec_env_get_cur_frame(exec_env);
+                WASMFuncType *tag_type;
+
+                wasm_copy_exception(module, uncaught_exception);
+                /* libc_builtin signaled a "exception thrown by stdc++" trap,
+                   throw it as the exception of tag 0 into the caller */
+                if (native_frame->prev_frame == frame && !native_frame->ip
+                    && strstr(uncaught_exception,
+                              "exception thrown by stdc++")) {
+                    /* the native frame isn't freed when the call fails */
+                    FREE_FRAME(exec_env, native_frame);
+                    wasm_exec_env_set_cur_frame(exec_env, frame);
+
+                    exception_tag_index = 0;
+                    tag_type = get_tag_type(module, exception_tag_index);
+                    exception_cell_num =
+                        tag_type ? tag_type->param_cell_num : 0;
+                    if (!(exception_values = alloc_exception_values(
+                              exec_env, exception_cell_num)))
+                        goto got_exception;
+                    wasm_set_exception(module, NULL);
+                    memset(exception_values, 0,
+                           sizeof(uint32) * exception_cell_num);
+                    goto find_a_catch_handler;
+                }
+#endif
                 goto got_exception;
+            }
         }
         else {
             WASMFunction *cur_wasm_func = cur_func->u.func;
@@ -7746,6 +8094,63 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         HANDLE_OP_END();
     }
 
+#if WASM_ENABLE_EXCE_HANDLING != 0
+    find_a_catch_handler:
+    {
+        WASMCatchHandler *handler;
+        uint32 *exception;
+
+        /* frame_ip points to the end of the throwing instruction, or of the
+           call instruction in the callers */
+        while (!(handler = find_catch_handler(cur_func->u.func, frame_ip - 1,
+                                              exception_tag_index))) {
+            /* not caught in this function, unwind to the caller */
+            FREE_FRAME(exec_env, frame);
+            wasm_exec_env_set_cur_frame(exec_env,
+                                        (WASMRuntimeFrame *)prev_frame);
+
+            if (!prev_frame->ip) {
+                /* Called from native. */
+                wasm_set_exception(module, "uncaught wasm exception");
+                return;
+            }
+
+            RECOVER_CONTEXT(prev_frame);
+#if WASM_ENABLE_GC != 0
+            local_cell_num =
+                cur_func->param_cell_num + cur_func->local_cell_num;
+#endif
+        }
+
+        /* save the exception for rethrow, and pass the values to the
+           catch clause of the tag */
+        exception = frame_lp + handler->exception_offset;
+        exception[0] = exception_tag_index;
+        word_copy(exception + 1, exception_values, exception_cell_num);
+        if (!IS_INVALID_TAGINDEX(handler->tag_index)) {
+            word_copy(exception + 1 + exception_cell_num, exception_values,
+                      exception_cell_num);
+#if WASM_ENABLE_GC != 0
+            {
+                WASMFuncType *tag_type =
+                    get_tag_type(module, exception_tag_index);
+                uint32 i, cell_offset = handler->exception_offset + 1
+                                        + exception_cell_num;
+
+                for (i = 0; i < tag_type->param_count; i++) {
+                    if (wasm_is_type_reftype(tag_type->types[i]))
+                        SET_FRAME_REF(cell_offset);
+                    cell_offset +=
+                        wasm_value_type_cell_num(tag_type->types[i]);
+                }
+            }
+#endif
+        }
+        frame_ip = handler->handler_addr;
+        HANDLE_OP_END();
+    }
+#endif /* end of WASM_ENABLE_EXCE_HANDLING != 0 */
+
         (void)frame_ip_end;
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -7869,6 +8274,10 @@ wasm_interp_call_wasm(WASMModuleInstance *module_inst, WASMExecEnv *exec_env,
     }
 #endif
 
+    /* The args are copied after the consts of the function */
+    if (!WASM_PREPARE_FUNC_LAZILY(module_inst, function))
+        return;
+
     if (!(frame =
               ALLOC_FRAME(exec_env, frame_size, (WASMInterpFrame *)prev_frame)))
         return;
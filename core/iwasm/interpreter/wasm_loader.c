@@ -320,7 +320,7 @@ is_byte_a_type(uint8 type)
 
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
 static V128
 read_i8x16(uint8 *p_buf, char *error_buf, uint32 error_buf_size)
 {
@@ -334,7 +334,8 @@ read_i8x16(uint8 *p_buf, char *error_buf, uint32 error_buf_size)
     return result;
 }
 #endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
-          (WASM_ENABLE_FAST_INTERP != 0) */
+          (WASM_ENABLE_FAST_INTERP != 0) || \
+          (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 static void *
@@ -728,7 +729,7 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
                 break;
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
             /* v128.const */
             case INIT_EXPR_TYPE_V128_CONST:
             {
@@ -758,7 +759,8 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
                 break;
             }
 #endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
-          (WASM_ENABLE_FAST_INTERP != 0) */
+          (WASM_ENABLE_FAST_INTERP != 0) || \
+          (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_REF_TYPES != 0 || WASM_ENABLE_GC != 0
@@ -1341,6 +1343,8 @@ destroy_wasm_type(WASMType *type)
         return;
     }
 
+    wasm_type_destroy_supers(type);
+
     if (type->type_flag == WASM_TYPE_FUNC)
         destroy_func_type((WASMFuncType *)type);
     else if (type->type_flag == WASM_TYPE_STRUCT)
@@ -2135,6 +2139,12 @@ load_type_section(const uint8 *buf, const uint8 *buf_end, WASMModule *module,
                     cur_type->root_type = cur_type;
                     cur_type->inherit_depth = 0;
                 }
+
+                if (!wasm_type_init_supers(cur_type)) {
+                    set_error_buf(error_buf, error_buf_size,
+                                  "allocate memory failed");
+                    return false;
+                }
             }
 
             for (j = 0; j < rec_count; j++) {
@@ -4179,7 +4189,7 @@ load_export_section(const uint8 *buf, const uint8 *buf_end, WASMModule *module,
                     }
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
                     /* TODO: check func type, if it has v128 param or result,
                              report error */
 #endif
@@ -5414,6 +5424,14 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
         (bool *)((uint8 *)module->func_ptrs
                  + sizeof(void *) * module->function_count);
 
+#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+    size = sizeof(WASMTierUpEntry) * (uint64)module->function_count;
+    if (!(module->tierup_queue =
+              loader_malloc(size, error_buf, error_buf_size))) {
+        return false;
+    }
+#endif
+
     module->comp_data = aot_create_comp_data(module, NULL, gc_enabled);
     if (!module->comp_data) {
         aot_last_error = aot_get_last_error();
@@ -5427,6 +5445,7 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
     option.opt_level = llvm_jit_options->opt_level;
     option.size_level = llvm_jit_options->size_level;
     option.segue_flags = llvm_jit_options->segue_flags;
+    option.jit_cache_dir = llvm_jit_options->cache_dir;
     option.quick_invoke_c_api_import =
         llvm_jit_options->quick_invoke_c_api_import;
 
@@ -5635,7 +5654,37 @@ orcjit_thread_callback(void *arg)
     os_mutex_unlock(&module->tierup_wait_lock);
 #endif
 
-#if WASM_ENABLE_JIT != 0
+#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+    /* Compile the hottest functions by llvm jit one by one, the functions
+       which don't get hot keep running the fast jit jitted code */
+    while (jit_compiler_get_tierup_func(module, &i)) {
+        LLVMOrcJITTargetAddress func_addr = 0;
+        LLVMErrorRef error;
+        char func_name[48];
+
+        snprintf(func_name, sizeof(func_name), "%s%d", AOT_FUNC_PREFIX,
+                 i - module->import_function_count);
+        LOG_DEBUG("compile llvm jit func %s", func_name);
+        error = LLVMOrcLLLazyJITCompileFunction(comp_ctx->orc_jit, &func_addr,
+                                                func_name);
+        if (error != LLVMErrorSuccess) {
+            char *err_msg = LLVMGetErrorMessage(error);
+            LOG_ERROR("failed to compile llvm jit function %u: %s", i, err_msg);
+            LLVMDisposeErrorMessage(err_msg);
+            /* Ignore current llvm jit func, as its func ptr is
+               previous set to call_to_fast_jit, which also works */
+            continue;
+        }
+
+        jit_compiler_set_llvm_jit_func_ptr(module, i, (void *)func_addr);
+        module->func_ptrs_compiled[i - module->import_function_count] = true;
+
+        /* Switch to call this llvm jit function instead of fast jit
+           function from fast jit jitted code */
+        jit_compiler_set_call_to_llvm_jit(module, i);
+    }
+#elif WASM_ENABLE_JIT != 0
     /* Compile llvm jit functions of this group */
     for (i = group_idx; i < func_count;
          i += group_stride * WASM_ORC_JIT_COMPILE_THREAD_NUM) {
@@ -5670,32 +5719,6 @@ orcjit_thread_callback(void *arg)
         for (j = 0; j < WASM_ORC_JIT_COMPILE_THREAD_NUM; j++) {
             if (i + j * group_stride < func_count) {
                 module->func_ptrs_compiled[i + j * group_stride] = true;
-#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
-                snprintf(func_name, sizeof(func_name), "%s%d", AOT_FUNC_PREFIX,
-                         i + j * group_stride);
-                error = LLVMOrcLLLazyJITLookup(comp_ctx->orc_jit, &func_addr,
-                                               func_name);
-                if (error != LLVMErrorSuccess) {
-                    char *err_msg = LLVMGetErrorMessage(error);
-                    LOG_ERROR("failed to compile llvm jit function %u: %s", i,
-                              err_msg);
-                    LLVMDisposeErrorMessage(err_msg);
-                    /* Ignore current llvm jit func, as its func ptr is
-                       previous set to call_to_fast_jit, which also works */
-                    continue;
-                }
-
-                jit_compiler_set_llvm_jit_func_ptr(
-                    module,
-                    i + j * group_stride + module->import_function_count,
-                    (void *)func_addr);
-
-                /* Try to switch to call this llvm jit function instead of
-                   fast jit function from fast jit jitted code */
-                jit_compiler_set_call_to_llvm_jit(
-                    module,
-                    i + j * group_stride + module->import_function_count);
-#endif
             }
         }
 
@@ -5703,6 +5726,14 @@ orcjit_thread_callback(void *arg)
             break;
         }
     }
+
+    /* All the llvm jit functions are compiled when the last thread
+       finishes its group, save the jit cache then */
+    if (i >= func_count
+        && BH_ATOMIC_32_FETCH_ADD(module->orcjit_finished_threads, 1) + 1
+               == (func_count < group_stride ? func_count : group_stride)) {
+        aot_save_jit_cache(comp_ctx);
+    }
 #endif
 
     return NULL;
@@ -6178,9 +6209,18 @@ load_from_sections(WASMModule *module, WASMSection *sections,
 
     for (i = 0; i < module->function_count; i++) {
         WASMFunction *func = module->functions[i];
-        if (!wasm_loader_prepare_bytecode(module, func, i, error_buf,
-                                          error_buf_size)) {
-            return false;
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+        if (module->is_lazy_validation) {
+            /* Validate and prepare the function on its first call */
+            func->lazy_state = WASM_FUNC_PENDING;
+        }
+        else
+#endif
+        {
+            if (!wasm_loader_prepare_bytecode(module, func, i, error_buf,
+                                              error_buf_size)) {
+                return false;
+            }
         }
 
         if (i == module->function_count - 1
@@ -6191,6 +6231,13 @@ load_from_sections(WASMModule *module, WASMSection *sections,
         }
     }
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    if (module->is_lazy_validation) {
+        /* The function bodies haven't been checked for memory.grow yet */
+        module->possible_memory_grow = true;
+    }
+#endif
+
     if (!module->possible_memory_grow) {
 #if WASM_ENABLE_SHRUNK_MEMORY != 0
         if (aux_data_end_global && aux_heap_base_global
@@ -6771,6 +6818,19 @@ wasm_loader_load(uint8 *buf, uint32 size,
     module->load_size = size;
 #endif
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    /* The function bodies are read from the wasm binary buffer when they
+       are called, so it must be kept */
+    if (args->lazy_validation && !args->wasm_binary_freeable) {
+        if (os_mutex_init(&module->lazy_validation_lock) != 0) {
+            set_error_buf(error_buf, error_buf_size,
+                          "init lazy validation lock failed");
+            goto fail;
+        }
+        module->is_lazy_validation = true;
+    }
+#endif
+
     if (!load(buf, size, module, args->wasm_binary_freeable, args->no_resolve,
               error_buf, error_buf_size)) {
         goto fail;
@@ -6831,6 +6891,13 @@ wasm_loader_unload(WASMModule *module)
         os_mutex_destroy(&module->tierup_wait_lock);
         os_cond_destroy(&module->tierup_wait_cond);
     }
+    if (module->tierup_queue)
+        wasm_runtime_free(module->tierup_queue);
+#endif
+
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    if (module->is_lazy_validation)
+        os_mutex_destroy(&module->lazy_validation_lock);
 #endif
 
     if (module->imports)
@@ -6846,6 +6913,17 @@ wasm_loader_unload(WASMModule *module)
                     wasm_runtime_free(module->functions[i]->code_compiled);
                 if (module->functions[i]->consts)
                     wasm_runtime_free(module->functions[i]->consts);
+#if WASM_ENABLE_GC != 0
+                if (module->functions[i]->call_indirect_caches)
+                    wasm_runtime_free(
+                        module->functions[i]->call_indirect_caches);
+#endif
+#if WASM_ENABLE_EXCE_HANDLING != 0
+                if (module->functions[i]->try_blocks)
+                    wasm_runtime_free(module->functions[i]->try_blocks);
+                if (module->functions[i]->catch_handlers)
+                    wasm_runtime_free(module->functions[i]->catch_handlers);
+#endif
 #endif
 #if WASM_ENABLE_FAST_JIT != 0
                 if (module->functions[i]->fast_jit_jitted_code) {
@@ -6940,14 +7018,7 @@ wasm_loader_unload(WASMModule *module)
         wasm_runtime_free(module->types);
     }
 
-    if (module->const_str_list) {
-        StringNode *node = module->const_str_list, *node_next;
-        while (node) {
-            node_next = node->next;
-            wasm_runtime_free(node);
-            node = node_next;
-        }
-    }
+    wasm_const_str_pool_destroy(&module->const_str_pool);
 
 #if WASM_ENABLE_STRINGREF != 0
     if (module->string_literal_ptrs) {
@@ -7046,6 +7117,41 @@ wasm_loader_unload(WASMModule *module)
     wasm_runtime_free(module);
 }
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+bool
+wasm_loader_prepare_func_lazily(WASMModule *module, WASMFunction *func,
+                                char *error_buf, uint32 error_buf_size)
+{
+    bool ret = false;
+
+    if (BH_ATOMIC_32_LOAD(func->lazy_state) == WASM_FUNC_PREPARED)
+        return true;
+
+    /* Only one thread prepares the function, the others wait for it */
+    os_mutex_lock(&module->lazy_validation_lock);
+    switch (BH_ATOMIC_32_LOAD(func->lazy_state)) {
+        case WASM_FUNC_PREPARED:
+            ret = true;
+            break;
+        case WASM_FUNC_PENDING:
+            /* The code and consts allocated on failure are freed when the
+               module is unloaded, so the function isn't validated again */
+            ret = wasm_loader_prepare_bytecode(module, func, 0, error_buf,
+                                               error_buf_size);
+            BH_ATOMIC_32_STORE(func->lazy_state, ret ? WASM_FUNC_PREPARED
+                                                     : WASM_FUNC_INVALID);
+            break;
+        default:
+            set_error_buf(error_buf, error_buf_size,
+                          "function body validation failed");
+            break;
+    }
+    os_mutex_unlock(&module->lazy_validation_lock);
+
+    return ret;
+}
+#endif /* end of WASM_ENABLE_LAZY_VALIDATION != 0 */
+
 bool
 wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
                             const uint8 *start_addr, const uint8 *code_end_addr,
@@ -7733,7 +7839,7 @@ wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
 
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
             case WASM_OP_SIMD_PREFIX:
             {
                 uint32 opcode1;
@@ -7827,7 +7933,8 @@ wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
                 break;
             }
 #endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
-          (WASM_ENABLE_FAST_INTERP != 0) */
+          (WASM_ENABLE_FAST_INTERP != 0) || \
+          (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -7934,6 +8041,13 @@ typedef struct BranchBlock {
      * to copy the stack operands to the loop block's arguments in
      * wasm_loader_emit_br_info for opcode br. */
     uint16 start_dynamic_offset;
+#if WASM_ENABLE_EXCE_HANDLING != 0
+    /* index of the try block in func->try_blocks */
+    int32 try_index;
+    /* offset of the slots saving the exception caught by the current
+       catch clause, used by rethrow */
+    uint16 exception_offset;
+#endif
 #endif
 
     /* Indicate the operand stack is in polymorphic state.
@@ -8015,6 +8129,18 @@ typedef struct WASMLoaderContext {
      * than the final code_compiled_size, we record the peak size to ensure
      * there will not be invalid memory access during second traverse */
     uint32 code_compiled_peak_size;
+#if WASM_ENABLE_GC != 0
+    /* count of call_indirect opcodes, their inline caches are allocated
+       with the count of the first traverse */
+    uint32 call_indirect_cache_num;
+#endif
+
+#if WASM_ENABLE_EXCE_HANDLING != 0
+    /* count of try blocks and catch clauses, the tables are allocated
+       with the counts of the first traverse and filled in the second */
+    uint32 try_block_num;
+    uint32 catch_handler_num;
+#endif
 #endif
 } WASMLoaderContext;
 
@@ -9132,6 +9258,23 @@ wasm_loader_emit_ptr(WASMLoaderContext *ctx, void *value)
     }
 }
 
+#if WASM_ENABLE_GC != 0
+static void
+wasm_loader_emit_call_indirect_cache(WASMLoaderContext *ctx,
+                                     WASMFunction *func)
+{
+    WASMCallIndirectCache *cache = NULL;
+
+    if (ctx->p_code_compiled) {
+        bh_assert(ctx->call_indirect_cache_num
+                  < func->call_indirect_cache_count);
+        cache = func->call_indirect_caches + ctx->call_indirect_cache_num;
+    }
+    ctx->call_indirect_cache_num++;
+    wasm_loader_emit_ptr(ctx, cache);
+}
+#endif
+
 static void
 wasm_loader_emit_backspace(WASMLoaderContext *ctx, uint32 size)
 {
@@ -10223,7 +10366,7 @@ check_memory_access_align(uint8 opcode, uint32 align, char *error_buf,
 
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
 static bool
 check_simd_memory_access_align(uint8 opcode, uint32 align, char *error_buf,
                                uint32 error_buf_size)
@@ -10338,7 +10481,8 @@ check_simd_shuffle_mask(V128 mask, char *error_buf, uint32 error_buf_size)
     }
     return true;
 }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
+          (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -10534,7 +10678,9 @@ wasm_loader_check_br(WASMLoaderContext *loader_ctx, uint32 depth, uint8 opcode,
         }
 
 #if WASM_ENABLE_FAST_INTERP != 0
-        emit_br_info(target_block, opcode == WASM_OP_BR);
+        /* rethrow only refers to the label of a catch clause */
+        if (opcode != WASM_OP_RETHROW)
+            emit_br_info(target_block, opcode == WASM_OP_BR);
 #endif
 
         /* Restore the stack data, note that frame_ref_bottom,
@@ -10632,7 +10778,8 @@ wasm_loader_check_br(WASMLoaderContext *loader_ctx, uint32 depth, uint8 opcode,
     }
 
 #if WASM_ENABLE_FAST_INTERP != 0
-    emit_br_info(target_block, opcode == WASM_OP_BR);
+    if (opcode != WASM_OP_RETHROW)
+        emit_br_info(target_block, opcode == WASM_OP_BR);
 #endif
 
     ret = true;
@@ -10653,6 +10800,58 @@ fail:
     return ret;
 }
 
+#if WASM_ENABLE_FAST_INTERP != 0
+/* The i32 compares fused with br_if, from i32.eqz to i32.ge_u */
+static const uint8 br_if_cmp_opcodes[] = {
+    EXT_OP_BR_IF_I32_EQZ,  EXT_OP_BR_IF_I32_EQ,   EXT_OP_BR_IF_I32_NE,
+    EXT_OP_BR_IF_I32_LT_S, EXT_OP_BR_IF_I32_LT_U, EXT_OP_BR_IF_I32_GT_S,
+    EXT_OP_BR_IF_I32_GT_U, EXT_OP_BR_IF_I32_LE_S, EXT_OP_BR_IF_I32_LE_U,
+    EXT_OP_BR_IF_I32_GE_S, EXT_OP_BR_IF_I32_GE_U,
+};
+
+/*
+ * Replace the last emitted i32 compare and the br_if label with one
+ * fused instruction which reads the operands of the compare directly,
+ * the compare result is popped without being emitted. The caller then
+ * emits the br_if info as usual.
+ */
+static bool
+fuse_i32_cmp_and_br_if(WASMLoaderContext *loader_ctx, uint8 cmp_opcode,
+                       char *error_buf, uint32 error_buf_size)
+{
+    int16 src_offsets[2] = { 0 };
+    uint32 src_count = cmp_opcode == WASM_OP_I32_EQZ ? 1 : 2, i;
+
+    bh_assert(cmp_opcode >= WASM_OP_I32_EQZ && cmp_opcode <= WASM_OP_I32_GE_U);
+
+    /* skip the br_if label and the result offset of the compare */
+    skip_label();
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16));
+
+    /* the operand offsets are only available in the second traverse */
+    if (loader_ctx->p_code_compiled) {
+        for (i = 0; i < src_count; i++)
+            src_offsets[i] = LOAD_I16(loader_ctx->p_code_compiled
+                                      - sizeof(int16) * (src_count - i));
+    }
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16) * src_count);
+    skip_label();
+
+    emit_label(br_if_cmp_opcodes[cmp_opcode - WASM_OP_I32_EQZ]);
+    for (i = 0; i < src_count; i++)
+        emit_operand(loader_ctx, src_offsets[i]);
+
+    /* pop the compare result, which isn't emitted any more */
+    loader_ctx->frame_offset--;
+    if ((*(loader_ctx->frame_offset) > loader_ctx->start_dynamic_offset)
+        && (*(loader_ctx->frame_offset) < loader_ctx->max_dynamic_offset))
+        loader_ctx->dynamic_offset--;
+
+    return wasm_loader_pop_frame_ref(loader_ctx, VALUE_TYPE_I32, error_buf,
+                                     error_buf_size);
+}
+#endif /* end of WASM_ENABLE_FAST_INTERP != 0 */
+
 static BranchBlock *
 check_branch_block(WASMLoaderContext *loader_ctx, uint8 **p_buf, uint8 *buf_end,
                    uint8 opcode, char *error_buf, uint32 error_buf_size)
@@ -10702,15 +10901,130 @@ check_branch_block_for_delegate(WASMLoaderContext *loader_ctx, uint8 **p_buf,
         goto fail;
     }
     frame_csp_tmp = loader_ctx->frame_csp - depth - 2;
-#if WASM_ENABLE_FAST_INTERP != 0
-    emit_br_info(frame_csp_tmp, false);
-#endif
 
     *p_buf = p;
     return frame_csp_tmp;
 fail:
     return NULL;
 }
+
+#if WASM_ENABLE_FAST_INTERP != 0
+/* Get the index of the innermost try block whose try body contains the
+   block, including the block itself, -1 if there is none */
+static int32
+get_enclosing_try_index(WASMLoaderContext *loader_ctx, BranchBlock *block)
+{
+    for (; block >= loader_ctx->frame_csp_bottom; block--) {
+        if (block->label_type == LABEL_TYPE_TRY)
+            return block->try_index;
+    }
+    return -1;
+}
+
+/* Add the current block to the try blocks, its try body starts here */
+static void
+add_try_block(WASMLoaderContext *loader_ctx, WASMFunction *func)
+{
+    BranchBlock *block = loader_ctx->frame_csp - 1;
+    WASMTryBlock *try_block;
+
+    block->try_index = (int32)loader_ctx->try_block_num++;
+    /* the table is filled in the second traverse */
+    if (!loader_ctx->p_code_compiled)
+        return;
+
+    bh_assert((uint32)block->try_index < func->try_block_count);
+    try_block = func->try_blocks + block->try_index;
+    try_block->start_addr = try_block->end_addr = loader_ctx->p_code_compiled;
+    try_block->first_catch = -1;
+    try_block->next_try = get_enclosing_try_index(loader_ctx, block - 1);
+}
+
+static void
+set_try_block_end(WASMLoaderContext *loader_ctx, WASMFunction *func,
+                  BranchBlock *block)
+{
+    if (loader_ctx->p_code_compiled)
+        func->try_blocks[block->try_index].end_addr =
+            loader_ctx->p_code_compiled;
+}
+
+/*
+ * End the try body or the previous catch clause of the current block
+ * like opcode else does: copy the block results and jump to the end.
+ * Then start a catch clause, the slots saving the caught tag index and
+ * exception values for rethrow are reserved from the block results.
+ */
+static bool
+add_catch_handler(WASMLoaderContext *loader_ctx, WASMFunction *func,
+                  uint32 tag_index, uint32 exception_cell_num,
+                  bool disable_emit, char *error_buf, uint32 error_buf_size)
+{
+    BranchBlock *block = loader_ctx->frame_csp - 1;
+    WASMCatchHandler *handler;
+    int32 *p_catch_index, dynamic_offset;
+    uint32 handler_index;
+
+    /* the caller has replaced the label of catch with the label of else */
+    if (!reserve_block_ret(loader_ctx, WASM_OP_ELSE, disable_emit, error_buf,
+                           error_buf_size))
+        return false;
+    emit_empty_label_addr_and_frame_ip(PATCH_END);
+
+    if (block->label_type == LABEL_TYPE_TRY)
+        set_try_block_end(loader_ctx, func, block);
+
+    dynamic_offset =
+        (int32)block->dynamic_offset + 1 + (int32)exception_cell_num;
+    if (dynamic_offset >= INT16_MAX) {
+        set_error_buf(error_buf, error_buf_size,
+                      "fast interpreter offset overflow");
+        return false;
+    }
+    block->exception_offset = block->dynamic_offset;
+    loader_ctx->dynamic_offset = (int16)dynamic_offset;
+    if (loader_ctx->dynamic_offset > loader_ctx->max_dynamic_offset)
+        loader_ctx->max_dynamic_offset = loader_ctx->dynamic_offset;
+
+    handler_index = loader_ctx->catch_handler_num++;
+    if (!loader_ctx->p_code_compiled)
+        return true;
+
+    bh_assert(handler_index < func->catch_handler_count);
+    handler = func->catch_handlers + handler_index;
+    handler->handler_addr = loader_ctx->p_code_compiled;
+    handler->tag_index = tag_index;
+    handler->exception_offset = block->exception_offset;
+    handler->next_catch = -1;
+
+    /* append it to the catch clauses of the try block */
+    p_catch_index = &func->try_blocks[block->try_index].first_catch;
+    while (*p_catch_index >= 0)
+        p_catch_index = &func->catch_handlers[*p_catch_index].next_catch;
+    *p_catch_index = (int32)handler_index;
+    return true;
+fail:
+    return false;
+}
+
+/* The max cell num of the params of all tags, catch_all reserves it to
+   save any caught exception */
+static uint32
+get_max_tag_param_cell_num(const WASMModule *module)
+{
+    uint32 i, cell_num = 0;
+
+    for (i = 0; i < module->import_tag_count; i++) {
+        if (module->import_tags[i].u.tag.tag_type->param_cell_num > cell_num)
+            cell_num = module->import_tags[i].u.tag.tag_type->param_cell_num;
+    }
+    for (i = 0; i < module->tag_count; i++) {
+        if (module->tags[i]->tag_type->param_cell_num > cell_num)
+            cell_num = module->tags[i]->tag_type->param_cell_num;
+    }
+    return cell_num;
+}
+#endif /* end of WASM_ENABLE_FAST_INTERP != 0 */
 #endif /* end of WASM_ENABLE_EXCE_HANDLING != 0 */
 
 static bool
@@ -11289,6 +11603,38 @@ re_scan:
         func->code_compiled = loader_ctx->p_code_compiled;
         func->code_compiled_size = loader_ctx->code_compiled_size;
 
+#if WASM_ENABLE_GC != 0
+        if (loader_ctx->call_indirect_cache_num > 0) {
+            uint64 size = sizeof(WASMCallIndirectCache)
+                          * (uint64)loader_ctx->call_indirect_cache_num;
+
+            if (!(func->call_indirect_caches =
+                      loader_malloc(size, error_buf, error_buf_size)))
+                goto fail;
+            /* all the entries are unused */
+            memset(func->call_indirect_caches, 0xFF, (uint32)size);
+        }
+        func->call_indirect_cache_count = loader_ctx->call_indirect_cache_num;
+        loader_ctx->call_indirect_cache_num = 0;
+#endif
+
+#if WASM_ENABLE_EXCE_HANDLING != 0
+        if (loader_ctx->try_block_num > 0
+            && !(func->try_blocks = loader_malloc(
+                     sizeof(WASMTryBlock) * (uint64)loader_ctx->try_block_num,
+                     error_buf, error_buf_size)))
+            goto fail;
+        func->try_block_count = loader_ctx->try_block_num;
+        if (loader_ctx->catch_handler_num > 0
+            && !(func->catch_handlers = loader_malloc(
+                     sizeof(WASMCatchHandler)
+                         * (uint64)loader_ctx->catch_handler_num,
+                     error_buf, error_buf_size)))
+            goto fail;
+        func->catch_handler_count = loader_ctx->catch_handler_num;
+        loader_ctx->try_block_num = loader_ctx->catch_handler_num = 0;
+#endif
+
         if (loader_ctx->i64_const_num > 0) {
             int64 *i64_consts_old = loader_ctx->i64_consts;
 
@@ -11652,6 +11998,15 @@ re_scan:
 #if WASM_ENABLE_EXCE_HANDLING != 0
                 else if (opcode == WASM_OP_TRY) {
                     skip_label();
+
+                    if (BLOCK_HAS_PARAM(block_type)) {
+                        /* Make sure params are in dynamic space */
+                        if (!copy_params_to_dynamic_space(loader_ctx, error_buf,
+                                                          error_buf_size))
+                            goto fail;
+                    }
+
+                    add_try_block(loader_ctx, func);
                 }
 #endif
                 else if (opcode == WASM_OP_IF) {
@@ -11817,6 +12172,26 @@ re_scan:
                 param_count = func->func_type->param_count;
 #endif
 
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* Emit the tag index and the offset of each tag param, the
+                   params may be missing only if the throw is unreachable */
+                emit_uint32(loader_ctx, tag_index);
+                if (loader_ctx->stack_cell_num - cur_block->stack_cell_num
+                    >= tag_type->param_cell_num) {
+                    int16 *frame_offset =
+                        loader_ctx->frame_offset - tag_type->param_cell_num;
+                    for (i = 0; i < tag_type->param_count; i++) {
+                        emit_operand(loader_ctx, *frame_offset);
+                        frame_offset +=
+                            wasm_value_type_cell_num(tag_type->types[i]);
+                    }
+                }
+                else {
+                    for (i = 0; i < tag_type->param_count; i++)
+                        emit_operand(loader_ctx, 0);
+                }
+#endif
+
                 /* throw is stack polymorphic */
                 (void)label_type;
                 RESET_STACK();
@@ -11842,6 +12217,11 @@ re_scan:
                     goto fail;
                 }
 
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* the caught exception is saved by the catch clause */
+                emit_operand(loader_ctx, frame_csp_tmp->exception_offset);
+#endif
+
                 BranchBlock *cur_block = loader_ctx->frame_csp - 1;
                 uint8 label_type = cur_block->label_type;
                 (void)label_type;
@@ -11851,17 +12231,49 @@ re_scan:
             }
             case WASM_OP_DELEGATE:
             {
+                BranchBlock *cur_block = loader_ctx->frame_csp - 1;
+
+                /* only a try block without catch clauses can be ended by
+                 * delegate */
+                if (cur_block->label_type != LABEL_TYPE_TRY) {
+                    set_error_buf(error_buf, error_buf_size,
+                                  "Unexpected block sequence encountered.");
+                    goto fail;
+                }
+
+                /* check whether the try body matches the block type */
+                if (!check_block_stack(loader_ctx, cur_block, error_buf,
+                                       error_buf_size))
+                    goto fail;
+
                 /* check  target block is valid */
                 if (!(frame_csp_tmp = check_branch_block_for_delegate(
                           loader_ctx, &p, p_end, error_buf, error_buf_size)))
                     goto fail;
 
-                BranchBlock *cur_block = loader_ctx->frame_csp - 1;
-                uint8 label_type = cur_block->label_type;
+#if WASM_ENABLE_FAST_INTERP != 0
+                skip_label();
+                set_try_block_end(loader_ctx, func, cur_block);
+                /* the exceptions not caught are thrown to the try block
+                 * whose try body contains the target label */
+                if (loader_ctx->p_code_compiled)
+                    func->try_blocks[cur_block->try_index].next_try =
+                        get_enclosing_try_index(loader_ctx, frame_csp_tmp);
+#endif
 
-                (void)label_type;
                 /* DELEGATE ends the block */
                 POP_CSP();
+
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* copy the result to the block return address like end */
+                if (!reserve_block_ret(loader_ctx, opcode, disable_emit,
+                                       error_buf, error_buf_size)) {
+                    free_label_patch_list(loader_ctx->frame_csp);
+                    goto fail;
+                }
+                apply_label_patch(loader_ctx, 0, PATCH_END);
+                free_label_patch_list(loader_ctx->frame_csp);
+#endif
                 break;
             }
             case WASM_OP_CATCH:
@@ -11908,6 +12320,24 @@ re_scan:
                     goto fail;
                 }
 
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* the try body or the previous catch clause jumps to the
+                 * end of the block with opcode else */
+                skip_label();
+                emit_label(WASM_OP_ELSE);
+#endif
+                /* check whether the try body or the previous catch clause
+                 * matches the block type */
+                if (!check_block_stack(loader_ctx, cur_block, error_buf,
+                                       error_buf_size))
+                    goto fail;
+#if WASM_ENABLE_FAST_INTERP != 0
+                if (!add_catch_handler(loader_ctx, func, tag_index,
+                                       func_type->param_cell_num, disable_emit,
+                                       error_buf, error_buf_size))
+                    goto fail;
+#endif
+
                 /*
                  * replace frame_csp by LABEL_TYPE_CATCH
                  */
@@ -11916,6 +12346,7 @@ re_scan:
                 /* RESET_STACK removes the values pushed in TRY or previous
                  * CATCH Blocks */
                 RESET_STACK();
+                SET_CUR_BLOCK_STACK_POLYMORPHIC_STATE(false);
 
 #if WASM_ENABLE_GC != 0
                 WASMRefType *ref_type;
@@ -11933,6 +12364,15 @@ re_scan:
                                     wasm_reftype_struct_size(ref_type));
                         j++;
                     }
+#endif
+#if WASM_ENABLE_FAST_INTERP != 0
+                    /* the caught values are copied to the dynamic space
+                       following the saved exception */
+                    if (!wasm_loader_push_frame_offset(
+                            loader_ctx, func_type->types[i], false, 0,
+                            error_buf, error_buf_size))
+                        goto fail;
+                    wasm_loader_emit_backspace(loader_ctx, sizeof(int16));
 #endif
                     PUSH_TYPE(func_type->types[i]);
                 }
@@ -11951,6 +12391,22 @@ re_scan:
                     goto fail;
                 }
 
+#if WASM_ENABLE_FAST_INTERP != 0
+                skip_label();
+                emit_label(WASM_OP_ELSE);
+#endif
+                if (!check_block_stack(loader_ctx, cur_block, error_buf,
+                                       error_buf_size))
+                    goto fail;
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* any exception may be caught and rethrown */
+                if (!add_catch_handler(loader_ctx, func, INVALID_TAGINDEX,
+                                       get_max_tag_param_cell_num(module),
+                                       disable_emit, error_buf,
+                                       error_buf_size))
+                    goto fail;
+#endif
+
                 /* no immediates */
                 /* replace frame_csp by LABEL_TYPE_CATCH_ALL */
                 cur_block->label_type = LABEL_TYPE_CATCH_ALL;
@@ -11958,6 +12414,7 @@ re_scan:
                 /* RESET_STACK removes the values pushed in TRY or previous
                  * CATCH Blocks */
                 RESET_STACK();
+                SET_CUR_BLOCK_STACK_POLYMORPHIC_STATE(false);
 
                 /* catch_all has no tagtype and therefore no parameters */
                 break;
@@ -12061,6 +12518,11 @@ re_scan:
 
 #if WASM_ENABLE_FAST_INTERP != 0
                 skip_label();
+#if WASM_ENABLE_EXCE_HANDLING != 0
+                /* the try body ends here if there is no catch clause */
+                if (loader_ctx->frame_csp->label_type == LABEL_TYPE_TRY)
+                    set_try_block_end(loader_ctx, func, loader_ctx->frame_csp);
+#endif
                 /* copy the result to the block return address */
                 if (!reserve_block_ret(loader_ctx, opcode, disable_emit,
                                        error_buf, error_buf_size)) {
@@ -12116,7 +12578,20 @@ re_scan:
 
             case WASM_OP_BR_IF:
             {
-                POP_I32();
+#if WASM_ENABLE_FAST_INTERP != 0
+                if (last_op >= WASM_OP_I32_EQZ && last_op <= WASM_OP_I32_GE_U
+                    && !(loader_ctx->frame_csp - 1)->is_stack_polymorphic) {
+                    /* Fuse the i32 compare with br_if: the compare result
+                       is the stack top and the last operand emitted */
+                    if (!fuse_i32_cmp_and_br_if(loader_ctx, last_op,
+                                                error_buf, error_buf_size))
+                        goto fail;
+                }
+                else
+#endif
+                {
+                    POP_I32();
+                }
 
                 if (!(frame_csp_tmp =
                           check_branch_block(loader_ctx, &p, p_end, opcode,
@@ -12543,6 +13018,9 @@ re_scan:
 #endif
                 emit_uint32(loader_ctx, type_idx);
                 emit_uint32(loader_ctx, table_idx);
+#if WASM_ENABLE_GC != 0
+                wasm_loader_emit_call_indirect_cache(loader_ctx, func);
+#endif
 #endif
 
 #if WASM_ENABLE_MEMORY64 != 0
@@ -12674,7 +13152,7 @@ re_scan:
                     }
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
                     else if (*(loader_ctx->frame_ref - 1) == VALUE_TYPE_V128) {
                         loader_ctx->frame_ref -= 4;
                         loader_ctx->stack_cell_num -= 4;
@@ -12774,11 +13252,12 @@ re_scan:
                             break;
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
                         case VALUE_TYPE_V128:
                             break;
 #endif /* (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
-          (WASM_ENABLE_FAST_INTERP != 0) */
+          (WASM_ENABLE_FAST_INTERP != 0) || \
+          (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* WASM_ENABLE_SIMD != 0 */
                         default:
                         {
@@ -15509,7 +15988,7 @@ re_scan:
 
 #if WASM_ENABLE_SIMD != 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
-    || (WASM_ENABLE_FAST_INTERP != 0)
+    || (WASM_ENABLE_FAST_INTERP != 0) || (WASM_ENABLE_FAST_JIT != 0)
             case WASM_OP_SIMD_PREFIX:
             {
                 uint32 opcode1;
@@ -16209,7 +16688,8 @@ re_scan:
                 break;
             }
 #endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) || \
-          (WASM_ENABLE_FAST_INTERP != 0) */
+          (WASM_ENABLE_FAST_INTERP != 0) || \
+          (WASM_ENABLE_FAST_JIT != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
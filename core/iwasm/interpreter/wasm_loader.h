@@ -51,6 +51,24 @@ wasm_loader_load_from_sections(WASMSection *section_list, char *error_buf,
 void
 wasm_loader_unload(WASMModule *module);
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+/**
+ * Validate and prepare the body of a function of a module loaded with
+ * LoadArgs::lazy_validation, it is done only once even if it is called
+ * by multiple threads at the same time.
+ *
+ * @param module the module which the function belongs to
+ * @param func the function to prepare
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return true if success, false if the function body is invalid
+ */
+bool
+wasm_loader_prepare_func_lazily(WASMModule *module, WASMFunction *func,
+                                char *error_buf, uint32 error_buf_size);
+#endif
+
 /**
  * Find address of related else opcode and end opcode of opcode block/loop/if
  * according to the start address of opcode.
@@ -656,6 +656,11 @@ load_function_import(const uint8 **p_buf, const uint8 *buf_end,
     function->signature = linked_signature;
     function->attachment = linked_attachment;
     function->call_conv_raw = linked_call_conv_raw;
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    if (linked_func && !linked_call_conv_raw)
+        wasm_native_precompile_signature(declare_func_type, linked_signature,
+                                         &function->native_call);
+#endif
     return true;
 }
 
@@ -2182,6 +2187,14 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
         (bool *)((uint8 *)module->func_ptrs
                  + sizeof(void *) * module->function_count);
 
+#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
+    size = sizeof(WASMTierUpEntry) * (uint64)module->function_count;
+    if (!(module->tierup_queue =
+              loader_malloc(size, error_buf, error_buf_size))) {
+        return false;
+    }
+#endif
+
     module->comp_data = aot_create_comp_data(module, NULL, gc_enabled);
     if (!module->comp_data) {
         aot_last_error = aot_get_last_error();
@@ -2194,6 +2207,7 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
     option.opt_level = llvm_jit_options->opt_level;
     option.size_level = llvm_jit_options->size_level;
     option.segue_flags = llvm_jit_options->segue_flags;
+    option.jit_cache_dir = llvm_jit_options->cache_dir;
     option.quick_invoke_c_api_import =
         llvm_jit_options->quick_invoke_c_api_import;
 
@@ -2402,7 +2416,37 @@ orcjit_thread_callback(void *arg)
     os_mutex_unlock(&module->tierup_wait_lock);
 #endif
 
-#if WASM_ENABLE_JIT != 0
+#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+    /* Compile the hottest functions by llvm jit one by one, the functions
+       which don't get hot keep running the fast jit jitted code */
+    while (jit_compiler_get_tierup_func(module, &i)) {
+        LLVMOrcJITTargetAddress func_addr = 0;
+        LLVMErrorRef error;
+        char func_name[48];
+
+        snprintf(func_name, sizeof(func_name), "%s%d", AOT_FUNC_PREFIX,
+                 i - module->import_function_count);
+        LOG_DEBUG("compile llvm jit func %s", func_name);
+        error = LLVMOrcLLLazyJITCompileFunction(comp_ctx->orc_jit, &func_addr,
+                                                func_name);
+        if (error != LLVMErrorSuccess) {
+            char *err_msg = LLVMGetErrorMessage(error);
+            LOG_ERROR("failed to compile llvm jit function %u: %s", i, err_msg);
+            LLVMDisposeErrorMessage(err_msg);
+            /* Ignore current llvm jit func, as its func ptr is
+               previous set to call_to_fast_jit, which also works */
+            continue;
+        }
+
+        jit_compiler_set_llvm_jit_func_ptr(module, i, (void *)func_addr);
+        module->func_ptrs_compiled[i - module->import_function_count] = true;
+
+        /* Switch to call this llvm jit function instead of fast jit
+           function from fast jit jitted code */
+        jit_compiler_set_call_to_llvm_jit(module, i);
+    }
+#elif WASM_ENABLE_JIT != 0
     /* Compile llvm jit functions of this group */
     for (i = group_idx; i < func_count;
          i += group_stride * WASM_ORC_JIT_COMPILE_THREAD_NUM) {
@@ -2437,32 +2481,6 @@ orcjit_thread_callback(void *arg)
         for (j = 0; j < WASM_ORC_JIT_COMPILE_THREAD_NUM; j++) {
             if (i + j * group_stride < func_count) {
                 module->func_ptrs_compiled[i + j * group_stride] = true;
-#if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
-                snprintf(func_name, sizeof(func_name), "%s%d", AOT_FUNC_PREFIX,
-                         i + j * group_stride);
-                error = LLVMOrcLLLazyJITLookup(comp_ctx->orc_jit, &func_addr,
-                                               func_name);
-                if (error != LLVMErrorSuccess) {
-                    char *err_msg = LLVMGetErrorMessage(error);
-                    LOG_ERROR("failed to compile llvm jit function %u: %s", i,
-                              err_msg);
-                    LLVMDisposeErrorMessage(err_msg);
-                    /* Ignore current llvm jit func, as its func ptr is
-                       previous set to call_to_fast_jit, which also works */
-                    continue;
-                }
-
-                jit_compiler_set_llvm_jit_func_ptr(
-                    module,
-                    i + j * group_stride + module->import_function_count,
-                    (void *)func_addr);
-
-                /* Try to switch to call this llvm jit function instead of
-                   fast jit function from fast jit jitted code */
-                jit_compiler_set_call_to_llvm_jit(
-                    module,
-                    i + j * group_stride + module->import_function_count);
-#endif
             }
         }
 
@@ -2470,6 +2488,14 @@ orcjit_thread_callback(void *arg)
             break;
         }
     }
+
+    /* All the llvm jit functions are compiled when the last thread
+       finishes its group, save the jit cache then */
+    if (i >= func_count
+        && BH_ATOMIC_32_FETCH_ADD(module->orcjit_finished_threads, 1) + 1
+               == (func_count < group_stride ? func_count : group_stride)) {
+        aot_save_jit_cache(comp_ctx);
+    }
 #endif
 
     return NULL;
@@ -3371,6 +3397,8 @@ wasm_loader_unload(WASMModule *module)
         os_mutex_destroy(&module->tierup_wait_lock);
         os_cond_destroy(&module->tierup_wait_cond);
     }
+    if (module->tierup_queue)
+        wasm_runtime_free(module->tierup_queue);
 #endif
 
     if (module->types) {
@@ -3444,14 +3472,7 @@ wasm_loader_unload(WASMModule *module)
         wasm_runtime_free(module->data_segments);
     }
 
-    if (module->const_str_list) {
-        StringNode *node = module->const_str_list, *node_next;
-        while (node) {
-            node_next = node->next;
-            wasm_runtime_free(node);
-            node = node_next;
-        }
-    }
+    wasm_const_str_pool_destroy(&module->const_str_pool);
 
 #if WASM_ENABLE_FAST_INTERP == 0
     if (module->br_table_cache_list) {
@@ -5845,6 +5866,58 @@ fail:
     return ret;
 }
 
+#if WASM_ENABLE_FAST_INTERP != 0
+/* The i32 compares fused with br_if, from i32.eqz to i32.ge_u */
+static const uint8 br_if_cmp_opcodes[] = {
+    EXT_OP_BR_IF_I32_EQZ,  EXT_OP_BR_IF_I32_EQ,   EXT_OP_BR_IF_I32_NE,
+    EXT_OP_BR_IF_I32_LT_S, EXT_OP_BR_IF_I32_LT_U, EXT_OP_BR_IF_I32_GT_S,
+    EXT_OP_BR_IF_I32_GT_U, EXT_OP_BR_IF_I32_LE_S, EXT_OP_BR_IF_I32_LE_U,
+    EXT_OP_BR_IF_I32_GE_S, EXT_OP_BR_IF_I32_GE_U,
+};
+
+/*
+ * Replace the last emitted i32 compare and the br_if label with one
+ * fused instruction which reads the operands of the compare directly,
+ * the compare result is popped without being emitted. The caller then
+ * emits the br_if info as usual.
+ */
+static bool
+fuse_i32_cmp_and_br_if(WASMLoaderContext *loader_ctx, uint8 cmp_opcode,
+                       char *error_buf, uint32 error_buf_size)
+{
+    int16 src_offsets[2] = { 0 };
+    uint32 src_count = cmp_opcode == WASM_OP_I32_EQZ ? 1 : 2, i;
+
+    bh_assert(cmp_opcode >= WASM_OP_I32_EQZ && cmp_opcode <= WASM_OP_I32_GE_U);
+
+    /* skip the br_if label and the result offset of the compare */
+    skip_label();
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16));
+
+    /* the operand offsets are only available in the second traverse */
+    if (loader_ctx->p_code_compiled) {
+        for (i = 0; i < src_count; i++)
+            src_offsets[i] = LOAD_I16(loader_ctx->p_code_compiled
+                                      - sizeof(int16) * (src_count - i));
+    }
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16) * src_count);
+    skip_label();
+
+    emit_label(br_if_cmp_opcodes[cmp_opcode - WASM_OP_I32_EQZ]);
+    for (i = 0; i < src_count; i++)
+        emit_operand(loader_ctx, src_offsets[i]);
+
+    /* pop the compare result, which isn't emitted any more */
+    loader_ctx->frame_offset--;
+    if ((*(loader_ctx->frame_offset) > loader_ctx->start_dynamic_offset)
+        && (*(loader_ctx->frame_offset) < loader_ctx->max_dynamic_offset))
+        loader_ctx->dynamic_offset--;
+
+    return wasm_loader_pop_frame_ref(loader_ctx, VALUE_TYPE_I32, error_buf,
+                                     error_buf_size);
+}
+#endif /* end of WASM_ENABLE_FAST_INTERP != 0 */
+
 static BranchBlock *
 check_branch_block(WASMLoaderContext *loader_ctx, uint8 **p_buf, uint8 *buf_end,
                    uint8 opcode, char *error_buf, uint32 error_buf_size)
@@ -6653,7 +6726,20 @@ re_scan:
 
             case WASM_OP_BR_IF:
             {
-                POP_I32();
+#if WASM_ENABLE_FAST_INTERP != 0
+                if (last_op >= WASM_OP_I32_EQZ && last_op <= WASM_OP_I32_GE_U
+                    && !(loader_ctx->frame_csp - 1)->is_stack_polymorphic) {
+                    /* Fuse the i32 compare with br_if: the compare result
+                       is the stack top and the last operand emitted */
+                    if (!fuse_i32_cmp_and_br_if(loader_ctx, last_op,
+                                                error_buf, error_buf_size))
+                        goto fail;
+                }
+                else
+#endif
+                {
+                    POP_I32();
+                }
 
                 if (!(frame_csp_tmp =
                           check_branch_block(loader_ctx, &p, p_end, opcode,
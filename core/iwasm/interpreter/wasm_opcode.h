@@ -287,6 +287,21 @@ typedef enum WASMOpcode {
     WASM_OP_SET_GLOBAL_V128 = 0xe1,
 #endif
 
+#if WASM_ENABLE_FAST_INTERP != 0
+    /* i32 compare fused with br_if */
+    EXT_OP_BR_IF_I32_EQZ = 0xe2,
+    EXT_OP_BR_IF_I32_EQ = 0xe3,
+    EXT_OP_BR_IF_I32_NE = 0xe4,
+    EXT_OP_BR_IF_I32_LT_S = 0xe5,
+    EXT_OP_BR_IF_I32_LT_U = 0xe6,
+    EXT_OP_BR_IF_I32_GT_S = 0xe7,
+    EXT_OP_BR_IF_I32_GT_U = 0xe8,
+    EXT_OP_BR_IF_I32_LE_S = 0xe9,
+    EXT_OP_BR_IF_I32_LE_U = 0xea,
+    EXT_OP_BR_IF_I32_GE_S = 0xeb,
+    EXT_OP_BR_IF_I32_GE_U = 0xec,
+#endif
+
     /* Post-MVP extend op prefix */
     WASM_OP_GC_PREFIX = 0xfb,
     WASM_OP_MISC_PREFIX = 0xfc,
@@ -809,6 +824,23 @@ typedef enum WASMAtomicEXTOpcode {
 #else
 #define DEF_EXT_V128_HANDLE()
 #endif
+
+#if WASM_ENABLE_FAST_INTERP != 0
+#define DEF_EXT_BR_IF_CMP_HANDLE()                             \
+    SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_EQZ),      /* 0xe2 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_EQ),   /* 0xe3 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_NE),   /* 0xe4 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_S), /* 0xe5 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_U), /* 0xe6 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_S), /* 0xe7 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_U), /* 0xe8 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_S), /* 0xe9 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_U), /* 0xea */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_S), /* 0xeb */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_U), /* 0xec */
+#else
+#define DEF_EXT_BR_IF_CMP_HANDLE()
+#endif
 /*
  * Macro used to generate computed goto tables for the C interpreter.
  */
@@ -1041,6 +1073,7 @@ typedef enum WASMAtomicEXTOpcode {
         SET_GOTO_TABLE_SIMD_PREFIX_ELEM()            /* 0xfd */ \
         SET_GOTO_TABLE_ELEM(WASM_OP_ATOMIC_PREFIX),  /* 0xfe */ \
         DEF_DEBUG_BREAK_HANDLE() DEF_EXT_V128_HANDLE()          \
+        DEF_EXT_BR_IF_CMP_HANDLE()                              \
     };
 
 #ifdef __cplusplus
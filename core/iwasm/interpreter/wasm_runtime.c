@@ -12,6 +12,7 @@
 #include "mem_alloc.h"
 #include "../common/wasm_runtime_common.h"
 #include "../common/wasm_memory.h"
+#include "../common/wasm_loader_common.h"
 #if WASM_ENABLE_GC != 0
 #include "../common/gc/gc_object.h"
 #endif
@@ -83,6 +84,30 @@ wasm_unload(WASMModule *module)
     wasm_loader_unload(module);
 }
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+bool
+wasm_prepare_func_lazily(WASMModuleInstance *module_inst,
+                         WASMFunctionInstance *func)
+{
+    char error_buf[128];
+
+    bh_assert(!func->is_import_func);
+
+    if (!wasm_loader_prepare_func_lazily(module_inst->module, func->u.func,
+                                         error_buf, sizeof(error_buf))) {
+        wasm_set_exception(module_inst, error_buf);
+        return false;
+    }
+
+#if WASM_ENABLE_FAST_INTERP != 0
+    /* The consts are known after the function is prepared */
+    func->const_cell_num = (uint16)func->u.func->const_cell_num;
+#endif
+    BH_ATOMIC_32_STORE(func->lazy_pending, 0);
+    return true;
+}
+#endif
+
 bool
 wasm_resolve_symbols(WASMModule *module)
 {
@@ -171,6 +196,12 @@ wasm_resolve_import_func(const WASMModule *module, WASMFunctionImport *function)
         &function->signature, &function->attachment, &function->call_conv_raw);
 
     if (function->func_ptr_linked) {
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+        if (!function->call_conv_raw)
+            wasm_native_precompile_signature(function->func_type,
+                                             function->signature,
+                                             &function->native_call);
+#endif
         return true;
     }
 
@@ -851,6 +882,13 @@ functions_instantiate(const WASMModule *module, WASMModuleInstance *module_inst,
 #if WASM_ENABLE_FAST_INTERP != 0
         function->const_cell_num = function->u.func->const_cell_num;
 #endif
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+        function->lazy_pending =
+            BH_ATOMIC_32_LOAD(function->u.func->lazy_state)
+                    != WASM_FUNC_PREPARED
+                ? 1
+                : 0;
+#endif
 
         function++;
     }
@@ -2339,8 +2377,8 @@ wasm_set_running_mode(WASMModuleInstance *module_inst, RunningMode running_mode)
 WASMModuleInstance *
 wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                  WASMExecEnv *exec_env_main, uint32 stack_size,
-                 uint32 heap_size, uint32 max_memory_pages, char *error_buf,
-                 uint32 error_buf_size)
+                 uint32 heap_size, uint32 max_memory_pages, bool from_snapshot,
+                 char *error_buf, uint32 error_buf_size)
 {
     WASMModuleInstance *module_inst;
     WASMGlobalInstance *globals = NULL, *global;
@@ -2703,9 +2741,9 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
         if (data_seg->is_passive)
             continue;
 #endif
-        if (is_sub_inst)
+        if (is_sub_inst || from_snapshot)
             /* Ignore setting memory init data if the memory has been
-               initialized */
+               initialized, or will be restored from the snapshot */
             continue;
 
         /* has check it in loader */
@@ -2875,8 +2913,10 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
     }
 #endif /* end of WASM_ENABLE_GC != 0 */
 
-    /* Initialize the table data with table segment section */
-    for (i = 0; module_inst->table_count > 0 && i < module->table_seg_count;
+    /* Initialize the table data with table segment section, no need to
+       do it if the table data will be restored from the snapshot */
+    for (i = 0; module_inst->table_count > 0 && !from_snapshot
+                && i < module->table_seg_count;
          i++) {
         WASMTableSeg *table_seg = module->table_segments + i;
         /* has check it in loader */
@@ -3257,8 +3297,10 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                 &module_inst->e->functions[module->start_function];
     }
 
-    if (!execute_post_instantiate_functions(module_inst, is_sub_inst,
-                                            exec_env_main)) {
+    /* The start functions have been executed before taking the snapshot */
+    if (!from_snapshot
+        && !execute_post_instantiate_functions(module_inst, is_sub_inst,
+                                               exec_env_main)) {
         set_error_buf(error_buf, error_buf_size, module_inst->cur_exception);
         goto fail;
     }
@@ -4121,15 +4163,8 @@ wasm_get_module_mem_consumption(const WASMModule *module,
         mem_conspn->data_segs_size += sizeof(WASMDataSeg);
     }
 
-    if (module->const_str_list) {
-        StringNode *node = module->const_str_list, *node_next;
-        while (node) {
-            node_next = node->next;
-            mem_conspn->const_strs_size +=
-                sizeof(StringNode) + strlen(node->str) + 1;
-            node = node_next;
-        }
-    }
+    mem_conspn->const_strs_size =
+        wasm_const_str_pool_get_mem_size(&module->const_str_pool);
 
     mem_conspn->total_size += mem_conspn->module_struct_size;
     mem_conspn->total_size += mem_conspn->types_size;
@@ -4576,6 +4611,13 @@ llvm_jit_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
             (WASMModuleInstanceCommon *)module_inst, func_ptr, func_type, argc,
             argv, c_api_func_import->with_env_arg, c_api_func_import->env_arg);
     }
+#if WASM_ENABLE_QUICK_NATIVE_CALL != 0
+    else if (import_func->native_call.quick) {
+        ret = wasm_runtime_invoke_native_quick(exec_env, func_ptr,
+                                               &import_func->native_call,
+                                               attachment, argv, argv);
+    }
+#endif
     else if (!import_func->call_conv_raw) {
         signature = import_func->signature;
         ret =
@@ -5007,8 +5049,6 @@ wasm_const_str_list_insert(const uint8 *str, uint32 len, WASMModule *module,
                            bool is_load_from_file_buf, char *error_buf,
                            uint32 error_buf_size)
 {
-    StringNode *node, *node_next;
-
     if (!wasm_check_utf8_str(str, len)) {
         set_error_buf(error_buf, error_buf_size, "invalid UTF-8 encoding");
         return NULL;
@@ -5027,40 +5067,8 @@ wasm_const_str_list_insert(const uint8 *str, uint32 len, WASMModule *module,
         return c_str;
     }
 
-    /* Search const str list */
-    node = module->const_str_list;
-    while (node) {
-        node_next = node->next;
-        if (strlen(node->str) == len && !memcmp(node->str, str, len))
-            break;
-        node = node_next;
-    }
-
-    if (node) {
-        return node->str;
-    }
-
-    if (!(node = runtime_malloc(sizeof(StringNode) + len + 1, error_buf,
-                                error_buf_size))) {
-        return NULL;
-    }
-
-    node->str = ((char *)node) + sizeof(StringNode);
-    bh_memcpy_s(node->str, len + 1, str, len);
-    node->str[len] = '\0';
-
-    if (!module->const_str_list) {
-        /* set as head */
-        module->const_str_list = node;
-        node->next = NULL;
-    }
-    else {
-        /* insert it */
-        node->next = module->const_str_list;
-        module->const_str_list = node;
-    }
-
-    return node->str;
+    return wasm_const_str_pool_insert(&module->const_str_pool, str, len,
+                                      false, error_buf, error_buf_size);
 }
 
 bool
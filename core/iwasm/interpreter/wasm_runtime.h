@@ -232,6 +232,10 @@ struct WASMFunctionInstance {
     WASMModuleInstance *import_module_inst;
     WASMFunctionInstance *import_func_inst;
 #endif
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+    /* whether the function body must be prepared before it is called */
+    bh_atomic_32_t lazy_pending;
+#endif
 #if WASM_ENABLE_PERF_PROFILING != 0
     /* total execution time */
     uint64 total_exec_time;
@@ -522,6 +526,27 @@ wasm_get_func_code_end(WASMFunctionInstance *func)
 #endif
 }
 
+#if WASM_ENABLE_LAZY_VALIDATION != 0
+/**
+ * Validate and prepare a function of a lazily loaded module before it is
+ * called for the first time, the exception is set if it is invalid.
+ *
+ * @param module_inst the module instance which the function belongs to
+ * @param func the WASM function instance
+ *
+ * @return true if success, false otherwise
+ */
+bool
+wasm_prepare_func_lazily(WASMModuleInstance *module_inst,
+                         WASMFunctionInstance *func);
+
+#define WASM_PREPARE_FUNC_LAZILY(module_inst, func) \
+    (!BH_ATOMIC_32_LOAD((func)->lazy_pending)       \
+     || wasm_prepare_func_lazily(module_inst, func))
+#else
+#define WASM_PREPARE_FUNC_LAZILY(module_inst, func) true
+#endif
+
 WASMModule *
 wasm_load(uint8 *buf, uint32 size,
 #if WASM_ENABLE_MULTI_MODULE != 0
@@ -546,8 +571,8 @@ wasm_resolve_import_func(const WASMModule *module,
 WASMModuleInstance *
 wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                  WASMExecEnv *exec_env_main, uint32 stack_size,
-                 uint32 heap_size, uint32 max_memory_pages, char *error_buf,
-                 uint32 error_buf_size);
+                 uint32 heap_size, uint32 max_memory_pages, bool from_snapshot,
+                 char *error_buf, uint32 error_buf_size);
 
 void
 wasm_dump_perf_profiling(const WASMModuleInstance *module_inst);
@@ -551,7 +551,6 @@ pthread_create_wrapper(wasm_exec_env_t exec_env,
                        uint32 elem_index, /* entry function */
                        uint32 arg)        /* arguments buffer */
 {
-    wasm_module_t module = get_module(exec_env);
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasm_module_inst_t new_module_inst = NULL;
     ThreadInfoNode *info_node = NULL;
@@ -562,7 +561,6 @@ pthread_create_wrapper(wasm_exec_env_t exec_env,
     uint64 aux_stack_start = 0;
     int32 ret = -1;
 
-    bh_assert(module);
     bh_assert(module_inst);
 
 #if WASM_ENABLE_INTERP != 0
@@ -579,19 +577,10 @@ pthread_create_wrapper(wasm_exec_env_t exec_env,
     }
 #endif
 
-    if (!(new_module_inst = wasm_runtime_instantiate_internal(
-              module, module_inst, exec_env, stack_size, 0, 0, NULL, 0)))
+    if (!(new_module_inst =
+              wasm_cluster_acquire_instance(exec_env, stack_size)))
         return -1;
 
-    /* Set custom_data to new module instance */
-    wasm_runtime_set_custom_data_internal(
-        new_module_inst, wasm_runtime_get_custom_data(module_inst));
-
-    wasm_native_inherit_contexts(new_module_inst, module_inst);
-
-    if (!(wasm_cluster_dup_c_api_imports(new_module_inst, module_inst)))
-        goto fail;
-
     if (!(info_node = wasm_runtime_malloc(sizeof(ThreadInfoNode))))
         goto fail;
 
@@ -645,7 +634,8 @@ pthread_create_wrapper(wasm_exec_env_t exec_env,
 
 fail:
     if (new_module_inst)
-        wasm_runtime_deinstantiate_internal(new_module_inst, true);
+        wasm_cluster_release_instance(wasm_exec_env_get_cluster(exec_env),
+                                      new_module_inst);
     if (info_node)
         wasm_runtime_free(info_node);
     if (routine_args)
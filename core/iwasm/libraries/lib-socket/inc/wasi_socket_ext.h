@@ -988,6 +988,34 @@ __wasi_sock_get_ipv6_only(__wasi_fd_t fd, bool *option)
     return (__wasi_errno_t)__imported_wasi_snapshot_preview1_sock_get_ipv6_only(
         (int32_t)fd, (int32_t)option);
 }
+
+/**
+ * Move up to len bytes from fd_in to fd_out in the host, without copying
+ * them through the linear memory, e.g. to serve a file over a socket.
+ * Reads at offset without moving the file position of fd_in, or at the
+ * file position if offset is (__wasi_filesize_t)-1. The number of bytes
+ * moved is 0 at the end of the input. Fails with __WASI_ENOSYS if the
+ * host doesn't support it, in which case the data should be moved with
+ * fd_read and fd_write.
+ * Note: This is similar to `sendfile` or `splice` in Linux
+ */
+int32_t
+__imported_wasi_snapshot_preview1_fd_transfer(int32_t arg0, int64_t arg1,
+                                              int32_t arg2, int32_t arg3,
+                                              int32_t arg4)
+    __attribute__((__import_module__("wasi_snapshot_preview1"),
+                   __import_name__("fd_transfer")));
+
+static inline __wasi_errno_t
+__wasi_fd_transfer(__wasi_fd_t fd_in, __wasi_filesize_t offset,
+                   __wasi_fd_t fd_out, __wasi_size_t len,
+                   __wasi_size_t *ntransferred)
+{
+    return (__wasi_errno_t)__imported_wasi_snapshot_preview1_fd_transfer(
+        (int32_t)fd_in, (int64_t)offset, (int32_t)fd_out, (int32_t)len,
+        (int32_t)ntransferred);
+}
+
 /**
  * TODO: modify recv() and send()
  * since don't want to re-compile the wasi-libc,
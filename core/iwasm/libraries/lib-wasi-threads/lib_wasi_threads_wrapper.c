@@ -72,7 +72,6 @@ thread_start(void *arg)
 static int32
 thread_spawn_wrapper(wasm_exec_env_t exec_env, uint32 start_arg)
 {
-    wasm_module_t module = wasm_exec_env_get_module(exec_env);
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasm_module_inst_t new_module_inst = NULL;
     ThreadStartArg *thread_start_arg = NULL;
@@ -81,23 +80,14 @@ thread_spawn_wrapper(wasm_exec_env_t exec_env, uint32 start_arg)
     uint32 stack_size = 8192;
     int32 ret = -1;
 
-    bh_assert(module);
     bh_assert(module_inst);
 
     stack_size = ((WASMModuleInstance *)module_inst)->default_wasm_stack_size;
 
-    if (!(new_module_inst = wasm_runtime_instantiate_internal(
-              module, module_inst, exec_env, stack_size, 0, 0, NULL, 0)))
+    if (!(new_module_inst =
+              wasm_cluster_acquire_instance(exec_env, stack_size)))
         return -1;
 
-    wasm_runtime_set_custom_data_internal(
-        new_module_inst, wasm_runtime_get_custom_data(module_inst));
-
-    if (!(wasm_cluster_dup_c_api_imports(new_module_inst, module_inst)))
-        goto thread_preparation_fail;
-
-    wasm_native_inherit_contexts(new_module_inst, module_inst);
-
     start_func =
         wasm_runtime_lookup_function(new_module_inst, THREAD_START_FUNCTION);
     if (!start_func) {
@@ -119,8 +109,8 @@ thread_spawn_wrapper(wasm_exec_env_t exec_env, uint32 start_arg)
     thread_start_arg->arg = start_arg;
     thread_start_arg->start_func = start_func;
 
-    ret = wasm_cluster_create_thread(exec_env, new_module_inst, false, 0, 0,
-                                     thread_start, thread_start_arg);
+    ret = wasm_cluster_create_pooled_thread(exec_env, new_module_inst,
+                                            thread_start, thread_start_arg);
     if (ret != 0) {
         LOG_ERROR("Failed to spawn a new thread");
         goto thread_spawn_fail;
@@ -133,7 +123,8 @@ thread_spawn_fail:
 
 thread_preparation_fail:
     if (new_module_inst)
-        wasm_runtime_deinstantiate_internal(new_module_inst, true);
+        wasm_cluster_release_instance(wasm_exec_env_get_cluster(exec_env),
+                                      new_module_inst);
     if (thread_start_arg)
         wasm_runtime_free(thread_start_arg);
 
@@ -52,6 +52,10 @@ typedef struct iovec_app {
     uint32 buf_len;
 } iovec_app_t;
 
+/* Max number of iovecs converted on the native stack by fd_read/fd_write
+   and friends, more iovecs are converted into a heap allocated array */
+#define WASI_IOVEC_BUF_NUM 16
+
 typedef struct WASIContext *wasi_ctx_t;
 
 wasi_ctx_t
@@ -359,7 +363,7 @@ wasi_fd_pread(wasm_exec_env_t exec_env, wasi_fd_t fd, iovec_app_t *iovec_app,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_iovec_t *iovec, *iovec_begin;
+    wasi_iovec_t iovec_buf[WASI_IOVEC_BUF_NUM], *iovec, *iovec_begin;
     uint64 total_size;
     size_t nread;
     uint32 i;
@@ -374,10 +378,15 @@ wasi_fd_pread(wasm_exec_env_t exec_env, wasi_fd_t fd, iovec_app_t *iovec_app,
         || !validate_native_addr(iovec_app, total_size))
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
-        return (wasi_errno_t)-1;
+    if (iovs_len <= WASI_IOVEC_BUF_NUM) {
+        iovec_begin = iovec_buf;
+    }
+    else {
+        total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
+        if (total_size >= UINT32_MAX
+            || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
+            return (wasi_errno_t)-1;
+    }
 
     iovec = iovec_begin;
 
@@ -402,7 +411,8 @@ wasi_fd_pread(wasm_exec_env_t exec_env, wasi_fd_t fd, iovec_app_t *iovec_app,
     err = 0;
 
 fail:
-    wasm_runtime_free(iovec_begin);
+    if (iovec_begin != iovec_buf)
+        wasm_runtime_free(iovec_begin);
     return err;
 }
 
@@ -414,7 +424,7 @@ wasi_fd_pwrite(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_ciovec_t *ciovec, *ciovec_begin;
+    wasi_ciovec_t ciovec_buf[WASI_IOVEC_BUF_NUM], *ciovec, *ciovec_begin;
     uint64 total_size;
     size_t nwritten;
     uint32 i;
@@ -429,10 +439,15 @@ wasi_fd_pwrite(wasm_exec_env_t exec_env, wasi_fd_t fd,
         || !validate_native_addr((void *)iovec_app, total_size))
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
-        return (wasi_errno_t)-1;
+    if (iovs_len <= WASI_IOVEC_BUF_NUM) {
+        ciovec_begin = ciovec_buf;
+    }
+    else {
+        total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
+        if (total_size >= UINT32_MAX
+            || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
+            return (wasi_errno_t)-1;
+    }
 
     ciovec = ciovec_begin;
 
@@ -457,7 +472,8 @@ wasi_fd_pwrite(wasm_exec_env_t exec_env, wasi_fd_t fd,
     err = 0;
 
 fail:
-    wasm_runtime_free(ciovec_begin);
+    if (ciovec_begin != ciovec_buf)
+        wasm_runtime_free(ciovec_begin);
     return err;
 }
 
@@ -468,7 +484,7 @@ wasi_fd_read(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_iovec_t *iovec, *iovec_begin;
+    wasi_iovec_t iovec_buf[WASI_IOVEC_BUF_NUM], *iovec, *iovec_begin;
     uint64 total_size;
     size_t nread;
     uint32 i;
@@ -483,10 +499,15 @@ wasi_fd_read(wasm_exec_env_t exec_env, wasi_fd_t fd,
         || !validate_native_addr((void *)iovec_app, total_size))
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
-        return (wasi_errno_t)-1;
+    if (iovs_len <= WASI_IOVEC_BUF_NUM) {
+        iovec_begin = iovec_buf;
+    }
+    else {
+        total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
+        if (total_size >= UINT32_MAX
+            || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
+            return (wasi_errno_t)-1;
+    }
 
     iovec = iovec_begin;
 
@@ -511,7 +532,8 @@ wasi_fd_read(wasm_exec_env_t exec_env, wasi_fd_t fd,
     err = 0;
 
 fail:
-    wasm_runtime_free(iovec_begin);
+    if (iovec_begin != iovec_buf)
+        wasm_runtime_free(iovec_begin);
     return err;
 }
 
@@ -638,7 +660,7 @@ wasi_fd_write(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_ciovec_t *ciovec, *ciovec_begin;
+    wasi_ciovec_t ciovec_buf[WASI_IOVEC_BUF_NUM], *ciovec, *ciovec_begin;
     uint64 total_size;
     size_t nwritten;
     uint32 i;
@@ -653,10 +675,15 @@ wasi_fd_write(wasm_exec_env_t exec_env, wasi_fd_t fd,
         || !validate_native_addr((void *)iovec_app, total_size))
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
-        return (wasi_errno_t)-1;
+    if (iovs_len <= WASI_IOVEC_BUF_NUM) {
+        ciovec_begin = ciovec_buf;
+    }
+    else {
+        total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
+        if (total_size >= UINT32_MAX
+            || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
+            return (wasi_errno_t)-1;
+    }
 
     ciovec = ciovec_begin;
 
@@ -681,10 +708,37 @@ wasi_fd_write(wasm_exec_env_t exec_env, wasi_fd_t fd,
     err = 0;
 
 fail:
-    wasm_runtime_free(ciovec_begin);
+    if (ciovec_begin != ciovec_buf)
+        wasm_runtime_free(ciovec_begin);
     return err;
 }
 
+static wasi_errno_t
+wasi_fd_transfer(wasm_exec_env_t exec_env, wasi_fd_t fd_in,
+                 wasi_filesize_t offset, wasi_fd_t fd_out, uint32 len,
+                 uint32 *ntransferred_app)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
+    struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+    size_t ntransferred;
+    wasi_errno_t err;
+
+    if (!wasi_ctx)
+        return (wasi_errno_t)-1;
+
+    if (!validate_native_addr(ntransferred_app, (uint64)sizeof(uint32)))
+        return (wasi_errno_t)-1;
+
+    err = wasmtime_ssp_fd_transfer(exec_env, curfds, fd_in, offset, fd_out,
+                                   len, &ntransferred);
+    if (err)
+        return err;
+
+    *ntransferred_app = (uint32)ntransferred;
+    return 0;
+}
+
 static wasi_errno_t
 wasi_fd_advise(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filesize_t offset,
                wasi_filesize_t len, wasi_advice_t advice)
@@ -2048,6 +2102,25 @@ copy_buffer_to_iovec_app(wasm_module_inst_t module_inst, uint8 *buf_begin,
     return __WASI_ESUCCESS;
 }
 
+/* Get the native address of a single, non-empty iovec, so that the data
+   can be sent or received in place instead of through a bounce buffer */
+static bool
+get_single_iovec_app_buffer(wasm_module_inst_t module_inst,
+                            const iovec_app_t *data, uint32 data_len,
+                            uint8 **buf_ptr, uint64 *buf_len)
+{
+    if (data_len != 1
+        || !validate_native_addr((void *)data, (uint64)sizeof(iovec_app_t))
+        || data->buf_len == 0
+        || !validate_app_addr((uint64)data->buf_offset,
+                              (uint64)data->buf_len))
+        return false;
+
+    *buf_ptr = (uint8 *)addr_app_to_native((uint64)data->buf_offset);
+    *buf_len = data->buf_len;
+    return true;
+}
+
 static wasi_errno_t
 wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
                     iovec_app_t *ri_data, uint32 ri_data_len,
@@ -2073,6 +2146,17 @@ wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(ro_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
+    if (get_single_iovec_app_buffer(module_inst, ri_data, ri_data_len,
+                                    &buf_begin, &total_size)) {
+        *ro_data_len = 0;
+        err = wasmtime_ssp_sock_recv_from(exec_env, curfds, sock, buf_begin,
+                                          total_size, ri_flags, src_addr,
+                                          &recv_bytes);
+        if (err == __WASI_ESUCCESS)
+            *ro_data_len = (uint32)recv_bytes;
+        return err;
+    }
+
     err = allocate_iovec_app_buffer(module_inst, ri_data, ri_data_len,
                                     &buf_begin, &total_size);
     if (err != __WASI_ESUCCESS) {
@@ -2168,6 +2252,7 @@ wasi_sock_send(wasm_exec_env_t exec_env, wasi_fd_t sock,
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     uint64 buf_size = 0;
     uint8 *buf = NULL;
+    bool is_app_buf = false;
     wasi_errno_t err;
     size_t send_bytes = 0;
 
@@ -2178,17 +2263,24 @@ wasi_sock_send(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(so_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
-    err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len, &buf,
-                                      &buf_size);
-    if (err != __WASI_ESUCCESS)
-        return err;
+    if (get_single_iovec_app_buffer(module_inst, si_data, si_data_len, &buf,
+                                    &buf_size)) {
+        is_app_buf = true;
+    }
+    else {
+        err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len,
+                                          &buf, &buf_size);
+        if (err != __WASI_ESUCCESS)
+            return err;
+    }
 
     *so_data_len = 0;
     err = wasmtime_ssp_sock_send(exec_env, curfds, sock, buf, buf_size,
                                  &send_bytes);
     *so_data_len = (uint32)send_bytes;
 
-    wasm_runtime_free(buf);
+    if (!is_app_buf)
+        wasm_runtime_free(buf);
 
     return err;
 }
@@ -2208,6 +2300,7 @@ wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     uint64 buf_size = 0;
     uint8 *buf = NULL;
+    bool is_app_buf = false;
     wasi_errno_t err;
     size_t send_bytes = 0;
     struct addr_pool *addr_pool = wasi_ctx_get_addr_pool(wasi_ctx);
@@ -2219,17 +2312,24 @@ wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(so_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
-    err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len, &buf,
-                                      &buf_size);
-    if (err != __WASI_ESUCCESS)
-        return err;
+    if (get_single_iovec_app_buffer(module_inst, si_data, si_data_len, &buf,
+                                    &buf_size)) {
+        is_app_buf = true;
+    }
+    else {
+        err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len,
+                                          &buf, &buf_size);
+        if (err != __WASI_ESUCCESS)
+            return err;
+    }
 
     *so_data_len = 0;
     err = wasmtime_ssp_sock_send_to(exec_env, curfds, addr_pool, sock, buf,
                                     buf_size, si_flags, dest_addr, &send_bytes);
     *so_data_len = (uint32)send_bytes;
 
-    wasm_runtime_free(buf);
+    if (!is_app_buf)
+        wasm_runtime_free(buf);
 
     return err;
 }
@@ -2282,6 +2382,7 @@ static NativeSymbol native_symbols_libc_wasi[] = {
     REG_NATIVE_FUNC(fd_fdstat_set_rights, "(iII)i"),
     REG_NATIVE_FUNC(fd_sync, "(i)i"),
     REG_NATIVE_FUNC(fd_write, "(i*i*)i"),
+    REG_NATIVE_FUNC(fd_transfer, "(iIii*)i"),
     REG_NATIVE_FUNC(fd_advise, "(iIIi)i"),
     REG_NATIVE_FUNC(fd_allocate, "(iII)i"),
     REG_NATIVE_FUNC(path_create_directory, "(i*~)i"),
@@ -136,6 +136,12 @@ wasmtime_ssp_fd_write(wasm_exec_env_t exec_env, struct fd_table *curfds,
                       size_t iovs_len, size_t *nwritten)
     WASMTIME_SSP_SYSCALL_NAME(fd_write) WARN_UNUSED;
 
+__wasi_errno_t
+wasmtime_ssp_fd_transfer(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                         __wasi_fd_t fd_in, __wasi_filesize_t offset,
+                         __wasi_fd_t fd_out, size_t len, size_t *ntransferred)
+    WASMTIME_SSP_SYSCALL_NAME(fd_transfer) WARN_UNUSED;
+
 __wasi_errno_t
 wasmtime_ssp_fd_advise(wasm_exec_env_t exec_env, struct fd_table *curfds,
                        __wasi_fd_t fd, __wasi_filesize_t offset,
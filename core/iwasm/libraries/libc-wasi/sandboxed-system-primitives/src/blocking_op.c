@@ -9,6 +9,10 @@
 #include "blocking_op.h"
 #include "libc_errno.h"
 
+#ifdef OS_ENABLE_IO_URING
+#include "wasm_exec_env.h"
+#endif
+
 __wasi_errno_t
 blocking_op_close(wasm_exec_env_t exec_env, os_file_handle handle,
                   bool is_stdio)
@@ -28,7 +32,14 @@ blocking_op_readv(wasm_exec_env_t exec_env, os_file_handle handle,
     if (!wasm_runtime_begin_blocking_op(exec_env)) {
         return __WASI_EINTR;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    __wasi_errno_t error =
+        ring ? os_io_ring_readv(ring, handle, iov, iovcnt, -1, nread)
+             : os_readv(handle, iov, iovcnt, nread);
+#else
     __wasi_errno_t error = os_readv(handle, iov, iovcnt, nread);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return error;
 }
@@ -41,7 +52,14 @@ blocking_op_preadv(wasm_exec_env_t exec_env, os_file_handle handle,
     if (!wasm_runtime_begin_blocking_op(exec_env)) {
         return __WASI_EINTR;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    __wasi_errno_t ret =
+        ring ? os_io_ring_readv(ring, handle, iov, iovcnt, (int64)offset, nread)
+             : os_preadv(handle, iov, iovcnt, offset, nread);
+#else
     __wasi_errno_t ret = os_preadv(handle, iov, iovcnt, offset, nread);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return ret;
 }
@@ -54,7 +72,14 @@ blocking_op_writev(wasm_exec_env_t exec_env, os_file_handle handle,
     if (!wasm_runtime_begin_blocking_op(exec_env)) {
         return __WASI_EINTR;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    __wasi_errno_t error =
+        ring ? os_io_ring_writev(ring, handle, iov, iovcnt, -1, nwritten)
+             : os_writev(handle, iov, iovcnt, nwritten);
+#else
     __wasi_errno_t error = os_writev(handle, iov, iovcnt, nwritten);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return error;
 }
@@ -67,11 +92,37 @@ blocking_op_pwritev(wasm_exec_env_t exec_env, os_file_handle handle,
     if (!wasm_runtime_begin_blocking_op(exec_env)) {
         return __WASI_EINTR;
     }
+#ifdef OS_ENABLE_IO_URING
+    /* os_pwritev rejects an empty write, keep that for the ring */
+    os_io_ring *ring =
+        iovcnt > 0 ? wasm_exec_env_get_io_ring(exec_env) : NULL;
+    __wasi_errno_t error =
+        ring ? os_io_ring_writev(ring, handle, iov, iovcnt, (int64)offset,
+                                 nwritten)
+             : os_pwritev(handle, iov, iovcnt, offset, nwritten);
+#else
     __wasi_errno_t error = os_pwritev(handle, iov, iovcnt, offset, nwritten);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return error;
 }
 
+#ifdef OS_ENABLE_FD_TRANSFER
+__wasi_errno_t
+blocking_op_fd_transfer(wasm_exec_env_t exec_env, os_file_handle handle_in,
+                        int64 offset, os_file_handle handle_out, size_t len,
+                        size_t *ntransferred)
+{
+    if (!wasm_runtime_begin_blocking_op(exec_env)) {
+        return __WASI_EINTR;
+    }
+    __wasi_errno_t error =
+        os_fd_transfer(handle_in, offset, handle_out, len, ntransferred);
+    wasm_runtime_end_blocking_op(exec_env);
+    return error;
+}
+#endif
+
 int
 blocking_op_socket_accept(wasm_exec_env_t exec_env, bh_socket_t server_sock,
                           bh_socket_t *sockp, void *addr,
@@ -108,7 +159,13 @@ blocking_op_socket_recv_from(wasm_exec_env_t exec_env, bh_socket_t sock,
         errno = EINTR;
         return -1;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    int ret = ring ? os_io_ring_recv_from(ring, sock, buf, len, flags, src_addr)
+                   : os_socket_recv_from(sock, buf, len, flags, src_addr);
+#else
     int ret = os_socket_recv_from(sock, buf, len, flags, src_addr);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return ret;
 }
@@ -122,7 +179,13 @@ blocking_op_socket_send_to(wasm_exec_env_t exec_env, bh_socket_t sock,
         errno = EINTR;
         return -1;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    int ret = ring ? os_io_ring_send_to(ring, sock, buf, len, flags, dest_addr)
+                   : os_socket_send_to(sock, buf, len, flags, dest_addr);
+#else
     int ret = os_socket_send_to(sock, buf, len, flags, dest_addr);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     return ret;
 }
@@ -182,7 +245,13 @@ blocking_op_poll(wasm_exec_env_t exec_env, struct pollfd *pfds, nfds_t nfds,
     if (!wasm_runtime_begin_blocking_op(exec_env)) {
         return __WASI_EINTR;
     }
+#ifdef OS_ENABLE_IO_URING
+    os_io_ring *ring = wasm_exec_env_get_io_ring(exec_env);
+    ret = ring ? os_io_ring_poll(ring, pfds, nfds, timeout_ms)
+               : poll(pfds, nfds, timeout_ms);
+#else
     ret = poll(pfds, nfds, timeout_ms);
+#endif
     wasm_runtime_end_blocking_op(exec_env);
     if (ret == -1) {
         return convert_errno(errno);
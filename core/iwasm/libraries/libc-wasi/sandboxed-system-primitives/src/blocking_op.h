@@ -27,6 +27,12 @@ __wasi_errno_t
 blocking_op_pwritev(wasm_exec_env_t exec_env, os_file_handle handle,
                     const struct __wasi_ciovec_t *iov, int iovcnt,
                     __wasi_filesize_t offset, size_t *nwritten);
+#ifdef OS_ENABLE_FD_TRANSFER
+__wasi_errno_t
+blocking_op_fd_transfer(wasm_exec_env_t exec_env, os_file_handle handle_in,
+                        int64 offset, os_file_handle handle_out, size_t len,
+                        size_t *ntransferred);
+#endif
 int
 blocking_op_socket_accept(wasm_exec_env_t exec_env, bh_socket_t server_sock,
                           bh_socket_t *sockp, void *addr,
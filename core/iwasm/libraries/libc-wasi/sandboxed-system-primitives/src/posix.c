@@ -1173,6 +1173,52 @@ wasmtime_ssp_fd_write(wasm_exec_env_t exec_env, struct fd_table *curfds,
     return error;
 }
 
+__wasi_errno_t
+wasmtime_ssp_fd_transfer(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                         __wasi_fd_t fd_in, __wasi_filesize_t offset,
+                         __wasi_fd_t fd_out, size_t len, size_t *ntransferred)
+{
+#ifdef OS_ENABLE_FD_TRANSFER
+    struct fd_object *fo_in, *fo_out;
+    __wasi_errno_t error;
+
+    /* All ones reads at the current file position */
+    if (offset != (__wasi_filesize_t)-1 && offset > INT64_MAX)
+        return __WASI_EINVAL;
+
+    error = fd_object_get(curfds, &fo_in, fd_in, __WASI_RIGHT_FD_READ, 0);
+    if (error != 0)
+        return error;
+
+    error = fd_object_get(curfds, &fo_out, fd_out, __WASI_RIGHT_FD_WRITE, 0);
+    if (error != 0) {
+        fd_object_release(exec_env, fo_in);
+        return error;
+    }
+
+#ifdef BH_VPRINTF
+    /* stdout/stderr output is redirected to BH_VPRINTF function, let the
+       caller write it with fd_write */
+    if (fo_out->is_stdio) {
+        fd_object_release(exec_env, fo_out);
+        fd_object_release(exec_env, fo_in);
+        return __WASI_ENOTSUP;
+    }
+#endif
+
+    error = blocking_op_fd_transfer(exec_env, fo_in->file_handle,
+                                    (int64)offset, fo_out->file_handle, len,
+                                    ntransferred);
+
+    fd_object_release(exec_env, fo_out);
+    fd_object_release(exec_env, fo_in);
+
+    return error;
+#else
+    return __WASI_ENOSYS;
+#endif
+}
+
 __wasi_errno_t
 wasmtime_ssp_fd_advise(wasm_exec_env_t exec_env, struct fd_table *curfds,
                        __wasi_fd_t fd, __wasi_filesize_t offset,
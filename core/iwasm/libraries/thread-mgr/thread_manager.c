@@ -13,6 +13,9 @@
 #include "../aot/aot_runtime.h"
 #endif
 
+#if WASM_ENABLE_SHARED_MEMORY != 0
+#include "../common/wasm_shared_memory.h"
+#endif
 #if WASM_ENABLE_DEBUG_INTERP != 0
 #include "debug_engine.h"
 #endif
@@ -35,6 +38,50 @@ typedef void (*list_visitor)(void *, void *);
 
 static uint32 cluster_max_thread_num = CLUSTER_MAX_THREAD_NUM;
 
+/* The max number of parked native threads and of idle sibling module
+   instances kept by every cluster, 0 to disable the thread pool */
+static uint32 cluster_thread_pool_size = 0;
+/* The time a parked native thread waits for a new wasm thread to run
+   before it exits, 0 to wait forever */
+static uint32 cluster_thread_idle_timeout_ms = 1000;
+
+/* A native thread of the thread pool of a cluster */
+typedef struct WASMThreadPoolWorker {
+    struct WASMThreadPoolWorker *next;
+    WASMCluster *cluster;
+    korp_tid handle;
+    /* Signaled when a wasm thread is assigned to the worker */
+    korp_cond cond;
+    /* The exec_env of the wasm thread to run, NULL if the worker is idle */
+    WASMExecEnv *exec_env;
+    /* The ticket of the wasm thread to run, 0 if the worker is idle */
+    uint64 ticket;
+    bool idle;
+} WASMThreadPoolWorker;
+
+typedef struct WASMRecycledTable {
+    uint32 cur_size;
+    table_elem_type_t *elems;
+} WASMRecycledTable;
+
+/* A sibling module instance kept by the thread pool of a cluster, with
+   the state a thread may change saved when the instance was created,
+   which is restored before the instance is reused */
+typedef struct WASMRecycledInstance {
+    struct WASMRecycledInstance *next;
+    WASMModuleInstanceCommon *module_inst;
+    bool in_use;
+    uint8 *global_data;
+    uint32 table_count;
+    WASMRecycledTable *tables;
+#if WASM_ENABLE_BULK_MEMORY != 0
+    uint8 *data_dropped;
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    uint8 *elem_dropped;
+#endif
+} WASMRecycledInstance;
+
 /* Set the maximum thread number, if this function is not called,
     the max thread num is defined by CLUSTER_MAX_THREAD_NUM */
 void
@@ -44,6 +91,16 @@ wasm_cluster_set_max_thread_num(uint32 num)
         cluster_max_thread_num = num;
 }
 
+/* Set the options of the thread pool, the native threads and module
+   instances of the exited wasm threads are kept by the cluster to run
+   the new ones, if this function is not called, the pool is disabled */
+void
+wasm_cluster_set_thread_pool_options(uint32 pool_size, uint32 idle_timeout_ms)
+{
+    cluster_thread_pool_size = pool_size;
+    cluster_thread_idle_timeout_ms = idle_timeout_ms;
+}
+
 bool
 thread_manager_init()
 {
@@ -242,6 +299,19 @@ wasm_cluster_create(WASMExecEnv *exec_env)
         LOG_ERROR("thread manager error: failed to init mutex");
         return NULL;
     }
+    if (os_mutex_init(&cluster->pool_lock) != 0) {
+        os_mutex_destroy(&cluster->lock);
+        wasm_runtime_free(cluster);
+        LOG_ERROR("thread manager error: failed to init mutex");
+        return NULL;
+    }
+    if (os_cond_init(&cluster->pool_cond) != 0) {
+        os_mutex_destroy(&cluster->pool_lock);
+        os_mutex_destroy(&cluster->lock);
+        wasm_runtime_free(cluster);
+        LOG_ERROR("thread manager error: failed to init condition variable");
+        return NULL;
+    }
 
     /* Prepare the aux stack top and size for every thread */
     if (!wasm_exec_env_get_aux_stack(exec_env, &aux_stack_start,
@@ -322,6 +392,330 @@ fail:
     return NULL;
 }
 
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return &((WASMModuleInstance *)module_inst)->e->common;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+#endif
+    bh_assert(0);
+    return NULL;
+}
+
+#if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
+static uint32
+bitmap_map_size(const bh_bitmap *bitmap)
+{
+    return (uint32)((bitmap->end_index - bitmap->begin_index + 7) / 8);
+}
+
+static uint8 *
+bitmap_map_clone(const bh_bitmap *bitmap)
+{
+    uint32 size = bitmap_map_size(bitmap);
+    uint8 *map;
+
+    if (!(map = wasm_runtime_malloc(size > 0 ? size : 1)))
+        return NULL;
+    bh_memcpy_s(map, size, bitmap->map, size);
+    return map;
+}
+#endif
+
+/* Only the instances whose state changed by a thread can be restored
+   cheaply are recycled: the start function which may change anything
+   isn't executed again when an instance is reused, the non-shared linear
+   memories would have to be reset, and the GC objects referred by the
+   globals and tables can't be saved */
+static bool
+instance_is_recyclable(WASMModuleInstanceCommon *module_inst_comm)
+{
+#if WASM_ENABLE_GC == 0
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    uint32 i;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst_comm->module_type == Wasm_Module_Bytecode
+        && module_inst->e->start_function)
+        return false;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst_comm->module_type == Wasm_Module_AoT
+        && ((AOTModule *)module_inst->module)->start_function)
+        return false;
+#endif
+#if WASM_ENABLE_MULTI_MODULE != 0
+    {
+        bh_list *sub_module_inst_list = NULL;
+#if WASM_ENABLE_INTERP != 0
+        if (module_inst_comm->module_type == Wasm_Module_Bytecode)
+            sub_module_inst_list = module_inst->e->sub_module_inst_list;
+#endif
+#if WASM_ENABLE_AOT != 0
+        if (module_inst_comm->module_type == Wasm_Module_AoT)
+            sub_module_inst_list =
+                ((AOTModuleInstanceExtra *)module_inst->e)
+                    ->sub_module_inst_list;
+#endif
+        /* The instances of the sub modules aren't saved */
+        if (sub_module_inst_list && bh_list_length(sub_module_inst_list) > 0)
+            return false;
+    }
+#endif
+
+    for (i = 0; i < module_inst->memory_count; i++) {
+        if (!module_inst->memories[i]->is_shared_memory)
+            return false;
+    }
+    return true;
+#else
+    (void)module_inst_comm;
+    return false;
+#endif
+}
+
+static void
+recycled_instance_free(WASMRecycledInstance *node)
+{
+    uint32 i;
+
+    if (node->global_data)
+        wasm_runtime_free(node->global_data);
+    if (node->tables) {
+        for (i = 0; i < node->table_count; i++) {
+            if (node->tables[i].elems)
+                wasm_runtime_free(node->tables[i].elems);
+        }
+        wasm_runtime_free(node->tables);
+    }
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (node->data_dropped)
+        wasm_runtime_free(node->data_dropped);
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (node->elem_dropped)
+        wasm_runtime_free(node->elem_dropped);
+#endif
+    wasm_runtime_free(node);
+}
+
+/* Save the state of a newly created instance */
+static WASMRecycledInstance *
+recycled_instance_create(WASMModuleInstanceCommon *module_inst_comm)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *common =
+        get_module_inst_extra_common(module_inst_comm);
+    WASMRecycledInstance *node;
+    WASMTableInstance *table;
+    uint64 total_size;
+    uint32 i;
+
+    if (!(node = wasm_runtime_malloc(sizeof(WASMRecycledInstance))))
+        return NULL;
+    memset(node, 0, sizeof(WASMRecycledInstance));
+    node->module_inst = module_inst_comm;
+
+    if (module_inst->global_data_size > 0) {
+        if (!(node->global_data =
+                  wasm_runtime_malloc(module_inst->global_data_size)))
+            goto fail;
+        bh_memcpy_s(node->global_data, module_inst->global_data_size,
+                    module_inst->global_data, module_inst->global_data_size);
+    }
+
+    if (module_inst->table_count > 0) {
+        total_size =
+            sizeof(WASMRecycledTable) * (uint64)module_inst->table_count;
+        if (!(node->tables = wasm_runtime_malloc((uint32)total_size)))
+            goto fail;
+        memset(node->tables, 0, (uint32)total_size);
+        node->table_count = module_inst->table_count;
+
+        for (i = 0; i < module_inst->table_count; i++) {
+            table = module_inst->tables[i];
+            node->tables[i].cur_size = table->cur_size;
+            if (table->cur_size == 0)
+                continue;
+            total_size = sizeof(table_elem_type_t) * (uint64)table->cur_size;
+            if (total_size >= UINT32_MAX
+                || !(node->tables[i].elems =
+                         wasm_runtime_malloc((uint32)total_size)))
+                goto fail;
+            bh_memcpy_s(node->tables[i].elems, (uint32)total_size,
+                        table->elems, (uint32)total_size);
+        }
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (common->data_dropped
+        && !(node->data_dropped = bitmap_map_clone(common->data_dropped)))
+        goto fail;
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (common->elem_dropped
+        && !(node->elem_dropped = bitmap_map_clone(common->elem_dropped)))
+        goto fail;
+#endif
+    (void)common;
+
+    return node;
+
+fail:
+    recycled_instance_free(node);
+    return NULL;
+}
+
+/* Restore the state of an instance saved when it was created */
+static void
+recycled_instance_reset(WASMRecycledInstance *node)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)node->module_inst;
+    WASMModuleInstanceExtraCommon *common =
+        get_module_inst_extra_common(node->module_inst);
+    WASMTableInstance *table;
+    uint32 i;
+
+    if (node->global_data) {
+        bh_memcpy_s(module_inst->global_data, module_inst->global_data_size,
+                    node->global_data, module_inst->global_data_size);
+    }
+
+    for (i = 0; i < node->table_count; i++) {
+        table = module_inst->tables[i];
+        table->cur_size = node->tables[i].cur_size;
+        if (table->cur_size > 0) {
+            bh_memcpy_s(table->elems,
+                        (uint32)sizeof(table_elem_type_t) * table->cur_size,
+                        node->tables[i].elems,
+                        (uint32)sizeof(table_elem_type_t) * table->cur_size);
+        }
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (node->data_dropped) {
+        bh_memcpy_s(common->data_dropped->map,
+                    bitmap_map_size(common->data_dropped), node->data_dropped,
+                    bitmap_map_size(common->data_dropped));
+    }
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (node->elem_dropped) {
+        bh_memcpy_s(common->elem_dropped->map,
+                    bitmap_map_size(common->elem_dropped), node->elem_dropped,
+                    bitmap_map_size(common->elem_dropped));
+    }
+#endif
+    (void)common;
+}
+
+WASMModuleInstanceCommon *
+wasm_cluster_acquire_instance(WASMExecEnv *exec_env, uint32 stack_size)
+{
+    WASMCluster *cluster = wasm_exec_env_get_cluster(exec_env);
+    WASMModuleInstanceCommon *module_inst = get_module_inst(exec_env);
+    WASMModuleCommon *module = wasm_exec_env_get_module(exec_env);
+    WASMModuleInstanceCommon *new_module_inst = NULL;
+    WASMRecycledInstance *node = NULL;
+
+    bh_assert(cluster);
+
+    os_mutex_lock(&cluster->pool_lock);
+    if (cluster->idle_instance_num > 0) {
+        for (node = cluster->recycled_instances; node; node = node->next) {
+            if (!node->in_use) {
+                node->in_use = true;
+                cluster->idle_instance_num--;
+                break;
+            }
+        }
+    }
+    os_mutex_unlock(&cluster->pool_lock);
+
+    if (node) {
+        /* The imports of the C API were duplicated when the instance
+           was created, only reset what the parent may have changed */
+        new_module_inst = node->module_inst;
+        wasm_runtime_set_custom_data_internal(
+            new_module_inst, wasm_runtime_get_custom_data(module_inst));
+        wasm_native_inherit_contexts(new_module_inst, module_inst);
+        return new_module_inst;
+    }
+
+    if (!(new_module_inst = wasm_runtime_instantiate_internal(
+              module, module_inst, exec_env, stack_size, 0, 0, NULL, 0)))
+        return NULL;
+
+    wasm_runtime_set_custom_data_internal(
+        new_module_inst, wasm_runtime_get_custom_data(module_inst));
+
+    wasm_native_inherit_contexts(new_module_inst, module_inst);
+
+    if (!(wasm_cluster_dup_c_api_imports(new_module_inst, module_inst))) {
+        wasm_runtime_deinstantiate_internal(new_module_inst, true);
+        return NULL;
+    }
+
+    /* Save the state of the instance for recycling, it is destroyed when
+       released if that fails */
+    if (cluster_thread_pool_size > 0 && instance_is_recyclable(new_module_inst)
+        && (node = recycled_instance_create(new_module_inst))) {
+        node->in_use = true;
+        os_mutex_lock(&cluster->pool_lock);
+        node->next = cluster->recycled_instances;
+        cluster->recycled_instances = node;
+        os_mutex_unlock(&cluster->pool_lock);
+    }
+
+    return new_module_inst;
+}
+
+void
+wasm_cluster_release_instance(WASMCluster *cluster,
+                              WASMModuleInstanceCommon *module_inst)
+{
+    WASMRecycledInstance *node, *prev = NULL;
+    bool has_exception = wasm_runtime_get_exception(module_inst) != NULL;
+
+    os_mutex_lock(&cluster->pool_lock);
+
+    for (node = cluster->recycled_instances; node; node = node->next) {
+        if (node->module_inst == module_inst)
+            break;
+        prev = node;
+    }
+
+    if (node) {
+        bh_assert(node->in_use);
+        if (!cluster->pool_destroyed
+            && cluster->idle_instance_num < cluster_thread_pool_size
+            && !has_exception) {
+            recycled_instance_reset(node);
+            node->in_use = false;
+            cluster->idle_instance_num++;
+            os_mutex_unlock(&cluster->pool_lock);
+            return;
+        }
+
+        if (prev)
+            prev->next = node->next;
+        else
+            cluster->recycled_instances = node->next;
+        recycled_instance_free(node);
+    }
+
+    os_mutex_unlock(&cluster->pool_lock);
+
+    wasm_runtime_deinstantiate_internal(module_inst, true);
+}
+
 static void
 destroy_cluster_visitor(void *node, void *user_data)
 {
@@ -331,9 +725,43 @@ destroy_cluster_visitor(void *node, void *user_data)
     destroy_node->destroy_cb(cluster);
 }
 
+static void
+thread_pool_destroy(WASMCluster *cluster)
+{
+    WASMThreadPoolWorker *worker;
+    WASMRecycledInstance *node, *next;
+
+    os_mutex_lock(&cluster->pool_lock);
+    cluster->pool_destroyed = true;
+    /* Wake up the parked workers and wait until all workers exit */
+    for (worker = cluster->workers; worker; worker = worker->next)
+        os_cond_signal(&worker->cond);
+    while (cluster->worker_num > 0)
+        os_cond_wait(&cluster->pool_cond, &cluster->pool_lock);
+
+    node = cluster->recycled_instances;
+    cluster->recycled_instances = NULL;
+    cluster->idle_instance_num = 0;
+    os_mutex_unlock(&cluster->pool_lock);
+
+    while (node) {
+        next = node->next;
+        /* The instances in use are destroyed by their owners */
+        if (!node->in_use)
+            wasm_runtime_deinstantiate_internal(node->module_inst, true);
+        recycled_instance_free(node);
+        node = next;
+    }
+
+    os_cond_destroy(&cluster->pool_cond);
+    os_mutex_destroy(&cluster->pool_lock);
+}
+
 void
 wasm_cluster_destroy(WASMCluster *cluster)
 {
+    thread_pool_destroy(cluster);
+
     traverse_list(destroy_callback_list, destroy_cluster_visitor,
                   (void *)cluster);
 
@@ -505,21 +933,11 @@ wasm_cluster_spawn_exec_env(WASMExecEnv *exec_env)
         return NULL;
     }
 
-    if (!(new_module_inst = wasm_runtime_instantiate_internal(
-              module, module_inst, exec_env, stack_size, 0, 0, NULL, 0))) {
+    if (!(new_module_inst =
+              wasm_cluster_acquire_instance(exec_env, stack_size))) {
         return NULL;
     }
 
-    /* Set custom_data to new module instance */
-    wasm_runtime_set_custom_data_internal(
-        new_module_inst, wasm_runtime_get_custom_data(module_inst));
-
-    wasm_native_inherit_contexts(new_module_inst, module_inst);
-
-    if (!(wasm_cluster_dup_c_api_imports(new_module_inst, module_inst))) {
-        goto fail1;
-    }
-
     if (!wasm_cluster_allocate_aux_stack(exec_env, &aux_stack_start,
                                          &aux_stack_size)) {
         LOG_ERROR("thread manager error: "
@@ -579,7 +997,7 @@ fail2:
     /* free the allocated aux stack space */
     wasm_cluster_free_aux_stack(exec_env, aux_stack_start);
 fail1:
-    wasm_runtime_deinstantiate_internal(new_module_inst, true);
+    wasm_cluster_release_instance(cluster, new_module_inst);
 
     return NULL;
 }
@@ -616,18 +1034,17 @@ wasm_cluster_destroy_spawned_exec_env(WASMExecEnv *exec_env)
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
     /* Destroy exec_env */
     wasm_exec_env_destroy_internal(exec_env);
-    /* Routine exit, destroy instance */
-    wasm_runtime_deinstantiate_internal(module_inst, true);
+    /* Routine exit, recycle or destroy instance */
+    wasm_cluster_release_instance(cluster, module_inst);
 
     os_mutex_unlock(&cluster->lock);
 }
 
-/* start routine of thread manager */
+/* Run the thread routine of exec_env and free its resources */
 static void *
-thread_manager_start_routine(void *arg)
+thread_manager_run_thread(WASMExecEnv *exec_env)
 {
     void *ret;
-    WASMExecEnv *exec_env = (WASMExecEnv *)arg;
     WASMCluster *cluster = wasm_exec_env_get_cluster(exec_env);
     WASMModuleInstanceCommon *module_inst =
         wasm_exec_env_get_module_inst(exec_env);
@@ -666,8 +1083,10 @@ thread_manager_start_routine(void *arg)
 
     os_mutex_lock(&cluster->lock);
 
-    /* Detach the native thread here to ensure the resources are freed */
-    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached) {
+    /* Detach the native thread here to ensure the resources are freed,
+       the native threads of the thread pool are always detached */
+    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached
+        && !exec_env->thread_is_pooled) {
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
            thread be released after joining */
@@ -686,23 +1105,182 @@ thread_manager_start_routine(void *arg)
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
     /* Destroy exec_env */
     wasm_exec_env_destroy_internal(exec_env);
-    /* Routine exit, destroy instance */
-    wasm_runtime_deinstantiate_internal(module_inst, true);
+    /* Routine exit, recycle or destroy instance */
+    wasm_cluster_release_instance(cluster, module_inst);
 
     os_mutex_unlock(&cluster->lock);
 
     os_mutex_unlock(&cluster_list_lock);
 
+    return ret;
+}
+
+/* start routine of thread manager */
+static void *
+thread_manager_start_routine(void *arg)
+{
+    void *ret = thread_manager_run_thread((WASMExecEnv *)arg);
+
     os_thread_exit(ret);
     return ret;
 }
 
-int32
-wasm_cluster_create_thread(WASMExecEnv *exec_env,
-                           wasm_module_inst_t module_inst,
-                           bool is_aux_stack_allocated, uint64 aux_stack_start,
-                           uint32 aux_stack_size,
-                           void *(*thread_routine)(void *), void *arg)
+/* Remove a worker from the thread pool, the caller should lock
+   cluster->pool_lock */
+static void
+thread_pool_remove_worker(WASMCluster *cluster, WASMThreadPoolWorker *worker)
+{
+    WASMThreadPoolWorker **p_worker = &cluster->workers;
+
+    while (*p_worker != worker)
+        p_worker = &(*p_worker)->next;
+    *p_worker = worker->next;
+
+    if (worker->idle)
+        cluster->idle_worker_num--;
+    cluster->worker_num--;
+    /* Wake up the threads joining the wasm thread of the worker, and
+       the thread destroying the cluster */
+    os_cond_broadcast(&cluster->pool_cond);
+
+    os_cond_destroy(&worker->cond);
+    wasm_runtime_free(worker);
+}
+
+/* start routine of the native threads of the thread pool */
+static void *
+thread_pool_worker_routine(void *arg)
+{
+    WASMThreadPoolWorker *worker = (WASMThreadPoolWorker *)arg;
+    WASMCluster *cluster = worker->cluster;
+    WASMExecEnv *exec_env;
+    uint64 timeout = cluster_thread_idle_timeout_ms > 0
+                         ? (uint64)cluster_thread_idle_timeout_ms * 1000
+                         : BHT_WAIT_FOREVER;
+
+    os_mutex_lock(&cluster->pool_lock);
+
+    while (true) {
+        /* Park until a wasm thread is assigned, the idle timeout
+           expires or the cluster is destroyed */
+        while (!worker->exec_env && !cluster->pool_destroyed) {
+            if (os_cond_reltimedwait(&worker->cond, &cluster->pool_lock,
+                                     timeout)
+                != BHT_OK)
+                break;
+        }
+        if (!(exec_env = worker->exec_env))
+            break;
+
+        os_mutex_unlock(&cluster->pool_lock);
+        thread_manager_run_thread(exec_env);
+        os_mutex_lock(&cluster->pool_lock);
+
+        worker->exec_env = NULL;
+        worker->ticket = 0;
+        /* Wake up the threads joining the wasm thread */
+        os_cond_broadcast(&cluster->pool_cond);
+
+        if (cluster->pool_destroyed
+            || cluster->idle_worker_num >= cluster_thread_pool_size)
+            break;
+        worker->idle = true;
+        cluster->idle_worker_num++;
+    }
+
+    /* The cluster may be destroyed once the pool lock is unlocked */
+    thread_pool_remove_worker(cluster, worker);
+    os_mutex_unlock(&cluster->pool_lock);
+
+    return NULL;
+}
+
+/* Run the wasm thread of exec_env on a parked worker of the thread pool,
+   or on a new worker if there is none, the caller should lock
+   cluster->lock */
+static bool
+thread_pool_run_thread(WASMCluster *cluster, WASMExecEnv *exec_env)
+{
+    WASMThreadPoolWorker *worker;
+
+    os_mutex_lock(&cluster->pool_lock);
+
+    for (worker = cluster->workers; worker; worker = worker->next) {
+        if (worker->idle)
+            break;
+    }
+
+    if (worker) {
+        worker->idle = false;
+        cluster->idle_worker_num--;
+    }
+    else {
+        if (!(worker = wasm_runtime_malloc(sizeof(WASMThreadPoolWorker)))) {
+            LOG_ERROR("thread manager error: failed to allocate memory");
+            goto fail;
+        }
+        memset(worker, 0, sizeof(WASMThreadPoolWorker));
+        worker->cluster = cluster;
+
+        if (os_cond_init(&worker->cond) != 0) {
+            wasm_runtime_free(worker);
+            goto fail;
+        }
+
+        /* The worker waits for the pool lock before reading its
+           exec_env, so it can't exit before being added to the pool */
+        if (0
+            != os_thread_create(&worker->handle, thread_pool_worker_routine,
+                                worker, APP_THREAD_STACK_SIZE_DEFAULT)) {
+            os_cond_destroy(&worker->cond);
+            wasm_runtime_free(worker);
+            goto fail;
+        }
+        os_thread_detach(worker->handle);
+
+        worker->next = cluster->workers;
+        cluster->workers = worker;
+        cluster->worker_num++;
+    }
+
+    exec_env->handle = worker->handle;
+    exec_env->thread_is_pooled = true;
+    exec_env->pool_ticket = worker->ticket = ++cluster->pool_ticket_count;
+    worker->exec_env = exec_env;
+    os_cond_signal(&worker->cond);
+
+    os_mutex_unlock(&cluster->pool_lock);
+    return true;
+
+fail:
+    os_mutex_unlock(&cluster->pool_lock);
+    return false;
+}
+
+/* Wait until the pooled wasm thread with the ticket finishes */
+static void
+thread_pool_join_thread(WASMCluster *cluster, uint64 ticket)
+{
+    WASMThreadPoolWorker *worker;
+
+    os_mutex_lock(&cluster->pool_lock);
+    while (true) {
+        for (worker = cluster->workers; worker; worker = worker->next) {
+            if (worker->ticket == ticket)
+                break;
+        }
+        if (!worker)
+            break;
+        os_cond_wait(&cluster->pool_cond, &cluster->pool_lock);
+    }
+    os_mutex_unlock(&cluster->pool_lock);
+}
+
+static int32
+cluster_create_thread(WASMExecEnv *exec_env, wasm_module_inst_t module_inst,
+                      bool is_aux_stack_allocated, uint64 aux_stack_start,
+                      uint32 aux_stack_size, void *(*thread_routine)(void *),
+                      void *arg, bool is_pooled)
 {
     WASMCluster *cluster;
     WASMExecEnv *new_exec_env;
@@ -747,6 +1325,13 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
     new_exec_env->thread_start_routine = thread_routine;
     new_exec_env->thread_arg = arg;
 
+    if (is_pooled) {
+        if (!thread_pool_run_thread(cluster, new_exec_env))
+            goto fail3;
+        os_mutex_unlock(&cluster->lock);
+        return 0;
+    }
+
     os_mutex_lock(&new_exec_env->wait_lock);
 
     if (0
@@ -776,6 +1361,28 @@ fail1:
     return -1;
 }
 
+int32
+wasm_cluster_create_thread(WASMExecEnv *exec_env,
+                           wasm_module_inst_t module_inst,
+                           bool is_aux_stack_allocated, uint64 aux_stack_start,
+                           uint32 aux_stack_size,
+                           void *(*thread_routine)(void *), void *arg)
+{
+    return cluster_create_thread(exec_env, module_inst, is_aux_stack_allocated,
+                                 aux_stack_start, aux_stack_size,
+                                 thread_routine, arg, false);
+}
+
+int32
+wasm_cluster_create_pooled_thread(WASMExecEnv *exec_env,
+                                  wasm_module_inst_t module_inst,
+                                  void *(*thread_routine)(void *), void *arg)
+{
+    return cluster_create_thread(exec_env, module_inst, false, 0, 0,
+                                 thread_routine, arg,
+                                 cluster_thread_pool_size > 0);
+}
+
 bool
 wasm_cluster_dup_c_api_imports(WASMModuleInstanceCommon *module_inst_dst,
                                const WASMModuleInstanceCommon *module_inst_src)
@@ -991,6 +1598,19 @@ wasm_cluster_join_thread(WASMExecEnv *exec_env, void **ret_val)
         return 0;
     }
 
+    if (exec_env->thread_is_pooled) {
+        WASMCluster *cluster = exec_env->cluster;
+        /* The exec_env may be freed and reallocated for another pooled
+           thread once cluster_list_lock is unlocked */
+        uint64 ticket = exec_env->pool_ticket;
+
+        os_mutex_unlock(&cluster_list_lock);
+        if (ret_val)
+            *ret_val = NULL;
+        thread_pool_join_thread(cluster, ticket);
+        return 0;
+    }
+
     os_mutex_lock(&exec_env->wait_lock);
     exec_env->wait_count++;
     handle = exec_env->handle;
@@ -1016,7 +1636,8 @@ wasm_cluster_detach_thread(WASMExecEnv *exec_env)
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
            thread be released after joining */
-        ret = os_thread_detach(exec_env->handle);
+        if (!exec_env->thread_is_pooled)
+            ret = os_thread_detach(exec_env->handle);
         exec_env->thread_is_detached = true;
     }
     os_mutex_unlock(&cluster_list_lock);
@@ -1028,6 +1649,7 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
 {
     WASMCluster *cluster;
     WASMModuleInstanceCommon *module_inst;
+    WASMThreadPoolWorker *worker = NULL;
 
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     if (exec_env->jmpbuf_stack_top) {
@@ -1062,12 +1684,22 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
 
     /* App exit the thread, free the resources before exit native thread */
 
+    if (exec_env->thread_is_pooled) {
+        /* The native thread exits, its worker is removed from the pool */
+        os_mutex_lock(&cluster->pool_lock);
+        worker = cluster->workers;
+        while (worker->exec_env != exec_env)
+            worker = worker->next;
+        os_mutex_unlock(&cluster->pool_lock);
+    }
+
     os_mutex_lock(&cluster_list_lock);
 
     os_mutex_lock(&cluster->lock);
 
     /* Detach the native thread here to ensure the resources are freed */
-    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached) {
+    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached
+        && !exec_env->thread_is_pooled) {
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
            thread be released after joining */
@@ -1082,13 +1714,19 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
     /* Destroy exec_env */
     wasm_exec_env_destroy_internal(exec_env);
-    /* Routine exit, destroy instance */
-    wasm_runtime_deinstantiate_internal(module_inst, true);
+    /* Routine exit, recycle or destroy instance */
+    wasm_cluster_release_instance(cluster, module_inst);
 
     os_mutex_unlock(&cluster->lock);
 
     os_mutex_unlock(&cluster_list_lock);
 
+    if (worker) {
+        os_mutex_lock(&cluster->pool_lock);
+        thread_pool_remove_worker(cluster, worker);
+        os_mutex_unlock(&cluster->pool_lock);
+    }
+
     os_thread_exit(retval);
 }
 
@@ -1108,6 +1746,10 @@ set_thread_cancel_flags(WASMExecEnv *exec_env)
 #ifdef OS_ENABLE_WAKEUP_BLOCKING_OP
     wasm_runtime_interrupt_blocking_op(exec_env);
 #endif
+#if WASM_ENABLE_SHARED_MEMORY != 0
+    /* Wake up the thread if it is blocked in atomic.wait */
+    wasm_runtime_atomic_wait_interrupt(exec_env->module_inst);
+#endif
 }
 
 static void
@@ -51,6 +51,28 @@ struct WASMCluster {
      * with lock, see wasm_cluster_wait_for_all and wasm_cluster_terminate_all
      */
     bool processing;
+
+    /* The thread pool, see wasm_cluster_set_thread_pool_options.
+       pool_lock protects the fields below, and mustn't be held when
+       locking cluster->lock or cluster_list_lock */
+    korp_mutex pool_lock;
+    /* Signaled when a pooled thread finishes or a worker exits */
+    korp_cond pool_cond;
+    /* The native threads of the pool, either running a wasm thread
+       or parked to wait for one */
+    struct WASMThreadPoolWorker *workers;
+    uint32 worker_num;
+    uint32 idle_worker_num;
+    /* The ticket count of the wasm threads run by the pool, a joiner
+       waits for the ticket of its thread rather than the exec_env, whose
+       memory may be reused by a later thread */
+    uint64 pool_ticket_count;
+    /* The sibling module instances which can be reused by new threads */
+    struct WASMRecycledInstance *recycled_instances;
+    uint32 idle_instance_num;
+    /* Set when the cluster is being destroyed, the parked workers exit */
+    bool pool_destroyed;
+
 #if WASM_ENABLE_DEBUG_INTERP != 0
     WASMDebugInstance *debug_inst;
 #endif
@@ -66,6 +88,9 @@ struct WASMCluster {
 void
 wasm_cluster_set_max_thread_num(uint32 num);
 
+void
+wasm_cluster_set_thread_pool_options(uint32 pool_size, uint32 idle_timeout_ms);
+
 bool
 thread_manager_init(void);
 
@@ -96,6 +121,26 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
                            uint32 aux_stack_size,
                            void *(*thread_routine)(void *), void *arg);
 
+/* Same as wasm_cluster_create_thread without an allocated aux stack, but
+   run the thread on a parked native thread of the thread pool if there is
+   one. Joining a pooled thread doesn't get the return value of the thread
+   routine. */
+int32
+wasm_cluster_create_pooled_thread(WASMExecEnv *exec_env,
+                                  wasm_module_inst_t module_inst,
+                                  void *(*thread_routine)(void *), void *arg);
+
+/* Instantiate a sibling module instance of the exec_env's module instance
+   for a new thread, or reuse one released by an exited thread */
+WASMModuleInstanceCommon *
+wasm_cluster_acquire_instance(WASMExecEnv *exec_env, uint32 stack_size);
+
+/* Keep a module instance got from wasm_cluster_acquire_instance in the
+   thread pool, or deinstantiate it if it can't be reused */
+void
+wasm_cluster_release_instance(WASMCluster *cluster,
+                              WASMModuleInstanceCommon *module_inst);
+
 int32
 wasm_cluster_join_thread(WASMExecEnv *exec_env, void **ret_val);
 
@@ -4,6 +4,9 @@
  */
 
 #include "ems_gc_internal.h"
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+#include "bh_atomic.h"
+#endif
 
 #if WASM_ENABLE_GC != 0
 #define LOCK_HEAP(heap)                                                \
@@ -328,6 +331,18 @@ gci_add_fc(gc_heap_t *heap, hmu_t *hmu, gc_size_t size)
     return true;
 }
 
+static inline void
+update_highmark_size(gc_heap_t *heap)
+{
+#if WASM_ENABLE_GC != 0
+    /* The free chunks not swept yet aren't counted in total_free_size */
+    if (heap->sweep_cursor)
+        return;
+#endif
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
+}
+
 /**
  * Find a proper hmu for required memory size
  *
@@ -412,10 +427,7 @@ alloc_hmu(gc_heap_t *heap, gc_size_t size)
             }
 
             heap->total_free_size -= size;
-            if ((heap->current_size - heap->total_free_size)
-                > heap->highmark_size)
-                heap->highmark_size =
-                    heap->current_size - heap->total_free_size;
+            update_highmark_size(heap);
 
             hmu_set_size((hmu_t *)p, size);
             return (hmu_t *)p;
@@ -469,8 +481,7 @@ alloc_hmu(gc_heap_t *heap, gc_size_t size)
         }
 
         heap->total_free_size -= size;
-        if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
-            heap->highmark_size = heap->current_size - heap->total_free_size;
+        update_highmark_size(heap);
 
         hmu_set_size((hmu_t *)last_tp, size);
         tp_ret = (uintptr_t)last_tp;
@@ -488,7 +499,7 @@ do_gc_heap(gc_heap_t *heap)
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
     uint64 start = 0, end = 0, time = 0;
 
-    start = os_time_get_boot_microsecond();
+    start = os_time_get_boot_us();
 #endif
     if (heap->is_reclaim_enabled) {
         UNLOCK_HEAP(heap);
@@ -496,7 +507,7 @@ do_gc_heap(gc_heap_t *heap)
         LOCK_HEAP(heap);
     }
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
-    end = os_time_get_boot_microsecond();
+    end = os_time_get_boot_us();
     time = end - start;
     heap->total_gc_time += time;
     if (time > heap->max_gc_time) {
@@ -506,6 +517,31 @@ do_gc_heap(gc_heap_t *heap)
 #endif
     return ret;
 }
+
+/**
+ * Sweep the pending part of heap for one slice of time and then try to
+ * allocate, the pause of an allocation is bounded by the pause budget
+ *
+ * @return hmu allocated if success, NULL otherwise
+ */
+static hmu_t *
+alloc_hmu_with_lazy_sweep(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *ret;
+    gc_uint64 start, deadline;
+
+    if ((ret = alloc_hmu(heap, size)) || !heap->sweep_cursor)
+        return ret;
+
+    start = os_time_get_boot_us();
+    /* Sweep a few blocks at least even if the budget is cleared */
+    deadline = start + (heap->pause_budget_us ? heap->pause_budget_us : 1);
+    gci_sweep_heap(heap, deadline);
+    gci_add_pause_time(heap->sweep_pause_histogram,
+                       os_time_get_boot_us() - start);
+
+    return alloc_hmu(heap, size);
+}
 #endif
 
 /**
@@ -515,9 +551,13 @@ do_gc_heap(gc_heap_t *heap)
  * @param size should cover the header and should be 8 bytes aligned
  *
  * Note: This function will try several ways to satisfy the allocation request:
- *   1. Find a proper on available HMUs.
- *   2. GC will be triggered if 1 failed.
- *   3. Find a proper on available HMUS.
+ *   1. Find a proper on available HMUs, sweep the heap for one slice
+ *      if the sweep of last GC hasn't finished.
+ *   2. GC will be triggered if 1 failed, which finishes the pending sweep
+ *      before marking.
+ *   3. Find a proper on available HMUS, sweep one slice of the sweep left
+ *      by the GC, and the whole rest of it if still failed, since the
+ *      heap is exhausted otherwise.
  *   4. Return NULL if 3 failed
  *
  * @return hmu allocated if success, which will be aligned to 8 bytes,
@@ -530,6 +570,12 @@ alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
     bh_assert(size > 0 && !(size & 7));
 
 #if WASM_ENABLE_GC != 0
+    if (heap->sweep_cursor) {
+        hmu_t *ret = alloc_hmu_with_lazy_sweep(heap, size);
+        if (ret)
+            return ret;
+    }
+
 #if GC_IN_EVERY_ALLOCATION != 0
     if (GC_SUCCESS != do_gc_heap(heap))
         return NULL;
@@ -547,11 +593,422 @@ alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
             return NULL;
     }
 #endif
+
+    /* the sweep may be left unfinished by the GC */
+    if (heap->sweep_cursor) {
+        hmu_t *ret = alloc_hmu_with_lazy_sweep(heap, size);
+        if (ret || !heap->sweep_cursor)
+            return ret;
+        gci_sweep_heap(heap, 0);
+    }
 #endif
 
     return alloc_hmu(heap, size);
 }
 
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Set the header of the rest of nursery, which is a vo block
+ */
+static void
+set_nursery_rest(hmu_t *hmu, gc_size_t size)
+{
+    bool pinuse = hmu_get_pinuse(hmu) ? true : false;
+
+    hmu->header = 0;
+    if (pinuse)
+        hmu_mark_pinuse(hmu);
+    hmu_set_ut(hmu, HMU_VO);
+    hmu_set_size(hmu, size);
+#if BH_ENABLE_GC_VERIFY != 0
+    hmu_init_prefix_and_suffix(hmu, size, __FILE__, __LINE__);
+#endif
+}
+
+/**
+ * Take a nursery from the free chunks of heap, GC will not be performed
+ *
+ * @return true if success, false if the heap is nearly full or no free
+ *         chunk is big enough
+ */
+static bool
+take_nursery(gc_heap_t *heap)
+{
+    gc_size_t size = heap->nursery_size;
+    hmu_t *hmu;
+
+    bh_assert(!heap->nursery_start);
+
+    /* leave the free chunks to the old wos when the heap is nearly full,
+       a major GC will be triggered by them */
+    if (heap->total_free_size < heap->gc_threshold + size)
+        return false;
+
+    if (!(hmu = alloc_hmu(heap, size)))
+        return false;
+
+    size = hmu_get_size(hmu);
+    set_nursery_rest(hmu, size);
+
+    heap->nursery_start = heap->nursery_cur = hmu;
+    heap->nursery_end = (hmu_t *)((char *)hmu + size);
+    return true;
+}
+
+/**
+ * Allocate a HMU for a young wo by bumping the nursery pointer
+ *
+ * @return hmu allocated with Y bit set if success, NULL if there is
+ *         no nursery or the nursery is full
+ */
+static inline hmu_t *
+alloc_young_hmu(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *hmu = heap->nursery_cur;
+    gc_size_t free_size;
+    bool pinuse;
+
+    if (!hmu)
+        return NULL;
+
+    if (size < GC_SMALLEST_SIZE)
+        size = GC_SMALLEST_SIZE;
+
+    free_size = (gc_size_t)((char *)heap->nursery_end - (char *)hmu);
+    if (free_size < size)
+        return NULL;
+
+    if (free_size - size < GC_SMALLEST_SIZE)
+        size = free_size;
+    else
+        set_nursery_rest((hmu_t *)((char *)hmu + size), free_size - size);
+
+    heap->nursery_cur = (hmu_t *)((char *)hmu + size);
+    if (heap->nursery_cur < heap->nursery_end)
+        hmu_mark_pinuse(heap->nursery_cur);
+
+    pinuse = hmu_get_pinuse(hmu) ? true : false;
+    hmu->header = 0;
+    if (pinuse)
+        hmu_mark_pinuse(hmu);
+    hmu_set_ut(hmu, HMU_WO);
+    hmu_set_size(hmu, size);
+    hmu_mark_young(hmu);
+    return hmu;
+}
+
+/**
+ * Allocate a HMU for a young wo, the nursery is collected by a minor
+ * GC if it is full, and a new nursery is taken from the heap
+ *
+ * @return hmu allocated if success, NULL otherwise, the wo should
+ *         then be allocated out of the nursery
+ */
+static hmu_t *
+alloc_young_hmu_ex(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *hmu;
+
+    if ((hmu = alloc_young_hmu(heap, size)))
+        return hmu;
+
+    if (heap->nursery_start) {
+        /* the nursery is released by the minor GC, the young wos are
+           all promoted if it fails */
+        UNLOCK_HEAP(heap);
+        gci_minor_gc_heap(heap);
+        LOCK_HEAP(heap);
+    }
+
+    if (!heap->nursery_start && !take_nursery(heap))
+        return NULL;
+
+    return alloc_young_hmu(heap, size);
+}
+#endif /* end of WASM_ENABLE_GC_NURSERY != 0 */
+
+/**
+ * Allocate a HMU for a VM object, the heap lock must be held
+ */
+static hmu_t *
+alloc_vo_hmu(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *hmu = alloc_hmu_ex(heap, size);
+
+    if (!hmu)
+        return NULL;
+
+    bh_assert(hmu_get_size(hmu) >= size);
+
+#if GC_STAT_DATA != 0
+    heap->total_size_allocated += hmu_get_size(hmu);
+#endif
+
+    hmu_set_ut(hmu, HMU_VO);
+    hmu_unfree_vo(hmu);
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    hmu_uncache_vo(hmu);
+#endif
+    return hmu;
+}
+
+/**
+ * Free the HMU of a VM object, the heap lock must be held
+ */
+static int
+free_vo_hmu(gc_heap_t *heap, hmu_t *hmu)
+{
+    gc_uint8 *base_addr = heap->base_addr;
+    gc_uint8 *end_addr = base_addr + heap->current_size;
+    hmu_t *prev = NULL;
+    hmu_t *next = NULL;
+    gc_size_t size;
+
+    if (hmu_is_vo_freed(hmu)) {
+        bh_assert(0);
+        return GC_ERROR;
+    }
+
+    size = hmu_get_size(hmu);
+
+#if GC_STAT_DATA != 0
+    heap->total_size_freed += size;
+#endif
+
+    if (gci_is_hmu_unswept(heap, hmu)) {
+        /* Leave it to the pending sweep, which merges it with
+           the adjacent free chunks and counts the free size */
+        hmu_free_vo(hmu);
+        return GC_SUCCESS;
+    }
+
+    heap->total_free_size += size;
+
+    if (!hmu_get_pinuse(hmu)) {
+        prev = (hmu_t *)((char *)hmu - *((int *)hmu - 1));
+
+        if (hmu_is_in_heap(prev, base_addr, end_addr)
+            && hmu_get_ut(prev) == HMU_FC) {
+            size += hmu_get_size(prev);
+            hmu = prev;
+            if (!unlink_hmu(heap, prev))
+                return GC_ERROR;
+        }
+    }
+
+    next = (hmu_t *)((char *)hmu + size);
+    if (hmu_is_in_heap(next, base_addr, end_addr)) {
+        if (hmu_get_ut(next) == HMU_FC && !gci_is_hmu_unswept(heap, next)) {
+            size += hmu_get_size(next);
+            if (!unlink_hmu(heap, next))
+                return GC_ERROR;
+            next = (hmu_t *)((char *)hmu + size);
+        }
+    }
+
+    if (!gci_add_fc(heap, hmu, size))
+        return GC_ERROR;
+
+    if (hmu_is_in_heap(next, base_addr, end_addr)) {
+        hmu_unmark_pinuse(next);
+    }
+
+    return GC_SUCCESS;
+}
+
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+/* Index plus one of the thread cache used by current thread, 0 if it
+   hasn't been assigned */
+static os_thread_local_attribute gc_uint32 thread_cache_idx;
+static bh_atomic_32_t thread_cache_assigned;
+
+static gc_thread_cache_t *
+get_thread_cache(gc_heap_t *heap)
+{
+    if (thread_cache_idx == 0)
+        thread_cache_idx =
+            BH_ATOMIC_32_FETCH_ADD(thread_cache_assigned, 1)
+                % GC_THREAD_CACHE_NUM
+            + 1;
+    return heap->thread_caches + thread_cache_idx - 1;
+}
+
+static inline void
+push_cached_hmu(gc_thread_cache_t *cache, hmu_t *hmu, uint32 idx)
+{
+    hmu_normal_node_t *node = (hmu_normal_node_t *)hmu;
+
+    hmu_cache_vo(hmu);
+    set_hmu_normal_node_next(node, cache->bins[idx]);
+    cache->bins[idx] = node;
+    cache->counts[idx]++;
+}
+
+static inline hmu_t *
+pop_cached_hmu(gc_thread_cache_t *cache, uint32 idx)
+{
+    hmu_normal_node_t *node = cache->bins[idx];
+
+    if (node) {
+        cache->bins[idx] = get_hmu_normal_node_next(node);
+        cache->counts[idx]--;
+        hmu_uncache_vo((hmu_t *)node);
+    }
+    return (hmu_t *)node;
+}
+
+/* Return the blocks of a bin to the heap until `keep` blocks are left,
+   the lock of the cache must be held */
+static void
+flush_bin(gc_heap_t *heap, gc_thread_cache_t *cache, uint32 idx, uint32 keep)
+{
+    LOCK_HEAP(heap);
+    while (cache->counts[idx] > keep)
+        free_vo_hmu(heap, pop_cached_hmu(cache, idx));
+    UNLOCK_HEAP(heap);
+}
+
+/* Return all the blocks of a cache to the heap, the lock of the cache
+   must be held */
+static void
+flush_thread_cache(gc_heap_t *heap, gc_thread_cache_t *cache)
+{
+    uint32 idx;
+
+    LOCK_HEAP(heap);
+    for (idx = 0; idx < HMU_NORMAL_NODE_CNT; idx++) {
+        while (cache->bins[idx])
+            free_vo_hmu(heap, pop_cached_hmu(cache, idx));
+    }
+    UNLOCK_HEAP(heap);
+    cache->op_count = 0;
+}
+
+static hmu_t *
+thread_cache_alloc(gc_heap_t *heap, gc_size_t size)
+{
+    gc_thread_cache_t *cache = get_thread_cache(heap);
+    hmu_t *hmu, *extra;
+    gc_size_t extra_size;
+    uint32 i;
+
+    if (size < GC_SMALLEST_SIZE)
+        size = GC_SMALLEST_SIZE;
+
+    os_mutex_lock(&cache->lock);
+
+    if (!(hmu = pop_cached_hmu(cache, size >> 3))) {
+        /* Refill the cache with a batch of blocks, the blocks got from
+           the heap may be a little larger than the size required, so
+           they are cached by their own sizes */
+        LOCK_HEAP(heap);
+        hmu = alloc_vo_hmu(heap, size);
+        for (i = 1; hmu && i < GC_THREAD_CACHE_REFILL_CNT; i++) {
+            if (!(extra = alloc_vo_hmu(heap, size)))
+                break;
+            extra_size = hmu_get_size(extra);
+            if (HMU_IS_FC_NORMAL(extra_size)
+                && cache->counts[extra_size >> 3] < GC_THREAD_CACHE_BIN_MAX)
+                push_cached_hmu(cache, extra, extra_size >> 3);
+            else
+                free_vo_hmu(heap, extra);
+        }
+        UNLOCK_HEAP(heap);
+    }
+
+    if (hmu && ++cache->op_count >= GC_THREAD_CACHE_FLUSH_INTERVAL)
+        flush_thread_cache(heap, cache);
+
+    os_mutex_unlock(&cache->lock);
+    return hmu;
+}
+
+static int
+thread_cache_free(gc_heap_t *heap, hmu_t *hmu)
+{
+    gc_thread_cache_t *cache = get_thread_cache(heap);
+    uint32 idx = hmu_get_size(hmu) >> 3;
+
+    os_mutex_lock(&cache->lock);
+
+    /* The block may be freed twice, and it may be in the cache of
+       another thread, check its header bits but not the bins */
+    if (hmu_is_vo_freed(hmu) || hmu_is_vo_cached(hmu)) {
+        os_mutex_unlock(&cache->lock);
+        LOG_ERROR("[GC_ERROR]Free the memory twice.\n");
+        return GC_ERROR;
+    }
+
+    push_cached_hmu(cache, hmu, idx);
+    if (cache->counts[idx] > GC_THREAD_CACHE_BIN_MAX)
+        flush_bin(heap, cache, idx, GC_THREAD_CACHE_BIN_MAX / 2);
+    else if (++cache->op_count >= GC_THREAD_CACHE_FLUSH_INTERVAL)
+        flush_thread_cache(heap, cache);
+
+    os_mutex_unlock(&cache->lock);
+    return GC_SUCCESS;
+}
+
+void
+gci_flush_thread_caches(gc_heap_t *heap)
+{
+    gc_thread_cache_t *cache;
+    uint32 i;
+
+    for (i = 0; i < GC_THREAD_CACHE_NUM; i++) {
+        cache = heap->thread_caches + i;
+        os_mutex_lock(&cache->lock);
+        flush_thread_cache(heap, cache);
+        os_mutex_unlock(&cache->lock);
+    }
+}
+
+int
+gc_enable_thread_cache(gc_handle_t handle)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    gc_thread_cache_t *caches;
+    uint32 i;
+
+    if (heap->thread_caches)
+        return GC_SUCCESS;
+
+    if (!(caches = gc_alloc_vo(heap, sizeof(gc_thread_cache_t)
+                                         * GC_THREAD_CACHE_NUM)))
+        return GC_ERROR;
+
+    memset(caches, 0, sizeof(gc_thread_cache_t) * GC_THREAD_CACHE_NUM);
+    for (i = 0; i < GC_THREAD_CACHE_NUM; i++) {
+        if (os_mutex_init(&caches[i].lock) != BHT_OK) {
+            while (i > 0)
+                os_mutex_destroy(&caches[--i].lock);
+            gc_free_vo(heap, caches);
+            return GC_ERROR;
+        }
+    }
+
+    heap->thread_caches = caches;
+    return GC_SUCCESS;
+}
+
+void
+gci_destroy_thread_caches(gc_heap_t *heap)
+{
+    gc_thread_cache_t *caches = heap->thread_caches;
+    uint32 i;
+
+    if (!caches)
+        return;
+
+    gci_flush_thread_caches(heap);
+    for (i = 0; i < GC_THREAD_CACHE_NUM; i++)
+        os_mutex_destroy(&caches[i].lock);
+
+    heap->thread_caches = NULL;
+    gc_free_vo(heap, caches);
+}
+#endif /* end of WASM_ENABLE_ALLOC_THREAD_CACHE != 0 */
+
 #if BH_ENABLE_GC_VERIFY == 0
 gc_object_t
 gc_alloc_vo(void *vheap, gc_size_t size)
@@ -580,24 +1037,32 @@ gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
     }
 #endif
 
-    LOCK_HEAP(heap);
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    if (heap->thread_caches && HMU_IS_FC_NORMAL(tot_size))
+        hmu = thread_cache_alloc(heap, tot_size);
+#endif
 
-    hmu = alloc_hmu_ex(heap, tot_size);
-    if (!hmu)
-        goto finish;
+    if (!hmu) {
+        LOCK_HEAP(heap);
+        hmu = alloc_vo_hmu(heap, tot_size);
+        UNLOCK_HEAP(heap);
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+        if (!hmu && heap->thread_caches) {
+            /* The free memory may be held by the thread caches */
+            gci_flush_thread_caches(heap);
+            LOCK_HEAP(heap);
+            hmu = alloc_vo_hmu(heap, tot_size);
+            UNLOCK_HEAP(heap);
+        }
+#endif
+        if (!hmu)
+            return NULL;
+    }
 
-    bh_assert(hmu_get_size(hmu) >= tot_size);
     /* the total size allocated may be larger than
        the required size, reset it here */
     tot_size = hmu_get_size(hmu);
 
-#if GC_STAT_DATA != 0
-    heap->total_size_allocated += tot_size;
-#endif
-
-    hmu_set_ut(hmu, HMU_VO);
-    hmu_unfree_vo(hmu);
-
 #if BH_ENABLE_GC_VERIFY != 0
     hmu_init_prefix_and_suffix(hmu, tot_size, file, line);
 #endif
@@ -607,8 +1072,6 @@ gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
         /* clear buffer appended by GC_ALIGN_8() */
         memset((uint8 *)ret + size, 0, tot_size - tot_size_unaligned);
 
-finish:
-    UNLOCK_HEAP(heap);
     return ret;
 }
 
@@ -662,13 +1125,17 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
         if (hmu_is_in_heap(hmu_next, base_addr, end_addr)) {
             ut = hmu_get_ut(hmu_next);
             tot_size_next = hmu_get_size(hmu_next);
-            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next) {
+            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next
+                /* the free chunk not swept yet isn't in the free lists */
+                && !gci_is_hmu_unswept(heap, hmu_next)) {
                 /* current node and next node meets requirement */
                 if (!unlink_hmu(heap, hmu_next)) {
                     UNLOCK_HEAP(heap);
                     return NULL;
                 }
                 hmu_set_size(hmu_old, tot_size);
+                heap->total_free_size -= tot_size - tot_size_old;
+                update_highmark_size(heap);
                 memset((char *)hmu_old + tot_size_old, 0,
                        tot_size - tot_size_old);
 #if BH_ENABLE_GC_VERIFY != 0
@@ -704,6 +1171,9 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
 
     hmu_set_ut(hmu, HMU_VO);
     hmu_unfree_vo(hmu);
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    hmu_uncache_vo(hmu);
+#endif
 
 #if BH_ENABLE_GC_VERIFY != 0
     hmu_init_prefix_and_suffix(hmu, tot_size, file, line);
@@ -781,7 +1251,17 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
 
     LOCK_HEAP(heap);
 
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (heap->nursery_size > 0 && heap->is_reclaim_enabled
+        && tot_size <= heap->nursery_size / GC_NURSERY_OBJ_RATIO)
+        hmu = alloc_young_hmu_ex(heap, tot_size);
+
+    if (!hmu && (hmu = alloc_hmu_ex(heap, tot_size)))
+        /* the Y bit may be left in the chunk by a young wo freed */
+        hmu_unmark_young(hmu);
+#else
     hmu = alloc_hmu_ex(heap, tot_size);
+#endif
     if (!hmu)
         goto finish;
 
@@ -813,6 +1293,12 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
         /* clear buffer appended by GC_ALIGN_8() */
         memset((uint8 *)ret + size, 0, tot_size - tot_size_unaligned);
 
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the old wo may be initialized with young wos without write barrier */
+    if (!hmu_is_young(hmu) && heap->nursery_cur != heap->nursery_start)
+        gci_remember_old_wo(heap, ret);
+#endif
+
 finish:
     UNLOCK_HEAP(heap);
     return ret;
@@ -844,10 +1330,6 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
     gc_heap_t *heap = (gc_heap_t *)vheap;
     gc_uint8 *base_addr, *end_addr;
     hmu_t *hmu = NULL;
-    hmu_t *prev = NULL;
-    hmu_t *next = NULL;
-    gc_size_t size = 0;
-    hmu_type_t ut;
     int ret = GC_SUCCESS;
 
     if (!obj) {
@@ -866,76 +1348,55 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
     base_addr = heap->base_addr;
     end_addr = base_addr + heap->current_size;
 
-    LOCK_HEAP(heap);
-
-    if (hmu_is_in_heap(hmu, base_addr, end_addr)) {
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    if (heap->thread_caches && hmu_is_in_heap(hmu, base_addr, end_addr)
+        && hmu_get_ut(hmu) == HMU_VO
+        && HMU_IS_FC_NORMAL(hmu_get_size(hmu))) {
 #if BH_ENABLE_GC_VERIFY != 0
         hmu_verify(heap, hmu);
 #endif
-        ut = hmu_get_ut(hmu);
-        if (ut == HMU_VO) {
-            if (hmu_is_vo_freed(hmu)) {
-                bh_assert(0);
-                ret = GC_ERROR;
-                goto out;
-            }
-
-            size = hmu_get_size(hmu);
-
-            heap->total_free_size += size;
-
-#if GC_STAT_DATA != 0
-            heap->total_size_freed += size;
+        return thread_cache_free(heap, hmu);
+    }
 #endif
 
-            if (!hmu_get_pinuse(hmu)) {
-                prev = (hmu_t *)((char *)hmu - *((int *)hmu - 1));
-
-                if (hmu_is_in_heap(prev, base_addr, end_addr)
-                    && hmu_get_ut(prev) == HMU_FC) {
-                    size += hmu_get_size(prev);
-                    hmu = prev;
-                    if (!unlink_hmu(heap, prev)) {
-                        ret = GC_ERROR;
-                        goto out;
-                    }
-                }
-            }
-
-            next = (hmu_t *)((char *)hmu + size);
-            if (hmu_is_in_heap(next, base_addr, end_addr)) {
-                if (hmu_get_ut(next) == HMU_FC) {
-                    size += hmu_get_size(next);
-                    if (!unlink_hmu(heap, next)) {
-                        ret = GC_ERROR;
-                        goto out;
-                    }
-                    next = (hmu_t *)((char *)hmu + size);
-                }
-            }
-
-            if (!gci_add_fc(heap, hmu, size)) {
-                ret = GC_ERROR;
-                goto out;
-            }
+    LOCK_HEAP(heap);
 
-            if (hmu_is_in_heap(next, base_addr, end_addr)) {
-                hmu_unmark_pinuse(next);
-            }
-        }
-        else {
+    if (hmu_is_in_heap(hmu, base_addr, end_addr)) {
+#if BH_ENABLE_GC_VERIFY != 0
+        hmu_verify(heap, hmu);
+#endif
+        if (hmu_get_ut(hmu) == HMU_VO)
+            ret = free_vo_hmu(heap, hmu);
+        else
             ret = GC_ERROR;
-            goto out;
-        }
-        ret = GC_SUCCESS;
-        goto out;
     }
 
-out:
     UNLOCK_HEAP(heap);
     return ret;
 }
 
+#if WASM_ENABLE_GC != 0
+static void
+dump_pause_histogram(const char *name, const gc_uint32 *histogram)
+{
+    uint32 i;
+
+    os_printf("%s pause histogram:\n", name);
+    for (i = 0; i < GC_PAUSE_HISTOGRAM_SIZE; i++) {
+        if (!histogram[i])
+            continue;
+        if (i == 0)
+            os_printf("  < 1 us: %" PRIu32 "\n", histogram[i]);
+        else if (i == GC_PAUSE_HISTOGRAM_SIZE - 1)
+            os_printf("  >= %" PRIu32 " us: %" PRIu32 "\n",
+                      (uint32)1 << (i - 1), histogram[i]);
+        else
+            os_printf("  %" PRIu32 " ~ %" PRIu32 " us: %" PRIu32 "\n",
+                      (uint32)1 << (i - 1), ((uint32)1 << i) - 1, histogram[i]);
+    }
+}
+#endif
+
 void
 gc_dump_heap_stats(gc_heap_t *heap)
 {
@@ -949,6 +1410,14 @@ gc_dump_heap_stats(gc_heap_t *heap)
               heap->total_size_allocated, heap->total_size_freed,
               heap->total_size_allocated - heap->total_size_freed);
 #endif
+#if WASM_ENABLE_GC != 0
+    dump_pause_histogram("gc", heap->gc_pause_histogram);
+    dump_pause_histogram("sweep slice", heap->sweep_pause_histogram);
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    os_printf("minor gc count: %" PRIu32 "\n", heap->minor_gc_count);
+    dump_pause_histogram("minor gc", heap->minor_gc_pause_histogram);
+#endif
 }
 
 uint32
@@ -5,13 +5,24 @@
 
 #include "ems_gc.h"
 #include "ems_gc_internal.h"
+#include "bh_atomic.h"
 
 #define GB (1 << 30UL)
 
 #define MARK_NODE_OBJ_CNT 256
 
+/* Check the time once per so many blocks swept */
+#define SWEEP_TIME_CHECK_INTERVAL 64
+
 #if WASM_ENABLE_GC != 0
 
+/* The markers set the mark bits of objects with atomic operations */
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0 && BH_ATOMIC_32_IS_ATOMIC != 0
+#define GC_PARALLEL_MARK 1
+#else
+#define GC_PARALLEL_MARK 0
+#endif
+
 /* mark node is used for gc marker*/
 typedef struct mark_node_struct {
     /* number of to-expand objects can be saved in this node */
@@ -58,25 +69,33 @@ free_mark_node(mark_node_t *node)
     BH_FREE((gc_object_t)node);
 }
 
+/* Free a list of mark nodes */
+static void
+free_mark_node_list(mark_node_t *node)
+{
+    mark_node_t *next;
+
+    while (node) {
+        next = node->next;
+        free_mark_node(node);
+        node = next;
+    }
+}
+
 /**
- * Sweep phase of mark_sweep algorithm
+ * Start the sweep phase of mark_sweep algorithm, the free lists are
+ * reset here and rebuilt by gci_sweep_heap
+ *
  * @param heap the heap to sweep, should be a valid instance heap
  *        which has already been marked
  */
 static void
-sweep_instance_heap(gc_heap_t *heap)
+sweep_instance_heap_begin(gc_heap_t *heap)
 {
-    hmu_t *cur = NULL, *end = NULL, *last = NULL;
-    hmu_type_t ut;
-    gc_size_t size;
     int i, lsize;
-    gc_size_t tot_free = 0;
 
     bh_assert(gci_is_heap_valid(heap));
-
-    cur = (hmu_t *)heap->base_addr;
-    last = NULL;
-    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+    bh_assert(!heap->sweep_cursor);
 
     /* reset KFC */
     lsize =
@@ -87,6 +106,42 @@ sweep_instance_heap(gc_heap_t *heap)
     heap->kfc_tree_root->right = NULL;
     heap->root_set = NULL;
 
+    /* the free chunks are counted again when they are swept */
+    heap->total_free_size = 0;
+    heap->sweep_cursor = (hmu_t *)heap->base_addr;
+
+#if GC_STAT_DATA != 0
+    heap->total_gc_count++;
+#endif
+}
+
+/* Add the free area [start, end) found by sweeping into the free lists */
+static void
+add_swept_free_area(gc_heap_t *heap, hmu_t *start, hmu_t *end)
+{
+    gc_size_t size = (gc_size_t)((char *)end - (char *)start);
+
+    heap->total_free_size += size;
+    gci_add_fc(heap, start, size);
+    hmu_mark_pinuse(start);
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_sweep_heap(gc_heap_t *heap, gc_uint64 deadline)
+{
+    hmu_t *cur = NULL, *end = NULL, *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+    uint32 block_cnt = 0;
+
+    bh_assert(gci_is_heap_valid(heap));
+    bh_assert(heap->sweep_cursor);
+
+    cur = heap->sweep_cursor;
+    last = NULL;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
     while (cur < end) {
         ut = hmu_get_ut(cur);
         size = hmu_get_size(cur);
@@ -114,9 +169,7 @@ sweep_instance_heap(gc_heap_t *heap)
         else {
             /* current block is still live */
             if (last) {
-                tot_free += (gc_size_t)((char *)cur - (char *)last);
-                gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
-                hmu_mark_pinuse(last);
+                add_swept_free_area(heap, last, cur);
                 last = NULL;
             }
 
@@ -127,40 +180,132 @@ sweep_instance_heap(gc_heap_t *heap)
         }
 
         cur = (hmu_t *)((char *)cur + size);
+
+        if (deadline && ++block_cnt >= SWEEP_TIME_CHECK_INTERVAL
+            && cur < end) {
+            block_cnt = 0;
+            if (os_time_get_boot_us() >= deadline) {
+                /* the free area before the cursor must be in the free
+                   lists, the rest of it is merged in next slice */
+                if (last)
+                    add_swept_free_area(heap, last, cur);
+                heap->sweep_cursor = cur;
+                return;
+            }
+        }
     }
 
     bh_assert(cur == end);
 
-    if (last) {
-        tot_free += (gc_size_t)((char *)cur - (char *)last);
-        gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
-        hmu_mark_pinuse(last);
-    }
+    if (last)
+        add_swept_free_area(heap, last, cur);
 
-    heap->total_free_size = tot_free;
+    heap->sweep_cursor = NULL;
 
 #if GC_STAT_DATA != 0
-    heap->total_gc_count++;
-    if ((heap->current_size - tot_free) > heap->highmark_size)
-        heap->highmark_size = heap->current_size - tot_free;
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
 
 #endif
     gc_update_threshold(heap);
 }
 
 /**
- * Add a to-expand node to the to-expand list
+ * Call the visitor with each non-null reference held by a wo
+ *
+ * @param obj the wo whose references to visit
+ * @param visit the visitor
+ * @param ctx the context passed to the visitor
+ *
+ * @return true if success, false if the reference list of the wo
+ *         can't be got
+ */
+static inline bool
+visit_wo_refs(gc_object_t obj, void (*visit)(void *ctx, gc_object_t ref),
+              void *ctx)
+{
+    hmu_t *hmu = obj_to_hmu(obj);
+    gc_object_t ref = NULL;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, size, offset, j;
+    gc_uint16 *ref_list = NULL;
+    bool is_compact_mode = false;
+
+    size = hmu_get_size(hmu);
+
+    if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode, &ref_num,
+                                         &ref_list, &ref_start_offset)) {
+        LOG_ERROR("mark process failed because failed "
+                  "vm_get_wasm_object_ref_list");
+        return false;
+    }
+
+    if (ref_num >= 2U * GB) {
+        LOG_ERROR("Invalid ref_num returned");
+        return false;
+    }
+
+    for (j = 0; j < ref_num; j++) {
+        if (is_compact_mode)
+            offset = ref_start_offset + j * (gc_uint32)sizeof(void *);
+        else
+            offset = ref_list[j];
+        bh_assert(offset + sizeof(void *) < size);
+
+        ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+        if (ref == NULL_REF || ((uintptr_t)ref & 1))
+            continue; /* null object or i31 object */
+        visit(ctx, ref);
+    }
+
+    (void)size;
+    return true;
+}
+
+/**
+ * Add a marked wo to the to-expand list, set is_fast_marking_failed if
+ * there is no more resource for the list
  *
  * @param heap should be a valid instance heap
  * @param obj should be a valid wo inside @heap
+ */
+static void
+push_wo_to_expand(gc_heap_t *heap, gc_object_t obj)
+{
+    mark_node_t *mark_node = NULL, *new_node = NULL;
+
+    if (heap->is_fast_marking_failed)
+        return;
+
+    mark_node = (mark_node_t *)heap->root_set;
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        new_node = alloc_mark_node();
+        if (!new_node) {
+            LOG_WARNING("can not add obj to mark node because of mark node "
+                        "allocation failed, switch to slow marking");
+            heap->is_fast_marking_failed = 1;
+            return;
+        }
+        new_node->next = mark_node;
+        heap->root_set = new_node;
+        mark_node = new_node;
+    }
+
+    mark_node->set[mark_node->idx++] = obj;
+}
+
+/**
+ * Mark a wo and add it to the to-expand list
  *
- * @return GC_ERROR if there is no more resource for marking,
- *         GC_SUCCESS if success
+ * If there is no more resource for the to-expand list, the wo is only
+ * marked and is_fast_marking_failed is set, and the marked wos which
+ * aren't expanded will be expanded in the slow mode of marking.
+ *
+ * @param heap should be a valid instance heap
+ * @param obj should be a valid wo inside @heap
  */
-static int
+static void
 add_wo_to_expand(gc_heap_t *heap, gc_object_t obj)
 {
-    mark_node_t *mark_node = NULL, *new_node = NULL;
     hmu_t *hmu = NULL;
 
     bh_assert(obj);
@@ -173,24 +318,22 @@ add_wo_to_expand(gc_heap_t *heap, gc_object_t obj)
     bh_assert(hmu_get_ut(hmu) == HMU_WO);
 
     if (hmu_is_wo_marked(hmu))
-        return GC_SUCCESS; /* already marked*/
+        return; /* already marked*/
 
-    mark_node = (mark_node_t *)heap->root_set;
-    if (!mark_node || mark_node->idx == mark_node->cnt) {
-        new_node = alloc_mark_node();
-        if (!new_node) {
-            LOG_ERROR("can not add obj to mark node because of mark node "
-                      "allocation failed");
-            return GC_ERROR;
-        }
-        new_node->next = mark_node;
-        heap->root_set = new_node;
-        mark_node = new_node;
-    }
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the minor GC neither marks nor expands the old wos */
+    if (heap->is_doing_minor_gc && !hmu_is_young(hmu))
+        return;
+#endif
 
-    mark_node->set[mark_node->idx++] = obj;
     hmu_mark_wo(hmu);
-    return GC_SUCCESS;
+    push_wo_to_expand(heap, obj);
+}
+
+static void
+mark_ref(void *heap, gc_object_t ref)
+{
+    add_wo_to_expand((gc_heap_t *)heap, ref);
 }
 
 /* Check ems_gc.h for description*/
@@ -223,11 +366,7 @@ gc_add_root(void *heap_p, gc_object_t obj)
         return GC_ERROR;
     }
 
-    if (add_wo_to_expand(heap, obj) != GC_SUCCESS) {
-        heap->is_fast_marking_failed = 1;
-        return GC_ERROR;
-    }
-
+    add_wo_to_expand(heap, obj);
     return GC_SUCCESS;
 }
 
@@ -239,7 +378,6 @@ gc_add_root(void *heap_p, gc_object_t obj)
 static void
 rollback_mark(gc_heap_t *heap)
 {
-    mark_node_t *mark_node = NULL, *next_mark_node = NULL;
     hmu_t *cur = NULL, *end = NULL;
     hmu_type_t ut;
     gc_size_t size;
@@ -247,14 +385,9 @@ rollback_mark(gc_heap_t *heap)
     bh_assert(gci_is_heap_valid(heap));
 
     /* roll back*/
-    mark_node = (mark_node_t *)heap->root_set;
-    while (mark_node) {
-        next_mark_node = mark_node->next;
-        free_mark_node(mark_node);
-        mark_node = next_mark_node;
-    }
-
+    free_mark_node_list((mark_node_t *)heap->root_set);
     heap->root_set = NULL;
+    heap->is_fast_marking_failed = 0;
 
     /* then traverse the heap to unmark all marked wos*/
 
@@ -275,23 +408,499 @@ rollback_mark(gc_heap_t *heap)
     bh_assert(cur == end);
 }
 
+/**
+ * Expand the objects in the to-expand list until the list is empty
+ *
+ * @param heap the heap to mark, should be a valid instance heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+mark_heap(gc_heap_t *heap)
+{
+    mark_node_t *mark_node = NULL;
+    uint32 idx;
+
+    /* the algorithm we use to mark all objects */
+    /* 1. mark rootset and organize them into a mark_node list (last marked
+     * roots at list header, i.e. stack top) */
+    /* 2. in every iteration, we use the top node to expand*/
+    /* 3. execute step 2 till no expanding */
+    /* this is a BFS & DFS mixed algorithm, but more like DFS */
+    mark_node = (mark_node_t *)heap->root_set;
+    while (mark_node) {
+        heap->root_set = mark_node->next;
+
+        for (idx = 0; idx < mark_node->idx; idx++) {
+            if (!visit_wo_refs(mark_node->set[idx], mark_ref, heap)) {
+                free_mark_node(mark_node);
+                return GC_ERROR;
+            }
+        }
+
+        /* obj's in mark_node are all expanded */
+#if WASM_ENABLE_GC_NURSERY != 0
+        if (heap->is_doing_minor_gc) {
+            /* the young wos marked are swept by sweep_nursery */
+            mark_node->next = (mark_node_t *)heap->survivor_list;
+            heap->survivor_list = mark_node;
+        }
+        else
+#endif
+            free_mark_node(mark_node);
+        mark_node = heap->root_set;
+    }
+
+    return GC_SUCCESS;
+}
+
+/* Size of the fixed stack used in slow mode of marking */
+#define SLOW_MARK_STACK_SIZE 64
+
+typedef struct slow_mark_ctx {
+    /* the block being walked through */
+    hmu_t *cur;
+    /* whether a wo before cur is newly marked but not expanded, which
+       requires another round of walking */
+    bool rewalk;
+    /* the newly marked wos to expand before walking to next block */
+    uint32 top;
+    gc_object_t stack[SLOW_MARK_STACK_SIZE];
+} slow_mark_ctx_t;
+
+static void
+slow_mark_ref(void *ctx_p, gc_object_t ref)
+{
+    slow_mark_ctx_t *ctx = (slow_mark_ctx_t *)ctx_p;
+    hmu_t *hmu = obj_to_hmu(ref);
+
+    bh_assert(hmu_get_ut(hmu) == HMU_WO);
+
+    if (hmu_is_wo_marked(hmu))
+        return;
+
+    hmu_mark_wo(hmu);
+    if (ctx->top < SLOW_MARK_STACK_SIZE)
+        ctx->stack[ctx->top++] = ref;
+    else if (hmu < ctx->cur)
+        ctx->rewalk = true;
+    /* else it will be expanded when walking to it */
+}
+
+/**
+ * The slow mode of marking, which doesn't require additional memory:
+ * walk through all the blocks and expand the marked wos until no new
+ * wo is marked. The wos newly marked are expanded at once with a small
+ * fixed stack when possible, to avoid walking the heap again.
+ *
+ * @param heap the heap to mark, should be a valid instance heap whose
+ *        to-expand list is empty
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+mark_heap_slowly(gc_heap_t *heap)
+{
+    slow_mark_ctx_t ctx = { 0 };
+    hmu_t *end;
+
+    bh_assert(!heap->root_set);
+
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    do {
+        ctx.rewalk = false;
+        ctx.cur = (hmu_t *)heap->base_addr;
+
+        while (ctx.cur < end) {
+            if (hmu_get_ut(ctx.cur) == HMU_WO && hmu_is_wo_marked(ctx.cur)
+                && !visit_wo_refs(hmu_to_obj(ctx.cur), slow_mark_ref, &ctx))
+                return GC_ERROR;
+
+            while (ctx.top > 0) {
+                if (!visit_wo_refs(ctx.stack[--ctx.top], slow_mark_ref, &ctx))
+                    return GC_ERROR;
+            }
+
+            ctx.cur = (hmu_t *)((char *)ctx.cur + hmu_get_size(ctx.cur));
+        }
+    } while (ctx.rewalk);
+
+    return GC_SUCCESS;
+}
+
+#if GC_PARALLEL_MARK != 0
+typedef struct parallel_mark_ctx {
+    korp_mutex lock;
+    korp_cond cond;
+    /* the to-expand nodes shared by all the markers */
+    mark_node_t *shared_nodes;
+    /* number of the markers, including the current thread */
+    uint32 marker_num;
+    /* number of the markers waiting for the shared nodes */
+    bh_atomic_32_t idle_marker_num;
+    /* whether all the markers should quit */
+    bool done;
+    /* whether the reference list of an object can't be got */
+    bool failed;
+} parallel_mark_ctx_t;
+
+typedef struct marker {
+    parallel_mark_ctx_t *ctx;
+    /* the to-expand nodes owned by this marker */
+    mark_node_t *mark_nodes;
+    /* whether a marked wo isn't added to the to-expand list */
+    bool is_fast_marking_failed;
+} marker_t;
+
+static void
+share_mark_node(parallel_mark_ctx_t *ctx, mark_node_t *node)
+{
+    os_mutex_lock(&ctx->lock);
+    node->next = ctx->shared_nodes;
+    ctx->shared_nodes = node;
+    os_cond_signal(&ctx->cond);
+    os_mutex_unlock(&ctx->lock);
+}
+
+/**
+ * Take a shared to-expand node, wait until some marker shares one
+ *
+ * @return the node taken, NULL if there is no more node to expand
+ */
+static mark_node_t *
+take_shared_mark_node(parallel_mark_ctx_t *ctx)
+{
+    mark_node_t *node = NULL;
+
+    os_mutex_lock(&ctx->lock);
+    BH_ATOMIC_32_FETCH_ADD(ctx->idle_marker_num, 1);
+    while (!ctx->done) {
+        if ((node = ctx->shared_nodes)) {
+            ctx->shared_nodes = node->next;
+            node->next = NULL;
+            BH_ATOMIC_32_FETCH_SUB(ctx->idle_marker_num, 1);
+            break;
+        }
+        if (BH_ATOMIC_32_LOAD(ctx->idle_marker_num) == ctx->marker_num) {
+            /* all the markers are idle, the marking is finished */
+            ctx->done = true;
+            os_cond_broadcast(&ctx->cond);
+            break;
+        }
+        os_cond_wait(&ctx->cond, &ctx->lock);
+    }
+    os_mutex_unlock(&ctx->lock);
+
+    return node;
+}
+
+static void
+parallel_mark_ref(void *marker_p, gc_object_t ref)
+{
+    marker_t *marker = (marker_t *)marker_p;
+    mark_node_t *mark_node = marker->mark_nodes, *new_node;
+    hmu_t *hmu = obj_to_hmu(ref);
+    const gc_uint32 mark_bit = (gc_uint32)1 << HMU_WO_MB_OFFSET;
+
+    /* the wo may be marked by other markers at the same time */
+    if ((BH_ATOMIC_32_LOAD(hmu->header) & mark_bit)
+        || (BH_ATOMIC_32_FETCH_OR(hmu->header, mark_bit) & mark_bit))
+        return;
+
+    if (marker->is_fast_marking_failed)
+        return;
+
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        if (!(new_node = alloc_mark_node())) {
+            marker->is_fast_marking_failed = true;
+            return;
+        }
+        if (mark_node && BH_ATOMIC_32_LOAD(marker->ctx->idle_marker_num) > 0) {
+            /* hand the full node over to the idle markers */
+            marker->mark_nodes = mark_node->next;
+            share_mark_node(marker->ctx, mark_node);
+            mark_node = marker->mark_nodes;
+        }
+        new_node->next = mark_node;
+        marker->mark_nodes = mark_node = new_node;
+    }
+
+    mark_node->set[mark_node->idx++] = ref;
+}
+
+static void
+run_marker(marker_t *marker)
+{
+    parallel_mark_ctx_t *ctx = marker->ctx;
+    mark_node_t *mark_node;
+    uint32 idx;
+
+    while (true) {
+        if ((mark_node = marker->mark_nodes))
+            marker->mark_nodes = mark_node->next;
+        else if (!(mark_node = take_shared_mark_node(ctx)))
+            break;
+
+        for (idx = 0; idx < mark_node->idx; idx++) {
+            if (!visit_wo_refs(mark_node->set[idx], parallel_mark_ref,
+                               marker)) {
+                os_mutex_lock(&ctx->lock);
+                ctx->failed = ctx->done = true;
+                os_cond_broadcast(&ctx->cond);
+                os_mutex_unlock(&ctx->lock);
+
+                free_mark_node(mark_node);
+                free_mark_node_list(marker->mark_nodes);
+                marker->mark_nodes = NULL;
+                return;
+            }
+        }
+
+        free_mark_node(mark_node);
+    }
+}
+
+/* The mark helper threads shared by all the heaps, which are created by
+   the first parallel marking and parked between GCs */
+typedef struct gc_mark_pool {
+    korp_mutex lock;
+    /* signaled when a marking round starts or the helpers should quit */
+    korp_cond start_cond;
+    /* signaled when the last helper finishes its marking round */
+    korp_cond finish_cond;
+    korp_tid tids[GC_MARK_HELPER_THREAD_NUM];
+    uint32 helper_num;
+    /* increased for every marking round */
+    uint32 round;
+    /* number of the helpers still marking in the current round */
+    uint32 busy_num;
+    /* the markers of the current round, the ith helper uses the
+       (i + 1)th one, the first one is used by the thread doing GC */
+    marker_t *markers;
+    /* whether a heap is being marked by the helpers, the other heaps
+       are marked by their own threads only in the meantime */
+    bool is_busy;
+    /* whether the helpers have been tried to create */
+    bool is_helper_created;
+    bool quit;
+} gc_mark_pool_t;
+
+static gc_mark_pool_t mark_pool;
+static bool mark_pool_inited = false;
+
+static void *
+mark_helper_thread(void *arg)
+{
+    uint32 idx = (uint32)(uintptr_t)arg, round = 0;
+    marker_t *marker;
+
+    os_mutex_lock(&mark_pool.lock);
+    while (true) {
+        while (!mark_pool.quit && mark_pool.round == round)
+            os_cond_wait(&mark_pool.start_cond, &mark_pool.lock);
+        if (mark_pool.quit)
+            break;
+
+        round = mark_pool.round;
+        marker = mark_pool.markers + idx + 1;
+        os_mutex_unlock(&mark_pool.lock);
+
+        run_marker(marker);
+
+        os_mutex_lock(&mark_pool.lock);
+        if (--mark_pool.busy_num == 0)
+            os_cond_signal(&mark_pool.finish_cond);
+    }
+    os_mutex_unlock(&mark_pool.lock);
+
+    return NULL;
+}
+
+/* Create the helper threads, called with the pool locked */
+static void
+create_mark_helpers(void)
+{
+    uint32 i;
+
+    mark_pool.is_helper_created = true;
+    for (i = 0; i < GC_MARK_HELPER_THREAD_NUM; i++) {
+        if (os_thread_create(&mark_pool.tids[i], mark_helper_thread,
+                             (void *)(uintptr_t)i,
+                             APP_THREAD_STACK_SIZE_DEFAULT)
+            != BHT_OK) {
+            LOG_WARNING("create gc mark helper thread failed");
+            break;
+        }
+        mark_pool.helper_num++;
+    }
+}
+
+int
+gc_init_mark_pool(void)
+{
+    bh_assert(!mark_pool_inited);
+
+    memset(&mark_pool, 0, sizeof(gc_mark_pool_t));
+    if (os_mutex_init(&mark_pool.lock) != BHT_OK)
+        return GC_ERROR;
+    if (os_cond_init(&mark_pool.start_cond) != BHT_OK)
+        goto fail1;
+    if (os_cond_init(&mark_pool.finish_cond) != BHT_OK)
+        goto fail2;
+
+    mark_pool_inited = true;
+    return GC_SUCCESS;
+
+fail2:
+    os_cond_destroy(&mark_pool.start_cond);
+fail1:
+    os_mutex_destroy(&mark_pool.lock);
+    return GC_ERROR;
+}
+
+void
+gc_destroy_mark_pool(void)
+{
+    uint32 i;
+
+    if (!mark_pool_inited)
+        return;
+
+    os_mutex_lock(&mark_pool.lock);
+    bh_assert(!mark_pool.is_busy);
+    mark_pool.quit = true;
+    os_cond_broadcast(&mark_pool.start_cond);
+    os_mutex_unlock(&mark_pool.lock);
+
+    for (i = 0; i < mark_pool.helper_num; i++)
+        os_thread_join(mark_pool.tids[i], NULL);
+
+    os_cond_destroy(&mark_pool.finish_cond);
+    os_cond_destroy(&mark_pool.start_cond);
+    os_mutex_destroy(&mark_pool.lock);
+    mark_pool_inited = false;
+}
+
+/**
+ * Expand the objects in the to-expand list with the current thread
+ * and the helper threads: each marker expands the nodes owned by
+ * itself, and shares the full nodes with the idle markers. The helper
+ * threads are shared by all the heaps, the heap is marked by the current
+ * thread only if they are marking another heap.
+ *
+ * @param heap the heap to mark, should be a valid instance heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+mark_heap_in_parallel(gc_heap_t *heap)
+{
+    parallel_mark_ctx_t ctx = { 0 };
+    marker_t markers[GC_MARK_HELPER_THREAD_NUM + 1] = { 0 };
+    uint32 i, helper_num;
+
+    if (!mark_pool_inited)
+        return mark_heap(heap);
+
+    os_mutex_lock(&mark_pool.lock);
+    if (!mark_pool.is_helper_created)
+        create_mark_helpers();
+    if (mark_pool.is_busy || mark_pool.helper_num == 0) {
+        os_mutex_unlock(&mark_pool.lock);
+        return mark_heap(heap);
+    }
+    mark_pool.is_busy = true;
+    helper_num = mark_pool.helper_num;
+    os_mutex_unlock(&mark_pool.lock);
+
+    if (os_mutex_init(&ctx.lock) != BHT_OK)
+        goto fail1;
+
+    if (os_cond_init(&ctx.cond) != BHT_OK)
+        goto fail2;
+
+    ctx.shared_nodes = (mark_node_t *)heap->root_set;
+    heap->root_set = NULL;
+    ctx.marker_num = helper_num + 1;
+
+    for (i = 0; i <= helper_num; i++) {
+        markers[i].ctx = &ctx;
+    }
+
+    /* Start a marking round of the helpers */
+    os_mutex_lock(&mark_pool.lock);
+    mark_pool.markers = markers;
+    mark_pool.busy_num = helper_num;
+    mark_pool.round++;
+    os_cond_broadcast(&mark_pool.start_cond);
+    os_mutex_unlock(&mark_pool.lock);
+
+    run_marker(&markers[0]);
+
+    /* Wait until the helpers finish, they don't touch the markers
+       and ctx after that */
+    os_mutex_lock(&mark_pool.lock);
+    while (mark_pool.busy_num > 0)
+        os_cond_wait(&mark_pool.finish_cond, &mark_pool.lock);
+    mark_pool.markers = NULL;
+    mark_pool.is_busy = false;
+    os_mutex_unlock(&mark_pool.lock);
+
+    for (i = 0; i <= helper_num; i++) {
+        bh_assert(!markers[i].mark_nodes);
+        if (markers[i].is_fast_marking_failed)
+            heap->is_fast_marking_failed = 1;
+    }
+
+    /* the nodes left when the marking failed */
+    free_mark_node_list(ctx.shared_nodes);
+
+    os_cond_destroy(&ctx.cond);
+    os_mutex_destroy(&ctx.lock);
+
+    return ctx.failed ? GC_ERROR : GC_SUCCESS;
+
+fail2:
+    os_mutex_destroy(&ctx.lock);
+fail1:
+    os_mutex_lock(&mark_pool.lock);
+    mark_pool.is_busy = false;
+    os_mutex_unlock(&mark_pool.lock);
+    return mark_heap(heap);
+}
+#elif WASM_ENABLE_GC_PARALLEL_MARK != 0
+int
+gc_init_mark_pool(void)
+{
+    return GC_SUCCESS;
+}
+
+void
+gc_destroy_mark_pool(void)
+{}
+#endif /* end of GC_PARALLEL_MARK != 0 */
+
 /**
  * Reclaim GC instance heap
  *
  * @param heap the heap to reclaim, should be a valid instance heap
+ * @param sweep_deadline the time to stop sweeping and leave the rest
+ *        of heap to the later allocations, 0 to sweep the whole heap
  *
  * @return GC_SUCCESS if success, GC_ERROR otherwise
  */
 static int
-reclaim_instance_heap(gc_heap_t *heap)
+reclaim_instance_heap(gc_heap_t *heap, gc_uint64 sweep_deadline)
 {
+    int ret;
+    bool is_enumerated;
+#if BH_ENABLE_GC_VERIFY != 0
     mark_node_t *mark_node = NULL;
-    int idx = 0, j = 0;
-    bool ret, is_compact_mode = false;
-    gc_object_t obj = NULL, ref = NULL;
+    gc_object_t obj = NULL;
     hmu_t *hmu = NULL;
-    gc_uint32 ref_num = 0, ref_start_offset = 0, size = 0, offset = 0;
-    gc_uint16 *ref_list = NULL;
+    int idx = 0;
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
 
@@ -300,14 +909,18 @@ reclaim_instance_heap(gc_heap_t *heap)
 #if WASM_ENABLE_THREAD_MGR == 0
     if (!heap->exec_env)
         return GC_SUCCESS;
-    ret = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
 #else
     if (!heap->cluster)
         return GC_SUCCESS;
-    ret = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
 #endif
-    if (!ret)
+    if (!is_enumerated) {
+        LOG_ERROR("enumerate rootset failed");
+        LOG_ERROR("all marked wos will be unmarked to keep heap consistency");
+        rollback_mark(heap);
         return GC_ERROR;
+    }
 
 #if BH_ENABLE_GC_VERIFY != 0
     /* no matter whether the enumeration is successful or not, the data
@@ -334,103 +947,511 @@ reclaim_instance_heap(gc_heap_t *heap)
     }
 #endif
 
-    /* TODO: when fast marking failed, we can still do slow
-       marking, currently just simply roll it back.  */
-    if (heap->is_fast_marking_failed) {
-        LOG_ERROR("enumerate rootset failed");
-        LOG_ERROR("all marked wos will be unmarked to keep heap consistency");
+#if GC_PARALLEL_MARK != 0
+    if (heap->current_size >= GC_PARALLEL_MARK_MIN_HEAP_SIZE)
+        ret = mark_heap_in_parallel(heap);
+    else
+#endif
+        ret = mark_heap(heap);
+
+    /* when fast marking failed, expand the marked wos which
+       weren't added to the to-expand list in slow mode */
+    if (ret == GC_SUCCESS && heap->is_fast_marking_failed) {
+        LOG_VERBOSE("mark node allocation failed, do slow marking");
+        free_mark_node_list((mark_node_t *)heap->root_set);
+        heap->root_set = NULL;
+        ret = mark_heap_slowly(heap);
+        heap->is_fast_marking_failed = 0;
+    }
 
+    if (ret != GC_SUCCESS) {
+        LOG_ERROR("mark process is not successfully finished");
+        /* roll back is required */
         rollback_mark(heap);
-        heap->is_fast_marking_failed = 0;
         return GC_ERROR;
     }
 
-    /* the algorithm we use to mark all objects */
-    /* 1. mark rootset and organize them into a mark_node list (last marked
-     * roots at list header, i.e. stack top) */
-    /* 2. in every iteration, we use the top node to expand*/
-    /* 3. execute step 2 till no expanding */
-    /* this is a BFS & DFS mixed algorithm, but more like DFS */
-    mark_node = (mark_node_t *)heap->root_set;
-    while (mark_node) {
-        heap->root_set = mark_node->next;
+    /* now sweep */
+    sweep_instance_heap_begin(heap);
+    gci_sweep_heap(heap, sweep_deadline);
 
-        /* note that mark_node->idx may change in each loop */
-        for (idx = 0; idx < (int)mark_node->idx; idx++) {
-            obj = mark_node->set[idx];
-            hmu = obj_to_hmu(obj);
-            size = hmu_get_size(hmu);
+    return GC_SUCCESS;
+}
 
-            if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode,
-                                                 &ref_num, &ref_list,
-                                                 &ref_start_offset)) {
-                LOG_ERROR("mark process failed because failed "
-                          "vm_get_wasm_object_ref_list");
-                break;
-            }
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Append a wo to a list of mark nodes, set the overflowed flag if there
+ * is no more resource for the list
+ */
+static void
+remember_wo(void **p_list, bool *p_is_overflowed, gc_object_t obj)
+{
+    mark_node_t *mark_node = (mark_node_t *)*p_list, *new_node;
+
+    if (*p_is_overflowed)
+        return;
 
-            if (ref_num >= 2U * GB) {
-                LOG_ERROR("Invalid ref_num returned");
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        if (!(new_node = alloc_mark_node())) {
+            *p_is_overflowed = true;
+            return;
+        }
+        new_node->next = mark_node;
+        *p_list = mark_node = new_node;
+    }
+
+    mark_node->set[mark_node->idx++] = obj;
+}
+
+#if GC_NURSERY_ESCAPED_LIST != 0
+/* The heaps with nursery, the write barrier looks up the heap of the
+   young wo here, and the escaped_wo_list of each heap is also protected
+   by the lock */
+static korp_mutex nursery_heap_list_lock = OS_THREAD_MUTEX_INITIALIZER;
+static gc_heap_t *nursery_heap_list;
+
+/**
+ * Take the escaped_wo_list of a heap
+ *
+ * @param heap the heap
+ * @param p_is_overflowed to return whether the list has overflowed
+ *
+ * @return the list taken, which should be freed by the caller
+ */
+static mark_node_t *
+take_escaped_wo_list(gc_heap_t *heap, bool *p_is_overflowed)
+{
+    mark_node_t *list;
+
+    os_mutex_lock(&nursery_heap_list_lock);
+    list = (mark_node_t *)heap->escaped_wo_list;
+    *p_is_overflowed = heap->is_escaped_wo_list_overflowed;
+    heap->escaped_wo_list = NULL;
+    heap->is_escaped_wo_list_overflowed = false;
+    os_mutex_unlock(&nursery_heap_list_lock);
+    return list;
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_link_nursery_heap(gc_heap_t *heap, bool link)
+{
+    gc_heap_t **p_heap;
+    mark_node_t *list = NULL;
+
+    os_mutex_lock(&nursery_heap_list_lock);
+    for (p_heap = &nursery_heap_list; *p_heap;
+         p_heap = &(*p_heap)->next_nursery_heap) {
+        if (*p_heap == heap)
+            break;
+    }
+
+    if (link && !*p_heap) {
+        heap->next_nursery_heap = nursery_heap_list;
+        heap->escaped_wo_list = NULL;
+        heap->is_escaped_wo_list_overflowed = false;
+        nursery_heap_list = heap;
+    }
+    else if (!link && *p_heap) {
+        *p_heap = heap->next_nursery_heap;
+        heap->next_nursery_heap = NULL;
+        list = (mark_node_t *)heap->escaped_wo_list;
+        heap->escaped_wo_list = NULL;
+        heap->is_escaped_wo_list_overflowed = false;
+    }
+    os_mutex_unlock(&nursery_heap_list_lock);
+
+    free_mark_node_list(list);
+}
+#endif
+
+/* Check ems_gc.h for description */
+void
+gc_write_barrier(gc_object_t obj, gc_object_t value)
+{
+    hmu_t *hmu = obj_to_hmu(value);
+#if GC_NURSERY_ESCAPED_LIST != 0
+    gc_heap_t *heap;
+#endif
+
+    if (!hmu_is_young(hmu) || hmu_is_wo_marked(hmu)
+        || hmu_is_young(obj_to_hmu(obj)))
+        return;
+
+    /* the young wo stored into an old wo escapes from the nursery,
+       mark it so that the minor GC takes it as a root */
+#if GC_NURSERY_ESCAPED_LIST != 0
+    /* this is done once for each escaped young wo, so the lookup of its
+       heap is cheap enough */
+    os_mutex_lock(&nursery_heap_list_lock);
+    if (!hmu_is_wo_marked(hmu)) {
+        hmu_mark_wo(hmu);
+        for (heap = nursery_heap_list; heap; heap = heap->next_nursery_heap) {
+            if ((gc_uint8 *)hmu >= heap->base_addr
+                && (gc_uint8 *)hmu < heap->base_addr + heap->current_size) {
+                remember_wo(&heap->escaped_wo_list,
+                            &heap->is_escaped_wo_list_overflowed, value);
                 break;
             }
+        }
+        bh_assert(heap);
+    }
+    os_mutex_unlock(&nursery_heap_list_lock);
+#else
+    hmu_mark_wo(hmu);
+#endif
+}
 
-            if (is_compact_mode) {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_start_offset + j * sizeof(void *);
-                    bh_assert(offset + sizeof(void *) < size);
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("add_wo_to_expand failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
-            }
-            else {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_list[j];
-                    bh_assert(offset + sizeof(void *) < size);
-
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("mark process failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
+/* Check ems_gc_internal.h for description */
+void
+gci_remember_old_wo(gc_heap_t *heap, gc_object_t obj)
+{
+    remember_wo(&heap->old_wo_list, &heap->is_old_wo_list_overflowed, obj);
+}
+
+static void
+adjust_wo_list(mark_node_t *mark_node, intptr_t offset)
+{
+    uint32 idx;
+
+    for (; mark_node; mark_node = mark_node->next) {
+        for (idx = 0; idx < mark_node->idx; idx++)
+            mark_node->set[idx] =
+                (gc_object_t)((intptr_t)mark_node->set[idx] + offset);
+    }
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_adjust_nursery_wo_lists(gc_heap_t *heap, intptr_t offset)
+{
+    adjust_wo_list((mark_node_t *)heap->old_wo_list, offset);
+#if GC_NURSERY_ESCAPED_LIST != 0
+    os_mutex_lock(&nursery_heap_list_lock);
+    adjust_wo_list((mark_node_t *)heap->escaped_wo_list, offset);
+    os_mutex_unlock(&nursery_heap_list_lock);
+#endif
+}
+
+/* Add the free area [start, end) found in the nursery into the free lists */
+static void
+add_nursery_free_area(gc_heap_t *heap, hmu_t *start, hmu_t *end)
+{
+    gc_uint8 *end_addr = heap->base_addr + heap->current_size;
+    gc_size_t size = (gc_size_t)((char *)end - (char *)start);
+    bool pinuse = hmu_get_pinuse(start) ? true : false;
+
+    if (size == 0)
+        return;
+
+    /* clear the bits left by the young wo or the vo */
+    start->header = 0;
+    if (pinuse)
+        hmu_mark_pinuse(start);
+
+    heap->total_free_size += size;
+    gci_add_fc(heap, start, size);
+
+    if ((gc_uint8 *)end < end_addr)
+        hmu_unmark_pinuse(end);
+}
+
+static void
+free_nursery_wo_lists(gc_heap_t *heap)
+{
+#if GC_NURSERY_ESCAPED_LIST != 0
+    bool is_overflowed;
+
+    free_mark_node_list(take_escaped_wo_list(heap, &is_overflowed));
+#endif
+    free_mark_node_list((mark_node_t *)heap->old_wo_list);
+    heap->old_wo_list = NULL;
+    heap->is_old_wo_list_overflowed = false;
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_release_nursery(gc_heap_t *heap)
+{
+    hmu_t *cur;
+
+    if (!heap->nursery_start)
+        return;
+
+    for (cur = heap->nursery_start; cur < heap->nursery_cur;
+         cur = (hmu_t *)((char *)cur + hmu_get_size(cur))) {
+        bh_assert(hmu_get_ut(cur) == HMU_WO && hmu_is_young(cur));
+        hmu_unmark_wo(cur);
+        hmu_unmark_young(cur);
+    }
+
+    add_nursery_free_area(heap, heap->nursery_cur, heap->nursery_end);
+    heap->nursery_start = heap->nursery_cur = heap->nursery_end = NULL;
+    free_nursery_wo_lists(heap);
+}
+
+/**
+ * Mark the young wos reachable from the escaped young wos, the wos of
+ * old_wo_list and the root set
+ *
+ * @param heap the heap to mark, should be a valid instance heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise, and the to-expand
+ *         list is empty in both cases
+ */
+static int
+mark_nursery(gc_heap_t *heap)
+{
+    mark_node_t *mark_node, *escaped_wo_list = NULL;
+    hmu_t *cur;
+    uint32 idx;
+    bool is_enumerated, is_escaped_wo_list_overflowed = true;
+    int ret = GC_ERROR;
+
+    heap->root_set = NULL;
+    heap->survivor_list = NULL;
+
+    if (heap->is_old_wo_list_overflowed)
+        return GC_ERROR;
+
+    /* the escaped young wos have been marked by the write barrier */
+#if GC_NURSERY_ESCAPED_LIST != 0
+    escaped_wo_list =
+        take_escaped_wo_list(heap, &is_escaped_wo_list_overflowed);
+#endif
+    if (!is_escaped_wo_list_overflowed) {
+        for (mark_node = escaped_wo_list; mark_node;
+             mark_node = mark_node->next) {
+            for (idx = 0; idx < mark_node->idx; idx++)
+                push_wo_to_expand(heap, mark_node->set[idx]);
+        }
+    }
+    else {
+        for (cur = heap->nursery_start; cur < heap->nursery_cur;
+             cur = (hmu_t *)((char *)cur + hmu_get_size(cur))) {
+            if (hmu_is_wo_marked(cur))
+                push_wo_to_expand(heap, hmu_to_obj(cur));
+        }
+    }
+    free_mark_node_list(escaped_wo_list);
+
+    for (mark_node = (mark_node_t *)heap->old_wo_list; mark_node;
+         mark_node = mark_node->next) {
+        for (idx = 0; idx < mark_node->idx; idx++) {
+            if (!visit_wo_refs(mark_node->set[idx], mark_ref, heap))
+                goto fail;
+        }
+    }
+
+#if WASM_ENABLE_THREAD_MGR == 0
+    if (!heap->exec_env)
+        goto fail;
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
+#else
+    if (!heap->cluster)
+        goto fail;
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
+#endif
+    if (!is_enumerated) {
+        LOG_ERROR("enumerate rootset failed");
+        goto fail;
+    }
+
+    /* the old wos aren't marked, so the slow mode of marking which walks
+       the whole heap can't be used, leave the work to a major GC */
+    ret = mark_heap(heap);
+    if (ret == GC_SUCCESS && heap->is_fast_marking_failed)
+        ret = GC_ERROR;
+
+fail:
+    free_mark_node_list((mark_node_t *)heap->root_set);
+    heap->root_set = NULL;
+    heap->is_fast_marking_failed = 0;
+    return ret;
+}
+
+/* Invoke the registered finalizers of the young wos not marked */
+static void
+finalize_nursery(gc_heap_t *heap)
+{
+    extra_info_node_t *node;
+    hmu_t *hmu;
+    gc_size_t i = heap->extra_info_node_cnt;
+
+    /* the nodes are sorted by address, and unsetting the finalizer only
+       moves the nodes after it */
+    while (i-- > 0) {
+        node = heap->extra_info_nodes[i];
+        hmu = obj_to_hmu(node->obj);
+        if (hmu < heap->nursery_start)
+            break;
+        if (hmu < heap->nursery_cur && !hmu_is_wo_marked(hmu)) {
+            bh_assert(hmu_is_young(hmu));
+            node->finalizer(node->obj, node->data);
+            gc_unset_finalizer((gc_handle_t)heap, node->obj);
+        }
+    }
+}
+
+static int
+compare_hmu_addr(const void *a, const void *b)
+{
+    const hmu_t *hmu_a = *(const hmu_t *const *)a;
+    const hmu_t *hmu_b = *(const hmu_t *const *)b;
+
+    return hmu_a < hmu_b ? -1 : (hmu_a > hmu_b ? 1 : 0);
+}
+
+/**
+ * Sweep the nursery by walking through it, which is required if the
+ * survivors can't be sorted
+ *
+ * @param heap the heap whose nursery has been marked
+ */
+static void
+sweep_nursery_slowly(gc_heap_t *heap)
+{
+    hmu_t *cur = heap->nursery_start, *last = NULL;
+
+    while (cur < heap->nursery_cur) {
+        bh_assert(hmu_get_ut(cur) == HMU_WO && hmu_is_young(cur));
+
+        if (!hmu_is_wo_marked(cur)) {
+            if (!last)
+                last = cur;
+        }
+        else {
+            if (last) {
+                add_nursery_free_area(heap, last, cur);
+                last = NULL;
             }
+            hmu_unmark_wo(cur);
+            hmu_unmark_young(cur);
         }
-        if (idx < (int)mark_node->idx)
-            break; /* not yet done */
 
-        /* obj's in mark_node are all expanded */
-        free_mark_node(mark_node);
-        mark_node = heap->root_set;
+        cur = (hmu_t *)((char *)cur + hmu_get_size(cur));
     }
 
-    if (mark_node) {
-        LOG_ERROR("mark process is not successfully finished");
+    /* merge the trailing free area with the rest of nursery */
+    add_nursery_free_area(heap, last ? last : heap->nursery_cur,
+                          heap->nursery_end);
+}
 
-        free_mark_node(mark_node);
-        /* roll back is required */
-        rollback_mark(heap);
+/**
+ * Free the young wos not marked, and promote the others by clearing
+ * their Y bits, then release the nursery
+ *
+ * The young wos marked are got from survivor_list and sorted by address,
+ * the free areas are the gaps between them, so the cost depends on the
+ * number of survivors rather than the size of nursery.
+ *
+ * @param heap the heap whose nursery has been marked
+ */
+static void
+sweep_nursery(gc_heap_t *heap)
+{
+    mark_node_t *mark_node;
+    hmu_t **survivors = NULL, *last = heap->nursery_start, *cur;
+    uint64 total_size;
+    uint32 survivor_num = 0, i = 0, idx;
+
+    finalize_nursery(heap);
+
+    for (mark_node = (mark_node_t *)heap->survivor_list; mark_node;
+         mark_node = mark_node->next)
+        survivor_num += mark_node->idx;
+
+    total_size = sizeof(hmu_t *) * (uint64)survivor_num;
+    if (survivor_num > 0
+        && (total_size >= UINT32_MAX
+            || !(survivors = (hmu_t **)BH_MALLOC((uint32)total_size)))) {
+        sweep_nursery_slowly(heap);
+        goto finish;
+    }
 
-        return GC_ERROR;
+    for (mark_node = (mark_node_t *)heap->survivor_list; mark_node;
+         mark_node = mark_node->next) {
+        for (idx = 0; idx < mark_node->idx; idx++)
+            survivors[i++] = obj_to_hmu(mark_node->set[idx]);
+    }
+    if (survivor_num > 1)
+        qsort(survivors, survivor_num, sizeof(hmu_t *), compare_hmu_addr);
+
+    for (i = 0; i < survivor_num; i++) {
+        cur = survivors[i];
+        bh_assert(cur >= last && cur < heap->nursery_cur);
+        bh_assert(hmu_is_wo_marked(cur) && hmu_is_young(cur));
+        add_nursery_free_area(heap, last, cur);
+        hmu_unmark_wo(cur);
+        hmu_unmark_young(cur);
+        last = (hmu_t *)((char *)cur + hmu_get_size(cur));
     }
 
-    /* now sweep */
-    sweep_instance_heap(heap);
+    /* merge the trailing free area with the rest of nursery */
+    add_nursery_free_area(heap, last, heap->nursery_end);
 
-    (void)size;
+    if (survivors)
+        BH_FREE(survivors);
 
-    return GC_SUCCESS;
+finish:
+    heap->nursery_start = heap->nursery_cur = heap->nursery_end = NULL;
+}
+
+/* Check ems_gc_internal.h for description */
+int
+gci_minor_gc_heap(gc_heap_t *heap)
+{
+    int ret = GC_SUCCESS;
+    gc_uint64 start;
+
+    bh_assert(gci_is_heap_valid(heap));
+
+    LOG_VERBOSE("#minor gc of instance heap %p", heap);
+
+    gct_vm_gc_prepare(NULL);
+
+    gct_vm_mutex_lock(&heap->lock);
+
+    /* the nursery may be released by another thread */
+    if (heap->nursery_start) {
+        heap->is_doing_reclaim = 1;
+        heap->is_doing_minor_gc = 1;
+
+        start = os_time_get_boot_us();
+
+        ret = mark_nursery(heap);
+        if (ret == GC_SUCCESS) {
+            sweep_nursery(heap);
+            free_nursery_wo_lists(heap);
+            heap->minor_gc_count++;
+        }
+        else {
+            /* promote all the young wos */
+            gci_release_nursery(heap);
+        }
+        free_mark_node_list((mark_node_t *)heap->survivor_list);
+        heap->survivor_list = NULL;
+
+        gci_add_pause_time(heap->minor_gc_pause_histogram,
+                           os_time_get_boot_us() - start);
+
+        heap->is_doing_minor_gc = 0;
+        heap->is_doing_reclaim = 0;
+    }
+
+    gct_vm_mutex_unlock(&heap->lock);
+
+    gct_vm_gc_finished(NULL);
+
+    LOG_VERBOSE("#minor gc of instance heap %p done", heap);
+
+#if BH_ENABLE_GC_VERIFY != 0
+    gci_verify_heap(heap);
+#endif
+
+    return ret;
 }
+#endif /* end of WASM_ENABLE_GC_NURSERY != 0 */
 
 /**
  * Do GC on given heap
@@ -444,6 +1465,7 @@ gci_gc_heap(void *h)
 {
     int ret = GC_ERROR;
     gc_heap_t *heap = (gc_heap_t *)h;
+    gc_uint64 start, sweep_deadline = 0;
 
     bh_assert(gci_is_heap_valid(heap));
 
@@ -456,7 +1478,25 @@ gci_gc_heap(void *h)
     gct_vm_mutex_lock(&heap->lock);
     heap->is_doing_reclaim = 1;
 
-    ret = reclaim_instance_heap(heap);
+    start = os_time_get_boot_us();
+
+    /* finish the sweep of last GC, which clears the mark bits */
+    if (heap->sweep_cursor)
+        gci_sweep_heap(heap, 0);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the major GC takes all the young wos as old ones */
+    gci_release_nursery(heap);
+#endif
+
+    /* leave the sweep to the later allocations if the budget is
+       used up, unless the finalizers may be called when sweeping */
+    if (heap->pause_budget_us > 0 && heap->extra_info_node_cnt == 0)
+        sweep_deadline = start + heap->pause_budget_us;
+
+    ret = reclaim_instance_heap(heap, sweep_deadline);
+
+    gci_add_pause_time(heap->gc_pause_histogram, os_time_get_boot_us() - start);
 
     heap->is_doing_reclaim = 0;
     gct_vm_mutex_unlock(&heap->lock);
@@ -79,6 +79,43 @@ typedef void (*gc_finalizer_t)(void *obj, void *data);
 #define EXTRA_INFO_NORMAL_NODE_CNT 32
 #endif
 
+/* Bucket count of the pause time histograms, the last bucket counts
+   the pauses longer than 2^(GC_PAUSE_HISTOGRAM_SIZE - 2) microseconds */
+#ifndef GC_PAUSE_HISTOGRAM_SIZE
+#define GC_PAUSE_HISTOGRAM_SIZE 24
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+/* Number of the threads shared by all the heaps to help the thread doing
+   GC to mark */
+#ifndef GC_MARK_HELPER_THREAD_NUM
+#define GC_MARK_HELPER_THREAD_NUM 3
+#endif
+
+/* Heaps smaller than it are marked by the current thread only */
+#ifndef GC_PARALLEL_MARK_MIN_HEAP_SIZE
+#define GC_PARALLEL_MARK_MIN_HEAP_SIZE (8 * 1024 * 1024)
+#endif
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/* The nursery takes at most 1/GC_NURSERY_HEAP_RATIO of the heap, and the
+   heap has no nursery if it would be smaller than GC_NURSERY_SIZE_MIN */
+#ifndef GC_NURSERY_HEAP_RATIO
+#define GC_NURSERY_HEAP_RATIO 4
+#endif
+
+#ifndef GC_NURSERY_SIZE_MIN
+#define GC_NURSERY_SIZE_MIN (8 * 1024)
+#endif
+
+/* The objects larger than 1/GC_NURSERY_OBJ_RATIO of the nursery are
+   allocated out of the nursery */
+#ifndef GC_NURSERY_OBJ_RATIO
+#define GC_NURSERY_OBJ_RATIO 8
+#endif
+#endif
+
 /* extra information attached to specific object */
 typedef struct extra_info_node {
     gc_object_t obj;
@@ -145,6 +182,78 @@ gc_enable_gc_reclaim(gc_handle_t handle, void *exec_env);
 void
 gc_enable_gc_reclaim(gc_handle_t handle, void *cluster);
 #endif
+
+/**
+ * Set the pause time budget of GC for a heap
+ *
+ * @param handle handle of the heap
+ * @param budget_us the max time in microseconds that a GC or a sweep
+ *        slice tries to take, 0 means that the heap is swept at once
+ *        after marking
+ */
+void
+gc_set_pause_budget(gc_handle_t handle, uint32 budget_us);
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+/**
+ * Initialize the pool of the mark helper threads shared by all the heaps,
+ * the threads are created when a heap is marked in parallel for the first
+ * time. It must be called before any heap is reclaimed in parallel, or the
+ * heaps are marked by the threads doing GC only.
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_init_mark_pool(void);
+
+/**
+ * Stop the mark helper threads and destroy the pool, it must be called
+ * when no heap is being reclaimed
+ */
+void
+gc_destroy_mark_pool(void);
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Set the nursery size of a heap, the objects are allocated in the
+ * nursery by bumping a pointer, and the nursery is collected by a minor
+ * GC when it is full. All the code storing object references into the
+ * objects of the heap must call gc_write_barrier.
+ *
+ * @param handle handle of the heap
+ * @param size the nursery size, which is limited by the heap size,
+ *        0 to disable the nursery
+ */
+void
+gc_set_nursery_size(gc_handle_t handle, uint32 size);
+
+/**
+ * The write barrier of the nursery, which must be called after a
+ * reference to an object is stored into another object
+ *
+ * @param obj the object stored into
+ * @param value the object stored, which must be a valid object
+ */
+void
+gc_write_barrier(gc_object_t obj, gc_object_t value);
+#endif
+#endif
+
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+/**
+ * Enable the thread caches for a heap, which serve the small allocations
+ * and frees of VM objects without contending on the heap lock. It should
+ * only be enabled for the heap shared by threads, e.g. the global pool of
+ * the runtime, and not for the heaps which may be migrated or reclaimed
+ * by GC.
+ *
+ * @param handle handle of the heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_enable_thread_cache(gc_handle_t handle);
 #endif
 
 /**
@@ -165,6 +274,22 @@ gc_get_heap_struct_size(void);
 int
 gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size);
 
+/**
+ * Restore the state of a heap saved from another heap, the pool buf of
+ * the heap must have been filled with the content of the other heap's
+ * pool buf, e.g. when creating a module instance from a snapshot
+ *
+ * @param handle handle of the heap to restore, which has been initialized
+ * @param heap_struct_saved the heap struct copied from the other heap
+ * @param pool_buf the pool buffer of the heap
+ * @param pool_buf_size the size of the pool buffer
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_restore(gc_handle_t handle, const char *heap_struct_saved, char *pool_buf,
+           gc_size_t pool_buf_size);
+
 /**
  * Check whether the heap is corrupted
  *
@@ -185,6 +310,17 @@ gc_is_heap_corrupted(gc_handle_t handle);
 void *
 gc_heap_stats(void *heap, uint32 *stats, int size);
 
+/**
+ * Get the size of the largest free block of the heap, an allocation
+ * larger than it fails even if the total free size is enough
+ *
+ * @param handle handle of the heap
+ *
+ * @return the size of the largest free block in bytes
+ */
+gc_size_t
+gc_get_largest_free_size(gc_handle_t handle);
+
 #if BH_ENABLE_GC_VERIFY == 0
 
 gc_object_t
@@ -143,6 +143,31 @@ hmu_verify(void *vheap, hmu_t *hmu);
 #define hmu_unmark_wo(hmu) CLRBIT((hmu)->header, HMU_WO_MB_OFFSET)
 #define hmu_is_wo_marked(hmu) GETBIT((hmu)->header, HMU_WO_MB_OFFSET)
 
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Y bit means the wo is allocated in the nursery and hasn't survived a GC
+ * yet. Between two GCs, the M bit of a young wo means that it has been
+ * stored into an old wo, and it is taken as a root by the minor GC.
+ */
+#define HMU_WO_YB_OFFSET 27
+
+#define hmu_mark_young(hmu) SETBIT((hmu)->header, HMU_WO_YB_OFFSET)
+#define hmu_unmark_young(hmu) CLRBIT((hmu)->header, HMU_WO_YB_OFFSET)
+#define hmu_is_young(hmu) GETBIT((hmu)->header, HMU_WO_YB_OFFSET)
+
+/**
+ * The write barrier also records the escaped young wos in a list of the
+ * heap, so that the minor GC doesn't walk the nursery to find them. The
+ * barrier isn't given the heap and looks it up under a global lock, which
+ * requires a statically initialized mutex.
+ */
+#if defined(OS_THREAD_MUTEX_INITIALIZER)
+#define GC_NURSERY_ESCAPED_LIST 1
+#else
+#define GC_NURSERY_ESCAPED_LIST 0
+#endif
+#endif
+
 /**
  * The hmu size is divisible by 8, its lowest 3 bits are 0, so we only
  * store its higher bits of bit [29..3], and bit [2..0] are not stored.
@@ -154,9 +179,24 @@ hmu_verify(void *vheap, hmu_t *hmu);
 
 #define HMU_VO_FB_OFFSET 28
 
+#define hmu_free_vo(hmu) SETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 #define hmu_is_vo_freed(hmu) GETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 #define hmu_unfree_vo(hmu) CLRBIT((hmu)->header, HMU_VO_FB_OFFSET)
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+/**
+ * Cached bit of a VO, it is set when the VO is freed into a thread cache
+ * and cleared when it is taken out again. The block is still in use from
+ * the view of the heap, so it can't be marked with the freed bit, which
+ * would let the sweep reclaim it.
+ */
+#define HMU_VO_CB_OFFSET 27
+
+#define hmu_cache_vo(hmu) SETBIT((hmu)->header, HMU_VO_CB_OFFSET)
+#define hmu_is_vo_cached(hmu) GETBIT((hmu)->header, HMU_VO_CB_OFFSET)
+#define hmu_uncache_vo(hmu) CLRBIT((hmu)->header, HMU_VO_CB_OFFSET)
+#endif
+
 #define hmu_get_size(hmu) \
     (GETBITS((hmu)->header, HMU_SIZE_OFFSET, HMU_SIZE_SIZE) << 3)
 #define hmu_set_size(hmu, size) \
@@ -249,6 +289,48 @@ bh_static_assert(offsetof(hmu_tree_node_t, left) == 4);
                   == 0);                                                    \
     } while (0)
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+/* Number of the thread caches of a heap, the threads are assigned to
+   them in turn */
+#ifndef GC_THREAD_CACHE_NUM
+#define GC_THREAD_CACHE_NUM 16
+#endif
+
+/* Max number of the blocks cached in a bin, half of them are returned
+   to the heap when it overflows */
+#ifndef GC_THREAD_CACHE_BIN_MAX
+#define GC_THREAD_CACHE_BIN_MAX 16
+#endif
+
+/* Number of the blocks allocated from the heap when a bin is empty */
+#ifndef GC_THREAD_CACHE_REFILL_CNT
+#define GC_THREAD_CACHE_REFILL_CNT 4
+#endif
+
+/* Number of the allocations and frees served by a thread cache before
+   all of its blocks are returned to the heap, so that the cached blocks
+   don't stay away from the heap and fragment it for too long */
+#ifndef GC_THREAD_CACHE_FLUSH_INTERVAL
+#define GC_THREAD_CACHE_FLUSH_INTERVAL 4096
+#endif
+
+/**
+ * Free VO blocks of the normal sizes kept out of the heap, which are
+ * allocated and freed without taking the heap lock. The blocks are still
+ * in use from the heap's point of view, their headers are never changed
+ * when they are cached, since the heap may update the pinuse bit of them
+ * when freeing their previous blocks with the heap lock.
+ */
+typedef struct gc_thread_cache {
+    korp_mutex lock;
+    /* the cached blocks of each size, linked by next_offset */
+    hmu_normal_node_t *bins[HMU_NORMAL_NODE_CNT];
+    gc_uint32 counts[HMU_NORMAL_NODE_CNT];
+    /* allocations and frees served since the last flush */
+    gc_uint32 op_count;
+} gc_thread_cache_t;
+#endif
+
 typedef struct gc_heap_struct {
     /* for double checking*/
     gc_handle_t heap_id;
@@ -285,10 +367,10 @@ typedef struct gc_heap_struct {
 
     /* whether the fast mode of marking process that requires
        additional memory fails.  When the fast mode fails, the
-       marking process can still be done in the slow mode, which
-       doesn't need additional memory (by walking through all
-       blocks and marking successors of marked nodes until no new
-       node is marked).  TODO: slow mode is not implemented.  */
+       marking process is done in the slow mode, which doesn't
+       need additional memory (by walking through all blocks and
+       marking successors of marked nodes until no new node is
+       marked).  */
     unsigned is_fast_marking_failed : 1;
 
     /* whether the heap is doing reclaim */
@@ -296,6 +378,11 @@ typedef struct gc_heap_struct {
 
     /* Whether the heap can do reclaim */
     unsigned is_reclaim_enabled : 1;
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* whether the heap is doing minor GC, which only marks young wos */
+    unsigned is_doing_minor_gc : 1;
+#endif
 #endif
 
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
@@ -324,6 +411,58 @@ typedef struct gc_heap_struct {
     extra_info_node_t **extra_info_nodes;
     gc_size_t extra_info_node_cnt;
     gc_size_t extra_info_node_capacity;
+
+    /* The first block not swept yet when the sweep phase is done in
+       slices, NULL if there is no pending sweep. The free chunks from
+       it to the end of heap aren't in the free lists. */
+    hmu_t *sweep_cursor;
+    /* Max pause time in microseconds of a GC or a sweep slice, 0 means
+       that the heap is swept at once after marking */
+    gc_uint32 pause_budget_us;
+    /* Histograms of the pause time, the ith bucket counts the pauses
+       which take [2^(i-1), 2^i) microseconds */
+    gc_uint32 gc_pause_histogram[GC_PAUSE_HISTOGRAM_SIZE];
+    gc_uint32 sweep_pause_histogram[GC_PAUSE_HISTOGRAM_SIZE];
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* Size of the nursery taken from the heap each time, 0 if the heap
+       has no nursery */
+    gc_size_t nursery_size;
+    /* The young wos are allocated by bumping nursery_cur from
+       nursery_start. The free space [nursery_cur, nursery_end) is a vo
+       block so that the heap can still be walked. They are NULL if no
+       nursery is taken from the heap. */
+    hmu_t *nursery_start;
+    hmu_t *nursery_cur;
+    hmu_t *nursery_end;
+    /* The wos allocated out of the nursery since the last GC when there
+       are young wos, which may be initialized with references to them
+       without write barrier, they are taken as roots by the minor GC */
+    void *old_wo_list;
+    /* Whether an old wo couldn't be added to old_wo_list, the next GC
+       must be a major GC then */
+    bool is_old_wo_list_overflowed;
+#if GC_NURSERY_ESCAPED_LIST != 0
+    /* The next heap with nursery, see gci_link_nursery_heap */
+    struct gc_heap_struct *next_nursery_heap;
+    /* The young wos stored into old wos since the last GC, recorded by
+       the write barrier, they are taken as roots by the minor GC */
+    void *escaped_wo_list;
+    /* Whether a young wo couldn't be added to escaped_wo_list, the minor
+       GC walks the nursery to find the escaped young wos then */
+    bool is_escaped_wo_list_overflowed;
+#endif
+    /* The to-expand nodes kept by the minor GC, which hold the young wos
+       marked, so that the nursery is swept without being walked */
+    void *survivor_list;
+    gc_size_t minor_gc_count;
+    gc_uint32 minor_gc_pause_histogram[GC_PAUSE_HISTOGRAM_SIZE];
+#endif
+#endif
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    /* GC_THREAD_CACHE_NUM caches allocated from the heap itself, NULL if
+       they aren't enabled, see gc_enable_thread_cache */
+    gc_thread_cache_t *thread_caches;
 #endif
 #if GC_STAT_DATA != 0
     gc_uint64 total_size_allocated;
@@ -331,15 +470,40 @@ typedef struct gc_heap_struct {
 #endif
 } gc_heap_t;
 
+/* Whether the hmu is in the part of heap which hasn't been swept yet */
+static inline bool
+gci_is_hmu_unswept(gc_heap_t *heap, hmu_t *hmu)
+{
+#if WASM_ENABLE_GC != 0
+    return heap->sweep_cursor && hmu >= heap->sweep_cursor;
+#else
+    (void)heap;
+    (void)hmu;
+    return false;
+#endif
+}
+
 #if WASM_ENABLE_GC != 0
 
 #define GC_DEFAULT_THRESHOLD_FACTOR 300
 
+static inline void
+gci_add_pause_time(gc_uint32 *histogram, gc_uint64 time_us)
+{
+    uint32 i = 0;
+
+    while (time_us > 0 && i < GC_PAUSE_HISTOGRAM_SIZE - 1) {
+        time_us >>= 1;
+        i++;
+    }
+    histogram[i]++;
+}
+
 static inline void
 gc_update_threshold(gc_heap_t *heap)
 {
-    heap->gc_threshold =
-        heap->total_free_size * heap->gc_threshold_factor / 1000;
+    heap->gc_threshold = (gc_size_t)((gc_uint64)heap->total_free_size
+                                     * heap->gc_threshold_factor / 1000);
 }
 
 #define gct_vm_mutex_init os_mutex_init
@@ -359,6 +523,84 @@ gc_update_threshold(gc_heap_t *heap)
  * MISC internal used APIs
  */
 
+#if WASM_ENABLE_GC != 0
+/**
+ * Sweep the pending part of heap for a slice of time
+ *
+ * @param heap the heap with pending sweep
+ * @param deadline the time to stop sweeping, got from os_time_get_boot_us,
+ *        0 to sweep until the end of heap
+ */
+void
+gci_sweep_heap(gc_heap_t *heap, gc_uint64 deadline);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Do minor GC on given heap: mark the young wos reachable from the root
+ * set, the escaped young wos and the wos of old_wo_list, free the young
+ * wos not marked and promote the others, and release the nursery.
+ * The heap lock must not be held.
+ *
+ * @param heap the heap with a nursery
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if a major GC is required
+ */
+int
+gci_minor_gc_heap(gc_heap_t *heap);
+
+/**
+ * Promote all the young wos and release the nursery without marking,
+ * the heap lock must be held
+ */
+void
+gci_release_nursery(gc_heap_t *heap);
+
+/**
+ * Remember a wo allocated out of the nursery when there are young wos,
+ * the heap lock must be held
+ */
+void
+gci_remember_old_wo(gc_heap_t *heap, gc_object_t obj);
+
+/**
+ * Move the wos remembered for the minor GC after the heap is moved by
+ * offset bytes, the heap lock must be held
+ */
+void
+gci_adjust_nursery_wo_lists(gc_heap_t *heap, intptr_t offset);
+
+#if GC_NURSERY_ESCAPED_LIST != 0
+/**
+ * Link the heap into or unlink it from the list of heaps with nursery,
+ * in which the write barrier looks up the heap of a young wo
+ *
+ * @param heap the heap to link or unlink
+ * @param link true to link the heap, false to unlink it
+ */
+void
+gci_link_nursery_heap(gc_heap_t *heap, bool link);
+#endif
+#endif
+#endif
+
+void
+gc_dump_heap_stats(gc_heap_t *heap);
+
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+/**
+ * Return all the blocks in the thread caches of the heap to the heap,
+ * the heap lock must not be held
+ */
+void
+gci_flush_thread_caches(gc_heap_t *heap);
+
+/**
+ * Flush and free the thread caches of the heap
+ */
+void
+gci_destroy_thread_caches(gc_heap_t *heap);
+#endif
+
 bool
 gci_add_fc(gc_heap_t *heap, hmu_t *hmu, gc_size_t size);
 
@@ -136,6 +136,19 @@ gc_destroy_with_pool(gc_handle_t handle)
 
 #if WASM_ENABLE_GC != 0
     gc_size_t i = 0;
+#endif
+
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    gci_destroy_thread_caches(heap);
+#endif
+
+#if WASM_ENABLE_GC != 0
+#if WASM_ENABLE_GC_NURSERY != 0
+    gci_release_nursery(heap);
+#if GC_NURSERY_ESCAPED_LIST != 0
+    gci_link_nursery_heap(heap, false);
+#endif
+#endif
 
     if (heap->extra_info_node_cnt > 0) {
         for (i = 0; i < heap->extra_info_node_cnt; i++) {
@@ -197,6 +210,41 @@ gc_enable_gc_reclaim(gc_handle_t handle, void *cluster)
     heap->cluster = cluster;
 }
 #endif
+
+void
+gc_set_pause_budget(gc_handle_t handle, uint32 budget_us)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    heap->pause_budget_us = budget_us;
+}
+
+#if WASM_ENABLE_GC_NURSERY != 0
+void
+gc_set_nursery_size(gc_handle_t handle, uint32 size)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+#if GC_MANUALLY != 0
+    /* the young wos are freed by the minor GC only */
+    size = 0;
+#endif
+    if (size > heap->current_size / GC_NURSERY_HEAP_RATIO)
+        size = heap->current_size / GC_NURSERY_HEAP_RATIO;
+    size &= ~(uint32)7;
+    if (size < GC_NURSERY_SIZE_MIN)
+        size = 0;
+
+    os_mutex_lock(&heap->lock);
+    if (size == 0)
+        gci_release_nursery(heap);
+    heap->nursery_size = size;
+#if GC_NURSERY_ESCAPED_LIST != 0
+    gci_link_nursery_heap(heap, size > 0);
+#endif
+    os_mutex_unlock(&heap->lock);
+}
+#endif
 #endif
 
 uint32
@@ -239,6 +287,13 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     if (offset == 0)
         return 0;
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    if (heap->thread_caches) {
+        LOG_ERROR("[GC_ERROR]heap with thread caches can't be migrated\n");
+        return GC_ERROR;
+    }
+#endif
+
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
     if (heap->is_heap_corrupted) {
         LOG_ERROR("[GC_ERROR]Heap is corrupted, heap migrate failed.\n");
@@ -259,6 +314,15 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     adjust_ptr(p_left, offset);
     adjust_ptr(p_right, offset);
     adjust_ptr(p_parent, offset);
+#if WASM_ENABLE_GC != 0
+    adjust_ptr((uint8 **)&heap->sweep_cursor, offset);
+#if WASM_ENABLE_GC_NURSERY != 0
+    adjust_ptr((uint8 **)&heap->nursery_start, offset);
+    adjust_ptr((uint8 **)&heap->nursery_cur, offset);
+    adjust_ptr((uint8 **)&heap->nursery_end, offset);
+    gci_adjust_nursery_wo_lists(heap, offset);
+#endif
+#endif
 
     cur = (hmu_t *)heap->base_addr;
     end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
@@ -308,6 +372,146 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     return 0;
 }
 
+int
+gc_restore(gc_handle_t handle, const char *heap_struct_saved, char *pool_buf,
+           gc_size_t pool_buf_size)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    const gc_heap_t *heap_saved = (const gc_heap_t *)heap_struct_saved;
+    char *base_addr_new = pool_buf + GC_HEAD_PADDING;
+    char *pool_buf_end = pool_buf + pool_buf_size;
+    intptr_t offset = (uint8 *)base_addr_new - (uint8 *)heap_saved->base_addr;
+    hmu_tree_node_t *kfc_tree_root_saved = heap_saved->kfc_tree_root;
+    hmu_t *cur = NULL, *end = NULL;
+    hmu_tree_node_t *tree_node;
+    uint8 **p_left, **p_right, **p_parent;
+    gc_size_t heap_max_size, size;
+    korp_mutex lock;
+    uint32 i;
+
+    if ((((uintptr_t)pool_buf) & 7) != 0) {
+        LOG_ERROR("[GC_ERROR]heap restore pool buf not 8-byte aligned\n");
+        return GC_ERROR;
+    }
+
+    heap_max_size = (uint32)(pool_buf_end - base_addr_new) & (uint32)~7;
+
+    if (pool_buf_end < base_addr_new
+        || heap_max_size < heap_saved->current_size) {
+        LOG_ERROR("[GC_ERROR]heap restore invalid pool buf size\n");
+        return GC_ERROR;
+    }
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap_saved->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, heap restore failed.\n");
+        return GC_ERROR;
+    }
+#endif
+
+    /* Keep the lock and the identity of current heap, take all the
+       other fields from the saved heap */
+    lock = heap->lock;
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_NURSERY != 0 \
+    && GC_NURSERY_ESCAPED_LIST != 0
+    /* The escaped young wos recorded belong to current heap, and the
+       link is overwritten by the saved heap */
+    gci_link_nursery_heap(heap, false);
+#endif
+    bh_memcpy_s(heap, (uint32)sizeof(gc_heap_t), heap_saved,
+                (uint32)sizeof(gc_heap_t));
+    heap->lock = lock;
+    heap->heap_id = (gc_handle_t)heap;
+    heap->base_addr = (uint8 *)base_addr_new;
+    heap->kfc_tree_root = (hmu_tree_node_t *)heap->kfc_tree_root_buf;
+
+    for (i = 0; i < HMU_NORMAL_NODE_CNT; i++) {
+        adjust_ptr((uint8 **)&heap->kfc_normal_list[i].next, offset);
+    }
+
+    ASSERT_TREE_NODE_ALIGNED_ACCESS(heap->kfc_tree_root);
+
+    p_left = (uint8 **)((uint8 *)heap->kfc_tree_root
+                        + offsetof(hmu_tree_node_t, left));
+    p_right = (uint8 **)((uint8 *)heap->kfc_tree_root
+                         + offsetof(hmu_tree_node_t, right));
+    adjust_ptr(p_left, offset);
+    adjust_ptr(p_right, offset);
+#if WASM_ENABLE_GC != 0
+    adjust_ptr((uint8 **)&heap->sweep_cursor, offset);
+#if WASM_ENABLE_GC_NURSERY != 0
+    adjust_ptr((uint8 **)&heap->nursery_start, offset);
+    adjust_ptr((uint8 **)&heap->nursery_cur, offset);
+    adjust_ptr((uint8 **)&heap->nursery_end, offset);
+    /* The list of old wos belongs to the saved heap, the next minor
+       GC promotes all the young wos instead */
+    if (heap->old_wo_list) {
+        heap->old_wo_list = NULL;
+        heap->is_old_wo_list_overflowed = true;
+    }
+    heap->survivor_list = NULL;
+#if GC_NURSERY_ESCAPED_LIST != 0
+    heap->next_nursery_heap = NULL;
+    heap->escaped_wo_list = NULL;
+    if (heap->nursery_size > 0) {
+        gci_link_nursery_heap(heap, true);
+        /* The escaped young wos of the saved heap weren't recorded */
+        heap->is_escaped_wo_list_overflowed = true;
+    }
+#endif
+#endif
+#endif
+
+    cur = (hmu_t *)heap->base_addr;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    while (cur < end) {
+        size = hmu_get_size(cur);
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+        if (size <= 0 || size > (uint32)((uint8 *)end - (uint8 *)cur)) {
+            LOG_ERROR("[GC_ERROR]Heap is corrupted, heap restore failed.\n");
+            heap->is_heap_corrupted = true;
+            return GC_ERROR;
+        }
+#endif
+
+        if (hmu_get_ut(cur) == HMU_FC && !HMU_IS_FC_NORMAL(size)) {
+            tree_node = (hmu_tree_node_t *)cur;
+
+            ASSERT_TREE_NODE_ALIGNED_ACCESS(tree_node);
+
+            p_left = (uint8 **)((uint8 *)tree_node
+                                + offsetof(hmu_tree_node_t, left));
+            p_right = (uint8 **)((uint8 *)tree_node
+                                 + offsetof(hmu_tree_node_t, right));
+            p_parent = (uint8 **)((uint8 *)tree_node
+                                  + offsetof(hmu_tree_node_t, parent));
+            adjust_ptr(p_left, offset);
+            adjust_ptr(p_right, offset);
+            if (tree_node->parent == kfc_tree_root_saved)
+                /* The root node lives in the heap structure, which
+                   isn't moved together with the pool buf */
+                tree_node->parent = heap->kfc_tree_root;
+            else
+                adjust_ptr(p_parent, offset);
+        }
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (cur != end) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, heap restore failed.\n");
+        heap->is_heap_corrupted = true;
+        return GC_ERROR;
+    }
+#else
+    bh_assert(cur == end);
+#endif
+
+    return 0;
+}
+
 bool
 gc_is_heap_corrupted(gc_handle_t handle)
 {
@@ -434,6 +638,12 @@ gc_heap_stats(void *heap_arg, uint32 *stats, int size)
         return NULL;
     }
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    /* Count the cached blocks as free */
+    if (heap->thread_caches)
+        gci_flush_thread_caches(heap);
+#endif
+
     for (i = 0; i < size; i++) {
         switch (i) {
             case GC_STAT_TOTAL:
@@ -461,6 +671,40 @@ gc_heap_stats(void *heap_arg, uint32 *stats, int size)
     return heap;
 }
 
+gc_size_t
+gc_get_largest_free_size(gc_handle_t handle)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    hmu_tree_node_t *node;
+    gc_size_t size = 0;
+    int i;
+
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+    if (heap->thread_caches)
+        gci_flush_thread_caches(heap);
+#endif
+
+    os_mutex_lock(&heap->lock);
+    /* The largest block in the tree is the rightmost one, and the tree
+       only holds the blocks larger than those in the normal lists */
+    if ((node = heap->kfc_tree_root->right)) {
+        while (node->right)
+            node = node->right;
+        size = node->size;
+    }
+    else {
+        for (i = HMU_NORMAL_NODE_CNT - 1; i > 0; i--) {
+            if (heap->kfc_normal_list[i].next) {
+                size = (gc_size_t)i << 3;
+                break;
+            }
+        }
+    }
+    os_mutex_unlock(&heap->lock);
+
+    return size;
+}
+
 void
 gc_traverse_tree(hmu_tree_node_t *node, gc_size_t *stats, int *n)
 {
@@ -515,9 +759,10 @@ gc_dump_perf_profiling(gc_handle_t *handle)
     gc_heap_t *gc_heap_handle = (void *)handle;
     if (gc_heap_handle) {
         os_printf("\nGC performance summary\n");
-        os_printf("    Total GC time (ms): %u\n",
+        os_printf("    Total GC time (us): %u\n",
                   gc_heap_handle->total_gc_time);
-        os_printf("    Max GC time (ms): %u\n", gc_heap_handle->max_gc_time);
+        os_printf("    Max GC time (us): %u\n", gc_heap_handle->max_gc_time);
+        gc_dump_heap_stats(gc_heap_handle);
     }
     else {
         os_printf("Failed to dump GC performance\n");
@@ -87,6 +87,40 @@ mem_allocator_enable_gc_reclaim(mem_allocator_t allocator, void *cluster)
 }
 #endif
 
+void
+mem_allocator_set_gc_pause_budget(mem_allocator_t allocator, uint32 budget_us)
+{
+    gc_set_pause_budget((gc_handle_t)allocator, budget_us);
+}
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+bool
+mem_allocator_init_gc_mark_pool(void)
+{
+    return gc_init_mark_pool() == GC_SUCCESS;
+}
+
+void
+mem_allocator_destroy_gc_mark_pool(void)
+{
+    gc_destroy_mark_pool();
+}
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+void
+mem_allocator_set_gc_nursery_size(mem_allocator_t allocator, uint32 size)
+{
+    gc_set_nursery_size((gc_handle_t)allocator, size);
+}
+
+void
+mem_allocator_write_barrier(void *obj, void *value)
+{
+    gc_write_barrier((gc_object_t)obj, (gc_object_t)value);
+}
+#endif
+
 int
 mem_allocator_add_root(mem_allocator_t allocator, WASMObjectRef obj)
 {
@@ -101,12 +135,28 @@ mem_allocator_migrate(mem_allocator_t allocator, char *pool_buf_new,
     return gc_migrate((gc_handle_t)allocator, pool_buf_new, pool_buf_size);
 }
 
+int
+mem_allocator_restore(mem_allocator_t allocator, const void *struct_buf_saved,
+                      char *pool_buf, uint32 pool_buf_size)
+{
+    return gc_restore((gc_handle_t)allocator, (const char *)struct_buf_saved,
+                      pool_buf, pool_buf_size);
+}
+
 bool
 mem_allocator_is_heap_corrupted(mem_allocator_t allocator)
 {
     return gc_is_heap_corrupted((gc_handle_t)allocator);
 }
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+bool
+mem_allocator_enable_thread_cache(mem_allocator_t allocator)
+{
+    return gc_enable_thread_cache((gc_handle_t)allocator) == GC_SUCCESS;
+}
+#endif
+
 bool
 mem_allocator_get_alloc_info(mem_allocator_t allocator, void *mem_alloc_info)
 {
@@ -114,6 +164,12 @@ mem_allocator_get_alloc_info(mem_allocator_t allocator, void *mem_alloc_info)
     return true;
 }
 
+uint32_t
+mem_allocator_get_largest_free_size(mem_allocator_t allocator)
+{
+    return gc_get_largest_free_size((gc_handle_t)allocator);
+}
+
 #if WASM_ENABLE_GC != 0
 bool
 mem_allocator_set_gc_finalizer(mem_allocator_t allocator, void *obj,
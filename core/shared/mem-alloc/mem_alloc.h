@@ -50,9 +50,18 @@ int
 mem_allocator_migrate(mem_allocator_t allocator, char *pool_buf_new,
                       uint32 pool_buf_size);
 
+int
+mem_allocator_restore(mem_allocator_t allocator, const void *struct_buf_saved,
+                      char *pool_buf, uint32 pool_buf_size);
+
 bool
 mem_allocator_is_heap_corrupted(mem_allocator_t allocator);
 
+#if WASM_ENABLE_ALLOC_THREAD_CACHE != 0
+bool
+mem_allocator_enable_thread_cache(mem_allocator_t allocator);
+#endif
+
 #if WASM_ENABLE_GC != 0
 void *
 mem_allocator_malloc_with_gc(mem_allocator_t allocator, uint32_t size);
@@ -70,6 +79,25 @@ void
 mem_allocator_enable_gc_reclaim(mem_allocator_t allocator, void *cluster);
 #endif
 
+void
+mem_allocator_set_gc_pause_budget(mem_allocator_t allocator, uint32 budget_us);
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+bool
+mem_allocator_init_gc_mark_pool(void);
+
+void
+mem_allocator_destroy_gc_mark_pool(void);
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+void
+mem_allocator_set_gc_nursery_size(mem_allocator_t allocator, uint32 size);
+
+void
+mem_allocator_write_barrier(void *obj, void *value);
+#endif
+
 int
 mem_allocator_add_root(mem_allocator_t allocator, WASMObjectRef obj);
 
@@ -89,6 +117,9 @@ mem_allocator_dump_perf_profiling(mem_allocator_t allocator);
 bool
 mem_allocator_get_alloc_info(mem_allocator_t allocator, void *mem_alloc_info);
 
+uint32_t
+mem_allocator_get_largest_free_size(mem_allocator_t allocator);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "platform_api_vmcore.h"
+#include "platform_api_extension.h"
+
+#ifdef OS_ENABLE_FIBER
+
+#include <ucontext.h>
+
+struct os_fiber {
+    ucontext_t context;
+    /* the context which resumed the fiber and is switched back to
+       when the fiber yields or its entry function returns */
+    ucontext_t caller_context;
+    void (*entry)(void *);
+    void *arg;
+    /* the stack, with a guard page at the lowest address */
+    uint8 *stack;
+    size_t stack_size;
+    bool running;
+    bool finished;
+};
+
+/* makecontext only passes int arguments to the entry function, so the
+   pointer of the fiber is split into two halves */
+static void
+fiber_entry(uint32 fiber_hi, uint32 fiber_lo)
+{
+    os_fiber *fiber =
+        (os_fiber *)(uintptr_t)(((uint64)fiber_hi << 32) | (uint64)fiber_lo);
+
+    fiber->entry(fiber->arg);
+    fiber->finished = true;
+    fiber->running = false;
+    /* returns to caller_context through uc_link */
+}
+
+os_fiber *
+os_fiber_create(void (*entry)(void *), void *arg, uint32 stack_size)
+{
+    size_t page_size = (size_t)os_getpagesize();
+    uint64 fiber_addr;
+    os_fiber *fiber;
+
+    if (!(fiber = BH_MALLOC(sizeof(os_fiber))))
+        return NULL;
+
+    memset(fiber, 0, sizeof(os_fiber));
+    fiber->entry = entry;
+    fiber->arg = arg;
+    fiber->stack_size =
+        ((size_t)stack_size + page_size - 1) / page_size * page_size
+        + page_size;
+
+    if (!(fiber->stack = os_mmap(NULL, fiber->stack_size,
+                                 MMAP_PROT_READ | MMAP_PROT_WRITE,
+                                 MMAP_MAP_NONE, os_get_invalid_handle()))) {
+        BH_FREE(fiber);
+        return NULL;
+    }
+
+    /* Overflowing the stack faults instead of corrupting other memory */
+    if (os_mprotect(fiber->stack, page_size, MMAP_PROT_NONE) != 0
+        || getcontext(&fiber->context) != 0) {
+        os_munmap(fiber->stack, fiber->stack_size);
+        BH_FREE(fiber);
+        return NULL;
+    }
+
+    fiber->context.uc_stack.ss_sp = fiber->stack;
+    fiber->context.uc_stack.ss_size = fiber->stack_size;
+    fiber->context.uc_link = &fiber->caller_context;
+    fiber_addr = (uint64)(uintptr_t)fiber;
+    makecontext(&fiber->context, (void (*)(void))fiber_entry, 2,
+                (uint32)(fiber_addr >> 32), (uint32)fiber_addr);
+    return fiber;
+}
+
+void
+os_fiber_destroy(os_fiber *fiber)
+{
+    assert(!fiber->running);
+    os_munmap(fiber->stack, fiber->stack_size);
+    BH_FREE(fiber);
+}
+
+int
+os_fiber_resume(os_fiber *fiber)
+{
+    if (fiber->running || fiber->finished)
+        return BHT_ERROR;
+
+    fiber->running = true;
+    if (swapcontext(&fiber->caller_context, &fiber->context) != 0) {
+        fiber->running = false;
+        return BHT_ERROR;
+    }
+    return BHT_OK;
+}
+
+int
+os_fiber_yield(os_fiber *fiber)
+{
+    if (!fiber->running)
+        return BHT_ERROR;
+
+    fiber->running = false;
+    if (swapcontext(&fiber->context, &fiber->caller_context) != 0) {
+        fiber->running = true;
+        return BHT_ERROR;
+    }
+    return BHT_OK;
+}
+
+uint8 *
+os_fiber_get_stack_boundary(os_fiber *fiber)
+{
+    return fiber->stack + os_getpagesize();
+}
+
+bool
+os_fiber_is_finished(os_fiber *fiber)
+{
+    return fiber->finished;
+}
+
+#endif /* end of OS_ENABLE_FIBER */
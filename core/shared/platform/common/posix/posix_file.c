@@ -7,6 +7,12 @@
 #include "libc_errno.h"
 #include <unistd.h>
 
+#ifdef OS_ENABLE_FD_TRANSFER
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
 #if !defined(__APPLE__) && !defined(ESP_PLATFORM)
 #define CONFIG_HAS_PWRITEV 1
 #define CONFIG_HAS_PREADV 1
@@ -599,6 +605,147 @@ os_writev(os_file_handle handle, const struct __wasi_ciovec_t *iov, int iovcnt,
     return __WASI_ESUCCESS;
 }
 
+#ifdef OS_ENABLE_FD_TRANSFER
+/* Size of the host buffer used to move data between handles that the
+   kernel can't transfer directly, e.g. between two sockets */
+#define FD_TRANSFER_BUF_SIZE (64 * 1024)
+
+/* Whether the kernel refused a transfer method for the given handles,
+   so that the next method should be tried */
+static bool
+fd_transfer_unsupported(int error)
+{
+    return error == EINVAL || error == ENOSYS || error == EOPNOTSUPP
+           || error == EXDEV || error == EBADF;
+}
+
+/* Move the data through a host buffer. The output may take only a part
+   of the data read, e.g. a nonblocking handle becoming full, a write
+   interrupted by a signal or a full disk, so the input is only consumed
+   as far as the output has taken: the data is read at the offset given,
+   peeked from a stream socket, or given back by seeking the input. The
+   other inputs can't give the data back and are rejected with ENOTSUP,
+   the caller should move the data with read and write then. */
+static ssize_t
+fd_transfer_copy(int fd_in, const struct stat *st_in, off_t *offset,
+                 int fd_out, size_t len)
+{
+    char *buf;
+    ssize_t nread, nwritten, total = 0;
+    off_t pos = -1;
+    bool is_stream_socket = false;
+    int sock_type, error;
+    socklen_t optlen = sizeof(sock_type);
+
+    if (!offset) {
+        if (S_ISSOCK(st_in->st_mode))
+            is_stream_socket =
+                getsockopt(fd_in, SOL_SOCKET, SO_TYPE, &sock_type, &optlen)
+                    == 0
+                && sock_type == SOCK_STREAM;
+        if (!is_stream_socket && (pos = lseek(fd_in, 0, SEEK_CUR)) < 0) {
+            errno = ENOTSUP;
+            return -1;
+        }
+    }
+
+    if (len > FD_TRANSFER_BUF_SIZE)
+        len = FD_TRANSFER_BUF_SIZE;
+
+    if (!(buf = BH_MALLOC((unsigned int)len))) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (offset)
+        nread = pread(fd_in, buf, len, *offset);
+    else if (is_stream_socket)
+        nread = recv(fd_in, buf, len, MSG_PEEK);
+    else
+        nread = read(fd_in, buf, len);
+
+    if (nread < 0) {
+        BH_FREE(buf);
+        return -1;
+    }
+
+    while (total < nread) {
+        nwritten = write(fd_out, buf + total, (size_t)(nread - total));
+        if (nwritten < 0)
+            break;
+        total += nwritten;
+    }
+
+    /* Consume the input as far as the output has taken */
+    error = errno;
+    if (offset) {
+        *offset += total;
+    }
+    else if (is_stream_socket) {
+        /* The data peeked is still queued, unless another thread reads
+           the same socket concurrently */
+        if (total > 0 && recv(fd_in, buf, (size_t)total, 0) != total) {
+            error = EIO;
+            total = -1;
+        }
+    }
+    else if (total < nread && lseek(fd_in, pos + total, SEEK_SET) < 0) {
+        error = EIO;
+        total = -1;
+    }
+
+    BH_FREE(buf);
+
+    if (total == 0 && nread > 0) {
+        /* Nothing was written, report the error of the output */
+        errno = error;
+        return -1;
+    }
+    errno = error;
+    return total;
+}
+
+__wasi_errno_t
+os_fd_transfer(os_file_handle handle_in, int64 offset,
+               os_file_handle handle_out, size_t len, size_t *ntransferred)
+{
+    struct stat st_in, st_out;
+    off_t off = (off_t)offset, *p_off = offset >= 0 ? &off : NULL;
+    ssize_t ret = -1;
+
+    if (fstat(handle_in, &st_in) != 0 || fstat(handle_out, &st_out) != 0)
+        return convert_errno(errno);
+
+    if (len == 0) {
+        *ntransferred = 0;
+        return __WASI_ESUCCESS;
+    }
+
+    /* Try the kernel paths from the most to the least specific one, each
+       failing with EINVAL or alike for the handles it doesn't support */
+    errno = EINVAL;
+#ifdef SYS_copy_file_range
+    if (S_ISREG(st_in.st_mode) && S_ISREG(st_out.st_mode))
+        ret = syscall(SYS_copy_file_range, handle_in, p_off, handle_out, NULL,
+                      len, 0);
+#endif
+    if (ret < 0 && fd_transfer_unsupported(errno)
+        && (S_ISREG(st_in.st_mode) || S_ISBLK(st_in.st_mode)))
+        ret = sendfile(handle_out, handle_in, p_off, len);
+    if (ret < 0 && fd_transfer_unsupported(errno)
+        && (S_ISFIFO(st_in.st_mode) || S_ISFIFO(st_out.st_mode)))
+        ret = splice(handle_in, p_off, handle_out, NULL, len, SPLICE_F_MOVE);
+    if (ret < 0 && fd_transfer_unsupported(errno))
+        ret = fd_transfer_copy(handle_in, &st_in, p_off, handle_out, len);
+
+    if (ret < 0)
+        return convert_errno(errno);
+
+    *ntransferred = (size_t)ret;
+    return __WASI_ESUCCESS;
+}
+#endif /* end of OS_ENABLE_FD_TRANSFER */
+
 __wasi_errno_t
 os_fallocate(os_file_handle handle, __wasi_filesize_t offset,
              __wasi_filesize_t length)
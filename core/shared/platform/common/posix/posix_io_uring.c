@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2026 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "platform_api_vmcore.h"
+#include "platform_api_extension.h"
+
+#ifdef OS_ENABLE_IO_URING
+
+#include "libc_errno.h"
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+/* The number of submission queue entries of a ring, os_io_ring_poll falls
+   back to poll() if there are more fds */
+#define IO_RING_ENTRIES 64
+
+/* The user data of the cancel requests, the user data of the other
+   requests is the index of their results */
+#define IO_RING_CANCEL_DATA ((uint64)-1)
+
+/* The result of a request which hasn't completed */
+#define IO_RING_PENDING INT32_MIN
+
+struct os_io_ring {
+    int fd;
+    uint32 sq_entries;
+    /* The tail of the entries queued but not yet published */
+    uint32 sq_local_tail;
+    uint32 *sq_head;
+    uint32 *sq_tail;
+    uint32 *sq_mask;
+    uint32 *sq_array;
+    struct io_uring_sqe *sqes;
+    uint32 *cq_head;
+    uint32 *cq_tail;
+    uint32 *cq_mask;
+    struct io_uring_cqe *cqes;
+    /* The mapping of both the submission and completion rings */
+    uint8 *rings;
+    size_t rings_size;
+    size_t sqes_size;
+};
+
+/* Set when the kernel doesn't support io_uring, or doesn't allow it,
+   so that io_uring_setup isn't tried again for each exec env */
+static bool io_ring_unsupported = false;
+
+os_io_ring *
+os_io_ring_create(void)
+{
+    struct io_uring_params params = { 0 };
+    os_io_ring *ring;
+    size_t cq_size;
+    int fd;
+
+    if (io_ring_unsupported)
+        return NULL;
+
+    fd = (int)syscall(__NR_io_uring_setup, IO_RING_ENTRIES, &params);
+    if (fd < 0) {
+        if (errno == ENOSYS || errno == EPERM || errno == EINVAL)
+            io_ring_unsupported = true;
+        return NULL;
+    }
+
+    /* Waiting with a timeout requires IORING_FEAT_EXT_ARG (Linux 5.11),
+       which also guarantees all the opcodes used below */
+    if (!(params.features & IORING_FEAT_EXT_ARG)
+        || !(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        io_ring_unsupported = true;
+        close(fd);
+        return NULL;
+    }
+
+    if (!(ring = BH_MALLOC(sizeof(os_io_ring)))) {
+        close(fd);
+        return NULL;
+    }
+    memset(ring, 0, sizeof(os_io_ring));
+    ring->fd = fd;
+    ring->sq_entries = params.sq_entries;
+
+    ring->rings_size = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    cq_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (cq_size > ring->rings_size)
+        ring->rings_size = cq_size;
+    ring->rings = mmap(NULL, ring->rings_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->rings == MAP_FAILED) {
+        ring->rings = NULL;
+        goto fail;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        goto fail;
+    }
+
+    ring->sq_head = (uint32 *)(ring->rings + params.sq_off.head);
+    ring->sq_tail = (uint32 *)(ring->rings + params.sq_off.tail);
+    ring->sq_mask = (uint32 *)(ring->rings + params.sq_off.ring_mask);
+    ring->sq_array = (uint32 *)(ring->rings + params.sq_off.array);
+    ring->sq_local_tail = *ring->sq_tail;
+    ring->cq_head = (uint32 *)(ring->rings + params.cq_off.head);
+    ring->cq_tail = (uint32 *)(ring->rings + params.cq_off.tail);
+    ring->cq_mask = (uint32 *)(ring->rings + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(ring->rings + params.cq_off.cqes);
+    return ring;
+
+fail:
+    os_io_ring_destroy(ring);
+    return NULL;
+}
+
+void
+os_io_ring_destroy(os_io_ring *ring)
+{
+    if (ring->sqes)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->rings)
+        munmap(ring->rings, ring->rings_size);
+    close(ring->fd);
+    BH_FREE(ring);
+}
+
+static struct io_uring_sqe *
+io_ring_get_sqe(os_io_ring *ring)
+{
+    uint32 head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    uint32 index = ring->sq_local_tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe;
+
+    /* The ring is only used by one operation at a time, which never
+       queues more entries than the ring holds */
+    assert(ring->sq_local_tail - head < ring->sq_entries);
+    (void)head;
+
+    sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    ring->sq_array[index] = index;
+    ring->sq_local_tail++;
+    return sqe;
+}
+
+static int
+io_ring_enter(os_io_ring *ring, uint32 to_submit, uint32 min_complete,
+              struct __kernel_timespec *timeout)
+{
+    struct io_uring_getevents_arg arg = { 0 };
+    uint32 flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    if (!timeout)
+        return (int)syscall(__NR_io_uring_enter, ring->fd, to_submit,
+                            min_complete, flags, NULL, 0);
+
+    arg.ts = (uint64)(uintptr_t)timeout;
+    flags |= IORING_ENTER_EXT_ARG;
+    return (int)syscall(__NR_io_uring_enter, ring->fd, to_submit,
+                        min_complete, flags, &arg, sizeof(arg));
+}
+
+/**
+ * Publish and submit the queued entries, and wait for min_complete
+ * completions. Return false with errno set if the entries couldn't be
+ * submitted, they are dropped then.
+ */
+static bool
+io_ring_submit(os_io_ring *ring, uint32 min_complete,
+               struct __kernel_timespec *timeout)
+{
+    uint32 head;
+    int ret;
+
+    __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+    head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    ret = io_ring_enter(ring, ring->sq_local_tail - head, min_complete,
+                        timeout);
+
+    head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (ret < 0 && head != ring->sq_local_tail) {
+        /* Nothing was consumed, drop the entries so that they aren't
+           submitted by the next operation */
+        int saved_errno = errno;
+        ring->sq_local_tail = head;
+        __atomic_store_n(ring->sq_tail, head, __ATOMIC_RELEASE);
+        errno = saved_errno;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reap the available completions, store the results of the requests to
+ * results[user_data] and count the completions of the cancel requests
+ */
+static void
+io_ring_reap(os_io_ring *ring, int32 *results, uint32 *ncanceled)
+{
+    uint32 head = *ring->cq_head;
+    uint32 tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    struct io_uring_cqe *cqe;
+
+    while (head != tail) {
+        cqe = &ring->cqes[head & *ring->cq_mask];
+        if (cqe->user_data == IO_RING_CANCEL_DATA)
+            (*ncanceled)++;
+        else
+            results[cqe->user_data] = cqe->res;
+        head++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * Cancel the pending requests and wait until all of them complete, as a
+ * request must not outlive the buffers it refers to
+ */
+static void
+io_ring_cancel(os_io_ring *ring, int32 *results, uint32 count)
+{
+    struct io_uring_sqe *sqe;
+    uint32 i, ncancel = 0, ncanceled = 0;
+    bool pending;
+
+    for (i = 0; i < count; i++) {
+        if (results[i] == IO_RING_PENDING) {
+            sqe = io_ring_get_sqe(ring);
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = i;
+            sqe->user_data = IO_RING_CANCEL_DATA;
+            ncancel++;
+        }
+    }
+
+    if (ncancel == 0)
+        return;
+    if (!io_ring_submit(ring, 0, NULL))
+        ncancel = 0;
+
+    while (true) {
+        io_ring_reap(ring, results, &ncanceled);
+
+        pending = ncanceled < ncancel;
+        for (i = 0; i < count && !pending; i++) {
+            if (results[i] == IO_RING_PENDING)
+                pending = true;
+        }
+        if (!pending)
+            break;
+
+        /* Keep waiting even if interrupted by a signal */
+        io_ring_enter(ring, 0, 1, NULL);
+    }
+}
+
+/**
+ * Submit the queued request and wait for its completion, return its
+ * result, or -EINTR if the waiting is interrupted by a signal
+ */
+static int32
+io_ring_run(os_io_ring *ring)
+{
+    int32 result = IO_RING_PENDING;
+    uint32 ncanceled = 0;
+
+    if (!io_ring_submit(ring, 1, NULL))
+        return -errno;
+
+    while (true) {
+        io_ring_reap(ring, &result, &ncanceled);
+        if (result != IO_RING_PENDING)
+            return result;
+
+        /* An interrupted io_uring_enter still returns the number of the
+           entries submitted, so wait again to see whether the thread is
+           being woken up, see wasm_runtime_interrupt_blocking_op */
+        if (io_ring_enter(ring, 0, 1, NULL) < 0 && errno == EINTR) {
+            io_ring_cancel(ring, &result, 1);
+            return result == -ECANCELED ? -EINTR : result;
+        }
+    }
+}
+
+__wasi_errno_t
+os_io_ring_readv(os_io_ring *ring, os_file_handle handle,
+                 const struct __wasi_iovec_t *iov, int iovcnt, int64 offset,
+                 size_t *nread)
+{
+    struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+    int32 ret;
+
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = handle;
+    sqe->addr = (uint64)(uintptr_t)iov;
+    sqe->len = (uint32)iovcnt;
+    sqe->off = (uint64)offset;
+
+    ret = io_ring_run(ring);
+    if (ret < 0)
+        return convert_errno(-ret);
+
+    *nread = (size_t)ret;
+    return __WASI_ESUCCESS;
+}
+
+__wasi_errno_t
+os_io_ring_writev(os_io_ring *ring, os_file_handle handle,
+                  const struct __wasi_ciovec_t *iov, int iovcnt, int64 offset,
+                  size_t *nwritten)
+{
+    struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+    int32 ret;
+
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = handle;
+    sqe->addr = (uint64)(uintptr_t)iov;
+    sqe->len = (uint32)iovcnt;
+    sqe->off = (uint64)offset;
+
+    ret = io_ring_run(ring);
+    if (ret < 0)
+        return convert_errno(-ret);
+
+    *nwritten = (size_t)ret;
+    return __WASI_ESUCCESS;
+}
+
+static int
+io_ring_run_msg(os_io_ring *ring, uint8 opcode, int socket,
+                struct msghdr *msg, int flags)
+{
+    struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+    int32 ret;
+
+    sqe->opcode = opcode;
+    sqe->fd = socket;
+    sqe->addr = (uint64)(uintptr_t)msg;
+    sqe->len = 1;
+    sqe->msg_flags = (uint32)flags;
+
+    ret = io_ring_run(ring);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return ret;
+}
+
+int
+os_io_ring_sendmsg(os_io_ring *ring, int socket, struct msghdr *msg,
+                   int flags)
+{
+    return io_ring_run_msg(ring, IORING_OP_SENDMSG, socket, msg, flags);
+}
+
+int
+os_io_ring_recvmsg(os_io_ring *ring, int socket, struct msghdr *msg,
+                   int flags)
+{
+    return io_ring_run_msg(ring, IORING_OP_RECVMSG, socket, msg, flags);
+}
+
+int
+os_io_ring_poll(os_io_ring *ring, struct pollfd *pfds, nfds_t nfds,
+                int timeout_ms)
+{
+    int32 results[IO_RING_ENTRIES];
+    struct io_uring_sqe *sqe;
+    struct __kernel_timespec ts, *timeout = NULL;
+    uint32 i, events, npoll = 0, ncanceled = 0;
+    bool interrupted = false;
+    int nready = 0;
+
+    if (nfds > ring->sq_entries || nfds > IO_RING_ENTRIES)
+        return poll(pfds, nfds, timeout_ms);
+
+    for (i = 0; i < nfds; i++) {
+        pfds[i].revents = 0;
+        if (pfds[i].fd < 0) {
+            results[i] = 0;
+            continue;
+        }
+
+        results[i] = IO_RING_PENDING;
+        sqe = io_ring_get_sqe(ring);
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = pfds[i].fd;
+        events = (uint16)pfds[i].events;
+#if __BYTE_ORDER == __BIG_ENDIAN
+        /* The poll mask is word-reversed on big endian */
+        events = (events << 16) | (events >> 16);
+#endif
+        sqe->poll32_events = events;
+        sqe->user_data = i;
+        npoll++;
+    }
+
+    if (npoll == 0)
+        return poll(pfds, nfds, timeout_ms);
+
+    /* The polls of the fds which are ready complete during the submission,
+       so don't wait at all with a zero timeout */
+    if (!io_ring_submit(ring, 0, NULL))
+        return -1;
+
+    if (timeout_ms != 0) {
+        if (timeout_ms > 0) {
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (long long)(timeout_ms % 1000) * 1000000;
+            timeout = &ts;
+        }
+        io_ring_reap(ring, results, &ncanceled);
+        for (i = 0; i < nfds; i++) {
+            if (results[i] != IO_RING_PENDING && pfds[i].fd >= 0)
+                break;
+        }
+        /* Wait only if no poll has completed yet, ETIME means the timeout
+           expired */
+        if (i == nfds && io_ring_enter(ring, 0, 1, timeout) < 0
+            && errno == EINTR)
+            interrupted = true;
+    }
+
+    io_ring_reap(ring, results, &ncanceled);
+    io_ring_cancel(ring, results, (uint32)nfds);
+
+    for (i = 0; i < nfds; i++) {
+        if (pfds[i].fd < 0 || results[i] == 0 || results[i] == -ECANCELED)
+            continue;
+        if (results[i] > 0)
+            pfds[i].revents = (short)results[i];
+        else
+            pfds[i].revents = results[i] == -EBADF ? POLLNVAL : POLLERR;
+        nready++;
+    }
+
+    if (nready == 0 && interrupted) {
+        errno = EINTR;
+        return -1;
+    }
+    return nready;
+}
+
+#endif /* end of OS_ENABLE_IO_URING */
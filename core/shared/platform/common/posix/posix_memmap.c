@@ -10,6 +10,13 @@
 #include <TargetConditionals.h>
 #endif
 
+#ifdef OS_ENABLE_MEMFD
+#include <sys/syscall.h>
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
 #ifndef BH_ENABLE_TRACE_MMAP
 #define BH_ENABLE_TRACE_MMAP 0
 #endif
@@ -264,6 +271,125 @@ os_mremap(void *old_addr, size_t old_size, size_t new_size)
 }
 #endif
 
+#ifdef OS_ENABLE_MEMFD
+int
+os_memfd_create(const void *data, size_t size, os_file_handle *p_handle)
+{
+#ifdef SYS_memfd_create
+    const uint8 *p = (const uint8 *)data;
+    size_t written = 0;
+    ssize_t ret;
+    int fd;
+
+    fd = (int)syscall(SYS_memfd_create, "wamr_memfd", MFD_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    if (ftruncate(fd, (off_t)size) != 0)
+        goto fail;
+
+    while (p && written < size) {
+        ret = pwrite(fd, p + written, size - written, (off_t)written);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            goto fail;
+        }
+        written += (size_t)ret;
+    }
+
+    *p_handle = fd;
+    return 0;
+
+fail:
+    close(fd);
+    return -1;
+#else
+    (void)data;
+    (void)size;
+    (void)p_handle;
+    return -1;
+#endif
+}
+
+void *
+os_memfd_map_private(void *addr, size_t size, os_file_handle handle)
+{
+    void *ret = mmap(addr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_FIXED, handle, 0);
+
+    if (ret == MAP_FAILED) {
+        os_printf("mmap memfd failed with errno: %d, addr: %p, size: %zu\n",
+                  errno, addr, size);
+        return NULL;
+    }
+
+    return ret;
+}
+
+int
+os_memfd_unmap_private(void *addr, size_t size)
+{
+    void *ret = mmap(addr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+
+    if (ret == MAP_FAILED) {
+        os_printf("mmap anonymous failed with errno: %d, addr: %p, "
+                  "size: %zu\n",
+                  errno, addr, size);
+        return -1;
+    }
+
+    return 0;
+}
+
+void *
+os_memfd_map_shared(size_t size, int prot, os_file_handle handle)
+{
+    int map_prot = PROT_NONE;
+    void *ret;
+
+    if (prot & MMAP_PROT_READ)
+        map_prot |= PROT_READ;
+
+    if (prot & MMAP_PROT_WRITE)
+        map_prot |= PROT_WRITE;
+
+    if (prot & MMAP_PROT_EXEC)
+        map_prot |= PROT_EXEC;
+
+    ret = mmap(NULL, size, map_prot, MAP_SHARED, handle, 0);
+    if (ret == MAP_FAILED) {
+        os_printf("mmap shared memfd failed with errno: %d, size: %zu, "
+                  "prot: %d\n",
+                  errno, size, prot);
+        return NULL;
+    }
+
+    return ret;
+}
+
+void
+os_memfd_close(os_file_handle handle)
+{
+    close(handle);
+}
+#endif /* end of OS_ENABLE_MEMFD */
+
+#ifdef OS_ENABLE_MEM_DISCARD
+int
+os_mem_discard(void *addr, size_t size)
+{
+    if (madvise(addr, size, MADV_DONTNEED) != 0) {
+        os_printf("madvise(%p, %zu) failed with errno: %d\n", addr, size,
+                  errno);
+        return -1;
+    }
+
+    return 0;
+}
+#endif
+
 int
 os_mprotect(void *addr, size_t size, int prot)
 {
@@ -283,6 +283,41 @@ os_socket_recv_from(bh_socket_t socket, void *buf, unsigned int len, int flags,
     return ret;
 }
 
+#ifdef OS_ENABLE_IO_URING
+int
+os_io_ring_recv_from(os_io_ring *ring, bh_socket_t socket, void *buf,
+                     unsigned int len, int flags, bh_sockaddr_t *src_addr)
+{
+    struct sockaddr_storage sock_addr = { 0 };
+    struct iovec iov = { buf, len };
+    struct msghdr msg = { 0 };
+    int ret;
+
+    msg.msg_name = &sock_addr;
+    msg.msg_namelen = sizeof(sock_addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    ret = os_io_ring_recvmsg(ring, socket, &msg, flags);
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (src_addr && msg.msg_namelen > 0) {
+        if (sockaddr_to_bh_sockaddr((struct sockaddr *)&sock_addr, src_addr)
+            == BHT_ERROR) {
+            return -1;
+        }
+    }
+    else if (src_addr) {
+        memset(src_addr, 0, sizeof(*src_addr));
+    }
+
+    return ret;
+}
+#endif
+
 int
 os_socket_send(bh_socket_t socket, const void *buf, unsigned int len)
 {
@@ -302,6 +337,28 @@ os_socket_send_to(bh_socket_t socket, const void *buf, unsigned int len,
                   socklen);
 }
 
+#ifdef OS_ENABLE_IO_URING
+int
+os_io_ring_send_to(os_io_ring *ring, bh_socket_t socket, const void *buf,
+                   unsigned int len, int flags,
+                   const bh_sockaddr_t *dest_addr)
+{
+    struct sockaddr_storage sock_addr = { 0 };
+    socklen_t socklen = 0;
+    struct iovec iov = { (void *)buf, len };
+    struct msghdr msg = { 0 };
+
+    bh_sockaddr_to_sockaddr(dest_addr, &sock_addr, &socklen);
+
+    msg.msg_name = &sock_addr;
+    msg.msg_namelen = socklen;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    return os_io_ring_sendmsg(ring, socket, &msg, flags);
+}
+#endif
+
 int
 os_socket_close(bh_socket_t socket)
 {
@@ -14,6 +14,10 @@
 #if defined(__APPLE__) || defined(__MACH__)
 #include <TargetConditionals.h>
 #endif
+#ifdef OS_ENABLE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 typedef struct {
     thread_start_routine_t start;
@@ -342,6 +346,45 @@ os_cond_broadcast(korp_cond *cond)
     return BHT_OK;
 }
 
+#ifdef OS_ENABLE_FUTEX
+int
+os_futex_wait(uint32 *addr, uint32 expected, uint64 useconds)
+{
+    struct timespec ts, *p_ts = NULL;
+
+    if (useconds != BHT_WAIT_FOREVER) {
+        ts.tv_sec = (time_t)(useconds / 1000000);
+        ts.tv_nsec = (long)(useconds % 1000000) * 1000;
+        p_ts = &ts;
+    }
+
+    /* The timeout of FUTEX_WAIT is relative */
+    if (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, p_ts, NULL, 0)
+        == 0)
+        return BHT_OK;
+
+    switch (errno) {
+        case ETIMEDOUT:
+            return BHT_TIMED_OUT;
+        case EAGAIN: /* the word doesn't equal the expected value */
+        case EINTR:
+            return BHT_OK;
+        default:
+            return BHT_ERROR;
+    }
+}
+
+int
+os_futex_wake(uint32 *addr, uint32 count)
+{
+    if (count > INT32_MAX)
+        count = INT32_MAX;
+
+    return (int)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, (int)count, NULL,
+                        NULL, 0);
+}
+#endif /* end of OS_ENABLE_FUTEX */
+
 int
 os_rwlock_init(korp_rwlock *lock)
 {
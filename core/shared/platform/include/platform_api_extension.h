@@ -240,6 +240,99 @@ os_cond_signal(korp_cond *cond);
 int
 os_cond_broadcast(korp_cond *cond);
 
+#ifdef OS_ENABLE_FUTEX
+/**
+ * Wait on a 32-bit word until it is woken up by os_futex_wake, return
+ * immediately if the word doesn't equal the expected value. The check
+ * and the sleep are atomic against os_futex_wake. The waiting may also
+ * be woken up spuriously or by a signal, so the caller should check the
+ * condition it waits for again after returning.
+ *
+ * @param addr the address of the word, must be 4-byte aligned
+ * @param expected the expected value of the word
+ * @param useconds the max time to wait in microseconds,
+ *        BHT_WAIT_FOREVER to wait forever
+ *
+ * @return BHT_TIMED_OUT if the time expired, BHT_ERROR if failed,
+ *         BHT_OK otherwise
+ */
+int
+os_futex_wait(uint32 *addr, uint32 expected, uint64 useconds);
+
+/**
+ * Wake up the threads waiting on a 32-bit word with os_futex_wait
+ *
+ * @param addr the address of the word
+ * @param count the max number of threads to wake up
+ *
+ * @return the number of threads woken up, or -1 if failed
+ */
+int
+os_futex_wake(uint32 *addr, uint32 count);
+#endif
+
+#ifdef OS_ENABLE_FIBER
+/**
+ * Create a fiber, which runs the entry function on a separately allocated
+ * stack. The fiber starts running when it is resumed the first time, and
+ * switches back to the context which resumed it when it yields or when
+ * the entry function returns. A fiber must be resumed and yield on the
+ * same thread.
+ *
+ * @param entry the entry function of the fiber
+ * @param arg the argument passed to the entry function
+ * @param stack_size the size of the stack of the fiber
+ *
+ * @return the fiber created, NULL if failed
+ */
+os_fiber *
+os_fiber_create(void (*entry)(void *), void *arg, uint32 stack_size);
+
+/**
+ * Destroy a fiber which isn't running, the frames left on its stack
+ * are discarded without being unwound
+ *
+ * @param fiber the fiber to destroy
+ */
+void
+os_fiber_destroy(os_fiber *fiber);
+
+/**
+ * Switch from the current context to the fiber, return after the fiber
+ * yields or its entry function returns
+ *
+ * @param fiber the fiber to resume
+ *
+ * @return BHT_OK if success, BHT_ERROR if the fiber is running or has
+ *         finished, or the switching failed
+ */
+int
+os_fiber_resume(os_fiber *fiber);
+
+/**
+ * Switch from the running fiber back to the context which resumed it,
+ * return after the fiber is resumed again
+ *
+ * @param fiber the running fiber, it must be the current context
+ *
+ * @return BHT_OK if success, BHT_ERROR otherwise
+ */
+int
+os_fiber_yield(os_fiber *fiber);
+
+/**
+ * Get the lowest usable address of the stack of the fiber
+ */
+uint8 *
+os_fiber_get_stack_boundary(os_fiber *fiber);
+
+/**
+ * Check whether the entry function of the fiber has returned
+ */
+bool
+os_fiber_is_finished(os_fiber *fiber);
+#endif
+
 /**
  * Initialize readwrite lock object
  *
@@ -1306,6 +1399,90 @@ __wasi_errno_t
 os_writev(os_file_handle handle, const struct __wasi_ciovec_t *iov, int iovcnt,
           size_t *nwritten);
 
+#ifdef OS_ENABLE_IO_URING
+/**
+ * Create a ring to submit file and socket I/O through io_uring. A ring
+ * is used by one thread at a time. Each operation on it submits its
+ * requests with one system call and blocks until they complete, or until
+ * the waiting is interrupted by a signal, see os_wakeup_blocking_op, in
+ * which case the requests are canceled before returning.
+ *
+ * @return the ring created, or NULL if io_uring isn't supported or allowed
+ */
+os_io_ring *
+os_io_ring_create(void);
+
+/**
+ * Destroy a ring created by os_io_ring_create
+ *
+ * @param ring the ring to destroy
+ */
+void
+os_io_ring_destroy(os_io_ring *ring);
+
+/**
+ * Same as os_preadv but through the ring, read at the current file
+ * position like os_readv if offset is -1.
+ */
+__wasi_errno_t
+os_io_ring_readv(os_io_ring *ring, os_file_handle handle,
+                 const struct __wasi_iovec_t *iov, int iovcnt, int64 offset,
+                 size_t *nread);
+
+/**
+ * Same as os_pwritev but through the ring, write at the current file
+ * position like os_writev if offset is -1.
+ */
+__wasi_errno_t
+os_io_ring_writev(os_io_ring *ring, os_file_handle handle,
+                  const struct __wasi_ciovec_t *iov, int iovcnt, int64 offset,
+                  size_t *nwritten);
+
+/**
+ * Same as os_socket_recv_from but through the ring
+ */
+int
+os_io_ring_recv_from(os_io_ring *ring, bh_socket_t socket, void *buf,
+                     unsigned int len, int flags, bh_sockaddr_t *src_addr);
+
+/**
+ * Same as os_socket_send_to but through the ring
+ */
+int
+os_io_ring_send_to(os_io_ring *ring, bh_socket_t socket, const void *buf,
+                   unsigned int len, int flags,
+                   const bh_sockaddr_t *dest_addr);
+
+/**
+ * Same as poll() but through the ring, all the fds are armed with one
+ * submission. Falls back to poll() if there are more fds than the ring
+ * can hold.
+ */
+int
+os_io_ring_poll(os_io_ring *ring, struct pollfd *pfds, nfds_t nfds,
+                int timeout_ms);
+#endif /* end of OS_ENABLE_IO_URING */
+
+#ifdef OS_ENABLE_FD_TRANSFER
+/**
+ * Move up to len bytes from one handle to another without copying them
+ * through user space where the kernel allows it, e.g. from a file to a
+ * socket or through a pipe, like sendfile, splice and copy_file_range do.
+ * The data is copied through a host buffer for the other handles.
+ *
+ * @param handle_in the handle to read from
+ * @param offset the offset to read at without moving the file position of
+ * handle_in, or -1 to read at and advance the file position
+ * @param handle_out the handle to write to at its file position
+ * @param len the maximum number of bytes to move
+ * @param ntransferred a pointer in which to store the number of bytes moved,
+ * which is 0 at the end of the input
+ */
+__wasi_errno_t
+os_fd_transfer(os_file_handle handle_in, int64 offset,
+               os_file_handle handle_out, size_t len, size_t *ntransferred);
+#endif
+
 /**
  * Allocate storage space for the file associated with the provided handle. This
  * is similar to the POSIX function posix_fallocate.
@@ -165,6 +165,87 @@ os_mremap_slow(void *old_addr, size_t old_size, size_t new_size)
 void *
 os_mremap(void *old_addr, size_t old_size, size_t new_size);
 
+#ifdef OS_ENABLE_MEMFD
+/**
+ * Create an anonymous memory-backed file holding a copy of the data
+ *
+ * @param data the data to copy into the file, or NULL to create a file
+ *        filled with zero
+ * @param size the size of the data, must be a multiple of page size
+ * @param p_handle return the handle of the file created
+ *
+ * @return 0 if success, -1 otherwise
+ */
+int
+os_memfd_create(const void *data, size_t size, os_file_handle *p_handle);
+
+/**
+ * Map the file created by os_memfd_create to the fixed address, the
+ * mapping is readable, writable and private: pages are shared with the
+ * file until they are written, and writes are never carried to the file
+ *
+ * @param addr the address to map to, must be page aligned, the original
+ *        mapping of the range is replaced
+ * @param size the size to map, must be a multiple of page size and not
+ *        larger than the file size
+ * @param handle the handle of the file
+ *
+ * @return addr if success, NULL otherwise
+ */
+void *
+os_memfd_map_private(void *addr, size_t size, os_file_handle handle);
+
+/**
+ * Replace the mapping created by os_memfd_map_private with private
+ * anonymous memory, the range is readable, writable and filled with zero
+ *
+ * @param addr the address of the mapping, must be page aligned
+ * @param size the size of the mapping, must be a multiple of page size
+ *
+ * @return 0 if success, -1 otherwise
+ */
+int
+os_memfd_unmap_private(void *addr, size_t size);
+
+/**
+ * Map the file created by os_memfd_create as shared memory, the writes
+ * through one mapping are seen by the other mappings of the file, so the
+ * same pages can be mapped writable and executable at different addresses
+ *
+ * @param size the size to map, must be a multiple of page size and not
+ *        larger than the file size
+ * @param prot the protection of the mapping, see MMAP_PROT_XXX
+ * @param handle the handle of the file
+ *
+ * @return the address mapped if success, NULL otherwise, the mapping is
+ *         unmapped with os_munmap
+ */
+void *
+os_memfd_map_shared(size_t size, int prot, os_file_handle handle);
+
+/**
+ * Close the file created by os_memfd_create, the mappings of it are
+ * still valid after closing
+ */
+void
+os_memfd_close(os_file_handle handle);
+#endif
+
+#ifdef OS_ENABLE_MEM_DISCARD
+/**
+ * Release the physical pages of a range of private anonymous memory,
+ * the mapping and its protection are kept, and the range reads as zero
+ * when it is accessed again
+ *
+ * @param addr the start address of the range, must be page aligned
+ * @param size the size of the range, must be a multiple of page size
+ *
+ * @return 0 if success, -1 otherwise
+ */
+int
+os_mem_discard(void *addr, size_t size);
+#endif
+
 #if (WASM_MEM_DUAL_BUS_MIRROR != 0)
 void *
 os_get_dbus_mirror(void *ibus);
@@ -119,6 +119,40 @@ os_sigreturn();
 #if WASM_DISABLE_WAKEUP_BLOCKING_OP == 0
 #define OS_ENABLE_WAKEUP_BLOCKING_OP
 #endif
+
+/* Anonymous memory-backed files, see os_memfd_create */
+#define OS_ENABLE_MEMFD
+/* Discarding pages of anonymous mappings, see os_mem_discard */
+#define OS_ENABLE_MEM_DISCARD
+/* Waiting on and waking up a 32-bit word directly, see os_futex_wait */
+#if WASM_DISABLE_FUTEX == 0
+#define OS_ENABLE_FUTEX
+#endif
+/* Moving data between two handles in the kernel, see os_fd_transfer */
+#define OS_ENABLE_FD_TRANSFER
+
+#ifdef __GLIBC__
+/* Running code on separately allocated stacks, see os_fiber_create */
+#define OS_ENABLE_FIBER
+typedef struct os_fiber os_fiber;
+#endif
+
+#if WASM_ENABLE_LIBC_WASI_IO_URING != 0
+/* Submitting file and socket I/O through io_uring, see os_io_ring_create */
+#define OS_ENABLE_IO_URING
+typedef struct os_io_ring os_io_ring;
+
+/* Send or receive a message on the socket through the ring, return the
+   number of bytes transferred, or -1 with errno set on failure */
+int
+os_io_ring_sendmsg(os_io_ring *ring, int socket, struct msghdr *msg,
+                   int flags);
+
+int
+os_io_ring_recvmsg(os_io_ring *ring, int socket, struct msghdr *msg,
+                   int flags);
+#endif
+
 void
 os_set_signal_number_for_blocking_op(int signo);
 
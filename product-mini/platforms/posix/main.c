@@ -50,20 +50,41 @@ print_help(void)
 #endif
 #if WASM_ENABLE_JIT != 0 && WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_LAZY_JIT != 0
     printf("  --multi-tier-jit         Run the wasm app with multi-tier jit mode\n");
+    printf("  --tierup-threshold=n     Set the hotness of a function to compile it with\n");
+    printf("                           llvm jit in multi-tier jit mode, which counts the\n");
+    printf("                           calls and loop iterations, default is %u\n",
+           WASM_TIERUP_HOTNESS_THRESHOLD);
 #endif
     printf("  --stack-size=n           Set maximum stack size in bytes, default is 64 KB\n");
     printf("  --heap-size=n            Set maximum heap size in bytes, default is 16 KB\n");
 #if WASM_ENABLE_FAST_JIT != 0
-    printf("  --jit-codecache-size=n   Set fast jit maximum code cache size in bytes,\n");
-    printf("                           default is %u KB\n", FAST_JIT_DEFAULT_CODE_CACHE_SIZE / 1024);
+    printf("  --jit-codecache-size=n   Set fast jit code cache size in bytes, the code\n");
+    printf("                           cache grows by chunks of at most this size,\n");
+    printf("                           default is %u KB\n",
+           FAST_JIT_DEFAULT_CODE_CACHE_SIZE / 1024);
+    printf("  --jit-codecache-max-size=n\n");
+    printf("                           Set fast jit code cache max total size in bytes,\n");
+    printf("                           default is the code cache size\n");
+    printf("  --fast-jit-opt-level=n   Set fast jit IR optimization level (0 to 2),\n");
+    printf("                           default is 0\n");
 #endif
 #if WASM_ENABLE_GC != 0
     printf("  --gc-heap-size=n         Set maximum gc heap size in bytes,\n");
     printf("                           default is %u KB\n", GC_HEAP_SIZE_DEFAULT / 1024);
+    printf("  --gc-pause-budget=n      Set the max pause time of gc in microseconds,\n");
+    printf("                           the heap is swept lazily when it is used up,\n");
+    printf("                           default is 0 (no limit)\n");
+#if WASM_ENABLE_GC_NURSERY != 0
+    printf("  --gc-nursery-size=n      Set the nursery size of gc heap in bytes,\n");
+    printf("                           default is %u KB\n", GC_NURSERY_SIZE_DEFAULT / 1024);
+#endif
 #endif
 #if WASM_ENABLE_JIT != 0
     printf("  --llvm-jit-size-level=n  Set LLVM JIT size level, default is 3\n");
     printf("  --llvm-jit-opt-level=n   Set LLVM JIT optimization level, default is 3\n");
+    printf("  --llvm-jit-cache-dir=<dir>\n");
+    printf("                           Save the code compiled by LLVM JIT to the directory\n");
+    printf("                           and load it from there in later runs\n");
 #if defined(os_writegsbase)
     printf("  --enable-segue[=<flags>] Enable using segment register GS as the base address of\n");
     printf("                           linear memory, which may improve performance, flags can be:\n");
@@ -95,6 +116,12 @@ print_help(void)
 #endif
 #if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
     printf("  --max-threads=n          Set maximum thread number per cluster, default is 4\n");
+    printf("  --thread-pool-size=n     Set the number of native threads and module instances\n");
+    printf("                           kept per cluster to run new threads, default is 0\n");
+    printf("                           (disabled)\n");
+    printf("  --thread-idle-timeout=ms Set the time a kept native thread waits for a new\n");
+    printf("                           thread before exiting, 0 to wait forever, default\n");
+    printf("                           is 1000\n");
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
     printf("  --timeout=ms             Set the maximum execution time in ms.\n");
@@ -107,6 +134,14 @@ print_help(void)
 #endif
 #if WASM_ENABLE_STATIC_PGO != 0
     printf("  --gen-prof-file=<path>   Generate LLVM PGO (Profile-Guided Optimization) profile file\n");
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    printf("  --profile=<file>         Sample the call stacks while running and write the\n");
+    printf("                           profile to the file\n");
+    printf("  --profile-format=<fmt>   Set the profile format, can be collapsed (default),\n");
+    printf("                           the input of flamegraph.pl, or pprof\n");
+    printf("  --profile-interval=us    Set the sample interval in microseconds of cpu time,\n");
+    printf("                           default is 10000\n");
 #endif
     printf("  --version                Show version information\n");
     return 1;
@@ -576,14 +611,25 @@ main(int argc, char *argv[])
 #endif
 #if WASM_ENABLE_FAST_JIT != 0
     uint32 jit_code_cache_size = FAST_JIT_DEFAULT_CODE_CACHE_SIZE;
+    uint32 jit_code_cache_max_size = 0;
+    uint32 fast_jit_opt_level = 0;
 #endif
 #if WASM_ENABLE_GC != 0
     uint32 gc_heap_size = GC_HEAP_SIZE_DEFAULT;
+    uint32 gc_pause_budget_us = 0;
+#if WASM_ENABLE_GC_NURSERY != 0
+    uint32 gc_nursery_size = GC_NURSERY_SIZE_DEFAULT;
+#endif
 #endif
 #if WASM_ENABLE_JIT != 0
     uint32 llvm_jit_size_level = 3;
     uint32 llvm_jit_opt_level = 3;
     uint32 segue_flags = 0;
+    const char *llvm_jit_cache_dir = NULL;
+#endif
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_FAST_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+    uint32 tierup_threshold = WASM_TIERUP_HOTNESS_THRESHOLD;
 #endif
 #if WASM_ENABLE_LINUX_PERF != 0
     bool enable_linux_perf = false;
@@ -617,9 +663,18 @@ main(int argc, char *argv[])
 #if WASM_ENABLE_STATIC_PGO != 0
     const char *gen_prof_file = NULL;
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    const char *profile_file = NULL;
+    wasm_profile_format_t profile_format = WASM_PROFILE_FORMAT_COLLAPSED;
+    uint32 profile_interval_us = 0;
+#endif
 #if WASM_ENABLE_THREAD_MGR != 0
     int timeout_ms = -1;
 #endif
+#if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
+    uint32 thread_pool_size = 0;
+    uint32 thread_idle_timeout_ms = 1000;
+#endif
 
 #if WASM_ENABLE_LIBC_WASI != 0
     memset(&wasi_parse_ctx, 0, sizeof(wasi_parse_ctx));
@@ -654,6 +709,11 @@ main(int argc, char *argv[])
         else if (!strcmp(argv[0], "--multi-tier-jit")) {
             running_mode = Mode_Multi_Tier_JIT;
         }
+        else if (!strncmp(argv[0], "--tierup-threshold=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            tierup_threshold = atoi(argv[0] + 19);
+        }
 #endif
 #if WASM_ENABLE_LOG != 0
         else if (!strncmp(argv[0], "-v=", 3)) {
@@ -686,6 +746,21 @@ main(int argc, char *argv[])
                 return print_help();
             jit_code_cache_size = atoi(argv[0] + 21);
         }
+        else if (!strncmp(argv[0], "--jit-codecache-max-size=", 25)) {
+            if (argv[0][25] == '\0')
+                return print_help();
+            jit_code_cache_max_size = atoi(argv[0] + 25);
+        }
+        else if (!strncmp(argv[0], "--fast-jit-opt-level=", 21)) {
+            if (argv[0][21] == '\0')
+                return print_help();
+            fast_jit_opt_level = atoi(argv[0] + 21);
+            if (fast_jit_opt_level > 2) {
+                printf("Fast JIT opt level shouldn't be greater than 2, "
+                       "setting it to 2\n");
+                fast_jit_opt_level = 2;
+            }
+        }
 #endif
 #if WASM_ENABLE_GC != 0
         else if (!strncmp(argv[0], "--gc-heap-size=", 15)) {
@@ -693,6 +768,18 @@ main(int argc, char *argv[])
                 return print_help();
             gc_heap_size = atoi(argv[0] + 15);
         }
+        else if (!strncmp(argv[0], "--gc-pause-budget=", 18)) {
+            if (argv[0][18] == '\0')
+                return print_help();
+            gc_pause_budget_us = atoi(argv[0] + 18);
+        }
+#if WASM_ENABLE_GC_NURSERY != 0
+        else if (!strncmp(argv[0], "--gc-nursery-size=", 18)) {
+            if (argv[0][18] == '\0')
+                return print_help();
+            gc_nursery_size = atoi(argv[0] + 18);
+        }
+#endif
 #endif
 #if WASM_ENABLE_JIT != 0
         else if (!strncmp(argv[0], "--llvm-jit-size-level=", 22)) {
@@ -725,6 +812,11 @@ main(int argc, char *argv[])
                 llvm_jit_opt_level = 3;
             }
         }
+        else if (!strncmp(argv[0], "--llvm-jit-cache-dir=", 21)) {
+            if (argv[0][21] == '\0')
+                return print_help();
+            llvm_jit_cache_dir = argv[0] + 21;
+        }
         else if (!strcmp(argv[0], "--enable-segue")) {
             /* all flags are enabled */
             segue_flags = 0x1F1F;
@@ -767,6 +859,16 @@ main(int argc, char *argv[])
                 return print_help();
             wasm_runtime_set_max_thread_num(atoi(argv[0] + 14));
         }
+        else if (!strncmp(argv[0], "--thread-pool-size=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            thread_pool_size = atoi(argv[0] + 19);
+        }
+        else if (!strncmp(argv[0], "--thread-idle-timeout=", 22)) {
+            if (argv[0][22] == '\0')
+                return print_help();
+            thread_idle_timeout_ms = atoi(argv[0] + 22);
+        }
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
         else if (!strncmp(argv[0], "--timeout=", 10)) {
@@ -794,6 +896,26 @@ main(int argc, char *argv[])
                 return print_help();
             gen_prof_file = argv[0] + 16;
         }
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+        else if (!strncmp(argv[0], "--profile=", 10)) {
+            if (argv[0][10] == '\0')
+                return print_help();
+            profile_file = argv[0] + 10;
+        }
+        else if (!strncmp(argv[0], "--profile-format=", 17)) {
+            if (!strcmp(argv[0] + 17, "collapsed"))
+                profile_format = WASM_PROFILE_FORMAT_COLLAPSED;
+            else if (!strcmp(argv[0] + 17, "pprof"))
+                profile_format = WASM_PROFILE_FORMAT_PPROF;
+            else
+                return print_help();
+        }
+        else if (!strncmp(argv[0], "--profile-interval=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            profile_interval_us = atoi(argv[0] + 19);
+        }
 #endif
         else if (!strcmp(argv[0], "--version")) {
             uint32 major, minor, patch;
@@ -849,21 +971,37 @@ main(int argc, char *argv[])
 
 #if WASM_ENABLE_FAST_JIT != 0
     init_args.fast_jit_code_cache_size = jit_code_cache_size;
+    init_args.fast_jit_code_cache_max_size = jit_code_cache_max_size;
+    init_args.fast_jit_opt_level = fast_jit_opt_level;
 #endif
 
 #if WASM_ENABLE_GC != 0
     init_args.gc_heap_size = gc_heap_size;
+    init_args.gc_pause_budget_us = gc_pause_budget_us;
+#if WASM_ENABLE_GC_NURSERY != 0
+    init_args.gc_nursery_size = gc_nursery_size;
+#endif
 #endif
 
 #if WASM_ENABLE_JIT != 0
     init_args.llvm_jit_size_level = llvm_jit_size_level;
     init_args.llvm_jit_opt_level = llvm_jit_opt_level;
     init_args.segue_flags = segue_flags;
+    init_args.llvm_jit_cache_dir = llvm_jit_cache_dir;
+#endif
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_FAST_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+    init_args.tierup_hotness_threshold = tierup_threshold;
 #endif
 #if WASM_ENABLE_LINUX_PERF != 0
     init_args.enable_linux_perf = enable_linux_perf;
 #endif
 
+#if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
+    init_args.thread_pool_size = thread_pool_size;
+    init_args.thread_idle_timeout_ms = thread_idle_timeout_ms;
+#endif
+
 #if WASM_ENABLE_DEBUG_INTERP != 0
     init_args.instance_port = instance_port;
     if (ip_addr)
@@ -992,6 +1130,13 @@ main(int argc, char *argv[])
     }
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    if (profile_file && !wasm_runtime_start_profiling(profile_interval_us)) {
+        printf("Failed to start the sampling profiler\n");
+        profile_file = NULL;
+    }
+#endif
+
     ret = 0;
     const char *exception = NULL;
     if (is_repl_mode) {
@@ -1022,6 +1167,14 @@ main(int argc, char *argv[])
     if (exception)
         printf("%s\n", exception);
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    if (profile_file) {
+        wasm_runtime_stop_profiling();
+        if (!wasm_runtime_write_profile(profile_file, profile_format))
+            printf("Failed to write the profile to %s\n", profile_file);
+    }
+#endif
+
 #if WASM_ENABLE_STATIC_PGO != 0 && WASM_ENABLE_AOT != 0
     if (get_package_type(wasm_file_buf, wasm_file_size) == Wasm_Module_AoT
         && gen_prof_file)
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "bh_platform.h"
+#include "mem_alloc.h"
+
+#define POOL_SIZE (256 * 1024)
+
+class alloc_thread_cache_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        allocator = mem_allocator_create(pool, sizeof(pool));
+        ASSERT_NE(allocator, nullptr);
+        ASSERT_TRUE(mem_allocator_enable_thread_cache(allocator));
+        initial_free = free_size();
+    }
+
+    virtual void TearDown()
+    {
+        if (allocator)
+            mem_allocator_destroy(allocator);
+    }
+
+    uint32 free_size()
+    {
+        uint32 info[3] = { 0 };
+
+        mem_allocator_get_alloc_info(allocator, info);
+        return info[1];
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    uint8 pool[POOL_SIZE];
+    mem_allocator_t allocator = nullptr;
+    uint32 initial_free = 0;
+};
+
+TEST_F(alloc_thread_cache_test, reuse)
+{
+    void *p = mem_allocator_malloc(allocator, 32);
+    void *q;
+
+    ASSERT_NE(p, nullptr);
+    memset(p, 0xAA, 32);
+    mem_allocator_free(allocator, p);
+
+    /* The block freed is cached and allocated again for the same size */
+    q = mem_allocator_malloc(allocator, 32);
+    EXPECT_EQ(q, p);
+    mem_allocator_free(allocator, q);
+
+    /* The cached blocks are counted as free */
+    EXPECT_EQ(free_size(), initial_free);
+}
+
+TEST_F(alloc_thread_cache_test, double_free)
+{
+    void *p = mem_allocator_malloc(allocator, 32);
+    void *q, *r;
+
+    ASSERT_NE(p, nullptr);
+    mem_allocator_free(allocator, p);
+    /* The second free is rejected, or the block is cached twice and
+       handed out twice */
+    mem_allocator_free(allocator, p);
+
+    q = mem_allocator_malloc(allocator, 32);
+    r = mem_allocator_malloc(allocator, 32);
+    ASSERT_NE(q, nullptr);
+    ASSERT_NE(r, nullptr);
+    EXPECT_NE(q, r);
+    mem_allocator_free(allocator, q);
+    mem_allocator_free(allocator, r);
+    EXPECT_EQ(free_size(), initial_free);
+}
+
+TEST_F(alloc_thread_cache_test, realloc)
+{
+    uint8 *p = (uint8 *)mem_allocator_malloc(allocator, 16);
+
+    ASSERT_NE(p, nullptr);
+    for (uint32 i = 0; i < 16; i++)
+        p[i] = (uint8)i;
+
+    p = (uint8 *)mem_allocator_realloc(allocator, p, 200);
+    ASSERT_NE(p, nullptr);
+    for (uint32 i = 0; i < 16; i++)
+        EXPECT_EQ(p[i], i);
+    p = (uint8 *)mem_allocator_realloc(allocator, p, 4096);
+    ASSERT_NE(p, nullptr);
+    for (uint32 i = 0; i < 16; i++)
+        EXPECT_EQ(p[i], i);
+
+    mem_allocator_free(allocator, p);
+    EXPECT_EQ(free_size(), initial_free);
+}
+
+TEST_F(alloc_thread_cache_test, exhaust)
+{
+    std::vector<void *> blocks;
+    void *p, *big;
+
+    /* Fill the pool with small blocks */
+    while ((p = mem_allocator_malloc(allocator, 64)))
+        blocks.push_back(p);
+    ASSERT_GT(blocks.size(), 1000u);
+
+    /* Free every other block, the big allocation below fails unless
+       the adjacent blocks are returned to the pool and merged */
+    for (size_t i = 0; i < blocks.size(); i += 2)
+        mem_allocator_free(allocator, blocks[i]);
+    for (size_t i = 1; i < blocks.size(); i += 2)
+        mem_allocator_free(allocator, blocks[i]);
+
+    big = mem_allocator_malloc(allocator, POOL_SIZE / 2);
+    EXPECT_NE(big, nullptr);
+    mem_allocator_free(allocator, big);
+    EXPECT_EQ(free_size(), initial_free);
+}
+
+struct stress_data {
+    mem_allocator_t allocator;
+    uint32 seed;
+    bool failed;
+};
+
+static void *
+stress_thread(void *arg)
+{
+    struct stress_data *data = (struct stress_data *)arg;
+    uint8 *blocks[32] = { 0 };
+    uint32 sizes[32] = { 0 };
+    uint32 seed = data->seed;
+
+    for (uint32 i = 0; i < 50000; i++) {
+        uint32 slot, size;
+
+        seed = seed * 1103515245 + 12345;
+        slot = (seed >> 16) % 32;
+        if (blocks[slot]) {
+            /* Check that no other thread got the same block */
+            for (uint32 j = 0; j < sizes[slot]; j++) {
+                if (blocks[slot][j] != (uint8)slot)
+                    data->failed = true;
+            }
+            mem_allocator_free(data->allocator, blocks[slot]);
+            blocks[slot] = NULL;
+        }
+        else {
+            size = 1 + (seed >> 8) % 300;
+            if ((blocks[slot] =
+                     (uint8 *)mem_allocator_malloc(data->allocator, size))) {
+                memset(blocks[slot], slot, size);
+                sizes[slot] = size;
+            }
+        }
+    }
+
+    for (uint32 slot = 0; slot < 32; slot++)
+        mem_allocator_free(data->allocator, blocks[slot]);
+    return NULL;
+}
+
+TEST_F(alloc_thread_cache_test, threads)
+{
+    struct stress_data data[4];
+    korp_tid tids[4];
+
+    for (uint32 i = 0; i < 4; i++) {
+        data[i] = { allocator, i + 1, false };
+        ASSERT_EQ(os_thread_create(&tids[i], stress_thread, &data[i],
+                                   APP_THREAD_STACK_SIZE_DEFAULT),
+                  0);
+    }
+    for (uint32 i = 0; i < 4; i++) {
+        os_thread_join(tids[i], NULL);
+        EXPECT_FALSE(data[i].failed);
+    }
+
+    EXPECT_FALSE(mem_allocator_is_heap_corrupted(allocator));
+    EXPECT_EQ(free_size(), initial_free);
+}
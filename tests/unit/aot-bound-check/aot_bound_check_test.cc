@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+#include "bh_platform.h"
+#include "bh_read_file.h"
+#include "wasm_export.h"
+
+#include <fstream>
+#include <map>
+
+#define PAGE_SIZE 65536
+
+/* The functions of wasm-apps/test.wast, which is compiled by wamrc
+   with the software bound checks, the first four have a loop */
+static const char *func_names[] = {
+    "sum", "fill", "fill_rev", "fill_grow", "sum3", "load_store_load",
+};
+
+class aot_bound_check_test : public testing::Test
+{
+  private:
+    std::string get_binary_path()
+    {
+        char cwd[1024] = { 0 };
+
+        if (readlink("/proc/self/exe", cwd, 1024) <= 0) {
+            return NULL;
+        }
+
+        char *path_end = strrchr(cwd, '/');
+        if (path_end != NULL) {
+            *path_end = '\0';
+        }
+
+        return std::string(cwd);
+    }
+
+  protected:
+    void SetUp()
+    {
+        RuntimeInitArgs init_args;
+        std::string file = get_binary_path() + "/wasm-apps/test.aot";
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        aot_file_buf = (uint8 *)bh_read_file_to_buffer(file.c_str(),
+                                                       &aot_file_size);
+        ASSERT_TRUE(aot_file_buf != NULL);
+        module = wasm_runtime_load(aot_file_buf, aot_file_size, error_buf,
+                                   sizeof(error_buf));
+        ASSERT_TRUE(module != NULL) << error_buf;
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        if (aot_file_buf)
+            BH_FREE(aot_file_buf);
+        wasm_runtime_destroy();
+    }
+
+    /* Returns the loop_versioned counts of the bound check report */
+    std::map<std::string, uint32> read_report()
+    {
+        std::ifstream report(get_binary_path() + "/wasm-apps/test.report");
+        std::map<std::string, uint32> counts;
+        std::string line, key = "loop_versioned=";
+        size_t pos;
+
+        while (std::getline(report, line)) {
+            if ((pos = line.find(key)) != std::string::npos)
+                counts[line.substr(0, line.find('\t'))] =
+                    (uint32)atoi(line.c_str() + pos + key.size());
+        }
+        return counts;
+    }
+
+    /* Returns false if the function traps, which must be by the bound
+       check */
+    bool call(const char *name, uint32 argc, uint32 argv[])
+    {
+        const char *exception;
+
+        EXPECT_TRUE(wasm_runtime_lookup_function(module_inst, name) != NULL);
+        if (call_wasm_func(exec_env, name, argc, argv))
+            return true;
+
+        exception = wasm_runtime_get_exception(module_inst);
+        EXPECT_STREQ(exception, "Exception: out of bounds memory access");
+        wasm_runtime_clear_exception(module_inst);
+        return false;
+    }
+
+    /* The memory may be moved by memory.grow */
+    uint32 *memory()
+    {
+        return (uint32 *)wasm_runtime_addr_app_to_native(module_inst, 0);
+    }
+
+    /* Returns the count of the i32s equal to v in [begin, end) */
+    uint32 count(uint32 begin, uint32 end, uint32 v)
+    {
+        uint32 n = 0, i;
+
+        for (i = begin; i < end; i += 4)
+            n += memory()[i / 4] == v ? 1 : 0;
+        return n;
+    }
+
+    uint8 *aot_file_buf = NULL;
+    uint32 aot_file_size = 0;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    char error_buf[128];
+};
+
+TEST_F(aot_bound_check_test, report)
+{
+    std::map<std::string, uint32> counts = read_report();
+    uint32 i;
+
+    /* The loops are versioned, so the tests below run the loops without
+       checks if they are in bounds, and the loops with the checks if not */
+    for (i = 0; i < 4; i++)
+        EXPECT_GT(counts["aot_func#" + std::to_string(i)], 0u)
+            << func_names[i];
+}
+
+TEST_F(aot_bound_check_test, sum)
+{
+    uint32 argv[2], i;
+
+    for (i = 0; i < 16; i++)
+        memory()[PAGE_SIZE / 4 - 16 + i] = i + 1;
+
+    /* The last i32 of the memory is accessed in the last iteration */
+    argv[0] = PAGE_SIZE - 16 * 4;
+    argv[1] = 16;
+    ASSERT_TRUE(call("sum", 2, argv));
+    EXPECT_EQ(argv[0], 16u * 17 / 2);
+
+    /* Out of bounds in the last iteration */
+    argv[0] = PAGE_SIZE - 15 * 4;
+    argv[1] = 16;
+    EXPECT_FALSE(call("sum", 2, argv));
+
+    /* Out of bounds in the first iteration */
+    argv[0] = PAGE_SIZE;
+    argv[1] = 1;
+    EXPECT_FALSE(call("sum", 2, argv));
+
+    /* The last byte is out of bounds */
+    argv[0] = PAGE_SIZE - 3;
+    argv[1] = 1;
+    EXPECT_FALSE(call("sum", 2, argv));
+}
+
+TEST_F(aot_bound_check_test, fill)
+{
+    uint32 argv[3];
+
+    /* The last i32 of the memory is stored in the last iteration */
+    argv[0] = PAGE_SIZE - 4 - 16 * 4;
+    argv[1] = 16;
+    argv[2] = 0x5a5a5a5a;
+    ASSERT_TRUE(call("fill", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x5a5a5a5a), 16u);
+    EXPECT_EQ(count(PAGE_SIZE - 16 * 4, PAGE_SIZE, 0x5a5a5a5a), 16u);
+
+    /* Out of bounds in the last iteration, the stores before it are done */
+    argv[0] = PAGE_SIZE - 16 * 4;
+    argv[1] = 16;
+    argv[2] = 0x11111111;
+    EXPECT_FALSE(call("fill", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x11111111), 15u);
+    EXPECT_EQ(count(PAGE_SIZE - 15 * 4, PAGE_SIZE, 0x11111111), 15u);
+
+    /* The address wraps around in 32 bits before the loop ends, the
+       store out of bounds traps before that */
+    argv[0] = 0;
+    argv[1] = 0x40000001;
+    argv[2] = 0x22222222;
+    EXPECT_FALSE(call("fill", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x22222222), PAGE_SIZE / 4 - 1);
+    EXPECT_EQ(memory()[0], 0u);
+}
+
+TEST_F(aot_bound_check_test, fill_rev)
+{
+    uint32 argv[3];
+
+    /* The whole memory from the last i32 */
+    argv[0] = 0;
+    argv[1] = PAGE_SIZE / 4;
+    argv[2] = 0x5a5a5a5a;
+    ASSERT_TRUE(call("fill_rev", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x5a5a5a5a), PAGE_SIZE / 4);
+
+    /* Out of bounds in the first iteration, nothing is stored */
+    argv[0] = 4;
+    argv[1] = PAGE_SIZE / 4;
+    argv[2] = 0x11111111;
+    EXPECT_FALSE(call("fill_rev", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x11111111), 0u);
+
+    /* Out of bounds in the last iteration: the address of the first
+       iteration wraps around to 0 */
+    argv[0] = (uint32)-4;
+    argv[1] = 2;
+    argv[2] = 0x22222222;
+    EXPECT_FALSE(call("fill_rev", 3, argv));
+    EXPECT_EQ(count(0, PAGE_SIZE, 0x22222222), 1u);
+    EXPECT_EQ(memory()[0], 0x22222222u);
+}
+
+TEST_F(aot_bound_check_test, fill_grow)
+{
+    uint32 argv[3];
+
+    /* In bounds after the memory grows in the first iteration */
+    argv[0] = PAGE_SIZE - 4;
+    argv[1] = 16;
+    argv[2] = 0x5a5a5a5a;
+    ASSERT_TRUE(call("fill_grow", 3, argv));
+    EXPECT_EQ(count(PAGE_SIZE, PAGE_SIZE * 2, 0x5a5a5a5a), 16u);
+
+    /* Out of bounds in the last iteration after the memory grows */
+    argv[0] = PAGE_SIZE * 3 - 16 * 4;
+    argv[1] = 16;
+    argv[2] = 0x11111111;
+    EXPECT_FALSE(call("fill_grow", 3, argv));
+    EXPECT_EQ(count(PAGE_SIZE * 2, PAGE_SIZE * 3, 0x11111111), 15u);
+}
+
+TEST_F(aot_bound_check_test, sum3)
+{
+    uint32 argv[1];
+
+    memory()[PAGE_SIZE / 4 - 3] = 1;
+    memory()[PAGE_SIZE / 4 - 2] = 2;
+    memory()[PAGE_SIZE / 4 - 1] = 3;
+
+    argv[0] = PAGE_SIZE - 12;
+    ASSERT_TRUE(call("sum3", 1, argv));
+    EXPECT_EQ(argv[0], 6u);
+
+    /* The merged check traps if any of the loads is out of bounds */
+    argv[0] = PAGE_SIZE - 8;
+    EXPECT_FALSE(call("sum3", 1, argv));
+    argv[0] = PAGE_SIZE - 11;
+    EXPECT_FALSE(call("sum3", 1, argv));
+}
+
+TEST_F(aot_bound_check_test, load_store_load)
+{
+    uint32 argv[2];
+
+    memory()[PAGE_SIZE / 4 - 3] = 1;
+    memory()[PAGE_SIZE / 4 - 1] = 3;
+
+    argv[0] = PAGE_SIZE - 12;
+    argv[1] = 2;
+    ASSERT_TRUE(call("load_store_load", 2, argv));
+    EXPECT_EQ(argv[0], 4u);
+    EXPECT_EQ(memory()[PAGE_SIZE / 4 - 2], 2u);
+
+    /* The second load traps after the store is done */
+    argv[0] = PAGE_SIZE - 8;
+    argv[1] = 0x11111111;
+    EXPECT_FALSE(call("load_store_load", 2, argv));
+    EXPECT_EQ(memory()[PAGE_SIZE / 4 - 1], 0x11111111u);
+}
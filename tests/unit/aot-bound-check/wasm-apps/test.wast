@@ -0,0 +1,118 @@
+(module
+  (memory (export "memory") 1)
+
+  ;; Sum of the i32s in [base, base + n * 4), n > 0
+  (func (export "sum") (param $base i32) (param $n i32) (result i32)
+    (local $i i32) (local $s i32)
+    loop $l
+      local.get $s
+      local.get $base
+      local.get $i
+      i32.const 2
+      i32.shl
+      i32.add
+      i32.load
+      i32.add
+      local.set $s
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $l
+    end
+    local.get $s
+  )
+
+  ;; Store v to the i32s in [base + 4, base + 4 + n * 4), n > 0
+  (func (export "fill") (param $base i32) (param $n i32) (param $v i32)
+    (local $i i32)
+    loop $l
+      local.get $base
+      local.get $i
+      i32.const 2
+      i32.shl
+      i32.add
+      local.get $v
+      i32.store offset=4
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $l
+    end
+  )
+
+  ;; Store v to the i32s in [base, base + n * 4) from the last one, n > 0
+  (func (export "fill_rev") (param $base i32) (param $n i32) (param $v i32)
+    loop $l
+      local.get $n
+      i32.const 1
+      i32.sub
+      local.tee $n
+      i32.const 2
+      i32.shl
+      local.get $base
+      i32.add
+      local.get $v
+      i32.store
+      local.get $n
+      br_if $l
+    end
+  )
+
+  ;; Same as fill, but grow the memory by one page in the first iteration
+  (func (export "fill_grow") (param $base i32) (param $n i32) (param $v i32)
+    (local $i i32)
+    loop $l
+      local.get $i
+      i32.eqz
+      if
+        i32.const 1
+        memory.grow
+        drop
+      end
+      local.get $base
+      local.get $i
+      i32.const 2
+      i32.shl
+      i32.add
+      local.get $v
+      i32.store offset=4
+      local.get $i
+      i32.const 1
+      i32.add
+      local.tee $i
+      local.get $n
+      i32.lt_u
+      br_if $l
+    end
+  )
+
+  ;; The checks of the loads from p are merged into one
+  (func (export "sum3") (param $p i32) (result i32)
+    local.get $p
+    i32.load
+    local.get $p
+    i32.load offset=4
+    i32.add
+    local.get $p
+    i32.load offset=8
+    i32.add
+  )
+
+  ;; The check of the first load must not cover the load after the store
+  (func (export "load_store_load") (param $p i32) (param $v i32) (result i32)
+    local.get $p
+    i32.load
+    local.get $p
+    local.get $v
+    i32.store offset=4
+    local.get $p
+    i32.load offset=8
+    i32.add
+  )
+)
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (import "env" "wait" (func (param i32) (result i32)))
+ *   (func (export "run") (param i32) (result i32)
+ *     (i32.add (call 0 (local.get 0))
+ *              (call 0 (i32.add (local.get 0) (i32.const 1))))))
+ */
+static const uint8_t wait_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x02, 0x0C, 0x01, 0x03, 0x65, 0x6E, 0x76, 0x04,
+    0x77, 0x61, 0x69, 0x74, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07,
+    0x01, 0x03, 0x72, 0x75, 0x6E, 0x00, 0x01, 0x0A, 0x10, 0x01, 0x0E, 0x00,
+    0x20, 0x00, 0x10, 0x00, 0x20, 0x00, 0x41, 0x01, 0x6A, 0x10, 0x00, 0x6A,
+    0x0B
+};
+
+/* The argument of the last pending wait, and whether a wait failed to
+   suspend the call */
+static int32_t pending_arg;
+static bool wait_failed;
+
+/* Suspend the call until the host resumes it with the result, or return
+   -1 immediately if the call isn't async */
+static int32_t
+wait_wrapper(wasm_exec_env_t exec_env, int32_t arg)
+{
+    uint64_t result;
+
+    pending_arg = arg;
+    if (!wasm_runtime_suspend(exec_env, &result)) {
+        wait_failed = true;
+        return -1;
+    }
+    return (int32_t)result;
+}
+
+static NativeSymbol native_symbols[] = {
+    { "wait", (void *)wait_wrapper, "(i)i", NULL },
+};
+
+class async_call_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(wasm_runtime_register_natives(
+            "env", native_symbols,
+            sizeof(native_symbols) / sizeof(NativeSymbol)));
+
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        for (int i = 0; i < 2; i++) {
+            insts[i] = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                                sizeof(error_buf));
+            ASSERT_NE(insts[i], nullptr) << error_buf;
+            exec_envs[i] = wasm_runtime_create_exec_env(insts[i], 8192);
+            ASSERT_NE(exec_envs[i], nullptr);
+        }
+        pending_arg = 0;
+        wait_failed = false;
+    }
+
+    virtual void TearDown()
+    {
+        for (int i = 0; i < 2; i++) {
+            if (exec_envs[i])
+                wasm_runtime_destroy_exec_env(exec_envs[i]);
+            if (insts[i])
+                wasm_runtime_deinstantiate(insts[i]);
+        }
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    wasm_async_status_t call_run(int i, uint32_t argv[])
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(insts[i], "run");
+
+        return wasm_runtime_call_wasm_async(exec_envs[i], func, 1, argv);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ wait_wasm, sizeof(wait_wasm) };
+    char error_buf[128] = { 0 };
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t insts[2] = { nullptr, nullptr };
+    wasm_exec_env_t exec_envs[2] = { nullptr, nullptr };
+};
+
+TEST_F(async_call_test, suspend_resume)
+{
+    uint32_t argv[1] = { 10 };
+
+    ASSERT_EQ(call_run(0, argv), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 10);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 100), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 11);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 5), WASM_ASYNC_DONE);
+    EXPECT_EQ(argv[0], 105u);
+    EXPECT_FALSE(wait_failed);
+
+    /* Nothing to resume after the call is done */
+    EXPECT_EQ(wasm_runtime_resume(exec_envs[0], 0), WASM_ASYNC_FAILED);
+
+    /* The native stack is reused by the next call */
+    argv[0] = 20;
+    ASSERT_EQ(call_run(0, argv), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 20);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 1), WASM_ASYNC_SUSPENDED);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 2), WASM_ASYNC_DONE);
+    EXPECT_EQ(argv[0], 3u);
+}
+
+TEST_F(async_call_test, interleave)
+{
+    uint32_t argv0[1] = { 1 }, argv1[1] = { 2 };
+
+    /* Two suspended calls are multiplexed on the same thread */
+    ASSERT_EQ(call_run(0, argv0), WASM_ASYNC_SUSPENDED);
+    ASSERT_EQ(call_run(1, argv1), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 2);
+
+    /* An exec env can't start another call before its call is done */
+    EXPECT_EQ(call_run(0, argv0), WASM_ASYNC_FAILED);
+
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 10), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 2);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[1], 20), WASM_ASYNC_SUSPENDED);
+    EXPECT_EQ(pending_arg, 3);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[1], 30), WASM_ASYNC_DONE);
+    ASSERT_EQ(wasm_runtime_resume(exec_envs[0], 40), WASM_ASYNC_DONE);
+    EXPECT_EQ(argv0[0], 50u);
+    EXPECT_EQ(argv1[0], 50u);
+}
+
+TEST_F(async_call_test, sync_call)
+{
+    uint32_t argv[1] = { 1 };
+
+    /* The native falls back to blocking in a normal call */
+    ASSERT_TRUE(call_wasm_func(exec_envs[0], "run", 1, argv));
+    EXPECT_TRUE(wait_failed);
+    EXPECT_EQ((int32_t)argv[0], -2);
+}
+
+TEST_F(async_call_test, cancel)
+{
+    uint32_t argv[1] = { 1 };
+
+    ASSERT_EQ(call_run(0, argv), WASM_ASYNC_SUSPENDED);
+
+    /* Destroying the exec env unwinds the suspended call */
+    wasm_runtime_destroy_exec_env(exec_envs[0]);
+    exec_envs[0] = nullptr;
+    EXPECT_TRUE(wait_failed);
+    EXPECT_STREQ(wasm_runtime_get_exception(insts[0]),
+                 "Exception: async call canceled");
+}
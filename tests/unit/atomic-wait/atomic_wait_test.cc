@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (import "wasi" "thread-spawn" (func $spawn (param i32) (result i32)))
+ *   (memory (export "memory") 1 1 shared)
+ *   (func (export "wasi_thread_start") (param i32 i32)
+ *     (if (i32.eqz (local.get 1))
+ *       (then
+ *         (drop (i32.atomic.rmw.add (i32.const 0) (i32.const 1)))
+ *         ;; count the waiters woken up by notify
+ *         (drop (i32.atomic.rmw.add (i32.const 4)
+ *           (i32.eqz (memory.atomic.wait32 (i32.const 8) (i32.const 0)
+ *                                          (i64.const -1))))))
+ *       (else
+ *         (drop (memory.atomic.wait32 (i32.const 16) (i32.const 0)
+ *                                     (i64.const -1)))))
+ *     (drop (i32.atomic.rmw.add (i32.const 12) (i32.const 1))))
+ *   (func (export "wait32") (param i32 i32 i64) (result i32)
+ *     (memory.atomic.wait32 (local.get 0) (local.get 1) (local.get 2)))
+ *   (func (export "notify") (param i32 i32) (result i32)
+ *     (memory.atomic.notify (local.get 0) (local.get 1)))
+ *   (func (export "run") (param $n i32) (result i32)
+ *     (local $i i32) (local $woken i32)
+ *     ;; spawn $n waiters, retry when the max thread num is reached
+ *     (block (loop
+ *       (br_if 1 (i32.ge_u (local.get $i) (local.get $n)))
+ *       (if (i32.gt_s (call $spawn (i32.const 0)) (i32.const 0))
+ *         (then (local.set $i (i32.add (local.get $i) (i32.const 1)))))
+ *       (br 0)))
+ *     (block (loop
+ *       (br_if 0 (i32.ne (i32.atomic.load (i32.const 0)) (local.get $n)))))
+ *     ;; wake them up one by one
+ *     (block (loop
+ *       (br_if 1 (i32.ge_u (local.get $woken) (local.get $n)))
+ *       (local.set $woken
+ *         (i32.add (local.get $woken)
+ *                  (memory.atomic.notify (i32.const 8) (i32.const 1))))
+ *       (br 0)))
+ *     (block (loop
+ *       (br_if 0 (i32.ne (i32.atomic.load (i32.const 12)) (local.get $n)))))
+ *     (i32.atomic.load (i32.const 4)))
+ *   (func (export "spawn_waiter") (result i32)
+ *     (call $spawn (i32.const 1))))
+ */
+static const uint8_t wait_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1C, 0x05, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x00, 0x60, 0x03, 0x7F,
+    0x7F, 0x7E, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x00,
+    0x01, 0x7F, 0x02, 0x15, 0x01, 0x04, 0x77, 0x61, 0x73, 0x69, 0x0C, 0x74,
+    0x68, 0x72, 0x65, 0x61, 0x64, 0x2D, 0x73, 0x70, 0x61, 0x77, 0x6E, 0x00,
+    0x00, 0x03, 0x06, 0x05, 0x01, 0x02, 0x03, 0x00, 0x04, 0x05, 0x04, 0x01,
+    0x03, 0x01, 0x01, 0x07, 0x45, 0x06, 0x06, 0x6D, 0x65, 0x6D, 0x6F, 0x72,
+    0x79, 0x02, 0x00, 0x11, 0x77, 0x61, 0x73, 0x69, 0x5F, 0x74, 0x68, 0x72,
+    0x65, 0x61, 0x64, 0x5F, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x01, 0x06,
+    0x77, 0x61, 0x69, 0x74, 0x33, 0x32, 0x00, 0x02, 0x06, 0x6E, 0x6F, 0x74,
+    0x69, 0x66, 0x79, 0x00, 0x03, 0x03, 0x72, 0x75, 0x6E, 0x00, 0x04, 0x0C,
+    0x73, 0x70, 0x61, 0x77, 0x6E, 0x5F, 0x77, 0x61, 0x69, 0x74, 0x65, 0x72,
+    0x00, 0x05, 0x0A, 0xC2, 0x01, 0x05, 0x38, 0x00, 0x20, 0x01, 0x45, 0x04,
+    0x40, 0x41, 0x00, 0x41, 0x01, 0xFE, 0x1E, 0x02, 0x00, 0x1A, 0x41, 0x04,
+    0x41, 0x08, 0x41, 0x00, 0x42, 0x7F, 0xFE, 0x01, 0x02, 0x00, 0x45, 0xFE,
+    0x1E, 0x02, 0x00, 0x1A, 0x05, 0x41, 0x10, 0x41, 0x00, 0x42, 0x7F, 0xFE,
+    0x01, 0x02, 0x00, 0x1A, 0x0B, 0x41, 0x0C, 0x41, 0x01, 0xFE, 0x1E, 0x02,
+    0x00, 0x1A, 0x0B, 0x0C, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xFE,
+    0x01, 0x02, 0x00, 0x0B, 0x0A, 0x00, 0x20, 0x00, 0x20, 0x01, 0xFE, 0x00,
+    0x02, 0x00, 0x0B, 0x68, 0x01, 0x02, 0x7F, 0x02, 0x40, 0x03, 0x40, 0x20,
+    0x01, 0x20, 0x00, 0x4F, 0x0D, 0x01, 0x41, 0x00, 0x10, 0x00, 0x41, 0x00,
+    0x4A, 0x04, 0x40, 0x20, 0x01, 0x41, 0x01, 0x6A, 0x21, 0x01, 0x0B, 0x0C,
+    0x00, 0x0B, 0x0B, 0x02, 0x40, 0x03, 0x40, 0x41, 0x00, 0xFE, 0x10, 0x02,
+    0x00, 0x20, 0x00, 0x47, 0x0D, 0x00, 0x0B, 0x0B, 0x02, 0x40, 0x03, 0x40,
+    0x20, 0x02, 0x20, 0x00, 0x4F, 0x0D, 0x01, 0x20, 0x02, 0x41, 0x08, 0x41,
+    0x01, 0xFE, 0x00, 0x02, 0x00, 0x6A, 0x21, 0x02, 0x0C, 0x00, 0x0B, 0x0B,
+    0x02, 0x40, 0x03, 0x40, 0x41, 0x0C, 0xFE, 0x10, 0x02, 0x00, 0x20, 0x00,
+    0x47, 0x0D, 0x00, 0x0B, 0x0B, 0x41, 0x04, 0xFE, 0x10, 0x02, 0x00, 0x0B,
+    0x06, 0x00, 0x41, 0x01, 0x10, 0x00, 0x0B
+};
+
+class atomic_wait_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(inst, 8192);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    int32_t call(const char *name, uint32_t argc, uint32_t *argv)
+    {
+        EXPECT_NE(wasm_runtime_lookup_function(inst, name), nullptr) << name;
+        if (!call_wasm_func(exec_env, name, argc, argv)) {
+            ADD_FAILURE() << wasm_runtime_get_exception(inst);
+            return -1;
+        }
+        return (int32_t)argv[0];
+    }
+
+    int32_t wait32(uint32_t addr, uint32_t expected, int64_t timeout)
+    {
+        uint32_t argv[4] = { addr, expected };
+
+        memcpy(argv + 2, &timeout, sizeof(int64_t));
+        return call("wait32", 4, argv);
+    }
+
+    int32_t notify(uint32_t addr, uint32_t count)
+    {
+        uint32_t argv[2] = { addr, count };
+
+        return call("notify", 2, argv);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ wait_wasm, sizeof(wait_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(atomic_wait_test, value_not_equal)
+{
+    EXPECT_EQ(wait32(8, 5, -1), 1);
+}
+
+TEST_F(atomic_wait_test, timeout)
+{
+    uint64 start = os_time_get_boot_us();
+
+    EXPECT_EQ(wait32(8, 0, 10 * 1000 * 1000), 2);
+    EXPECT_GE(os_time_get_boot_us() - start, 10 * 1000u);
+}
+
+TEST_F(atomic_wait_test, notify_without_waiters)
+{
+    EXPECT_EQ(notify(8, 1), 0);
+    EXPECT_EQ(notify(8, 0), 0);
+}
+
+TEST_F(atomic_wait_test, notify_waiters)
+{
+    uint32_t argv[1] = { 4 };
+
+    /* Every waiter is woken up by exactly one notify */
+    EXPECT_EQ(call("run", 1, argv), 4);
+    EXPECT_EQ(notify(8, 1), 0);
+}
+
+TEST_F(atomic_wait_test, terminate_waiter)
+{
+    uint32_t argv[1] = { 0 };
+    uint64 start;
+
+    EXPECT_GT(call("spawn_waiter", 0, argv), 0);
+    os_usleep(20 * 1000);
+
+    /* The waiter waits forever unless the termination wakes it up */
+    start = os_time_get_boot_us();
+    wasm_runtime_terminate(inst);
+    wasm_runtime_destroy_exec_env(exec_env);
+    exec_env = nullptr;
+    EXPECT_LT(os_time_get_boot_us() - start, 500 * 1000u);
+}
+
+TEST_F(atomic_wait_test, terminate_waiter_at_recheck)
+{
+    uint32_t argv[1] = { 0 };
+    uint64 start;
+
+    EXPECT_GT(call("spawn_waiter", 0, argv), 0);
+    /* Terminate the waiter around the time it wakes up to check whether
+       it is terminated, which mustn't deadlock with the cancellation */
+    os_usleep(1000 * 1000);
+
+    start = os_time_get_boot_us();
+    wasm_runtime_terminate(inst);
+    wasm_runtime_destroy_exec_env(exec_env);
+    exec_env = nullptr;
+    EXPECT_LT(os_time_get_boot_us() - start, 1500 * 1000u);
+}
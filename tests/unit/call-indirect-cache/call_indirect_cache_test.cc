@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (type $t (func (param i32) (result i32)))
+ *   (table 4 funcref)
+ *   (elem (i32.const 0) $add1 $mul2 $neg $wrong)
+ *   (func $add1 (type $t) (i32.add (local.get 0) (i32.const 1)))
+ *   (func $mul2 (type $t) (i32.mul (local.get 0) (i32.const 2)))
+ *   (func $neg (type $t) (i32.sub (i32.const 0) (local.get 0)))
+ *   (func $wrong (result i32) (i32.const 42))
+ *   (func (export "dispatch") (param i32 i32) (result i32)
+ *     (call_indirect (type $t) (local.get 1) (local.get 0)))
+ *   (func (export "set") (param i32 i32)
+ *     (table.set (local.get 0) (table.get (local.get 1))))
+ *   (func (export "grow") (param i32) (result i32)
+ *     (table.grow (table.get (local.get 0)) (i32.const 1)))
+ *   (func (export "grow_null") (result i32)
+ *     (table.grow (ref.null func) (i32.const 1))))
+ */
+static const uint8_t dispatch_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x15, 0x04, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F,
+    0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x00, 0x03, 0x09, 0x08, 0x00, 0x00,
+    0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x04, 0x04, 0x01, 0x70, 0x00, 0x04,
+    0x07, 0x25, 0x04, 0x08, 0x64, 0x69, 0x73, 0x70, 0x61, 0x74, 0x63, 0x68,
+    0x00, 0x04, 0x03, 0x73, 0x65, 0x74, 0x00, 0x05, 0x04, 0x67, 0x72, 0x6F,
+    0x77, 0x00, 0x06, 0x09, 0x67, 0x72, 0x6F, 0x77, 0x5F, 0x6E, 0x75, 0x6C,
+    0x6C, 0x00, 0x07, 0x09, 0x0A, 0x01, 0x00, 0x41, 0x00, 0x0B, 0x04, 0x00,
+    0x01, 0x02, 0x03, 0x0A, 0x49, 0x08, 0x07, 0x00, 0x20, 0x00, 0x41, 0x01,
+    0x6A, 0x0B, 0x07, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6C, 0x0B, 0x07, 0x00,
+    0x41, 0x00, 0x20, 0x00, 0x6B, 0x0B, 0x04, 0x00, 0x41, 0x2A, 0x0B, 0x09,
+    0x00, 0x20, 0x01, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0B, 0x0A, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x25, 0x00, 0x26, 0x00, 0x0B, 0x0B, 0x00, 0x20, 0x00,
+    0x25, 0x00, 0x41, 0x01, 0xFC, 0x0F, 0x00, 0x0B, 0x09, 0x00, 0xD0, 0x70,
+    0x41, 0x01, 0xFC, 0x0F, 0x00, 0x0B
+};
+
+class call_indirect_cache_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = instantiate();
+        ASSERT_NE(inst, nullptr) << error_buf;
+    }
+
+    virtual void TearDown()
+    {
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    wasm_module_inst_t instantiate()
+    {
+        return wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+    }
+
+    /* Call the function, return the exception if it traps */
+    std::string call(wasm_module_inst_t module_inst, const char *name,
+                     uint32_t argc, uint32_t argv[])
+    {
+        wasm_exec_env_t exec_env =
+            wasm_runtime_get_exec_env_singleton(module_inst);
+        std::string exception;
+
+        if (!call_wasm_func(exec_env, name, argc, argv)) {
+            if (!wasm_runtime_get_exception(module_inst))
+                return "function not found";
+            exception = wasm_runtime_get_exception(module_inst);
+            wasm_runtime_clear_exception(module_inst);
+        }
+        return exception;
+    }
+
+    int32_t dispatch(wasm_module_inst_t module_inst, uint32_t elem,
+                     int32_t value)
+    {
+        uint32_t argv[2] = { elem, (uint32_t)value };
+
+        EXPECT_EQ(call(module_inst, "dispatch", 2, argv), "");
+        return (int32_t)argv[0];
+    }
+
+    std::string dispatch_trap(uint32_t elem)
+    {
+        uint32_t argv[2] = { elem, 0 };
+
+        return call(inst, "dispatch", 2, argv);
+    }
+
+    void set(uint32_t dst, uint32_t src)
+    {
+        uint32_t argv[2] = { dst, src };
+
+        EXPECT_EQ(call(inst, "set", 2, argv), "");
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ dispatch_wasm, sizeof(dispatch_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+};
+
+TEST_F(call_indirect_cache_test, polymorphic)
+{
+    /* More callees than the cache holds */
+    for (int32_t i = 0; i < 100; i++) {
+        EXPECT_EQ(dispatch(inst, 0, i), i + 1);
+        EXPECT_EQ(dispatch(inst, 1, i), i * 2);
+        if (i % 10 == 0)
+            EXPECT_EQ(dispatch(inst, 2, i), -i);
+    }
+}
+
+TEST_F(call_indirect_cache_test, type_mismatch)
+{
+    EXPECT_EQ(dispatch(inst, 0, 1), 2);
+    EXPECT_EQ(dispatch_trap(3), "Exception: indirect call type mismatch");
+    EXPECT_EQ(dispatch(inst, 0, 1), 2);
+    EXPECT_EQ(dispatch_trap(3), "Exception: indirect call type mismatch");
+    EXPECT_EQ(dispatch_trap(4), "Exception: undefined element");
+}
+
+TEST_F(call_indirect_cache_test, table_set)
+{
+    EXPECT_EQ(dispatch(inst, 0, 5), 6);
+    EXPECT_EQ(dispatch(inst, 1, 5), 10);
+
+    /* The elements are swapped, the cached callees follow them */
+    set(0, 1);
+    set(1, 2);
+    EXPECT_EQ(dispatch(inst, 0, 5), 10);
+    EXPECT_EQ(dispatch(inst, 1, 5), -5);
+
+    /* A function of another type replaces a cached one */
+    set(0, 3);
+    EXPECT_EQ(dispatch_trap(0), "Exception: indirect call type mismatch");
+}
+
+TEST_F(call_indirect_cache_test, table_grow)
+{
+    uint32_t argv[1] = { 2 };
+
+    EXPECT_EQ(dispatch(inst, 2, 5), -5);
+    EXPECT_EQ(dispatch_trap(4), "Exception: undefined element");
+    EXPECT_EQ(call(inst, "grow", 1, argv), "");
+    EXPECT_EQ(argv[0], 4u);
+    EXPECT_EQ(dispatch(inst, 4, 5), -5);
+
+    EXPECT_EQ(call(inst, "grow_null", 0, argv), "");
+    EXPECT_EQ(argv[0], 5u);
+    EXPECT_EQ(dispatch_trap(5), "Exception: uninitialized element");
+}
+
+TEST_F(call_indirect_cache_test, shared_by_instances)
+{
+    wasm_module_inst_t inst2 = instantiate();
+
+    ASSERT_NE(inst2, nullptr) << error_buf;
+    EXPECT_EQ(dispatch(inst, 0, 5), 6);
+    EXPECT_EQ(dispatch(inst, 1, 5), 10);
+
+    /* The caches hold function indexes, which are the same in all the
+       instances, while the tables of the instances differ */
+    set(0, 2);
+    EXPECT_EQ(dispatch(inst, 0, 5), -5);
+    EXPECT_EQ(dispatch(inst2, 0, 5), 6);
+    EXPECT_EQ(dispatch(inst2, 1, 5), 10);
+    EXPECT_EQ(dispatch(inst, 1, 5), 10);
+
+    wasm_runtime_deinstantiate(inst2);
+}
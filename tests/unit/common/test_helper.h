@@ -11,6 +11,7 @@
 #include <iostream>
 #include <memory>
 #include <fstream>
+#include <vector>
 
 template<int Size = 512 * 1024>
 class WAMRRuntimeRAII
@@ -88,6 +89,55 @@ class WAMRExecEnv
     }
 };
 
+/* A copy of the wasm binary to load, the loader may rewrite the buffer,
+   so the modules aren't loaded from the arrays of the tests directly */
+class WAMRWasmBuffer
+{
+  private:
+    std::vector<uint8_t> buffer_;
+
+  public:
+    WAMRWasmBuffer(const uint8_t *buf, uint32_t size)
+      : buffer_(buf, buf + size)
+    {}
+
+    uint8_t *data() { return buffer_.data(); }
+
+    uint32_t size() const { return (uint32_t)buffer_.size(); }
+};
+
+/* Call the exported function with the exec env given */
+inline bool
+call_wasm_func(wasm_exec_env_t exec_env, const char *name, uint32_t argc,
+               uint32_t argv[])
+{
+    wasm_module_inst_t inst = wasm_runtime_get_module_inst(exec_env);
+    wasm_function_inst_t func;
+
+    if (!(func = wasm_runtime_lookup_function(inst, name))) {
+        return false;
+    }
+
+    return wasm_runtime_call_wasm(exec_env, func, argc, argv);
+}
+
+/* Call the exported function with a temporary exec env of the instance */
+inline bool
+call_wasm_func(wasm_module_inst_t inst, const char *name, uint32_t argc,
+               uint32_t argv[], uint32_t stack_size = 8192)
+{
+    wasm_exec_env_t exec_env;
+    bool ret;
+
+    if (!(exec_env = wasm_runtime_create_exec_env(inst, stack_size))) {
+        return false;
+    }
+
+    ret = call_wasm_func(exec_env, name, argc, argv);
+    wasm_runtime_destroy_exec_env(exec_env);
+    return ret;
+}
+
 static uint8_t dummy_wasm_buffer[] = {
     0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x05, 0x03, 0x01, 0x00,
     0x02, 0x06, 0x08, 0x01, 0x7F, 0x01, 0x41, 0x80, 0x88, 0x04, 0x0B, 0x07,
@@ -184,6 +184,209 @@ TEST_F(aot_compiler_test_suit, aot_emit_llvm_file)
     EXPECT_EQ(true, aot_emit_llvm_file(comp_ctx, out_file_name));
 }
 
+static void
+put_leb(std::vector<uint8> &buf, uint32 value)
+{
+    do {
+        uint8 byte = value & 0x7f;
+        value >>= 7;
+        buf.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+static void
+put_section(std::vector<uint8> &buf, uint8 id, const std::vector<uint8> &body)
+{
+    buf.push_back(id);
+    put_leb(buf, (uint32)body.size());
+    buf.insert(buf.end(), body.begin(), body.end());
+}
+
+/* A module of func_count functions of (i32) -> i32, function i calls
+   function i + 1 in a loop, the small callees are inlined at O3 */
+static std::vector<uint8>
+create_call_chain_wasm(uint32 func_count)
+{
+    std::vector<uint8> buf = { 0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00 };
+    std::vector<uint8> types = { 0x01, 0x60, 0x01, 0x7F, 0x01, 0x7F };
+    std::vector<uint8> funcs, exports, codes, body;
+    uint32 i;
+
+    put_leb(funcs, func_count);
+    for (i = 0; i < func_count; i++)
+        funcs.push_back(0x00);
+
+    /* (export "f0" (func 0)) */
+    exports = { 0x01, 0x02, 0x66, 0x30, 0x00, 0x00 };
+
+    put_leb(codes, func_count);
+    for (i = 0; i < func_count; i++) {
+        body.clear();
+        if (i + 1 < func_count) {
+            /* (local i32)
+               (loop
+                 (local.set 1 (i32.add (local.get 1)
+                                       (call i+1 (local.get 0))))
+                 (br_if 0 (local.tee 0 (i32.sub (local.get 0)
+                                                (i32.const 1)))))
+               (local.get 1) */
+            body = { 0x01, 0x01, 0x7F, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00,
+                     0x10 };
+            put_leb(body, i + 1);
+            body.insert(body.end(), { 0x6A, 0x21, 0x01, 0x20, 0x00, 0x41,
+                                      0x01, 0x6B, 0x22, 0x00, 0x0D, 0x00,
+                                      0x0B, 0x20, 0x01, 0x0B });
+        }
+        else {
+            /* (i32.add (local.get 0) (i32.const 1)) */
+            body = { 0x00, 0x20, 0x00, 0x41, 0x01, 0x6A, 0x0B };
+        }
+        put_leb(codes, (uint32)body.size());
+        codes.insert(codes.end(), body.begin(), body.end());
+    }
+
+    put_section(buf, 1, types);
+    put_section(buf, 3, funcs);
+    put_section(buf, 7, exports);
+    put_section(buf, 10, codes);
+    return buf;
+}
+
+/* Compile the wasm file and return the AOT file */
+static std::vector<uint8>
+compile_wasm_to_aot(std::vector<uint8> wasm_buf, AOTCompOption *option)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_t wasm_module = nullptr;
+    aot_comp_data_t comp_data = nullptr;
+    aot_comp_context_t comp_ctx = nullptr;
+    std::vector<uint8> content;
+    uint8 *aot_file_buf = nullptr;
+    uint32 aot_file_size = 0;
+
+    wasm_module = wasm_runtime_load(wasm_buf.data(), (uint32)wasm_buf.size(),
+                                    error_buf, sizeof(error_buf));
+    EXPECT_NE(wasm_module, nullptr) << error_buf;
+    if (!wasm_module)
+        return content;
+
+    comp_data = aot_create_comp_data(wasm_module, NULL, false);
+    EXPECT_NE(nullptr, comp_data);
+    comp_ctx = aot_create_comp_context(comp_data, option);
+    EXPECT_NE(comp_ctx, nullptr);
+    EXPECT_TRUE(aot_compile_wasm(comp_ctx)) << aot_get_last_error();
+
+    aot_file_buf = aot_emit_aot_file_buf(comp_ctx, comp_data, &aot_file_size);
+    EXPECT_NE(aot_file_buf, nullptr) << aot_get_last_error();
+    if (aot_file_buf) {
+        content.assign(aot_file_buf, aot_file_buf + aot_file_size);
+        wasm_runtime_free(aot_file_buf);
+    }
+
+    aot_destroy_comp_context(comp_ctx);
+    aot_destroy_comp_data(comp_data);
+    wasm_runtime_unload(wasm_module);
+    return content;
+}
+
+/* Call the exported function "f0" of the AOT file */
+static bool
+call_aot_func(std::vector<uint8> aot_buf, uint32 arg, uint32 *p_result)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_function_inst_t func;
+    wasm_exec_env_t exec_env = nullptr;
+    uint32 argv[1] = { arg };
+    bool ret = false;
+
+    module = wasm_runtime_load(aot_buf.data(), (uint32)aot_buf.size(),
+                               error_buf, sizeof(error_buf));
+    EXPECT_NE(module, nullptr) << error_buf;
+    if (!module)
+        return false;
+
+    module_inst = wasm_runtime_instantiate(module, 8 * 1024, 0, error_buf,
+                                           sizeof(error_buf));
+    EXPECT_NE(module_inst, nullptr) << error_buf;
+    if (module_inst
+        && (func = wasm_runtime_lookup_function(module_inst, "f0"))
+        && (exec_env = wasm_runtime_create_exec_env(module_inst, 64 * 1024))
+        && wasm_runtime_call_wasm(exec_env, func, 1, argv)) {
+        *p_result = argv[0];
+        ret = true;
+    }
+
+    if (exec_env)
+        wasm_runtime_destroy_exec_env(exec_env);
+    if (module_inst)
+        wasm_runtime_deinstantiate(module_inst);
+    wasm_runtime_unload(module);
+    return ret;
+}
+
+static bool
+check_parallel_jobs()
+{
+    /* Four partitions of 16 functions */
+    std::vector<uint8> wasm_buf = create_call_chain_wasm(64);
+    std::vector<uint8> aot_serial, aot_jobs, aot;
+    AOTCompOption option = { 0 };
+    uint32 jobs[] = { 2, 3, 4, 8 };
+    uint32 result_serial = 0, result_jobs = 0;
+    uint32 i;
+
+    option.opt_level = 3;
+    option.size_level = 3;
+    option.output_format = AOT_FORMAT_FILE;
+    option.bounds_checks = 2;
+    option.enable_simd = true;
+    option.enable_aux_stack_check = true;
+    option.enable_bulk_memory = true;
+    option.enable_ref_types = true;
+
+    aot_serial = compile_wasm_to_aot(wasm_buf, &option);
+    option.parallel_jobs = 1;
+    aot_jobs = compile_wasm_to_aot(wasm_buf, &option);
+    if (aot_serial.empty() || aot_jobs.empty())
+        return false;
+    /* The module is split, the layout of the merged text differs */
+    EXPECT_FALSE(aot_jobs == aot_serial);
+
+    /* The objects of the partitions are merged into an AOT file which
+       runs as the one of the serial build */
+    if (!call_aot_func(aot_serial, 3, &result_serial)
+        || !call_aot_func(aot_jobs, 3, &result_jobs)
+        || result_serial != result_jobs) {
+        ADD_FAILURE() << "result " << result_serial << " != " << result_jobs;
+        return false;
+    }
+
+    /* The output doesn't depend on the thread number */
+    for (i = 0; i < sizeof(jobs) / sizeof(jobs[0]); i++) {
+        option.parallel_jobs = jobs[i];
+        aot = compile_wasm_to_aot(wasm_buf, &option);
+        if (aot != aot_jobs) {
+            ADD_FAILURE() << "jobs=" << jobs[i];
+            return false;
+        }
+    }
+    return aot_jobs != aot_serial;
+}
+
+TEST_F(aot_compiler_test_suit, aot_compile_wasm_parallel_jobs)
+{
+    std::string death_test_style = testing::GTEST_FLAG(death_test_style);
+
+    /* The target machine can't emit again once LLVM is shut down by a
+       previous test, check in a new process running this test only */
+    testing::GTEST_FLAG(death_test_style) = "threadsafe";
+    EXPECT_EXIT(exit(check_parallel_jobs() ? 0 : 1),
+                testing::ExitedWithCode(0), "");
+    testing::GTEST_FLAG(death_test_style) = death_test_style;
+}
+
 TEST_F(aot_compiler_test_suit, aot_generate_tempfile_name)
 {
     char obj_file_name[64];
@@ -105,6 +105,28 @@ TEST_F(compilation_aot_emit_memory_test, aot_check_memory_overflow)
     }
 }
 
+TEST_F(compilation_aot_emit_memory_test, aot_checked_addr_list_find)
+{
+    /* [8, 20) of local 1 has been checked */
+    EXPECT_TRUE(aot_checked_addr_list_add(func_ctx, 1, 8, 12));
+
+    /* Accesses ending no later than the checked range are covered */
+    EXPECT_TRUE(aot_checked_addr_list_find(func_ctx, 1, 8, 12, false));
+    EXPECT_TRUE(aot_checked_addr_list_find(func_ctx, 1, 16, 4, false));
+    EXPECT_TRUE(aot_checked_addr_list_find(func_ctx, 1, 0, 8, false));
+    EXPECT_FALSE(aot_checked_addr_list_find(func_ctx, 1, 17, 4, false));
+    EXPECT_FALSE(aot_checked_addr_list_find(func_ctx, 1, 0, 24, false));
+    EXPECT_FALSE(aot_checked_addr_list_find(func_ctx, 2, 8, 4, false));
+
+    /* Only the same offset if the shared heap is enabled */
+    EXPECT_TRUE(aot_checked_addr_list_find(func_ctx, 1, 8, 4, true));
+    EXPECT_FALSE(aot_checked_addr_list_find(func_ctx, 1, 12, 4, true));
+
+    aot_checked_addr_list_del(func_ctx, 1);
+    EXPECT_FALSE(aot_checked_addr_list_find(func_ctx, 1, 8, 4, false));
+    aot_checked_addr_list_destroy(func_ctx);
+}
+
 TEST_F(compilation_aot_emit_memory_test, aot_compile_op_i32_load)
 {
     uint32 align = 0;
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+#include "wasm_loader_common.h"
+
+/*
+ * (module
+ *   (func (export "load") (result i32) (i32.const 1))
+ *   (func (export "store") (result i32) (i32.const 2)))
+ */
+static uint8_t export_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01,
+    0x60, 0x00, 0x01, 0x7F, 0x03, 0x03, 0x02, 0x00, 0x00, 0x07, 0x10,
+    0x02, 0x04, 0x6C, 0x6F, 0x61, 0x64, 0x00, 0x00, 0x05, 0x73, 0x74,
+    0x6F, 0x72, 0x65, 0x00, 0x01, 0x0A, 0x0B, 0x02, 0x04, 0x00, 0x41,
+    0x01, 0x0B, 0x04, 0x00, 0x41, 0x02, 0x0B
+};
+
+class const_str_pool_test : public testing::Test
+{
+  protected:
+    virtual void SetUp() { memset(&pool, 0, sizeof(pool)); }
+
+    virtual void TearDown() { wasm_const_str_pool_destroy(&pool); }
+
+    char *insert(const char *str)
+    {
+        return wasm_const_str_pool_insert(&pool, (const uint8 *)str,
+                                          (uint32)strlen(str), false,
+                                          error_buf, sizeof(error_buf));
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    ConstStrPool pool;
+    char error_buf[128];
+};
+
+TEST_F(const_str_pool_test, intern_returns_same_copy)
+{
+    char buf[] = "memory";
+    char *s1, *s2, *s3;
+
+    s1 = insert("memory");
+    ASSERT_NE(s1, nullptr) << error_buf;
+    EXPECT_STREQ(s1, "memory");
+    EXPECT_NE(s1, buf);
+
+    s2 = insert(buf);
+    EXPECT_EQ(s1, s2);
+
+    /* A prefix is a different string */
+    s3 = wasm_const_str_pool_insert(&pool, (const uint8 *)buf, 3, false,
+                                    error_buf, sizeof(error_buf));
+    ASSERT_NE(s3, nullptr) << error_buf;
+    EXPECT_STREQ(s3, "mem");
+    EXPECT_NE(s1, s3);
+    EXPECT_EQ(pool.str_count, 2u);
+}
+
+TEST_F(const_str_pool_test, grow_keeps_strings)
+{
+    char name[32], *strs[2000];
+    uint32 i;
+
+    for (i = 0; i < 2000; i++) {
+        snprintf(name, sizeof(name), "func_%u", i);
+        strs[i] = insert(name);
+        ASSERT_NE(strs[i], nullptr) << error_buf;
+    }
+    EXPECT_EQ(pool.str_count, 2000u);
+    EXPECT_GE(pool.slot_count * 3, pool.str_count * 4);
+
+    for (i = 0; i < 2000; i++) {
+        snprintf(name, sizeof(name), "func_%u", i);
+        EXPECT_EQ(insert(name), strs[i]);
+        EXPECT_STREQ(strs[i], name);
+    }
+    EXPECT_EQ(pool.str_count, 2000u);
+    EXPECT_GT(wasm_const_str_pool_get_mem_size(&pool), 2000u * 8);
+}
+
+TEST_F(const_str_pool_test, big_string_gets_own_block)
+{
+    char big[8192], *small1, *small2, *s;
+    ConstStrBlock *head;
+
+    small1 = insert("a");
+    ASSERT_NE(small1, nullptr) << error_buf;
+    head = pool.blocks;
+
+    memset(big, 'x', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    s = insert(big);
+    ASSERT_NE(s, nullptr) << error_buf;
+    EXPECT_EQ(strlen(s), sizeof(big) - 1);
+
+    /* Small strings keep filling the first block */
+    EXPECT_EQ(pool.blocks, head);
+    small2 = insert("b");
+    ASSERT_NE(small2, nullptr) << error_buf;
+    EXPECT_GT((uintptr_t)small2, (uintptr_t)small1);
+    EXPECT_LT((uintptr_t)small2, (uintptr_t)head->data + head->size);
+}
+
+TEST_F(const_str_pool_test, medium_string_keeps_head_block)
+{
+    char medium[2048], *small1, *small2, *s;
+    ConstStrBlock *head;
+
+    small1 = insert("a");
+    ASSERT_NE(small1, nullptr) << error_buf;
+    head = pool.blocks;
+
+    /* A string smaller than a block but bigger than a quarter of it is
+       allocated on its own, no spare block space is stranded */
+    memset(medium, 'y', sizeof(medium) - 1);
+    medium[sizeof(medium) - 1] = '\0';
+    s = insert(medium);
+    ASSERT_NE(s, nullptr) << error_buf;
+    EXPECT_EQ(pool.blocks, head);
+    ASSERT_NE(head->next, nullptr);
+    EXPECT_EQ(head->next->used, head->next->size);
+
+    small2 = insert("b");
+    ASSERT_NE(small2, nullptr) << error_buf;
+    EXPECT_GT((uintptr_t)small2, (uintptr_t)small1);
+    EXPECT_LT((uintptr_t)small2, (uintptr_t)head->data + head->size);
+}
+
+TEST_F(const_str_pool_test, freeable_binary_exports)
+{
+    WAMRWasmBuffer buf(export_wasm, sizeof(export_wasm));
+    LoadArgs args = { 0 };
+    wasm_module_t module;
+    wasm_module_inst_t inst;
+
+    /* The export names are interned as the buffer may be freed after
+       loading, clobber it to check that */
+    args.name = (char *)"freeable";
+    args.wasm_binary_freeable = true;
+    module = wasm_runtime_load_ex(buf.data(), buf.size(), &args, error_buf,
+                                  sizeof(error_buf));
+    ASSERT_NE(module, nullptr) << error_buf;
+    memset(buf.data(), 0, buf.size());
+
+    inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                    sizeof(error_buf));
+    ASSERT_NE(inst, nullptr) << error_buf;
+    EXPECT_NE(wasm_runtime_lookup_function(inst, "load"), nullptr);
+    EXPECT_NE(wasm_runtime_lookup_function(inst, "store"), nullptr);
+    EXPECT_EQ(wasm_runtime_lookup_function(inst, "stor"), nullptr);
+
+    wasm_runtime_deinstantiate(inst);
+    wasm_runtime_unload(module);
+}
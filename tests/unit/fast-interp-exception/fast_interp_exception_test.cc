@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (tag $e0 (param i32))
+ *   (tag $e1 (param i64 i32))
+ *   (func $thrower (export "thrower") (param i32)
+ *     (throw $e0 (local.get 0)))
+ *   (func (export "catch_value") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (call $thrower (local.get 0)) (i32.const -1))
+ *       (catch $e0 (i32.add (i32.const 1)))))
+ *   (func (export "catch_multi") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (throw $e1 (i64.const 7) (local.get 0)))
+ *       (catch $e1 (local.set 0) (i32.wrap_i64) (i32.add (local.get 0)))))
+ *   (func (export "catch_all") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (if (i32.eqz (local.get 0))
+ *             (then (throw $e1 (i64.const 1) (i32.const 2))))
+ *           (throw $e0 (local.get 0)))
+ *       (catch $e1 (drop) (drop) (i32.const 100))
+ *       (catch_all (i32.const 200))))
+ *   (func (export "rethrow") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (try (result i32)
+ *             (do (call $thrower (local.get 0)) (i32.const 0))
+ *             (catch_all (rethrow 0))))
+ *       (catch $e0 (i32.add (i32.const 1000)))))
+ *   (func (export "delegate") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (try (result i32)
+ *             (do (throw $e0 (local.get 0)))
+ *             (delegate 0)))
+ *       (catch $e0 (i32.mul (i32.const 2)))))
+ *   (func (export "delegate_outer") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (try (result i32)
+ *             (do (try (result i32)
+ *                   (do (throw $e0 (local.get 0)))
+ *                   (delegate 1)))
+ *             (catch $e0 (drop) (i32.const 5))))
+ *       (catch $e0 (drop) (i32.const 6))))
+ *   (func (export "uncaught") (param i32) (result i32)
+ *     (call $thrower (local.get 0)) (i32.const 0))
+ *   (func (export "loop_catch") (param i32) (result i32) (local i32)
+ *     (loop
+ *       (try
+ *         (do (call $thrower (local.get 0)))
+ *         (catch $e0 (local.set 1 (i32.add (local.get 1))))))
+ *       (br_if 0 (local.tee 0 (i32.sub (local.get 0) (i32.const 1)))))
+ *     (local.get 1))
+ *   (func (export "no_throw") (param i32) (result i32)
+ *     (try (result i32)
+ *       (do (local.get 0))
+ *       (catch_all (i32.const -1)))))
+ */
+static const uint8_t exception_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x03, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60, 0x02, 0x7E, 0x7F,
+    0x00, 0x03, 0x0B, 0x0A, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x0D, 0x05, 0x02, 0x00, 0x00, 0x00, 0x02, 0x07, 0x7C, 0x0A,
+    0x07, 0x74, 0x68, 0x72, 0x6F, 0x77, 0x65, 0x72, 0x00, 0x00, 0x0B, 0x63,
+    0x61, 0x74, 0x63, 0x68, 0x5F, 0x76, 0x61, 0x6C, 0x75, 0x65, 0x00, 0x01,
+    0x0B, 0x63, 0x61, 0x74, 0x63, 0x68, 0x5F, 0x6D, 0x75, 0x6C, 0x74, 0x69,
+    0x00, 0x02, 0x09, 0x63, 0x61, 0x74, 0x63, 0x68, 0x5F, 0x61, 0x6C, 0x6C,
+    0x00, 0x03, 0x07, 0x72, 0x65, 0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x04,
+    0x08, 0x64, 0x65, 0x6C, 0x65, 0x67, 0x61, 0x74, 0x65, 0x00, 0x05, 0x0E,
+    0x64, 0x65, 0x6C, 0x65, 0x67, 0x61, 0x74, 0x65, 0x5F, 0x6F, 0x75, 0x74,
+    0x65, 0x72, 0x00, 0x06, 0x08, 0x75, 0x6E, 0x63, 0x61, 0x75, 0x67, 0x68,
+    0x74, 0x00, 0x07, 0x0A, 0x6C, 0x6F, 0x6F, 0x70, 0x5F, 0x63, 0x61, 0x74,
+    0x63, 0x68, 0x00, 0x08, 0x08, 0x6E, 0x6F, 0x5F, 0x74, 0x68, 0x72, 0x6F,
+    0x77, 0x00, 0x09, 0x0A, 0xC9, 0x01, 0x0A, 0x06, 0x00, 0x20, 0x00, 0x08,
+    0x00, 0x0B, 0x10, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x7F,
+    0x07, 0x00, 0x41, 0x01, 0x6A, 0x0B, 0x0B, 0x13, 0x00, 0x06, 0x7F, 0x42,
+    0x07, 0x20, 0x00, 0x08, 0x01, 0x07, 0x01, 0x21, 0x00, 0xA7, 0x20, 0x00,
+    0x6A, 0x0B, 0x0B, 0x20, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x45, 0x04, 0x40,
+    0x42, 0x01, 0x41, 0x02, 0x08, 0x01, 0x0B, 0x20, 0x00, 0x08, 0x00, 0x07,
+    0x01, 0x1A, 0x1A, 0x41, 0xE4, 0x00, 0x19, 0x41, 0xC8, 0x01, 0x0B, 0x0B,
+    0x17, 0x00, 0x06, 0x7F, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00,
+    0x19, 0x09, 0x00, 0x0B, 0x07, 0x00, 0x41, 0xE8, 0x07, 0x6A, 0x0B, 0x0B,
+    0x12, 0x00, 0x06, 0x7F, 0x06, 0x7F, 0x20, 0x00, 0x08, 0x00, 0x18, 0x00,
+    0x07, 0x00, 0x41, 0x02, 0x6C, 0x0B, 0x0B, 0x1A, 0x00, 0x06, 0x7F, 0x06,
+    0x7F, 0x06, 0x7F, 0x20, 0x00, 0x08, 0x00, 0x18, 0x01, 0x07, 0x00, 0x1A,
+    0x41, 0x05, 0x0B, 0x07, 0x00, 0x1A, 0x41, 0x06, 0x0B, 0x0B, 0x08, 0x00,
+    0x20, 0x00, 0x10, 0x00, 0x41, 0x00, 0x0B, 0x20, 0x01, 0x01, 0x7F, 0x03,
+    0x40, 0x06, 0x40, 0x20, 0x00, 0x10, 0x00, 0x07, 0x00, 0x20, 0x01, 0x6A,
+    0x21, 0x01, 0x0B, 0x20, 0x00, 0x41, 0x01, 0x6B, 0x22, 0x00, 0x0D, 0x00,
+    0x0B, 0x20, 0x01, 0x0B, 0x0A, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x19, 0x41,
+    0x7F, 0x0B, 0x0B
+};
+
+/*
+ * (module
+ *   (func
+ *     (try (do) (catch_all) (delegate 0))))
+ */
+static const uint8_t delegate_after_catch_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+    0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x0A, 0x09, 0x01, 0x07, 0x00, 0x06,
+    0x40, 0x19, 0x18, 0x00, 0x0B
+};
+
+class fast_interp_exception_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(inst, 8192);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    bool call(const char *name, int32_t arg, int32_t *p_result)
+    {
+        uint32_t argv[1] = { (uint32_t)arg };
+
+        EXPECT_NE(wasm_runtime_lookup_function(inst, name), nullptr) << name;
+        if (!call_wasm_func(exec_env, name, 1, argv))
+            return false;
+        *p_result = (int32_t)argv[0];
+        return true;
+    }
+
+    int32_t call(const char *name, int32_t arg)
+    {
+        int32_t result = -1;
+
+        EXPECT_TRUE(call(name, arg, &result))
+            << wasm_runtime_get_exception(inst);
+        return result;
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ exception_wasm, sizeof(exception_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(fast_interp_exception_test, catch_tag)
+{
+    EXPECT_EQ(call("catch_value", 0), 1);
+    EXPECT_EQ(call("catch_value", 41), 42);
+    EXPECT_EQ(call("catch_multi", 5), 12);
+    EXPECT_EQ(call("catch_all", 0), 100);
+    EXPECT_EQ(call("catch_all", 5), 200);
+    EXPECT_EQ(call("no_throw", 5), 5);
+}
+
+TEST_F(fast_interp_exception_test, rethrow_and_delegate)
+{
+    EXPECT_EQ(call("rethrow", 5), 1005);
+    EXPECT_EQ(call("delegate", 5), 10);
+    EXPECT_EQ(call("delegate_outer", 5), 6);
+}
+
+TEST_F(fast_interp_exception_test, unwind_frames)
+{
+    int32_t result;
+
+    /* the frames of the callees are freed when the exception is caught */
+    EXPECT_EQ(call("loop_catch", 100000), 705082704);
+
+    EXPECT_FALSE(call("uncaught", 5, &result));
+    EXPECT_STREQ(wasm_runtime_get_exception(inst),
+                 "Exception: uncaught wasm exception");
+    wasm_runtime_clear_exception(inst);
+
+    /* the instance is still usable after the exception */
+    EXPECT_EQ(call("catch_value", 1), 2);
+}
+
+TEST_F(fast_interp_exception_test, delegate_after_catch)
+{
+    WAMRWasmBuffer buf(delegate_after_catch_wasm,
+                       sizeof(delegate_after_catch_wasm));
+    wasm_module_t invalid_module;
+
+    invalid_module = wasm_runtime_load(buf.data(), buf.size(), error_buf,
+                                       sizeof(error_buf));
+    EXPECT_EQ(invalid_module, nullptr);
+    if (invalid_module)
+        wasm_runtime_unload(invalid_module);
+}
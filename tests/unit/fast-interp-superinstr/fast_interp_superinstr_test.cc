@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (func (export "eqz") (param i32 i32) (result i32)
+ *     (block (result i32)
+ *       (br_if 0 (i32.const 1) (i32.eqz (local.get 0)))
+ *       (drop)
+ *       (i32.const 0)))
+ *   ;; "eq", "ne", "lt_s", "lt_u", "gt_s", "gt_u", "le_s", "le_u",
+ *   ;; "ge_s" and "ge_u" are the same as:
+ *   (func (export "eq") (param i32 i32) (result i32)
+ *     (block (result i32)
+ *       (br_if 0 (i32.const 1) (i32.eq (local.get 0) (local.get 1)))
+ *       (drop)
+ *       (i32.const 0)))
+ *   ...
+ *   (func (export "sum") (param i32 i32) (result i32)
+ *     (loop
+ *       (local.set 1 (i32.add (local.get 1) (local.get 0)))
+ *       (br_if 0 (i32.gt_s (local.tee 0 (i32.sub (local.get 0)
+ *                                                (i32.const 1)))
+ *                          (i32.const 0))))
+ *     (local.get 1)))
+ */
+static const uint8_t fused_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60,
+    0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x03, 0x0D, 0x0C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x4F, 0x0C, 0x03,
+    0x65, 0x71, 0x7A, 0x00, 0x00, 0x02, 0x65, 0x71, 0x00, 0x01, 0x02, 0x6E,
+    0x65, 0x00, 0x02, 0x04, 0x6C, 0x74, 0x5F, 0x73, 0x00, 0x03, 0x04, 0x6C,
+    0x74, 0x5F, 0x75, 0x00, 0x04, 0x04, 0x67, 0x74, 0x5F, 0x73, 0x00, 0x05,
+    0x04, 0x67, 0x74, 0x5F, 0x75, 0x00, 0x06, 0x04, 0x6C, 0x65, 0x5F, 0x73,
+    0x00, 0x07, 0x04, 0x6C, 0x65, 0x5F, 0x75, 0x00, 0x08, 0x04, 0x67, 0x65,
+    0x5F, 0x73, 0x00, 0x09, 0x04, 0x67, 0x65, 0x5F, 0x75, 0x00, 0x0A, 0x03,
+    0x73, 0x75, 0x6D, 0x00, 0x0B, 0x0A, 0xE0, 0x01, 0x0C, 0x0F, 0x00, 0x02,
+    0x7F, 0x41, 0x01, 0x20, 0x00, 0x45, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41, 0x01, 0x20, 0x00, 0x20, 0x01, 0x46,
+    0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B, 0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x47, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41, 0x01, 0x20, 0x00, 0x20, 0x01, 0x48,
+    0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B, 0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x49, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41, 0x01, 0x20, 0x00, 0x20, 0x01, 0x4A,
+    0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B, 0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x4B, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41, 0x01, 0x20, 0x00, 0x20, 0x01, 0x4C,
+    0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B, 0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x4D, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41, 0x01, 0x20, 0x00, 0x20, 0x01, 0x4E,
+    0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B, 0x0B, 0x11, 0x00, 0x02, 0x7F, 0x41,
+    0x01, 0x20, 0x00, 0x20, 0x01, 0x4F, 0x0D, 0x00, 0x1A, 0x41, 0x00, 0x0B,
+    0x0B, 0x1A, 0x00, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6A, 0x21, 0x01,
+    0x20, 0x00, 0x41, 0x01, 0x6B, 0x22, 0x00, 0x41, 0x00, 0x4A, 0x0D, 0x00,
+    0x0B, 0x20, 0x01, 0x0B
+};
+
+class fast_interp_superinstr_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(inst, 8192);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    int32_t call(const char *name, int32_t a, int32_t b)
+    {
+        uint32_t argv[2] = { (uint32_t)a, (uint32_t)b };
+
+        EXPECT_TRUE(call_wasm_func(exec_env, name, 2, argv))
+            << name << ": " << wasm_runtime_get_exception(inst);
+        return (int32_t)argv[0];
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ fused_wasm, sizeof(fused_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(fast_interp_superinstr_test, compare_and_br_if)
+{
+    const int32_t values[] = { INT32_MIN, -2, -1, 0, 1, 2, INT32_MAX };
+
+    for (int32_t a : values) {
+        uint32_t ua = (uint32_t)a;
+
+        EXPECT_EQ(call("eqz", a, 0), a == 0) << a;
+
+        for (int32_t b : values) {
+            uint32_t ub = (uint32_t)b;
+
+            EXPECT_EQ(call("eq", a, b), a == b) << a << ", " << b;
+            EXPECT_EQ(call("ne", a, b), a != b) << a << ", " << b;
+            EXPECT_EQ(call("lt_s", a, b), a < b) << a << ", " << b;
+            EXPECT_EQ(call("lt_u", a, b), ua < ub) << a << ", " << b;
+            EXPECT_EQ(call("gt_s", a, b), a > b) << a << ", " << b;
+            EXPECT_EQ(call("gt_u", a, b), ua > ub) << a << ", " << b;
+            EXPECT_EQ(call("le_s", a, b), a <= b) << a << ", " << b;
+            EXPECT_EQ(call("le_u", a, b), ua <= ub) << a << ", " << b;
+            EXPECT_EQ(call("ge_s", a, b), a >= b) << a << ", " << b;
+            EXPECT_EQ(call("ge_u", a, b), ua >= ub) << a << ", " << b;
+        }
+    }
+}
+
+TEST_F(fast_interp_superinstr_test, loop_with_const_operand)
+{
+    EXPECT_EQ(call("sum", 1, 0), 1);
+    EXPECT_EQ(call("sum", 100, 0), 5050);
+    EXPECT_EQ(call("sum", 100000, 7), 705082711);
+}
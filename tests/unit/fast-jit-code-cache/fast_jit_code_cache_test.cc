@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include <list>
+
+#include "bh_platform.h"
+#include "wasm_export.h"
+#include "jit_codecache.h"
+
+#define CHUNK_SIZE (64 * 1024)
+
+/* (module (func (export "f") (param i32) (result i32)
+     local.get 0 i32.const 1 i32.add)) */
+static uint8 wasm_add_one[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01,
+    0x60, 0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x05,
+    0x01, 0x01, 0x66, 0x00, 0x00, 0x0a, 0x09, 0x01, 0x07, 0x00, 0x20,
+    0x00, 0x41, 0x01, 0x6a, 0x0b,
+};
+
+class fast_jit_code_cache_test : public testing::Test
+{
+  protected:
+    virtual void TearDown()
+    {
+        if (is_inited)
+            wasm_runtime_destroy();
+    }
+
+    bool init_runtime(uint32 code_cache_size, uint32 code_cache_max_size)
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.running_mode = Mode_Fast_JIT;
+        init_args.fast_jit_code_cache_size = code_cache_size;
+        init_args.fast_jit_code_cache_max_size = code_cache_max_size;
+
+        return (is_inited = wasm_runtime_full_init(&init_args));
+    }
+
+    fast_jit_code_cache_stats_t get_stats()
+    {
+        fast_jit_code_cache_stats_t stats;
+
+        EXPECT_TRUE(wasm_runtime_get_fast_jit_code_cache_stats(&stats));
+        return stats;
+    }
+
+    wasm_module_t load_module()
+    {
+        /* The loader may modify the buffer */
+        bufs.emplace_back(wasm_add_one, sizeof(wasm_add_one));
+        return wasm_runtime_load(bufs.back().data(), bufs.back().size(),
+                                 error_buf, sizeof(error_buf));
+    }
+
+    /* With lazy jit the function is compiled when it is called */
+    bool call_add_one(wasm_module_t module, wasm_module_inst_t *p_inst)
+    {
+        uint32 argv[1] = { 41 };
+
+        *p_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                           sizeof(error_buf));
+        return *p_inst && call_wasm_func(*p_inst, "f", 1, argv)
+               && argv[0] == 42;
+    }
+
+    bool is_inited = false;
+    std::list<WAMRWasmBuffer> bufs;
+    char error_buf[128];
+};
+
+TEST_F(fast_jit_code_cache_test, default_max_size)
+{
+    fast_jit_code_cache_stats_t stats;
+
+    ASSERT_TRUE(init_runtime(CHUNK_SIZE * 4, 0));
+
+    /* The code cache doesn't grow beyond the code cache size by default */
+    stats = get_stats();
+    EXPECT_EQ(stats.max_size, CHUNK_SIZE * 4);
+    EXPECT_EQ(stats.chunk_count, 1u);
+    EXPECT_EQ(stats.module_chunk_count, 0u);
+    EXPECT_LE(stats.total_size, stats.max_size);
+    EXPECT_GT(stats.used_size, 0u);
+}
+
+TEST_F(fast_jit_code_cache_test, grow)
+{
+    int owner;
+    std::vector<void *> codes;
+    fast_jit_code_cache_stats_t stats;
+    uint64 shared_size;
+    void *code;
+
+    ASSERT_TRUE(init_runtime(CHUNK_SIZE * 2, CHUNK_SIZE * 8));
+    shared_size = get_stats().total_size;
+
+    /* Fill the code cache until it reaches the max size */
+    while ((code = jit_code_cache_alloc_for_module(&owner, 4096)))
+        codes.push_back(code);
+
+    stats = get_stats();
+    EXPECT_GT(stats.module_chunk_count, 2u);
+    EXPECT_EQ(stats.chunk_count, stats.module_chunk_count + 1);
+    EXPECT_LE(stats.total_size, stats.max_size);
+    EXPECT_GT(stats.total_size, stats.max_size - CHUNK_SIZE);
+    EXPECT_GT(codes.size() * 4096, (stats.max_size - shared_size) / 2);
+
+    /* The chunks are released after the code is freed */
+    for (void *p : codes)
+        jit_code_cache_free(p);
+    stats = get_stats();
+    EXPECT_EQ(stats.module_chunk_count, 0u);
+    EXPECT_EQ(stats.chunk_count, 1u);
+    EXPECT_EQ(stats.total_size, shared_size);
+
+    /* A code larger than the chunk size gets its own chunk */
+    code = jit_code_cache_alloc_for_module(&owner, CHUNK_SIZE * 3);
+    ASSERT_TRUE(code != NULL);
+    stats = get_stats();
+    EXPECT_EQ(stats.module_chunk_count, 1u);
+    EXPECT_GT(stats.total_size, shared_size + CHUNK_SIZE * 3);
+    jit_code_cache_free(code);
+
+    /* But not if it exceeds the max size */
+    EXPECT_TRUE(jit_code_cache_alloc_for_module(&owner, CHUNK_SIZE * 8)
+                == NULL);
+    EXPECT_EQ(get_stats().total_size, shared_size);
+}
+
+TEST_F(fast_jit_code_cache_test, owners)
+{
+    int owner1, owner2;
+    fast_jit_code_cache_stats_t stats;
+    void *code1, *code2;
+
+    ASSERT_TRUE(init_runtime(CHUNK_SIZE, CHUNK_SIZE * 4));
+
+    code1 = jit_code_cache_alloc_for_module(&owner1, 64);
+    code2 = jit_code_cache_alloc_for_module(&owner2, 64);
+    ASSERT_TRUE(code1 != NULL);
+    ASSERT_TRUE(code2 != NULL);
+    EXPECT_EQ(get_stats().module_chunk_count, 2u);
+
+    /* The code of another module doesn't pin the chunk */
+    jit_code_cache_free(code1);
+    stats = get_stats();
+    EXPECT_EQ(stats.module_chunk_count, 1u);
+    EXPECT_EQ(stats.chunk_count, 2u);
+
+    jit_code_cache_free(code2);
+    EXPECT_EQ(get_stats().module_chunk_count, 0u);
+}
+
+TEST_F(fast_jit_code_cache_test, dual_mapping)
+{
+    int owner;
+    /* mov eax, 42; ret */
+    uint8 ret_42[] = { 0xb8, 0x2a, 0x00, 0x00, 0x00, 0xc3 };
+    uint8 *code, *writable;
+
+    ASSERT_TRUE(init_runtime(CHUNK_SIZE * 4, 0));
+
+    code = (uint8 *)jit_code_cache_alloc_for_module(&owner, sizeof(ret_42));
+    ASSERT_TRUE(code != NULL);
+    writable = (uint8 *)jit_code_cache_get_writable_addr(code);
+    ASSERT_TRUE(writable != NULL);
+#ifdef OS_ENABLE_MEMFD
+    /* No page is both writable and executable */
+    EXPECT_NE(writable, code);
+#endif
+    EXPECT_EQ((uint8 *)jit_code_cache_get_writable_addr(code + 4),
+              writable + 4);
+
+    /* The code written through the writable mapping is run through the
+       executable mapping */
+    jit_code_cache_write(code, ret_42, sizeof(ret_42));
+    EXPECT_EQ(memcmp(code, ret_42, sizeof(ret_42)), 0);
+#if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64)
+    EXPECT_EQ(((int (*)(void))code)(), 42);
+#endif
+
+    jit_code_cache_free(code);
+}
+
+TEST_F(fast_jit_code_cache_test, unload)
+{
+    wasm_module_t module1, module2;
+    wasm_module_inst_t module_inst1, module_inst2;
+    fast_jit_code_cache_stats_t stats;
+    uint64 shared_size, used_size;
+
+    ASSERT_TRUE(init_runtime(CHUNK_SIZE, CHUNK_SIZE * 4));
+    stats = get_stats();
+    shared_size = stats.total_size;
+    used_size = stats.used_size;
+
+    /* The jitted code of a module is in its own chunk */
+    module1 = load_module();
+    ASSERT_TRUE(module1 != NULL) << error_buf;
+    module2 = load_module();
+    ASSERT_TRUE(module2 != NULL) << error_buf;
+    ASSERT_TRUE(call_add_one(module1, &module_inst1)) << error_buf;
+    ASSERT_TRUE(call_add_one(module2, &module_inst2)) << error_buf;
+    stats = get_stats();
+    EXPECT_EQ(stats.module_chunk_count, 2u);
+    EXPECT_GT(stats.used_size, used_size);
+    wasm_runtime_deinstantiate(module_inst1);
+    wasm_runtime_deinstantiate(module_inst2);
+
+    /* The chunks of a module are released when it is unloaded */
+    wasm_runtime_unload(module1);
+    EXPECT_EQ(get_stats().module_chunk_count, 1u);
+    wasm_runtime_unload(module2);
+    stats = get_stats();
+    EXPECT_EQ(stats.module_chunk_count, 0u);
+    EXPECT_EQ(stats.total_size, shared_size);
+    EXPECT_EQ(stats.used_size, used_size);
+}
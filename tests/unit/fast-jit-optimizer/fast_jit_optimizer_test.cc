@@ -0,0 +1,612 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "bh_platform.h"
+#include "wasm_export.h"
+#include "jit_ir.h"
+#include "jit_utils.h"
+#include "jit_compiler.h"
+
+/* Number of the values computed twice by the function of
+   wasm_pressure, which are all alive after redundancy elimination */
+#define PRESSURE_VALUE_NUM 60
+
+/* The spill area of wasm_pressure's function: 2 locals, 3 stack cells
+   and the 16 pointers reserved by the frontend */
+#define PRESSURE_SPILL_CACHE_SIZE ((2 + 3) * 4 + sizeof(void *) * 16)
+
+/**
+ * (module
+ *   (func (export "f") (param i32) (result i32) (local i32)
+ *     ;; for k in 1 .. PRESSURE_VALUE_NUM
+ *     local.get 1 local.get 0 i32.const k i32.add i32.xor local.set 1
+ *     ;; for k in 1 .. PRESSURE_VALUE_NUM
+ *     local.get 1 local.get 0 i32.const k i32.add i32.add local.set 1
+ *     local.get 1))
+ */
+static std::vector<uint8> wasm_pressure()
+{
+    std::vector<uint8> body = { 0x01, 0x01, 0x7f };
+    std::vector<uint8> wasm = {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, /* header */
+        0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f, /* type */
+        0x03, 0x02, 0x01, 0x00,                         /* function */
+        0x07, 0x05, 0x01, 0x01, 0x66, 0x00, 0x00,       /* export */
+    };
+    uint32 size;
+
+    for (uint8 op : { 0x73 /* i32.xor */, 0x6a /* i32.add */ }) {
+        for (uint8 k = 1; k <= PRESSURE_VALUE_NUM; k++) {
+            body.insert(body.end(), { 0x20, 0x01, 0x20, 0x00, 0x41, k, 0x6a,
+                                      op, 0x21, 0x01 });
+        }
+    }
+    body.insert(body.end(), { 0x20, 0x01, 0x0b });
+
+    /* The sizes are encoded in two LEB128 bytes */
+    size = (uint32)body.size();
+    wasm.insert(wasm.end(),
+                { 0x0a, (uint8)(((size + 3) & 0x7f) | 0x80),
+                  (uint8)((size + 3) >> 7), 0x01, (uint8)((size & 0x7f) | 0x80),
+                  (uint8)(size >> 7) });
+    wasm.insert(wasm.end(), body.begin(), body.end());
+    return wasm;
+}
+
+static uint32
+pressure_result(uint32 x)
+{
+    uint32 t = 0, k;
+
+    for (k = 1; k <= PRESSURE_VALUE_NUM; k++)
+        t ^= x + k;
+    for (k = 1; k <= PRESSURE_VALUE_NUM; k++)
+        t += x + k;
+    return t;
+}
+
+static void
+native_func()
+{}
+
+/**
+ * The tests generate the IR of a block and run the optimization passes
+ * of the opt level (the parameter) on it.
+ */
+class fast_jit_optimizer_test : public testing::TestWithParam<uint32>
+{
+  protected:
+    virtual void SetUp()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.running_mode = Mode_Fast_JIT;
+        init_args.fast_jit_opt_level = GetParam();
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        memset(&module, 0, sizeof(WASMModule));
+        module.memory_count = 1;
+
+        ASSERT_TRUE((cc = (JitCompContext *)jit_calloc(sizeof(*cc))));
+        ASSERT_TRUE(jit_cc_init(cc, 64));
+        cc->cur_wasm_module = &module;
+        ASSERT_TRUE(
+            (cc->memory_regs = (JitMemRegs *)jit_calloc(sizeof(JitMemRegs))));
+        cc->memory_regs[0].mem_bound_check_4bytes = jit_cc_new_reg_I64(cc);
+        cc->memory_regs[0].mem_bound_check_8bytes = jit_cc_new_reg_I64(cc);
+
+        ASSERT_TRUE((exce_block = jit_cc_new_basic_block(cc, 0)));
+        ASSERT_TRUE((cc->cur_basic_block = jit_cc_new_basic_block(cc, 0)));
+    }
+
+    virtual void TearDown()
+    {
+        if (cc)
+            jit_cc_delete(cc);
+        wasm_runtime_destroy();
+    }
+
+    /* Run the optional optimization passes of the opt level */
+    bool run_opt_passes()
+    {
+        const uint8 *p = jit_compiler_get_jit_globals()->passes;
+        const char *name;
+        bool ret;
+
+        for (; *p; p++) {
+            name = jit_compiler_get_pass_name(*p);
+            if (!strcmp(name, "propagate"))
+                ret = jit_pass_propagate(cc);
+            else if (!strcmp(name, "redundancy_elim"))
+                ret = jit_pass_redundancy_elim(cc);
+            else if (!strcmp(name, "dce"))
+                ret = jit_pass_dce(cc);
+            else
+                continue;
+
+            if (!ret || jit_get_last_error(cc))
+                return false;
+        }
+        return true;
+    }
+
+    uint32 count_insns(uint16 opcode)
+    {
+        JitInsn *insn;
+        uint32 count = 0;
+
+        JIT_FOREACH_INSN(cc->cur_basic_block, insn)
+        {
+            if (insn->opcode == opcode)
+                count++;
+        }
+        return count;
+    }
+
+    /* A value unknown to the passes */
+    JitReg gen_unknown(unsigned kind)
+    {
+        JitReg reg = jit_cc_new_reg(cc, kind);
+
+        if (kind == JIT_REG_KIND_I32)
+            GEN_INSN(LDI32, reg, cc->exec_env_reg, NEW_CONST(I32, 0));
+        else
+            GEN_INSN(LDI64, reg, cc->exec_env_reg, NEW_CONST(I32, 0));
+        return reg;
+    }
+
+    /* Keep the value alive by storing it to the frame */
+    JitInsn *keep(JitReg value)
+    {
+        JitReg offset = NEW_CONST(I32, (int32)(kept_num++ * 8));
+
+        if (jit_reg_is_kind(I64, value))
+            return GEN_INSN(STI64, value, cc->fp_reg, offset);
+        return GEN_INSN(STI32, value, cc->fp_reg, offset);
+    }
+
+    /* Compute op(a, b) of two registers holding the constants */
+    JitInsn *gen_binary(uint16 opcode, JitReg const_a, JitReg const_b)
+    {
+        unsigned kind = jit_reg_kind(const_a);
+        JitReg a = jit_cc_new_reg(cc, kind), b = jit_cc_new_reg(cc, kind);
+        JitReg dst = jit_cc_new_reg(cc, kind);
+        JitInsn *insn;
+
+        GEN_INSN(MOV, a, const_a);
+        GEN_INSN(MOV, b, const_b);
+        /* All the binary ALU insns have the same operands */
+        insn = GEN_INSN(ADD, dst, a, b);
+        insn->opcode = opcode;
+        return keep(dst);
+    }
+
+    /* Compute op(a) of a register holding the constant */
+    JitInsn *gen_unary(uint16 opcode, unsigned dst_kind, JitReg const_a)
+    {
+        JitReg a = jit_cc_new_reg(cc, jit_reg_kind(const_a));
+        JitReg dst = jit_cc_new_reg(cc, dst_kind);
+        JitInsn *insn;
+
+        GEN_INSN(MOV, a, const_a);
+        insn = GEN_INSN(NEG, dst, a);
+        insn->opcode = opcode;
+        return keep(dst);
+    }
+
+    /* The stored value is folded into the constant if the opt level
+       enables the propagation */
+    void expect_folded(JitInsn *store, int64 expected)
+    {
+        JitReg value = *jit_insn_opnd(store, 0);
+
+        if (GetParam() == 0) {
+            EXPECT_FALSE(jit_reg_is_const(value));
+            return;
+        }
+
+        ASSERT_TRUE(jit_reg_is_const(value));
+        if (jit_reg_is_kind(I32, value))
+            EXPECT_EQ(jit_cc_get_const_I32(cc, value), (int32)expected);
+        else
+            EXPECT_EQ(jit_cc_get_const_I64(cc, value), expected);
+    }
+
+    /* CMP and BGTU of a linear memory bounds check */
+    void gen_bounds_check(JitReg addr, JitReg bound)
+    {
+        GEN_INSN(CMP, cc->cmp_reg, addr, bound);
+        GEN_INSN(BGTU, cc->cmp_reg, jit_basic_block_label(exce_block), 0);
+    }
+
+    /* The bound registers are reloaded after memory.grow */
+    void gen_memory_grow()
+    {
+        JitMemRegs *mem_regs = cc->memory_regs;
+
+        GEN_INSN(CALLNATIVE, 0, NEW_CONST(PTR, (uintptr_t)native_func), 0);
+        GEN_INSN(LDI64, mem_regs->mem_bound_check_4bytes, cc->exec_env_reg,
+                 NEW_CONST(I32, 8));
+        GEN_INSN(LDI64, mem_regs->mem_bound_check_8bytes, cc->exec_env_reg,
+                 NEW_CONST(I32, 16));
+    }
+
+    WASMModule module;
+    JitCompContext *cc = NULL;
+    JitBasicBlock *exce_block = NULL;
+    uint32 kept_num = 0;
+};
+
+TEST_P(fast_jit_optimizer_test, fold_shift_rotate)
+{
+    JitInsn *stores[10], *shl_x_32, *shl_x_31;
+    JitReg x = gen_unknown(JIT_REG_KIND_I32), dst;
+
+    /* The shift count is masked by the bit width */
+    stores[0] = gen_binary(JIT_OP_SHL, NEW_CONST(I32, 1), NEW_CONST(I32, 33));
+    stores[1] = gen_binary(JIT_OP_SHRS, NEW_CONST(I32, INT32_MIN),
+                           NEW_CONST(I32, 63));
+    stores[2] = gen_binary(JIT_OP_SHRU, NEW_CONST(I32, INT32_MIN),
+                           NEW_CONST(I32, 32));
+    stores[3] = gen_binary(JIT_OP_ROTL, NEW_CONST(I32, (int32)0x80000001),
+                           NEW_CONST(I32, 33));
+    stores[4] = gen_binary(JIT_OP_ROTR, NEW_CONST(I32, 1), NEW_CONST(I32, 32));
+    stores[5] = gen_binary(JIT_OP_ROTR, NEW_CONST(I32, 3), NEW_CONST(I32, 1));
+    stores[6] = gen_binary(JIT_OP_SHL, NEW_CONST(I64, 1), NEW_CONST(I64, 65));
+    stores[7] = gen_binary(JIT_OP_SHRS, NEW_CONST(I64, INT64_MIN),
+                           NEW_CONST(I64, 127));
+    stores[8] = gen_binary(JIT_OP_ROTR, NEW_CONST(I64, 1), NEW_CONST(I64, 65));
+    stores[9] = gen_binary(JIT_OP_ROTL, NEW_CONST(I64, INT64_MIN),
+                           NEW_CONST(I64, 64));
+
+    /* x << 32 is x, but x << 31 isn't */
+    dst = jit_cc_new_reg_I32(cc);
+    GEN_INSN(SHL, dst, x, NEW_CONST(I32, 32));
+    shl_x_32 = keep(dst);
+    dst = jit_cc_new_reg_I32(cc);
+    GEN_INSN(SHL, dst, x, NEW_CONST(I32, 31));
+    shl_x_31 = keep(dst);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    expect_folded(stores[0], 2);
+    expect_folded(stores[1], -1);
+    expect_folded(stores[2], INT32_MIN);
+    expect_folded(stores[3], 3);
+    expect_folded(stores[4], 1);
+    expect_folded(stores[5], (int32)0x80000001);
+    expect_folded(stores[6], 2);
+    expect_folded(stores[7], -1);
+    expect_folded(stores[8], INT64_MIN);
+    expect_folded(stores[9], INT64_MIN);
+
+    EXPECT_EQ(*jit_insn_opnd(shl_x_32, 0) == x, GetParam() > 0);
+    EXPECT_NE(*jit_insn_opnd(shl_x_31, 0), x);
+    EXPECT_EQ(count_insns(JIT_OP_SHL), GetParam() > 0 ? 1u : 4u);
+}
+
+TEST_P(fast_jit_optimizer_test, fold_wraparound)
+{
+    JitInsn *stores[7];
+
+    /* The I32 results wrap around at 32 bits */
+    stores[0] = gen_binary(JIT_OP_ADD, NEW_CONST(I32, INT32_MAX),
+                           NEW_CONST(I32, 1));
+    stores[1] = gen_binary(JIT_OP_MUL, NEW_CONST(I32, 0x10000),
+                           NEW_CONST(I32, 0x10000));
+    stores[2] = gen_binary(JIT_OP_SUB, NEW_CONST(I32, 0), NEW_CONST(I32, 1));
+    stores[3] = gen_binary(JIT_OP_MUL, NEW_CONST(I32, INT32_MAX),
+                           NEW_CONST(I32, 2));
+    stores[4] = gen_unary(JIT_OP_NEG, JIT_REG_KIND_I32,
+                          NEW_CONST(I32, INT32_MIN));
+    stores[5] = gen_unary(JIT_OP_I64TOI32, JIT_REG_KIND_I32,
+                          NEW_CONST(I64, 0x100000005LL));
+    stores[6] = gen_binary(JIT_OP_ADD, NEW_CONST(I64, INT64_MAX),
+                           NEW_CONST(I64, 1));
+
+    ASSERT_TRUE(run_opt_passes());
+
+    expect_folded(stores[0], INT32_MIN);
+    expect_folded(stores[1], 0);
+    expect_folded(stores[2], -1);
+    expect_folded(stores[3], -2);
+    expect_folded(stores[4], INT32_MIN);
+    expect_folded(stores[5], 5);
+    expect_folded(stores[6], INT64_MIN);
+}
+
+TEST_P(fast_jit_optimizer_test, fold_sign_extension)
+{
+    JitInsn *stores[9];
+
+    /* Only the low bits are extended */
+    stores[0] = gen_unary(JIT_OP_I8TOI32, JIT_REG_KIND_I32,
+                          NEW_CONST(I32, 0x80));
+    stores[1] = gen_unary(JIT_OP_I8TOI32, JIT_REG_KIND_I32,
+                          NEW_CONST(I32, 0x17f));
+    stores[2] = gen_unary(JIT_OP_I16TOI32, JIT_REG_KIND_I32,
+                          NEW_CONST(I32, 0x8000));
+    stores[3] = gen_unary(JIT_OP_I16TOI32, JIT_REG_KIND_I32,
+                          NEW_CONST(I32, 0x17fff));
+    stores[4] = gen_unary(JIT_OP_I8TOI64, JIT_REG_KIND_I64,
+                          NEW_CONST(I32, 0xff));
+    stores[5] = gen_unary(JIT_OP_I16TOI64, JIT_REG_KIND_I64,
+                          NEW_CONST(I32, 0x7fff));
+    stores[6] = gen_unary(JIT_OP_I16TOI64, JIT_REG_KIND_I64,
+                          NEW_CONST(I32, 0xffff8000));
+    stores[7] = gen_unary(JIT_OP_I32TOI64, JIT_REG_KIND_I64,
+                          NEW_CONST(I32, -1));
+    stores[8] = gen_unary(JIT_OP_U32TOI64, JIT_REG_KIND_I64,
+                          NEW_CONST(I32, -1));
+
+    ASSERT_TRUE(run_opt_passes());
+
+    expect_folded(stores[0], -128);
+    expect_folded(stores[1], 127);
+    expect_folded(stores[2], -32768);
+    expect_folded(stores[3], 32767);
+    expect_folded(stores[4], -1);
+    expect_folded(stores[5], 32767);
+    expect_folded(stores[6], -32768);
+    expect_folded(stores[7], -1);
+    expect_folded(stores[8], 0xffffffffLL);
+}
+
+TEST_P(fast_jit_optimizer_test, keep_relocated_const)
+{
+    JitReg rel = jit_cc_new_const_I32_rel(cc, 8, 1);
+    JitReg a = jit_cc_new_reg_I32(cc), dst = jit_cc_new_reg_I32(cc);
+    JitInsn *store_a, *store_dst;
+
+    /* The relocated constant is patched at runtime, it is neither
+       folded nor propagated */
+    GEN_INSN(MOV, a, rel);
+    GEN_INSN(ADD, dst, a, NEW_CONST(I32, 4));
+    store_a = keep(a);
+    store_dst = keep(dst);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    EXPECT_EQ(*jit_insn_opnd(store_a, 0), a);
+    EXPECT_EQ(*jit_insn_opnd(store_dst, 0), dst);
+    EXPECT_EQ(count_insns(JIT_OP_ADD), 1u);
+    EXPECT_EQ(count_insns(JIT_OP_MOV), 1u);
+}
+
+TEST_P(fast_jit_optimizer_test, dce)
+{
+    JitReg x = gen_unknown(JIT_REG_KIND_I32);
+    JitReg dead = jit_cc_new_reg_I32(cc), live = jit_cc_new_reg_I32(cc);
+
+    GEN_INSN(ADD, dead, x, NEW_CONST(I32, 1));
+    GEN_INSN(SUB, live, x, NEW_CONST(I32, 1));
+    keep(live);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    EXPECT_EQ(count_insns(JIT_OP_ADD), GetParam() > 0 ? 0u : 1u);
+    EXPECT_EQ(count_insns(JIT_OP_SUB), 1u);
+}
+
+TEST_P(fast_jit_optimizer_test, forward_store_to_load)
+{
+    JitReg base = gen_unknown(JIT_REG_KIND_I64);
+    JitReg v = gen_unknown(JIT_REG_KIND_I32), r = jit_cc_new_reg_I32(cc);
+    JitInsn *store;
+
+    GEN_INSN(STI32, v, base, NEW_CONST(I32, 8));
+    GEN_INSN(LDI32, r, base, NEW_CONST(I32, 8));
+    store = keep(r);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    /* The load of the stored address gets the stored value */
+    if (GetParam() == 2) {
+        EXPECT_EQ(*jit_insn_opnd(store, 0), v);
+        EXPECT_EQ(count_insns(JIT_OP_LDI32), 1u);
+    }
+    else {
+        EXPECT_EQ(*jit_insn_opnd(store, 0), r);
+        EXPECT_EQ(count_insns(JIT_OP_LDI32), 2u);
+    }
+}
+
+TEST_P(fast_jit_optimizer_test, no_forward_low_half)
+{
+    JitReg base = gen_unknown(JIT_REG_KIND_I64);
+    JitReg v = gen_unknown(JIT_REG_KIND_I64), r = jit_cc_new_reg_I64(cc);
+    JitInsn *store;
+
+    /* i64.store32 and i64.load32_s of the same address, the loaded
+       value is the sign extended low half, not the stored register */
+    GEN_INSN(STI32, v, base, NEW_CONST(I32, 8));
+    GEN_INSN(LDI32, r, base, NEW_CONST(I32, 8));
+    store = keep(r);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    EXPECT_EQ(*jit_insn_opnd(store, 0), r);
+    EXPECT_EQ(count_insns(JIT_OP_LDI32), 1u);
+}
+
+TEST_P(fast_jit_optimizer_test, narrow_store_of_i64_const)
+{
+    JitReg base = gen_unknown(JIT_REG_KIND_I64), v = jit_cc_new_reg_I64(cc);
+    JitInsn *stores[3];
+
+    /* The narrow stores of a known I64 register take an I32 constant,
+       which is what the code generator accepts */
+    GEN_INSN(MOV, v, NEW_CONST(I64, 0x1ffff8081LL));
+    stores[0] = GEN_INSN(STI8, v, base, NEW_CONST(I32, 0));
+    stores[1] = GEN_INSN(STI16, v, base, NEW_CONST(I32, 2));
+    stores[2] = GEN_INSN(STI32, v, base, NEW_CONST(I32, 4));
+
+    ASSERT_TRUE(run_opt_passes());
+
+    for (JitInsn *store : stores) {
+        expect_folded(store, (int32)0xffff8081);
+        if (jit_reg_is_const(*jit_insn_opnd(store, 0)))
+            EXPECT_TRUE(jit_reg_is_kind(I32, *jit_insn_opnd(store, 0)));
+    }
+}
+
+TEST_P(fast_jit_optimizer_test, no_forward_across_memory_writes)
+{
+    JitReg base = gen_unknown(JIT_REG_KIND_I64);
+    JitReg base2 = gen_unknown(JIT_REG_KIND_I64);
+    JitReg v = gen_unknown(JIT_REG_KIND_I32);
+    JitReg r, t;
+    JitInsn *insn;
+    uint32 load_num = 1, i;
+
+    for (i = 0; i < (WASM_ENABLE_SHARED_MEMORY != 0 ? 5 : 4); i++) {
+        GEN_INSN(STI32, v, base, NEW_CONST(I32, 8));
+
+        switch (i) {
+            case 0:
+                /* A call may write the memory */
+                GEN_INSN(CALLNATIVE, 0,
+                         NEW_CONST(PTR, (uintptr_t)native_func), 0);
+                break;
+            case 1:
+                /* The store may write the same address */
+                GEN_INSN(STI32, v, base2, NEW_CONST(I32, 0));
+                break;
+            case 2:
+                /* An atomic load orders the accesses after it */
+                t = jit_cc_new_reg_I32(cc);
+                insn = GEN_INSN(LDI32, t, base2, NEW_CONST(I32, 0));
+                insn->flags_u8 |= 0x1;
+                keep(t);
+                load_num++;
+                break;
+            case 3:
+                /* An atomic store isn't forwarded */
+                insn = GEN_INSN(STI32, v, base, NEW_CONST(I32, 8));
+                insn->flags_u8 |= 0x1;
+                break;
+#if WASM_ENABLE_SHARED_MEMORY != 0
+            case 4:
+                /* An atomic read-modify-write writes the memory, and so
+                   does a fence */
+                t = jit_cc_new_reg_I32(cc);
+                GEN_INSN(AT_ADDU32, t, v, base, NEW_CONST(I32, 8));
+                keep(t);
+                GEN_INSN(STI32, v, base, NEW_CONST(I32, 8));
+                GEN_INSN(FENCE);
+                break;
+#endif
+        }
+
+        r = jit_cc_new_reg_I32(cc);
+        GEN_INSN(LDI32, r, base, NEW_CONST(I32, 8));
+        keep(r);
+        load_num++;
+    }
+
+    ASSERT_TRUE(run_opt_passes());
+
+    /* No load is removed */
+    EXPECT_EQ(count_insns(JIT_OP_LDI32), load_num);
+}
+
+TEST_P(fast_jit_optimizer_test, bounds_check_across_memory_grow)
+{
+    JitMemRegs *mem_regs = cc->memory_regs;
+    JitReg addr = gen_unknown(JIT_REG_KIND_I64);
+    JitReg addr_4 = jit_cc_new_reg_I64(cc);
+
+    gen_bounds_check(addr, mem_regs->mem_bound_check_4bytes);
+    gen_memory_grow();
+
+    /* The linear memory never shrinks, the same check after
+       memory.grow is removed */
+    gen_bounds_check(addr, mem_regs->mem_bound_check_4bytes);
+
+    /* The check of the bytes beyond isn't */
+    GEN_INSN(ADD, addr_4, addr, NEW_CONST(I64, 4));
+    gen_bounds_check(addr_4, mem_regs->mem_bound_check_4bytes);
+
+    /* Which covers the 8 bytes at addr */
+    gen_memory_grow();
+    gen_bounds_check(addr, mem_regs->mem_bound_check_8bytes);
+
+    /* The check of a redefined address isn't removed */
+    GEN_INSN(LDI64, addr, cc->exec_env_reg, NEW_CONST(I32, 0));
+    gen_bounds_check(addr, mem_regs->mem_bound_check_4bytes);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    EXPECT_EQ(count_insns(JIT_OP_BGTU), GetParam() == 2 ? 3u : 5u);
+    EXPECT_EQ(count_insns(JIT_OP_CMP), count_insns(JIT_OP_BGTU));
+}
+
+TEST_P(fast_jit_optimizer_test, regalloc_spill_area)
+{
+    JitReg x = gen_unknown(JIT_REG_KIND_I32), t, v;
+    uint32 k;
+
+    /* The IR of wasm_pressure's function, the values computed again
+       are all alive after redundancy elimination */
+    t = gen_unknown(JIT_REG_KIND_I32);
+    for (k = 1; k <= PRESSURE_VALUE_NUM * 2; k++) {
+        v = jit_cc_new_reg_I32(cc);
+        GEN_INSN(ADD, v, x,
+                 NEW_CONST(I32, (int32)((k - 1) % PRESSURE_VALUE_NUM + 1)));
+        if (k <= PRESSURE_VALUE_NUM)
+            GEN_INSN(XOR, t, t, v);
+        else
+            GEN_INSN(ADD, t, t, v);
+    }
+    keep(t);
+
+    ASSERT_TRUE(run_opt_passes());
+
+    /* The spill area of the frame is too small at level 2, where the
+       compiler compiles the function again without the optimization */
+    cc->spill_cache_offset = 64;
+    cc->spill_cache_size = PRESSURE_SPILL_CACHE_SIZE;
+    EXPECT_EQ(jit_pass_regalloc(cc), GetParam() != 2);
+    EXPECT_TRUE(jit_get_last_error(cc) == NULL);
+}
+
+TEST_P(fast_jit_optimizer_test, regalloc_retry)
+{
+    std::vector<uint8> wasm = wasm_pressure();
+    wasm_module_t module;
+    wasm_module_inst_t module_inst;
+    wasm_exec_env_t exec_env;
+    char error_buf[128];
+    uint32 xs[] = { 0, 1, 0x7fffffff, 0xffffffc0, 0x12345678 };
+    uint32 argv[1], i;
+
+    /* The function is compiled at every opt level */
+    module = wasm_runtime_load(wasm.data(), (uint32)wasm.size(), error_buf,
+                               sizeof(error_buf));
+    ASSERT_TRUE(module != NULL) << error_buf;
+    module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                           sizeof(error_buf));
+    ASSERT_TRUE(module_inst != NULL) << error_buf;
+    exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+    ASSERT_TRUE(exec_env != NULL);
+
+    for (i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        argv[0] = xs[i];
+        ASSERT_TRUE(call_wasm_func(exec_env, "f", 1, argv));
+        EXPECT_EQ(argv[0], pressure_result(xs[i]));
+    }
+
+    wasm_runtime_destroy_exec_env(exec_env);
+    wasm_runtime_deinstantiate(module_inst);
+    wasm_runtime_unload(module);
+}
+
+INSTANTIATE_TEST_CASE_P(OptLevel, fast_jit_optimizer_test,
+                        testing::Values(0, 1, 2));
@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "bh_platform.h"
+#include "wasm_export.h"
+#include "jit_codegen.h"
+
+#include <cmath>
+#include <vector>
+
+/* The vectors are passed to the op at 0 and 16 of the memory and the
+   result is stored at 32 */
+#define A_OFFSET 0
+#define B_OFFSET 16
+#define RESULT_OFFSET 32
+
+#define SKIP_IF_SIMD_UNSUPPORTED()                   \
+    do {                                             \
+        if (!jit_codegen_is_simd_supported())        \
+            GTEST_SKIP() << "SSE4.2 is unsupported"; \
+    } while (0)
+
+typedef union {
+    int8 i8[16];
+    uint8 u8[16];
+    int16 i16[8];
+    uint16 u16[8];
+    int32 i32[4];
+    uint32 u32[4];
+    float32 f32[4];
+    float64 f64[2];
+} v128;
+
+static void
+emit_leb(std::vector<uint8> &buf, uint32 v)
+{
+    do {
+        buf.push_back((uint8)((v & 0x7f) | (v > 0x7f ? 0x80 : 0)));
+        v >>= 7;
+    } while (v);
+}
+
+/* SIMD instruction with the sub-opcode */
+static std::vector<uint8>
+simd_op(uint32 opcode)
+{
+    std::vector<uint8> buf = { 0xfd };
+
+    emit_leb(buf, opcode);
+    return buf;
+}
+
+/* i32.const v, v is in [-64, 63] */
+static std::vector<uint8>
+i32_const(int8 v)
+{
+    return { 0x41, (uint8)(v & 0x7f) };
+}
+
+/* i32.const 0 v128.load offset=offset */
+static std::vector<uint8>
+v128_load(uint8 offset)
+{
+    return { 0x41, 0x00, 0xfd, 0x00, 0x04, offset };
+}
+
+/* v128.store offset=0 */
+static const std::vector<uint8> v128_store = { 0xfd, 0x0b, 0x04, 0x00 };
+
+static std::vector<uint8>
+concat(std::initializer_list<std::vector<uint8>> parts)
+{
+    std::vector<uint8> buf;
+
+    for (const std::vector<uint8> &part : parts)
+        buf.insert(buf.end(), part.begin(), part.end());
+    return buf;
+}
+
+/**
+ * (module (memory 1) (func (export "f") body))
+ */
+static std::vector<uint8>
+build_module(const std::vector<uint8> &body)
+{
+    std::vector<uint8> wasm = {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, /* header */
+        0x01, 0x04, 0x01, 0x60, 0x00, 0x00,             /* type */
+        0x03, 0x02, 0x01, 0x00,                         /* function */
+        0x05, 0x03, 0x01, 0x00, 0x01,                   /* memory */
+        0x07, 0x05, 0x01, 0x01, 0x66, 0x00, 0x00,       /* export */
+    };
+    std::vector<uint8> func, code = { 0x01 };
+
+    /* No locals */
+    func.push_back(0x00);
+    func.insert(func.end(), body.begin(), body.end());
+    func.push_back(0x0b);
+
+    emit_leb(code, (uint32)func.size());
+    code.insert(code.end(), func.begin(), func.end());
+
+    wasm.push_back(0x0a);
+    emit_leb(wasm, (uint32)code.size());
+    wasm.insert(wasm.end(), code.begin(), code.end());
+    return wasm;
+}
+
+class fast_jit_simd_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.running_mode = Mode_Fast_JIT;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+    }
+
+    virtual void TearDown()
+    {
+        unload();
+        wasm_runtime_destroy();
+    }
+
+    void unload()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        exec_env = NULL;
+        module_inst = NULL;
+        module = NULL;
+    }
+
+    bool load(const std::vector<uint8> &body)
+    {
+        unload();
+        wasm = build_module(body);
+        module = wasm_runtime_load(wasm.data(), (uint32)wasm.size(),
+                                   error_buf, sizeof(error_buf));
+        return module != NULL;
+    }
+
+    /* Compile and run the body, the memory is initialized with a at
+       A_OFFSET and b at B_OFFSET */
+    void run(const std::vector<uint8> &body, const v128 &a, const v128 &b)
+    {
+        ASSERT_TRUE(load(body)) << error_buf;
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+
+        memcpy(memory(A_OFFSET), &a, sizeof(v128));
+        memcpy(memory(B_OFFSET), &b, sizeof(v128));
+        ASSERT_TRUE(call_wasm_func(exec_env, "f", 0, NULL))
+            << wasm_runtime_get_exception(module_inst);
+    }
+
+    uint8 *memory(uint32 offset)
+    {
+        return (uint8 *)wasm_runtime_addr_app_to_native(module_inst, offset);
+    }
+
+    v128 result()
+    {
+        v128 res;
+
+        memcpy(&res, memory(RESULT_OFFSET), sizeof(v128));
+        return res;
+    }
+
+    v128 unary(uint32 opcode, const v128 &a)
+    {
+        run(concat({ i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+                     simd_op(opcode), v128_store }),
+            a, a);
+        return result();
+    }
+
+    v128 binary(uint32 opcode, const v128 &a, const v128 &b)
+    {
+        run(concat({ i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+                     v128_load(B_OFFSET), simd_op(opcode), v128_store }),
+            a, b);
+        return result();
+    }
+
+    std::vector<uint8> wasm;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    char error_buf[128];
+};
+
+static uint32
+count_allocatable(const JitHardRegInfo *hreg_info, uint32 kind)
+{
+    uint32 n = 0, i;
+
+    for (i = 0; i < hreg_info->info[kind].num; i++)
+        n += hreg_info->info[kind].fixed[i] ? 0 : 1;
+    return n;
+}
+
+TEST_F(fast_jit_simd_test, float_registers)
+{
+    const JitHardRegInfo *hreg_info = jit_codegen_get_hreg_info();
+    const JitHardRegInfo *hreg_info_simd = jit_codegen_get_hreg_info_simd();
+
+    /* The functions without v128 keep all the float registers */
+    EXPECT_EQ(count_allocatable(hreg_info, JIT_REG_KIND_F32), 8u);
+    EXPECT_EQ(count_allocatable(hreg_info, JIT_REG_KIND_F64), 7u);
+    EXPECT_EQ(count_allocatable(hreg_info, JIT_REG_KIND_V128), 0u);
+
+    EXPECT_EQ(count_allocatable(hreg_info_simd, JIT_REG_KIND_F32), 6u);
+    EXPECT_EQ(count_allocatable(hreg_info_simd, JIT_REG_KIND_F64), 4u);
+    EXPECT_EQ(count_allocatable(hreg_info_simd, JIT_REG_KIND_V128), 4u);
+}
+
+TEST_F(fast_jit_simd_test, cpu_check)
+{
+    bool ok;
+
+    /* The SIMD instructions are rejected if the CPU can't run them, with
+       lazy jit the function is compiled when it is called */
+    ok = load(concat({ i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+                       v128_store }));
+    if (ok) {
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+        ok = call_wasm_func(exec_env, "f", 0, NULL);
+    }
+    EXPECT_EQ(ok, jit_codegen_is_simd_supported());
+}
+
+TEST_F(fast_jit_simd_test, lane_ops)
+{
+    v128 a;
+    float32 f;
+    uint32 i;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    for (i = 0; i < 16; i++)
+        a.u8[i] = (uint8)(0xf0 + i);
+    a.f32[2] = 1.5f;
+
+    run(concat({
+            /* i8x16.extract_lane_s 15 and i8x16.extract_lane_u 15 */
+            i32_const(48), v128_load(A_OFFSET), simd_op(0x15), { 15 },
+            { 0x36, 0x02, 0x00 }, i32_const(52), v128_load(A_OFFSET),
+            simd_op(0x16), { 15 }, { 0x36, 0x02, 0x00 },
+            /* f32x4.extract_lane 2 */
+            i32_const(56), v128_load(A_OFFSET), simd_op(0x1f), { 2 },
+            { 0x38, 0x02, 0x00 },
+            /* i16x8.replace_lane 3 with 0x12345 */
+            i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+            { 0x41, 0xc5, 0xc6, 0x04 }, simd_op(0x1a), { 3 }, v128_store,
+            /* i32x4.splat -7, stored at 64 */
+            i32_const(0), i32_const(-7), simd_op(0x11),
+            { 0xfd, 0x0b, 0x04, 0x40 } }),
+        a, a);
+
+    EXPECT_EQ(*(int32 *)memory(48), -1);
+    EXPECT_EQ(*(uint32 *)memory(52), 0xffu);
+    memcpy(&f, memory(56), sizeof(f));
+    EXPECT_EQ(f, 1.5f);
+
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ(result().u16[i], i == 3 ? 0x2345 : a.u16[i]);
+    for (i = 0; i < 4; i++)
+        EXPECT_EQ(((int32 *)memory(64))[i], -7);
+}
+
+TEST_F(fast_jit_simd_test, shuffle)
+{
+    v128 a, b, res;
+    std::vector<uint8> lanes;
+    uint32 i;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    for (i = 0; i < 16; i++) {
+        a.u8[i] = (uint8)i;
+        b.u8[i] = (uint8)(0x10 + i);
+    }
+
+    /* i8x16.shuffle interleaving a and b */
+    for (i = 0; i < 16; i++)
+        lanes.push_back((uint8)(i % 2 ? 16 + i : i));
+    run(concat({ i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+                 v128_load(B_OFFSET), simd_op(0x0d), lanes, v128_store }),
+        a, b);
+    res = result();
+    for (i = 0; i < 16; i++)
+        EXPECT_EQ(res.u8[i], i % 2 ? b.u8[i] : a.u8[i]);
+
+    /* i8x16.shuffle reversing b */
+    lanes.clear();
+    for (i = 0; i < 16; i++)
+        lanes.push_back((uint8)(31 - i));
+    run(concat({ i32_const(RESULT_OFFSET), v128_load(A_OFFSET),
+                 v128_load(B_OFFSET), simd_op(0x0d), lanes, v128_store }),
+        a, b);
+    res = result();
+    for (i = 0; i < 16; i++)
+        EXPECT_EQ(res.u8[i], b.u8[15 - i]);
+
+    /* i8x16.swizzle zeroes the lanes whose indexes are out of range */
+    for (i = 0; i < 16; i++)
+        b.u8[i] = (uint8)(i % 4 == 0 ? 15 - i : i % 4 == 1 ? 16 : 0xff - i);
+    res = binary(0x0e, a, b);
+    for (i = 0; i < 16; i++)
+        EXPECT_EQ(res.u8[i], b.u8[i] < 16 ? a.u8[b.u8[i]] : 0);
+}
+
+TEST_F(fast_jit_simd_test, saturating_arith)
+{
+    v128 a, b, res;
+    int32 v;
+    uint32 i;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    /* i8x16.add_sat_s */
+    for (i = 0; i < 16; i++) {
+        a.i8[i] = (int8)(i * 17 - 128);
+        b.i8[i] = (int8)(i % 2 ? 100 : -100);
+    }
+    res = binary(0x6f, a, b);
+    for (i = 0; i < 16; i++) {
+        v = a.i8[i] + b.i8[i];
+        EXPECT_EQ(res.i8[i], v > 127 ? 127 : v < -128 ? -128 : v);
+    }
+
+    /* i16x8.sub_sat_u */
+    for (i = 0; i < 8; i++) {
+        a.u16[i] = (uint16)(i * 0x2000);
+        b.u16[i] = (uint16)(0x7000 + i);
+    }
+    res = binary(0x93, a, b);
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ(res.u16[i], a.u16[i] > b.u16[i] ? a.u16[i] - b.u16[i] : 0);
+
+    /* i16x8.q15mulr_sat_s, which overflows only for -1.0 * -1.0 */
+    int16 q15[8][2] = { { INT16_MIN, INT16_MIN }, { INT16_MIN, INT16_MAX },
+                        { INT16_MAX, INT16_MAX }, { 0x4000, 0x4000 },
+                        { -0x4000, 0x4000 },      { 1, 0x4000 },
+                        { -1, 0x4000 },           { 0x1234, -0x5678 } };
+    for (i = 0; i < 8; i++) {
+        a.i16[i] = q15[i][0];
+        b.i16[i] = q15[i][1];
+    }
+    res = binary(0x82, a, b);
+    for (i = 0; i < 8; i++) {
+        v = (a.i16[i] * b.i16[i] + 0x4000) >> 15;
+        EXPECT_EQ(res.i16[i], v > INT16_MAX ? INT16_MAX : v);
+    }
+
+    /* i16x8.narrow_i32x4_s */
+    a.i32[0] = 70000;
+    a.i32[1] = -70000;
+    a.i32[2] = 32767;
+    a.i32[3] = -32768;
+    b.i32[0] = 1;
+    b.i32[1] = -1;
+    b.i32[2] = INT32_MAX;
+    b.i32[3] = INT32_MIN;
+    res = binary(0x85, a, b);
+    int16 narrowed[8] = { 32767, -32768, 32767, -32768,
+                          1,     -1,     32767, -32768 };
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ(res.i16[i], narrowed[i]);
+}
+
+TEST_F(fast_jit_simd_test, trunc_sat)
+{
+    v128 a, res;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    /* i32x4.trunc_sat_f32x4_s */
+    a.f32[0] = NAN;
+    a.f32[1] = 3e9f;
+    a.f32[2] = -3e9f;
+    a.f32[3] = -1.5f;
+    res = unary(0xf8, a);
+    EXPECT_EQ(res.i32[0], 0);
+    EXPECT_EQ(res.i32[1], INT32_MAX);
+    EXPECT_EQ(res.i32[2], INT32_MIN);
+    EXPECT_EQ(res.i32[3], -1);
+
+    /* i32x4.trunc_sat_f32x4_u */
+    a.f32[0] = -NAN;
+    a.f32[1] = 5e9f;
+    a.f32[2] = -1.5f;
+    a.f32[3] = 3e9f;
+    res = unary(0xf9, a);
+    EXPECT_EQ(res.u32[0], 0u);
+    EXPECT_EQ(res.u32[1], UINT32_MAX);
+    EXPECT_EQ(res.u32[2], 0u);
+    EXPECT_EQ(res.u32[3], 3000000000u);
+
+    /* i32x4.trunc_sat_f64x2_s_zero */
+    a.f64[0] = NAN;
+    a.f64[1] = -1e10;
+    res = unary(0xfc, a);
+    EXPECT_EQ(res.i32[0], 0);
+    EXPECT_EQ(res.i32[1], INT32_MIN);
+    EXPECT_EQ(res.i32[2], 0);
+    EXPECT_EQ(res.i32[3], 0);
+    a.f64[0] = 2147483647.9;
+    a.f64[1] = -1.9;
+    res = unary(0xfc, a);
+    EXPECT_EQ(res.i32[0], INT32_MAX);
+    EXPECT_EQ(res.i32[1], -1);
+
+    /* i32x4.trunc_sat_f64x2_u_zero */
+    a.f64[0] = 4294967296.0;
+    a.f64[1] = 4294967294.5;
+    res = unary(0xfd, a);
+    EXPECT_EQ(res.u32[0], UINT32_MAX);
+    EXPECT_EQ(res.u32[1], 4294967294u);
+    EXPECT_EQ(res.u32[2], 0u);
+    EXPECT_EQ(res.u32[3], 0u);
+    a.f64[0] = -0.5;
+    a.f64[1] = NAN;
+    res = unary(0xfd, a);
+    EXPECT_EQ(res.u32[0], 0u);
+    EXPECT_EQ(res.u32[1], 0u);
+}
+
+TEST_F(fast_jit_simd_test, convert)
+{
+    v128 a, res;
+    uint32 i;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    /* f32x4.convert_i32x4_u, the last one is rounded to nearest even */
+    a.u32[0] = UINT32_MAX;
+    a.u32[1] = 0x80000000;
+    a.u32[2] = 1;
+    a.u32[3] = 0x80000081;
+    res = unary(0xfb, a);
+    for (i = 0; i < 4; i++)
+        EXPECT_EQ(res.f32[i], (float32)a.u32[i]);
+
+    /* f64x2.convert_low_i32x4_s and f64x2.convert_low_i32x4_u */
+    a.i32[0] = -1;
+    a.i32[1] = INT32_MIN;
+    res = unary(0xfe, a);
+    EXPECT_EQ(res.f64[0], -1.0);
+    EXPECT_EQ(res.f64[1], -2147483648.0);
+    res = unary(0xff, a);
+    EXPECT_EQ(res.f64[0], 4294967295.0);
+    EXPECT_EQ(res.f64[1], 2147483648.0);
+
+    /* i8x16.popcnt */
+    for (i = 0; i < 16; i++)
+        a.u8[i] = (uint8)(i * 37);
+    res = unary(0x62, a);
+    for (i = 0; i < 16; i++)
+        EXPECT_EQ(res.u8[i], (uint8)__builtin_popcount(a.u8[i]));
+}
+
+TEST_F(fast_jit_simd_test, nan)
+{
+    v128 a, b, res;
+
+    SKIP_IF_SIMD_UNSUPPORTED();
+
+    a.f32[0] = NAN;
+    a.f32[1] = -0.0f;
+    a.f32[2] = 1.0f;
+    a.f32[3] = 0.0f;
+    b.f32[0] = 1.0f;
+    b.f32[1] = 0.0f;
+    b.f32[2] = -NAN;
+    b.f32[3] = -0.0f;
+
+    /* f32x4.min and f32x4.max propagate NaN, and -0.0 < 0.0 */
+    res = binary(0xe8, a, b);
+    EXPECT_TRUE(std::isnan(res.f32[0]));
+    EXPECT_TRUE(res.f32[1] == 0.0f && std::signbit(res.f32[1]));
+    EXPECT_TRUE(std::isnan(res.f32[2]));
+    EXPECT_TRUE(res.f32[3] == 0.0f && std::signbit(res.f32[3]));
+    res = binary(0xe9, a, b);
+    EXPECT_TRUE(std::isnan(res.f32[0]));
+    EXPECT_TRUE(res.f32[1] == 0.0f && !std::signbit(res.f32[1]));
+    EXPECT_TRUE(std::isnan(res.f32[2]));
+    EXPECT_TRUE(res.f32[3] == 0.0f && !std::signbit(res.f32[3]));
+
+    /* f32x4.eq and f32x4.ne, NaN is unequal to itself */
+    b.f32[0] = NAN;
+    b.f32[1] = -0.0f;
+    res = binary(0x41, a, b);
+    EXPECT_EQ(res.i32[0], 0);
+    EXPECT_EQ(res.i32[1], -1);
+    EXPECT_EQ(res.i32[3], -1);
+    res = binary(0x42, a, b);
+    EXPECT_EQ(res.i32[0], -1);
+    EXPECT_EQ(res.i32[1], 0);
+
+    /* f64x2.max */
+    a.f64[0] = -INFINITY;
+    a.f64[1] = -0.0;
+    b.f64[0] = NAN;
+    b.f64[1] = 0.0;
+    res = binary(0xf5, a, b);
+    EXPECT_TRUE(std::isnan(res.f64[0]));
+    EXPECT_TRUE(res.f64[1] == 0.0 && !std::signbit(res.f64[1]));
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+#include "bh_platform.h"
+#include "bh_read_file.h"
+#include "wasm_export.h"
+
+class gc_nursery_test : public testing::Test
+{
+  private:
+    std::string get_binary_path()
+    {
+        char cwd[1024] = { 0 };
+
+        if (readlink("/proc/self/exe", cwd, 1024) <= 0) {
+            return NULL;
+        }
+
+        char *path_end = strrchr(cwd, '/');
+        if (path_end != NULL) {
+            *path_end = '\0';
+        }
+
+        return std::string(cwd);
+    }
+
+  protected:
+    void SetUp() { CWD = get_binary_path(); }
+
+    void TearDown()
+    {
+        if (is_inited)
+            destroy_runtime();
+    }
+
+    bool init_runtime(uint32 nursery_size)
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_Pool;
+        init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
+        init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        init_args.gc_heap_size = 256 * 1024;
+        init_args.gc_nursery_size = nursery_size;
+
+        return (is_inited = wasm_runtime_full_init(&init_args));
+    }
+
+    void destroy_runtime()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+        module = NULL;
+        /* the file buffer is allocated from the runtime pool */
+        if (wasm_file_buf)
+            BH_FREE(wasm_file_buf);
+        wasm_file_buf = NULL;
+        wasm_runtime_destroy();
+        is_inited = false;
+    }
+
+    bool load_wasm_file(const char *wasm_file)
+    {
+        std::string file = CWD + "/" + wasm_file;
+
+        if (!(wasm_file_buf = (unsigned char *)bh_read_file_to_buffer(
+                  file.c_str(), &wasm_file_size)))
+            return false;
+
+        module = wasm_runtime_load(wasm_file_buf, wasm_file_size, error_buf,
+                                   sizeof(error_buf));
+        return module != NULL;
+    }
+
+    /* Call list2's run with n nodes pushed to k lists */
+    void run_list2(wasm_module_inst_t module_inst, uint32 n, uint32 k)
+    {
+        uint32 argv[2] = { n, k };
+
+        /* the new nodes are stored into the promoted nodes and array,
+           they must survive the minor GCs by the write barrier */
+        ASSERT_TRUE(call_wasm_func(module_inst, "run", 2, argv))
+            << wasm_runtime_get_exception(module_inst);
+        EXPECT_EQ(argv[0], n * (n + 1) / 2);
+    }
+
+  public:
+    std::string CWD;
+    unsigned char *wasm_file_buf = NULL;
+    uint32 wasm_file_size = 0;
+    wasm_module_t module = NULL;
+    bool is_inited = false;
+    char error_buf[128];
+    char global_heap_buf[1024 * 1024];
+};
+
+TEST_F(gc_nursery_test, list)
+{
+    uint32 nursery_sizes[] = { 8 * 1024, 16 * 1024, 0 };
+    wasm_module_inst_t module_inst;
+    uint32 i;
+
+    for (i = 0; i < sizeof(nursery_sizes) / sizeof(nursery_sizes[0]); i++) {
+        ASSERT_TRUE(init_runtime(nursery_sizes[i]));
+        ASSERT_TRUE(load_wasm_file("list2.wasm"));
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL);
+
+        run_list2(module_inst, 5000, 16);
+
+        wasm_runtime_deinstantiate(module_inst);
+        destroy_runtime();
+    }
+}
+
+TEST_F(gc_nursery_test, instances)
+{
+    wasm_module_inst_t module_insts[3];
+    uint32 i, j;
+
+    ASSERT_TRUE(init_runtime(8 * 1024));
+    ASSERT_TRUE(load_wasm_file("list2.wasm"));
+
+    /* each instance has its own heap and nursery, the escaped young wos
+       must be recorded in the heap they are allocated from */
+    for (i = 0; i < 3; i++) {
+        module_insts[i] = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                                   sizeof(error_buf));
+        ASSERT_TRUE(module_insts[i] != NULL);
+    }
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 3; i++)
+            run_list2(module_insts[i], 1000 + 1000 * i, 4 + j);
+    }
+
+    for (i = 0; i < 3; i++)
+        wasm_runtime_deinstantiate(module_insts[i]);
+}
@@ -0,0 +1,46 @@
+(module
+  (type $node (struct (field $next (mut (ref null $node))) (field $val i32)))
+  (type $lists (array (mut (ref null $node))))
+
+  ;; Push the values n, n-1, ..., 1 to k lists held by a long-lived array,
+  ;; allocating a garbage node for each value, and return the sum of the
+  ;; values in the lists. The new nodes are linked after the head nodes,
+  ;; which have been promoted by the minor GCs.
+  (func (export "run") (param $n i32) (param $k i32) (result i32)
+    (local $lists (ref null $lists))
+    (local $idx i32)
+    (local $head (ref null $node))
+    (local $sum i32)
+    (local.set $lists (array.new_default $lists (local.get $k)))
+    (loop $build
+      (drop (struct.new $node (ref.null $node) (local.get $n)))
+      (local.set $idx (i32.rem_u (local.get $n) (local.get $k)))
+      (local.set $head (array.get $lists (local.get $lists) (local.get $idx)))
+      (if (ref.is_null (local.get $head))
+        (then
+          (array.set $lists (local.get $lists) (local.get $idx)
+            (struct.new $node (ref.null $node) (local.get $n))))
+        (else
+          (struct.set $node $next (local.get $head)
+            (struct.new $node (struct.get $node $next (local.get $head))
+                              (local.get $n)))))
+      (br_if $build
+        (local.tee $n (i32.sub (local.get $n) (i32.const 1))))
+    )
+    (loop $sum_lists
+      (local.set $k (i32.sub (local.get $k) (i32.const 1)))
+      (local.set $head (array.get $lists (local.get $lists) (local.get $k)))
+      (block $done
+        (loop $sum_up
+          (br_if $done (ref.is_null (local.get $head)))
+          (local.set $sum
+            (i32.add (struct.get $node $val (local.get $head)) (local.get $sum)))
+          (local.set $head (struct.get $node $next (local.get $head)))
+          (br $sum_up)
+        )
+      )
+      (br_if $sum_lists (local.get $k))
+    )
+    (local.get $sum)
+  )
+)
@@ -100,3 +100,57 @@ TEST_F(WasmGCTest, Test_app1)
     ASSERT_TRUE(load_wasm_file("func1.wasm"));
     ASSERT_TRUE(load_wasm_file("func2.wasm"));
 }
+
+TEST_F(WasmGCTest, Test_gc_pause_budget)
+{
+    uint32 budgets[] = { 0, 1 };
+    uint32 i, argv[2];
+
+    for (i = 0; i < sizeof(budgets) / sizeof(budgets[0]); i++) {
+        wasm_runtime_destroy();
+        init_args.gc_pause_budget_us = budgets[i];
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        ASSERT_TRUE(load_wasm_file("list1.wasm"));
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL);
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+        func_inst = wasm_runtime_lookup_function(module_inst, "run");
+        ASSERT_TRUE(func_inst != NULL);
+
+        /* allocate much more objects than the gc heap can hold, the
+           sweep is left to the allocations when the budget is set */
+        argv[0] = 100000;
+        argv[1] = 1023;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func_inst, 2, argv));
+        ASSERT_EQ(argv[0], 1023 * 1024 / 2);
+
+        wasm_runtime_destroy_exec_env(exec_env);
+        wasm_runtime_deinstantiate(module_inst);
+        wasm_runtime_unload(module);
+    }
+}
+
+TEST_F(WasmGCTest, Test_subtype_display)
+{
+    uint32 argv[1];
+
+    ASSERT_TRUE(load_wasm_file("subtype1.wasm"));
+    module_inst =
+        wasm_runtime_instantiate(module, 8192, 0, error_buf, sizeof(error_buf));
+    ASSERT_TRUE(module_inst != NULL);
+    exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+    ASSERT_TRUE(exec_env != NULL);
+    func_inst = wasm_runtime_lookup_function(module_inst, "run");
+    ASSERT_TRUE(func_inst != NULL);
+
+    /* the casts to the types inside and beyond the supertype display */
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func_inst, 0, argv));
+    ASSERT_EQ(argv[0], 12);
+
+    wasm_runtime_destroy_exec_env(exec_env);
+    wasm_runtime_deinstantiate(module_inst);
+    wasm_runtime_unload(module);
+}
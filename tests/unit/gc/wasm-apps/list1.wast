@@ -0,0 +1,27 @@
+(module
+  (type $node (struct (field $next (mut (ref null $node))) (field $val i32)))
+
+  ;; Build a list of nodes with values n, n-1, ..., 1, dropping the list
+  ;; whenever (value & mask) is 0, and return the sum of the values left
+  (func (export "run") (param $n i32) (param $mask i32) (result i32)
+    (local $head (ref null $node))
+    (local $sum i32)
+    (loop $build
+      (local.set $head (struct.new $node (local.get $head) (local.get $n)))
+      (if (i32.eqz (i32.and (local.get $n) (local.get $mask)))
+        (then (local.set $head (ref.null $node))))
+      (br_if $build
+        (local.tee $n (i32.sub (local.get $n) (i32.const 1))))
+    )
+    (block $done
+      (loop $sum_up
+        (br_if $done (ref.is_null (local.get $head)))
+        (local.set $sum
+          (i32.add (struct.get $node $val (local.get $head)) (local.get $sum)))
+        (local.set $head (struct.get $node $next (local.get $head)))
+        (br $sum_up)
+      )
+    )
+    (local.get $sum)
+  )
+)
@@ -0,0 +1,67 @@
+(module
+  ;; A chain of 40 struct types deeper than the supertype display, and
+  ;; a sibling of $t32 whose inherit depth is beyond the display
+  (type $t0 (sub (struct)))
+  (type $t1 (sub $t0 (struct)))
+  (type $t2 (sub $t1 (struct)))
+  (type $t3 (sub $t2 (struct)))
+  (type $t4 (sub $t3 (struct)))
+  (type $t5 (sub $t4 (struct)))
+  (type $t6 (sub $t5 (struct)))
+  (type $t7 (sub $t6 (struct)))
+  (type $t8 (sub $t7 (struct)))
+  (type $t9 (sub $t8 (struct)))
+  (type $t10 (sub $t9 (struct)))
+  (type $t11 (sub $t10 (struct)))
+  (type $t12 (sub $t11 (struct)))
+  (type $t13 (sub $t12 (struct)))
+  (type $t14 (sub $t13 (struct)))
+  (type $t15 (sub $t14 (struct)))
+  (type $t16 (sub $t15 (struct)))
+  (type $t17 (sub $t16 (struct)))
+  (type $t18 (sub $t17 (struct)))
+  (type $t19 (sub $t18 (struct)))
+  (type $t20 (sub $t19 (struct)))
+  (type $t21 (sub $t20 (struct)))
+  (type $t22 (sub $t21 (struct)))
+  (type $t23 (sub $t22 (struct)))
+  (type $t24 (sub $t23 (struct)))
+  (type $t25 (sub $t24 (struct)))
+  (type $t26 (sub $t25 (struct)))
+  (type $t27 (sub $t26 (struct)))
+  (type $t28 (sub $t27 (struct)))
+  (type $t29 (sub $t28 (struct)))
+  (type $t30 (sub $t29 (struct)))
+  (type $t31 (sub $t30 (struct)))
+  (type $t32 (sub $t31 (struct)))
+  (type $t33 (sub $t32 (struct)))
+  (type $t34 (sub $t33 (struct)))
+  (type $t35 (sub $t34 (struct)))
+  (type $t36 (sub $t35 (struct)))
+  (type $t37 (sub $t36 (struct)))
+  (type $t38 (sub $t37 (struct)))
+  (type $t39 (sub $t38 (struct)))
+  (type $t40 (sub $t31 (struct (field i32))))
+
+  ;; Return the count of the successful ref.test checks, 12 is expected
+  (func (export "run") (result i32)
+    (i32.const 0)
+    (i32.add (ref.test (ref $t0) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t31) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t32) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t38) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t39) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t40) (struct.new_default $t39)))
+    (i32.add (ref.test (ref $t0) (struct.new_default $t20)))
+    (i32.add (ref.test (ref $t19) (struct.new_default $t20)))
+    (i32.add (ref.test (ref $t20) (struct.new_default $t20)))
+    (i32.add (ref.test (ref $t21) (struct.new_default $t20)))
+    (i32.add (ref.test (ref $t33) (struct.new_default $t20)))
+    (i32.add (ref.test (ref $t0) (struct.new_default $t40)))
+    (i32.add (ref.test (ref $t30) (struct.new_default $t40)))
+    (i32.add (ref.test (ref $t31) (struct.new_default $t40)))
+    (i32.add (ref.test (ref $t40) (struct.new_default $t40)))
+    (i32.add (ref.test (ref $t32) (struct.new_default $t40)))
+    (i32.add (ref.test (ref $t39) (struct.new_default $t40)))
+  )
+)
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (global $g (mut i32) (i32.const 0))
+ *   (memory (export "memory") 1 10)
+ *   (table 1 funcref)
+ *   (elem (i32.const 0) $get_g)
+ *   (func (export "init")
+ *     (global.set $g (i32.const 42))
+ *     (i32.store (i32.const 1024) (i32.const 0x12345678))
+ *     (drop (memory.grow (i32.const 2)))
+ *     (i32.store (i32.const 131072) (i32.const 7)))
+ *   (func $get_g (export "get_g") (result i32) (global.get $g))
+ *   (func (export "load") (param i32) (result i32)
+ *     (i32.load (local.get 0)))
+ *   (func (export "store") (param i32 i32)
+ *     (i32.store (local.get 0) (local.get 1)))
+ *   (func (export "size") (result i32) (memory.size))
+ *   (func (export "call0") (result i32)
+ *     (call_indirect (result i32) (i32.const 0)))
+ *   (data (i32.const 16) "hello"))
+ */
+static const uint8_t snapshot_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x12, 0x04, 0x60,
+    0x00, 0x00, 0x60, 0x00, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60,
+    0x02, 0x7F, 0x7F, 0x00, 0x03, 0x07, 0x06, 0x00, 0x01, 0x02, 0x03, 0x01,
+    0x01, 0x04, 0x04, 0x01, 0x70, 0x00, 0x01, 0x05, 0x04, 0x01, 0x01, 0x01,
+    0x0A, 0x06, 0x06, 0x01, 0x7F, 0x01, 0x41, 0x00, 0x0B, 0x07, 0x37, 0x07,
+    0x04, 0x69, 0x6E, 0x69, 0x74, 0x00, 0x00, 0x05, 0x67, 0x65, 0x74, 0x5F,
+    0x67, 0x00, 0x01, 0x04, 0x6C, 0x6F, 0x61, 0x64, 0x00, 0x02, 0x05, 0x73,
+    0x74, 0x6F, 0x72, 0x65, 0x00, 0x03, 0x04, 0x73, 0x69, 0x7A, 0x65, 0x00,
+    0x04, 0x05, 0x63, 0x61, 0x6C, 0x6C, 0x30, 0x00, 0x05, 0x06, 0x6D, 0x65,
+    0x6D, 0x6F, 0x72, 0x79, 0x02, 0x00, 0x09, 0x07, 0x01, 0x00, 0x41, 0x00,
+    0x0B, 0x01, 0x01, 0x0A, 0x46, 0x06, 0x20, 0x00, 0x41, 0x2A, 0x24, 0x00,
+    0x41, 0x80, 0x08, 0x41, 0xF8, 0xAC, 0xD1, 0x91, 0x01, 0x36, 0x02, 0x00,
+    0x41, 0x02, 0x40, 0x00, 0x1A, 0x41, 0x80, 0x80, 0x08, 0x41, 0x07, 0x36,
+    0x02, 0x00, 0x0B, 0x04, 0x00, 0x23, 0x00, 0x0B, 0x07, 0x00, 0x20, 0x00,
+    0x28, 0x02, 0x00, 0x0B, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x36, 0x02,
+    0x00, 0x0B, 0x04, 0x00, 0x3F, 0x00, 0x0B, 0x07, 0x00, 0x41, 0x00, 0x11,
+    0x01, 0x00, 0x0B, 0x0B, 0x0B, 0x01, 0x00, 0x41, 0x10, 0x0B, 0x05, 0x68,
+    0x65, 0x6C, 0x6C, 0x6F
+};
+
+class instance_snapshot_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        char error_buf[128];
+
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+    }
+
+    virtual void TearDown()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    static uint32 call(wasm_module_inst_t inst, const char *name,
+                       uint32 argc = 0, uint32 arg0 = 0, uint32 arg1 = 0)
+    {
+        wasm_exec_env_t exec_env;
+        uint32 argv[2] = { arg0, arg1 };
+
+        exec_env = wasm_runtime_get_exec_env_singleton(inst);
+        EXPECT_NE(exec_env, nullptr);
+        EXPECT_TRUE(call_wasm_func(exec_env, name, argc, argv))
+            << name << ": " << wasm_runtime_get_exception(inst);
+        return argv[0];
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ snapshot_wasm, sizeof(snapshot_wasm) };
+    wasm_module_t module = nullptr;
+};
+
+TEST_F(instance_snapshot_test, restore_state)
+{
+    char error_buf[128];
+    wasm_module_inst_t inst, clone1, clone2;
+    wasm_instance_snapshot_t snapshot;
+    uint64 app_offset;
+    uint32 page_count;
+    void *native_ptr;
+
+    inst = wasm_runtime_instantiate(module, 8192, 8192, error_buf,
+                                    sizeof(error_buf));
+    ASSERT_NE(inst, nullptr) << error_buf;
+
+    call(inst, "init");
+    /* The app heap may add a page in front of the grown pages */
+    page_count = call(inst, "size");
+    ASSERT_GE(page_count, 3u);
+    app_offset = wasm_runtime_module_malloc(inst, 100, &native_ptr);
+    ASSERT_NE(app_offset, 0u);
+    strcpy((char *)native_ptr, "snapshot");
+
+    snapshot =
+        wasm_runtime_snapshot_instance(inst, error_buf, sizeof(error_buf));
+    ASSERT_NE(snapshot, nullptr) << error_buf;
+
+    /* Changes made after the snapshot must not leak into it */
+    call(inst, "store", 2, 1024, 1);
+    wasm_runtime_deinstantiate(inst);
+
+    clone1 = wasm_runtime_instantiate_from_snapshot(snapshot, 8192, error_buf,
+                                                    sizeof(error_buf));
+    ASSERT_NE(clone1, nullptr) << error_buf;
+    clone2 = wasm_runtime_instantiate_from_snapshot(snapshot, 8192, error_buf,
+                                                    sizeof(error_buf));
+    ASSERT_NE(clone2, nullptr) << error_buf;
+
+    EXPECT_EQ(call(clone1, "get_g"), 42u);
+    EXPECT_EQ(call(clone1, "size"), page_count);
+    EXPECT_EQ(call(clone1, "load", 1, 1024), 0x12345678u);
+    EXPECT_EQ(call(clone1, "load", 1, 131072), 7u);
+    EXPECT_EQ(call(clone1, "call0"), 42u);
+    EXPECT_EQ(memcmp(wasm_runtime_addr_app_to_native(clone1, 16), "hello", 5),
+              0);
+    EXPECT_STREQ(
+        (char *)wasm_runtime_addr_app_to_native(clone1, app_offset),
+        "snapshot");
+
+    /* Instances created from one snapshot don't share memory */
+    call(clone1, "store", 2, 1024, 99);
+    EXPECT_EQ(call(clone1, "load", 1, 1024), 99u);
+    EXPECT_EQ(call(clone2, "load", 1, 1024), 0x12345678u);
+
+    /* The restored app heap is usable */
+    wasm_runtime_module_free(clone2, app_offset);
+    EXPECT_NE(wasm_runtime_module_malloc(clone2, 4096, NULL), 0u);
+
+    wasm_runtime_deinstantiate(clone2);
+    wasm_runtime_deinstantiate(clone1);
+    wasm_runtime_destroy_instance_snapshot(snapshot);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (func (export "add") (param i32 i32) (result i32)
+ *     (i32.add (local.get 0) (local.get 1)))
+ *   (func (export "bad") (result i32) (i64.const 1))
+ *   (func (export "call_add") (result i32)
+ *     (call 0 (i32.const 40) (i32.const 2))))
+ */
+static const uint8_t lazy_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0B, 0x02, 0x60,
+    0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x01, 0x7F, 0x03, 0x04, 0x03,
+    0x00, 0x01, 0x01, 0x07, 0x18, 0x03, 0x03, 0x61, 0x64, 0x64, 0x00, 0x00,
+    0x03, 0x62, 0x61, 0x64, 0x00, 0x01, 0x08, 0x63, 0x61, 0x6C, 0x6C, 0x5F,
+    0x61, 0x64, 0x64, 0x00, 0x02, 0x0A, 0x17, 0x03, 0x07, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x6A, 0x0B, 0x04, 0x00, 0x42, 0x01, 0x0B, 0x08, 0x00, 0x41,
+    0x28, 0x41, 0x02, 0x10, 0x00, 0x0B
+};
+
+class lazy_validation_test : public testing::Test
+{
+  protected:
+    wasm_module_t load(bool lazy_validation)
+    {
+        LoadArgs args = { 0 };
+
+        args.name = (char *)"lazy";
+        args.lazy_validation = lazy_validation;
+        return wasm_runtime_load_ex(wasm_buf.data(), wasm_buf.size(), &args,
+                                    error_buf, sizeof(error_buf));
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ lazy_wasm, sizeof(lazy_wasm) };
+    char error_buf[128];
+};
+
+TEST_F(lazy_validation_test, invalid_body_fails_eager_load)
+{
+    wasm_module_t module = load(false);
+
+    EXPECT_EQ(module, nullptr);
+    EXPECT_NE(strstr(error_buf, "type mismatch"), nullptr) << error_buf;
+}
+
+TEST_F(lazy_validation_test, invalid_body_traps_on_call)
+{
+    wasm_module_t module;
+    wasm_module_inst_t inst;
+    uint32_t argv[2] = { 0 };
+
+    module = load(true);
+    ASSERT_NE(module, nullptr) << error_buf;
+
+    inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                    sizeof(error_buf));
+    ASSERT_NE(inst, nullptr) << error_buf;
+
+    EXPECT_FALSE(call_wasm_func(inst, "bad", 0, argv));
+    EXPECT_NE(strstr(wasm_runtime_get_exception(inst), "type mismatch"),
+              nullptr)
+        << wasm_runtime_get_exception(inst);
+    wasm_runtime_clear_exception(inst);
+
+    /* The function isn't validated again */
+    EXPECT_FALSE(call_wasm_func(inst, "bad", 0, argv));
+    EXPECT_NE(strstr(wasm_runtime_get_exception(inst),
+                     "function body validation failed"),
+              nullptr)
+        << wasm_runtime_get_exception(inst);
+    wasm_runtime_clear_exception(inst);
+
+    /* The valid functions still work */
+    argv[0] = 3;
+    argv[1] = 4;
+    ASSERT_TRUE(call_wasm_func(inst, "add", 2, argv))
+        << wasm_runtime_get_exception(inst);
+    EXPECT_EQ(argv[0], 7u);
+
+    wasm_runtime_deinstantiate(inst);
+    wasm_runtime_unload(module);
+}
+
+TEST_F(lazy_validation_test, callee_prepared_from_interp)
+{
+    wasm_module_t module;
+    wasm_module_inst_t inst1, inst2;
+    uint32_t argv[2] = { 0 };
+
+    module = load(true);
+    ASSERT_NE(module, nullptr) << error_buf;
+
+    inst1 = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                     sizeof(error_buf));
+    ASSERT_NE(inst1, nullptr) << error_buf;
+    inst2 = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                     sizeof(error_buf));
+    ASSERT_NE(inst2, nullptr) << error_buf;
+
+    /* "add" is first called by "call_add" */
+    ASSERT_TRUE(call_wasm_func(inst1, "call_add", 0, argv))
+        << wasm_runtime_get_exception(inst1);
+    EXPECT_EQ(argv[0], 42u);
+
+    /* The other instance shares the prepared function */
+    argv[0] = 1;
+    argv[1] = 2;
+    ASSERT_TRUE(call_wasm_func(inst2, "add", 2, argv))
+        << wasm_runtime_get_exception(inst2);
+    EXPECT_EQ(argv[0], 3u);
+    ASSERT_TRUE(call_wasm_func(inst2, "call_add", 0, argv))
+        << wasm_runtime_get_exception(inst2);
+    EXPECT_EQ(argv[0], 42u);
+
+    wasm_runtime_deinstantiate(inst2);
+    wasm_runtime_deinstantiate(inst1);
+    wasm_runtime_unload(module);
+}
+
+TEST_F(lazy_validation_test, concurrent_first_calls)
+{
+    const int thread_num = 8;
+    std::vector<wasm_module_inst_t> insts(thread_num);
+    std::vector<uint32_t> results(thread_num, 0);
+    std::vector<std::thread> threads;
+    wasm_module_t module;
+    int i;
+
+    module = load(true);
+    ASSERT_NE(module, nullptr) << error_buf;
+
+    for (i = 0; i < thread_num; i++) {
+        insts[i] = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                            sizeof(error_buf));
+        ASSERT_NE(insts[i], nullptr) << error_buf;
+    }
+
+    for (i = 0; i < thread_num; i++) {
+        threads.emplace_back([&insts, &results, i]() {
+            uint32_t argv[2] = { 0 };
+
+            if (!wasm_runtime_init_thread_env())
+                return;
+            if (call_wasm_func(insts[i], "call_add", 0, argv))
+                results[i] = argv[0];
+            wasm_runtime_destroy_thread_env();
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (i = 0; i < thread_num; i++) {
+        EXPECT_EQ(results[i], 42u) << wasm_runtime_get_exception(insts[i]);
+        wasm_runtime_deinstantiate(insts[i]);
+    }
+    wasm_runtime_unload(module);
+}
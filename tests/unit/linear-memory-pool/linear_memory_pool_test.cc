@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (memory 1 10)
+ *   (func (export "load") (param i32) (result i32)
+ *     (i32.load (local.get 0)))
+ *   (func (export "store") (param i32 i32)
+ *     (i32.store (local.get 0) (local.get 1)))
+ *   (func (export "grow") (param i32) (result i32)
+ *     (memory.grow (local.get 0))))
+ */
+static const uint8_t pool_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0B, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x00, 0x03, 0x04, 0x03,
+    0x00, 0x01, 0x00, 0x05, 0x04, 0x01, 0x01, 0x01, 0x0A, 0x07, 0x17, 0x03,
+    0x04, 0x6C, 0x6F, 0x61, 0x64, 0x00, 0x00, 0x05, 0x73, 0x74, 0x6F, 0x72,
+    0x65, 0x00, 0x01, 0x04, 0x67, 0x72, 0x6F, 0x77, 0x00, 0x02, 0x0A, 0x1A,
+    0x03, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0B, 0x09, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x36, 0x02, 0x00, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x40,
+    0x00, 0x0B
+};
+
+class linear_memory_pool_test : public testing::Test
+{
+  protected:
+    virtual void TearDown()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+        if (runtime_inited)
+            wasm_runtime_destroy();
+    }
+
+    void init_runtime(uint32_t slots)
+    {
+        RuntimeInitArgs init_args;
+        char error_buf[128];
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_Pool;
+        init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
+        init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        init_args.linear_memory_pool_slots = slots;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+        runtime_inited = true;
+
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+    }
+
+    wasm_module_inst_t instantiate()
+    {
+        char error_buf[128];
+        wasm_module_inst_t inst = wasm_runtime_instantiate(
+            module, 8192, 0, error_buf, sizeof(error_buf));
+
+        EXPECT_NE(inst, nullptr) << error_buf;
+        return inst;
+    }
+
+    static uint32 load(wasm_module_inst_t inst, uint32 addr)
+    {
+        uint32 argv[1] = { addr };
+
+        EXPECT_TRUE(call_wasm_func(inst, "load", 1, argv))
+            << wasm_runtime_get_exception(inst);
+        return argv[0];
+    }
+
+    static void store(wasm_module_inst_t inst, uint32 addr, uint32 value)
+    {
+        uint32 argv[2] = { addr, value };
+
+        EXPECT_TRUE(call_wasm_func(inst, "store", 2, argv))
+            << wasm_runtime_get_exception(inst);
+    }
+
+    char global_heap_buf[512 * 1024];
+    WAMRWasmBuffer wasm_buf{ pool_wasm, sizeof(pool_wasm) };
+    bool runtime_inited = false;
+    wasm_module_t module = nullptr;
+};
+
+TEST_F(linear_memory_pool_test, disabled)
+{
+    linear_memory_pool_stats_t stats;
+
+    init_runtime(0);
+    EXPECT_FALSE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+}
+
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && defined(OS_ENABLE_MEM_DISCARD)
+TEST_F(linear_memory_pool_test, reuse_slot)
+{
+    linear_memory_pool_stats_t stats;
+    wasm_module_inst_t inst;
+    uint32 argv[1] = { 2 };
+
+    init_runtime(2);
+
+    inst = instantiate();
+    ASSERT_NE(inst, nullptr);
+    store(inst, 100, 5);
+    ASSERT_TRUE(call_wasm_func(inst, "grow", 1, argv));
+    store(inst, 2 * 65536 + 8, 9);
+    EXPECT_EQ(load(inst, 2 * 65536 + 8), 9u);
+    wasm_runtime_deinstantiate(inst);
+
+    ASSERT_TRUE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+    EXPECT_EQ(stats.slot_count, 2u);
+    EXPECT_EQ(stats.slots_in_use, 0u);
+    EXPECT_EQ(stats.acquire_count, 1u);
+    EXPECT_EQ(stats.reuse_count, 0u);
+    EXPECT_EQ(stats.release_count, 1u);
+
+    /* The released slot is handed out again with the dirty pages reset
+       and the grown pages inaccessible */
+    inst = instantiate();
+    ASSERT_NE(inst, nullptr);
+    EXPECT_EQ(load(inst, 100), 0u);
+    argv[0] = 2 * 65536 + 8;
+    EXPECT_FALSE(call_wasm_func(inst, "load", 1, argv));
+    EXPECT_NE(strstr(wasm_runtime_get_exception(inst), "out of bounds"),
+              nullptr);
+
+    ASSERT_TRUE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+    EXPECT_EQ(stats.slots_in_use, 1u);
+    EXPECT_EQ(stats.acquire_count, 2u);
+    EXPECT_EQ(stats.reuse_count, 1u);
+    wasm_runtime_deinstantiate(inst);
+}
+
+TEST_F(linear_memory_pool_test, fallback)
+{
+    linear_memory_pool_stats_t stats;
+    wasm_module_inst_t inst1, inst2;
+
+    init_runtime(1);
+
+    inst1 = instantiate();
+    ASSERT_NE(inst1, nullptr);
+    inst2 = instantiate();
+    ASSERT_NE(inst2, nullptr);
+
+    store(inst1, 16, 1);
+    store(inst2, 16, 2);
+    EXPECT_EQ(load(inst1, 16), 1u);
+    EXPECT_EQ(load(inst2, 16), 2u);
+
+    ASSERT_TRUE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+    EXPECT_EQ(stats.slots_in_use, 1u);
+    EXPECT_EQ(stats.acquire_count, 1u);
+    EXPECT_EQ(stats.fallback_count, 1u);
+
+    wasm_runtime_deinstantiate(inst2);
+    wasm_runtime_deinstantiate(inst1);
+
+    ASSERT_TRUE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+    EXPECT_EQ(stats.slots_in_use, 0u);
+    EXPECT_EQ(stats.release_count, 1u);
+}
+
+#if WASM_ENABLE_INSTANCE_SNAPSHOT != 0
+TEST_F(linear_memory_pool_test, reuse_slot_of_snapshot_instance)
+{
+    char error_buf[128];
+    linear_memory_pool_stats_t stats;
+    wasm_instance_snapshot_t snapshot;
+    wasm_module_inst_t inst;
+
+    init_runtime(1);
+
+    inst = instantiate();
+    ASSERT_NE(inst, nullptr);
+    store(inst, 100, 5);
+    snapshot =
+        wasm_runtime_snapshot_instance(inst, error_buf, sizeof(error_buf));
+    ASSERT_NE(snapshot, nullptr) << error_buf;
+    wasm_runtime_deinstantiate(inst);
+
+    inst = wasm_runtime_instantiate_from_snapshot(snapshot, 8192, error_buf,
+                                                  sizeof(error_buf));
+    ASSERT_NE(inst, nullptr) << error_buf;
+    EXPECT_EQ(load(inst, 100), 5u);
+    store(inst, 200, 6);
+    wasm_runtime_deinstantiate(inst);
+
+    /* Neither the snapshot data nor the writes are left in the slot */
+    inst = instantiate();
+    ASSERT_NE(inst, nullptr);
+    EXPECT_EQ(load(inst, 100), 0u);
+    EXPECT_EQ(load(inst, 200), 0u);
+    wasm_runtime_deinstantiate(inst);
+
+    ASSERT_TRUE(wasm_runtime_get_linear_memory_pool_stats(&stats));
+    EXPECT_EQ(stats.reuse_count, 2u);
+    EXPECT_EQ(stats.fallback_count, 0u);
+
+    wasm_runtime_destroy_instance_snapshot(snapshot);
+}
+#endif
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "bh_platform.h"
+#include "mem_alloc.h"
+
+#define POOL_SIZE (256 * 1024)
+
+class mem_alloc_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        allocator = mem_allocator_create(pool, sizeof(pool));
+        ASSERT_NE(allocator, nullptr);
+        initial_free = free_size();
+    }
+
+    virtual void TearDown()
+    {
+        if (allocator)
+            mem_allocator_destroy(allocator);
+    }
+
+    uint32 free_size()
+    {
+        uint32 info[3] = { 0 };
+
+        mem_allocator_get_alloc_info(allocator, info);
+        return info[1];
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    uint8 pool[POOL_SIZE];
+    mem_allocator_t allocator = nullptr;
+    uint32 initial_free = 0;
+};
+
+TEST_F(mem_alloc_test, largest_free_size)
+{
+    void *p, *q, *r;
+
+    EXPECT_EQ(mem_allocator_get_largest_free_size(allocator), initial_free);
+
+    /* Pin a block in the middle of the pool, the free space is split */
+    p = mem_allocator_malloc(allocator, POOL_SIZE / 2 - 1024);
+    q = mem_allocator_malloc(allocator, 64);
+    r = mem_allocator_malloc(allocator, 1024);
+    ASSERT_NE(p, nullptr);
+    ASSERT_NE(q, nullptr);
+    ASSERT_NE(r, nullptr);
+    mem_allocator_free(allocator, p);
+    mem_allocator_free(allocator, r);
+
+    EXPECT_LT(mem_allocator_get_largest_free_size(allocator),
+              free_size() - POOL_SIZE / 4);
+    EXPECT_GT(mem_allocator_get_largest_free_size(allocator), POOL_SIZE / 4);
+
+    mem_allocator_free(allocator, q);
+    EXPECT_EQ(mem_allocator_get_largest_free_size(allocator), initial_free);
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "wasm_runtime_common.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (import "env" "sum" (func (param i32 i32 i32 i64) (result i64)))
+ *   (import "env" "buf_sum" (func (param i32 i32) (result i32)))
+ *   (import "env" "str_len" (func (param i32) (result i32)))
+ *   (import "env" "store" (func (param i32)))
+ *   (import "env" "many"
+ *     (func (param i32 i32 i32 i32 i32 i32 i32 i32) (result i32)))
+ *   (import "env" "fmul" (func (param f32) (result f32)))
+ *   (memory 1)
+ *   (data (i32.const 16) "hello\00")
+ *   (data (i32.const 32) "\01\02\03\04")
+ *   (func (export "call_sum") (param i32 i32 i32 i64) (result i64)
+ *     (call 0 (local.get 0) (local.get 1) (local.get 2) (local.get 3)))
+ *   (func (export "call_buf_sum") (param i32 i32) (result i32)
+ *     (call 1 (local.get 0) (local.get 1)))
+ *   (func (export "call_str_len") (param i32) (result i32)
+ *     (call 2 (local.get 0)))
+ *   (func (export "call_store") (param i32)
+ *     (call 3 (local.get 0)))
+ *   (func (export "call_many")
+ *     (param i32 i32 i32 i32 i32 i32 i32 i32) (result i32)
+ *     (call 4 (local.get 0) (local.get 1) (local.get 2) (local.get 3)
+ *             (local.get 4) (local.get 5) (local.get 6) (local.get 7)))
+ *   (func (export "call_fmul") (param f32) (result f32)
+ *     (call 5 (local.get 0))))
+ */
+static const uint8_t natives_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x29, 0x06, 0x60,
+    0x04, 0x7F, 0x7F, 0x7F, 0x7E, 0x01, 0x7E, 0x60, 0x02, 0x7F, 0x7F, 0x01,
+    0x7F, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x00, 0x60, 0x08,
+    0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x01,
+    0x7D, 0x01, 0x7D, 0x02, 0x49, 0x06, 0x03, 0x65, 0x6E, 0x76, 0x03, 0x73,
+    0x75, 0x6D, 0x00, 0x00, 0x03, 0x65, 0x6E, 0x76, 0x07, 0x62, 0x75, 0x66,
+    0x5F, 0x73, 0x75, 0x6D, 0x00, 0x01, 0x03, 0x65, 0x6E, 0x76, 0x07, 0x73,
+    0x74, 0x72, 0x5F, 0x6C, 0x65, 0x6E, 0x00, 0x02, 0x03, 0x65, 0x6E, 0x76,
+    0x05, 0x73, 0x74, 0x6F, 0x72, 0x65, 0x00, 0x03, 0x03, 0x65, 0x6E, 0x76,
+    0x04, 0x6D, 0x61, 0x6E, 0x79, 0x00, 0x04, 0x03, 0x65, 0x6E, 0x76, 0x04,
+    0x66, 0x6D, 0x75, 0x6C, 0x00, 0x05, 0x03, 0x07, 0x06, 0x00, 0x01, 0x02,
+    0x03, 0x04, 0x05, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x4F, 0x06, 0x08,
+    0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x73, 0x75, 0x6D, 0x00, 0x06, 0x0C, 0x63,
+    0x61, 0x6C, 0x6C, 0x5F, 0x62, 0x75, 0x66, 0x5F, 0x73, 0x75, 0x6D, 0x00,
+    0x07, 0x0C, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x73, 0x74, 0x72, 0x5F, 0x6C,
+    0x65, 0x6E, 0x00, 0x08, 0x0A, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x73, 0x74,
+    0x6F, 0x72, 0x65, 0x00, 0x09, 0x09, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x6D,
+    0x61, 0x6E, 0x79, 0x00, 0x0A, 0x09, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x66,
+    0x6D, 0x75, 0x6C, 0x00, 0x0B, 0x0A, 0x41, 0x06, 0x0C, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x02, 0x20, 0x03, 0x10, 0x00, 0x0B, 0x08, 0x00, 0x20,
+    0x00, 0x20, 0x01, 0x10, 0x01, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x02,
+    0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x03, 0x0B, 0x14, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x02, 0x20, 0x03, 0x20, 0x04, 0x20, 0x05, 0x20, 0x06,
+    0x20, 0x07, 0x10, 0x04, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x05, 0x0B,
+    0x0B, 0x15, 0x02, 0x00, 0x41, 0x10, 0x0B, 0x06, 0x68, 0x65, 0x6C, 0x6C,
+    0x6F, 0x00, 0x00, 0x41, 0x20, 0x0B, 0x04, 0x01, 0x02, 0x03, 0x04
+};
+
+static int64_t
+sum_wrapper(wasm_exec_env_t exec_env, int32_t a, int32_t b, int32_t c,
+            int64_t d)
+{
+    return (int64_t)a + b + c + d;
+}
+
+static int32_t
+buf_sum_wrapper(wasm_exec_env_t exec_env, uint8_t *buf, uint32_t len)
+{
+    int32_t total = 0;
+
+    for (uint32_t i = 0; i < len; i++)
+        total += buf[i];
+    return total;
+}
+
+static int32_t
+str_len_wrapper(wasm_exec_env_t exec_env, const char *str)
+{
+    return (int32_t)strlen(str);
+}
+
+static void
+store_wrapper(wasm_exec_env_t exec_env, uint32_t *ptr)
+{
+    *ptr = *(uint32_t *)wasm_runtime_get_function_attachment(exec_env);
+}
+
+static int32_t
+many_wrapper(wasm_exec_env_t exec_env, int32_t a, int32_t b, int32_t c,
+             int32_t d, int32_t e, int32_t f, int32_t g, int32_t h)
+{
+    wasm_module_inst_t inst = get_module_inst(exec_env);
+
+    if (h < 0) {
+        wasm_runtime_set_exception(inst, "negative argument");
+        return 0;
+    }
+    return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + 7 * g + 8 * h;
+}
+
+static float
+fmul_wrapper(wasm_exec_env_t exec_env, float a)
+{
+    return a * 2.0f;
+}
+
+static uint32_t store_value = 0x12345678;
+
+static NativeSymbol native_symbols[] = {
+    { "sum", (void *)sum_wrapper, "(iiiI)I", NULL },
+    { "buf_sum", (void *)buf_sum_wrapper, "(*~)i", NULL },
+    { "str_len", (void *)str_len_wrapper, "($)i", NULL },
+    { "store", (void *)store_wrapper, "(*)", &store_value },
+    { "many", (void *)many_wrapper, "(iiiiiiii)i", NULL },
+    { "fmul", (void *)fmul_wrapper, "(f)f", NULL },
+};
+
+class quick_native_call_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(wasm_runtime_register_natives(
+            "env", native_symbols,
+            sizeof(native_symbols) / sizeof(NativeSymbol)));
+
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+    }
+
+    virtual void TearDown()
+    {
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    /* Call the function, return the exception if it traps */
+    std::string call(const char *name, uint32_t argc, uint32_t argv[])
+    {
+        wasm_exec_env_t exec_env = wasm_runtime_get_exec_env_singleton(inst);
+        std::string exception;
+
+        if (!call_wasm_func(exec_env, name, argc, argv)) {
+            if (!wasm_runtime_get_exception(inst))
+                return "function not found";
+            exception = wasm_runtime_get_exception(inst);
+            wasm_runtime_clear_exception(inst);
+        }
+        return exception;
+    }
+
+    bool is_quick(uint32_t func_idx)
+    {
+        WASMModule *wasm_module = (WASMModule *)module;
+
+        return wasm_module->import_functions[func_idx]
+            .u.function.native_call.quick;
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ natives_wasm, sizeof(natives_wasm) };
+    char error_buf[128] = { 0 };
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+};
+
+TEST_F(quick_native_call_test, precompile_signature)
+{
+    uint8_t types[] = { VALUE_TYPE_I32, VALUE_TYPE_I32, VALUE_TYPE_I32,
+                        VALUE_TYPE_I64, VALUE_TYPE_I32, VALUE_TYPE_I32 };
+    WASMFuncType *func_type = (WASMFuncType *)wasm_runtime_malloc(
+        offsetof(WASMFuncType, types) + sizeof(types));
+    WASMNativeCallDesc desc;
+
+    ASSERT_NE(func_type, nullptr);
+    memset(func_type, 0, offsetof(WASMFuncType, types));
+    memcpy(func_type->types, types, sizeof(types));
+    func_type->param_count = 5;
+    func_type->result_count = 1;
+
+    wasm_native_precompile_signature(func_type, "(*~$Ii)i", &desc);
+    EXPECT_TRUE(desc.quick);
+    EXPECT_TRUE(desc.has_ptr_args);
+    EXPECT_EQ(desc.param_count, 5);
+    EXPECT_EQ(desc.ret_cell_num, 1);
+    EXPECT_EQ(desc.arg_kinds[0], NATIVE_ARG_PTR_LEN);
+    EXPECT_EQ(desc.arg_kinds[1], NATIVE_ARG_I32);
+    EXPECT_EQ(desc.arg_kinds[2], NATIVE_ARG_STR);
+    EXPECT_EQ(desc.arg_kinds[3], NATIVE_ARG_I64);
+    EXPECT_EQ(desc.arg_kinds[4], NATIVE_ARG_I32);
+
+    /* A native registered without signature takes integers only */
+    wasm_native_precompile_signature(func_type, NULL, &desc);
+    EXPECT_TRUE(desc.quick);
+    EXPECT_FALSE(desc.has_ptr_args);
+    EXPECT_EQ(desc.arg_kinds[0], NATIVE_ARG_I32);
+
+    /* Memory64 pointers are left to invokeNative */
+    func_type->param_count = 4;
+    func_type->result_count = 0;
+    wasm_native_precompile_signature(func_type, "(ii*I)", &desc);
+    EXPECT_TRUE(desc.quick);
+    EXPECT_EQ(desc.ret_cell_num, 0);
+    wasm_native_precompile_signature(func_type, "(iii*)", &desc);
+    EXPECT_FALSE(desc.quick);
+
+    /* So are floats */
+    func_type->types[1] = VALUE_TYPE_F32;
+    wasm_native_precompile_signature(func_type, "(ifiI)", &desc);
+    EXPECT_FALSE(desc.quick);
+
+    wasm_runtime_free(func_type);
+}
+
+TEST_F(quick_native_call_test, integers)
+{
+    uint32_t argv[5] = { 1, (uint32_t)-2, 3 };
+    uint32_t argv8[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int64_t i64 = INT64_C(0x100000000);
+
+    ASSERT_TRUE(is_quick(0));
+    memcpy(argv + 3, &i64, sizeof(i64));
+    EXPECT_EQ(call("call_sum", 5, argv), "");
+    memcpy(&i64, argv, sizeof(i64));
+    EXPECT_EQ(i64, INT64_C(0x100000002));
+
+    /* Params are passed in order, including the ones on the stack */
+    ASSERT_TRUE(is_quick(4));
+    EXPECT_EQ(call("call_many", 8, argv8), "");
+    EXPECT_EQ(argv8[0], 204u);
+
+    /* Exceptions thrown by the native are reported */
+    argv8[7] = (uint32_t)-1;
+    EXPECT_EQ(call("call_many", 8, argv8), "Exception: negative argument");
+}
+
+TEST_F(quick_native_call_test, pointers)
+{
+    uint32_t argv[2] = { 32, 4 };
+    uint32_t *native;
+
+    ASSERT_TRUE(is_quick(1));
+    EXPECT_EQ(call("call_buf_sum", 2, argv), "");
+    EXPECT_EQ(argv[0], 10u);
+
+    ASSERT_TRUE(is_quick(2));
+    argv[0] = 16;
+    EXPECT_EQ(call("call_str_len", 1, argv), "");
+    EXPECT_EQ(argv[0], 5u);
+
+    /* The attachment is set for the native */
+    ASSERT_TRUE(is_quick(3));
+    argv[0] = 64;
+    EXPECT_EQ(call("call_store", 1, argv), "");
+    native = (uint32_t *)wasm_runtime_addr_app_to_native(inst, 64);
+    EXPECT_EQ(*native, store_value);
+
+    /* Pointers are validated with their lengths */
+    argv[0] = 65534;
+    argv[1] = 2;
+    EXPECT_EQ(call("call_buf_sum", 2, argv), "");
+    argv[0] = 65534;
+    argv[1] = 3;
+    EXPECT_EQ(call("call_buf_sum", 2, argv),
+              "Exception: out of bounds memory access");
+    argv[0] = 65536;
+    EXPECT_EQ(call("call_store", 1, argv),
+              "Exception: out of bounds memory access");
+}
+
+TEST_F(quick_native_call_test, fallback)
+{
+    float value = 1.5f;
+    uint32_t argv[1];
+
+    /* Float params are still marshalled by invokeNative */
+    EXPECT_FALSE(is_quick(5));
+    memcpy(argv, &value, sizeof(value));
+    EXPECT_EQ(call("call_fmul", 1, argv), "");
+    memcpy(&value, argv, sizeof(value));
+    EXPECT_EQ(value, 3.0f);
+}
@@ -14,6 +14,8 @@
 #include "wasm_export.h"
 #include "aot_runtime.h"
 
+#include <dirent.h>
+
 namespace {
 
 std::string CWD;
@@ -55,6 +57,7 @@ class wasm_running_modes_test_suite : public testing::TestWithParam<RunningMode>
         return std::string(cwd);
     }
 
+  protected:
     bool load_wasm_file(const char *wasm_file)
     {
         const char *file;
@@ -105,6 +108,11 @@ class wasm_running_modes_test_suite : public testing::TestWithParam<RunningMode>
         return false;
     }
 
+    /* Set the init args needed by the test before the runtime is
+       initialized, the runtime can't be initialized again in the same
+       process since wasm_runtime_destroy shuts down LLVM */
+    virtual void set_init_args() {}
+
     void destory_exec_env()
     {
         wasm_runtime_destroy_exec_env(exec_env);
@@ -112,7 +120,6 @@ class wasm_running_modes_test_suite : public testing::TestWithParam<RunningMode>
         wasm_runtime_unload(module);
     }
 
-  protected:
     void run_wasm_basic(
         char *filename, bool in_default_running_mode,
         RunningMode running_mode = static_cast<RunningMode>(Mode_Default))
@@ -206,6 +213,7 @@ class wasm_running_modes_test_suite : public testing::TestWithParam<RunningMode>
         init_args.mem_alloc_type = Alloc_With_Pool;
         init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
         init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        set_init_args();
 
         ASSERT_EQ(wasm_runtime_full_init(&init_args), true);
 
@@ -302,6 +310,162 @@ TEST_P(wasm_running_modes_test_suite,
     }
 }
 
+#if WASM_ENABLE_JIT != 0
+/* Returns the count of the entries in dir_path, and the path of the
+   last one if path isn't NULL */
+static uint32
+count_dir_files(const char *dir_path, std::string *path = NULL)
+{
+    DIR *dir = opendir(dir_path);
+    struct dirent *entry;
+    uint32 count = 0;
+
+    if (!dir)
+        return 0;
+    while ((entry = readdir(dir))) {
+        if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+            if (path)
+                *path = std::string(dir_path) + "/" + entry->d_name;
+            count++;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+static void
+remove_dir(const char *dir_path)
+{
+    DIR *dir = opendir(dir_path);
+    struct dirent *entry;
+
+    if (!dir)
+        return;
+    while ((entry = readdir(dir))) {
+        if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+            std::string path = std::string(dir_path) + "/" + entry->d_name;
+            if (entry->d_type == DT_DIR)
+                remove_dir(path.c_str());
+            else
+                unlink(path.c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(dir_path);
+}
+
+class wasm_running_modes_jit_cache_test : public wasm_running_modes_test_suite
+{
+  protected:
+    virtual void set_init_args()
+    {
+        strcpy(cache_dir, "/tmp/wamr-jit-cache-XXXXXX");
+        ASSERT_TRUE(mkdtemp(cache_dir) != NULL);
+        init_args.llvm_jit_cache_dir = cache_dir;
+    }
+
+    virtual void TearDown()
+    {
+        wasm_running_modes_test_suite::TearDown();
+        remove_dir(cache_dir);
+    }
+
+    char cache_dir[32];
+};
+
+TEST_F(wasm_running_modes_jit_cache_test, llvm_jit_cache_dir)
+{
+    std::string module_dir, module_dir2;
+    uint32 file_count;
+
+    /* The first load fills the cache, the objects of a module are kept in
+       the directory named by its key */
+    run_wasm_basic(WASM_FILE_1, false, Mode_LLVM_JIT);
+    ASSERT_EQ(count_dir_files(cache_dir, &module_dir), 1u);
+    file_count = count_dir_files(module_dir.c_str());
+    ASSERT_GT(file_count, 0);
+#if WASM_ENABLE_FAST_JIT == 0 && WASM_ENABLE_LAZY_JIT == 0
+    /* All the functions are compiled when the module is loaded, so the
+       next run doesn't translate the module */
+    ASSERT_EQ(access((module_dir + "/manifest").c_str(), F_OK), 0);
+#endif
+
+    /* Each module has its own jit instance, so loading the module again
+       loads the cached objects */
+    run_wasm_basic(WASM_FILE_1, false, Mode_LLVM_JIT);
+    ASSERT_EQ(count_dir_files(cache_dir, &module_dir2), 1u);
+    ASSERT_EQ(module_dir2, module_dir);
+    ASSERT_GE(count_dir_files(module_dir.c_str()), file_count);
+}
+#endif
+
+#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_FAST_JIT != 0 \
+    && WASM_ENABLE_LAZY_JIT != 0
+class wasm_running_modes_tierup_test : public wasm_running_modes_test_suite
+{
+  protected:
+    virtual void set_init_args() { init_args.tierup_hotness_threshold = 100; }
+};
+
+TEST_F(wasm_running_modes_tierup_test, multi_tier_jit_tierup_threshold)
+{
+    uint32 wasm_argv[1], func_idx, i;
+    wasm_function_inst_t echo;
+    WASMModule *wasm_module;
+    bool compiled = false;
+
+    ASSERT_TRUE(load_wasm_file(WASM_FILE_1));
+    ASSERT_TRUE(init_exec_env());
+    ASSERT_TRUE(
+        wasm_runtime_set_running_mode(module_inst, Mode_Multi_Tier_JIT));
+
+    echo = wasm_runtime_lookup_function(module_inst, "echo");
+    ASSERT_TRUE(echo != NULL);
+    wasm_module = (WASMModule *)module;
+    func_idx = (uint32)((WASMFunctionInstance *)echo
+                        - ((WASMModuleInstance *)module_inst)->e->functions)
+               - wasm_module->import_function_count;
+
+    /* The function isn't compiled by llvm jit before it gets hot */
+    for (i = 0; i < 50; i++) {
+        wasm_argv[0] = 5;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, echo, 1, wasm_argv));
+        ASSERT_EQ(10, wasm_argv[0]);
+    }
+    usleep(100 * 1000);
+    ASSERT_FALSE(wasm_module->func_ptrs_compiled[func_idx]);
+
+    for (i = 0; i < 100; i++) {
+        wasm_argv[0] = 5;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, echo, 1, wasm_argv));
+        ASSERT_EQ(10, wasm_argv[0]);
+    }
+    for (i = 0; i < 1000 && !compiled; i++) {
+        usleep(10 * 1000);
+        compiled = wasm_module->func_ptrs_compiled[func_idx];
+    }
+    ASSERT_TRUE(compiled);
+
+    /* The llvm jit code is called after the tier-up */
+    wasm_argv[0] = 7;
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, echo, 1, wasm_argv));
+    ASSERT_EQ(14, wasm_argv[0]);
+
+    destory_exec_env();
+}
+#endif
+
+#if WASM_ENABLE_FAST_JIT != 0
+TEST_F(wasm_running_modes_test_suite, fast_jit_opt_level)
+{
+    wasm_runtime_destroy();
+    init_args.fast_jit_opt_level = 2;
+    ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+    run_wasm_basic(WASM_FILE_1, false, Mode_Fast_JIT);
+    run_wasm_complex(WASM_FILE_1, WASM_FILE_2, Mode_Fast_JIT, Mode_Fast_JIT);
+}
+#endif
+
 INSTANTIATE_TEST_CASE_P(RunningMode, wasm_running_modes_test_suite,
                         testing::ValuesIn(running_mode_supportted));
 
@@ -9,6 +9,7 @@
 file_names=("main")
 
 WORKDIR="$PWD"
+OUT_DIR="${1:-${WORKDIR}/wasm-apps}"
 WAMRC_ROOT_DIR="${WORKDIR}/../../../wamr-compiler"
 WAMRC="${WAMRC_ROOT_DIR}/build/wamrc"
 WAST2WASM="/opt/wabt/bin/wat2wasm"
@@ -26,6 +27,6 @@ fi
 # Iterate over the files array
 for file_name in "${file_names[@]}"; do
     # compile wasm to aot
-    $WAMRC -o "wasm-apps/${file_name}.aot" "wasm-apps/${file_name}.wasm"
+    $WAMRC -o "${OUT_DIR}/${file_name}.aot" "wasm-apps/${file_name}.wasm"
 done
 
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (func (export "spin") (param i32) (result i32) (local i32)
+ *     (loop
+ *       (local.set 1 (i32.add (local.get 1) (i32.const 1)))
+ *       (br_if 0 (i32.lt_u (local.get 1) (local.get 0))))
+ *     (local.get 1))
+ *   (func (export "run") (param i32) (result i32)
+ *     (call 0 (local.get 0))))
+ */
+static const uint8_t spin_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x03, 0x03, 0x02, 0x00, 0x00, 0x07, 0x0E, 0x02,
+    0x04, 0x73, 0x70, 0x69, 0x6E, 0x00, 0x00, 0x03, 0x72, 0x75, 0x6E, 0x00,
+    0x01, 0x0A, 0x20, 0x02, 0x17, 0x01, 0x01, 0x7F, 0x03, 0x40, 0x20, 0x01,
+    0x41, 0x01, 0x6A, 0x21, 0x01, 0x20, 0x01, 0x20, 0x00, 0x49, 0x0D, 0x00,
+    0x0B, 0x20, 0x01, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0B
+};
+
+/*
+ * (module
+ *   (import "sub" "spin" (func $spin (param i32) (result i32)))
+ *   (func (export "run_sub") (param i32) (result i32)
+ *     (call $spin (local.get 0))))
+ *
+ * The sub module is spin_wasm
+ */
+static const uint8_t main_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x02, 0x0C, 0x01, 0x03, 0x73, 0x75, 0x62, 0x04,
+    0x73, 0x70, 0x69, 0x6E, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x0B,
+    0x01, 0x07, 0x72, 0x75, 0x6E, 0x5F, 0x73, 0x75, 0x62, 0x00, 0x01, 0x0A,
+    0x08, 0x01, 0x06, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0B
+};
+
+#define PROFILE_FILE "sampling_profiler_test.prof"
+
+static bool
+read_sub_module(package_type_t module_type, const char *module_name,
+                uint8_t **p_buffer, uint32_t *p_size)
+{
+    /* The loader may modify the buffer */
+    if (strcmp(module_name, "sub") != 0
+        || !(*p_buffer = (uint8_t *)malloc(sizeof(spin_wasm))))
+        return false;
+    memcpy(*p_buffer, spin_wasm, sizeof(spin_wasm));
+    *p_size = sizeof(spin_wasm);
+    return true;
+}
+
+static void
+destroy_sub_module(uint8_t *buffer, uint32_t size)
+{
+    free(buffer);
+}
+
+class sampling_profiler_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(inst, 8192);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+        remove(PROFILE_FILE);
+    }
+
+    /* Keep the cpu busy in wasm code for at least 200ms */
+    void spin(wasm_module_inst_t module_inst, wasm_exec_env_t env,
+              const char *name)
+    {
+        uint64 start = os_time_get_boot_us();
+        uint32_t argv[1];
+
+        while (os_time_get_boot_us() - start < 200 * 1000) {
+            argv[0] = 1000000;
+            ASSERT_TRUE(call_wasm_func(env, name, 1, argv))
+                << wasm_runtime_get_exception(module_inst);
+            ASSERT_EQ(argv[0], 1000000u);
+        }
+    }
+
+    void spin() { spin(inst, exec_env, "run"); }
+
+    /* Returns the total count and the count of the stack in the
+       collapsed profile */
+    void count_stack(const std::string &profile, const char *stack,
+                     uint32_t *p_total, uint32_t *p_count)
+    {
+        std::istringstream lines(profile);
+        std::string line;
+
+        *p_total = *p_count = 0;
+        while (std::getline(lines, line)) {
+            size_t pos = line.rfind(' ');
+
+            ASSERT_NE(pos, std::string::npos) << line;
+            *p_total += (uint32_t)atoi(line.c_str() + pos + 1);
+            if (line.compare(0, pos, stack) == 0)
+                *p_count += (uint32_t)atoi(line.c_str() + pos + 1);
+        }
+    }
+
+    std::string read_profile()
+    {
+        std::ifstream file(PROFILE_FILE, std::ios::binary);
+        std::stringstream content;
+
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    /* The profiler allocates its tables from the runtime heap */
+    WAMRRuntimeRAII<4 * 1024 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ spin_wasm, sizeof(spin_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(sampling_profiler_test, collapsed_stacks)
+{
+    uint32_t total, spin_count;
+
+    ASSERT_TRUE(wasm_runtime_start_profiling(1000));
+    spin();
+    ASSERT_TRUE(wasm_runtime_stop_profiling());
+    ASSERT_TRUE(wasm_runtime_write_profile(PROFILE_FILE,
+                                           WASM_PROFILE_FORMAT_COLLAPSED));
+
+    /* From the outermost frame to the innermost frame */
+    count_stack(read_profile(), "run;spin", &total, &spin_count);
+    EXPECT_GT(total, 0u) << read_profile();
+    EXPECT_GT(spin_count, 0u) << read_profile();
+    EXPECT_GE(spin_count * 2, total) << read_profile();
+}
+
+TEST_F(sampling_profiler_test, sub_module)
+{
+    WAMRWasmBuffer buf(main_wasm, sizeof(main_wasm));
+    wasm_module_t main_module;
+    wasm_module_inst_t main_inst;
+    wasm_exec_env_t main_exec_env;
+    uint32_t total, spin_count;
+
+    wasm_runtime_set_module_reader(read_sub_module, destroy_sub_module);
+    main_module = wasm_runtime_load(buf.data(), buf.size(), error_buf,
+                                    sizeof(error_buf));
+    ASSERT_NE(main_module, nullptr) << error_buf;
+    main_inst = wasm_runtime_instantiate(main_module, 8192, 0, error_buf,
+                                         sizeof(error_buf));
+    ASSERT_NE(main_inst, nullptr) << error_buf;
+    main_exec_env = wasm_runtime_create_exec_env(main_inst, 8192);
+    ASSERT_NE(main_exec_env, nullptr);
+
+    ASSERT_TRUE(wasm_runtime_start_profiling(1000));
+    spin(main_inst, main_exec_env, "run_sub");
+    ASSERT_TRUE(wasm_runtime_stop_profiling());
+    ASSERT_TRUE(wasm_runtime_write_profile(PROFILE_FILE,
+                                           WASM_PROFILE_FORMAT_COLLAPSED));
+
+    wasm_runtime_destroy_exec_env(main_exec_env);
+    wasm_runtime_deinstantiate(main_inst);
+    wasm_runtime_unload(main_module);
+    wasm_runtime_set_module_reader(NULL, NULL);
+
+    /* The imported function runs on the exec_env of the main module, each
+       frame is named by the module it belongs to */
+    count_stack(read_profile(), "run_sub;spin", &total, &spin_count);
+    EXPECT_GT(total, 0u) << read_profile();
+    EXPECT_GT(spin_count, 0u) << read_profile();
+    EXPECT_GE(spin_count * 2, total) << read_profile();
+}
+
+TEST_F(sampling_profiler_test, pprof)
+{
+    std::string profile;
+
+    ASSERT_TRUE(wasm_runtime_start_profiling(1000));
+    spin();
+    ASSERT_TRUE(wasm_runtime_stop_profiling());
+    ASSERT_TRUE(
+        wasm_runtime_write_profile(PROFILE_FILE, WASM_PROFILE_FORMAT_PPROF));
+
+    profile = read_profile();
+    ASSERT_GT(profile.size(), 2u);
+    /* Starts with the sample_type field, which is length-delimited */
+    EXPECT_EQ((uint8_t)profile[0], (1 << 3) | 2);
+    EXPECT_NE(profile.find("spin"), std::string::npos);
+    EXPECT_NE(profile.find("nanoseconds"), std::string::npos);
+}
+
+TEST_F(sampling_profiler_test, start_stop)
+{
+    EXPECT_FALSE(wasm_runtime_stop_profiling());
+
+    ASSERT_TRUE(wasm_runtime_start_profiling(0));
+    EXPECT_FALSE(wasm_runtime_start_profiling(0));
+    /* The profile can't be written while sampling */
+    EXPECT_FALSE(wasm_runtime_write_profile(PROFILE_FILE,
+                                            WASM_PROFILE_FORMAT_COLLAPSED));
+    EXPECT_TRUE(wasm_runtime_stop_profiling());
+    EXPECT_FALSE(wasm_runtime_stop_profiling());
+
+    /* No sample recorded, the profile is empty */
+    EXPECT_TRUE(wasm_runtime_write_profile(PROFILE_FILE,
+                                           WASM_PROFILE_FORMAT_COLLAPSED));
+    EXPECT_EQ(read_profile(), "");
+}
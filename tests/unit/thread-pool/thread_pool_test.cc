@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+/*
+ * (module
+ *   (import "wasi" "thread-spawn" (func $spawn (param i32) (result i32)))
+ *   (memory (export "memory") 1 1 shared)
+ *   (global $g (mut i32) (i32.const 0))
+ *   (func (export "wasi_thread_start") (param i32 i32)
+ *     ;; $g is 1 in every thread unless a reused instance isn't reset
+ *     (global.set $g (i32.add (global.get $g) (i32.const 1)))
+ *     (drop (i32.atomic.rmw.add (i32.const 0) (global.get $g)))
+ *     (drop (i32.atomic.rmw.add (i32.const 4) (i32.const 1))))
+ *   (func (export "_start") (local $i i32)
+ *     ;; spawn 50 threads, retry when the max thread num is reached
+ *     (block (loop
+ *       (br_if 1 (i32.ge_u (local.get $i) (i32.const 50)))
+ *       (if (i32.gt_s (call $spawn (i32.const 0)) (i32.const 0))
+ *         (then (local.set $i (i32.add (local.get $i) (i32.const 1)))))
+ *       (br 0)))
+ *     (block (loop
+ *       (br_if 0 (i32.lt_u (i32.atomic.load (i32.const 4)) (i32.const 50)))))
+ *     (if (i32.ne (i32.atomic.load (i32.const 0)) (i32.const 50))
+ *       (then (unreachable)))))
+ */
+static const uint8_t spawn_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E, 0x03, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x02, 0x7F, 0x7F, 0x00, 0x60, 0x00, 0x00,
+    0x02, 0x15, 0x01, 0x04, 0x77, 0x61, 0x73, 0x69, 0x0C, 0x74, 0x68, 0x72,
+    0x65, 0x61, 0x64, 0x2D, 0x73, 0x70, 0x61, 0x77, 0x6E, 0x00, 0x00, 0x03,
+    0x03, 0x02, 0x01, 0x02, 0x05, 0x04, 0x01, 0x03, 0x01, 0x01, 0x06, 0x06,
+    0x01, 0x7F, 0x01, 0x41, 0x00, 0x0B, 0x07, 0x27, 0x03, 0x06, 0x6D, 0x65,
+    0x6D, 0x6F, 0x72, 0x79, 0x02, 0x00, 0x11, 0x77, 0x61, 0x73, 0x69, 0x5F,
+    0x74, 0x68, 0x72, 0x65, 0x61, 0x64, 0x5F, 0x73, 0x74, 0x61, 0x72, 0x74,
+    0x00, 0x01, 0x06, 0x5F, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x02, 0x0A,
+    0x60, 0x02, 0x1B, 0x00, 0x23, 0x00, 0x41, 0x01, 0x6A, 0x24, 0x00, 0x41,
+    0x00, 0x23, 0x00, 0xFE, 0x1E, 0x02, 0x00, 0x1A, 0x41, 0x04, 0x41, 0x01,
+    0xFE, 0x1E, 0x02, 0x00, 0x1A, 0x0B, 0x42, 0x01, 0x01, 0x7F, 0x02, 0x40,
+    0x03, 0x40, 0x20, 0x00, 0x41, 0x32, 0x4F, 0x0D, 0x01, 0x41, 0x00, 0x10,
+    0x00, 0x41, 0x00, 0x4A, 0x04, 0x40, 0x20, 0x00, 0x41, 0x01, 0x6A, 0x21,
+    0x00, 0x0B, 0x0C, 0x00, 0x0B, 0x0B, 0x02, 0x40, 0x03, 0x40, 0x41, 0x04,
+    0xFE, 0x10, 0x02, 0x00, 0x41, 0x32, 0x49, 0x0D, 0x00, 0x0B, 0x0B, 0x41,
+    0x00, 0xFE, 0x10, 0x02, 0x00, 0x41, 0x32, 0x47, 0x04, 0x40, 0x00, 0x0B,
+    0x0B
+};
+
+class thread_pool_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+    }
+
+    virtual void TearDown()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+        wasm_runtime_set_thread_pool_options(0, 1000);
+    }
+
+    /* Spawn the threads from a new instance, and destroy the instance
+       with the threads and module instances kept by its cluster */
+    bool run_spawn()
+    {
+        wasm_module_inst_t inst;
+        bool ret;
+
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        EXPECT_NE(inst, nullptr) << error_buf;
+        if (!inst)
+            return false;
+
+        ret = call_wasm_func(inst, "_start", 0, NULL);
+        EXPECT_TRUE(ret) << wasm_runtime_get_exception(inst);
+
+        wasm_runtime_deinstantiate(inst);
+        return ret;
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    WAMRWasmBuffer wasm_buf{ spawn_wasm, sizeof(spawn_wasm) };
+    char error_buf[128];
+    wasm_module_t module = nullptr;
+};
+
+TEST_F(thread_pool_test, spawn_without_pool)
+{
+    wasm_runtime_set_thread_pool_options(0, 1000);
+    EXPECT_TRUE(run_spawn());
+}
+
+TEST_F(thread_pool_test, spawn_with_pool)
+{
+    wasm_runtime_set_thread_pool_options(2, 1000);
+    EXPECT_TRUE(run_spawn());
+    EXPECT_TRUE(run_spawn());
+}
+
+TEST_F(thread_pool_test, pool_larger_than_max_thread_num)
+{
+    wasm_runtime_set_max_thread_num(2);
+    wasm_runtime_set_thread_pool_options(8, 0);
+    EXPECT_TRUE(run_spawn());
+    wasm_runtime_set_max_thread_num(CLUSTER_MAX_THREAD_NUM);
+}
+
+TEST_F(thread_pool_test, short_idle_timeout)
+{
+    wasm_runtime_set_thread_pool_options(1, 1);
+    EXPECT_TRUE(run_spawn());
+}
@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "wasm_export.h"
+#include "bh_platform.h"
+
+#include <sys/socket.h>
+
+/*
+ * (module
+ *   (import "wasi_snapshot_preview1" "fd_transfer"
+ *     (func $fd_transfer (param i32 i64 i32 i32 i32) (result i32)))
+ *   (import "wasi_snapshot_preview1" "fd_write"
+ *     (func $fd_write (param i32 i32 i32 i32) (result i32)))
+ *   (memory (export "memory") 1)
+ *   (func (export "transfer") (param i32 i64 i32 i32) (result i32)
+ *     (call $fd_transfer (local.get 0) (local.get 1) (local.get 2)
+ *                        (local.get 3) (i32.const 0)))
+ *   (func (export "write") (param i32 i32 i32) (result i32)
+ *     (call $fd_write (local.get 0) (local.get 1) (local.get 2)
+ *                     (i32.const 0))))
+ */
+static const uint8_t transfer_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x21, 0x04, 0x60,
+    0x05, 0x7F, 0x7E, 0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x04, 0x7F, 0x7F,
+    0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x04, 0x7F, 0x7E, 0x7F, 0x7F, 0x01, 0x7F,
+    0x60, 0x03, 0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x02, 0x48, 0x02, 0x16, 0x77,
+    0x61, 0x73, 0x69, 0x5F, 0x73, 0x6E, 0x61, 0x70, 0x73, 0x68, 0x6F, 0x74,
+    0x5F, 0x70, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x31, 0x0B, 0x66, 0x64,
+    0x5F, 0x74, 0x72, 0x61, 0x6E, 0x73, 0x66, 0x65, 0x72, 0x00, 0x00, 0x16,
+    0x77, 0x61, 0x73, 0x69, 0x5F, 0x73, 0x6E, 0x61, 0x70, 0x73, 0x68, 0x6F,
+    0x74, 0x5F, 0x70, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x31, 0x08, 0x66,
+    0x64, 0x5F, 0x77, 0x72, 0x69, 0x74, 0x65, 0x00, 0x01, 0x03, 0x03, 0x02,
+    0x02, 0x03, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x1D, 0x03, 0x06, 0x6D,
+    0x65, 0x6D, 0x6F, 0x72, 0x79, 0x02, 0x00, 0x08, 0x74, 0x72, 0x61, 0x6E,
+    0x73, 0x66, 0x65, 0x72, 0x00, 0x02, 0x05, 0x77, 0x72, 0x69, 0x74, 0x65,
+    0x00, 0x03, 0x0A, 0x1D, 0x02, 0x0E, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x02, 0x20, 0x03, 0x41, 0x00, 0x10, 0x00, 0x0B, 0x0C, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x20, 0x02, 0x41, 0x00, 0x10, 0x01, 0x0B
+};
+
+static int
+create_temp_file(const char *data)
+{
+    char path[] = "/tmp/wasi_fd_transfer_test_XXXXXX";
+    int fd = mkstemp(path);
+
+    if (fd < 0)
+        return -1;
+    unlink(path);
+    if (write(fd, data, strlen(data)) != (ssize_t)strlen(data)
+        || lseek(fd, 0, SEEK_SET) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static std::string
+read_all(int fd, size_t len)
+{
+    std::string str(len, '\0');
+    ssize_t n = read(fd, &str[0], len);
+
+    str.resize(n > 0 ? (size_t)n : 0);
+    return str;
+}
+
+class wasi_fd_transfer_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_EQ(pipe(fds), 0);
+        file = create_temp_file("hello world");
+        ASSERT_GE(file, 0);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (inst)
+            wasm_runtime_deinstantiate(inst);
+        if (module)
+            wasm_runtime_unload(module);
+        close(fds[0]);
+        close(fds[1]);
+        close(file);
+    }
+
+    /* Instantiate the module with file as stdin and the pipe as stdout */
+    void instantiate()
+    {
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        wasm_runtime_set_wasi_args_ex(module, NULL, 0, NULL, 0, NULL, 0, NULL,
+                                      0, file, fds[1], -1);
+        inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                        sizeof(error_buf));
+        ASSERT_NE(inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(inst, 8192);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    int32_t call(const char *name, uint32_t argc, uint32_t argv[])
+    {
+        const char *e;
+
+        exception.clear();
+        if (!call_wasm_func(exec_env, name, argc, argv)) {
+            /* no exception is thrown if the function isn't found */
+            e = wasm_runtime_get_exception(inst);
+            EXPECT_NE(e, nullptr) << name;
+            if (e) {
+                exception = e;
+                wasm_runtime_clear_exception(inst);
+            }
+            return -1;
+        }
+        return (int32_t)argv[0];
+    }
+
+    int32_t transfer(int32_t fd_in, int64_t offset, int32_t fd_out,
+                     int32_t len)
+    {
+        uint32_t argv[5];
+
+        argv[0] = (uint32_t)fd_in;
+        /* the i64 argument takes two cells */
+        memcpy(&argv[1], &offset, sizeof(int64_t));
+        argv[3] = (uint32_t)fd_out;
+        argv[4] = (uint32_t)len;
+        return call("transfer", 5, argv);
+    }
+
+    int32_t write_iovecs(int32_t fd, uint32_t iovs_offset, uint32_t iovs_len)
+    {
+        uint32_t argv[3] = { (uint32_t)fd, iovs_offset, iovs_len };
+
+        return call("write", 3, argv);
+    }
+
+    /* The number of bytes returned by the last WASI call */
+    uint32_t result_count()
+    {
+        return *(uint32_t *)wasm_runtime_addr_app_to_native(inst, 0);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    int fds[2] = { -1, -1 };
+    int file = -1;
+    WAMRWasmBuffer wasm_buf{ transfer_wasm, sizeof(transfer_wasm) };
+    char error_buf[128];
+    std::string exception;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(wasi_fd_transfer_test, file_to_pipe)
+{
+    size_t n = 0;
+
+    /* The positioned transfer doesn't move the file position */
+    EXPECT_EQ(os_fd_transfer(file, 6, fds[1], 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 5u);
+    EXPECT_EQ(lseek(file, 0, SEEK_CUR), 0);
+    EXPECT_EQ(read_all(fds[0], 64), "world");
+
+    EXPECT_EQ(os_fd_transfer(file, -1, fds[1], 5, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 5u);
+    EXPECT_EQ(lseek(file, 0, SEEK_CUR), 5);
+    EXPECT_EQ(read_all(fds[0], 64), "hello");
+
+    EXPECT_EQ(os_fd_transfer(file, 11, fds[1], 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 0u);
+}
+
+TEST_F(wasi_fd_transfer_test, file_to_file)
+{
+    int out = create_temp_file("");
+    char buf[16] = { 0 };
+    size_t n = 0;
+
+    ASSERT_GE(out, 0);
+    EXPECT_EQ(os_fd_transfer(file, 0, out, 5, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 5u);
+    EXPECT_EQ(os_fd_transfer(file, 5, out, 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 6u);
+    EXPECT_EQ(lseek(out, 0, SEEK_CUR), 11);
+    EXPECT_EQ(pread(out, buf, sizeof(buf), 0), 11);
+    EXPECT_STREQ(buf, "hello world");
+    close(out);
+}
+
+TEST_F(wasi_fd_transfer_test, pipe_to_file)
+{
+    int out = create_temp_file("");
+    char buf[16] = { 0 };
+    size_t n = 0;
+
+    ASSERT_GE(out, 0);
+    ASSERT_EQ(write(fds[1], "abc", 3), 3);
+    /* A pipe has no offset to read at */
+    EXPECT_EQ(os_fd_transfer(fds[0], 0, out, 64, &n), __WASI_ESPIPE);
+    EXPECT_EQ(os_fd_transfer(fds[0], -1, out, 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 3u);
+    EXPECT_EQ(pread(out, buf, sizeof(buf), 0), 3);
+    EXPECT_STREQ(buf, "abc");
+    close(out);
+}
+
+TEST_F(wasi_fd_transfer_test, socket_to_socket)
+{
+    int in[2], out[2];
+    size_t n = 0;
+
+    /* The kernel can't move data between two sockets directly */
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, in), 0);
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, out), 0);
+    ASSERT_EQ(write(in[1], "ping", 4), 4);
+    EXPECT_EQ(os_fd_transfer(in[0], -1, out[0], 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 4u);
+    EXPECT_EQ(read_all(out[1], 64), "ping");
+
+
+    for (int i = 0; i < 2; i++) {
+        close(in[i]);
+        close(out[i]);
+    }
+}
+
+/* Make the handle nonblocking and write to it until it is full */
+static void
+fill_nonblocking(int fd)
+{
+    char buf[4096];
+
+    memset(buf, 'x', sizeof(buf));
+    ASSERT_EQ(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK), 0);
+    while (write(fd, buf, sizeof(buf)) > 0)
+        ;
+    ASSERT_EQ(errno, EAGAIN);
+}
+
+/* Read all the data from a handle which is nonblocking or closed */
+static size_t
+drain(int fd)
+{
+    char buf[4096];
+    size_t total = 0;
+    ssize_t n;
+
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+        total += (size_t)n;
+    return total;
+}
+
+TEST_F(wasi_fd_transfer_test, pipe_to_full_pipe)
+{
+    int out[2];
+    size_t n = 0;
+
+    ASSERT_EQ(pipe(out), 0);
+    ASSERT_EQ(write(fds[1], "abc", 3), 3);
+    fill_nonblocking(out[1]);
+
+    /* The data stays in the input if the output can't take it */
+    EXPECT_EQ(os_fd_transfer(fds[0], -1, out[1], 64, &n), __WASI_EAGAIN);
+    ASSERT_EQ(fcntl(out[0], F_SETFL, O_NONBLOCK), 0);
+    drain(out[0]);
+    EXPECT_EQ(os_fd_transfer(fds[0], -1, out[1], 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 3u);
+    EXPECT_EQ(read_all(out[0], 64), "abc");
+
+    close(out[0]);
+    close(out[1]);
+}
+
+TEST_F(wasi_fd_transfer_test, pipe_to_unsupported)
+{
+    char path[] = "/tmp/wasi_fd_transfer_test_XXXXXX";
+    int out = mkstemp(path);
+    size_t n = 0;
+
+    ASSERT_GE(out, 0);
+    unlink(path);
+    /* splice() can't write to a file opened for appending, and the data
+       read from a pipe can't be given back if the write fails, so it is
+       left to the caller */
+    ASSERT_EQ(fcntl(out, F_SETFL, O_APPEND), 0);
+    ASSERT_EQ(write(fds[1], "abc", 3), 3);
+    EXPECT_EQ(os_fd_transfer(fds[0], -1, out, 64, &n), __WASI_ENOTSUP);
+    EXPECT_EQ(read_all(fds[0], 64), "abc");
+    close(out);
+}
+
+TEST_F(wasi_fd_transfer_test, socket_to_full_socket)
+{
+    int in[2], out[2];
+    std::string sent, received(256 * 1024, '\0');
+    size_t n = 0, nsent = 0, nreceived = 0;
+    ssize_t ret;
+    __wasi_errno_t error;
+
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, in), 0);
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, out), 0);
+    for (int i = 0; i < 2; i++)
+        ASSERT_EQ(fcntl(in[i], F_SETFL, O_NONBLOCK), 0);
+    ASSERT_EQ(fcntl(out[1], F_SETFL, O_NONBLOCK), 0);
+    fill_nonblocking(out[0]);
+
+    /* Nothing is consumed from the input if the output is full */
+    ASSERT_EQ(write(in[1], "ping", 4), 4);
+    EXPECT_EQ(os_fd_transfer(in[0], -1, out[0], 64, &n), __WASI_EAGAIN);
+    drain(out[1]);
+    EXPECT_EQ(os_fd_transfer(in[0], -1, out[0], 64, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 4u);
+    EXPECT_EQ(read_all(out[1], 64), "ping");
+
+    /* The output takes a part of the buffer now and then, the rest must
+       be moved by the next transfers in order */
+    for (size_t i = 0; i < received.size(); i++)
+        sent += (char)(i * 7 + i / 251);
+    while (nreceived < sent.size()) {
+        if (nsent < sent.size()
+            && (ret = write(in[1], sent.data() + nsent, sent.size() - nsent))
+                   > 0)
+            nsent += (size_t)ret;
+        error = os_fd_transfer(in[0], -1, out[0], 64 * 1024, &n);
+        ASSERT_TRUE(error == __WASI_ESUCCESS || error == __WASI_EAGAIN);
+        if ((ret = read(out[1], &received[nreceived],
+                        received.size() - nreceived))
+            > 0)
+            nreceived += (size_t)ret;
+    }
+    EXPECT_TRUE(received == sent);
+
+    for (int i = 0; i < 2; i++) {
+        close(in[i]);
+        close(out[i]);
+    }
+}
+
+TEST_F(wasi_fd_transfer_test, wasi_fd_transfer)
+{
+    instantiate();
+
+    EXPECT_EQ(transfer(0, -1, 1, 5), __WASI_ESUCCESS);
+    EXPECT_EQ(result_count(), 5u);
+    EXPECT_EQ(read_all(fds[0], 64), "hello");
+    EXPECT_EQ(transfer(0, 5, 1, 64), __WASI_ESUCCESS);
+    EXPECT_EQ(result_count(), 6u);
+    EXPECT_EQ(read_all(fds[0], 64), " world");
+    EXPECT_EQ(transfer(0, -1, 1, 64), __WASI_ESUCCESS);
+    EXPECT_EQ(result_count(), 6u);
+    EXPECT_EQ(read_all(fds[0], 64), " world");
+
+    /* Offsets out of the range of the host aren't wrapped around */
+    EXPECT_EQ(transfer(0, INT64_MIN, 1, 64), __WASI_EINVAL);
+    EXPECT_EQ(transfer(0, -1, 9, 64), __WASI_EBADF);
+    EXPECT_EQ(transfer(9, -1, 1, 64), __WASI_EBADF);
+}
+
+TEST_F(wasi_fd_transfer_test, wasi_fd_write_iovecs)
+{
+    const uint32_t iovs_offset = 64, data_offset = 1024;
+    uint32_t *iovs;
+    char *data;
+
+    instantiate();
+    iovs = (uint32_t *)wasm_runtime_addr_app_to_native(inst, iovs_offset);
+    data = (char *)wasm_runtime_addr_app_to_native(inst, data_offset);
+
+    for (uint32_t i = 0; i < 40; i++) {
+        data[i] = (char)('a' + i % 26);
+        iovs[i * 2] = data_offset + i;
+        iovs[i * 2 + 1] = 1;
+    }
+
+    /* Both the iovecs converted on the stack and on the heap */
+    for (uint32_t iovs_len : { 1u, 16u, 17u, 40u }) {
+        EXPECT_EQ(write_iovecs(1, iovs_offset, iovs_len), __WASI_ESUCCESS);
+        EXPECT_EQ(result_count(), iovs_len);
+        EXPECT_EQ(read_all(fds[0], 64), std::string(data, iovs_len));
+    }
+
+    /* An iovec out of the linear memory traps */
+    iovs[2 * 2] = 0x10000;
+    EXPECT_EQ(write_iovecs(1, iovs_offset, 4), -1);
+    EXPECT_NE(exception.find("out of bounds memory access"), std::string::npos);
+    iovs[2 * 2] = data_offset + 2;
+    iovs[20 * 2] = 0x10000;
+    EXPECT_EQ(write_iovecs(1, iovs_offset, 40), -1);
+    EXPECT_NE(exception.find("out of bounds memory access"), std::string::npos);
+}
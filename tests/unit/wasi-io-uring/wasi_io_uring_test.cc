@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "test_helper.h"
+
+#include "bh_platform.h"
+
+#include <arpa/inet.h>
+
+class wasi_io_uring_test : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        ring = os_io_ring_create();
+        if (!ring)
+            GTEST_SKIP() << "io_uring isn't available";
+        ASSERT_EQ(pipe(fds), 0);
+    }
+
+    virtual void TearDown()
+    {
+        if (ring) {
+            os_io_ring_destroy(ring);
+            close(fds[0]);
+            close(fds[1]);
+        }
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    os_io_ring *ring = nullptr;
+    int fds[2] = { -1, -1 };
+};
+
+TEST_F(wasi_io_uring_test, readv_writev)
+{
+    char buf1[3] = { 0 }, buf2[8] = { 0 };
+    struct __wasi_ciovec_t out[2] = { { (const uint8_t *)"hel", 3 },
+                                      { (const uint8_t *)"lo", 2 } };
+    struct __wasi_iovec_t in[2] = { { (uint8_t *)buf1, sizeof(buf1) },
+                                    { (uint8_t *)buf2, sizeof(buf2) } };
+    size_t n = 0;
+
+    EXPECT_EQ(os_io_ring_writev(ring, fds[1], out, 2, -1, &n),
+              __WASI_ESUCCESS);
+    EXPECT_EQ(n, 5u);
+    EXPECT_EQ(os_io_ring_readv(ring, fds[0], in, 2, -1, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 5u);
+    EXPECT_EQ(memcmp(buf1, "hel", 3), 0);
+    EXPECT_STREQ(buf2, "lo");
+
+    /* Errors are converted to WASI errnos */
+    EXPECT_EQ(os_io_ring_readv(ring, fds[1], in, 2, -1, &n), __WASI_EBADF);
+}
+
+TEST_F(wasi_io_uring_test, preadv_pwritev)
+{
+    char path[] = "/tmp/wasi_io_uring_test_XXXXXX";
+    int fd = mkstemp(path);
+    char buf[4] = { 0 };
+    struct __wasi_ciovec_t out = { (const uint8_t *)"abcd", 4 };
+    struct __wasi_iovec_t in = { (uint8_t *)buf, 2 };
+    size_t n = 0;
+
+    ASSERT_GE(fd, 0);
+    unlink(path);
+
+    EXPECT_EQ(os_io_ring_writev(ring, fd, &out, 1, 8, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 4u);
+    /* The file position isn't moved by the positioned write */
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 0);
+    EXPECT_EQ(os_io_ring_readv(ring, fd, &in, 1, 9, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 2u);
+    EXPECT_STREQ(buf, "bc");
+    EXPECT_EQ(os_io_ring_readv(ring, fd, &in, 1, 12, &n), __WASI_ESUCCESS);
+    EXPECT_EQ(n, 0u);
+    close(fd);
+}
+
+TEST_F(wasi_io_uring_test, poll)
+{
+    struct pollfd pfds[3] = { { fds[0], POLLIN, 0 },
+                              { -1, POLLIN, 0 },
+                              { fds[1], POLLOUT, 0 } };
+    uint64 start;
+
+    /* The pipe is always writable */
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 3, -1), 1);
+    EXPECT_EQ(pfds[0].revents, 0);
+    EXPECT_EQ(pfds[1].revents, 0);
+    EXPECT_EQ(pfds[2].revents, POLLOUT);
+
+    /* Time out on the empty pipe */
+    start = os_time_get_boot_us();
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 1, 20), 0);
+    EXPECT_GE(os_time_get_boot_us() - start, 20 * 1000u);
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 1, 0), 0);
+
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 1, 0), 1);
+    EXPECT_EQ(pfds[0].revents, POLLIN);
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 3, 1000), 2);
+    EXPECT_EQ(pfds[0].revents, POLLIN);
+    EXPECT_EQ(pfds[2].revents, POLLOUT);
+
+    close(fds[1]);
+    fds[1] = open("/dev/null", O_RDONLY);
+    EXPECT_EQ(os_io_ring_poll(ring, pfds, 1, 0), 1);
+    EXPECT_TRUE(pfds[0].revents & POLLIN);
+}
+
+TEST_F(wasi_io_uring_test, send_to_recv_from)
+{
+    bh_socket_t socks[2];
+    struct sockaddr_in addr = { 0 };
+    socklen_t addr_len = sizeof(addr);
+    bh_sockaddr_t dest_addr = { 0 }, src_addr = { 0 };
+    char buf[8] = { 0 };
+
+    for (int i = 0; i < 2; i++) {
+        socks[i] = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(socks[i], 0);
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ASSERT_EQ(bind(socks[i], (struct sockaddr *)&addr, sizeof(addr)), 0);
+    }
+
+    ASSERT_EQ(getsockname(socks[1], (struct sockaddr *)&addr, &addr_len), 0);
+    dest_addr.is_ipv4 = true;
+    dest_addr.addr_buffer.ipv4 = INADDR_LOOPBACK;
+    dest_addr.port = ntohs(addr.sin_port);
+
+    EXPECT_EQ(os_io_ring_send_to(ring, socks[0], "ping", 4, 0, &dest_addr),
+              4);
+    EXPECT_EQ(os_io_ring_recv_from(ring, socks[1], buf, sizeof(buf), 0,
+                                   &src_addr),
+              4);
+    EXPECT_STREQ(buf, "ping");
+
+    addr_len = sizeof(addr);
+    ASSERT_EQ(getsockname(socks[0], (struct sockaddr *)&addr, &addr_len), 0);
+    EXPECT_TRUE(src_addr.is_ipv4);
+    EXPECT_EQ(src_addr.addr_buffer.ipv4, (uint32)INADDR_LOOPBACK);
+    EXPECT_EQ(src_addr.port, ntohs(addr.sin_port));
+
+    close(socks[0]);
+    close(socks[1]);
+}
+
+static void
+interrupt_sighandler(int signo)
+{
+    (void)signo;
+}
+
+struct interrupt_data {
+    os_io_ring *ring;
+    int fd;
+    volatile bool done;
+    __wasi_errno_t error;
+};
+
+static void *
+interrupt_thread(void *arg)
+{
+    struct interrupt_data *data = (struct interrupt_data *)arg;
+    char buf[4];
+    struct __wasi_iovec_t in = { (uint8_t *)buf, sizeof(buf) };
+    size_t n;
+
+    data->error = os_io_ring_readv(data->ring, data->fd, &in, 1, -1, &n);
+    data->done = true;
+    return NULL;
+}
+
+TEST_F(wasi_io_uring_test, interrupt)
+{
+    struct interrupt_data data = { ring, fds[0], false, __WASI_ESUCCESS };
+    struct sigaction sa = {}, old_sa;
+    korp_tid tid;
+    char c = 0;
+
+    sa.sa_handler = interrupt_sighandler;
+    sigemptyset(&sa.sa_mask);
+    ASSERT_EQ(sigaction(SIGUSR1, &sa, &old_sa), 0);
+
+    ASSERT_EQ(os_thread_create(&tid, interrupt_thread, &data,
+                               APP_THREAD_STACK_SIZE_DEFAULT),
+              0);
+    /* Keep waking up the thread like wasm_runtime_interrupt_blocking_op */
+    while (!data.done) {
+        os_usleep(10 * 1000);
+        pthread_kill(tid, SIGUSR1);
+    }
+    os_thread_join(tid, NULL);
+    sigaction(SIGUSR1, &old_sa, NULL);
+
+    EXPECT_EQ(data.error, __WASI_EINTR);
+
+    /* The read was canceled and doesn't consume data written later */
+    ASSERT_EQ(write(fds[1], "y", 1), 1);
+    EXPECT_EQ(read(fds[0], &c, 1), 1);
+    EXPECT_EQ(c, 'y');
+}
@@ -145,6 +145,9 @@ print_help()
     printf("                              if the option is set, the status is same as the option value\n");
     printf("  --stack-usage=<file>      Generate a stack-usage file.\n");
     printf("                              Similarly to `clang -fstack-usage`.\n");
+    printf("  --bound-check-report=<file>\n");
+    printf("                            Generate a report of the software bound checks\n");
+    printf("                              of each function, like --stack-usage\n");
     printf("  --format=<format>         Specifies the format of the output file\n");
     printf("                            The format supported:\n");
     printf("                              aot (default)  AoT file\n");
@@ -182,6 +185,10 @@ print_help()
     printf("                            Use comma to separate, please refer to doc/xip.md for full list.\n");
     printf("  --disable-llvm-lto        Disable the LLVM link time optimization\n");
     printf("  --enable-llvm-pgo         Enable LLVM PGO (Profile-Guided Optimization)\n");
+    printf("  --jobs=n                  Generate the machine code with n threads, the optimized module is\n");
+    printf("                              split into partitions whose object files are emitted in parallel\n");
+    printf("                              and merged, the output is the same for any n. It is ignored if\n");
+    printf("                              LLVM PGO is enabled or the target isn't x86_64 or aarch64\n");
     printf("  --enable-llvm-passes=<passes>\n");
     printf("                            Enable the specified LLVM passes, using comma to separate\n");
     printf("  --use-prof-file=<file>    Use profile file collected by LLVM PGO (Profile-Guided Optimization)\n");
@@ -483,6 +490,9 @@ main(int argc, char *argv[])
         else if (!strncmp(argv[0], "--stack-usage=", 14)) {
             option.stack_usage_file = argv[0] + 14;
         }
+        else if (!strncmp(argv[0], "--bound-check-report=", 21)) {
+            option.bound_check_report_file = argv[0] + 21;
+        }
         else if (!strncmp(argv[0], "--format=", 9)) {
             if (argv[0][9] == '\0')
                 PRINT_HELP_AND_EXIT();
@@ -576,6 +586,13 @@ main(int argc, char *argv[])
         else if (!strcmp(argv[0], "--enable-llvm-pgo")) {
             option.enable_llvm_pgo = true;
         }
+        else if (!strncmp(argv[0], "--jobs=", 7)) {
+            if (argv[0][7] == '\0')
+                PRINT_HELP_AND_EXIT();
+            option.parallel_jobs = (uint32)atoi(argv[0] + 7);
+            if (option.parallel_jobs == 0)
+                PRINT_HELP_AND_EXIT();
+        }
         else if (!strncmp(argv[0], "--enable-llvm-passes=", 21)) {
             if (argv[0][21] == '\0')
                 PRINT_HELP_AND_EXIT();